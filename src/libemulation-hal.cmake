@@ -4,11 +4,17 @@ set(_libemulation_hal_dir ${source_directory}/libemulation-hal)
 
 # Sources
 set(emulation_hal
+  ${_libemulation_hal_dir}/HeadlessAudio.cpp
+  ${_libemulation_hal_dir}/HeadlessCanvas.cpp
   ${_libemulation_hal_dir}/HIDJoystick.cpp
   ${_libemulation_hal_dir}/OEMatrix3.cpp
   ${_libemulation_hal_dir}/OEVector.cpp
   ${_libemulation_hal_dir}/OpenGLCanvas.cpp
   ${_libemulation_hal_dir}/PAAudio.cpp
+  ${_libemulation_hal_dir}/PAAudioEmulation.cpp
+  ${_libemulation_hal_dir}/SoftwareCanvas.cpp
+  ${_libemulation_hal_dir}/TripleBuffer.cpp
+  ${_libemulation_hal_dir}/VideoDecoder.cpp
 )
 
 set(emulation_hal_include ${_libemulation_hal_dir})
\ No newline at end of file
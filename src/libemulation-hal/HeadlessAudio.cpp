@@ -0,0 +1,87 @@
+
+/**
+ * libemulation-hal
+ * Headless audio
+ * (C) 2012 by Marc S. Ressl (mressl@umich.edu)
+ * Released under the GPL
+ *
+ * Implements an audio component that runs emulations without audio hardware
+ */
+
+#include "HeadlessAudio.h"
+
+#include "AudioInterface.h"
+
+#define DEFAULT_SAMPLERATE      48000
+#define DEFAULT_CHANNELNUM      2
+#define DEFAULT_FRAMESPERBUFFER 512
+
+HeadlessAudio::HeadlessAudio()
+{
+    sampleRate = DEFAULT_SAMPLERATE;
+    channelNum = DEFAULT_CHANNELNUM;
+    framesPerBuffer = DEFAULT_FRAMESPERBUFFER;
+    
+    bufferCount = 0;
+}
+
+void HeadlessAudio::setSampleRate(float value)
+{
+    sampleRate = value;
+}
+
+void HeadlessAudio::setChannelNum(OEInt value)
+{
+    channelNum = value;
+}
+
+void HeadlessAudio::setFramesPerBuffer(OEInt value)
+{
+    framesPerBuffer = value;
+}
+
+float HeadlessAudio::getSampleRate()
+{
+    return sampleRate;
+}
+
+OEInt HeadlessAudio::getFramesPerBuffer()
+{
+    return framesPerBuffer;
+}
+
+// Runs the emulations for a number of synthetic buffers, as fast as possible
+
+void HeadlessAudio::runEmulations(OELong bufferNum)
+{
+    OEInt samplesPerBuffer = framesPerBuffer * channelNum;
+    
+    inputBuffer.resize(samplesPerBuffer);
+    outputBuffer.resize(samplesPerBuffer);
+    
+    for (OELong i = 0; i < bufferNum; i++)
+    {
+        fill(inputBuffer.begin(), inputBuffer.end(), 0.0F);
+        fill(outputBuffer.begin(), outputBuffer.end(), 0.0F);
+        
+        AudioBuffer audioBuffer =
+        {
+            sampleRate,
+            channelNum,
+            framesPerBuffer,
+            &inputBuffer.front(),
+            &outputBuffer.front(),
+        };
+        
+        postNotification(this, AUDIO_BUFFER_WILL_RENDER, &audioBuffer);
+        postNotification(this, AUDIO_BUFFER_IS_RENDERING, &audioBuffer);
+        postNotification(this, AUDIO_BUFFER_DID_RENDER, &audioBuffer);
+        
+        bufferCount++;
+    }
+}
+
+OELong HeadlessAudio::getBufferCount()
+{
+    return bufferCount;
+}
@@ -0,0 +1,43 @@
+
+/**
+ * libemulation-hal
+ * Headless audio
+ * (C) 2012 by Marc S. Ressl (mressl@umich.edu)
+ * Released under the GPL
+ *
+ * Implements an audio component that runs emulations without audio hardware
+ */
+
+#ifndef _HEADLESSAUDIO_H
+#define _HEADLESSAUDIO_H
+
+#include "OEEmulation.h"
+
+class HeadlessAudio : public OEComponent
+{
+public:
+    HeadlessAudio();
+    
+    void setSampleRate(float value);
+    void setChannelNum(OEInt value);
+    void setFramesPerBuffer(OEInt value);
+    
+    float getSampleRate();
+    OEInt getFramesPerBuffer();
+    
+    void runEmulations(OELong bufferNum);
+    
+    OELong getBufferCount();
+    
+private:
+    float sampleRate;
+    OEInt channelNum;
+    OEInt framesPerBuffer;
+    
+    vector<float> inputBuffer;
+    vector<float> outputBuffer;
+    
+    OELong bufferCount;
+};
+
+#endif
@@ -0,0 +1,73 @@
+
+/**
+ * libemulation-hal
+ * Headless canvas
+ * (C) 2012 by Marc S. Ressl (mressl@umich.edu)
+ * Released under the GPL
+ *
+ * Implements a canvas that accepts and counts frames without drawing them
+ */
+
+#include "HeadlessCanvas.h"
+
+#include "CanvasInterface.h"
+
+HeadlessCanvas::HeadlessCanvas(OECanvasType canvasType)
+{
+    this->canvasType = canvasType;
+    
+    frameCount = 0;
+    dirtyRect = OEMakeRect(0, 0, 0, 0);
+}
+
+OECanvasType HeadlessCanvas::getCanvasType()
+{
+    return canvasType;
+}
+
+OELong HeadlessCanvas::getFrameCount()
+{
+    return frameCount;
+}
+
+// The dirty rect of the last posted image
+
+OERect HeadlessCanvas::getDirtyRect()
+{
+    return dirtyRect;
+}
+
+bool HeadlessCanvas::postMessage(OEComponent *sender, int message, void *data)
+{
+    switch (message)
+    {
+        case CANVAS_SET_CAPTUREMODE:
+        case CANVAS_SET_BEZEL:
+        case CANVAS_SET_KEYBOARD_LEDS:
+        case CANVAS_CONFIGURE_DISPLAY:
+        case CANVAS_CONFIGURE_PAPER:
+        case CANVAS_CONFIGURE_OPENGL:
+        case CANVAS_CLEAR:
+        case CANVAS_SET_PRINTPOSITION:
+            return true;
+            
+        case CANVAS_GET_KEYBOARD_FLAGS:
+            *((CanvasKeyboardFlags *)data) = 0;
+            
+            return true;
+            
+        case CANVAS_GET_KEYBOARD_ANYKEYDOWN:
+            *((bool *)data) = false;
+            
+            return true;
+            
+        case CANVAS_POST_IMAGE:
+            frameCount++;
+            
+            dirtyRect = ((OEImage *)data)->getDirtyRect();
+            
+            return true;
+    }
+    
+    return false;
+}
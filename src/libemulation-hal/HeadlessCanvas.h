@@ -0,0 +1,36 @@
+
+/**
+ * libemulation-hal
+ * Headless canvas
+ * (C) 2012 by Marc S. Ressl (mressl@umich.edu)
+ * Released under the GPL
+ *
+ * Implements a canvas that accepts and counts frames without drawing them
+ */
+
+#ifndef _HEADLESSCANVAS_H
+#define _HEADLESSCANVAS_H
+
+#include "OEEmulation.h"
+#include "OEImage.h"
+
+class HeadlessCanvas : public OEComponent
+{
+public:
+    HeadlessCanvas(OECanvasType canvasType);
+    
+    OECanvasType getCanvasType();
+    
+    OELong getFrameCount();
+    OERect getDirtyRect();
+    
+    bool postMessage(OEComponent *sender, int message, void *data);
+    
+private:
+    OECanvasType canvasType;
+    
+    OELong frameCount;
+    OERect dirtyRect;
+};
+
+#endif
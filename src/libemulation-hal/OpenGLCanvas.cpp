@@ -16,13 +16,6 @@
 #include "OEVector.h"
 #include "OEMatrix3.h"
 
-// References:
-// * Poynton C., Digital Video and HDTV Algorithms and Interfaces
-
-#define NTSC_I_CUTOFF               1300000
-#define NTSC_Q_CUTOFF               600000
-#define NTSC_IQ_DELTA               (NTSC_I_CUTOFF - NTSC_Q_CUTOFF)
-
 #define PAPER_SLICE                 256
 
 #define BEZELCAPTURE_DISPLAY_TIME   2.0
@@ -165,6 +158,8 @@ OpenGLCanvas::OpenGLCanvas(string resourcePath, OECanvasType canvasType)
     imageSampleRate = 0;
     imageBlackLevel = 0;
     imageWhiteLevel = 0;
+    imageUploadSize = OEMakeSize(0, 0);
+    imageUploadFormat = OEIMAGE_LUMINANCE;
     
     printPosition = OEMakePoint(0, 0);
     
@@ -425,15 +420,16 @@ bool OpenGLCanvas::vsync()
     
     if (canvasType == OECANVAS_DISPLAY)
     {
-        if (isImageUpdated)
+        bool isFrameUpdated = frames.update();
+        
+        if (isFrameUpdated)
             uploadImage();
         
         if (isConfigurationUpdated)
             configureShaders();
         
-        if (isImageUpdated || isConfigurationUpdated)
+        if (isFrameUpdated || isConfigurationUpdated)
         {
-            isImageUpdated = false;
             isConfigurationUpdated = false;
             
             renderImage();
@@ -520,6 +516,8 @@ bool OpenGLCanvas::initOpenGL()
         textureSize[i] = OEMakeSize(0, 0);
     }
     
+    imageUploadSize = OEMakeSize(0, 0);
+    
     isConfigurationUpdated = true;
     for (OEInt i = 0; i < OPENGLCANVAS_SHADEREND; i++)
         shader[i] = 0;
@@ -741,40 +739,75 @@ void OpenGLCanvas::deleteShader(GLuint shaderIndex)
 
 bool OpenGLCanvas::uploadImage()
 {
+    OEImage& frontImage = frames.getImage();
+    OESize size = frontImage.getSize();
+    
     // Upload image
-    updateTextureSize(OPENGLCANVAS_IMAGE_IN, image.getSize());
+    OESize texSize = textureSize[OPENGLCANVAS_IMAGE_IN];
+    
+    updateTextureSize(OPENGLCANVAS_IMAGE_IN, size);
     
-    glBindTexture(GL_TEXTURE_2D, texture[OPENGLCANVAS_IMAGE_IN]);
+    OERect dirtyRect = frontImage.getDirtyRect();
     
-    glTexSubImage2D(GL_TEXTURE_2D, 0,
-                    0, 0,
-                    image.getSize().width, image.getSize().height,
-                    getGLFormat(image.getFormat()), GL_UNSIGNED_BYTE, image.getPixels());
+    if ((textureSize[OPENGLCANVAS_IMAGE_IN].width != texSize.width) ||
+        (textureSize[OPENGLCANVAS_IMAGE_IN].height != texSize.height) ||
+        (size.width != imageUploadSize.width) ||
+        (size.height != imageUploadSize.height) ||
+        (frontImage.getFormat() != imageUploadFormat))
+        dirtyRect = OEMakeRect(0, 0, size.width, size.height);
+    
+    // Only the rows of the dirty rect are uploaded
+    OEInt y0 = (OEInt) max(OEMinY(dirtyRect), 0.0F);
+    OEInt y1 = (OEInt) min(OEMaxY(dirtyRect), size.height);
+    
+    if (!OEIsEmptyRect(dirtyRect) && (y0 < y1))
+    {
+        glBindTexture(GL_TEXTURE_2D, texture[OPENGLCANVAS_IMAGE_IN]);
+        
+        glTexSubImage2D(GL_TEXTURE_2D, 0,
+                        0, y0,
+                        size.width, y1 - y0,
+                        getGLFormat(frontImage.getFormat()), GL_UNSIGNED_BYTE,
+                        frontImage.getPixels() + frontImage.getBytesPerRow() * y0);
+    }
     
     // Update configuration
-    if ((image.getSampleRate() != imageSampleRate) ||
-        (image.getBlackLevel() != imageBlackLevel) ||
-        (image.getWhiteLevel() != imageWhiteLevel) ||
-        (image.getSubcarrier() != imageSubcarrier))
+    if ((frontImage.getSampleRate() != imageSampleRate) ||
+        (frontImage.getBlackLevel() != imageBlackLevel) ||
+        (frontImage.getWhiteLevel() != imageWhiteLevel) ||
+        (frontImage.getSubcarrier() != imageSubcarrier))
     {
-        imageSampleRate = image.getSampleRate();
-        imageBlackLevel = image.getBlackLevel();
-        imageWhiteLevel = image.getWhiteLevel();
-        imageSubcarrier = image.getSubcarrier();
+        imageSampleRate = frontImage.getSampleRate();
+        imageBlackLevel = frontImage.getBlackLevel();
+        imageWhiteLevel = frontImage.getWhiteLevel();
+        imageSubcarrier = frontImage.getSubcarrier();
         
         isConfigurationUpdated = true;
     }
     
-    // Upload phase info
-    OEInt texSize = (OEInt) getNextPowerOf2((OEInt) image.getSize().height);
+    // Upload phase info, when it changed
+    vector<float> colorBurst = frontImage.getColorBurst();
+    vector<bool> phaseAlternation = frontImage.getPhaseAlternation();
     
-    vector<float> colorBurst = image.getColorBurst();
-    vector<bool> phaseAlternation = image.getPhaseAlternation();
+    bool isPhaseInfoUpdated = ((size.height != imageUploadSize.height) ||
+                               (colorBurst != imageColorBurst) ||
+                               (phaseAlternation != imagePhaseAlternation));
+    
+    imageUploadSize = size;
+    imageUploadFormat = frontImage.getFormat();
+    
+    if (!isPhaseInfoUpdated)
+        return true;
+    
+    imageColorBurst = colorBurst;
+    imagePhaseAlternation = phaseAlternation;
+    
+    OEInt phaseInfoSize = (OEInt) getNextPowerOf2((OEInt) size.height);
     
     vector<float> phaseInfo;
-    phaseInfo.resize(3 * texSize);
+    phaseInfo.resize(3 * phaseInfoSize);
     
-    for (OEInt x = 0; x < image.getSize().height; x++)
+    for (OEInt x = 0; x < size.height; x++)
     {
         float c = colorBurst[x % colorBurst.size()] / 2 / (float) M_PI;
         
@@ -785,7 +818,7 @@ bool OpenGLCanvas::uploadImage()
     glBindTexture(GL_TEXTURE_1D, texture[OPENGLCANVAS_IMAGE_PHASEINFO]);
     
     glTexImage1D(GL_TEXTURE_1D, 0, GL_RGB,
-                 texSize,
+                 phaseInfoSize,
                  0,
                  GL_RGB, GL_FLOAT, &phaseInfo.front());
     
@@ -823,51 +856,21 @@ void OpenGLCanvas::configureShaders()
     // Render shader
     glUseProgram(renderShader);
     
+    videoDecoder.configure(displayConfiguration,
+                           imageSampleRate,
+                           imageBlackLevel,
+                           imageWhiteLevel,
+                           imageSubcarrier);
+    
     // Subcarrier
     if (isCompositeDecoder)
         glUniform1f(glGetUniformLocation(renderShader, "subcarrier"),
-                    imageSubcarrier / imageSampleRate);
+                    videoDecoder.getSubcarrier());
     
     // Filters
-    OEVector w = OEVector::chebyshevWindow(17, 50);
-    w = w.normalize();
-    
-    OEVector wy, wu, wv;
-    
-    float bandwidth = displayConfiguration.videoBandwidth / imageSampleRate;
-    
-    if (isCompositeDecoder)
-    {
-        float yBandwidth = displayConfiguration.videoLumaBandwidth / imageSampleRate;
-        float uBandwidth = displayConfiguration.videoChromaBandwidth / imageSampleRate;
-        float vBandwidth = uBandwidth;
-        
-        if (displayConfiguration.videoDecoder == CANVAS_YIQ)
-            uBandwidth = uBandwidth + NTSC_IQ_DELTA / imageSampleRate;
-        
-        // Switch to video bandwidth when no subcarrier
-        if ((imageSubcarrier == 0.0) ||
-            (displayConfiguration.videoWhiteOnly))
-        {
-            yBandwidth = bandwidth;
-            uBandwidth = bandwidth;
-            vBandwidth = bandwidth;
-        }
-        
-        wy = w * OEVector::lanczosWindow(17, yBandwidth);
-        wy = wy.normalize();
-        
-        wu = w * OEVector::lanczosWindow(17, uBandwidth);
-        wu = wu.normalize() * 2;
-        
-        wv = w * OEVector::lanczosWindow(17, vBandwidth);
-        wv = wv.normalize() * 2;
-    }
-    else
-    {
-        wy = w * OEVector::lanczosWindow(17, bandwidth);
-        wu = wv = wy = wy.normalize();
-    }
+    OEVector wy = videoDecoder.getFilter(0);
+    OEVector wu = videoDecoder.getFilter(1);
+    OEVector wv = videoDecoder.getFilter(2);
     
     glUniform3f(glGetUniformLocation(renderShader, "c0"),
                 wy.getValue(8), wu.getValue(8), wv.getValue(8));
@@ -888,119 +891,15 @@ void OpenGLCanvas::configureShaders()
     glUniform3f(glGetUniformLocation(renderShader, "c8"),
                 wy.getValue(0), wu.getValue(0), wv.getValue(0));
     
-    // Decoder matrix
-    OEMatrix3 decoderMatrix(1, 0, 0,
-                            0, 1, 0,
-                            0, 0, 1);
-    
-    // Encode
-    if (!isCompositeDecoder)
-    {
-        // Y'PbPr encoding matrix
-        decoderMatrix = OEMatrix3(0.299F, -0.168736F, 0.5F,
-                                  0.587F, -0.331264F, -0.418688F,
-                                  0.114F, 0.5F, -0.081312F) * decoderMatrix;
-    }
-    
-    // Set hue
-    if (displayConfiguration.videoDecoder == CANVAS_MONOCHROME)
-        decoderMatrix = OEMatrix3(1, 0.5F, 0,
-                                  0, 0, 0,
-                                  0, 0, 0) * decoderMatrix;
-    
-    // Disable color decoding when no subcarrier
-    if (isCompositeDecoder)
-    {
-        if ((imageSubcarrier == 0.0) ||
-            (displayConfiguration.videoWhiteOnly))
-        {
-            decoderMatrix = OEMatrix3(1, 0, 0,
-                                      0, 0, 0,
-                                      0, 0, 0) * decoderMatrix;
-        }
-    }
-    
-    // Saturation
-    decoderMatrix = OEMatrix3(1, 0, 0,
-                              0, displayConfiguration.videoSaturation, 0,
-                              0, 0, displayConfiguration.videoSaturation) * decoderMatrix;
-    
-    // Hue
-    float hue = 2 * (float) M_PI * displayConfiguration.videoHue;
-    
-    decoderMatrix = OEMatrix3(1, 0, 0,
-                              0, cosf(hue), -sinf(hue),
-                              0, sinf(hue), cosf(hue)) * decoderMatrix;
-    
-    // Decode
-    switch (displayConfiguration.videoDecoder)
-    {
-        case CANVAS_RGB:
-        case CANVAS_MONOCHROME:
-            // Y'PbPr decoder matrix
-            decoderMatrix = OEMatrix3(1, 1, 1,
-                                      0, -0.344136F, 1.772F,
-                                      1.402F, -0.714136F, 0) * decoderMatrix;
-            break;
-            
-        case CANVAS_YUV:
-        case CANVAS_YIQ:
-            // Y'UV decoder matrix
-            decoderMatrix = OEMatrix3(1, 1, 1,
-                                      0, -0.394642F, 2.032062F,
-                                      1.139883F, -0.580622F, 0) * decoderMatrix;
-            break;
-            
-        case CANVAS_CXA2025AS:
-            // Exchange I and Q
-            decoderMatrix = OEMatrix3(1, 0, 0,
-                                      0, 0, 1,
-                                      0, 1, 0) * decoderMatrix;
-            
-            // Rotate 33 degrees
-            hue = -(float) M_PI * 33 / 180;
-            decoderMatrix = OEMatrix3(1, 0, 0,
-                                      0, cosf(hue), -sinf(hue),
-                                      0, sinf(hue), cosf(hue)) * decoderMatrix;
-            
-            // CXA2025AS decoder matrix
-            decoderMatrix = OEMatrix3(1, 1, 1,
-                                      1.630F, -0.378F, -1.089F,
-                                      0.317F, -0.466F, 1.677F) * decoderMatrix;
-            break;
-    }
-    
-    // Brigthness
-    float brightness = displayConfiguration.videoBrightness - imageBlackLevel;
-    OEMatrix3 decoderOffset;
-    
-    if (isCompositeDecoder)
-        decoderOffset = decoderMatrix * OEMatrix3(brightness, 0, 0,
-                                                  0, 0, 0,
-                                                  0, 0, 0);
-    else
-        decoderOffset = decoderMatrix * OEMatrix3(brightness, 0, 0,
-                                                  brightness, 0, 0,
-                                                  brightness, 0, 0);
+    // Decoder matrix and offset
+    OEMatrix3 decoderOffset = videoDecoder.getDecoderOffset();
     
     glUniform3f(glGetUniformLocation(renderShader, "decoderOffset"),
                 decoderOffset.getValue(0, 0),
                 decoderOffset.getValue(0, 1),
                 decoderOffset.getValue(0, 2));
     
-    // Contrast
-    float contrast = displayConfiguration.videoContrast;
-    
-    float videoLevel = (imageWhiteLevel - imageBlackLevel);
-    if (videoLevel > 0)
-        contrast /= videoLevel;
-    else
-        contrast = 0;
-    
-    if (contrast < 0)
-        contrast = 0;
-    
-    decoderMatrix *= contrast;
+    OEMatrix3 decoderMatrix = videoDecoder.getDecoderMatrix();
     
     glUniformMatrix3fv(glGetUniformLocation(renderShader, "decoderMatrix"),
                        1, false, decoderMatrix.getValues());
@@ -1080,7 +979,7 @@ void OpenGLCanvas::renderImage()
     // (support for vanilla OpenGL 2.0 cards)
     glReadBuffer(GL_BACK);
     
-    OESize imageSize = image.getSize();
+    OESize imageSize = frames.getImage().getSize();
     for (float y = 0; y < imageSize.height; y += viewportSize.height)
         for (float x = 0; x < imageSize.width; x += viewportSize.width)
         {
@@ -1141,7 +1040,7 @@ OEPoint OpenGLCanvas::getDisplayCanvasTexPoint(OEPoint p)
     p = OEMakePoint((p.x - 2 * videoCenter.x) / videoSize.width,
                     (p.y - 2 * videoCenter.y) / videoSize.height);
     
-    OESize imageSize = image.getSize();
+    OESize imageSize = frames.getImage().getSize();
     OESize texSize = textureSize[OPENGLCANVAS_IMAGE_IN];
     
     p.x = (p.x + 1) * 0.5F * imageSize.width / texSize.width;
@@ -1152,6 +1051,8 @@ OEPoint OpenGLCanvas::getDisplayCanvasTexPoint(OEPoint p)
 
 void OpenGLCanvas::drawDisplayCanvas()
 {
+    OEImage& frontImage = frames.getImage();
+    
     GLuint displayShader = shader[OPENGLCANVAS_DISPLAY];
     
     if (!isShaderEnabled)
@@ -1161,8 +1062,8 @@ void OpenGLCanvas::drawDisplayCanvas()
     glClearColor(0, 0, 0, 1);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     
-    if ((image.getSize().width == 0) ||
-        (image.getSize().height == 0))
+    if ((frontImage.getSize().width == 0) ||
+        (frontImage.getSize().height == 0))
     {
         updateTextureSize(OPENGLCANVAS_IMAGE_PERSISTENCE, OEMakeSize(0, 0));
         
@@ -1195,7 +1096,7 @@ void OpenGLCanvas::drawDisplayCanvas()
     OERect baseTexRect = OEMakeRect(0, 0, 1, 1);
     
     // Canvas texture tect
-    float interlaceShift = image.getInterlace() / image.getSize().height;
+    float interlaceShift = frontImage.getInterlace() / frontImage.getSize().height;
     
     OEPoint canvasTexLowerLeft = getDisplayCanvasTexPoint(OEMakePoint(-1, -1 + 2 * interlaceShift));
     OEPoint canvasTexUpperRight = getDisplayCanvasTexPoint(OEMakePoint(1, 1 + 2 * interlaceShift));
@@ -1244,7 +1145,7 @@ void OpenGLCanvas::drawDisplayCanvas()
                     1, 1.0F / displayAspectRatio);
         
         // Scanlines
-        float scanlineHeight = canvasVideoSize.height / image.getSize().height;
+        float scanlineHeight = canvasVideoSize.height / frontImage.getSize().height;
         float scanlineLevel = displayConfiguration.displayScanlineLevel;
         
         scanlineLevel = ((scanlineHeight > 2.5F) ? scanlineLevel :
@@ -1873,19 +1774,22 @@ bool OpenGLCanvas::setOpenGLConfiguration(CanvasOpenGLConfiguration *value)
     return true;
 }
 
+// Display frames are passed to the drawing thread through a triple buffer,
+// so neither thread waits for the other
+
 bool OpenGLCanvas::postImage(OEImage *value)
 {
+    if (canvasType == OECANVAS_DISPLAY)
+    {
+        frames.post(*value);
+        
+        return true;
+    }
+    
     lock();
     
     switch (canvasType)
     {
-        case OECANVAS_DISPLAY:
-            image = *value;
-            
-            isImageUpdated = true;
-            
-            break;
-            
         case OECANVAS_PAPER:
         {
             OESize srcSize = value->getSize();
@@ -1924,17 +1828,17 @@ bool OpenGLCanvas::postImage(OEImage *value)
 
 bool OpenGLCanvas::clear()
 {
+    if (canvasType == OECANVAS_DISPLAY)
+    {
+        frames.clear();
+        
+        return true;
+    }
+    
     lock();
     
     switch (canvasType)
     {
-        case OECANVAS_DISPLAY:
-            image = OEImage();
-            
-            isImageUpdated = true;
-            
-            break;
-            
         case OECANVAS_PAPER:
             image = OEImage();
             
@@ -24,6 +24,9 @@
 #include "OEEmulation.h"
 #include "CanvasInterface.h"
 
+#include "TripleBuffer.h"
+#include "VideoDecoder.h"
+
 typedef enum
 {
     OPENGLCANVAS_CAPTURE_NONE,
@@ -131,6 +134,11 @@ private:
     
     bool isImageUpdated;
     OEImage image;
+    TripleBuffer frames;
+    OESize imageUploadSize;
+    OEImageFormat imageUploadFormat;
+    vector<float> imageColorBurst;
+    vector<bool> imagePhaseAlternation;
     float imageSampleRate;
     float imageBlackLevel;
     float imageWhiteLevel;
@@ -143,6 +151,7 @@ private:
     
     CanvasDisplayConfiguration displayConfiguration;
     GLuint shader[OPENGLCANVAS_SHADEREND];
+    VideoDecoder videoDecoder;
     
     CanvasPaperConfiguration paperConfiguration;
     OEPoint printPosition;
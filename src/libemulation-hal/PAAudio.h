@@ -14,10 +14,15 @@
 #include <pthread.h>
 
 #include "portaudio.h"
-#include "sndfile.h"
-#include "samplerate.h"
 
-#include "OEEmulation.h"
+#include "PAAudioEmulation.h"
+
+// Notes:
+// * PAAudio owns the audio stream and mixes the emulations added to it.
+//   Each emulation runs on its own PAAudioEmulation thread.
+// * The emulation list is guarded by a mutex. The audio callback only
+//   tries to take it, and outputs silence for one buffer when the list
+//   is being changed.
 
 class PAAudio : public OEComponent
 {
@@ -34,35 +39,14 @@ public:
     bool open();
     void close();
     
-    void lock();
-    void unlock();
-    
-    void runEmulations();
+    void addEmulation(PAAudioEmulation *emulation);
+    void removeEmulation(PAAudioEmulation *emulation);
     
     void runAudio(const float *input,
                   float *output,
                   OEInt frameCount);
     void runTimer();
     
-    void openPlayer(string path);
-    void closePlayer();
-    void setPlayerVolume(float value);
-    void setPlayerPlayThrough(bool value);
-    void setPlayerPosition(float value);
-    float getPlayerPosition();
-    float getPlayerTime();
-    bool isPlayerPlaying();
-    void startPlayer();
-    void pausePlayer();
-    
-    void openRecorder(string path);
-    void closeRecorder();
-    float getRecorderTime();
-    OELong getRecorderSize();
-    bool isRecorderRecording();
-    void startRecorder();
-    void stopRecorder();
-    
 private:
     bool fullDuplex;
     float sampleRate;
@@ -70,65 +54,20 @@ private:
     OEInt framesPerBuffer;
     OEInt bufferNum;
     
-    volatile OEInt bufferAudioIndex;
-    volatile OEInt bufferEmulationIndex;
-    vector<float> bufferInput;
-    vector<float> bufferOutput;
-    
-    bool emulationsThreadShouldRun;
-    pthread_t emulationsThread;
+    vector<PAAudioEmulation *> emulations;
     pthread_mutex_t emulationsMutex;
-    pthread_cond_t emulationsCond;
     
     bool audioOpen;
     PaStream *audioStream;
     bool timerThreadShouldRun;
     pthread_t timerThread;
     
-    float playerVolume;
-    bool playerPlayThrough;
-    bool playerPlaying;
-    SNDFILE *playerSNDFILE;
-    OEInt playerChannelNum;
-    OELong playerFrameIndex;
-    OELong playerFrameNum;
-    double playerSRCRatio;
-    SRC_STATE *playerSRC;
-    bool playerSRCEndOfInput;
-    vector<float> playerInput;
-    OEInt playerInputFrameIndex;
-    OEInt playerInputFrameNum;
-    
-    bool recorderRecording;
-    SNDFILE *recorderSNDFILE;
-    OELong recorderFrameNum;
-    
-    void initBuffer();
-    bool isAudioBufferEmpty();
-    float *getAudioInputBuffer();
-    float *getAudioOutputBuffer();
-    void advanceAudioBuffer();
-    bool isEmulationsBufferEmpty();
-    float *getEmulationsInputBuffer();
-    float *getEmulationsOutputBuffer();
-    void advanceEmulationsBuffer();
-    
     bool openAudio();
     void closeAudio();
     bool disableAudio();
     void enableAudio(bool value);
     
-    bool openEmulations();
-    void closeEmulations();
-    
-    void playAudio(float *inputBuffer,
-                   float *outputBuffer,
-                   OEInt frameNum,
-                   OEInt channelNum);
-    
-    void recordAudio(float *outputBuffer,
-                     OEInt frameNum,
-                     OEInt channelNum);
+    void configureEmulations();
 };
 
 #endif
@@ -0,0 +1,661 @@
+
+/**
+ * libemulation-hal
+ * PortAudio emulation
+ * (C) 2012 by Marc S. Ressl (mressl@umich.edu)
+ * Released under the GPL
+ *
+ * Runs one emulation on its own thread for a PortAudio audio component
+ */
+
+#include "PAAudioEmulation.h"
+
+#include "AudioInterface.h"
+
+#define DEFAULT_SAMPLERATE          48000
+#define DEFAULT_CHANNELNUM          2
+#define DEFAULT_FRAMESPERBUFFER     512
+#define DEFAULT_BUFFERNUM           3
+
+using namespace std;
+
+// Callbacks
+
+void *PAAudioEmulationRunEmulation(void *arg)
+{
+    ((PAAudioEmulation *) arg)->runEmulation();
+    
+    return NULL;
+}
+
+// Configuration
+
+PAAudioEmulation::PAAudioEmulation()
+{
+    sampleRate = DEFAULT_SAMPLERATE;
+    channelNum = DEFAULT_CHANNELNUM;
+    framesPerBuffer = DEFAULT_FRAMESPERBUFFER;
+    bufferNum = DEFAULT_BUFFERNUM;
+    
+    emulationSpeed = 1;
+    emulationSpeedRemainder = 0;
+    
+    emulationThreadShouldRun = false;
+    pthread_mutex_init(&emulationMutex, NULL);
+    pthread_cond_init(&emulationCond, NULL);
+    
+    playerVolume = 1;
+    playerPlayThrough = false;
+    playerSNDFILE = NULL;
+    playerPlaying = false;
+    recorderSNDFILE = NULL;
+    recorderRecording = false;
+    
+    initBuffer();
+}
+
+PAAudioEmulation::~PAAudioEmulation()
+{
+    close();
+    
+    closePlayer();
+    closeRecorder();
+    
+    pthread_cond_destroy(&emulationCond);
+    pthread_mutex_destroy(&emulationMutex);
+}
+
+// Called by PAAudio while the audio stream is stopped
+
+void PAAudioEmulation::configure(float sampleRate,
+                                 OEInt channelNum,
+                                 OEInt framesPerBuffer,
+                                 OEInt bufferNum)
+{
+    if ((sampleRate != this->sampleRate) ||
+        (channelNum != this->channelNum))
+    {
+        closePlayer();
+        closeRecorder();
+    }
+    
+    lock();
+    
+    this->sampleRate = sampleRate;
+    this->channelNum = channelNum;
+    this->framesPerBuffer = framesPerBuffer;
+    this->bufferNum = bufferNum;
+    
+    initBuffer();
+    
+    unlock();
+}
+
+// At speed 1 the emulation runs in real time. At speed N it runs N
+// buffers for every audio buffer, and at speed 0 as fast as possible.
+// Audio input and output are muted when not running in real time;
+// the player and recorder keep following emulated time
+
+void PAAudioEmulation::setEmulationSpeed(float value)
+{
+    lock();
+    
+    emulationSpeed = value;
+    emulationSpeedRemainder = 0;
+    
+    pthread_cond_signal(&emulationCond);
+    
+    unlock();
+}
+
+bool PAAudioEmulation::open()
+{
+    if (emulationThreadShouldRun)
+        return true;
+    
+    int error;
+    pthread_attr_t attr;
+    
+    error = pthread_attr_init(&attr);
+    
+    if (!error)
+    {
+        sched_param param;
+        
+        error = pthread_attr_getschedparam(&attr, &param);
+        if (!error)
+        {
+            int curr = param.sched_priority;
+            int max = sched_get_priority_max(SCHED_RR);
+            
+            param.sched_priority += (max - curr) / 2;
+            pthread_attr_setschedparam(&attr, &param);
+        }
+        
+        error = pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+        if (!error)
+        {
+            emulationThreadShouldRun = true;
+            error = pthread_create(&emulationThread,
+                                   &attr,
+                                   PAAudioEmulationRunEmulation,
+                                   this);
+            if (!error)
+                return true;
+            else
+            {
+                emulationThreadShouldRun = false;
+                
+                logMessage("could not create emulation thread, error " + getString(error));
+            }
+        }
+        else
+            logMessage("could not attr emulation thread, error " + getString(error));
+    }
+    else
+        logMessage("could not init emulation attr, error " + getString(error));
+    
+    return false;
+}
+
+void PAAudioEmulation::close()
+{
+    if (!emulationThreadShouldRun)
+        return;
+    
+    emulationThreadShouldRun = false;
+    
+    pthread_cond_signal(&emulationCond);
+    
+    void *status;
+    pthread_join(emulationThread, &status);
+}
+
+void PAAudioEmulation::lock()
+{
+    pthread_mutex_lock(&emulationMutex);
+}
+
+void PAAudioEmulation::unlock()
+{
+    pthread_mutex_unlock(&emulationMutex);
+}
+
+// Audio buffering
+
+void PAAudioEmulation::initBuffer()
+{
+    OEInt bufferSize = bufferNum * framesPerBuffer * channelNum;
+    bufferInput.resize(bufferSize);
+    bufferOutput.resize(bufferSize);
+    
+    fill(bufferInput.begin(), bufferInput.end(), 0.0F);
+    fill(bufferOutput.begin(), bufferOutput.end(), 0.0F);
+    
+    bufferAudioIndex = 0;
+    bufferEmulationIndex = bufferNum;
+}
+
+bool PAAudioEmulation::isAudioBufferEmpty()
+{
+    OEInt stateNum = 2 * bufferNum;
+    
+    OEInt delta = (stateNum + bufferEmulationIndex - bufferAudioIndex) % stateNum;
+    
+    return delta <= 0;
+}
+
+float *PAAudioEmulation::getAudioInputBuffer()
+{
+    OEInt index = bufferAudioIndex % bufferNum;
+    
+    OEInt samplesPerBuffer = framesPerBuffer * channelNum;
+    
+    return &bufferInput[index * samplesPerBuffer];
+}
+
+float *PAAudioEmulation::getAudioOutputBuffer()
+{
+    OEInt index = bufferAudioIndex % bufferNum;
+    
+    OEInt samplesPerBuffer = framesPerBuffer * channelNum;
+    
+    return &bufferOutput[index * samplesPerBuffer];
+}
+
+void PAAudioEmulation::advanceAudioBuffer()
+{
+    OEInt stateNum = 2 * bufferNum;
+    
+    bufferAudioIndex = (bufferAudioIndex + 1) % stateNum;
+    
+    pthread_cond_signal(&emulationCond);
+}
+
+bool PAAudioEmulation::isEmulationBufferEmpty()
+{
+    OEInt stateNum = 2 * bufferNum;
+    
+    OEInt delta = (stateNum + bufferEmulationIndex - bufferAudioIndex) % stateNum;
+    
+    return (bufferNum - delta) <= 0;
+}
+
+float *PAAudioEmulation::getEmulationInputBuffer()
+{
+    OEInt index = bufferEmulationIndex % bufferNum;
+    
+    OEInt samplesPerBuffer = framesPerBuffer * channelNum;
+    
+    return &bufferInput[index * samplesPerBuffer];
+}
+
+float *PAAudioEmulation::getEmulationOutputBuffer()
+{
+    OEInt index = bufferEmulationIndex % bufferNum;
+    
+    OEInt samplesPerBuffer = framesPerBuffer * channelNum;
+    
+    return &bufferOutput[index * samplesPerBuffer];
+}
+
+void PAAudioEmulation::advanceEmulationBuffer()
+{
+    OEInt stateNum = 2 * bufferNum;
+    
+    bufferEmulationIndex = (bufferEmulationIndex + 1) % stateNum;
+}
+
+// Emulation
+
+void PAAudioEmulation::runEmulation()
+{
+    OEInt localBufferSize = 0;
+    float *localInputBuffer = NULL;
+    float *localOutputBuffer = NULL;
+    
+    while (emulationThreadShouldRun)
+    {
+        lock();
+        
+        if ((emulationSpeed > 0) && isEmulationBufferEmpty())
+            pthread_cond_wait(&emulationCond, &emulationMutex);
+        
+        if (!emulationThreadShouldRun)
+        {
+            unlock();
+            
+            break;
+        }
+        
+        bool isRealTime = (emulationSpeed == 1);
+        
+        OEInt samplesPerBuffer = framesPerBuffer * channelNum;
+        OEInt bytesPerBuffer = samplesPerBuffer * (OEInt) sizeof(float);
+        
+        // Resize local buffers
+        if (localBufferSize != bytesPerBuffer)
+        {
+            localBufferSize = bytesPerBuffer;
+            
+            free(localInputBuffer);
+            free(localOutputBuffer);
+            
+            localInputBuffer = (float *) malloc(2 * bytesPerBuffer);
+            localOutputBuffer = (float *) malloc(2 * bytesPerBuffer);
+            
+            memset(localInputBuffer + samplesPerBuffer, 0, bytesPerBuffer);
+            memset(localOutputBuffer + samplesPerBuffer, 0, bytesPerBuffer);
+        }
+        
+        // Number of emulation buffers for this audio buffer
+        OEInt renderNum = 1;
+        
+        if (emulationSpeed > 0)
+        {
+            emulationSpeedRemainder += emulationSpeed;
+            renderNum = (OEInt) emulationSpeedRemainder;
+            emulationSpeedRemainder -= renderNum;
+        }
+        
+        for (OEInt i = 0; i < renderNum; i++)
+        {
+            // Copy circular input buffer to local input buffer
+            memcpy(localInputBuffer, localInputBuffer + samplesPerBuffer, bytesPerBuffer);
+            if (isRealTime)
+                memcpy(localInputBuffer + samplesPerBuffer, getEmulationInputBuffer(), bytesPerBuffer);
+            else
+                memset(localInputBuffer + samplesPerBuffer, 0, bytesPerBuffer);
+            
+            // Shift local output buffer
+            memcpy(localOutputBuffer, localOutputBuffer + samplesPerBuffer, bytesPerBuffer);
+            memset(localOutputBuffer + samplesPerBuffer, 0, bytesPerBuffer);
+            
+            // Audio play
+            playAudio(localInputBuffer + samplesPerBuffer, localOutputBuffer, framesPerBuffer, channelNum);
+            
+            // Output
+            AudioBuffer audioBuffer =
+            {
+                sampleRate,
+                channelNum,
+                framesPerBuffer,
+                localInputBuffer,
+                localOutputBuffer,
+            };
+            
+            postNotification(this, AUDIO_BUFFER_WILL_RENDER, &audioBuffer);
+            postNotification(this, AUDIO_BUFFER_IS_RENDERING, &audioBuffer);
+            postNotification(this, AUDIO_BUFFER_DID_RENDER, &audioBuffer);
+            
+            // Audio recording
+            recordAudio(localOutputBuffer, framesPerBuffer, channelNum);
+        }
+        
+        // Copy local output buffer to circular output buffer
+        bool isBufferAvailable = !isEmulationBufferEmpty();
+        
+        if (isBufferAvailable)
+        {
+            if (isRealTime)
+                memcpy(getEmulationOutputBuffer(), localOutputBuffer, bytesPerBuffer);
+            else
+                memset(getEmulationOutputBuffer(), 0, bytesPerBuffer);
+        }
+        
+        unlock();
+        
+        if (isBufferAvailable)
+            advanceEmulationBuffer();
+    }
+    
+    free(localInputBuffer);
+    free(localOutputBuffer);
+}
+
+// Player
+
+void PAAudioEmulation::openPlayer(string path)
+{
+    closePlayer();
+    
+    lock();
+    
+    SF_INFO sfInfo;
+    
+    playerSNDFILE = sf_open(path.c_str(), SFM_READ, &sfInfo);
+    if (playerSNDFILE)
+    {
+        playerChannelNum = sfInfo.channels;
+        playerSRCRatio = (double) sampleRate / sfInfo.samplerate;
+        playerFrameIndex = 0;
+        playerFrameNum = sfInfo.frames * playerSRCRatio;
+        
+        int error;
+        
+        playerSRC = src_new(SRC_SINC_FASTEST, playerChannelNum, &error);
+        if (playerSRC)
+        {
+            playerInput.resize(framesPerBuffer * playerChannelNum);
+            playerInputFrameNum = 0;
+        }
+        else
+        {
+            logMessage("could not init sample rate converter, error " + getString(error));
+            
+            sf_close(playerSNDFILE);
+            
+            playerSNDFILE = NULL;
+        }
+    }
+    else
+        logMessage("could not open " + path);
+    
+    unlock();
+}
+
+void PAAudioEmulation::closePlayer()
+{
+    if (!playerSNDFILE)
+        return;
+    
+    lock();
+    
+    sf_close(playerSNDFILE);
+    
+    playerPlaying = false;
+    playerSNDFILE = NULL;
+    playerFrameIndex = 0;
+    playerFrameNum = 0;
+    
+    unlock();
+}
+
+void PAAudioEmulation::setPlayerVolume(float value)
+{
+    playerVolume = value;
+}
+
+void PAAudioEmulation::setPlayerPlayThrough(bool value)
+{
+    playerPlayThrough = value;
+}
+
+void PAAudioEmulation::setPlayerPosition(float value)
+{
+    if (!playerSNDFILE)
+        return;
+    
+    lock();
+    
+    playerFrameIndex = value * sampleRate;
+    sf_seek(playerSNDFILE, playerFrameIndex / playerSRCRatio, SEEK_SET);
+    
+    src_reset(playerSRC);
+    
+    playerInputFrameNum = 0;
+    playerSRCEndOfInput = false;
+    
+    unlock();
+}
+
+void PAAudioEmulation::startPlayer()
+{
+    if (getPlayerPosition() >= (getPlayerTime() - 0.1))
+        setPlayerPosition(0);
+    
+    if (!playerSNDFILE)
+        return;
+    
+    playerPlaying = true;
+}
+
+void PAAudioEmulation::pausePlayer()
+{
+    if (!playerSNDFILE)
+        return;
+    
+    playerPlaying = false;
+}
+
+float PAAudioEmulation::getPlayerPosition()
+{
+    return (float) playerFrameIndex / sampleRate;
+}
+
+float PAAudioEmulation::getPlayerTime()
+{
+    return (float) playerFrameNum / sampleRate;
+}
+
+bool PAAudioEmulation::isPlayerPlaying()
+{
+    return playerPlaying;
+}
+
+void PAAudioEmulation::playAudio(float *inputBuffer,
+                        float *outputBuffer,
+                        OEInt frameNum,
+                        OEInt channelNum)
+{
+    if (!playerPlaying)
+        return;
+    
+    OEInt srcOutputFrameIndex = 0;
+    OEInt srcOutputFrameNum = frameNum;
+    
+    vector<float> srcOutput;
+    srcOutput.resize(srcOutputFrameNum * playerChannelNum);
+    
+    do
+    {
+        if (!playerInputFrameNum)
+        {
+            OEInt inputFrameNum = (OEInt) playerInput.size() / playerChannelNum;
+            
+            playerInputFrameIndex = 0;
+            playerInputFrameNum = (OEInt) sf_readf_float(playerSNDFILE,
+                                                            &playerInput.front(),
+                                                            inputFrameNum);
+                                                            
+            playerSRCEndOfInput = (playerInputFrameNum != inputFrameNum);
+        }
+        
+        SRC_DATA srcData =
+        {
+            &playerInput[playerInputFrameIndex * playerChannelNum],
+            &srcOutput[srcOutputFrameIndex * playerChannelNum],
+            playerInputFrameNum,
+            srcOutputFrameNum,
+            0, 0,
+            playerSRCEndOfInput,
+            playerSRCRatio,
+        };
+        
+        src_process(playerSRC, &srcData);
+        
+        if (playerSRCEndOfInput && !srcData.output_frames_gen)
+        {
+            playerPlaying = false;
+            
+            break;
+        }
+        
+        playerInputFrameIndex += (OEInt) srcData.input_frames_used;
+        playerInputFrameNum -= (OEInt) srcData.input_frames_used;
+        
+        srcOutputFrameIndex += (OEInt) srcData.output_frames_gen;
+        srcOutputFrameNum -= (OEInt) srcData.output_frames_gen;
+        
+        playerFrameIndex += srcData.output_frames_gen;
+    } while (srcOutputFrameNum > 0);
+    
+    float linearVolume = getLevelFromVolume(playerVolume);
+    OEInt sampleNum = (frameNum - srcOutputFrameNum) * channelNum;
+    
+    for (OEInt ch = 0; ch < channelNum; ch++)
+    {
+        float *x = &srcOutput.front() + (ch % playerChannelNum);
+        float *yi = inputBuffer + ch;
+        float *yo = outputBuffer + ch;
+        
+        for (OEInt i = 0; i < sampleNum; i += channelNum)
+        {
+            float value = *x * linearVolume;
+            
+            yi[i] += value;
+            if (playerPlayThrough)
+                yo[i] += value;
+            
+            x += playerChannelNum;
+        }
+    }
+}
+
+// Recorder
+
+void PAAudioEmulation::openRecorder(string path)
+{
+    closeRecorder();
+    
+    SF_INFO sfInfo = 
+    {
+        0,
+        sampleRate,
+        channelNum,
+        SF_FORMAT_WAV | SF_FORMAT_PCM_16,
+        0,
+        0,
+    };
+    
+    lock();
+    
+    if (!(recorderSNDFILE = sf_open(path.c_str(), SFM_WRITE, &sfInfo)))
+        logMessage("could not open temporary recorder file " + path);
+    
+    recorderFrameNum = 0;
+    
+    unlock();
+}
+
+void PAAudioEmulation::closeRecorder()
+{
+    if (!recorderSNDFILE)
+        return;
+    
+    lock();
+    
+    sf_close(recorderSNDFILE);
+    
+    recorderSNDFILE = NULL;
+    recorderRecording = false;
+    
+    unlock();
+}
+
+float PAAudioEmulation::getRecorderTime()
+{
+    return (float) recorderFrameNum / sampleRate;
+}
+
+OELong PAAudioEmulation::getRecorderSize()
+{
+    return (OELong) recorderFrameNum * channelNum * sizeof(short);
+}
+
+bool PAAudioEmulation::isRecorderRecording()
+{
+    return recorderRecording;
+}
+
+void PAAudioEmulation::startRecorder()
+{
+    if (recorderSNDFILE)
+        recorderRecording = true;
+}
+
+void PAAudioEmulation::stopRecorder()
+{
+    if (recorderSNDFILE)
+        recorderRecording = false;
+}
+
+void PAAudioEmulation::recordAudio(float *outputBuffer,
+                          OEInt frameNum,
+                          OEInt channelNum)
+{
+    if (!recorderRecording)
+        return;
+    
+    OEInt n = (OEInt) sf_writef_float(recorderSNDFILE, outputBuffer, frameNum);
+    recorderFrameNum += n;
+    
+    if (frameNum != n)
+    {
+        sf_close(recorderSNDFILE);
+        
+        recorderRecording = false;
+        recorderSNDFILE = NULL;
+        recorderFrameNum = 0;
+    }
+}
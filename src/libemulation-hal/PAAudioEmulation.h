@@ -0,0 +1,128 @@
+
+/**
+ * libemulation-hal
+ * PortAudio emulation
+ * (C) 2012 by Marc S. Ressl (mressl@umich.edu)
+ * Released under the GPL
+ *
+ * Runs one emulation on its own thread for a PortAudio audio component
+ */
+
+#ifndef _PAAUDIOEMULATION_H
+#define _PAAUDIOEMULATION_H
+
+#include <pthread.h>
+
+#include "sndfile.h"
+#include "samplerate.h"
+
+#include "OEEmulation.h"
+
+// Notes:
+// * A PAAudioEmulation is the audio component of one emulation. It renders
+//   the emulation's buffers on its own thread, so emulations added to the
+//   same PAAudio run in parallel.
+// * Rendered buffers are passed to PAAudio through a ring with one writer
+//   (the emulation thread) and one reader (the audio callback). Neither
+//   side takes a lock.
+// * lock() and unlock() guard this emulation only. Hold the lock while
+//   calling into the emulation or its components from other threads.
+
+class PAAudioEmulation : public OEComponent
+{
+public:
+    PAAudioEmulation();
+    ~PAAudioEmulation();
+    
+    void configure(float sampleRate,
+                   OEInt channelNum,
+                   OEInt framesPerBuffer,
+                   OEInt bufferNum);
+    void setEmulationSpeed(float value);
+    
+    bool open();
+    void close();
+    
+    void lock();
+    void unlock();
+    
+    void runEmulation();
+    
+    bool isAudioBufferEmpty();
+    float *getAudioInputBuffer();
+    float *getAudioOutputBuffer();
+    void advanceAudioBuffer();
+    
+    void openPlayer(string path);
+    void closePlayer();
+    void setPlayerVolume(float value);
+    void setPlayerPlayThrough(bool value);
+    void setPlayerPosition(float value);
+    float getPlayerPosition();
+    float getPlayerTime();
+    bool isPlayerPlaying();
+    void startPlayer();
+    void pausePlayer();
+    
+    void openRecorder(string path);
+    void closeRecorder();
+    float getRecorderTime();
+    OELong getRecorderSize();
+    bool isRecorderRecording();
+    void startRecorder();
+    void stopRecorder();
+    
+private:
+    float sampleRate;
+    OEInt channelNum;
+    OEInt framesPerBuffer;
+    OEInt bufferNum;
+    
+    volatile OEInt bufferAudioIndex;
+    volatile OEInt bufferEmulationIndex;
+    vector<float> bufferInput;
+    vector<float> bufferOutput;
+    
+    float emulationSpeed;
+    float emulationSpeedRemainder;
+    
+    bool emulationThreadShouldRun;
+    pthread_t emulationThread;
+    pthread_mutex_t emulationMutex;
+    pthread_cond_t emulationCond;
+    
+    float playerVolume;
+    bool playerPlayThrough;
+    bool playerPlaying;
+    SNDFILE *playerSNDFILE;
+    OEInt playerChannelNum;
+    OELong playerFrameIndex;
+    OELong playerFrameNum;
+    double playerSRCRatio;
+    SRC_STATE *playerSRC;
+    bool playerSRCEndOfInput;
+    vector<float> playerInput;
+    OEInt playerInputFrameIndex;
+    OEInt playerInputFrameNum;
+    
+    bool recorderRecording;
+    SNDFILE *recorderSNDFILE;
+    OELong recorderFrameNum;
+    
+    void initBuffer();
+    bool isEmulationBufferEmpty();
+    float *getEmulationInputBuffer();
+    float *getEmulationOutputBuffer();
+    void advanceEmulationBuffer();
+    
+    void playAudio(float *inputBuffer,
+                   float *outputBuffer,
+                   OEInt frameNum,
+                   OEInt channelNum);
+    
+    void recordAudio(float *outputBuffer,
+                     OEInt frameNum,
+                     OEInt channelNum);
+};
+
+#endif
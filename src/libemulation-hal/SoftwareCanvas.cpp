@@ -0,0 +1,118 @@
+
+/**
+ * libemulation-hal
+ * Software canvas
+ * (C) 2012 by Marc S. Ressl (mressl@umich.edu)
+ * Released under the GPL
+ *
+ * Implements a canvas that decodes display frames without OpenGL
+ */
+
+#include <sys/time.h>
+
+#include "SoftwareCanvas.h"
+
+static double getTime()
+{
+    struct timeval tv;
+    
+    gettimeofday(&tv, NULL);
+    
+    return tv.tv_sec + tv.tv_usec * 1E-6;
+}
+
+SoftwareCanvas::SoftwareCanvas(OECanvasType canvasType) : HeadlessCanvas(canvasType)
+{
+    isConfigurationUpdated = true;
+    
+    imageSampleRate = 0;
+    imageBlackLevel = 0;
+    imageWhiteLevel = 0;
+    imageSubcarrier = 0;
+    
+    decodeTime = 0;
+}
+
+void SoftwareCanvas::setThreadNum(OEInt value)
+{
+    videoDecoder.setThreadNum(value);
+}
+
+OEImage& SoftwareCanvas::getImage()
+{
+    return image;
+}
+
+double SoftwareCanvas::getDecodeTime()
+{
+    return decodeTime;
+}
+
+bool SoftwareCanvas::postMessage(OEComponent *sender, int message, void *data)
+{
+    if (getCanvasType() == OECANVAS_DISPLAY)
+    {
+        switch (message)
+        {
+            case CANVAS_CONFIGURE_DISPLAY:
+                return setDisplayConfiguration((CanvasDisplayConfiguration *)data);
+                
+            case CANVAS_POST_IMAGE:
+                postImage((OEImage *)data);
+                
+                break;
+                
+            case CANVAS_CLEAR:
+                return clear();
+        }
+    }
+    
+    return HeadlessCanvas::postMessage(sender, message, data);
+}
+
+bool SoftwareCanvas::setDisplayConfiguration(CanvasDisplayConfiguration *value)
+{
+    displayConfiguration = *value;
+    
+    isConfigurationUpdated = true;
+    
+    return true;
+}
+
+bool SoftwareCanvas::postImage(OEImage *value)
+{
+    double startTime = getTime();
+    
+    if (isConfigurationUpdated ||
+        (value->getSampleRate() != imageSampleRate) ||
+        (value->getBlackLevel() != imageBlackLevel) ||
+        (value->getWhiteLevel() != imageWhiteLevel) ||
+        (value->getSubcarrier() != imageSubcarrier))
+    {
+        isConfigurationUpdated = false;
+        
+        imageSampleRate = value->getSampleRate();
+        imageBlackLevel = value->getBlackLevel();
+        imageWhiteLevel = value->getWhiteLevel();
+        imageSubcarrier = value->getSubcarrier();
+        
+        videoDecoder.configure(displayConfiguration,
+                               imageSampleRate,
+                               imageBlackLevel,
+                               imageWhiteLevel,
+                               imageSubcarrier);
+    }
+    
+    videoDecoder.decode(*value, image);
+    
+    decodeTime += getTime() - startTime;
+    
+    return true;
+}
+
+bool SoftwareCanvas::clear()
+{
+    image = OEImage();
+    
+    return true;
+}
@@ -0,0 +1,56 @@
+
+/**
+ * libemulation-hal
+ * Software canvas
+ * (C) 2012 by Marc S. Ressl (mressl@umich.edu)
+ * Released under the GPL
+ *
+ * Implements a canvas that decodes display frames without OpenGL
+ */
+
+#ifndef _SOFTWARECANVAS_H
+#define _SOFTWARECANVAS_H
+
+#include "HeadlessCanvas.h"
+#include "VideoDecoder.h"
+
+#include "CanvasInterface.h"
+
+// Notes:
+// * Display frames are decoded on the posting thread with the same filters
+//   and matrix OpenGLCanvas uses, so getImage() returns what the render
+//   shader would draw before the display shader adds the CRT effects.
+// * Paper frames are only counted, as in HeadlessCanvas.
+
+class SoftwareCanvas : public HeadlessCanvas
+{
+public:
+    SoftwareCanvas(OECanvasType canvasType);
+    
+    void setThreadNum(OEInt value);
+    
+    OEImage& getImage();
+    double getDecodeTime();
+    
+    bool postMessage(OEComponent *sender, int message, void *data);
+    
+private:
+    VideoDecoder videoDecoder;
+    
+    CanvasDisplayConfiguration displayConfiguration;
+    bool isConfigurationUpdated;
+    
+    float imageSampleRate;
+    float imageBlackLevel;
+    float imageWhiteLevel;
+    float imageSubcarrier;
+    
+    OEImage image;
+    double decodeTime;
+    
+    bool setDisplayConfiguration(CanvasDisplayConfiguration *value);
+    bool postImage(OEImage *value);
+    bool clear();
+};
+
+#endif
@@ -0,0 +1,115 @@
+
+/**
+ * libemulation-hal
+ * Triple buffer
+ * (C) 2012 by Marc S. Ressl (mressl@umich.edu)
+ * Released under the GPL
+ *
+ * Passes images from a posting thread to a reading thread
+ */
+
+#include <string.h>
+
+#include "TripleBuffer.h"
+
+#define FRAME_INDEX     0x3
+#define FRAME_UPDATED   0x4
+
+TripleBuffer::TripleBuffer()
+{
+    for (OEInt i = 0; i < 3; i++)
+        frameStaleRect[i] = OEMakeRect(0, 0, 0, 0);
+    
+    frameFront = 0;
+    frameBack = 1;
+    frameReady = 2;
+    lastDirtyRect = OEMakeRect(0, 0, 0, 0);
+}
+
+void TripleBuffer::post(OEImage& image)
+{
+    OEImage& back = frame[frameBack];
+    OESize size = image.getSize();
+    OERect dirtyRect = image.getDirtyRect();
+    
+    // The other buffers miss the rows of this image
+    for (OEInt i = 0; i < 3; i++)
+        frameStaleRect[i] = OEUnionRect(frameStaleRect[i], dirtyRect);
+    
+    if ((back.getSize().width != size.width) ||
+        (back.getSize().height != size.height) ||
+        (back.getFormat() != image.getFormat()))
+    {
+        back = OEImage();
+        back.setFormat(image.getFormat());
+        back.setSize(size);
+        
+        frameStaleRect[frameBack] = OEMakeRect(0, 0, size.width, size.height);
+    }
+    
+    back.setSampleRate(image.getSampleRate());
+    back.setBlackLevel(image.getBlackLevel());
+    back.setWhiteLevel(image.getWhiteLevel());
+    back.setInterlace(image.getInterlace());
+    back.setSubcarrier(image.getSubcarrier());
+    back.setColorBurst(image.getColorBurst());
+    back.setPhaseAlternation(image.getPhaseAlternation());
+    
+    OERect staleRect = frameStaleRect[frameBack];
+    OEInt y0 = (OEInt) max(OEMinY(staleRect), 0.0F);
+    OEInt y1 = (OEInt) min(OEMaxY(staleRect), size.height);
+    
+    if (!OEIsEmptyRect(staleRect) && (y0 < y1))
+    {
+        OEInt bytesPerRow = image.getBytesPerRow();
+        
+        memcpy(back.getPixels() + y0 * bytesPerRow,
+               image.getPixels() + y0 * bytesPerRow,
+               (y1 - y0) * bytesPerRow);
+    }
+    
+    frameStaleRect[frameBack] = OEMakeRect(0, 0, 0, 0);
+    
+    publish(dirtyRect);
+}
+
+void TripleBuffer::clear()
+{
+    frame[frameBack] = OEImage();
+    
+    // The next image might not be the one posted before
+    for (OEInt i = 0; i < 3; i++)
+        frameStaleRect[i] = OEMakeRect(0, 0, HUGE_VALF, HUGE_VALF);
+    
+    publish(OEMakeRect(0, 0, 0, 0));
+}
+
+bool TripleBuffer::update()
+{
+    if (!(frameReady.load(std::memory_order_relaxed) & FRAME_UPDATED))
+        return false;
+    
+    frameFront = frameReady.exchange(frameFront,
+                                     std::memory_order_acq_rel) & FRAME_INDEX;
+    
+    return true;
+}
+
+OEImage& TripleBuffer::getImage()
+{
+    return frame[frameFront];
+}
+
+void TripleBuffer::publish(OERect dirtyRect)
+{
+    // When the previous image was not taken yet, it might be dropped, so
+    // this image must also carry its dirty rect
+    if (frameReady.load(std::memory_order_relaxed) & FRAME_UPDATED)
+        dirtyRect = OEUnionRect(dirtyRect, lastDirtyRect);
+    
+    frame[frameBack].setDirtyRect(dirtyRect);
+    lastDirtyRect = dirtyRect;
+    
+    frameBack = frameReady.exchange(frameBack | FRAME_UPDATED,
+                                    std::memory_order_acq_rel) & FRAME_INDEX;
+}
@@ -0,0 +1,53 @@
+
+/**
+ * libemulation-hal
+ * Triple buffer
+ * (C) 2012 by Marc S. Ressl (mressl@umich.edu)
+ * Released under the GPL
+ *
+ * Passes images from a posting thread to a reading thread
+ */
+
+#ifndef _TRIPLEBUFFER_H
+#define _TRIPLEBUFFER_H
+
+#include <atomic>
+
+#include "OEImage.h"
+
+// Notes:
+// * Images are passed through three buffers: the posting thread fills the
+//   back buffer, the reading thread holds the front buffer, and the third
+//   one holds the newest complete image. Neither thread waits for the other.
+// * post() and clear() must be called from the posting thread, update() and
+//   getImage() from the reading thread.
+// * post() does not copy the whole image, only the rows that were posted
+//   dirty since the back buffer last held an image. Unchanged rows and the
+//   buffer allocations are reused.
+// * An image the reading thread did not take is dropped. The image's dirty
+//   rect then also covers the rows the dropped image changed.
+// * After clear(), the next image is copied whole.
+
+class TripleBuffer
+{
+public:
+    TripleBuffer();
+    
+    void post(OEImage& image);
+    void clear();
+    
+    bool update();
+    OEImage& getImage();
+    
+private:
+    OEImage frame[3];
+    OERect frameStaleRect[3];
+    OEInt frameFront;
+    OEInt frameBack;
+    std::atomic<OEInt> frameReady;
+    OERect lastDirtyRect;
+    
+    void publish(OERect dirtyRect);
+};
+
+#endif
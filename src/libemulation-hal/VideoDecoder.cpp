@@ -0,0 +1,522 @@
+
+/**
+ * libemulation-hal
+ * Video decoder
+ * (C) 2012 by Marc S. Ressl (mressl@umich.edu)
+ * Released under the GPL
+ *
+ * Decodes composite and RGB video images
+ */
+
+#include <math.h>
+#include <pthread.h>
+
+#include "VideoDecoder.h"
+
+// References:
+// * Poynton C., Digital Video and HDTV Algorithms and Interfaces
+
+#define NTSC_I_CUTOFF               1300000
+#define NTSC_Q_CUTOFF               600000
+#define NTSC_IQ_DELTA               (NTSC_I_CUTOFF - NTSC_Q_CUTOFF)
+
+#define MAX_THREADNUM               16
+
+typedef struct
+{
+    VideoDecoder *decoder;
+    OEImage *image;
+    OEImage *decodedImage;
+    OEInt y0;
+    OEInt y1;
+} VideoDecoderBand;
+
+static void *runVideoDecoderBand(void *arg)
+{
+    VideoDecoderBand *band = (VideoDecoderBand *)arg;
+    
+    band->decoder->decodeRows(*band->image, *band->decodedImage,
+                              band->y0, band->y1);
+    
+    return NULL;
+}
+
+// The filter loops run over whole rows, one tap at a time, so the compiler
+// can vectorize them. in has VIDEODECODER_TAPHALF zeros on each side
+
+static void filterRow(const float *in, float *out, const float *c, OEInt width)
+{
+    for (OEInt x = 0; x < width; x++)
+        out[x] = c[0] * in[x];
+    
+    for (OEInt k = 1; k <= VIDEODECODER_TAPHALF; k++)
+    {
+        const float ck = c[k];
+        const float *right = in + k;
+        const float *left = in - k;
+        
+        for (OEInt x = 0; x < width; x++)
+            out[x] += ck * (right[x] + left[x]);
+    }
+}
+
+VideoDecoder::VideoDecoder()
+{
+    threadNum = 1;
+    
+    CanvasDisplayConfiguration configuration;
+    
+    configure(configuration, 14318180, 0, 1, 0);
+}
+
+void VideoDecoder::setThreadNum(OEInt value)
+{
+    threadNum = value ? min(value, (OEInt) MAX_THREADNUM) : 1;
+}
+
+void VideoDecoder::configure(CanvasDisplayConfiguration& configuration,
+                             float sampleRate,
+                             float blackLevel,
+                             float whiteLevel,
+                             float subcarrier)
+{
+    compositeDecoder = ((configuration.videoDecoder == CANVAS_YUV) ||
+                        (configuration.videoDecoder == CANVAS_YIQ) ||
+                        (configuration.videoDecoder == CANVAS_CXA2025AS));
+    
+    // Subcarrier
+    this->subcarrier = subcarrier / sampleRate;
+    
+    // Filters
+    OEVector w = OEVector::chebyshevWindow(VIDEODECODER_TAPNUM, 50);
+    w = w.normalize();
+    
+    OEVector wy, wu, wv;
+    
+    float bandwidth = configuration.videoBandwidth / sampleRate;
+    
+    if (compositeDecoder)
+    {
+        float yBandwidth = configuration.videoLumaBandwidth / sampleRate;
+        float uBandwidth = configuration.videoChromaBandwidth / sampleRate;
+        float vBandwidth = uBandwidth;
+        
+        if (configuration.videoDecoder == CANVAS_YIQ)
+            uBandwidth = uBandwidth + NTSC_IQ_DELTA / sampleRate;
+        
+        // Switch to video bandwidth when no subcarrier
+        if ((subcarrier == 0.0) ||
+            (configuration.videoWhiteOnly))
+        {
+            yBandwidth = bandwidth;
+            uBandwidth = bandwidth;
+            vBandwidth = bandwidth;
+        }
+        
+        wy = w * OEVector::lanczosWindow(VIDEODECODER_TAPNUM, yBandwidth);
+        wy = wy.normalize();
+        
+        wu = w * OEVector::lanczosWindow(VIDEODECODER_TAPNUM, uBandwidth);
+        wu = wu.normalize() * 2;
+        
+        wv = w * OEVector::lanczosWindow(VIDEODECODER_TAPNUM, vBandwidth);
+        wv = wv.normalize() * 2;
+    }
+    else
+    {
+        wy = w * OEVector::lanczosWindow(VIDEODECODER_TAPNUM, bandwidth);
+        wu = wv = wy = wy.normalize();
+    }
+    
+    filter[0] = wy;
+    filter[1] = wu;
+    filter[2] = wv;
+    
+    // Decoder matrix
+    decoderMatrix = OEMatrix3(1, 0, 0,
+                              0, 1, 0,
+                              0, 0, 1);
+    
+    // Encode
+    if (!compositeDecoder)
+    {
+        // Y'PbPr encoding matrix
+        decoderMatrix = OEMatrix3(0.299F, -0.168736F, 0.5F,
+                                  0.587F, -0.331264F, -0.418688F,
+                                  0.114F, 0.5F, -0.081312F) * decoderMatrix;
+    }
+    
+    // Set hue
+    if (configuration.videoDecoder == CANVAS_MONOCHROME)
+        decoderMatrix = OEMatrix3(1, 0.5F, 0,
+                                  0, 0, 0,
+                                  0, 0, 0) * decoderMatrix;
+    
+    // Disable color decoding when no subcarrier
+    if (compositeDecoder)
+    {
+        if ((subcarrier == 0.0) ||
+            (configuration.videoWhiteOnly))
+        {
+            decoderMatrix = OEMatrix3(1, 0, 0,
+                                      0, 0, 0,
+                                      0, 0, 0) * decoderMatrix;
+        }
+    }
+    
+    // Saturation
+    decoderMatrix = OEMatrix3(1, 0, 0,
+                              0, configuration.videoSaturation, 0,
+                              0, 0, configuration.videoSaturation) * decoderMatrix;
+    
+    // Hue
+    float hue = 2 * (float) M_PI * configuration.videoHue;
+    
+    decoderMatrix = OEMatrix3(1, 0, 0,
+                              0, cosf(hue), -sinf(hue),
+                              0, sinf(hue), cosf(hue)) * decoderMatrix;
+    
+    // Decode
+    switch (configuration.videoDecoder)
+    {
+        case CANVAS_RGB:
+        case CANVAS_MONOCHROME:
+            // Y'PbPr decoder matrix
+            decoderMatrix = OEMatrix3(1, 1, 1,
+                                      0, -0.344136F, 1.772F,
+                                      1.402F, -0.714136F, 0) * decoderMatrix;
+            break;
+            
+        case CANVAS_YUV:
+        case CANVAS_YIQ:
+            // Y'UV decoder matrix
+            decoderMatrix = OEMatrix3(1, 1, 1,
+                                      0, -0.394642F, 2.032062F,
+                                      1.139883F, -0.580622F, 0) * decoderMatrix;
+            break;
+            
+        case CANVAS_CXA2025AS:
+            // Exchange I and Q
+            decoderMatrix = OEMatrix3(1, 0, 0,
+                                      0, 0, 1,
+                                      0, 1, 0) * decoderMatrix;
+            
+            // Rotate 33 degrees
+            hue = -(float) M_PI * 33 / 180;
+            decoderMatrix = OEMatrix3(1, 0, 0,
+                                      0, cosf(hue), -sinf(hue),
+                                      0, sinf(hue), cosf(hue)) * decoderMatrix;
+            
+            // CXA2025AS decoder matrix
+            decoderMatrix = OEMatrix3(1, 1, 1,
+                                      1.630F, -0.378F, -1.089F,
+                                      0.317F, -0.466F, 1.677F) * decoderMatrix;
+            break;
+    }
+    
+    // Brigthness
+    float brightness = configuration.videoBrightness - blackLevel;
+    
+    if (compositeDecoder)
+        decoderOffset = decoderMatrix * OEMatrix3(brightness, 0, 0,
+                                                  0, 0, 0,
+                                                  0, 0, 0);
+    else
+        decoderOffset = decoderMatrix * OEMatrix3(brightness, 0, 0,
+                                                  brightness, 0, 0,
+                                                  brightness, 0, 0);
+    
+    // Contrast
+    float contrast = configuration.videoContrast;
+    
+    float videoLevel = (whiteLevel - blackLevel);
+    if (videoLevel > 0)
+        contrast /= videoLevel;
+    else
+        contrast = 0;
+    
+    if (contrast < 0)
+        contrast = 0;
+    
+    decoderMatrix *= contrast;
+    
+    // Values for the CPU decoder. The matrix is applied as the shader does,
+    // with row i weighting filtered component i
+    for (OEInt i = 0; i < 3; i++)
+    {
+        for (OEInt k = 0; k <= VIDEODECODER_TAPHALF; k++)
+            coefficient[i][k] = filter[i].getValue(VIDEODECODER_TAPHALF - k);
+        
+        for (OEInt j = 0; j < 3; j++)
+            matrix[i][j] = decoderMatrix.getValue(i, j);
+        
+        offset[i] = decoderOffset.getValue(0, i);
+    }
+    
+    carrierWidth = 0;
+    
+    isConfigurationUpdated = true;
+}
+
+bool VideoDecoder::isCompositeDecoder()
+{
+    return compositeDecoder;
+}
+
+float VideoDecoder::getSubcarrier()
+{
+    return subcarrier;
+}
+
+OEVector VideoDecoder::getFilter(OEInt index)
+{
+    return filter[index];
+}
+
+OEMatrix3 VideoDecoder::getDecoderMatrix()
+{
+    return decoderMatrix;
+}
+
+OEMatrix3 VideoDecoder::getDecoderOffset()
+{
+    return decoderOffset;
+}
+
+void VideoDecoder::decode(OEImage& image, OEImage& decodedImage)
+{
+    OESize size = image.getSize();
+    
+    bool isFullDecode = isConfigurationUpdated;
+    
+    if ((decodedImage.getFormat() != OEIMAGE_RGB) ||
+        (decodedImage.getSize().width != size.width) ||
+        (decodedImage.getSize().height != size.height))
+    {
+        decodedImage.setFormat(OEIMAGE_RGB);
+        decodedImage.setSize(size);
+        
+        isFullDecode = true;
+    }
+    
+    if (compositeDecoder && updateCarrier(image))
+        isFullDecode = true;
+    
+    isConfigurationUpdated = false;
+    
+    OERect dirtyRect = image.getDirtyRect();
+    OEInt y0 = 0;
+    OEInt y1 = (OEInt) size.height;
+    
+    if (!isFullDecode)
+    {
+        if (OEIsEmptyRect(dirtyRect))
+            return;
+        
+        y0 = (OEInt) max(OEMinY(dirtyRect), 0.0F);
+        y1 = (OEInt) min(OEMaxY(dirtyRect), size.height);
+    }
+    
+    decodedImage.setDirtyRect(OEMakeRect(0, y0, size.width, y1 - y0));
+    
+    if ((threadNum < 2) || ((y1 - y0) < threadNum))
+    {
+        decodeRows(image, decodedImage, y0, y1);
+        
+        return;
+    }
+    
+    // Decode bands, the last one on this thread
+    VideoDecoderBand band[MAX_THREADNUM];
+    pthread_t thread[MAX_THREADNUM];
+    bool isThreadCreated[MAX_THREADNUM];
+    
+    for (OEInt i = 0; i < threadNum; i++)
+    {
+        band[i].decoder = this;
+        band[i].image = &image;
+        band[i].decodedImage = &decodedImage;
+        band[i].y0 = y0 + (y1 - y0) * i / threadNum;
+        band[i].y1 = y0 + (y1 - y0) * (i + 1) / threadNum;
+        
+        isThreadCreated[i] = false;
+    }
+    
+    for (OEInt i = 0; i < (threadNum - 1); i++)
+        isThreadCreated[i] = !pthread_create(&thread[i], NULL,
+                                             runVideoDecoderBand, &band[i]);
+    
+    runVideoDecoderBand(&band[threadNum - 1]);
+    
+    for (OEInt i = 0; i < (threadNum - 1); i++)
+    {
+        if (isThreadCreated[i])
+            pthread_join(thread[i], NULL);
+        else
+            runVideoDecoderBand(&band[i]);
+    }
+}
+
+void VideoDecoder::decodeRows(OEImage& image, OEImage& decodedImage, OEInt y0, OEInt y1)
+{
+    OEInt width = (OEInt) image.getSize().width;
+    OEInt bytesPerPixel = image.getBytesPerPixel();
+    OEInt bytesPerRow = image.getBytesPerRow();
+    bool isLuminance = (image.getFormat() == OEIMAGE_LUMINANCE);
+    
+    if (!width || !bytesPerPixel)
+        return;
+    
+    // A luminance image decoded as RGB filters the same row three times
+    OEInt channelNum = (isLuminance && !compositeDecoder) ? 1 : 3;
+    
+    OEInt paddedWidth = width + 2 * VIDEODECODER_TAPHALF;
+    
+    vector<float> in;
+    in.resize(3 * paddedWidth);
+    
+    vector<float> out;
+    out.resize(3 * width);
+    
+    vector<int> rgb;
+    rgb.resize(3 * width);
+    
+    float *channelIn[3];
+    float *channelOut[3];
+    int *channelRGB[3];
+    
+    for (OEInt i = 0; i < 3; i++)
+    {
+        channelIn[i] = &in.front() + i * paddedWidth + VIDEODECODER_TAPHALF;
+        channelOut[i] = &out.front() + ((i < channelNum) ? i : 0) * width;
+        channelRGB[i] = &rgb.front() + i * width;
+    }
+    
+    vector<float> colorBurst = image.getColorBurst();
+    vector<bool> phaseAlternation = image.getPhaseAlternation();
+    
+    for (OEInt y = y0; y < y1; y++)
+    {
+        OEChar *src = image.getPixels() + y * bytesPerRow;
+        
+        // Load, modulating the chroma components with the subcarrier
+        if (isLuminance)
+        {
+            for (OEInt x = 0; x < width; x++)
+                channelIn[0][x] = src[x] * (1.0F / 255.0F);
+        }
+        else
+        {
+            for (OEInt x = 0; x < width; x++)
+                for (OEInt i = 0; i < 3; i++)
+                    channelIn[i][x] = src[x * bytesPerPixel + i] * (1.0F / 255.0F);
+        }
+        
+        if (compositeDecoder)
+        {
+            OEInt burstIndex = y % colorBurst.size();
+            float *carrierSinRow = &carrierSin.front() + burstIndex * width;
+            float *carrierCosRow = &carrierCos.front() + burstIndex * width;
+            float alternation = phaseAlternation[y % phaseAlternation.size()] ? -1 : 1;
+            
+            float *luma = channelIn[0];
+            float *u = channelIn[1];
+            float *v = channelIn[2];
+            
+            if (isLuminance)
+            {
+                for (OEInt x = 0; x < width; x++)
+                {
+                    u[x] = luma[x] * carrierSinRow[x];
+                    v[x] = luma[x] * alternation * carrierCosRow[x];
+                }
+            }
+            else
+            {
+                for (OEInt x = 0; x < width; x++)
+                {
+                    u[x] *= carrierSinRow[x];
+                    v[x] *= alternation * carrierCosRow[x];
+                }
+            }
+        }
+        
+        // Filter
+        for (OEInt i = 0; i < channelNum; i++)
+            filterRow(channelIn[i], channelOut[i], coefficient[i], width);
+        
+        // Convert to RGB. Clamping is done on integers, as float comparisons
+        // keep the loop from vectorizing
+        for (OEInt j = 0; j < 3; j++)
+        {
+            const float m0 = matrix[0][j];
+            const float m1 = matrix[1][j];
+            const float m2 = matrix[2][j];
+            const float o = offset[j];
+            
+            const float *a = channelOut[0];
+            const float *b = channelOut[1];
+            const float *c = channelOut[2];
+            int *value = channelRGB[j];
+            
+            for (OEInt x = 0; x < width; x++)
+            {
+                int v = (int) ((m0 * a[x] + m1 * b[x] + m2 * c[x] + o) * 255 + 0.5F);
+                
+                v = (v < 0) ? 0 : v;
+                v = (v > 255) ? 255 : v;
+                
+                value[x] = v;
+            }
+        }
+        
+        OEChar *dest = decodedImage.getPixels() + y * width * 3;
+        
+        for (OEInt x = 0; x < width; x++)
+        {
+            dest[3 * x + 0] = (OEChar) channelRGB[0][x];
+            dest[3 * x + 1] = (OEChar) channelRGB[1][x];
+            dest[3 * x + 2] = (OEChar) channelRGB[2][x];
+        }
+    }
+}
+
+// The subcarrier phase of each pixel only depends on the color burst of its
+// row, so sines and cosines are computed once per color burst value. A
+// changed color burst or phase alternation requires a full decode
+
+bool VideoDecoder::updateCarrier(OEImage& image)
+{
+    OEInt width = (OEInt) image.getSize().width;
+    vector<float> colorBurst = image.getColorBurst();
+    vector<bool> phaseAlternation = image.getPhaseAlternation();
+    
+    if ((width == carrierWidth) &&
+        (colorBurst == carrierBurst) &&
+        (phaseAlternation == carrierAlternation))
+        return false;
+    
+    carrierWidth = width;
+    carrierBurst = colorBurst;
+    carrierAlternation = phaseAlternation;
+    
+    carrierSin.resize(colorBurst.size() * width);
+    carrierCos.resize(colorBurst.size() * width);
+    
+    for (OEInt i = 0; i < colorBurst.size(); i++)
+    {
+        float c = colorBurst[i] / 2 / (float) M_PI;
+        
+        c -= floorf(c);
+        
+        for (OEInt x = 0; x < width; x++)
+        {
+            double phase = 2 * M_PI * (subcarrier * (x + 0.5) + c);
+            
+            carrierSin[i * width + x] = (float) sin(phase);
+            carrierCos[i * width + x] = (float) cos(phase);
+        }
+    }
+    
+    return true;
+}
@@ -0,0 +1,79 @@
+
+/**
+ * libemulation-hal
+ * Video decoder
+ * (C) 2012 by Marc S. Ressl (mressl@umich.edu)
+ * Released under the GPL
+ *
+ * Decodes composite and RGB video images
+ */
+
+#ifndef _VIDEODECODER_H
+#define _VIDEODECODER_H
+
+#include "OEImage.h"
+#include "OEVector.h"
+#include "OEMatrix3.h"
+
+#include "CanvasInterface.h"
+
+// Notes:
+// * configure() designs the decoder: a 17-tap Chebyshev-windowed Lanczos
+//   filter for each of Y, U and V (R, G and B for the RGB decoders), and
+//   the matrix that converts the filtered signal to RGB.
+// * OpenGLCanvas loads the same filters and matrix into its render shaders.
+//   decode() does the same work on the CPU, producing an OEIMAGE_RGB image.
+// * decode() only redecodes the rows in the image's dirty rect, unless the
+//   image size, color burst or configuration changed.
+// * With more than one thread, decode() splits the rows into bands that
+//   are decoded in parallel.
+
+#define VIDEODECODER_TAPNUM     17
+#define VIDEODECODER_TAPHALF    (VIDEODECODER_TAPNUM / 2)
+
+class VideoDecoder
+{
+public:
+    VideoDecoder();
+    
+    void setThreadNum(OEInt value);
+    
+    void configure(CanvasDisplayConfiguration& configuration,
+                   float sampleRate,
+                   float blackLevel,
+                   float whiteLevel,
+                   float subcarrier);
+    
+    bool isCompositeDecoder();
+    float getSubcarrier();
+    OEVector getFilter(OEInt index);
+    OEMatrix3 getDecoderMatrix();
+    OEMatrix3 getDecoderOffset();
+    
+    void decode(OEImage& image, OEImage& decodedImage);
+    void decodeRows(OEImage& image, OEImage& decodedImage, OEInt y0, OEInt y1);
+    
+private:
+    OEInt threadNum;
+    
+    bool compositeDecoder;
+    float subcarrier;
+    OEVector filter[3];
+    OEMatrix3 decoderMatrix;
+    OEMatrix3 decoderOffset;
+    bool isConfigurationUpdated;
+    
+    float coefficient[3][VIDEODECODER_TAPHALF + 1];
+    float matrix[3][3];
+    float offset[3];
+    
+    OEInt carrierWidth;
+    vector<float> carrierBurst;
+    vector<bool> carrierAlternation;
+    vector<float> carrierSin;
+    vector<float> carrierCos;
+    
+    bool updateCarrier(OEImage& image);
+};
+
+#endif
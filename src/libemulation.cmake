@@ -13,6 +13,7 @@ set(emulation
   ${_libemulation_dir}/Core/OEEmulation.cpp
   ${_libemulation_dir}/Core/OEImage.cpp
   ${_libemulation_dir}/Core/OEPackage.cpp
+  ${_libemulation_dir}/Core/OERewind.cpp
   ${_libemulation_dir}/Core/OESound.cpp
   # Generic libaries
   ${_libemulation_dir}/Implementation/Generic/AddressDecoder.cpp
@@ -20,6 +21,7 @@ set(emulation
   ${_libemulation_dir}/Implementation/Generic/AddressMasker.cpp
   ${_libemulation_dir}/Implementation/Generic/AddressMux.cpp
   ${_libemulation_dir}/Implementation/Generic/AddressOffset.cpp
+  ${_libemulation_dir}/Implementation/Generic/AddressWatcher.cpp
   ${_libemulation_dir}/Implementation/Generic/ATAController.cpp
   ${_libemulation_dir}/Implementation/Generic/ATADevice.cpp
   ${_libemulation_dir}/Implementation/Generic/Audio1Bit.cpp
@@ -68,11 +70,12 @@ set(emulation
   ${_libemulation_dir}/Implementation/Apple/AppleIIVideo.cpp
   ${_libemulation_dir}/Implementation/Apple/AppleLanguageCard.cpp
   ${_libemulation_dir}/Implementation/Apple/AppleSilentype.cpp
-  ${_libemulation_dir}/Implementation/Apple/AppleSilentypeInterfacecard.cpp
+  ${_libemulation_dir}/Implementation/Apple/AppleSilentypeInterfaceCard.cpp
   # Don't Ask
   ${_libemulation_dir}/Implementation/Don\'t\ Ask/SAMDACCard.cpp
   # MOS
   ${_libemulation_dir}/Implementation/MOS/MOS6502.cpp
+  ${_libemulation_dir}/Implementation/MOS/MOS6502Trace.cpp
   # TODO ${_libemulation_dir}/Implementation/MOS/MOS6509.cpp
   ${_libemulation_dir}/Implementation/MOS/MOS6522.cpp
   ${_libemulation_dir}/Implementation/MOS/MOS6530.cpp
@@ -92,9 +95,9 @@ set(emulation
   ${_libemulation_dir}/Implementation/Videx/VidexVideoterm.cpp
   # Western Design Center
   ${_libemulation_dir}/Implementation/WDC/W65C02S.cpp
-  # TODO ${_libemulation_dir}/Implementation/WDC/W65C816S.cpp
+  ${_libemulation_dir}/Implementation/WDC/W65C816S.cpp
   # Zilog
-  # TODO ${_libemulation_dir}/Implementation/Zilog/Z80.cpp
+  ${_libemulation_dir}/Implementation/Zilog/Z80.cpp
   # Interface
   ${_libemulation_dir}/Interface/Generic/MemoryInterface.cpp
   ${_libemulation_dir}/Interface/Host/AudioInterface.cpp
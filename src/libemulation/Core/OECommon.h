@@ -39,6 +39,12 @@ typedef signed long long OESLong;
 
 typedef OELong OEAddress;
 
+typedef struct
+{
+    OEAddress startAddress;
+    OEAddress endAddress;
+} OEAddressRange;
+
 typedef union
 {
 #ifdef BYTES_BIG_ENDIAN
@@ -127,3 +127,56 @@ OELong OEComponent::read64(OEAddress address)
 void OEComponent::write64(OEAddress address, OELong value)
 {
 }
+
+// Returns a host pointer p such that read(a) == p[a - startAddress] and
+// write(a, v) == (p[a - startAddress] = v) for all a in [startAddress, endAddress],
+// or NULL when the range has side effects or is not contiguous in host memory
+
+OEChar *OEComponent::getReadPointer(OEAddress startAddress, OEAddress endAddress)
+{
+    return NULL;
+}
+
+OEChar *OEComponent::getWritePointer(OEAddress startAddress, OEAddress endAddress)
+{
+    return NULL;
+}
+
+// Block access copies through a host pointer when the component provides
+// one for the whole range, and falls back to single byte accesses
+
+void OEComponent::readBlock(OEAddress address, OEChar *data, OEInt size)
+{
+    if (!size)
+        return;
+    
+    OEChar *p = getReadPointer(address, address + size - 1);
+    
+    if (p)
+    {
+        memcpy(data, p, size);
+        
+        return;
+    }
+    
+    for (OEInt i = 0; i < size; i++)
+        data[i] = read(address + i);
+}
+
+void OEComponent::writeBlock(OEAddress address, const OEChar *data, OEInt size)
+{
+    if (!size)
+        return;
+    
+    OEChar *p = getWritePointer(address, address + size - 1);
+    
+    if (p)
+    {
+        memcpy(p, data, size);
+        
+        return;
+    }
+    
+    for (OEInt i = 0; i < size; i++)
+        write(address + i, data[i]);
+}
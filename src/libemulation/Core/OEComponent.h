@@ -20,6 +20,20 @@ class OEComponent;
 typedef vector<OEComponent *> OEComponents;
 typedef map<int, OEComponents> OEObservers;
 
+// Notes:
+// * COMPONENT_GET_STATE appends the state a component keeps outside its
+//   properties to an OEData. COMPONENT_SET_STATE restores it from an
+//   OEData holding exactly what COMPONENT_GET_STATE appended, and fails
+//   when it is invalid. Components without such state ignore both.
+// * Component messages are numbered apart from the messages of each
+//   component interface, which start at 0.
+
+typedef enum
+{
+    COMPONENT_GET_STATE = 0x20000,
+    COMPONENT_SET_STATE,
+} OEComponentMessage;
+
 class OEComponent
 {
 public:
@@ -54,6 +68,14 @@ public:
     virtual OELong read64(OEAddress address);
     virtual void write64(OEAddress address, OELong value);
     
+    // Direct memory access
+    virtual OEChar *getReadPointer(OEAddress startAddress, OEAddress endAddress);
+    virtual OEChar *getWritePointer(OEAddress startAddress, OEAddress endAddress);
+    
+    // Block access
+    virtual void readBlock(OEAddress address, OEChar *data, OEInt size);
+    virtual void writeBlock(OEAddress address, const OEChar *data, OEInt size);
+    
 protected:
     OEObservers observers;
 };
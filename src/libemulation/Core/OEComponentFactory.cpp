@@ -85,6 +85,9 @@
 #include "AERamFactor.h"
 
 #include "W65C02S.h"
+#include "W65C816S.h"
+
+#include "Z80.h"
 // FACTORY_INCLUDE_END - Do not modify this section
 
 #define matchComponent(name) if (className == #name) return new name()
@@ -167,6 +170,9 @@ OEComponent *OEComponentFactory::construct(const string& className)
     matchComponent(AERamFactor);
     
     matchComponent(W65C02S);
+    matchComponent(W65C816S);
+    
+    matchComponent(Z80);
     // FACTORY_CODE_END - Do not modify this section
     
     return NULL;
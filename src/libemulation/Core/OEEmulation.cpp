@@ -22,6 +22,85 @@
 #include "EmulationInterface.h"
 #include "CanvasInterface.h"
 
+#define STATE_VALUE_ALIGN   16
+
+// State stream
+
+static void appendStateInt(OEData *data, OEInt value)
+{
+    OEChar *p = (OEChar *) &value;
+    
+    data->insert(data->end(), p, p + sizeof(OEInt));
+}
+
+static void appendStateString(OEData *data, const string& value)
+{
+    appendStateInt(data, (OEInt) value.size());
+    
+    data->insert(data->end(), value.begin(), value.end());
+}
+
+// Values are padded, so they keep their place in the stream when their
+// length changes slightly
+
+static void appendStateValue(OEData *data, const string& value)
+{
+    OEInt size = (OEInt) value.size();
+    OEInt paddedSize = (size + STATE_VALUE_ALIGN - 1) & ~(STATE_VALUE_ALIGN - 1);
+    
+    appendStateString(data, value);
+    
+    data->insert(data->end(), paddedSize - size, 0);
+}
+
+static void setStateInt(OEData *data, size_t offset, OEInt value)
+{
+    memcpy(&data->front() + offset, &value, sizeof(OEInt));
+}
+
+static bool readStateInt(OEData *data, size_t& offset, OEInt& value)
+{
+    if ((data->size() - offset) < sizeof(OEInt))
+        return false;
+    
+    memcpy(&value, &data->front() + offset, sizeof(OEInt));
+    
+    offset += sizeof(OEInt);
+    
+    return true;
+}
+
+static bool readStateString(OEData *data, size_t& offset, string& value)
+{
+    OEInt size;
+    
+    if (!readStateInt(data, offset, size) ||
+        ((data->size() - offset) < size))
+        return false;
+    
+    value.assign((char *) &data->front() + offset, size);
+    
+    offset += size;
+    
+    return true;
+}
+
+static bool readStateValue(OEData *data, size_t& offset, string& value)
+{
+    if (!readStateString(data, offset, value))
+        return false;
+    
+    OEInt size = (OEInt) value.size();
+    OEInt paddedSize = (size + STATE_VALUE_ALIGN - 1) & ~(STATE_VALUE_ALIGN - 1);
+    
+    if ((data->size() - offset) < (paddedSize - size))
+        return false;
+    
+    offset += paddedSize - size;
+    
+    return true;
+}
+
 OEEmulation::OEEmulation() : OEDocument()
 {
     constructCanvas = NULL;
@@ -30,6 +109,8 @@ OEEmulation::OEEmulation() : OEDocument()
     
     activityCount = 0;
     
+    isStateComponentsValid = false;
+    
     addComponent("emulation", this);
 }
 
@@ -123,10 +204,117 @@ bool OEEmulation::isActive()
     return (activityCount != 0);
 }
 
+bool OEEmulation::saveState(OEData *data)
+{
+    if (!doc)
+        return false;
+    
+    updateStateComponents();
+    
+    data->clear();
+    stateData.clear();
+    
+    appendStateInt(data, OE_STATE_MAGIC);
+    appendStateInt(data, OE_STATE_VERSION);
+    appendStateInt(data, (OEInt) stateComponents.size());
+    
+    string value;
+    
+    for (OEStateComponents::iterator i = stateComponents.begin();
+         i != stateComponents.end();
+         i++)
+    {
+        OEComponent *component = i->component;
+        
+        appendStateString(data, i->id);
+        
+        // Value properties
+        size_t valueNumOffset = data->size();
+        OEInt valueNum = 0;
+        
+        appendStateInt(data, 0);
+        
+        for (vector<string>::iterator j = i->valueNames.begin();
+             j != i->valueNames.end();
+             j++)
+        {
+            if (!component->getValue(*j, value))
+                continue;
+            
+            appendStateString(data, *j);
+            appendStateValue(data, value);
+            
+            valueNum++;
+        }
+        
+        setStateInt(data, valueNumOffset, valueNum);
+        
+        // Data properties
+        size_t dataNumOffset = data->size();
+        OEInt dataNum = 0;
+        
+        appendStateInt(data, 0);
+        
+        for (vector<string>::iterator j = i->dataNames.begin();
+             j != i->dataNames.end();
+             j++)
+        {
+            OEData *value = NULL;
+            
+            if (!component->getData(*j, &value) || !value)
+                continue;
+            
+            appendStateString(data, *j);
+            appendStateInt(data, (OEInt) value->size());
+            
+            OEStateData entry = { component, data->size(), value->size() };
+            stateData.push_back(entry);
+            
+            data->insert(data->end(), value->begin(), value->end());
+            
+            dataNum++;
+        }
+        
+        setStateInt(data, dataNumOffset, dataNum);
+        
+        // Component state
+        OEData state;
+        
+        component->postMessage(this, COMPONENT_GET_STATE, &state);
+        
+        appendStateInt(data, (OEInt) state.size());
+        data->insert(data->end(), state.begin(), state.end());
+    }
+    
+    return true;
+}
+
+bool OEEmulation::loadState(OEData *data)
+{
+    if (!doc)
+        return false;
+    
+    if (!parseState(data, false))
+    {
+        logMessage("invalid state");
+        
+        return false;
+    }
+    
+    return parseState(data, true);
+}
+
+OEStateDataList& OEEmulation::getStateData()
+{
+    return stateData;
+}
+
 
 
 bool OEEmulation::constructDocument(xmlDocPtr doc)
 {
+    isStateComponentsValid = false;
+    
     xmlNodePtr rootNode = xmlDocGetRootElement(doc);
     
     for(xmlNodePtr node = rootNode->children;
@@ -655,6 +843,8 @@ void OEEmulation::destroyDocument(xmlDocPtr doc)
 
 void OEEmulation::destroyDevice(string deviceId)
 {
+    isStateComponentsValid = false;
+    
     xmlNodePtr rootNode = xmlDocGetRootElement(doc);
     
     for(xmlNodePtr node = rootNode->children;
@@ -722,6 +912,160 @@ string OEEmulation::parseValueProperties(string value, map<string, string>& prop
     return value;
 }
 
+void OEEmulation::updateStateComponents()
+{
+    if (isStateComponentsValid)
+        return;
+    
+    stateComponents.clear();
+    
+    xmlNodePtr rootNode = xmlDocGetRootElement(doc);
+    
+    for(xmlNodePtr node = rootNode->children;
+        node;
+        node = node->next)
+    {
+        if (getNodeName(node) != "component")
+            continue;
+        
+        OEStateComponent stateComponent;
+        
+        stateComponent.id = getNodeProperty(node, "id");
+        stateComponent.component = getComponent(stateComponent.id);
+        
+        if (!stateComponent.component)
+            continue;
+        
+        for(xmlNodePtr propertyNode = node->children;
+            propertyNode;
+            propertyNode = propertyNode->next)
+        {
+            if (getNodeName(propertyNode) != "property")
+                continue;
+            
+            string name = getNodeProperty(propertyNode, "name");
+            
+            if (hasNodeProperty(propertyNode, "value"))
+                stateComponent.valueNames.push_back(name);
+            else if (hasNodeProperty(propertyNode, "data") &&
+                     hasValueProperty(getNodeProperty(propertyNode, "data"), "packagePath"))
+                stateComponent.dataNames.push_back(name);
+        }
+        
+        stateComponents.push_back(stateComponent);
+    }
+    
+    isStateComponentsValid = true;
+}
+
+// When isApplied is false, the stream is only checked
+
+bool OEEmulation::parseState(OEData *data, bool isApplied)
+{
+    size_t offset = 0;
+    OEInt magic, version, componentNum;
+    
+    if (!readStateInt(data, offset, magic) ||
+        (magic != OE_STATE_MAGIC) ||
+        !readStateInt(data, offset, version) ||
+        (version != OE_STATE_VERSION) ||
+        !readStateInt(data, offset, componentNum))
+        return false;
+    
+    vector<OEComponent *> components;
+    vector<OEComponent *> componentsWithState;
+    vector<OEData> componentStates;
+    string id, name, value;
+    
+    for (OEInt i = 0; i < componentNum; i++)
+    {
+        if (!readStateString(data, offset, id))
+            return false;
+        
+        OEComponent *component = isApplied ? getComponent(id) : NULL;
+        
+        // Value properties
+        OEInt valueNum;
+        
+        if (!readStateInt(data, offset, valueNum))
+            return false;
+        
+        for (OEInt j = 0; j < valueNum; j++)
+        {
+            if (!readStateString(data, offset, name) ||
+                !readStateValue(data, offset, value))
+                return false;
+            
+            if (component && !component->setValue(name, value))
+                logMessage("could not set value property '" + name + "' for '" + id + "'");
+        }
+        
+        // Data properties
+        OEInt dataNum;
+        
+        if (!readStateInt(data, offset, dataNum))
+            return false;
+        
+        for (OEInt j = 0; j < dataNum; j++)
+        {
+            OEInt size;
+            
+            if (!readStateString(data, offset, name) ||
+                !readStateInt(data, offset, size) ||
+                ((data->size() - offset) < size))
+                return false;
+            
+            if (component)
+            {
+                OEData value(data->begin() + offset,
+                             data->begin() + offset + size);
+                
+                if (!component->setData(name, &value))
+                    logMessage("could not set data property '" + name + "' for '" + id + "'");
+            }
+            
+            offset += size;
+        }
+        
+        if (component && (valueNum || dataNum))
+            components.push_back(component);
+        
+        // Component state
+        OEInt stateSize;
+        
+        if (!readStateInt(data, offset, stateSize) ||
+            ((data->size() - offset) < stateSize))
+            return false;
+        
+        if (component && stateSize)
+        {
+            componentsWithState.push_back(component);
+            componentStates.push_back(OEData(data->begin() + offset,
+                                             data->begin() + offset + stateSize));
+        }
+        
+        offset += stateSize;
+    }
+    
+    if (offset != data->size())
+        return false;
+    
+    for (vector<OEComponent *>::iterator i = components.begin();
+         i != components.end();
+         i++)
+        (*i)->update();
+    
+    for (OEInt i = 0; i < componentsWithState.size(); i++)
+    {
+        OEComponent *component = componentsWithState[i];
+        
+        if (!component->postMessage(this, COMPONENT_SET_STATE, &componentStates[i]))
+            logMessage("could not set state for '" + getId(component) + "'");
+    }
+    
+    return true;
+}
+
 bool OEEmulation::postMessage(OEComponent *sender, int message, void *data)
 {
     switch (message)
@@ -780,6 +1124,24 @@ bool OEEmulation::postMessage(OEComponent *sender, int message, void *data)
             activityCount--;
             
             return true;
+            
+        case EMULATION_GET_COMPONENT:
+        {
+            EmulationComponent *value = (EmulationComponent *)data;
+            
+            value->component = getComponent(value->id);
+            
+            return (value->component != NULL);
+        }
+            
+        case EMULATION_GET_COMPONENTID:
+        {
+            EmulationComponent *value = (EmulationComponent *)data;
+            
+            value->id = getId(value->component);
+            
+            return (value->id != "");
+        }
     }
     
     return false;
@@ -35,6 +35,50 @@ typedef void (*EmulationDestroyCanvas)(void *userData, OEComponent *canvas);
 
 typedef map<string, OEComponent *> OEComponentsMap;
 
+// Notes:
+// * saveState and loadState store the value properties and the package
+//   data properties of every component, the same state save() writes to
+//   the EDL and package, as a binary stream.
+// * The properties of each component are collected from the document once
+//   and cached, so saving and loading never touch the XML.
+// * Components also keep state that is not published as properties, such
+//   as the control bus event queue or the cycles a CPU has pending. It is
+//   saved with COMPONENT_GET_STATE and restored with COMPONENT_SET_STATE.
+// * A state stream starts with OE_STATE_MAGIC and OE_STATE_VERSION,
+//   followed by one section per component: its id, the value properties
+//   as name/value strings, the data properties as name/size/bytes and the
+//   component state as size/bytes. Integers are stored in host byte order.
+// * Value strings are zero-padded to 16 bytes, so snapshots of the same
+//   machine keep the same layout and can be diffed byte by byte.
+// * loadState checks the whole stream before setting any property, then
+//   updates the components it configured. The component states are set
+//   last, so they override the timers components schedule in update().
+//   Sections of unknown components are skipped.
+// * getStateData lists where the data properties were stored in the last
+//   state saved, so OERewind can skip the pages memory reports unchanged.
+
+#define OE_STATE_MAGIC      0x5345454f
+#define OE_STATE_VERSION    3
+
+typedef struct
+{
+    string id;
+    OEComponent *component;
+    vector<string> valueNames;
+    vector<string> dataNames;
+} OEStateComponent;
+
+typedef vector<OEStateComponent> OEStateComponents;
+
+typedef struct
+{
+    OEComponent *component;
+    size_t offset;
+    size_t size;
+} OEStateData;
+
+typedef vector<OEStateData> OEStateDataList;
+
 class OEEmulation : public OEComponent, public OEDocument
 {
 public:
@@ -54,6 +98,10 @@ public:
     
     bool isActive();
     
+    bool saveState(OEData *data);
+    bool loadState(OEData *data);
+    OEStateDataList& getStateData();
+    
     bool postMessage(OEComponent *sender, int message, void *data);
     
 private:
@@ -67,6 +115,10 @@ private:
     
     OEInt activityCount;
     
+    OEStateComponents stateComponents;
+    bool isStateComponentsValid;
+    OEStateDataList stateData;
+    
     bool constructDocument(xmlDocPtr doc);
     bool constructDevice(string deviceId);
     bool constructComponent(string id, string className);
@@ -92,6 +144,9 @@ private:
     
     bool hasValueProperty(string value, string propertyName);
     string parseValueProperties(string value, map<string, string>& propertiesMap);
+    
+    void updateStateComponents();
+    bool parseState(OEData *data, bool isApplied);
 };
 
 #endif
@@ -81,6 +81,8 @@ void OEImage::init()
     
     colorBurst.push_back(0);
     phaseAlternation.push_back(false);
+    
+    dirtyRect = OEMakeRect(0, 0, 0, 0);
 }
 
 void OEImage::setFormat(OEImageFormat value)
@@ -107,6 +109,8 @@ void OEImage::setSize(OESize s)
     pixels.resize(getBytesPerRow() * size.height);
     
     memset(getPixels(), 0, getBytesPerRow() * size.height);
+    
+    dirtyRect = OEMakeRect(0, 0, size.width, size.height);
 }
 
 OESize OEImage::getSize()
@@ -212,6 +216,17 @@ vector<bool> OEImage::getPhaseAlternation()
     return phaseAlternation;
 }
 
+void OEImage::setDirtyRect(OERect value)
+{
+    dirtyRect = OEIntersectionRect(OEIntegralRect(value),
+                                   OEMakeRect(0, 0, size.width, size.height));
+}
+
+OERect OEImage::getDirtyRect()
+{
+    return dirtyRect;
+}
+
 void OEImage::clear()
 {
     setSize(OEMakeSize(0, 0));
@@ -267,6 +282,8 @@ void OEImage::resize(OESize s, OEColor color)
     for (OEInt y = oldSize.height; y < size.height; y++)
         for (OEInt x = 0; x < size.width; x++)
             setPixel(x, y, color);
+    
+    dirtyRect = OEMakeRect(0, 0, size.width, size.height);
 }
 
 OEColor OEImage::getPixel(OEInt x, OEInt y)
@@ -449,6 +466,7 @@ bool OEImage::load(string path)
                             format = OEIMAGE_RGBA;
                         size = OEMakeSize(width, height);
                         pixels.resize(getBytesPerRow() * size.height);
+                        dirtyRect = OEMakeRect(0, 0, width, height);
                         
                         // Copy image
                         OEChar **rows = (unsigned char **) png_get_rows(png, info);
@@ -270,6 +270,10 @@ inline OEPoint OEGetPosInRect(OEPoint aPoint, OERect aRect)
         return OEMakePoint(OEMaxX(aRect), OEMaxY(aRect) - 1);
 }
 
+// Notes:
+// * The dirty rect tells a canvas which pixels changed since the previous
+//   posted image. It covers the whole image after the size changes.
+
 class OEImage
 {
 public:
@@ -300,6 +304,8 @@ public:
     vector<float> getColorBurst();
     void setPhaseAlternation(vector<bool> value);
     vector<bool> getPhaseAlternation();
+    void setDirtyRect(OERect value);
+    OERect getDirtyRect();
     
     void clear();
     void resize(OESize s, OEColor color);
@@ -324,6 +330,7 @@ private:
     float subcarrier;
     vector<float> colorBurst;
     vector<bool> phaseAlternation;
+    OERect dirtyRect;
     
     void init();
     bool validatePNGHeader(FILE *fp);
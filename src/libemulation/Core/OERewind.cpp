@@ -0,0 +1,410 @@
+
+/**
+ * libemulation
+ * OERewind
+ * (C) 2012 by Marc S. Ressl (mressl@umich.edu)
+ * Released under the GPL
+ *
+ * Keeps a bounded history of emulation state snapshots
+ */
+
+#include <string.h>
+#include <sys/time.h>
+
+#include "OERewind.h"
+
+#include "MemoryInterface.h"
+
+#define DEFAULT_MAXMEMORY           (8 << 20)
+#define DEFAULT_KEYFRAMEINTERVAL    300
+
+// Equal bytes shorter than this are kept inside a literal run
+#define MIN_EQUAL_RUN               8
+
+static double getRewindTime()
+{
+    struct timeval time;
+    
+    gettimeofday(&time, NULL);
+    
+    return time.tv_sec + time.tv_usec * 1E-6;
+}
+
+static void appendDeltaInt(OEData& data, OEInt value)
+{
+    OEChar *p = (OEChar *) &value;
+    
+    data.insert(data.end(), p, p + sizeof(OEInt));
+}
+
+static bool readDeltaInt(OEData& data, size_t& offset, OEInt& value)
+{
+    if ((data.size() - offset) < sizeof(OEInt))
+        return false;
+    
+    memcpy(&value, &data.front() + offset, sizeof(OEInt));
+    
+    offset += sizeof(OEInt);
+    
+    return true;
+}
+
+OERewind::OERewind()
+{
+    emulation = NULL;
+    maxMemory = DEFAULT_MAXMEMORY;
+    keyframeInterval = DEFAULT_KEYFRAMEINTERVAL;
+    
+    snapshotNum = 0;
+    memorySize = 0;
+    restoredIndex = 0;
+    
+    captureNum = 0;
+    captureTime = 0;
+    
+    isKeyframeTracked = false;
+}
+
+void OERewind::setEmulation(OEEmulation *emulation)
+{
+    this->emulation = emulation;
+    
+    clear();
+}
+
+void OERewind::setMaxMemory(size_t value)
+{
+    maxMemory = value;
+    
+    while ((memorySize > maxMemory) && (groups.size() > 1))
+        dropOldest();
+}
+
+void OERewind::setKeyframeInterval(OEInt value)
+{
+    keyframeInterval = value ? value : 1;
+}
+
+bool OERewind::capture()
+{
+    if (!emulation)
+        return false;
+    
+    double startTime = getRewindTime();
+    
+    if (!emulation->saveState(&state))
+        return false;
+    
+    dropNewest(restoredIndex);
+    
+    bool isKeyframe = (!groups.size() ||
+                       ((groups.back().deltas.size() + 1) >= keyframeInterval) ||
+                       (groups.back().keyframe.size() != state.size()));
+    
+    // Start a new group when the state drifted too far from the keyframe
+    if (!isKeyframe)
+    {
+        updateCleanRanges();
+        
+        encodeDelta(groups.back().keyframe);
+        
+        isKeyframe = (delta.size() >= (state.size() / 2));
+    }
+    
+    if (isKeyframe)
+    {
+        groups.push_back(OERewindGroup());
+        
+        groups.back().keyframe = state;
+        
+        memorySize += state.size();
+        
+        clearDirtyPages();
+        
+        keyframeStateData = emulation->getStateData();
+        isKeyframeTracked = true;
+    }
+    else
+    {
+        groups.back().deltas.push_back(delta);
+        
+        memorySize += delta.size();
+    }
+    
+    snapshotNum++;
+    
+    while ((memorySize > maxMemory) && (groups.size() > 1))
+        dropOldest();
+    
+    captureNum++;
+    captureTime += getRewindTime() - startTime;
+    
+    return true;
+}
+
+bool OERewind::restore(OEInt index)
+{
+    if (!emulation || (index >= snapshotNum))
+        return false;
+    
+    isKeyframeTracked = false;
+    
+    // Find the snapshot's group, from the newest
+    OEInt n = index;
+    
+    for (deque<OERewindGroup>::reverse_iterator i = groups.rbegin();
+         i != groups.rend();
+         i++)
+    {
+        OEInt groupSize = (OEInt) i->deltas.size() + 1;
+        
+        if (n >= groupSize)
+        {
+            n -= groupSize;
+            
+            continue;
+        }
+        
+        OEInt deltaIndex = groupSize - 1 - n;
+        
+        bool isLoaded;
+        
+        if (!deltaIndex)
+            isLoaded = emulation->loadState(&i->keyframe);
+        else if (decodeDelta(i->keyframe, i->deltas[deltaIndex - 1]))
+            isLoaded = emulation->loadState(&state);
+        else
+            isLoaded = false;
+        
+        if (isLoaded)
+            restoredIndex = index;
+        
+        return isLoaded;
+    }
+    
+    return false;
+}
+
+void OERewind::clear()
+{
+    groups.clear();
+    
+    snapshotNum = 0;
+    memorySize = 0;
+    restoredIndex = 0;
+    
+    isKeyframeTracked = false;
+}
+
+OEInt OERewind::getSnapshotNum()
+{
+    return snapshotNum;
+}
+
+size_t OERewind::getMemorySize()
+{
+    return memorySize;
+}
+
+OELong OERewind::getCaptureNum()
+{
+    return captureNum;
+}
+
+double OERewind::getCaptureTime()
+{
+    return captureTime;
+}
+
+void OERewind::clearDirtyPages()
+{
+    OEStateDataList& stateData = emulation->getStateData();
+    bool value = true;
+    
+    for (OEStateDataList::iterator i = stateData.begin();
+         i != stateData.end();
+         i++)
+    {
+        i->component->postMessage(NULL, RAM_SET_DIRTYTRACKING, &value);
+        i->component->postMessage(NULL, RAM_CLEAR_DIRTYPAGES, NULL);
+    }
+}
+
+// Lists the state bytes of the memory pages not written since the keyframe
+
+void OERewind::updateCleanRanges()
+{
+    OEStateDataList& stateData = emulation->getStateData();
+    
+    cleanRanges.clear();
+    
+    if (!isKeyframeTracked ||
+        (stateData.size() != keyframeStateData.size()))
+        return;
+    
+    for (size_t i = 0; i < stateData.size(); i++)
+    {
+        if ((stateData[i].component != keyframeStateData[i].component) ||
+            (stateData[i].offset != keyframeStateData[i].offset) ||
+            (stateData[i].size != keyframeStateData[i].size))
+            return;
+    }
+    
+    for (OEStateDataList::iterator i = stateData.begin();
+         i != stateData.end();
+         i++)
+    {
+        OEAddress pageSize = 0;
+        
+        dirtyPages.clear();
+        
+        if (!i->component->postMessage(NULL, RAM_GET_DIRTYPAGESIZE, &pageSize) ||
+            !i->component->postMessage(NULL, RAM_GET_DIRTYPAGES, &dirtyPages) ||
+            ((dirtyPages.size() * pageSize) != i->size))
+            continue;
+        
+        for (size_t j = 0; j < dirtyPages.size(); j++)
+        {
+            if (dirtyPages[j])
+                continue;
+            
+            size_t start = i->offset + j * (size_t) pageSize;
+            
+            if (cleanRanges.size() && (cleanRanges.back().end == start))
+                cleanRanges.back().end += (size_t) pageSize;
+            else
+            {
+                OERewindRange range = { start, start + (size_t) pageSize };
+                
+                cleanRanges.push_back(range);
+            }
+        }
+    }
+}
+
+// A delta is a list of runs: the number of bytes equal to the keyframe,
+// the number of changed bytes, and the changed bytes XOR the keyframe
+
+void OERewind::encodeDelta(OEData& keyframe)
+{
+    OEChar *s = &state.front();
+    OEChar *k = &keyframe.front();
+    size_t size = state.size();
+    
+    delta.clear();
+    
+    size_t i = 0;
+    vector<OERewindRange>::iterator clean = cleanRanges.begin();
+    
+    while (i < size)
+    {
+        size_t equalStart = i;
+        
+        while (i < size)
+        {
+            // Clean ranges are equal, and are skipped
+            if ((clean != cleanRanges.end()) && (i >= clean->start))
+            {
+                i = max(i, clean->end);
+                clean++;
+            }
+            else if (s[i] == k[i])
+                i++;
+            else
+                break;
+        }
+        
+        size_t literalStart = i;
+        size_t literalEnd = i;
+        
+        while (i < size)
+        {
+            if (s[i] != k[i])
+                literalEnd = ++i;
+            else if ((i - literalEnd) >= MIN_EQUAL_RUN)
+                break;
+            else
+                i++;
+        }
+        
+        i = literalEnd;
+        
+        appendDeltaInt(delta, (OEInt) (literalStart - equalStart));
+        appendDeltaInt(delta, (OEInt) (literalEnd - literalStart));
+        
+        for (size_t j = literalStart; j < literalEnd; j++)
+            delta.push_back(s[j] ^ k[j]);
+    }
+}
+
+bool OERewind::decodeDelta(OEData& keyframe, OEData& data)
+{
+    state = keyframe;
+    
+    size_t offset = 0;
+    size_t i = 0;
+    
+    while (offset < data.size())
+    {
+        OEInt equalNum, literalNum;
+        
+        if (!readDeltaInt(data, offset, equalNum) ||
+            !readDeltaInt(data, offset, literalNum))
+            return false;
+        
+        if ((state.size() - i) < equalNum)
+            return false;
+        
+        i += equalNum;
+        
+        if (((state.size() - i) < literalNum) ||
+            ((data.size() - offset) < literalNum))
+            return false;
+        
+        for (OEInt j = 0; j < literalNum; j++)
+            state[i++] ^= data[offset++];
+    }
+    
+    return true;
+}
+
+void OERewind::dropNewest(OEInt num)
+{
+    for (; num && groups.size(); num--)
+    {
+        OERewindGroup& group = groups.back();
+        
+        if (group.deltas.size())
+        {
+            memorySize -= group.deltas.back().size();
+            
+            group.deltas.pop_back();
+        }
+        else
+        {
+            memorySize -= group.keyframe.size();
+            
+            groups.pop_back();
+        }
+        
+        snapshotNum--;
+    }
+    
+    restoredIndex = 0;
+}
+
+void OERewind::dropOldest()
+{
+    OERewindGroup& group = groups.front();
+    
+    memorySize -= group.keyframe.size();
+    
+    for (vector<OEData>::iterator i = group.deltas.begin();
+         i != group.deltas.end();
+         i++)
+        memorySize -= i->size();
+    
+    snapshotNum -= (OEInt) group.deltas.size() + 1;
+    
+    groups.pop_front();
+}
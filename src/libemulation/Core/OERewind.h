@@ -0,0 +1,94 @@
+
+/**
+ * libemulation
+ * OERewind
+ * (C) 2012 by Marc S. Ressl (mressl@umich.edu)
+ * Released under the GPL
+ *
+ * Keeps a bounded history of emulation state snapshots
+ */
+
+#ifndef _OEREWIND_H
+#define _OEREWIND_H
+
+#include <deque>
+
+#include "OEEmulation.h"
+
+// Notes:
+// * capture() stores the emulation state, usually once per video frame.
+// * Snapshots are kept in groups. The first snapshot of a group is a full
+//   keyframe; the others are stored as the XOR against that keyframe,
+//   run-length encoded, so restoring any snapshot decodes only itself.
+// * A group is closed after keyframeInterval snapshots, when the state
+//   size changes, or when a delta would be half the size of the keyframe.
+// * Dirty page tracking is turned on for the memory saved in the state,
+//   and the dirty pages are cleared with each keyframe. Pages still clean
+//   equal the keyframe, so encodeDelta does not compare them. This is
+//   only done while the memory is stored at the same state offsets as in
+//   the keyframe, and not after a restore, which rewrites all memory.
+// * When the history uses more than maxMemory bytes, the oldest groups are
+//   dropped. The newest group is always kept.
+// * restore(index) loads the snapshot index captures back (0 is the
+//   newest). Snapshots can be restored in any order; the next capture()
+//   drops the snapshots newer than the last one restored.
+
+typedef struct
+{
+    OEData keyframe;
+    vector<OEData> deltas;
+} OERewindGroup;
+
+typedef struct
+{
+    size_t start;
+    size_t end;
+} OERewindRange;
+
+class OERewind
+{
+public:
+    OERewind();
+    
+    void setEmulation(OEEmulation *emulation);
+    void setMaxMemory(size_t value);
+    void setKeyframeInterval(OEInt value);
+    
+    bool capture();
+    bool restore(OEInt index);
+    void clear();
+    
+    OEInt getSnapshotNum();
+    size_t getMemorySize();
+    OELong getCaptureNum();
+    double getCaptureTime();
+    
+private:
+    OEEmulation *emulation;
+    size_t maxMemory;
+    OEInt keyframeInterval;
+    
+    deque<OERewindGroup> groups;
+    OEInt snapshotNum;
+    size_t memorySize;
+    OEInt restoredIndex;
+    
+    OELong captureNum;
+    double captureTime;
+    
+    OEData state;
+    OEData delta;
+    OEStateDataList keyframeStateData;
+    bool isKeyframeTracked;
+    vector<OERewindRange> cleanRanges;
+    OEData dirtyPages;
+    
+    void clearDirtyPages();
+    void updateCleanRanges();
+    void encodeDelta(OEData& keyframe);
+    bool decodeDelta(OEData& keyframe, OEData& data);
+    void dropNewest(OEInt num);
+    void dropOldest();
+};
+
+#endif
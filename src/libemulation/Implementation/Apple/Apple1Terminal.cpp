@@ -421,12 +421,26 @@ void Apple1Terminal::drawFrame()
     vramp[cursorY * BLOCK_WIDTH + cursorX] = cursorChar;
 }
 
+// The screen is changed through the vram's write methods, so that dirty
+// page tracking sees the changes. The cursor is only placed through the
+// pointer while the canvas is drawn
+
+void Apple1Terminal::clearLine(OEInt y)
+{
+    OEChar line[BLOCK_WIDTH];
+    
+    memset(line, ' ', BLOCK_WIDTH);
+    
+    vram->writeBlock(y * BLOCK_WIDTH, line, BLOCK_WIDTH);
+}
+
 void Apple1Terminal::clearScreen()
 {
     if (!vramp)
         return;
     
-    memset(vramp, ' ', BLOCK_HEIGHT * BLOCK_WIDTH);
+    for (OEInt y = 0; y < BLOCK_HEIGHT; y++)
+        clearLine(y);
     
     cursorX = 0;
     cursorY = 0;
@@ -448,7 +462,7 @@ void Apple1Terminal::putChar(OEChar c)
     }
     else if ((c >= 0x20) && (c <= 0x7f))
     {
-        vramp[cursorY * BLOCK_WIDTH + cursorX] = c;
+        vram->write(cursorY * BLOCK_WIDTH + cursorX, c);
         
         cursorX++;
         if (cursorX >= BLOCK_WIDTH)
@@ -464,8 +478,10 @@ void Apple1Terminal::putChar(OEChar c)
     {
         cursorY = BLOCK_HEIGHT - 1;
         
-        memmove(vramp, vramp + BLOCK_WIDTH, (BLOCK_HEIGHT - 1) * BLOCK_WIDTH);
-        memset(vramp + (BLOCK_HEIGHT - 1) * BLOCK_WIDTH, ' ', BLOCK_WIDTH);
+        for (OEInt y = 0; y < (BLOCK_HEIGHT - 1); y++)
+            vram->writeBlock(y * BLOCK_WIDTH, vramp + (y + 1) * BLOCK_WIDTH, BLOCK_WIDTH);
+        
+        clearLine(BLOCK_HEIGHT - 1);
         
         updateCanvas = true;
     }
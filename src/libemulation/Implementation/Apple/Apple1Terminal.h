@@ -66,6 +66,7 @@ private:
     void scheduleNextTimer(OESLong cycles);
     void drawFrame();
     
+    void clearLine(OEInt y);
     void clearScreen();
     void putChar(OEChar c);
     void sendKey(CanvasUnicodeChar key);
@@ -17,6 +17,8 @@
  * The stepper motor has an inertial time constant of approx. 2 ms.
  */
 
+#include <string.h>
+
 #include "AppleDiskDrive525.h"
 
 #include "DeviceInterface.h"
@@ -49,6 +51,7 @@ AppleDiskDrive525::AppleDiskDrive525()
     trackDataIndex = 0;
     
     zeroCount = 0;
+    noiseSeed = 1;
     
     isModified = false;
     
@@ -234,7 +237,7 @@ bool AppleDiskDrive525::postMessage(OEComponent *sender, int message, void *data
                 OEInt id = 0;
                 controlBus->postMessage(this, CONTROLBUS_INVALIDATE_TIMERS, &id);
                 
-                ControlBusTimer timer = { 0.0005 * APPLEII_CLOCKFREQUENCY, 0 };
+                ControlBusTimer timer = { (OESLong) (0.0005 * APPLEII_CLOCKFREQUENCY), 0 };
                 controlBus->postMessage(this, CONTROLBUS_SCHEDULE_TIMER, &timer);
             }
             
@@ -250,11 +253,67 @@ bool AppleDiskDrive525::postMessage(OEComponent *sender, int message, void *data
             trackDataIndex %= trackDataSize;
             
             return true;
+            
+        case COMPONENT_GET_STATE:
+            getState((OEData *)data);
+            
+            return true;
+            
+        case COMPONENT_SET_STATE:
+            return setState((OEData *)data);
 	}
 	
 	return false;
 }
 
+// The state holds the stepper, the head position on the track and the
+// noise generator
+
+void AppleDiskDrive525::getState(OEData *data)
+{
+    AppleDiskDrive525State state;
+    
+    memset(&state, 0, sizeof(state));
+    
+    state.phaseControl = phaseControl;
+    state.phaseCycles = phaseCycles;
+    state.phaseDirection = phaseDirection;
+    state.phaseLastBump = phaseLastBump;
+    state.phaseStop = phaseStop;
+    state.phaseAlign = phaseAlign;
+    state.trackDataIndex = trackDataIndex;
+    state.zeroCount = zeroCount;
+    state.noiseSeed = noiseSeed;
+    
+    OEChar *p = (OEChar *) &state;
+    
+    data->insert(data->end(), p, p + sizeof(state));
+}
+
+bool AppleDiskDrive525::setState(OEData *data)
+{
+    AppleDiskDrive525State state;
+    
+    if (data->size() != sizeof(state))
+        return false;
+    
+    memcpy(&state, &data->front(), sizeof(state));
+    
+    phaseControl = state.phaseControl;
+    phaseCycles = state.phaseCycles;
+    phaseDirection = state.phaseDirection;
+    phaseLastBump = state.phaseLastBump;
+    phaseStop = state.phaseStop;
+    phaseAlign = state.phaseAlign;
+    trackDataIndex = state.trackDataIndex;
+    zeroCount = state.zeroCount;
+    noiseSeed = state.noiseSeed;
+    
+    trackDataIndex %= trackDataSize;
+    
+    return true;
+}
+
 void AppleDiskDrive525::notify(OEComponent *sender, int notification, void *data)
 {
     switch (((ControlBusTimer *)data)->id)
@@ -335,7 +394,7 @@ void AppleDiskDrive525::notify(OEComponent *sender, int notification, void *data
             OEInt id = 1;
             controlBus->postMessage(this, CONTROLBUS_INVALIDATE_TIMERS, &id);
             
-            ControlBusTimer timer = { 0.05 * APPLEII_CLOCKFREQUENCY, 1 };
+            ControlBusTimer timer = { (OESLong) (0.05 * APPLEII_CLOCKFREQUENCY), 1 };
             controlBus->postMessage(this, CONTROLBUS_SCHEDULE_TIMER, &timer);
             
             break;
@@ -376,19 +435,29 @@ OEChar AppleDiskDrive525::read(OEAddress address)
         zeroCount = 0;
         
         // Weak bit support
-        value = ((random() & 0xff) > value);
+        value = ((getNoise() & 0xff) > value);
     }
     else
     {
         // MC3470 spurious bit behavior
         zeroCount++;
         if (zeroCount > 3)
-			value = ((random() & 0x1f) == 0x1f);
+			value = ((getNoise() & 0x1f) == 0x1f);
     }
     
     return value;
 }
 
+// The noise comes from a generator of the drive's own, so that a loaded
+// state replays it
+
+OEInt AppleDiskDrive525::getNoise()
+{
+    noiseSeed = noiseSeed * 1103515245 + 12345;
+    
+    return (noiseSeed >> 16) & 0x7fff;
+}
+
 void AppleDiskDrive525::write(OEAddress address, OEChar value)
 {
     trackData[trackDataIndex] = value;
@@ -509,7 +578,7 @@ bool AppleDiskDrive525::openDiskImage(string path)
         {
             isOpenSound = true;
             
-            ControlBusTimer timer = { 1.0 * APPLEII_CLOCKFREQUENCY, 2 };
+            ControlBusTimer timer = { (OESLong) (1.0 * APPLEII_CLOCKFREQUENCY), 2 };
             controlBus->postMessage(this, CONTROLBUS_SCHEDULE_TIMER, &timer);
         }
         else
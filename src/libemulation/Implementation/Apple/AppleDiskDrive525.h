@@ -14,6 +14,19 @@
 
 #include "diskimage.h"
 
+typedef struct
+{
+    OEInt phaseControl;
+    OELong phaseCycles;
+    OESInt phaseDirection;
+    bool phaseLastBump;
+    bool phaseStop;
+    bool phaseAlign;
+    OEInt trackDataIndex;
+    OEInt zeroCount;
+    OEInt noiseSeed;
+} AppleDiskDrive525State;
+
 class AppleDiskDrive525 : public OEComponent
 {
 public:
@@ -65,11 +78,13 @@ private:
     OEInt trackDataIndex;
     
     OEInt zeroCount;
+    OEInt noiseSeed;
     
     bool isModified;
     
     bool isOpenSound;
     
+    OEInt getNoise();
     OESInt getStepperDelta(OESInt position, OEInt phaseControl);
     void updateTrack(OEInt value);
     
@@ -78,4 +93,7 @@ private:
     
     bool openDiskImage(string path);
     bool closeDiskImage();
+    
+    void getState(OEData *data);
+    bool setState(OEData *data);
 };
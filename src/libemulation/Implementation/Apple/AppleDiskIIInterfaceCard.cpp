@@ -8,6 +8,8 @@
  * Implements an Apple Disk II interface card
  */
 
+#include <string.h>
+
 #include "AppleDiskIIInterfaceCard.h"
 
 #include "ControlBusInterface.h"
@@ -32,6 +34,7 @@ typedef enum
 AppleDiskIIInterfaceCard::AppleDiskIIInterfaceCard()
 {
 	controlBus = NULL;
+	controlBusClock = NULL;
     drive[0] = &dummyDrive;
     drive[1] = &dummyDrive;
     drive[2] = &dummyDrive;
@@ -122,6 +125,9 @@ bool AppleDiskIIInterfaceCard::init()
     OECheckComponent(controlBus);
     OECheckComponent(floatingBus);
     
+    controlBus->postMessage(this, CONTROLBUS_GET_CLOCK, &controlBusClock);
+    OECheckComponent(controlBusClock);
+    
     update();
     
     return true;
@@ -136,6 +142,66 @@ void AppleDiskIIInterfaceCard::update()
     updateDriveSelection(driveSel);
 }
 
+bool AppleDiskIIInterfaceCard::postMessage(OEComponent *sender, int message, void *data)
+{
+    switch (message)
+    {
+        case COMPONENT_GET_STATE:
+            getState((OEData *)data);
+            
+            return true;
+            
+        case COMPONENT_SET_STATE:
+            return setState((OEData *)data);
+    }
+    
+    return false;
+}
+
+// The state holds the sequencer and the bit clock, which is stamped with
+// control bus cycles
+
+void AppleDiskIIInterfaceCard::getState(OEData *data)
+{
+    AppleDiskIIInterfaceCardState state;
+    
+    memset(&state, 0, sizeof(state));
+    
+    state.lastCycles = lastCycles;
+    state.driveBitClock = driveBitClock;
+    state.timerOn = timerOn;
+    state.reset = reset;
+    state.driveEnableControl = driveEnableControl;
+    state.sequencerMode = sequencerMode;
+    state.sequencerState = sequencerState;
+    state.dataRegister = dataRegister;
+    
+    OEChar *p = (OEChar *) &state;
+    
+    data->insert(data->end(), p, p + sizeof(state));
+}
+
+bool AppleDiskIIInterfaceCard::setState(OEData *data)
+{
+    AppleDiskIIInterfaceCardState state;
+    
+    if (data->size() != sizeof(state))
+        return false;
+    
+    memcpy(&state, &data->front(), sizeof(state));
+    
+    lastCycles = state.lastCycles;
+    driveBitClock = state.driveBitClock;
+    timerOn = state.timerOn;
+    reset = state.reset;
+    driveEnableControl = state.driveEnableControl;
+    sequencerMode = state.sequencerMode;
+    sequencerState = state.sequencerState;
+    dataRegister = state.dataRegister;
+    
+    return true;
+}
+
 void AppleDiskIIInterfaceCard::notify(OEComponent *sender, int notification, void *data)
 {
     switch (notification)
@@ -277,12 +343,12 @@ void AppleDiskIIInterfaceCard::setDriveOn(bool value)
     
     if (driveOn)
     {
-        controlBus->postMessage(this, CONTROLBUS_GET_CYCLES, &lastCycles);
+        lastCycles = getControlBusCycles(controlBusClock);
         driveBitClock = 0;
     }
     else
     {
-        ControlBusTimer timer = { 1.0 * APPLEII_CLOCKFREQUENCY, 0};
+        ControlBusTimer timer = { (OESLong) (1.0 * APPLEII_CLOCKFREQUENCY), 0};
         
         controlBus->postMessage(this, CONTROLBUS_SCHEDULE_TIMER, &timer);
         
@@ -352,9 +418,7 @@ void AppleDiskIIInterfaceCard::updateSequencer()
     if (!driveEnableControl)
         return;
     
-    OELong cycles;
-    
-    controlBus->postMessage(this, CONTROLBUS_GET_CYCLES, &cycles);
+    OELong cycles = getControlBusCycles(controlBusClock);
     
     driveBitClock += (cycles - lastCycles) << 3;
     OELong bitTiming;
@@ -13,6 +13,20 @@
 
 #include "OEComponent.h"
 
+#include "ControlBusInterface.h"
+
+typedef struct
+{
+    OELong lastCycles;
+    OELong driveBitClock;
+    bool timerOn;
+    bool reset;
+    bool driveEnableControl;
+    OEInt sequencerMode;
+    bool sequencerState;
+    OEChar dataRegister;
+} AppleDiskIIInterfaceCardState;
+
 class AppleDiskIIInterfaceCard : public OEComponent
 {
 public:
@@ -24,6 +38,8 @@ public:
     bool init();
 	void update();
     
+    bool postMessage(OEComponent *sender, int message, void *data);
+    
     void notify(OEComponent *sender, int notification, void *data);
     
     OEChar read(OEAddress address);
@@ -45,6 +61,7 @@ protected:
     
 private:
 	OEComponent *controlBus;
+	ControlBusClock *controlBusClock;
 	OEComponent *drive[5];
     
     OEInt phaseControl;
@@ -68,6 +85,9 @@ private:
     void updateDriveEnableControl();
     void updateDriveEnabled();
     void updateDriveSelection(OEInt value);
+    
+    void getState(OEData *data);
+    bool setState(OEData *data);
 };
 
 #endif
@@ -8,6 +8,8 @@
  * Controls an Apple Graphics Tablet Interface Card
  */
 
+#include <string.h>
+
 #include "AppleGraphicsTabletInterfaceCard.h"
 
 #include "ControlBusInterface.h"
@@ -73,6 +75,53 @@ bool AppleGraphicsTabletInterfaceCard::init()
     return true;
 }
 
+bool AppleGraphicsTabletInterfaceCard::postMessage(OEComponent *sender, int message, void *data)
+{
+    switch (message)
+    {
+        case COMPONENT_GET_STATE:
+            getState((OEData *)data);
+            
+            return true;
+            
+        case COMPONENT_SET_STATE:
+            return setState((OEData *)data);
+    }
+    
+    return false;
+}
+
+// The state holds the timer, which is stamped with control bus cycles
+
+void AppleGraphicsTabletInterfaceCard::getState(OEData *data)
+{
+    AppleGraphicsTabletInterfaceCardState state;
+    
+    memset(&state, 0, sizeof(state));
+    
+    state.timerCount = timerCount;
+    state.timerCycles = timerCycles;
+    
+    OEChar *p = (OEChar *) &state;
+    
+    data->insert(data->end(), p, p + sizeof(state));
+}
+
+bool AppleGraphicsTabletInterfaceCard::setState(OEData *data)
+{
+    AppleGraphicsTabletInterfaceCardState state;
+    
+    if (data->size() != sizeof(state))
+        return false;
+    
+    memcpy(&state, &data->front(), sizeof(state));
+    
+    timerCount = state.timerCount;
+    timerCycles = state.timerCycles;
+    
+    return true;
+}
+
 void AppleGraphicsTabletInterfaceCard::notify(OEComponent *sender, int notification, void *data)
 {
     if (sender == graphicsTablet)
@@ -10,6 +10,12 @@
 
 #include "OEComponent.h"
 
+typedef struct
+{
+    OEInt timerCount;
+    OELong timerCycles;
+} AppleGraphicsTabletInterfaceCardState;
+
 class AppleGraphicsTabletInterfaceCard : public OEComponent
 {
 public:
@@ -18,6 +24,8 @@ public:
     bool setRef(string name, OEComponent *ref);
     bool init();
     
+    bool postMessage(OEComponent *sender, int message, void *data);
+    
     void notify(OEComponent *sender, int notification, void *data);
     
     OEChar read(OEAddress address);
@@ -43,4 +51,7 @@ private:
     
     void setTimer(OEInt value);
     void updateCount();
+    
+    void getState(OEData *data);
+    bool setState(OEData *data);
 };
@@ -33,7 +33,7 @@ bool AppleIIAddressDecoder::postMessage(OEComponent *sender, int message, void *
             return removeMemoryMap(ioMemoryMaps, (MemoryMap *) data);
     }
     
-    return false;
+    return AddressDecoder::postMessage(sender, message, data);
 }
 
 void AppleIIAddressDecoder::updateReadWriteMap(OEAddress startAddress, OEAddress endAddress)
@@ -8,6 +8,8 @@
  * Controls Apple II audio output
  */
 
+#include <string.h>
+
 #include "AppleIIAudioOut.h"
 
 #include "ControlBusInterface.h"
@@ -66,6 +68,53 @@ bool AppleIIAudioOut::init()
     return true;
 }
 
+bool AppleIIAudioOut::postMessage(OEComponent *sender, int message, void *data)
+{
+    switch (message)
+    {
+        case COMPONENT_GET_STATE:
+            getState((OEData *)data);
+            
+            return true;
+            
+        case COMPONENT_SET_STATE:
+            return setState((OEData *)data);
+    }
+    
+    return Audio1Bit::postMessage(sender, message, data);
+}
+
+// The state holds the relaxation state, which is stamped with control bus cycles
+
+void AppleIIAudioOut::getState(OEData *data)
+{
+    AppleIIAudioOutState state;
+    
+    memset(&state, 0, sizeof(state));
+    
+    state.lastCycles = lastCycles;
+    state.relaxationState = relaxationState;
+    
+    OEChar *p = (OEChar *) &state;
+    
+    data->insert(data->end(), p, p + sizeof(state));
+}
+
+bool AppleIIAudioOut::setState(OEData *data)
+{
+    AppleIIAudioOutState state;
+    
+    if (data->size() != sizeof(state))
+        return false;
+    
+    memcpy(&state, &data->front(), sizeof(state));
+    
+    lastCycles = state.lastCycles;
+    relaxationState = state.relaxationState;
+    
+    return true;
+}
+
 OEChar AppleIIAudioOut::read(OEAddress address)
 {
     write(address, 0);
@@ -10,6 +10,12 @@
 
 #include "Audio1Bit.h"
 
+typedef struct
+{
+    OELong lastCycles;
+    bool relaxationState;
+} AppleIIAudioOutState;
+
 class AppleIIAudioOut : public Audio1Bit
 {
 public:
@@ -20,6 +26,8 @@ public:
 	bool setRef(string name, OEComponent *ref);
 	bool init();
     
+    bool postMessage(OEComponent *sender, int message, void *data);
+    
 	OEChar read(OEAddress address);
 	void write(OEAddress address, OEChar value);
 	
@@ -31,4 +39,7 @@ private:
     
     OELong lastCycles;
     bool relaxationState;
+    
+    void getState(OEData *data);
+    bool setState(OEData *data);
 };
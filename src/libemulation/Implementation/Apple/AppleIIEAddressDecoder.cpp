@@ -45,7 +45,7 @@ bool AppleIIEAddressDecoder::postMessage(OEComponent *sender, int message, void
             return removeMemoryMap(internalMemoryMaps, (MemoryMap *) data);
     }
 
-    return false;
+    return AddressDecoder::postMessage(sender, message, data);
 }
 
 void AppleIIEAddressDecoder::updateReadWriteMap(OEAddress startAddress, OEAddress endAddress)
@@ -14,6 +14,13 @@
 #include "AppleIIInterface.h"
 #include "ControlBusInterface.h"
 
+#define AUXMEM_ALTZP    (1 << 0)
+#define AUXMEM_RAMRD    (1 << 1)
+#define AUXMEM_RAMWRT   (1 << 2)
+#define AUXMEM_80STORE  (1 << 3)
+#define AUXMEM_HIRES    (1 << 4)
+#define AUXMEM_PAGE2    (1 << 5)
+
 AppleIIEMMU::AppleIIEMMU()
 {
     bankSwitcher = NULL;
@@ -24,6 +31,8 @@ AppleIIEMMU::AppleIIEMMU()
     romC0DF = NULL;
     video = NULL;
     
+    videoState = NULL;
+    
     bank1 = false;
     hramRead = false;
     preWrite = false;
@@ -163,6 +172,12 @@ bool AppleIIEMMU::init()
         return false;
     }
 
+    video->postMessage(this, APPLEII_GET_VIDEOSTATEPOINTER, &videoState);
+    if (!videoState) {
+        logMessage("video component does not publish its state");
+        return false;
+    }
+
     hramMap.component = bankSwitcher;
     hramMap.startAddress = 0xd000;
     hramMap.endAddress = 0xffff;
@@ -183,6 +198,7 @@ bool AppleIIEMMU::init()
     updateBankSwitcher();
     updateBankOffset();
 
+    initAuxmemMasks();
     updateAuxmem();
     updateCxxxRom();
 
@@ -265,16 +281,13 @@ OEChar AppleIIEMMU::read(OEAddress address)
             case 0xC016: val = altzp; break;
             case 0xC017: val = slotc3rom; break;
             case 0xC018: val = _80store; break;
-            case 0xC019:
-                bool vbl;
-                video->postMessage(this, APPLEII_IS_VBL, &vbl);
-                val = !vbl; break;
-            case 0xC01A: val = getVideoBool("text"); break;
-            case 0xC01B: val = getVideoBool("mixed"); break;
+            case 0xC019: val = !OEGetBit(*videoState, APPLEII_VIDEOSTATE_VBL); break;
+            case 0xC01A: val = OEGetBit(*videoState, APPLEII_VIDEOSTATE_TEXT); break;
+            case 0xC01B: val = OEGetBit(*videoState, APPLEII_VIDEOSTATE_MIXED); break;
             case 0xC01C: val = page2; break;
             case 0xC01D: val = hires; break;
-            case 0xC01E: val = getVideoBool("altchrset"); break;
-            case 0xC01F: val = getVideoBool("80col"); break;
+            case 0xC01E: val = OEGetBit(*videoState, APPLEII_VIDEOSTATE_ALTCHRSET); break;
+            case 0xC01F: val = OEGetBit(*videoState, APPLEII_VIDEOSTATE_80COL); break;
         }
         if (val) {
             return 0x80 | kbd;
@@ -305,15 +318,6 @@ OEChar AppleIIEMMU::read(OEAddress address)
     return floatingBus->read(address);
 }
 
-bool AppleIIEMMU::getVideoBool(string property) {
-    string value;
-    if (!video->getValue(property, value)) {
-        logMessage("unable to retrieve video property '" + property + "'");
-        return false;
-    };
-    return getOEInt(value);
-}
-
 void AppleIIEMMU::write(OEAddress address, OEChar value)
 {
     // High RAM.
@@ -393,6 +397,8 @@ void AppleIIEMMU::updateBankSwitcher()
         (hramMap.write == hramWrite))
         return;
     
+    memoryBus->postMessage(this, ADDRESSDECODER_BEGIN_UPDATE, NULL);
+    
     if (hramMap.read || hramMap.write)
         memoryBus->postMessage(this, APPLEII_UNMAP_INTERNAL, &hramMap);
     
@@ -401,9 +407,31 @@ void AppleIIEMMU::updateBankSwitcher()
     
     if (hramMap.read || hramMap.write)
         memoryBus->postMessage(this, APPLEII_MAP_INTERNAL, &hramMap);
+    
+    memoryBus->postMessage(this, ADDRESSDECODER_COMMIT_UPDATE, NULL);
 }
 
-void AppleIIEMMU::updateAuxmem() {
+// The ram mapper selection only depends on six switches, so all of its
+// masks are translated once at init.
+
+void AppleIIEMMU::initAuxmemMasks() {
+    for (OEInt i = 0; i < APPLEIIEMMU_AUXMEMMASKNUM; i++) {
+        AddressMapperMask mask;
+        mask.sel = getAuxmemSel(OEGetBit(i, AUXMEM_ALTZP),
+                                OEGetBit(i, AUXMEM_RAMRD),
+                                OEGetBit(i, AUXMEM_RAMWRT),
+                                OEGetBit(i, AUXMEM_80STORE),
+                                OEGetBit(i, AUXMEM_HIRES),
+                                OEGetBit(i, AUXMEM_PAGE2));
+        mask.mask = 0;
+        ramMapper->postMessage(this, ADDRESSMAPPER_GET_MASK, &mask);
+        
+        auxmemMasks[i] = mask.mask;
+    }
+}
+
+string AppleIIEMMU::getAuxmemSel(bool altzp, bool ramrd, bool ramwrt,
+                                 bool _80store, bool hires, bool page2) {
     string sel;
 
     sel = altzp ? "Aux00_01,AuxC0_FF" : "Main00_01,MainC0_FF";
@@ -441,10 +469,24 @@ void AppleIIEMMU::updateAuxmem() {
             }
         }
     }
-    ramMapper->postMessage(this, ADDRESSMAPPER_SELECT, &sel);
+    return sel;
+}
+
+void AppleIIEMMU::updateAuxmem() {
+    OEInt i = 0;
+    OESetBit(i, AUXMEM_ALTZP, altzp);
+    OESetBit(i, AUXMEM_RAMRD, ramrd);
+    OESetBit(i, AUXMEM_RAMWRT, ramwrt);
+    OESetBit(i, AUXMEM_80STORE, _80store);
+    OESetBit(i, AUXMEM_HIRES, hires);
+    OESetBit(i, AUXMEM_PAGE2, page2);
+    
+    ramMapper->postMessage(this, ADDRESSMAPPER_SELECT_MASK, &auxmemMasks[i]);
 }
 
 void AppleIIEMMU::updateCxxxRom() {
+    memoryBus->postMessage(this, ADDRESSDECODER_BEGIN_UPDATE, NULL);
+
     for (int i=0; i < 4; i++) {
         MemoryMap *map = &cxxxMaps[i];
         if (map->read||map->write)
@@ -463,4 +505,6 @@ void AppleIIEMMU::updateCxxxRom() {
         if (map->read||map->write)
             memoryBus->postMessage(this, APPLEII_MAP_CXXX, map);
     }
+
+    memoryBus->postMessage(this, ADDRESSDECODER_COMMIT_UPDATE, NULL);
 }
@@ -12,6 +12,8 @@
 
 #include "MemoryInterface.h"
 
+#define APPLEIIEMMU_AUXMEMMASKNUM   (1 << 6)
+
 class AppleIIEMMU : public OEComponent
 {
 public:
@@ -54,12 +56,16 @@ private:
     // Copies of the video's values
     bool hires;
     bool page2;
+    OEInt *videoState;
     
     void setBank1(bool value);
     void updateBankOffset();
     void updateBankSwitcher();
 
-    bool getVideoBool(string property);
+    OELong auxmemMasks[APPLEIIEMMU_AUXMEMMASKNUM];
+    void initAuxmemMasks();
+    string getAuxmemSel(bool altzp, bool ramrd, bool ramwrt,
+                        bool _80store, bool hires, bool page2);
     void updateAuxmem();
     
     MemoryMap cxxxMaps[4];
@@ -10,6 +10,7 @@
  */
 
 #include <math.h>
+#include <string.h>
 
 #include "AppleIIEVideo.h"
 
@@ -28,6 +29,9 @@
 #define MODE_HIRES      (1 << 3)
 #define MODE_80COL      (1 << 4)
 
+#define TEXT_MEMORY_SIZE    0x400
+#define HIRES_MEMORY_SIZE   0x2000
+
 #define CHAR_NUM        0x100
 #define CHAR_WIDTH      16
 #define CHAR_HEIGHT     8
@@ -67,6 +71,7 @@ enum
 AppleIIEVideo::AppleIIEVideo()
 {
     controlBus = NULL;
+    controlBusClock = NULL;
     gamePort = NULL;
     mmu = NULL;
     monitor = NULL;
@@ -121,6 +126,8 @@ AppleIIEVideo::AppleIIEVideo()
     image.setSampleRate(NTSC_4FSC);
     image.setFormat(OEIMAGE_LUMINANCE);
     imageModified = false;
+    modifiedStart = VERT_DISPLAY;
+    modifiedEnd = 0;
     
     frameStart = 0;
     frameCycleNum = 0;
@@ -129,6 +136,10 @@ AppleIIEVideo::AppleIIEVideo()
     lastCycles = 0;
     pendingCycles = 0;
     
+    frameSkip = 0;
+    frameSkipCount = 0;
+    isSkippedImageModified = false;
+    
     flash = false;
     flashCount = 0;
     
@@ -140,6 +151,11 @@ AppleIIEVideo::AppleIIEVideo()
     
     altchrset = false;
     _80store = false;
+    
+    isTextRomTableValid = false;
+    isGraphicsRomTableValid = false;
+    
+    updateVideoState();
 }
 
 bool AppleIIEVideo::setValue(string name, string value)
@@ -208,6 +224,8 @@ bool AppleIIEVideo::setValue(string name, string value)
     else
         return false;
 	
+    updateVideoState();
+	
 	return true;
 }
 
@@ -270,6 +288,7 @@ bool AppleIIEVideo::setRef(string name, OEComponent *ref)
             controlBus->removeObserver(this, CONTROLBUS_POWERSTATE_DID_CHANGE);
             controlBus->removeObserver(this, CONTROLBUS_RESET_DID_ASSERT);
             controlBus->removeObserver(this, CONTROLBUS_TIMER_DID_FIRE);
+            controlBus->removeObserver(this, CONTROLBUS_FRAMESKIP_DID_CHANGE);
         }
         controlBus = ref;
         if (controlBus)
@@ -277,6 +296,7 @@ bool AppleIIEVideo::setRef(string name, OEComponent *ref)
             controlBus->addObserver(this, CONTROLBUS_POWERSTATE_DID_CHANGE);
             controlBus->addObserver(this, CONTROLBUS_RESET_DID_ASSERT);
             controlBus->addObserver(this, CONTROLBUS_TIMER_DID_FIRE);
+            controlBus->addObserver(this, CONTROLBUS_FRAMESKIP_DID_CHANGE);
         }
     }
     else if (name == "gamePort")
@@ -353,6 +373,9 @@ bool AppleIIEVideo::init()
 {
     OECheckComponent(controlBus);
     
+    controlBus->postMessage(this, CONTROLBUS_GET_CLOCK, &controlBusClock);
+    OECheckComponent(controlBusClock);
+    
     OEData *data;
     
     if (vram0000)
@@ -416,6 +439,7 @@ bool AppleIIEVideo::init()
     }
 
     controlBus->postMessage(this, CONTROLBUS_GET_POWERSTATE, &powerState);
+    controlBus->postMessage(this, CONTROLBUS_GET_FRAMESKIP, &frameSkip);
     
     if (gamePort) {
         gamePort->postMessage(this, APPLEII_GET_AN2, &an2);
@@ -455,6 +479,9 @@ void AppleIIEVideo::update()
         currentCharacterRom = characterRoms[characterRom];
     }
     
+    isTextRomTableValid = false;
+    isGraphicsRomTableValid = false;
+    
     updateVideoEnabled();
 }
 
@@ -520,6 +547,19 @@ bool AppleIIEVideo::postMessage(OEComponent *sender, int message, void *data)
             
             break;
         
+        case APPLEII_GET_VIDEOSTATEPOINTER:
+            *((OEInt **)data) = &videoState;
+            
+            return true;
+        
+        case COMPONENT_GET_STATE:
+            getState((OEData *)data);
+            
+            return true;
+            
+        case COMPONENT_SET_STATE:
+            return setState((OEData *)data);
+            
         default:
             if (monitor)
                 return monitor->postMessage(sender, message, data);
@@ -530,6 +570,53 @@ bool AppleIIEVideo::postMessage(OEComponent *sender, int message, void *data)
     return false;
 }
 
+// The state holds the frame timing, which is stamped with control bus
+// cycles. The whole frame is drawn again after the state is set
+
+void AppleIIEVideo::getState(OEData *data)
+{
+    AppleIIEVideoState state;
+    
+    memset(&state, 0, sizeof(state));
+    
+    state.frameStart = frameStart;
+    state.currentTimer = currentTimer;
+    state.lastCycles = lastCycles;
+    state.frameSkipCount = frameSkipCount;
+    state.isSkippedImageModified = isSkippedImageModified;
+    state.flash = flash;
+    state.flashCount = flashCount;
+    
+    OEChar *p = (OEChar *) &state;
+    
+    data->insert(data->end(), p, p + sizeof(state));
+}
+
+bool AppleIIEVideo::setState(OEData *data)
+{
+    AppleIIEVideoState state;
+    
+    if (data->size() != sizeof(state))
+        return false;
+    
+    memcpy(&state, &data->front(), sizeof(state));
+    
+    frameStart = state.frameStart;
+    currentTimer = state.currentTimer;
+    lastCycles = state.lastCycles;
+    frameSkipCount = state.frameSkipCount;
+    isSkippedImageModified = state.isSkippedImageModified;
+    flash = state.flash;
+    flashCount = state.flashCount;
+    
+    configureDraw();
+    updateVideoState();
+    
+    pendingCycles = frameCycleNum;
+    
+    return true;
+}
+
 void AppleIIEVideo::notify(OEComponent *sender, int notification, void *data)
 {
     if (sender == controlBus)
@@ -562,6 +649,11 @@ void AppleIIEVideo::notify(OEComponent *sender, int notification, void *data)
             case CONTROLBUS_TIMER_DID_FIRE:
                 scheduleNextTimer(*((OESLong *)data));
                 
+                break;
+                
+            case CONTROLBUS_FRAMESKIP_DID_CHANGE:
+                frameSkip = *((OEInt *)data);
+                
                 break;
         }
     }
@@ -609,7 +701,7 @@ void AppleIIEVideo::notify(OEComponent *sender, int notification, void *data)
     }
     else
         // Refresh notification from VRAM
-        refreshVideo();
+        refreshVideoMemory((OEChar *)data);
 }
 
 OEChar AppleIIEVideo::read(OEAddress address)
@@ -624,7 +716,11 @@ void AppleIIEVideo::write(OEAddress address, OEChar value)
     // Apple IIe softswitches.
     switch (address) {
         case 0xC00C: case 0xC00D: setMode(MODE_80COL, address & 0x1); return;
-        case 0xC00E: case 0xC00F: altchrset = address & 0x1; return;
+        case 0xC00E: case 0xC00F:
+            altchrset = address & 0x1;
+            isTextRomTableValid = false;
+            updateVideoState();
+            return;
     }
     
     switch (address & 0x7f)
@@ -661,6 +757,19 @@ void AppleIIEVideo::initOffsets()
     
     for (OEInt y = 0; y < BLOCK_HEIGHT * CELL_HEIGHT; y++)
         hiresOffset[y] = (y >> 6) * BLOCK_WIDTH + ((y >> 3) & 0x7) * 0x80 + (y & 0x7) * 0x400;
+    
+    // First line on which each video memory byte is displayed
+    textLine.assign(TEXT_MEMORY_SIZE, -1);
+    
+    for (OEInt y = 0; y < BLOCK_HEIGHT * CELL_HEIGHT; y += CELL_HEIGHT)
+        for (OEInt x = 0; x < HORIZ_DISPLAY; x++)
+            textLine[textOffset[y] + x] = y;
+    
+    hiresLine.assign(HIRES_MEMORY_SIZE, -1);
+    
+    for (OEInt y = 0; y < BLOCK_HEIGHT * CELL_HEIGHT; y++)
+        for (OEInt x = 0; x < HORIZ_DISPLAY; x++)
+            hiresLine[hiresOffset[y] + x] = y;
 }
 
 // videoRomMaps are four maps from the outputs of video ROM to actual dots to copy.
@@ -726,6 +835,8 @@ void AppleIIEVideo::setMode(OEInt mask, bool value)
         OEInt oldMode = mode;
         mode = newMode;
         
+        updateVideoState();
+        
         refreshVideo();
         
         configureDraw();
@@ -741,6 +852,21 @@ void AppleIIEVideo::setMode(OEInt mask, bool value)
     }
 }
 
+void AppleIIEVideo::updateVideoState()
+{
+    OEInt state = 0;
+    
+    OESetBit(state, APPLEII_VIDEOSTATE_TEXT, OEGetBit(mode, MODE_TEXT));
+    OESetBit(state, APPLEII_VIDEOSTATE_MIXED, OEGetBit(mode, MODE_MIXED));
+    OESetBit(state, APPLEII_VIDEOSTATE_PAGE2, OEGetBit(mode, MODE_PAGE2));
+    OESetBit(state, APPLEII_VIDEOSTATE_HIRES, OEGetBit(mode, MODE_HIRES));
+    OESetBit(state, APPLEII_VIDEOSTATE_80COL, OEGetBit(mode, MODE_80COL));
+    OESetBit(state, APPLEII_VIDEOSTATE_ALTCHRSET, altchrset);
+    OESetBit(state, APPLEII_VIDEOSTATE_VBL, currentTimer == TIMER_VSYNC);
+    
+    videoState = state;
+}
+
 void AppleIIEVideo::configureDraw()
 {
     bool newColorKiller;
@@ -807,6 +933,11 @@ void AppleIIEVideo::configureDraw()
         
         image.setSubcarrier(colorKiller ? 0 : NTSC_FSC);
         
+        // The canvas needs the new subcarrier even when no pixel changed
+        invalidateLineHash();
+        
+        imageModified = true;
+        
         postNotification(this, APPLEII_COLORKILLER_DID_CHANGE, &colorKiller);
     }
 }
@@ -828,6 +959,15 @@ void AppleIIEVideo::configureDraw()
 *((OEInt*)(d + 0)) = 0;\
 *((OEInt*)(d + 3)) = 0;\
 
+// Copy a segment with one 16-byte or 8-byte move. The extra pixels are
+// overwritten by the next segment, so the last segment of a span is
+// copied exactly
+#define copyWide40Segment(d,s) \
+memcpy(d, s, 16);
+
+#define copyWide80Segment(d,s) \
+memcpy(d, s, 8);
+
 
 // Given a memory value, and whether it's
 OEInt AppleIIEVideo::romMapOffset(OEChar value, OESInt y, OESInt x, bool graphics, bool hgr)
@@ -846,136 +986,248 @@ OEInt AppleIIEVideo::romMapOffset(OEChar value, OESInt y, OESInt x, bool graphic
     return result;
 }
 
+// The ROM values of all 256 memory values are looked up once per text row,
+// and once per graphics row and column parity. Text tables depend on
+// altchrset and flash, and are rebuilt on the first draw after a change
+
+void AppleIIEVideo::updateTextRomTable()
+{
+    textRomTable.resize(CELL_HEIGHT * CHAR_NUM);
+    
+    bool isRomValid = (currentCharacterRom.size() >= 0x1000);
+    
+    for (OEInt y = 0; y < CELL_HEIGHT; y++)
+        for (OEInt i = 0; i < CHAR_NUM; i++)
+            textRomTable[y * CHAR_NUM + i] = (isRomValid ?
+                                              currentCharacterRom[romMapOffset(i, y, 0, false, false)] :
+                                              0);
+    
+    isTextRomTableValid = true;
+}
+
+void AppleIIEVideo::updateGraphicsRomTable()
+{
+    graphicsRomTable.resize(8 * CHAR_NUM);
+    
+    bool isRomValid = (currentCharacterRom.size() >= 0x1000);
+    
+    for (OEInt j = 0; j < 8; j++)
+    {
+        bool hgr = (j >> 2) & 0x1;
+        OESInt y = (j & 0x2) << 1;
+        OESInt x = j & 0x1;
+        
+        for (OEInt i = 0; i < CHAR_NUM; i++)
+            graphicsRomTable[j * CHAR_NUM + i] = (isRomValid ?
+                                                  currentCharacterRom[romMapOffset(i, y, x, true, hgr)] :
+                                                  0);
+    }
+    
+    isGraphicsRomTableValid = true;
+}
+
+OEChar *AppleIIEVideo::getTextRomTable(OESInt y)
+{
+    if (!isTextRomTableValid)
+        updateTextRomTable();
+    
+    return &textRomTable.front() + (y & 0x7) * CHAR_NUM;
+}
+
+// The table for odd columns follows the one for even columns
+
+OEChar *AppleIIEVideo::getGraphicsRomTable(OESInt y, bool hgr)
+{
+    if (!isGraphicsRomTableValid)
+        updateGraphicsRomTable();
+    
+    return &graphicsRomTable.front() + ((hgr << 2) | ((y & 0x4) >> 1)) * CHAR_NUM;
+}
+
 void AppleIIEVideo::drawText40Line(OESInt y, OESInt x0, OESInt x1)
 {
-    OEInt memoryOffset = textOffset[y];
+    OEChar *memory = drawMemory1 + textOffset[y];
     OEChar *p = imagep + y * imageWidth + x0 * CELL_WIDTH;
     
     if (x0==0) {
         blank80Segment(p-7);
     }
-    for (OEInt x = x0; x < x1; x++, p += CELL_WIDTH)
-    {
-        OEChar value = drawMemory1[memoryOffset + x];
-        OEChar romValue = currentCharacterRom[romMapOffset(value, y, x, false, false)];
-        OEChar *m = romMap + CHAR_WIDTH * romValue;
+    if (x0 >= x1)
+        return;
+    
+    OEChar *romTable = getTextRomTable(y);
+    
+    OESInt x = x0;
+    
+    for (; x < x1 - 1; x++, p += CELL_WIDTH)
+        copyWide40Segment(p, romMap + CHAR_WIDTH * romTable[memory[x]]);
         
-        copy40Segment(p, m);
-    }
+    OEChar *m = romMap + CHAR_WIDTH * romTable[memory[x]];
+    
+    copy40Segment(p, m);
 }
 
 void AppleIIEVideo::drawText80Line(OESInt y, OESInt x0, OESInt x1)
 {
-    OEInt memoryOffset = textOffset[y];
+    if (x0 >= x1)
+        return;
+    
+    OEChar *memory = drawMemory1 + textOffset[y];
+    OEChar *memoryAux = drawMemory2 + textOffset[y];
+    OEChar *romTable = getTextRomTable(y);
     OEChar *p = imagep + y * imageWidth + x0 * CELL_WIDTH - CELL_WIDTH/2;
     
-    for (OEInt x = x0; x < x1; x++, p += CELL_WIDTH)
+    OESInt x = x0;
+    
+    for (; x < x1 - 1; x++, p += CELL_WIDTH)
     {
-        OEChar value = drawMemory1[memoryOffset + x];
-        OEChar valueAux = drawMemory2[memoryOffset + x];
-        OEChar romValue = currentCharacterRom[romMapOffset(value, y, x, false, false)];
-        OEChar romValueAux = currentCharacterRom[romMapOffset(valueAux, y, x, false, false)];
-        OEChar *m = romMap + CHAR_WIDTH * romValue;
-        OEChar *mAux = romMap + CHAR_WIDTH * romValueAux;
-        
-        copy80Segment(p, mAux);
-        copy80Segment(p + (CELL_WIDTH/2), m);
-        if (x==39) {
-            blank80Segment(p+CELL_WIDTH);
-        }
+        copyWide80Segment(p, romMap + CHAR_WIDTH * romTable[memoryAux[x]]);
+        copyWide80Segment(p + (CELL_WIDTH/2), romMap + CHAR_WIDTH * romTable[memory[x]]);
+    }
+    
+    OEChar *m = romMap + CHAR_WIDTH * romTable[memory[x]];
+    OEChar *mAux = romMap + CHAR_WIDTH * romTable[memoryAux[x]];
+    
+    copyWide80Segment(p, mAux);
+    copy80Segment(p + (CELL_WIDTH/2), m);
+    if (x==39) {
+        blank80Segment(p+CELL_WIDTH);
     }
 }
 
 void AppleIIEVideo::drawLores40Line(OESInt y, OESInt x0, OESInt x1)
 {
-    OEInt memoryOffset = textOffset[y];
+    OEChar *memory = drawMemory1 + textOffset[y];
     OEChar *p = imagep + y * imageWidth + x0 * CELL_WIDTH;
     
     if (x0==0) {
         blank80Segment(p-7);
     }
-    for (OEInt x = x0; x < x1; x++, p += CELL_WIDTH)
-    {
-        OEChar value = drawMemory1[memoryOffset + x];
-        OEChar romValue = currentCharacterRom[romMapOffset(value, y, x, true, false)];
-        OEChar *m = romMap + CHAR_WIDTH * romValue;
+    if (x0 >= x1)
+        return;
+    
+    OEChar *romTable = getGraphicsRomTable(y, false);
+    
+    OESInt x = x0;
+    
+    for (; x < x1 - 1; x++, p += CELL_WIDTH)
+        copyWide40Segment(p, romMap + CHAR_WIDTH * romTable[(x & 1) * CHAR_NUM + memory[x]]);
         
-        copy40Segment(p, m);
-    }
+    OEChar *m = romMap + CHAR_WIDTH * romTable[(x & 1) * CHAR_NUM + memory[x]];
+    
+    copy40Segment(p, m);
 }
 
 void AppleIIEVideo::drawLores80Line(OESInt y, OESInt x0, OESInt x1)
 {
-    OEInt memoryOffset = textOffset[y];
+    if (x0 >= x1)
+        return;
+    
+    OEChar *memory = drawMemory1 + textOffset[y];
+    OEChar *memoryAux = drawMemory2 + textOffset[y];
+    OEChar *romTable = getGraphicsRomTable(y, false);
     OEChar *p = imagep + y * imageWidth + x0 * CELL_WIDTH - CELL_WIDTH/2;
     
-    for (OEInt x = x0; x < x1; x++, p += CELL_WIDTH)
+    OESInt x = x0;
+    
+    for (; x < x1 - 1; x++, p += CELL_WIDTH)
     {
-        OEChar value = drawMemory1[memoryOffset + x];
-        OEChar valueAux = drawMemory2[memoryOffset + x];
-        OEChar romValue = currentCharacterRom[romMapOffset(value, y, x, true, false)];
-        OEChar romValueAux = currentCharacterRom[romMapOffset(valueAux, y, x, true, false)];
-        OEChar *m = romMap + CHAR_WIDTH * romValue;
-        OEChar *mAux = romMap + CHAR_WIDTH * romValueAux;
+        OEChar *romRow = romTable + (x & 1) * CHAR_NUM;
         
-        copy80Segment(p, mAux);
-        copy80Segment(p + (CELL_WIDTH/2), m);
-        if (x==39) {
-            blank80Segment(p+CELL_WIDTH);
-        }
+        copyWide80Segment(p, romMap + CHAR_WIDTH * romRow[memoryAux[x]]);
+        copyWide80Segment(p + (CELL_WIDTH/2), romMap + CHAR_WIDTH * romRow[memory[x]]);
+    }
+    
+    OEChar *romRow = romTable + (x & 1) * CHAR_NUM;
+    OEChar *m = romMap + CHAR_WIDTH * romRow[memory[x]];
+    OEChar *mAux = romMap + CHAR_WIDTH * romRow[memoryAux[x]];
+    
+    copyWide80Segment(p, mAux);
+    copy80Segment(p + (CELL_WIDTH/2), m);
+    if (x==39) {
+        blank80Segment(p+CELL_WIDTH);
     }
 }
 
+// With AN3 set, a byte with bit 7 set is delayed by one pixel, and its
+// first pixel continues the previous cell. The previous cell's ROM value
+// is carried across the span; rows wrap within 128 bytes, which only the
+// first cell of a span can hit
+
 void AppleIIEVideo::drawHires40Line(OESInt y, OESInt x0, OESInt x1)
 {
     OEInt memoryOffset = hiresOffset[y];
+    OEChar *memory = drawMemory1 + memoryOffset;
     OEChar *p = imagep + y * imageWidth + x0 * CELL_WIDTH;
     
     if (x0==0) {
         blank80Segment(p-7);
     }
-    for (OEInt x = x0; x < x1; x++, p += CELL_WIDTH)
+    if (x0 >= x1)
+        return;
+    
+    OEChar *romTable = getGraphicsRomTable(y, true);
+    OEChar lastRomValue = 0;
+    
+    if (x0 > 0) { // Column zero is never previous-on.
+        OEInt offset = memoryOffset + x0;
+        OELong lastOffset = (offset & ~0x7f) | ((offset - 1) & 0x7f);
+        OEChar lastValue = drawMemory1[lastOffset];
+        
+        lastRomValue = romTable[((x0 - 1) & 1) * CHAR_NUM + lastValue];
+    }
+    
+    for (OESInt x = x0; x < x1; x++, p += CELL_WIDTH)
     {
-        OEChar value = drawMemory1[memoryOffset + x];
-        OEChar romValue = currentCharacterRom[romMapOffset(value, y, x, true, true)];
+        OEChar value = memory[x];
+        OEChar romValue = romTable[(x & 1) * CHAR_NUM + value];
         OEChar *m = romMap + CHAR_WIDTH * romValue;
         if (OEGetBit(value, 0x80) && an3) {
             // Add to offset to get to delayed, previous off.
             m += CHAR_NUM * CHAR_WIDTH;
-            if (x > 0) { // Column zero is never previous-on.
-                OEInt offset = memoryOffset + x;
-                OELong lastOffset = (offset & ~0x7f) | ((offset - 1) & 0x7f);
-                OEChar lastValue = drawMemory1[lastOffset];
-                OEChar lastRomValue = currentCharacterRom[romMapOffset(lastValue, y, x-1, true, true)];
-                if (!OEGetBit(lastRomValue, 0x40)) {
-                    // Add to offset to get to delayed, previous on.
-                    m += CHAR_NUM * CHAR_WIDTH;
-                }
+            if ((x > 0) && !OEGetBit(lastRomValue, 0x40)) {
+                // Add to offset to get to delayed, previous on.
+                m += CHAR_NUM * CHAR_WIDTH;
             }
         }
-        copy40Segment(p, m);
+        lastRomValue = romValue;
+        
+        if (x < x1 - 1) {
+            copyWide40Segment(p, m);
+        } else {
+            copy40Segment(p, m);
+        }
     }
 }
 
 void AppleIIEVideo::drawHires80Line(OESInt y, OESInt x0, OESInt x1)
 {
-    OEInt memoryOffset = hiresOffset[y];
+    if (x0 >= x1)
+        return;
+    
+    OEChar *memory = drawMemory1 + hiresOffset[y];
+    OEChar *memoryAux = drawMemory2 + hiresOffset[y];
+    OEChar *romTable = getGraphicsRomTable(y, true);
     OEChar *p = imagep + y * imageWidth + x0 * CELL_WIDTH - CELL_WIDTH/2;
     
-    for (OEInt x = x0; x < x1; x++, p += CELL_WIDTH)
+    OESInt x = x0;
+    
+    for (; x < x1 - 1; x++, p += CELL_WIDTH)
     {
-        OEChar value = drawMemory1[memoryOffset + x];
-        OEChar valueAux = drawMemory2[memoryOffset + x];
-        OEChar romValue = currentCharacterRom[romMapOffset(value, y, x, true, true)];
-        OEChar romValueAux = currentCharacterRom[romMapOffset(valueAux, y, x, true, true)];
-        OEChar *m = romMap + CHAR_WIDTH * romValue;
-        OEChar *mAux = romMap + CHAR_WIDTH * romValueAux;
+        OEChar *romRow = romTable + (x & 1) * CHAR_NUM;
         
-        copy80Segment(p, mAux);
-        copy80Segment(p + (CELL_WIDTH/2), m);
-        if (x==39) {
-            blank80Segment(p+CELL_WIDTH);
-        }
+        copyWide80Segment(p, romMap + CHAR_WIDTH * romRow[memoryAux[x]]);
+        copyWide80Segment(p + (CELL_WIDTH/2), romMap + CHAR_WIDTH * romRow[memory[x]]);
+    }
+    
+    OEChar *romRow = romTable + (x & 1) * CHAR_NUM;
+    OEChar *m = romMap + CHAR_WIDTH * romRow[memory[x]];
+    OEChar *mAux = romMap + CHAR_WIDTH * romRow[memoryAux[x]];
+    
+    copyWide80Segment(p, mAux);
+    copy80Segment(p + (CELL_WIDTH/2), m);
+    if (x==39) {
+        blank80Segment(p+CELL_WIDTH);
     }
 }
 
@@ -997,6 +1249,8 @@ void AppleIIEVideo::updateVideoEnabled()
             {
                 image.fill(OEColor());
                 
+                invalidateLineHash();
+                
                 monitor->postMessage(this, CANVAS_CLEAR, NULL);
             }
             else
@@ -1012,11 +1266,70 @@ void AppleIIEVideo::refreshVideo()
     pendingCycles = frameCycleNum;
 }
 
-void AppleIIEVideo::updateVideo()
+// A video memory write only requires drawing up to now when the byte was
+// displayed since the last update. Otherwise the pending frame is extended
+// so it still covers a full frame from now
+
+void AppleIIEVideo::refreshVideoMemory(OEChar *p)
+{
+    if (!pendingCycles || !p || isDisplayedSinceUpdate(p))
+    {
+        refreshVideo();
+        
+        return;
+    }
+    
+    OELong cycles = getControlBusCycles(controlBusClock);
+    
+    pendingCycles = frameCycleNum + (OEInt) (cycles - lastCycles);
+}
+
+bool AppleIIEVideo::isDisplayedSinceUpdate(OEChar *p)
+{
+    OELong cycles = getControlBusCycles(controlBusClock);
+    
+    if ((lastCycles < frameStart) ||
+        ((cycles - frameStart) >= pos.size()))
+        return true;
+    
+    OESInt y0 = pos[(size_t) (lastCycles - frameStart)].y;
+    OESInt y1 = pos[(size_t) (cycles - frameStart)].y;
+    
+    for (OEInt page = 0; page < 2; page++)
+    {
+        if (isTextLineInRange(p, textMemory[page], y0, y1) ||
+            isHiresLineInRange(p, hiresMemory[page], y0, y1) ||
+            isTextLineInRange(p, textMemoryAux[page], y0, y1) ||
+            isHiresLineInRange(p, hiresMemoryAux[page], y0, y1))
+            return true;
+    }
+    
+    return false;
+}
+
+bool AppleIIEVideo::isTextLineInRange(OEChar *p, OEChar *memory, OESInt y0, OESInt y1)
+{
+    if ((p < memory) || (p >= (memory + TEXT_MEMORY_SIZE)))
+        return false;
+    
+    OESInt y = textLine[p - memory];
+    
+    return (y >= 0) && (y <= y1) && ((y + CELL_HEIGHT - 1) >= y0);
+}
+
+bool AppleIIEVideo::isHiresLineInRange(OEChar *p, OEChar *memory, OESInt y0, OESInt y1)
 {
-    OELong cycles;
+    if ((p < memory) || (p >= (memory + HIRES_MEMORY_SIZE)))
+        return false;
     
-    controlBus->postMessage(this, CONTROLBUS_GET_CYCLES, &cycles);
+    OESInt y = hiresLine[p - memory];
+    
+    return (y >= 0) && (y <= y1) && (y >= y0);
+}
+
+void AppleIIEVideo::updateVideo()
+{
+    OELong cycles = getControlBusCycles(controlBusClock);
     
     OEInt deltaCycles = (OEInt) (cycles - lastCycles);
     
@@ -1026,7 +1339,9 @@ void AppleIIEVideo::updateVideo()
     {
         pendingCycles -= cycleNum;
         
-        if (videoEnabled)
+        if (videoEnabled && frameSkipCount)
+            isSkippedImageModified = true;
+        else if (videoEnabled)
         {
             OEInt segmentStart = (OEInt) (lastCycles - frameStart);
             
@@ -1045,6 +1360,9 @@ void AppleIIEVideo::updateVideo()
                 (this->*draw)(p1.y, 0, p1.x);
             }
             
+            modifiedStart = min(modifiedStart, p0.y);
+            modifiedEnd = max(modifiedEnd, min(p1.y + 1, VERT_DISPLAY));
+            
             imageModified = true;
         }
     }
@@ -1052,6 +1370,88 @@ void AppleIIEVideo::updateVideo()
     lastCycles = cycles;
 }
 
+// A frame is posted only when a redrawn line hashes differently from the
+// last posted copy; the changed lines become the image's dirty rect
+
+static OELong getLineHash(OEChar *p, OEInt size)
+{
+    OELong hash = 0xcbf29ce484222325ULL;
+    
+    OEInt i = 0;
+    
+    for (; (i + sizeof(OELong)) <= size; i += sizeof(OELong))
+    {
+        OELong value;
+        
+        memcpy(&value, p + i, sizeof(OELong));
+        
+        hash = (hash ^ value) * 0x100000001b3ULL;
+    }
+    
+    for (; i < size; i++)
+        hash = (hash ^ p[i]) * 0x100000001b3ULL;
+    
+    return hash;
+}
+
+void AppleIIEVideo::invalidateLineHash()
+{
+    lineHash.assign(VERT_DISPLAY, 0);
+    
+    modifiedStart = 0;
+    modifiedEnd = VERT_DISPLAY;
+}
+
+bool AppleIIEVideo::updateDirtyRect()
+{
+    OESInt y0 = VERT_DISPLAY;
+    OESInt y1 = 0;
+    
+    for (OESInt y = modifiedStart; y < modifiedEnd; y++)
+    {
+        OELong hash = getLineHash(imagep + y * imageWidth, HORIZ_DISPLAY * CELL_WIDTH);
+        
+        if (hash == lineHash[y])
+            continue;
+        
+        lineHash[y] = hash;
+        
+        y0 = min(y0, y);
+        y1 = y + 1;
+    }
+    
+    modifiedStart = VERT_DISPLAY;
+    modifiedEnd = 0;
+    
+    if (y0 >= y1)
+        return false;
+    
+    OEInt imageTop = (OEInt) (imagep - image.getPixels()) / imageWidth;
+    
+    image.setDirtyRect(OEMakeRect(0, imageTop + y0,
+                                  imageWidth, y1 - y0));
+    
+    return true;
+}
+
+// Skipped frames are not drawn. If anything changed while frames were
+// skipped, the next drawn frame is redrawn in full
+
+void AppleIIEVideo::updateFrameSkip()
+{
+    if (frameSkipCount < frameSkip)
+        frameSkipCount++;
+    else
+        frameSkipCount = 0;
+    
+    if (!frameSkipCount && isSkippedImageModified)
+    {
+        isSkippedImageModified = false;
+        
+        pendingCycles = frameCycleNum;
+    }
+}
+
 void AppleIIEVideo::updateTiming()
 {
     // Update timing and rects
@@ -1099,6 +1499,8 @@ void AppleIIEVideo::updateTiming()
     imagep = image.getPixels();
     imagep += (OEInt) (vertStart - OEMinY(visibleRect)) * imageWidth + imageLeft;
     
+    invalidateLineHash();
+    
     vector<float> colorBurst;
     colorBurst.push_back(2.0 * M_PI * (-33.0 / 360.0 + (imageLeft % 4) / 4.0));
     image.setColorBurst(colorBurst);
@@ -1135,7 +1537,9 @@ void AppleIIEVideo::updateTiming()
     }
     
     currentTimer = TIMER_VSYNC;
-    controlBus->postMessage(this, CONTROLBUS_GET_CYCLES, &lastCycles);
+    lastCycles = getControlBusCycles(controlBusClock);
+    
+    updateVideoState();
     
     OEInt id = 0;
     controlBus->postMessage(this, CONTROLBUS_INVALIDATE_TIMERS, &id);
@@ -1151,6 +1555,8 @@ void AppleIIEVideo::scheduleNextTimer(OESLong cycles)
     if (currentTimer > TIMER_DISPLAYEND)
         currentTimer = TIMER_VSYNC;
     
+    updateVideoState();
+    
     switch (currentTimer)
     {
         case TIMER_DISPLAYMIXED:
@@ -1163,7 +1569,7 @@ void AppleIIEVideo::scheduleNextTimer(OESLong cycles)
             {
                 imageModified = false;
                 
-                if (videoEnabled)
+                if (videoEnabled && updateDirtyRect())
                     monitor->postMessage(this, CANVAS_POST_IMAGE, &image);
             }
             
@@ -1175,14 +1581,17 @@ void AppleIIEVideo::scheduleNextTimer(OESLong cycles)
                 {
                     flash = !flash;
                     flashCount = 0;
+                    isTextRomTableValid = false;
                     
                     refreshVideo();
                 }
             }
             
+            updateFrameSkip();
+            
             configureDraw();
             
-            controlBus->postMessage(this, CONTROLBUS_GET_CYCLES, &frameStart);
+            frameStart = getControlBusCycles(controlBusClock);
             frameStart += cycles;
             
             cycles += (vertStart + VERT_DISPLAY - 32) * HORIZ_TOTAL;
@@ -1214,9 +1623,7 @@ void AppleIIEVideo::scheduleNextTimer(OESLong cycles)
 
 OEIntPoint AppleIIEVideo::getCount()
 {
-    OELong cycles;
-    
-    controlBus->postMessage(this, CONTROLBUS_GET_CYCLES, &cycles);
+    OELong cycles = getControlBusCycles(controlBusClock);
     
     return count[(size_t) (cycles - frameStart)];
 }
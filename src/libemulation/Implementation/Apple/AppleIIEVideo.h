@@ -14,6 +14,17 @@
 
 #include "ControlBusInterface.h"
 
+typedef struct
+{
+    OELong frameStart;
+    OEInt currentTimer;
+    OELong lastCycles;
+    OEInt frameSkipCount;
+    bool isSkippedImageModified;
+    bool flash;
+    OEInt flashCount;
+} AppleIIEVideoState;
+
 class AppleIIEVideo : public OEComponent
 {
 public:
@@ -35,6 +46,7 @@ public:
 	
 private:
     OEComponent *controlBus;
+    ControlBusClock *controlBusClock;
     OEComponent *gamePort;
     OEComponent *mmu;
     OEComponent *monitor;
@@ -57,6 +69,8 @@ private:
     
     vector<OEInt> textOffset;
     vector<OEInt> hiresOffset;
+    vector<OESInt> textLine;
+    vector<OESInt> hiresLine;
     
     // Memory
     OEComponent *vram0000;
@@ -98,6 +112,9 @@ private:
     OEChar *imagep;
     OEInt imageWidth;
     bool imageModified;
+    OESInt modifiedStart;
+    OESInt modifiedEnd;
+    vector<OELong> lineHash;
     
     void (AppleIIEVideo::*draw)(OESInt y, OESInt x0, OESInt x1);
     OEChar *drawMemory1;
@@ -114,6 +131,10 @@ private:
     OELong lastCycles;
     OEInt pendingCycles;
     
+    OEInt frameSkip;
+    OEInt frameSkipCount;
+    bool isSkippedImageModified;
+    
     bool flash;
     OEInt flashCount;
     
@@ -123,6 +144,7 @@ private:
     OEInt videoInhibitCount;
     bool an2;
     bool an3;
+    OEInt videoState;
     
     void initOffsets();
 
@@ -135,6 +157,7 @@ private:
     void updateMonitorConnected();
     
     void setMode(OEInt mask, bool value);
+    void updateVideoState();
     void configureDraw();
     void drawText40Line(OESInt y, OESInt x0, OESInt x1);
     void drawText80Line(OESInt y, OESInt x0, OESInt x1);
@@ -144,7 +167,14 @@ private:
     void drawHires80Line(OESInt y, OESInt x0, OESInt x1);
     void updateVideoEnabled();
     void refreshVideo();
+    void refreshVideoMemory(OEChar *p);
+    bool isDisplayedSinceUpdate(OEChar *p);
+    bool isTextLineInRange(OEChar *p, OEChar *memory, OESInt y0, OESInt y1);
+    bool isHiresLineInRange(OEChar *p, OEChar *memory, OESInt y0, OESInt y1);
     void updateVideo();
+    void invalidateLineHash();
+    bool updateDirtyRect();
+    void updateFrameSkip();
     
     void updateTiming();
     void scheduleNextTimer(OESLong cycles);
@@ -161,5 +191,17 @@ private:
 
     OEChar *romMap;
     
+    OEData textRomTable;
+    OEData graphicsRomTable;
+    bool isTextRomTableValid;
+    bool isGraphicsRomTableValid;
+    
     OEInt romMapOffset(OEChar value, OESInt y, OESInt x, bool graphics, bool hgr);
+    void updateTextRomTable();
+    void updateGraphicsRomTable();
+    OEChar *getTextRomTable(OESInt y);
+    OEChar *getGraphicsRomTable(OESInt y, bool hgr);
+    
+    void getState(OEData *data);
+    bool setState(OEData *data);
 };
@@ -8,6 +8,8 @@
  * Implements an Apple II Game Port
  */
 
+#include <string.h>
+
 #include "AppleIIGamePort.h"
 
 #include "ControlBusInterface.h"
@@ -131,11 +133,48 @@ bool AppleIIGamePort::postMessage(OEComponent *sender, int message, void *data)
             *((bool *)data) = an[message - APPLEII_GET_AN0];
             
             return true;
+            
+        case COMPONENT_GET_STATE:
+            getState((OEData *)data);
+            
+            return true;
+            
+        case COMPONENT_SET_STATE:
+            return setState((OEData *)data);
     }
     
     return false;
 }
 
+// The state holds the paddle timer start, in control bus cycles
+
+void AppleIIGamePort::getState(OEData *data)
+{
+    AppleIIGamePortState state;
+    
+    memset(&state, 0, sizeof(state));
+    
+    state.timerStart = timerStart;
+    
+    OEChar *p = (OEChar *) &state;
+    
+    data->insert(data->end(), p, p + sizeof(state));
+}
+
+bool AppleIIGamePort::setState(OEData *data)
+{
+    AppleIIGamePortState state;
+    
+    if (data->size() != sizeof(state))
+        return false;
+    
+    memcpy(&state, &data->front(), sizeof(state));
+    
+    timerStart = state.timerStart;
+    
+    return true;
+}
+
 void AppleIIGamePort::notify(OEComponent *sender, int notification, void *data)
 {
     if (sender == gamePort)
@@ -16,6 +16,11 @@
 #define APPLEIIGAMEPORT_MINVALUE    (0 * 11 + 8)
 #define APPLEIIGAMEPORT_MAXVALUE    (255 * 11 + 8)
 
+typedef struct
+{
+    OELong timerStart;
+} AppleIIGamePortState;
+
 class AppleIIGamePort : public OEComponent
 {
 public:
@@ -48,6 +53,9 @@ protected:
     void setPB(OELong index, bool value);
     bool isTimerPending(OELong index);
     void resetTimer();
+    
+    void getState(OEData *data);
+    bool setState(OEData *data);
 };
 
 #endif
@@ -193,11 +193,18 @@ bool AppleIIIAddressDecoder::postMessage(OEComponent *sender, int message, void
             return removeMemoryMap(ioMemoryMaps, (MemoryMap *) data);
     }
     
-    return false;
+    return AddressDecoder::postMessage(sender, message, data);
 }
 
 void AppleIIIAddressDecoder::notify(OEComponent *sender, int notification, void *data)
 {
+    if (sender != systemControl)
+    {
+        AddressDecoder::notify(sender, notification, data);
+        
+        return;
+    }
+    
     switch (notification)
     {
         case APPLEIII_ENVIRONMENT_DID_CHANGE:
@@ -238,7 +245,7 @@ void AppleIIIAddressDecoder::setSlot(OEInt index, OEComponent *ref)
         removeMemoryMap(ioMemoryMaps, &m);
     
     if (readMapp)
-        updateReadWriteMap(m.startAddress, m.endAddress);
+        updateMemoryMap(m.startAddress, m.endAddress);
 }
 
 bool AppleIIIAddressDecoder::setEnvironment(OEChar value)
@@ -249,7 +256,7 @@ bool AppleIIIAddressDecoder::setEnvironment(OEChar value)
         
         updateAppleIIIMemoryMaps();
         
-        updateReadWriteMap(0xc000, 0xffff);
+        updateMemoryMap(0xc000, 0xffff);
     }
     
     return true;
@@ -263,7 +270,7 @@ bool AppleIIIAddressDecoder::setAppleIIMode(bool value)
         
         updateAppleIIIMemoryMaps();
         
-        updateReadWriteMap(0xff00, 0xffff);
+        updateMemoryMap(0xff00, 0xffff);
     }
     
     return true;
@@ -32,6 +32,7 @@ private:
     OEInt extendedMemoryBank;
     
     void execute();
+    template <bool isTraceEnabled> void executeInstructions();
     void setZeroPage(OEChar value);
 };
 
@@ -27,20 +27,29 @@ if (extendedMemoryEnabled)                                  \
         xbyte &= 0x0f;                                      \
         systemControl->postMessage(this,                    \
             APPLEIII_SET_EXTENDEDRAMBANK, &xbyte);          \
-        APPLEIIIRDMEM((EAH << 8) | ((EAL + Y) & 0xff));     \
+        if (EAL + Y > 0xff)                                 \
+        {                                                   \
+            APPLEIIIRDMEM((EAH << 8) | ((EAL + Y) & 0xff)); \
+        }                                                   \
         EAW += Y;                                           \
         tmp = APPLEIIIRDMEM_ID(EAA);                        \
     }                                                       \
     else                                                    \
     {                                                       \
-        RDMEM((EAH << 8) | ((EAL + Y) & 0xff));             \
+        if (EAL + Y > 0xff)                                 \
+        {                                                   \
+            RDMEM((EAH << 8) | ((EAL + Y) & 0xff));         \
+        }                                                   \
         EAW += Y;                                           \
         tmp = RDMEM_ID(EAA);                                \
     }                                                       \
 }                                                           \
 else                                                        \
 {                                                           \
-    RDMEM((EAH << 8) | ((EAL + Y) & 0xff));                 \
+    if (EAL + Y > 0xff)                                     \
+    {                                                       \
+        RDMEM((EAH << 8) | ((EAL + Y) & 0xff));             \
+    }                                                       \
     EAW += Y;                                               \
     tmp = RDMEM_ID(EAA);                                    \
 }
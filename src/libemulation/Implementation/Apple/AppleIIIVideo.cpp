@@ -58,6 +58,7 @@ enum
 AppleIIIVideo::AppleIIIVideo()
 {
     controlBus = NULL;
+    controlBusClock = NULL;
     systemControl = NULL;
     vram = NULL;
     monochromeMonitor = NULL;
@@ -240,6 +241,9 @@ bool AppleIIIVideo::init()
     OECheckComponent(systemControl);
     OECheckComponent(vram);
     
+    controlBus->postMessage(this, CONTROLBUS_GET_CLOCK, &controlBusClock);
+    OECheckComponent(controlBusClock);
+    
     controlBus->postMessage(this, CONTROLBUS_GET_POWERSTATE, &powerState);
     
     systemControl->postMessage(this, APPLEIII_GET_APPLEIIMODE, &appleIIMode);
@@ -338,6 +342,14 @@ bool AppleIIIVideo::postMessage(OEComponent *sender, int message, void *data)
         case APPLEIII_UPDATE_CHARACTERSET:
             return updateCharacterSet();
             
+        case COMPONENT_GET_STATE:
+        case COMPONENT_SET_STATE:
+        case RAM_SET_DIRTYTRACKING:
+        case RAM_GET_DIRTYPAGESIZE:
+        case RAM_GET_DIRTYPAGES:
+        case RAM_CLEAR_DIRTYPAGES:
+            return false;
+            
         default:
             if (monochromeMonitor)
                 monochromeMonitor->postMessage(sender, message, data);
@@ -758,9 +770,7 @@ void AppleIIIVideo::drawHires140Line(OESInt y, OESInt x0, OESInt x1)
 
 void AppleIIIVideo::updateVideo()
 {
-    OELong cycles;
-    
-    controlBus->postMessage(this, CONTROLBUS_GET_CYCLES, &cycles);
+    OELong cycles = getControlBusCycles(controlBusClock);
     
     OEInt deltaCycles = (OEInt) (cycles - lastCycles);
     
@@ -38,6 +38,7 @@ public:
 	
 private:
     OEComponent *controlBus;
+    ControlBusClock *controlBusClock;
     OEComponent *systemControl;
     OEComponent *vram;
     OEComponent *monochromeMonitor;
@@ -147,10 +147,14 @@ void AppleIISlotController::updateSlotExpansion(bool value)
     
     int message = en ? APPLEII_MAP_SLOT : APPLEII_UNMAP_SLOT;
     
+    memoryBus->postMessage(this, ADDRESSDECODER_BEGIN_UPDATE, NULL);
+    
     for (MemoryMaps::iterator i = memoryMaps.begin();
          i != memoryMaps.end();
          i++)
         memoryBus->postMessage(this, message, &*i);
     
+    memoryBus->postMessage(this, ADDRESSDECODER_COMMIT_UPDATE, NULL);
+    
     postNotification(this, APPLEII_C800_DID_CHANGE, &en);
 }
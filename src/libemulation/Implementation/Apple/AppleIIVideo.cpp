@@ -9,6 +9,7 @@
  */
 
 #include <math.h>
+#include <string.h>
 
 #include "AppleIIVideo.h"
 
@@ -26,6 +27,9 @@
 #define MODE_PAGE2      (1 << 2)
 #define MODE_HIRES      (1 << 3)
 
+#define TEXT_MEMORY_SIZE    0x400
+#define HIRES_MEMORY_SIZE   0x2000
+
 #define CHAR_NUM        0x100
 #define CHAR_WIDTH      16
 #define CHAR_HEIGHT     8
@@ -65,6 +69,7 @@ enum
 AppleIIVideo::AppleIIVideo()
 {
     controlBus = NULL;
+    controlBusClock = NULL;
     gamePort = NULL;
     monitor = NULL;
     
@@ -107,6 +112,8 @@ AppleIIVideo::AppleIIVideo()
     image.setSampleRate(NTSC_4FSC);
     image.setFormat(OEIMAGE_LUMINANCE);
     imageModified = false;
+    modifiedStart = VERT_DISPLAY;
+    modifiedEnd = 0;
     
     frameStart = 0;
     frameCycleNum = 0;
@@ -115,6 +122,10 @@ AppleIIVideo::AppleIIVideo()
     lastCycles = 0;
     pendingCycles = 0;
     
+    frameSkip = 0;
+    frameSkipCount = 0;
+    isSkippedImageModified = false;
+    
     flash = false;
     flashCount = 0;
     
@@ -221,12 +232,14 @@ bool AppleIIVideo::setRef(string name, OEComponent *ref)
         {
             controlBus->removeObserver(this, CONTROLBUS_POWERSTATE_DID_CHANGE);
             controlBus->removeObserver(this, CONTROLBUS_TIMER_DID_FIRE);
+            controlBus->removeObserver(this, CONTROLBUS_FRAMESKIP_DID_CHANGE);
         }
         controlBus = ref;
         if (controlBus)
         {
             controlBus->addObserver(this, CONTROLBUS_POWERSTATE_DID_CHANGE);
             controlBus->addObserver(this, CONTROLBUS_TIMER_DID_FIRE);
+            controlBus->addObserver(this, CONTROLBUS_FRAMESKIP_DID_CHANGE);
         }
     }
     else if (name == "gamePort")
@@ -282,6 +295,9 @@ bool AppleIIVideo::init()
 {
     OECheckComponent(controlBus);
     
+    controlBus->postMessage(this, CONTROLBUS_GET_CLOCK, &controlBusClock);
+    OECheckComponent(controlBusClock);
+    
     OEData *data;
     
     if (vram0000)
@@ -315,6 +331,7 @@ bool AppleIIVideo::init()
     }
     
     controlBus->postMessage(this, CONTROLBUS_GET_POWERSTATE, &powerState);
+    controlBus->postMessage(this, CONTROLBUS_GET_FRAMESKIP, &frameSkip);
     
     if (gamePort)
         gamePort->postMessage(this, APPLEII_GET_AN2, &an2);
@@ -413,6 +430,14 @@ bool AppleIIVideo::postMessage(OEComponent *sender, int message, void *data)
             
             break;
             
+        case COMPONENT_GET_STATE:
+            getState((OEData *)data);
+            
+            return true;
+            
+        case COMPONENT_SET_STATE:
+            return setState((OEData *)data);
+            
         default:
             if (monitor)
                 return monitor->postMessage(sender, message, data);
@@ -423,6 +448,52 @@ bool AppleIIVideo::postMessage(OEComponent *sender, int message, void *data)
     return false;
 }
 
+// The state holds the frame timing, which is stamped with control bus
+// cycles. The whole frame is drawn again after the state is set
+
+void AppleIIVideo::getState(OEData *data)
+{
+    AppleIIVideoState state;
+    
+    memset(&state, 0, sizeof(state));
+    
+    state.frameStart = frameStart;
+    state.currentTimer = currentTimer;
+    state.lastCycles = lastCycles;
+    state.frameSkipCount = frameSkipCount;
+    state.isSkippedImageModified = isSkippedImageModified;
+    state.flash = flash;
+    state.flashCount = flashCount;
+    
+    OEChar *p = (OEChar *) &state;
+    
+    data->insert(data->end(), p, p + sizeof(state));
+}
+
+bool AppleIIVideo::setState(OEData *data)
+{
+    AppleIIVideoState state;
+    
+    if (data->size() != sizeof(state))
+        return false;
+    
+    memcpy(&state, &data->front(), sizeof(state));
+    
+    frameStart = state.frameStart;
+    currentTimer = state.currentTimer;
+    lastCycles = state.lastCycles;
+    frameSkipCount = state.frameSkipCount;
+    isSkippedImageModified = state.isSkippedImageModified;
+    flash = state.flash;
+    flashCount = state.flashCount;
+    
+    configureDraw();
+    
+    pendingCycles = frameCycleNum;
+    
+    return true;
+}
+
 void AppleIIVideo::notify(OEComponent *sender, int notification, void *data)
 {
     if (sender == controlBus)
@@ -447,6 +518,11 @@ void AppleIIVideo::notify(OEComponent *sender, int notification, void *data)
             case CONTROLBUS_TIMER_DID_FIRE:
                 scheduleNextTimer(*((OESLong *)data));
                 
+                break;
+                
+            case CONTROLBUS_FRAMESKIP_DID_CHANGE:
+                frameSkip = *((OEInt *)data);
+                
                 break;
         }
     }
@@ -477,7 +553,7 @@ void AppleIIVideo::notify(OEComponent *sender, int notification, void *data)
     }
     else
         // Refresh notification from VRAM
-        refreshVideo();
+        refreshVideoMemory((OEChar *)data);
 }
 
 OEChar AppleIIVideo::read(OEAddress address)
@@ -524,6 +600,19 @@ void AppleIIVideo::initOffsets()
     
     for (OEInt y = 0; y < BLOCK_HEIGHT * CELL_HEIGHT; y++)
         hiresOffset[y] = (y >> 6) * BLOCK_WIDTH + ((y >> 3) & 0x7) * 0x80 + (y & 0x7) * 0x400;
+    
+    // First line on which each video memory byte is displayed
+    textLine.assign(TEXT_MEMORY_SIZE, -1);
+    
+    for (OEInt y = 0; y < BLOCK_HEIGHT * CELL_HEIGHT; y += CELL_HEIGHT)
+        for (OEInt x = 0; x < HORIZ_DISPLAY; x++)
+            textLine[textOffset[y] + x] = y;
+    
+    hiresLine.assign(HIRES_MEMORY_SIZE, -1);
+    
+    for (OEInt y = 0; y < BLOCK_HEIGHT * CELL_HEIGHT; y++)
+        for (OEInt x = 0; x < HORIZ_DISPLAY; x++)
+            hiresLine[hiresOffset[y] + x] = y;
 }
 
 bool AppleIIVideo::loadTextFont(string name, OEData *data)
@@ -691,6 +780,11 @@ void AppleIIVideo::configureDraw()
         
         image.setSubcarrier(colorKiller ? 0 : NTSC_FSC);
         
+        // The canvas needs the new subcarrier even when no pixel changed
+        invalidateLineHash();
+        
+        imageModified = true;
+        
         postNotification(this, APPLEII_COLORKILLER_DID_CHANGE, &colorKiller);
     }
 }
@@ -707,90 +801,136 @@ void AppleIIVideo::configureDraw()
 *((OEInt *)(d + 8)) = *((OEInt *)(s + 8));\
 *((OEShort *)(d + 12)) = *((OEShort *)(s + 12));
 
+// Copy a segment with one 16-byte move. The extra pixels are overwritten
+// by the next segment, so the last segment of a span is copied exactly.
+// Font rows stay in L1, so these moves beat computing pixels from bit
+// masks: SSE2 and AVX2 mask expansion kernels measured slower
+#define copyWideSegment(d,s) \
+memcpy(d, s, 16);
+
+// Draw routines expand a span of cells [x0, x1) of one line. Font rows
+// and memory rows are set up once per span
+
 void AppleIIVideo::drawText40Line(OESInt y, OESInt x0, OESInt x1)
 {
-    OEInt memoryOffset = textOffset[y];
+    if (x0 >= x1)
+        return;
+    
+    OEChar *memory = drawMemory1 + textOffset[y];
+    OEChar *font = drawFont + (y & 0x7) * CHAR_WIDTH;
     OEChar *p = imagep + y * imageWidth + x0 * CELL_WIDTH;
     
-    for (OEInt x = x0; x < x1; x++, p += CELL_WIDTH)
-    {
-        OEChar *m = (drawFont + (y & 0x7) * CHAR_WIDTH +
-                     drawMemory1[memoryOffset + x] * CHAR_SIZE);
+    OESInt x = x0;
         
-        copy40Segment(p, m);
-    }
+    for (; x < x1 - 1; x++, p += CELL_WIDTH)
+        copyWideSegment(p, font + memory[x] * CHAR_SIZE);
+    
+    OEChar *m = font + memory[x] * CHAR_SIZE;
+    
+    copy40Segment(p, m);
 }
 
 void AppleIIVideo::drawText80Line(OESInt y, OESInt x0, OESInt x1)
 {
-    OEInt memoryOffset = textOffset[y];
+    if (x0 >= x1)
+        return;
+    
+    OEChar *memory1 = drawMemory1 + textOffset[y];
+    OEChar *memory2 = drawMemory2 + textOffset[y];
+    OEChar *font = drawFont + (y & 0x7) * CHAR_WIDTH;
     OEChar *p = imagep + y * imageWidth + x0 * CELL_WIDTH;
     
-    for (OEInt x = x0; x < x1; x++, p += CELL_WIDTH / 2)
+    OESInt x = x0;
+    
+    for (; x < x1 - 1; x++, p += CELL_WIDTH)
     {
-        OEChar *m = (drawFont + (y & 0x7) * CHAR_WIDTH +
-                     drawMemory1[memoryOffset + x] * CHAR_SIZE);
+        copyWideSegment(p, font + memory1[x] * CHAR_SIZE);
+        copyWideSegment(p + CELL_WIDTH / 2, font + memory2[x] * CHAR_SIZE);
+    }
         
-        copy80Segment(p, m);
+    copyWideSegment(p, font + memory1[x] * CHAR_SIZE);
         
-        p += CELL_WIDTH / 2;
+    p += CELL_WIDTH / 2;
         
-        m = (drawFont + (y & 0x7) * CHAR_WIDTH +
-             drawMemory2[memoryOffset + x] * CHAR_SIZE);
+    OEChar *m = font + memory2[x] * CHAR_SIZE;
         
-        copy80Segment(p, m);
-    }
+    copy80Segment(p, m);
 }
 
 void AppleIIVideo::drawLores40Line(OESInt y, OESInt x0, OESInt x1)
 {
-    OEInt memoryOffset = textOffset[y];
+    if (x0 >= x1)
+        return;
+    
+    OEChar *memory = drawMemory1 + textOffset[y];
+    OEChar *font = drawFont + (y & 0x7) * CHAR_WIDTH;
     OEChar *p = imagep + y * imageWidth + x0 * CELL_WIDTH;
     
-    for (OEInt x = x0; x < x1; x++, p += CELL_WIDTH)
-    {
-        OEChar *m = (drawFont + (y & 0x7) * CHAR_WIDTH +
-                     drawMemory1[memoryOffset + x] * CHAR_SIZE +
-                     (x & 1) * FONT_SIZE);
+    OESInt x = x0;
         
-        copy40Segment(p, m);
-    }
+    for (; x < x1 - 1; x++, p += CELL_WIDTH)
+        copyWideSegment(p, font + memory[x] * CHAR_SIZE + (x & 1) * FONT_SIZE);
+    
+    OEChar *m = font + memory[x] * CHAR_SIZE + (x & 1) * FONT_SIZE;
+    
+    copy40Segment(p, m);
 }
 
+// Bit 6 of the previous byte selects the delayed half of the hires font.
+// Rows wrap within 128 bytes, which only the first cell of a span can hit
+
 void AppleIIVideo::drawHires40Line(OESInt y, OESInt x0, OESInt x1)
 {
+    if (x0 >= x1)
+        return;
+    
     OEInt memoryOffset = hiresOffset[y];
+    OEChar *memory = drawMemory1 + memoryOffset;
     OEChar *p = imagep + y * imageWidth + x0 * CELL_WIDTH;
     
-    for (OEInt x = x0; x < x1; x++, p += CELL_WIDTH)
+    OEInt offset = memoryOffset + x0;
+    OEInt lastValue = drawMemory1[(offset & ~0x7f) | ((offset - 1) & 0x7f)];
+    
+    OESInt x = x0;
+    
+    for (; x < x1 - 1; x++, p += CELL_WIDTH)
     {
-        OEInt offset = memoryOffset + x;
-        OELong lastOffset = (offset & ~0x7f) | ((offset - 1) & 0x7f);
+        OEInt value = memory[x];
         
-        OEInt i = drawMemory1[offset] | ((drawMemory1[lastOffset] & 0x40) << 2);
-        OEChar *m = drawFont + i * CHAR_WIDTH;
+        copyWideSegment(p, drawFont + (value | ((lastValue & 0x40) << 2)) * CHAR_WIDTH);
         
-        copy40Segment(p, m);
+        lastValue = value;
     }
+    
+    OEChar *m = drawFont + (memory[x] | ((lastValue & 0x40) << 2)) * CHAR_WIDTH;
+    
+    copy40Segment(p, m);
 }
 
 void AppleIIVideo::drawHires80Line(OESInt y, OESInt x0, OESInt x1)
 {
-    OEInt memoryOffset = hiresOffset[y];
+    if (x0 >= x1)
+        return;
+    
+    OEChar *memory1 = drawMemory1 + hiresOffset[y];
+    OEChar *memory2 = drawMemory2 + hiresOffset[y];
     OEChar *p = imagep + y * imageWidth + x0 * CELL_WIDTH;
     
-    for (OEInt x = x0; x < x1; x++, p += CELL_WIDTH / 2)
+    OESInt x = x0;
+    
+    for (; x < x1 - 1; x++, p += CELL_WIDTH)
     {
-        OEChar *m = drawFont + drawMemory1[memoryOffset + x] * CHAR_WIDTH;
+        copyWideSegment(p, drawFont + memory1[x] * CHAR_WIDTH);
+        copyWideSegment(p + CELL_WIDTH / 2, drawFont + memory2[x] * CHAR_WIDTH);
+    }
         
-        copy80Segment(p, m);
+    copyWideSegment(p, drawFont + memory1[x] * CHAR_WIDTH);
         
-        p += CELL_WIDTH / 2;
+    p += CELL_WIDTH / 2;
         
-        m = drawFont + drawMemory2[memoryOffset + x] * CHAR_WIDTH;
+    OEChar *m = drawFont + memory2[x] * CHAR_WIDTH;
         
-        copy80Segment(p, m);
-    }
+    copy80Segment(p, m);
 }
 
 // To-Do: Implement Apple IIe delay
@@ -811,6 +951,8 @@ void AppleIIVideo::updateVideoEnabled()
             {
                 image.fill(OEColor());
                 
+                invalidateLineHash();
+                
                 monitor->postMessage(this, CANVAS_CLEAR, NULL);
             }
             else
@@ -826,11 +968,68 @@ void AppleIIVideo::refreshVideo()
     pendingCycles = frameCycleNum;
 }
 
-void AppleIIVideo::updateVideo()
+// A video memory write only requires drawing up to now when the byte was
+// displayed since the last update. Otherwise the pending frame is extended
+// so it still covers a full frame from now
+
+void AppleIIVideo::refreshVideoMemory(OEChar *p)
+{
+    if (!pendingCycles || !p || isDisplayedSinceUpdate(p))
+    {
+        refreshVideo();
+        
+        return;
+    }
+    
+    OELong cycles = getControlBusCycles(controlBusClock);
+    
+    pendingCycles = frameCycleNum + (OEInt) (cycles - lastCycles);
+}
+
+bool AppleIIVideo::isDisplayedSinceUpdate(OEChar *p)
+{
+    OELong cycles = getControlBusCycles(controlBusClock);
+    
+    if ((lastCycles < frameStart) ||
+        ((cycles - frameStart) >= pos.size()))
+        return true;
+    
+    OESInt y0 = pos[(size_t) (lastCycles - frameStart)].y;
+    OESInt y1 = pos[(size_t) (cycles - frameStart)].y;
+    
+    for (OEInt page = 0; page < 2; page++)
+    {
+        if (isTextLineInRange(p, textMemory[page], y0, y1) ||
+            isHiresLineInRange(p, hiresMemory[page], y0, y1))
+            return true;
+    }
+    
+    return false;
+}
+
+bool AppleIIVideo::isTextLineInRange(OEChar *p, OEChar *memory, OESInt y0, OESInt y1)
 {
-    OELong cycles;
+    if ((p < memory) || (p >= (memory + TEXT_MEMORY_SIZE)))
+        return false;
+    
+    OESInt y = textLine[p - memory];
+    
+    return (y >= 0) && (y <= y1) && ((y + CELL_HEIGHT - 1) >= y0);
+}
+
+bool AppleIIVideo::isHiresLineInRange(OEChar *p, OEChar *memory, OESInt y0, OESInt y1)
+{
+    if ((p < memory) || (p >= (memory + HIRES_MEMORY_SIZE)))
+        return false;
     
-    controlBus->postMessage(this, CONTROLBUS_GET_CYCLES, &cycles);
+    OESInt y = hiresLine[p - memory];
+    
+    return (y >= 0) && (y <= y1) && (y >= y0);
+}
+
+void AppleIIVideo::updateVideo()
+{
+    OELong cycles = getControlBusCycles(controlBusClock);
     
     OEInt deltaCycles = (OEInt) (cycles - lastCycles);
     
@@ -840,7 +1039,9 @@ void AppleIIVideo::updateVideo()
     {
         pendingCycles -= cycleNum;
         
-        if (videoEnabled)
+        if (videoEnabled && frameSkipCount)
+            isSkippedImageModified = true;
+        else if (videoEnabled)
         {
             OEInt segmentStart = (OEInt) (lastCycles - frameStart);
             
@@ -859,6 +1060,9 @@ void AppleIIVideo::updateVideo()
                 (this->*draw)(p1.y, 0, p1.x);
             }
             
+            modifiedStart = min(modifiedStart, p0.y);
+            modifiedEnd = max(modifiedEnd, min(p1.y + 1, VERT_DISPLAY));
+            
             imageModified = true;
         }
     }
@@ -866,6 +1070,88 @@ void AppleIIVideo::updateVideo()
     lastCycles = cycles;
 }
 
+// Lines drawn since the last post are hashed, and only the lines whose
+// hash changed are marked dirty. Nothing is posted when no line changed
+
+static OELong getLineHash(OEChar *p, OEInt size)
+{
+    OELong hash = 0xcbf29ce484222325ULL;
+    
+    OEInt i = 0;
+    
+    for (; (i + sizeof(OELong)) <= size; i += sizeof(OELong))
+    {
+        OELong value;
+        
+        memcpy(&value, p + i, sizeof(OELong));
+        
+        hash = (hash ^ value) * 0x100000001b3ULL;
+    }
+    
+    for (; i < size; i++)
+        hash = (hash ^ p[i]) * 0x100000001b3ULL;
+    
+    return hash;
+}
+
+void AppleIIVideo::invalidateLineHash()
+{
+    lineHash.assign(VERT_DISPLAY, 0);
+    
+    modifiedStart = 0;
+    modifiedEnd = VERT_DISPLAY;
+}
+
+bool AppleIIVideo::updateDirtyRect()
+{
+    OESInt y0 = VERT_DISPLAY;
+    OESInt y1 = 0;
+    
+    for (OESInt y = modifiedStart; y < modifiedEnd; y++)
+    {
+        OELong hash = getLineHash(imagep + y * imageWidth, HORIZ_DISPLAY * CELL_WIDTH);
+        
+        if (hash == lineHash[y])
+            continue;
+        
+        lineHash[y] = hash;
+        
+        y0 = min(y0, y);
+        y1 = y + 1;
+    }
+    
+    modifiedStart = VERT_DISPLAY;
+    modifiedEnd = 0;
+    
+    if (y0 >= y1)
+        return false;
+    
+    OEInt imageTop = (OEInt) (imagep - image.getPixels()) / imageWidth;
+    
+    image.setDirtyRect(OEMakeRect(0, imageTop + y0,
+                                  imageWidth, y1 - y0));
+    
+    return true;
+}
+
+// Skipped frames are not drawn. If anything changed while frames were
+// skipped, the next drawn frame is redrawn in full
+
+void AppleIIVideo::updateFrameSkip()
+{
+    if (frameSkipCount < frameSkip)
+        frameSkipCount++;
+    else
+        frameSkipCount = 0;
+    
+    if (!frameSkipCount && isSkippedImageModified)
+    {
+        isSkippedImageModified = false;
+        
+        pendingCycles = frameCycleNum;
+    }
+}
+
 void AppleIIVideo::updateTiming()
 {
     // Update timing and rects
@@ -913,6 +1199,8 @@ void AppleIIVideo::updateTiming()
     imagep = image.getPixels();
     imagep += (OEInt) (vertStart - OEMinY(visibleRect)) * imageWidth + imageLeft;
     
+    invalidateLineHash();
+    
     vector<float> colorBurst;
     colorBurst.push_back(2.0 * M_PI * (-33.0 / 360.0 + (imageLeft % 4) / 4.0));
     image.setColorBurst(colorBurst);
@@ -949,7 +1237,7 @@ void AppleIIVideo::updateTiming()
     }
     
     currentTimer = TIMER_VSYNC;
-    controlBus->postMessage(this, CONTROLBUS_GET_CYCLES, &lastCycles);
+    lastCycles = getControlBusCycles(controlBusClock);
     
     OEInt id = 0;
     controlBus->postMessage(this, CONTROLBUS_INVALIDATE_TIMERS, &id);
@@ -977,7 +1265,7 @@ void AppleIIVideo::scheduleNextTimer(OESLong cycles)
             {
                 imageModified = false;
                 
-                if (videoEnabled)
+                if (videoEnabled && updateDirtyRect())
                     monitor->postMessage(this, CANVAS_POST_IMAGE, &image);
             }
             
@@ -994,9 +1282,11 @@ void AppleIIVideo::scheduleNextTimer(OESLong cycles)
                 }
             }
             
+            updateFrameSkip();
+            
             configureDraw();
             
-            controlBus->postMessage(this, CONTROLBUS_GET_CYCLES, &frameStart);
+            frameStart = getControlBusCycles(controlBusClock);
             frameStart += cycles;
             
             cycles += (vertStart + VERT_DISPLAY - 32) * HORIZ_TOTAL;
@@ -1028,9 +1318,7 @@ void AppleIIVideo::scheduleNextTimer(OESLong cycles)
 
 OEIntPoint AppleIIVideo::getCount()
 {
-    OELong cycles;
-    
-    controlBus->postMessage(this, CONTROLBUS_GET_CYCLES, &cycles);
+    OELong cycles = getControlBusCycles(controlBusClock);
     
     return count[(size_t) (cycles - frameStart)];
 }
@@ -13,6 +13,17 @@
 
 #include "ControlBusInterface.h"
 
+typedef struct
+{
+    OELong frameStart;
+    OEInt currentTimer;
+    OELong lastCycles;
+    OEInt frameSkipCount;
+    bool isSkippedImageModified;
+    bool flash;
+    OEInt flashCount;
+} AppleIIVideoState;
+
 class AppleIIVideo : public OEComponent
 {
 public:
@@ -34,6 +45,7 @@ public:
 	
 private:
     OEComponent *controlBus;
+    ControlBusClock *controlBusClock;
     OEComponent *gamePort;
 	OEComponent *monitor;
     
@@ -54,6 +66,8 @@ private:
     
     vector<OEInt> textOffset;
     vector<OEInt> hiresOffset;
+    vector<OESInt> textLine;
+    vector<OESInt> hiresLine;
     
     // Memory
     OEComponent *vram0000;
@@ -85,6 +99,9 @@ private:
     OEChar *imagep;
     OEInt imageWidth;
     bool imageModified;
+    OESInt modifiedStart;
+    OESInt modifiedEnd;
+    vector<OELong> lineHash;
     
     void (AppleIIVideo::*draw)(OESInt y, OESInt x0, OESInt x1);
     OEChar *drawMemory1;
@@ -102,6 +119,10 @@ private:
     OELong lastCycles;
     OEInt pendingCycles;
     
+    OEInt frameSkip;
+    OEInt frameSkipCount;
+    bool isSkippedImageModified;
+    
     bool flash;
     OEInt flashCount;
     
@@ -133,7 +154,14 @@ private:
     void drawHires80Line(OESInt y, OESInt x0, OESInt x1);
     void updateVideoEnabled();
     void refreshVideo();
+    void refreshVideoMemory(OEChar *p);
+    bool isDisplayedSinceUpdate(OEChar *p);
+    bool isTextLineInRange(OEChar *p, OEChar *memory, OESInt y0, OESInt y1);
+    bool isHiresLineInRange(OEChar *p, OEChar *memory, OESInt y0, OESInt y1);
     void updateVideo();
+    void invalidateLineHash();
+    bool updateDirtyRect();
+    void updateFrameSkip();
     
     void updateTiming();
     void scheduleNextTimer(OESLong cycles);
@@ -141,4 +169,7 @@ private:
     OEChar readFloatingBus();
     
     void copy(wstring *s);
+    
+    void getState(OEData *data);
+    bool setState(OEData *data);
 };
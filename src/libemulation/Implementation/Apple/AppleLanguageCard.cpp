@@ -218,6 +218,8 @@ void AppleLanguageCard::updateBankSwitcher()
         (ramMap.write == ramWrite))
         return;
     
+    memoryBus->postMessage(this, ADDRESSDECODER_BEGIN_UPDATE, NULL);
+    
     if (ramMap.read || ramMap.write)
         memoryBus->postMessage(this, ADDRESSDECODER_UNMAP, &ramMap);
     
@@ -226,4 +228,6 @@ void AppleLanguageCard::updateBankSwitcher()
     
     if (ramMap.read || ramMap.write)
         memoryBus->postMessage(this, ADDRESSDECODER_MAP, &ramMap);
+    
+    memoryBus->postMessage(this, ADDRESSDECODER_COMMIT_UPDATE, NULL);
 }
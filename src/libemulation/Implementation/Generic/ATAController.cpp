@@ -62,6 +62,7 @@ ATAController::ATAController()
     lba.q = 0;
     sectorCount = 0;
     
+    memset(buffer, 0, ATA_BUFFER_SIZE);
     bufferIndex = 0;
     
     driveSel = 0;
@@ -20,11 +20,20 @@ AddressDecoder::AddressDecoder()
 	blockSize = 0;
     
 	floatingBus = NULL;
+	controlBus = NULL;
 	
     readMapp = NULL;
     writeMapp = NULL;
+    readPointerMapp = NULL;
+    writePointerMapp = NULL;
     
 	mask = 0;
+    blockMask = 0;
+    
+    updateCount = 0;
+    isUpdatePending = false;
+    updateStartAddress = 0;
+    updateEndAddress = 0;
 }
 
 bool AddressDecoder::setValue(string name, string value)
@@ -45,6 +54,8 @@ bool AddressDecoder::setRef(string name, OEComponent *ref)
 {
 	if (name == "floatingBus")
 		floatingBus = ref;
+	else if (name == "controlBus")
+		controlBus = ref;
 	else if (name.substr(0, 3) == "ref")
 		this->ref[name.substr(3)] = ref;
 	else
@@ -57,8 +68,8 @@ bool AddressDecoder::init()
 {
     OECheckComponent(floatingBus);
 	
-    if ((size != getNextPowerOf2(size)) ||
-        (blockSize != getNextPowerOf2(blockSize)) ||
+    if ((size != (OEAddress) getNextPowerOf2(size)) ||
+        (blockSize != (OEAddress) getNextPowerOf2(blockSize)) ||
         (size < blockSize) ||
         (!blockSize) ||
         (!size))
@@ -70,18 +81,28 @@ bool AddressDecoder::init()
     
 	mask = size - 1;
     blockBits = getBitNum(blockSize);
+    blockMask = blockSize - 1;
 	
 	size_t blockNum = (size_t) (size / blockSize);
     readMap.resize(blockNum);
 	writeMap.resize(blockNum);
+    readPointerMap.resize(blockNum);
+    writePointerMap.resize(blockNum);
+    observedReadMap.resize(blockNum);
+    observedWriteMap.resize(blockNum);
     
     readMapp = &readMap.front();
     writeMapp = &writeMap.front();
+    readPointerMapp = &readPointerMap.front();
+    writePointerMapp = &writePointerMap.front();
+    
+    watcher.configure(mask, blockBits, blockNum);
+    watcher.setControlBus(controlBus);
     
     if (!updateInternalMemoryMaps())
         return false;
     
-    updateReadWriteMap(0, mask);
+    updateMemoryMap(0, mask);
     
     return true;
 }
@@ -91,7 +112,7 @@ void AddressDecoder::update()
     if (!updateInternalMemoryMaps())
         return;
     
-    updateReadWriteMap(0, mask);
+    updateMemoryMap(0, mask);
 }
 
 bool AddressDecoder::postMessage(OEComponent *sender, int message, void *data)
@@ -103,19 +124,130 @@ bool AddressDecoder::postMessage(OEComponent *sender, int message, void *data)
         
         case ADDRESSDECODER_UNMAP:
             return removeMemoryMap(externalMemoryMaps, (MemoryMap *) data);
+            
+        case ADDRESSDECODER_BEGIN_UPDATE:
+            beginUpdate();
+            
+            return true;
+            
+        case ADDRESSDECODER_COMMIT_UPDATE:
+            commitUpdate();
+            
+            return true;
+            
+        case ADDRESSDECODER_ADD_WATCHPOINT:
+            return addWatchpoint((MemoryWatchpoint *) data);
+            
+        case ADDRESSDECODER_REMOVE_WATCHPOINT:
+            return removeWatchpoint((MemoryWatchpoint *) data);
+            
+        case ADDRESSDECODER_GET_WATCHPOINTHITS:
+            watcher.getHits((MemoryWatchpointHits *) data);
+            
+            return true;
+            
+        case ADDRESSDECODER_CLEAR_WATCHPOINTHITS:
+            watcher.clearHits();
+            
+            return true;
 	}
 	
 	return false;
 }
 
+void AddressDecoder::notify(OEComponent *sender, int notification, void *data)
+{
+    if (notification != MEMORY_MAP_DID_CHANGE)
+        return;
+    
+    OEAddressRange range;
+    
+    if (updatePointerMap(sender, (OEAddressRange *) data, range))
+        postNotification(this, MEMORY_MAP_DID_CHANGE, &range);
+}
+
+// Mirrored addresses are passed to the mapped components
+
 OEChar AddressDecoder::read(OEAddress address)
 {
-	return readMapp[(size_t) ((address & mask) >> blockBits)]->read(address);
+    size_t i = (size_t) ((address & mask) >> blockBits);
+    OEChar *p = readPointerMapp[i];
+    
+    if (p && !(address & ~mask))
+        return p[address & blockMask];
+    
+    return readMapp[i]->read(address);
 }
 
 void AddressDecoder::write(OEAddress address, OEChar value)
 {
-	writeMapp[(size_t) ((address & mask) >> blockBits)]->write(address, value);
+    size_t i = (size_t) ((address & mask) >> blockBits);
+    OEChar *p = writePointerMapp[i];
+    
+    if (p && !(address & ~mask))
+    {
+        p[address & blockMask] = value;
+        
+        return;
+    }
+    
+    writeMapp[i]->write(address, value);
+}
+
+OEChar *AddressDecoder::getReadPointer(OEAddress startAddress, OEAddress endAddress)
+{
+    return getPointer(startAddress, endAddress, false);
+}
+
+OEChar *AddressDecoder::getWritePointer(OEAddress startAddress, OEAddress endAddress)
+{
+    return getPointer(startAddress, endAddress, true);
+}
+
+// Blocks are split at decoder block boundaries
+
+void AddressDecoder::readBlock(OEAddress address, OEChar *data, OEInt size)
+{
+    if (!readMapp)
+        return;
+    
+    while (size)
+    {
+        size_t i = (size_t) ((address & mask) >> blockBits);
+        OEInt n = (OEInt) min((OEAddress) size, blockSize - (address & blockMask));
+        OEChar *p = readPointerMapp[i];
+        
+        if (p && !(address & ~mask))
+            memcpy(data, p + (address & blockMask), n);
+        else
+            readMapp[i]->readBlock(address, data, n);
+        
+        address += n;
+        data += n;
+        size -= n;
+    }
+}
+
+void AddressDecoder::writeBlock(OEAddress address, const OEChar *data, OEInt size)
+{
+    if (!writeMapp)
+        return;
+    
+    while (size)
+    {
+        size_t i = (size_t) ((address & mask) >> blockBits);
+        OEInt n = (OEInt) min((OEAddress) size, blockSize - (address & blockMask));
+        OEChar *p = writePointerMapp[i];
+        
+        if (p && !(address & ~mask))
+            memcpy(p + (address & blockMask), data, n);
+        else
+            writeMapp[i]->writeBlock(address, data, n);
+        
+        address += n;
+        data += n;
+        size -= n;
+    }
 }
 
 void AddressDecoder::mapMemory(MemoryMap& value)
@@ -166,6 +298,29 @@ void AddressDecoder::updateReadWriteMap(OEAddress startAddress, OEAddress endAdd
     updateReadWriteMap(externalMemoryMaps, startAddress, endAddress);
 }
 
+void AddressDecoder::updateMemoryMap(OEAddress startAddress, OEAddress endAddress)
+{
+    if (updateCount)
+    {
+        if (!isUpdatePending || (startAddress < updateStartAddress))
+            updateStartAddress = startAddress;
+        if (!isUpdatePending || (endAddress > updateEndAddress))
+            updateEndAddress = endAddress;
+        
+        isUpdatePending = true;
+        
+        return;
+    }
+    
+    updateReadWriteMap(startAddress, endAddress);
+    updateWatchedMap(startAddress, endAddress);
+    
+    OEAddressRange range;
+    
+    if (updatePointerMap(startAddress, endAddress, range))
+        postNotification(this, MEMORY_MAP_DID_CHANGE, &range);
+}
+
 bool AddressDecoder::updateInternalMemoryMaps()
 {
     bool success = true;
@@ -210,17 +365,32 @@ bool AddressDecoder::addMemoryMap(MemoryMaps& maps, MemoryMap *value)
 {
     maps.push_back(*value);
     
-    if (readMapp)
-        updateReadWriteMap(value->startAddress, value->endAddress);
+    if (!readMapp)
+        return true;
+    
+    // The newest external map is on top of every layer
+    if (!updateCount && (&maps == &externalMemoryMaps))
+    {
+        mapMemory(*value);
+        updateWatchedMap(value->startAddress, value->endAddress);
+        
+        OEAddressRange range;
+        
+        if (updatePointerMap(value->startAddress, value->endAddress, range))
+            postNotification(this, MEMORY_MAP_DID_CHANGE, &range);
+    }
+    else
+        updateMemoryMap(value->startAddress, value->endAddress);
     
     return true;
 }
 
 bool AddressDecoder::removeMemoryMap(MemoryMaps& maps, MemoryMap *value)
 {
+    bool isRemoved = false;
+    
     for (MemoryMaps::iterator i = maps.begin();
-         i != maps.end();
-         i++)
+         i != maps.end();)
     {
         if ((i->component == value->component) &&
             (i->startAddress == value->startAddress) &&
@@ -230,10 +400,259 @@ bool AddressDecoder::removeMemoryMap(MemoryMaps& maps, MemoryMap *value)
         {
             i = maps.erase(i);
             
-            if (readMapp)
-                updateReadWriteMap(value->startAddress, value->endAddress);
+            isRemoved = true;
         }
+        else
+            i++;
     }
     
+    if (isRemoved && readMapp)
+        updateMemoryMap(value->startAddress, value->endAddress);
+    
     return true;
 }
+
+// Watchpoints
+
+void AddressDecoder::updateWatchedMap(OEAddress startAddress, OEAddress endAddress)
+{
+    if (!watcher.isWatching())
+        return;
+    
+    size_t startBlock = (size_t) ((startAddress & mask) >> blockBits);
+    size_t endBlock = (size_t) ((endAddress & mask) >> blockBits);
+    
+    for (size_t i = startBlock; i <= endBlock; i++)
+    {
+        if (watcher.isReadWatched(i) && (readMap[i] != &watcher))
+        {
+            watcher.setReadComponent(i, readMap[i]);
+            
+            readMap[i] = &watcher;
+        }
+        
+        if (watcher.isWriteWatched(i) && (writeMap[i] != &watcher))
+        {
+            watcher.setWriteComponent(i, writeMap[i]);
+            
+            writeMap[i] = &watcher;
+        }
+    }
+}
+
+bool AddressDecoder::addWatchpoint(MemoryWatchpoint *value)
+{
+    if (!readMapp)
+        return false;
+    
+    if (!watcher.addWatchpoint(value))
+    {
+        logMessage("invalid watchpoint range");
+        
+        return false;
+    }
+    
+    updateMemoryMap(value->startAddress, value->endAddress);
+    
+    return true;
+}
+
+// Rebuilding the range maps the original components back
+
+bool AddressDecoder::removeWatchpoint(MemoryWatchpoint *value)
+{
+    if (!watcher.removeWatchpoint(value))
+        return false;
+    
+    if (readMapp)
+        updateMemoryMap(value->startAddress, value->endAddress);
+    
+    return true;
+}
+
+void AddressDecoder::beginUpdate()
+{
+    updateCount++;
+}
+
+void AddressDecoder::commitUpdate()
+{
+    if (!updateCount)
+        return;
+    
+    updateCount--;
+    
+    if (updateCount || !isUpdatePending)
+        return;
+    
+    isUpdatePending = false;
+    
+    if (readMapp)
+        updateMemoryMap(updateStartAddress, updateEndAddress);
+}
+
+// Direct memory access
+
+// range is set to the decoder addresses of the blocks that changed
+
+bool AddressDecoder::updatePointerMap(OEAddress startAddress, OEAddress endAddress,
+                                      OEAddressRange& range)
+{
+    if (!readMapp)
+        return false;
+    
+    size_t startBlock = (size_t) ((startAddress & mask) >> blockBits);
+    size_t endBlock = (size_t) ((endAddress & mask) >> blockBits);
+    
+    bool isChanged = false;
+    
+    for (size_t i = startBlock; i <= endBlock; i++)
+    {
+        OEAddress blockStart = (OEAddress) i << blockBits;
+        OEAddress blockEnd = blockStart + blockSize - 1;
+        
+        OEComponent *readComponent = readMap[i];
+        OEComponent *writeComponent = writeMap[i];
+        
+        OEChar *readPointer = (readComponent ?
+                               readComponent->getReadPointer(blockStart, blockEnd) :
+                               NULL);
+        OEChar *writePointer = (writeComponent ?
+                                writeComponent->getWritePointer(blockStart, blockEnd) :
+                                NULL);
+        
+        if ((observedReadMap[i] != readComponent) ||
+            (observedWriteMap[i] != writeComponent) ||
+            (readPointerMap[i] != readPointer) ||
+            (writePointerMap[i] != writePointer))
+        {
+            if (!isChanged)
+                range.startAddress = blockStart;
+            range.endAddress = blockEnd;
+            
+            isChanged = true;
+        }
+        
+        observeComponent(observedReadMap[i], readComponent);
+        observeComponent(observedWriteMap[i], writeComponent);
+        
+        observedReadMap[i] = readComponent;
+        observedWriteMap[i] = writeComponent;
+        readPointerMap[i] = readPointer;
+        writePointerMap[i] = writePointer;
+    }
+    
+    return isChanged;
+}
+
+// Only the blocks of the component that overlap componentRange are
+// refreshed; range is set to the decoder addresses they span
+
+bool AddressDecoder::updatePointerMap(OEComponent *component,
+                                      OEAddressRange *componentRange,
+                                      OEAddressRange& range)
+{
+    bool isMapped = false;
+    
+    for (size_t i = 0; i < readMap.size(); i++)
+    {
+        if ((readMap[i] != component) && (writeMap[i] != component))
+            continue;
+        
+        OEAddress blockStart = (OEAddress) i << blockBits;
+        OEAddress blockEnd = blockStart + blockSize - 1;
+        
+        if (componentRange &&
+            !isAddressRangeOverlapping(*componentRange, blockStart, blockEnd))
+            continue;
+        
+        if (readMap[i] == component)
+            readPointerMap[i] = component->getReadPointer(blockStart, blockEnd);
+        if (writeMap[i] == component)
+            writePointerMap[i] = component->getWritePointer(blockStart, blockEnd);
+            
+        if (!isMapped)
+            range.startAddress = blockStart;
+        range.endAddress = blockEnd;
+        
+        isMapped = true;
+    }
+    
+    return isMapped;
+}
+
+void AddressDecoder::observeComponent(OEComponent *oldComponent, OEComponent *newComponent)
+{
+    if (oldComponent == newComponent)
+        return;
+    
+    if (newComponent && !observedComponents[newComponent]++)
+        newComponent->addObserver(this, MEMORY_MAP_DID_CHANGE);
+    
+    if (oldComponent && !--observedComponents[oldComponent])
+    {
+        observedComponents.erase(oldComponent);
+        
+        oldComponent->removeObserver(this, MEMORY_MAP_DID_CHANGE);
+    }
+}
+
+// Pointers are cached for the decoder's own address space;
+// mirrored addresses are resolved through the mapped components
+
+OEChar *AddressDecoder::getPointer(OEAddress startAddress, OEAddress endAddress, bool isWrite)
+{
+    if (!readMapp ||
+        (endAddress < startAddress) ||
+        ((startAddress & mask) + (endAddress - startAddress) > mask))
+        return NULL;
+    
+    size_t startBlock = (size_t) ((startAddress & mask) >> blockBits);
+    size_t endBlock = (size_t) (((startAddress & mask) + (endAddress - startAddress)) >> blockBits);
+    
+    OEAddress blockAddress = startAddress - (startAddress & mask);
+    
+    OEChar *p = NULL;
+    
+    for (size_t i = startBlock; i <= endBlock; i++)
+    {
+        OEAddress blockStart = blockAddress + ((OEAddress) i << blockBits);
+        OEAddress blockEnd = blockStart + blockSize - 1;
+        
+        if (blockStart < startAddress)
+            blockStart = startAddress;
+        if (blockEnd > endAddress)
+            blockEnd = endAddress;
+        
+        OEChar *q;
+        
+        if (!blockAddress)
+        {
+            q = isWrite ? writePointerMap[i] : readPointerMap[i];
+            
+            if (q)
+                q += blockStart & (blockSize - 1);
+        }
+        else
+        {
+            OEComponent *component = isWrite ? writeMapp[i] : readMapp[i];
+            
+            if (!component)
+                return NULL;
+            
+            q = (isWrite ?
+                 component->getWritePointer(blockStart, blockEnd) :
+                 component->getReadPointer(blockStart, blockEnd));
+        }
+        
+        if (!q)
+            return NULL;
+        
+        if (i == startBlock)
+            p = q;
+        else if (q != p + (blockStart - startAddress))
+            return NULL;
+    }
+    
+    return p;
+}
@@ -15,6 +15,23 @@
 
 #include "MemoryInterface.h"
 
+#include "AddressWatcher.h"
+
+// Notes:
+// * Subclasses apply their layers in updateReadWriteMap. externalMemoryMaps
+//   must be the last layer applied, so a map added to it can be written
+//   to the block tables without rescanning the other maps.
+// * read and write go through the cached block pointers when the mapped
+//   component provides them, so offset, mux and masker chains in front of
+//   a RAM cost one table lookup.
+// * Between beginUpdate and commitUpdate, table updates only extend the
+//   dirty range, which is rebuilt once on the outermost commit.
+// * MEMORY_MAP_DID_CHANGE is posted with the span of the blocks whose
+//   components or pointers changed, so a commit covering the union of
+//   the updated ranges only invalidates that span.
+// * Watched blocks are mapped to the watcher after each table update, so
+//   watchpoints survive remapping. Unwatched blocks are not touched.
+
 class AddressDecoder : public OEComponent
 {
 public:
@@ -27,9 +44,17 @@ public:
     
     bool postMessage(OEComponent *sender, int event, void *data);
     
+    void notify(OEComponent *sender, int notification, void *data);
+    
     OEChar read(OEAddress address);
     void write(OEAddress address, OEChar value);
     
+    OEChar *getReadPointer(OEAddress startAddress, OEAddress endAddress);
+    OEChar *getWritePointer(OEAddress startAddress, OEAddress endAddress);
+    
+    void readBlock(OEAddress address, OEChar *data, OEInt size);
+    void writeBlock(OEAddress address, const OEChar *data, OEInt size);
+    
 protected:
     OEAddress size;
     OEAddress blockSize;
@@ -39,18 +64,26 @@ protected:
     
     OEComponent **readMapp;
     OEComponent **writeMapp;
+    OEChar **readPointerMapp;
+    OEChar **writePointerMapp;
     
     OEAddress mask;
     OEInt blockBits;
+    OEAddress blockMask;
     
     void updateReadWriteMap(MemoryMaps& value, OEAddress startAddress, OEAddress endAddress);
     virtual void updateReadWriteMap(OEAddress startAddress, OEAddress endAddress);
+    void updateMemoryMap(OEAddress startAddress, OEAddress endAddress);
     
     bool addMemoryMap(MemoryMaps& maps, MemoryMap *value);
     bool removeMemoryMap(MemoryMaps& maps, MemoryMap *value);
     
+    void beginUpdate();
+    void commitUpdate();
+    
 private:
     OEComponent *floatingBus;
+    OEComponent *controlBus;
     
     MemoryMapsRef ref;
     MemoryMapsConf conf;
@@ -58,8 +91,33 @@ private:
     OEComponents readMap;
     OEComponents writeMap;
     
+    vector<OEChar *> readPointerMap;
+    vector<OEChar *> writePointerMap;
+    OEComponents observedReadMap;
+    OEComponents observedWriteMap;
+    map<OEComponent *, OEInt> observedComponents;
+    
+    OEInt updateCount;
+    bool isUpdatePending;
+    OEAddress updateStartAddress;
+    OEAddress updateEndAddress;
+    
+    AddressWatcher watcher;
+    
     void mapMemory(MemoryMap& value);
     bool updateInternalMemoryMaps();
+    void updateWatchedMap(OEAddress startAddress, OEAddress endAddress);
+    
+    bool addWatchpoint(MemoryWatchpoint *value);
+    bool removeWatchpoint(MemoryWatchpoint *value);
+    
+    bool updatePointerMap(OEAddress startAddress, OEAddress endAddress,
+                          OEAddressRange& range);
+    bool updatePointerMap(OEComponent *component,
+                          OEAddressRange *componentRange,
+                          OEAddressRange& range);
+    void observeComponent(OEComponent *oldComponent, OEComponent *newComponent);
+    OEChar *getPointer(OEAddress startAddress, OEAddress endAddress, bool isWrite);
 };
 
 #endif
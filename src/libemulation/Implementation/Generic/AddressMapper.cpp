@@ -12,12 +12,23 @@
 
 AddressMapper::AddressMapper()
 {
+    addressDecoder = NULL;
+    
+    isSelPending = false;
+    
+    isSelMapsBuilt = false;
+    
+    lastSelMask = 0;
+    selMask = 0;
 }
 
 bool AddressMapper::setValue(string name, string value)
 {
     if (name == "sel")
+    {
         sel = value;
+        isSelPending = true;
+    }
 	else if (name.substr(0, 3) == "map")
         conf[name.substr(3)] = value;
     else
@@ -29,7 +40,7 @@ bool AddressMapper::setValue(string name, string value)
 bool AddressMapper::getValue(string name, string& value)
 {
     if (name == "sel")
-        value = sel;
+        value = isSelPending ? sel : getSel(selOrder);
     else
         return false;
     
@@ -52,6 +63,8 @@ bool AddressMapper::init()
 {
     OECheckComponent(addressDecoder);
     
+    buildSelMaps();
+    
     update();
     
     return true;
@@ -59,31 +72,47 @@ bool AddressMapper::init()
 
 void AddressMapper::update()
 {
-    if (lastSel == sel)
+    if (isSelPending)
+    {
+        selMask = getSelMask(sel, selOrder);
+        
+        isSelPending = false;
+    }
+    
+    if ((lastSelMask == selMask) && (lastSelOrder == selOrder))
         return;
     
-    MemoryMaps m;
+    OELong unmapMask = lastSelMask & ~selMask;
+    OELong mapMask = selMask & ~lastSelMask;
+    OELong keepMask = lastSelMask & selMask;
     
-    m = buildMemoryMaps(lastSel);
+    OELong overlapMask = 0;
+    for (OEInt i = 0; i < selNames.size(); i++)
+        if (mapMask & (1ULL << i))
+            overlapMask |= selOverlaps[i];
     
-    for (MemoryMaps::iterator i = m.begin();
-         i != m.end();
-         i++)
-        addressDecoder->postMessage(this, ADDRESSDECODER_UNMAP, &*i);
+    if ((overlapMask & keepMask) || isSelReordered(keepMask))
+    {
+        unmapMask = lastSelMask;
+        mapMask = selMask;
+    }
     
-    m = buildMemoryMaps(sel);
+    addressDecoder->postMessage(this, ADDRESSDECODER_BEGIN_UPDATE, NULL);
     
-    for (MemoryMaps::iterator i = m.begin();
-         i != m.end();
-         i++)
-        addressDecoder->postMessage(this, ADDRESSDECODER_MAP, &*i);
+    postSelMaps(lastSelOrder, unmapMask, ADDRESSDECODER_UNMAP);
+    postSelMaps(selOrder, mapMask, ADDRESSDECODER_MAP);
     
-    lastSel = sel;
+    addressDecoder->postMessage(this, ADDRESSDECODER_COMMIT_UPDATE, NULL);
+    
+    lastSelMask = selMask;
+    lastSelOrder = selOrder;
 }
 
 void AddressMapper::dispose()
 {
-    sel = "";
+    selMask = 0;
+    selOrder.clear();
+    isSelPending = false;
     
     update();
 }
@@ -94,18 +123,105 @@ bool AddressMapper::postMessage(OEComponent *sender, int message, void *data)
     {
         case ADDRESSMAPPER_SELECT:
             sel = *((string *)data);
+            isSelPending = true;
             
             update();
             
             return true;
+            
+        case ADDRESSMAPPER_SELECT_MASK:
+            selMask = *((OELong *)data);
+            isSelPending = false;
+            
+            getSelOrder(selMask, selOrder);
+            
+            update();
+            
+            return true;
+            
+        case ADDRESSMAPPER_GET_MASK:
+        {
+            AddressMapperMask *mask = (AddressMapperMask *)data;
+            vector<OEInt> order;
+            
+            mask->mask = getSelMask(mask->sel, order);
+            
+            return true;
+        }
     }
     
     return false;
 }
 
-MemoryMaps AddressMapper::buildMemoryMaps(string value)
+void AddressMapper::buildSelMaps()
 {
-    MemoryMaps m;
+    if (isSelMapsBuilt)
+        return;
+    
+    isSelMapsBuilt = true;
+    
+    for (MemoryMapsRef::iterator i = ref.begin();
+         i != ref.end();
+         i++)
+    {
+        if (selNames.size() == 64)
+        {
+            logMessage("too many memory maps, ignoring " + i->first);
+            
+            continue;
+        }
+        
+        MemoryMaps m;
+        
+        if (!appendMemoryMaps(m, i->second, conf[i->first]))
+            logMessage("invalid memory map " + conf[i->first] + " for " + i->first);
+        
+        selNames.push_back(i->first);
+        selMaps.push_back(m);
+    }
+    
+    selOverlaps.resize(selNames.size());
+    
+    for (OEInt i = 0; i < selNames.size(); i++)
+    {
+        selOverlaps[i] = 0;
+        
+        for (OEInt j = 0; j < selNames.size(); j++)
+            if ((i != j) && isOverlapping(selMaps[i], selMaps[j]))
+                selOverlaps[i] |= (1ULL << j);
+    }
+}
+
+bool AddressMapper::isOverlapping(MemoryMaps& a, MemoryMaps& b)
+{
+    for (MemoryMaps::iterator i = a.begin();
+         i != a.end();
+         i++)
+        for (MemoryMaps::iterator j = b.begin();
+             j != b.end();
+             j++)
+        {
+            if ((i->startAddress > j->endAddress) ||
+                (j->startAddress > i->endAddress))
+                continue;
+            
+            if ((i->read && j->read) || (i->write && j->write))
+                return true;
+        }
+    
+    return false;
+}
+
+// A name selected more than once keeps its last position, where it was
+// mapped on top
+
+OELong AddressMapper::getSelMask(string value, vector<OEInt>& order)
+{
+    buildSelMaps();
+    
+    OELong mask = 0;
+    
+    order.clear();
     
     vector<string> values = strsplit(value, ',');
     
@@ -113,14 +229,82 @@ MemoryMaps AddressMapper::buildMemoryMaps(string value)
          i != values.end();
          i++)
     {
-        string sel = *i;
+        vector<string>::iterator j = find(selNames.begin(), selNames.end(), *i);
         
-        if (!ref.count(sel))
+        if (j == selNames.end())
             continue;
         
-        if (!appendMemoryMaps(m, ref[sel], conf[sel]))
-            logMessage("could not remove memory map " + conf[lastSel] + " for " + lastSel);
+        OEInt index = (OEInt) (j - selNames.begin());
+        
+        if (mask & (1ULL << index))
+            order.erase(find(order.begin(), order.end(), index));
+        
+        order.push_back(index);
+        
+        mask |= (1ULL << index);
     }
     
-    return m;
+    return mask;
+}
+
+void AddressMapper::getSelOrder(OELong mask, vector<OEInt>& order)
+{
+    order.clear();
+    
+    for (OEInt i = 0; i < selNames.size(); i++)
+        if (mask & (1ULL << i))
+            order.push_back(i);
+}
+
+string AddressMapper::getSel(vector<OEInt>& order)
+{
+    string value;
+    
+    for (vector<OEInt>::iterator i = order.begin();
+         i != order.end();
+         i++)
+    {
+        if (value != "")
+            value += ",";
+            
+        value += selNames[*i];
+    }
+    
+    return value;
+}
+
+bool AddressMapper::isSelReordered(OELong keepMask)
+{
+    vector<OEInt>::iterator i = lastSelOrder.begin();
+    vector<OEInt>::iterator j = selOrder.begin();
+    
+    while (true)
+    {
+        while ((i != lastSelOrder.end()) && !(keepMask & (1ULL << *i)))
+            i++;
+        while ((j != selOrder.end()) && !(keepMask & (1ULL << *j)))
+            j++;
+        
+        if ((i == lastSelOrder.end()) || (j == selOrder.end()))
+            return false;
+        
+        if (*i++ != *j++)
+            return true;
+    }
+}
+
+void AddressMapper::postSelMaps(vector<OEInt>& order, OELong mask, int message)
+{
+    for (vector<OEInt>::iterator i = order.begin();
+         i != order.end();
+         i++)
+    {
+        if (!(mask & (1ULL << *i)))
+            continue;
+        
+        for (MemoryMaps::iterator j = selMaps[*i].begin();
+             j != selMaps[*i].end();
+             j++)
+            addressDecoder->postMessage(this, message, &*j);
+    }
 }
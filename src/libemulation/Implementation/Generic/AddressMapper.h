@@ -12,6 +12,16 @@
 
 #include "MemoryInterface.h"
 
+// Notes:
+// * The map* configuration is parsed once into one set of memory maps per
+//   name. Each name is a bit of the selection mask (at most 64 names).
+// * Names are mapped in selection order, so later names take precedence
+//   where they overlap. A mask selection has no order of its own and is
+//   mapped in name order.
+// * A selection change only unmaps and maps the names whose bit changed.
+//   If a newly selected name overlaps a name that stays selected, or names
+//   that stay selected change order, all selected names are remapped.
+
 class AddressMapper : public OEComponent
 {
 public:
@@ -32,8 +42,24 @@ private:
     MemoryMapsConf conf;
     MemoryMapsRef ref;
     
-    string lastSel;
     string sel;
+    bool isSelPending;
+    
+    bool isSelMapsBuilt;
+    vector<string> selNames;
+    vector<MemoryMaps> selMaps;
+    vector<OELong> selOverlaps;
+    
+    OELong lastSelMask;
+    OELong selMask;
+    vector<OEInt> lastSelOrder;
+    vector<OEInt> selOrder;
     
-    MemoryMaps buildMemoryMaps(string value);
+    void buildSelMaps();
+    bool isOverlapping(MemoryMaps& a, MemoryMaps& b);
+    OELong getSelMask(string value, vector<OEInt>& order);
+    void getSelOrder(OELong mask, vector<OEInt>& order);
+    string getSel(vector<OEInt>& order);
+    bool isSelReordered(OELong keepMask);
+    void postSelMaps(vector<OEInt>& order, OELong mask, int message);
 };
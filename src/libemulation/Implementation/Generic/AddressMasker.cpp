@@ -35,7 +35,13 @@ bool AddressMasker::setValue(string name, string value)
 bool AddressMasker::setRef(string name, OEComponent *ref)
 {
     if (name == "memory")
+    {
+        if (memory)
+            memory->removeObserver(this, MEMORY_MAP_DID_CHANGE);
         memory = ref;
+        if (memory)
+            memory->addObserver(this, MEMORY_MAP_DID_CHANGE);
+    }
     else
         return false;
     
@@ -58,9 +64,19 @@ bool AddressMasker::postMessage(OEComponent *sender, int message, void *data)
     else
         return false;
     
+    postNotification(this, MEMORY_MAP_DID_CHANGE, NULL);
+    
     return true;
 }
 
+void AddressMasker::notify(OEComponent *sender, int notification, void *data)
+{
+    if (notification != MEMORY_MAP_DID_CHANGE)
+        return;
+    
+    postNotification(this, MEMORY_MAP_DID_CHANGE, NULL);
+}
+
 OEChar AddressMasker::read(OEAddress address)
 {
     return memory->read((address & andMask) | orMask);
@@ -70,3 +86,62 @@ void AddressMasker::write(OEAddress address, OEChar value)
 {
     memory->write((address & andMask) | orMask, value);
 }
+
+OEChar *AddressMasker::getReadPointer(OEAddress startAddress, OEAddress endAddress)
+{
+    if (!getMaskedRange(startAddress, endAddress))
+        return NULL;
+    
+    return memory->getReadPointer(startAddress, endAddress);
+}
+
+OEChar *AddressMasker::getWritePointer(OEAddress startAddress, OEAddress endAddress)
+{
+    if (!getMaskedRange(startAddress, endAddress))
+        return NULL;
+    
+    return memory->getWritePointer(startAddress, endAddress);
+}
+
+void AddressMasker::readBlock(OEAddress address, OEChar *data, OEInt size)
+{
+    OEAddress startAddress = address;
+    OEAddress endAddress = address + size - 1;
+    
+    if (size && getMaskedRange(startAddress, endAddress))
+        memory->readBlock(startAddress, data, size);
+    else
+        OEComponent::readBlock(address, data, size);
+}
+
+void AddressMasker::writeBlock(OEAddress address, const OEChar *data, OEInt size)
+{
+    OEAddress startAddress = address;
+    OEAddress endAddress = address + size - 1;
+    
+    if (size && getMaskedRange(startAddress, endAddress))
+        memory->writeBlock(startAddress, data, size);
+    else
+        OEComponent::writeBlock(address, data, size);
+}
+
+// A range stays contiguous when the masks leave every address bit that
+// changes within the range untouched
+
+bool AddressMasker::getMaskedRange(OEAddress& startAddress, OEAddress& endAddress)
+{
+    if (endAddress < startAddress)
+        return false;
+    
+    OEAddress rangeMask = startAddress ^ endAddress;
+    for (OEInt i = 1; i < 64; i <<= 1)
+        rangeMask |= rangeMask >> i;
+    
+    if (((andMask & rangeMask) != rangeMask) || (orMask & rangeMask))
+        return false;
+    
+    startAddress = (startAddress & andMask) | orMask;
+    endAddress = (endAddress & andMask) | orMask;
+    
+    return true;
+}
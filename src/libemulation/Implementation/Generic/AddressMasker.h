@@ -21,12 +21,22 @@ public:
     
     bool postMessage(OEComponent *sender, int message, void *data);
     
+    void notify(OEComponent *sender, int notification, void *data);
+    
     OEChar read(OEAddress address);
     void write(OEAddress address, OEChar value);
     
+    OEChar *getReadPointer(OEAddress startAddress, OEAddress endAddress);
+    OEChar *getWritePointer(OEAddress startAddress, OEAddress endAddress);
+    
+    void readBlock(OEAddress address, OEChar *data, OEInt size);
+    void writeBlock(OEAddress address, const OEChar *data, OEInt size);
+    
 private:
     OEComponent *memory;
     
     OEAddress andMask;
     OEAddress orMask;
+    
+    bool getMaskedRange(OEAddress& startAddress, OEAddress& endAddress);
 };
@@ -12,6 +12,7 @@
 
 AddressMux::AddressMux()
 {
+    component = &dummyComponent;
 }
 
 bool AddressMux::setValue(string name, string value)
@@ -53,17 +54,37 @@ bool AddressMux::init()
 
 void AddressMux::update()
 {
-    if (ref.count(sel))
+    OEComponent *oldComponent = component;
+    
+    if (ref.count(sel) && ref[sel])
         component = ref[sel];
     else
         component = &dummyComponent;
+    
+    oldComponent->removeObserver(this, MEMORY_MAP_DID_CHANGE);
+    component->addObserver(this, MEMORY_MAP_DID_CHANGE);
+    
+    postNotification(this, MEMORY_MAP_DID_CHANGE, NULL);
 }
 
 bool AddressMux::postMessage(OEComponent *sender, int message, void *data)
 {
+    // The state belongs to the selected component, not to the mux
+    if ((message == COMPONENT_GET_STATE) || (message == COMPONENT_SET_STATE))
+        return false;
+    
     return component->postMessage(sender, message, data);
 }
 
+void AddressMux::notify(OEComponent *sender, int notification, void *data)
+{
+    if (notification != MEMORY_MAP_DID_CHANGE)
+        return;
+    
+    // Addresses are passed unchanged, so is the range
+    postNotification(this, MEMORY_MAP_DID_CHANGE, data);
+}
+
 OEChar AddressMux::read(OEAddress address)
 {
     return component->read(address);
@@ -103,3 +124,23 @@ void AddressMux::write64(OEAddress address, OELong value)
 {
     component->write64(address, value);
 }
+
+OEChar *AddressMux::getReadPointer(OEAddress startAddress, OEAddress endAddress)
+{
+    return component->getReadPointer(startAddress, endAddress);
+}
+
+OEChar *AddressMux::getWritePointer(OEAddress startAddress, OEAddress endAddress)
+{
+    return component->getWritePointer(startAddress, endAddress);
+}
+
+void AddressMux::readBlock(OEAddress address, OEChar *data, OEInt size)
+{
+    component->readBlock(address, data, size);
+}
+
+void AddressMux::writeBlock(OEAddress address, const OEChar *data, OEInt size)
+{
+    component->writeBlock(address, data, size);
+}
@@ -25,6 +25,8 @@ public:
     
     bool postMessage(OEComponent *sender, int message, void *data);
     
+    void notify(OEComponent *sender, int notification, void *data);
+    
     OEChar read(OEAddress address);
     void write(OEAddress address, OEChar value);
     OEShort read16(OEAddress address);
@@ -34,6 +36,12 @@ public:
     OELong read64(OEAddress address);
     void write64(OEAddress address, OELong value);
     
+    OEChar *getReadPointer(OEAddress startAddress, OEAddress endAddress);
+    OEChar *getWritePointer(OEAddress startAddress, OEAddress endAddress);
+    
+    void readBlock(OEAddress address, OEChar *data, OEInt size);
+    void writeBlock(OEAddress address, const OEChar *data, OEInt size);
+    
 private:
     MemoryMapsRef ref;
     
@@ -35,7 +35,13 @@ bool AddressOffset::setValue(string name, string value)
 bool AddressOffset::setRef(string name, OEComponent *ref)
 {
     if (name == "memory")
+    {
+        if (memory)
+            memory->removeObserver(this, MEMORY_MAP_DID_CHANGE);
         memory = ref;
+        if (memory)
+            memory->addObserver(this, MEMORY_MAP_DID_CHANGE);
+    }
     else
         return false;
     
@@ -69,6 +75,8 @@ bool AddressOffset::init()
     
     offsetMaps.clear();
     
+    postNotification(this, MEMORY_MAP_DID_CHANGE, NULL);
+    
     return true;
 }
 
@@ -82,6 +90,14 @@ bool AddressOffset::postMessage(OEComponent *sender, int message, void *data)
     return true;
 }
 
+void AddressOffset::notify(OEComponent *sender, int notification, void *data)
+{
+    if (notification != MEMORY_MAP_DID_CHANGE)
+        return;
+    
+    postNotification(this, MEMORY_MAP_DID_CHANGE, NULL);
+}
+
 OEChar AddressOffset::read(OEAddress address)
 {
     return memory->read(address + offsetp[(address & mask) >> blockBits]);
@@ -103,9 +119,106 @@ bool AddressOffset::mapOffset(AddressOffsetMap& value)
         
         OESLong offset = value.offset;
         
+        bool isChanged = false;
+        
         for (size_t i = startBlock; i <= endBlock; i++)
+        {
+            isChanged |= (offsetp[i] != offset);
+            
             offsetp[i] = offset;
+        }
+        
+        if (isChanged)
+            postNotification(this, MEMORY_MAP_DID_CHANGE, NULL);
     }
     
     return true;
 }
+
+OEChar *AddressOffset::getReadPointer(OEAddress startAddress, OEAddress endAddress)
+{
+    return getPointer(startAddress, endAddress, false);
+}
+
+OEChar *AddressOffset::getWritePointer(OEAddress startAddress, OEAddress endAddress)
+{
+    return getPointer(startAddress, endAddress, true);
+}
+
+OEChar *AddressOffset::getPointer(OEAddress startAddress, OEAddress endAddress, bool isWrite)
+{
+    if (!offsetp ||
+        (endAddress < startAddress) ||
+        ((startAddress & mask) + (endAddress - startAddress) > mask))
+        return NULL;
+    
+    size_t startBlock = (size_t) ((startAddress & mask) >> blockBits);
+    size_t endBlock = (size_t) (((startAddress & mask) + (endAddress - startAddress)) >> blockBits);
+    
+    OEAddress blockAddress = startAddress - (startAddress & mask);
+    
+    OEChar *p = NULL;
+    
+    for (size_t i = startBlock; i <= endBlock; i++)
+    {
+        OEAddress blockStart = blockAddress + ((OEAddress) i << blockBits);
+        OEAddress blockEnd = blockStart + blockSize - 1;
+        
+        if (blockStart < startAddress)
+            blockStart = startAddress;
+        if (blockEnd > endAddress)
+            blockEnd = endAddress;
+        
+        OEChar *q = (isWrite ?
+                     memory->getWritePointer(blockStart + offsetp[i], blockEnd + offsetp[i]) :
+                     memory->getReadPointer(blockStart + offsetp[i], blockEnd + offsetp[i]));
+        
+        if (!q)
+            return NULL;
+        
+        if (i == startBlock)
+            p = q;
+        else if (q != p + (blockStart - startAddress))
+            return NULL;
+    }
+    
+    return p;
+}
+
+// Blocks are split where the offset can change
+
+void AddressOffset::readBlock(OEAddress address, OEChar *data, OEInt size)
+{
+    if (!offsetp)
+        return;
+    
+    while (size)
+    {
+        OEAddress blockOffset = address & (blockSize - 1);
+        OEInt n = (OEInt) min((OEAddress) size, blockSize - blockOffset);
+        
+        memory->readBlock(address + offsetp[(address & mask) >> blockBits], data, n);
+        
+        address += n;
+        data += n;
+        size -= n;
+    }
+}
+
+void AddressOffset::writeBlock(OEAddress address, const OEChar *data, OEInt size)
+{
+    if (!offsetp)
+        return;
+    
+    while (size)
+    {
+        OEAddress blockOffset = address & (blockSize - 1);
+        OEInt n = (OEInt) min((OEAddress) size, blockSize - blockOffset);
+        
+        memory->writeBlock(address + offsetp[(address & mask) >> blockBits], data, n);
+        
+        address += n;
+        data += n;
+        size -= n;
+    }
+}
@@ -0,0 +1,198 @@
+
+/**
+ * libemulation
+ * Address watcher
+ * (C) 2012 by Marc S. Ressl (mressl@umich.edu)
+ * Released under the GPL
+ *
+ * Records accesses to watched addresses
+ */
+
+#include "AddressWatcher.h"
+
+#define HIT_MAX     1024
+
+AddressWatcher::AddressWatcher()
+{
+    mask = 0;
+    blockBits = 0;
+    
+    controlBus = NULL;
+    controlBusClock = NULL;
+}
+
+void AddressWatcher::configure(OEAddress mask, OEInt blockBits, size_t blockNum)
+{
+    this->mask = mask;
+    this->blockBits = blockBits;
+    
+    readWatchNum.assign(blockNum, 0);
+    writeWatchNum.assign(blockNum, 0);
+    readMap.assign(blockNum, NULL);
+    writeMap.assign(blockNum, NULL);
+    
+    for (MemoryWatchpoints::iterator i = watchpoints.begin();
+         i != watchpoints.end();
+         i++)
+        updateWatchNum(*i, true);
+}
+
+void AddressWatcher::setControlBus(OEComponent *controlBus)
+{
+    this->controlBus = controlBus;
+    
+    controlBusClock = NULL;
+    
+    if (controlBus)
+        controlBus->postMessage(this, CONTROLBUS_GET_CLOCK, &controlBusClock);
+}
+
+bool AddressWatcher::addWatchpoint(MemoryWatchpoint *value)
+{
+    if ((value->startAddress > value->endAddress) ||
+        (value->endAddress > mask))
+        return false;
+    
+    watchpoints.push_back(*value);
+    
+    updateWatchNum(*value, true);
+    
+    return true;
+}
+
+bool AddressWatcher::removeWatchpoint(MemoryWatchpoint *value)
+{
+    for (MemoryWatchpoints::iterator i = watchpoints.begin();
+         i != watchpoints.end();
+         i++)
+    {
+        if ((i->startAddress == value->startAddress) &&
+            (i->endAddress == value->endAddress) &&
+            (i->read == value->read) &&
+            (i->write == value->write) &&
+            (i->halt == value->halt))
+        {
+            updateWatchNum(*i, false);
+            
+            watchpoints.erase(i);
+            
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+bool AddressWatcher::isWatching()
+{
+    return !watchpoints.empty();
+}
+
+bool AddressWatcher::isReadWatched(size_t block)
+{
+    return readWatchNum[block] != 0;
+}
+
+bool AddressWatcher::isWriteWatched(size_t block)
+{
+    return writeWatchNum[block] != 0;
+}
+
+void AddressWatcher::setReadComponent(size_t block, OEComponent *component)
+{
+    readMap[block] = component;
+}
+
+void AddressWatcher::setWriteComponent(size_t block, OEComponent *component)
+{
+    writeMap[block] = component;
+}
+
+void AddressWatcher::getHits(MemoryWatchpointHits *value)
+{
+    value->assign(hits.begin(), hits.end());
+}
+
+void AddressWatcher::clearHits()
+{
+    hits.clear();
+}
+
+OEChar AddressWatcher::read(OEAddress address)
+{
+    OEChar value = readMap[(size_t) ((address & mask) >> blockBits)]->read(address);
+    
+    checkWatchpoints(address, value, false);
+    
+    return value;
+}
+
+void AddressWatcher::write(OEAddress address, OEChar value)
+{
+    writeMap[(size_t) ((address & mask) >> blockBits)]->write(address, value);
+    
+    checkWatchpoints(address, value, true);
+}
+
+void AddressWatcher::updateWatchNum(MemoryWatchpoint& value, bool isAdded)
+{
+    if (readWatchNum.empty())
+        return;
+    
+    size_t startBlock = (size_t) (value.startAddress >> blockBits);
+    size_t endBlock = (size_t) (value.endAddress >> blockBits);
+    
+    for (size_t i = startBlock; i <= endBlock; i++)
+    {
+        if (value.read)
+            isAdded ? readWatchNum[i]++ : readWatchNum[i]--;
+        if (value.write)
+            isAdded ? writeWatchNum[i]++ : writeWatchNum[i]--;
+    }
+}
+
+// A block may hold addresses no watchpoint covers, so every access is matched
+
+void AddressWatcher::checkWatchpoints(OEAddress address, OEChar value, bool isWrite)
+{
+    OEAddress watchAddress = address & mask;
+    
+    bool isHit = false;
+    bool isHalt = false;
+    
+    for (MemoryWatchpoints::iterator i = watchpoints.begin();
+         i != watchpoints.end();
+         i++)
+    {
+        if ((isWrite ? !i->write : !i->read) ||
+            (watchAddress < i->startAddress) ||
+            (watchAddress > i->endAddress))
+            continue;
+        
+        isHit = true;
+        isHalt |= i->halt;
+    }
+    
+    if (!isHit)
+        return;
+    
+    MemoryWatchpointHit hit;
+    
+    hit.cycles = controlBusClock ? getControlBusCycles(controlBusClock) : 0;
+    hit.address = address;
+    hit.value = value;
+    hit.write = isWrite;
+    
+    if (hits.size() >= HIT_MAX)
+        hits.pop_front();
+    
+    hits.push_back(hit);
+    
+    if (isHalt && controlBus)
+    {
+        ControlBusPowerState powerState = CONTROLBUS_POWERSTATE_PAUSE;
+        
+        controlBus->postMessage(this, CONTROLBUS_SET_POWERSTATE, &powerState);
+        controlBus->postMessage(this, CONTROLBUS_END_SLICE, NULL);
+    }
+}
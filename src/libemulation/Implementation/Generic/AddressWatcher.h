@@ -0,0 +1,70 @@
+
+/**
+ * libemulation
+ * Address watcher
+ * (C) 2012 by Marc S. Ressl (mressl@umich.edu)
+ * Released under the GPL
+ *
+ * Records accesses to watched addresses
+ */
+
+#ifndef _ADDRESSWATCHER_H
+#define _ADDRESSWATCHER_H
+
+#include <deque>
+
+#include "OEComponent.h"
+
+#include "MemoryInterface.h"
+#include "ControlBusInterface.h"
+
+// Notes:
+// * An address watcher is owned by an address decoder. The decoder maps
+//   the watcher over the blocks covered by a watchpoint, after passing it
+//   the components the blocks were mapped to.
+// * The watcher provides no direct pointers, so every access to a watched
+//   block reaches read/write, which forward it to the original component.
+
+class AddressWatcher : public OEComponent
+{
+public:
+    AddressWatcher();
+    
+    void configure(OEAddress mask, OEInt blockBits, size_t blockNum);
+    void setControlBus(OEComponent *controlBus);
+    
+    bool addWatchpoint(MemoryWatchpoint *value);
+    bool removeWatchpoint(MemoryWatchpoint *value);
+    bool isWatching();
+    
+    bool isReadWatched(size_t block);
+    bool isWriteWatched(size_t block);
+    void setReadComponent(size_t block, OEComponent *component);
+    void setWriteComponent(size_t block, OEComponent *component);
+    
+    void getHits(MemoryWatchpointHits *value);
+    void clearHits();
+    
+    OEChar read(OEAddress address);
+    void write(OEAddress address, OEChar value);
+    
+private:
+    OEAddress mask;
+    OEInt blockBits;
+    
+    OEComponent *controlBus;
+    ControlBusClock *controlBusClock;
+    
+    MemoryWatchpoints watchpoints;
+    vector<OEInt> readWatchNum;
+    vector<OEInt> writeWatchNum;
+    OEComponents readMap;
+    OEComponents writeMap;
+    
+    deque<MemoryWatchpointHit> hits;
+    
+    void updateWatchNum(MemoryWatchpoint& value, bool isAdded);
+    void checkWatchpoints(OEAddress address, OEChar value, bool isWrite);
+};
+
+#endif
@@ -41,6 +41,7 @@ AudioCodec::AudioCodec()
     
     audio = NULL;
     controlBus = NULL;
+    controlBusClock = NULL;
     
     audioBuffer = NULL;
     
@@ -94,6 +95,9 @@ bool AudioCodec::init()
     OECheckComponent(audio);
     OECheckComponent(controlBus);
     
+    controlBus->postMessage(this, CONTROLBUS_GET_CLOCK, &controlBusClock);
+    OECheckComponent(controlBusClock);
+    
     updateSynth();
     
     return true;
@@ -141,9 +145,7 @@ OEChar AudioCodec::read(OEAddress address)
     if (!audioBuffer)
         return 0;
     
-    float audioBufferFrame;
-    
-    controlBus->postMessage(this, CONTROLBUS_GET_AUDIOBUFFERFRAME, &audioBufferFrame);
+    float audioBufferFrame = getControlBusAudioBufferFrame(controlBusClock);
     
     OEInt index = audioBuffer->channelNum * ((OEInt) audioBufferFrame);
     index += (OEInt) address % audioBuffer->channelNum;
@@ -156,9 +158,7 @@ void AudioCodec::write(OEAddress address, OEChar value)
     if (!audioBuffer)
         return;
     
-    float audioBufferFrame;
-    
-    controlBus->postMessage(this, CONTROLBUS_GET_AUDIOBUFFERFRAME, &audioBufferFrame);
+    float audioBufferFrame = getControlBusAudioBufferFrame(controlBusClock);
     
     if (address < audioBuffer->channelNum)
         setSynth(audioBufferFrame, (OEInt) address, (value - 128) / 128.0F);
@@ -169,9 +169,7 @@ OEShort AudioCodec::read16(OEAddress address)
     if (!audioBuffer)
         return 0;
     
-    float audioBufferFrame;
-    
-    controlBus->postMessage(this, CONTROLBUS_GET_AUDIOBUFFERFRAME, &audioBufferFrame);
+    float audioBufferFrame = getControlBusAudioBufferFrame(controlBusClock);
     
     OEInt index = audioBuffer->channelNum * ((OEInt) audioBufferFrame);
     index += (OEInt) address % audioBuffer->channelNum;
@@ -184,22 +182,23 @@ void AudioCodec::write16(OEAddress address, OEShort value)
     if (!audioBuffer)
         return;
     
-    float audioBufferFrame;
-    
-    controlBus->postMessage(this, CONTROLBUS_GET_AUDIOBUFFERFRAME, &audioBufferFrame);
+    float audioBufferFrame = getControlBusAudioBufferFrame(controlBusClock);
     
     if (address < audioBuffer->channelNum)
         setSynth(audioBufferFrame, (OEInt) address, ((OESShort) value) / 32768.0F);
 }
 
+// audioBuffer is only valid while a buffer renders, so the synth is
+// built from the last known sample rate
+
 void AudioCodec::updateSynth()
 {
-    if (!audioBuffer)
+    if (!sampleRate)
         return;
     
-    integrationAlpha = 1.0F / (1.0F + lowFrequency / audioBuffer->sampleRate);
+    integrationAlpha = 1.0F / (1.0F + lowFrequency / sampleRate);
     
-    float sincCutoff = 2.0F * highFrequency / audioBuffer->sampleRate;
+    float sincCutoff = 2.0F * highFrequency / sampleRate;
     if (sincCutoff >= 0.9F)
         sincCutoff = 0.9F;
     
@@ -208,7 +207,7 @@ void AudioCodec::updateSynth()
     impulseFilterSize = impulseFilterHalfSize * 2 + 1;
     
     // Calculate number of impulses
-    impulseTableEntryNum = (OEInt) (1.0 / (timeAccuracy * audioBuffer->sampleRate));
+    impulseTableEntryNum = (OEInt) (1.0 / (timeAccuracy * sampleRate));
     impulseTableEntrySize = (OEInt) getNextPowerOf2(impulseFilterSize);
     impulseTable.resize(impulseTableEntryNum * impulseTableEntrySize);
     
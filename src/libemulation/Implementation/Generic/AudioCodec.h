@@ -10,6 +10,7 @@
 
 #include "OEComponent.h"
 
+#include "ControlBusInterface.h"
 #include "AudioInterface.h"
 
 class AudioCodec : public OEComponent
@@ -37,6 +38,7 @@ private:
     
     OEComponent *audio;
     OEComponent *controlBus;
+    ControlBusClock *controlBusClock;
     
     AudioBuffer *audioBuffer;
     
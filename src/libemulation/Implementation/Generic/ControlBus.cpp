@@ -9,6 +9,9 @@
  */
 
 #include <math.h>
+#include <string.h>
+
+#include <set>
 
 #include "ControlBus.h"
 
@@ -25,19 +28,23 @@ ControlBus::ControlBus()
     cpu = NULL;
     
     clockFrequency = 1E6F;
-    cpuClockMultiplier = 1;
+    clock.cpuClockMultiplier = 1;
     powerState = CONTROLBUS_POWERSTATE_OFF;
     resetOnPowerOn = true;
     resetCount = 0;
     irqCount = 0;
     nmiCount = 0;
+    frameSkip = 0;
     
-    cycles = 0;
-    cpuCycles = 0;
+    clock.cycles = 0;
+    clock.cpuCycles = 0;
+    clock.pendingCPUCycles = &noPendingCPUCycles;
+    noPendingCPUCycles = 0;
+    eventOrder = 0;
     inEvent = false;
     
-    audioBufferStart = 0;
-    sampleToCycleRatio = 0;
+    clock.audioBufferStart = 0;
+    clock.sampleToCycleRatio = 0;
     
     activity = false;
 }
@@ -47,7 +54,7 @@ bool ControlBus::setValue(string name, string value)
     if (name == "clockFrequency")
         clockFrequency = getFloat(value);
     else if (name == "cpuClockMultiplier")
-        cpuClockMultiplier = getFloat(value);
+        clock.cpuClockMultiplier = getFloat(value);
     else if (name == "powerState")
     {
         if (value.substr(0, 1) == "S")
@@ -104,7 +111,11 @@ bool ControlBus::setRef(string name, OEComponent *ref)
             audio->addObserver(this, AUDIO_BUFFER_IS_RENDERING);
     }
     else if (name == "cpu")
+    {
         cpu = ref;
+        
+        updatePendingCPUCycles();
+    }
     else
         return false;
     
@@ -117,6 +128,13 @@ bool ControlBus::init()
     OECheckComponent(audio);
     OECheckComponent(cpu);
     
+    if (clock.pendingCPUCycles == &noPendingCPUCycles)
+    {
+        logMessage("cpu does not provide a pending cycles counter");
+        
+        return false;
+    }
+    
     updatePowerState();
     
     return true;
@@ -154,22 +172,30 @@ bool ControlBus::postMessage(OEComponent *sender, int message, void *data)
             return true;
             
         case CONTROLBUS_GET_CYCLES:
-            *((OELong *)data) = cycles + getCycles();
+            *((OELong *)data) = getControlBusCycles(&clock);
             
             return true;
             
         case CONTROLBUS_GET_AUDIOBUFFERFRAME:
-            *((float *)data) = ((OEInt) (cycles + getCycles() - audioBufferStart)) * sampleToCycleRatio;
+            *((float *)data) = getControlBusAudioBufferFrame(&clock);
+            
+            return true;
+            
+        case CONTROLBUS_GET_CLOCK:
+            *((ControlBusClock **)data) = &clock;
             
             return true;
             
         case CONTROLBUS_SCHEDULE_TIMER:
-            scheduleTimer(sender,
-                          ((ControlBusTimer *)data)->cycles,
-                          ((ControlBusTimer *)data)->id);
+            ((ControlBusTimer *)data)->handle = scheduleTimer(sender,
+                                                              ((ControlBusTimer *)data)->cycles,
+                                                              ((ControlBusTimer *)data)->id);
             
             return true;
             
+        case CONTROLBUS_CANCEL_TIMER:
+            return cancelTimer(sender, *((OELong *)data));
+            
         case CONTROLBUS_INVALIDATE_TIMERS:
             invalidateTimers(sender, *((OEInt *)data));
             
@@ -180,6 +206,24 @@ bool ControlBus::postMessage(OEComponent *sender, int message, void *data)
             
             break;
             
+        case CONTROLBUS_END_SLICE:
+            if (inEvent)
+                setPendingCPUCycles(0);
+            
+            return true;
+            
+        case CONTROLBUS_SET_FRAMESKIP:
+            frameSkip = *((OEInt *)data);
+            
+            postNotification(this, CONTROLBUS_FRAMESKIP_DID_CHANGE, &frameSkip);
+            
+            return true;
+            
+        case CONTROLBUS_GET_FRAMESKIP:
+            *((OEInt *)data) = frameSkip;
+            
+            return true;
+            
         case CONTROLBUS_ASSERT_RESET:
             resetCount++;
             
@@ -250,6 +294,12 @@ bool ControlBus::postMessage(OEComponent *sender, int message, void *data)
             *((bool *)data) = (nmiCount != 0);
             
             return true;
+            
+        case COMPONENT_GET_STATE:
+            return getState((OEData *)data);
+            
+        case COMPONENT_SET_STATE:
+            return setState((OEData *)data);
     }
     
     return false;
@@ -264,31 +314,35 @@ void ControlBus::notify(OEComponent *sender, int notification, void *data)
         
         AudioBuffer *buffer = (AudioBuffer *)data;
         
-        audioBufferStart = cycles;
-        sampleToCycleRatio = buffer->sampleRate / clockFrequency;
+        clock.audioBufferStart = clock.cycles;
+        clock.sampleToCycleRatio = buffer->sampleRate / clockFrequency;
         
-        scheduleTimer(NULL, ceil(buffer->frameNum / sampleToCycleRatio) - getCycles(), 0);
+        scheduleTimer(NULL, ceil(buffer->frameNum / clock.sampleToCycleRatio) - getCycles(), 0);
         
         while (true)
         {
             inEvent = true;
             
-            cpuCycles += ceil(events.front().cycles * cpuClockMultiplier - cpuCycles);
-            setPendingCPUCycles(floor(cpuCycles + getPendingCPUCycles()));
-            runCPU();
+            clock.cpuCycles += ceil((events[eventHeap.front()].cycles - clock.cycles) * clock.cpuClockMultiplier - clock.cpuCycles);
+            setPendingCPUCycles(floor(clock.cpuCycles + getPendingCPUCycles()));
+            
+            if (powerState == CONTROLBUS_POWERSTATE_ON)
+                runCPU();
             
             inEvent = false;
             
-            OEComponent *component = events.front().component;
-            OEInt id = events.front().id;
-            cycles += events.front().cycles;
-            cpuCycles -= events.front().cycles * cpuClockMultiplier;
-            events.front().cycles = 0;
-            events.pop_front();
+            OEInt index = eventHeap.front();
+            OEComponent *component = events[index].component;
+            OEInt id = events[index].id;
+            OELong handle = getEventHandle(index);
+            OELong eventCycles = events[index].cycles - clock.cycles;
+            clock.cycles += eventCycles;
+            clock.cpuCycles -= eventCycles * clock.cpuClockMultiplier;
+            removeEvent(index);
             
             if (component)
             {
-                ControlBusTimer timer = { -getCycles(), id };
+                ControlBusTimer timer = { -getCycles(), id, handle };
                 
                 component->notify(this, CONTROLBUS_TIMER_DID_FIRE, &timer);
             }
@@ -428,116 +482,578 @@ void ControlBus::updateActivity()
                                       EMULATION_CLEAR_ACTIVITY), NULL);
 }
 
-inline OESLong ControlBus::getPendingCPUCycles()
+void ControlBus::updatePendingCPUCycles()
 {
-    OESLong value;
+    OESLong *pendingCPUCycles = NULL;
     
-    cpu->postMessage(this, CPU_GET_PENDINGCYCLES, &value);
+    if (cpu)
+        cpu->postMessage(this, CPU_GET_PENDINGCYCLESPOINTER, &pendingCPUCycles);
     
-    return value;
+    clock.pendingCPUCycles = pendingCPUCycles ? pendingCPUCycles : &noPendingCPUCycles;
+}
+
+inline OESLong ControlBus::getPendingCPUCycles()
+{
+    return *clock.pendingCPUCycles;
 }
 
 inline void ControlBus::setPendingCPUCycles(OESLong value)
 {
-    cpu->postMessage(this, CPU_SET_PENDINGCYCLES, &value);
+    *clock.pendingCPUCycles = value;
 }
 
 inline void ControlBus::runCPU()
 {
-    cpu->postMessage(this, CPU_RUN, &cpuCycles);
+    cpu->postMessage(this, CPU_RUN, &clock.cpuCycles);
 }
 
 OESLong ControlBus::getCycles()
 {
-    return floor((cpuCycles - getPendingCPUCycles()) / cpuClockMultiplier);
+    return getCycles(getPendingCPUCycles());
+}
+
+OESLong ControlBus::getCycles(OESLong pendingCPUCycles)
+{
+    return floor((clock.cpuCycles - pendingCPUCycles) / clock.cpuClockMultiplier);
+}
+
+OELong ControlBus::scheduleTimer(OEComponent *component, OELong cycles, OEInt id)
+{
+    OESLong pendingCPUCycles = getPendingCPUCycles();
+    
+    bool isFrontValid = !eventHeap.empty();
+    OEInt front = isFrontValid ? eventHeap.front() : 0;
+    
+    OEInt index = addEvent(clock.cycles + getCycles(pendingCPUCycles) + cycles, component, id);
+    
+    if (inEvent && isFrontValid && (eventHeap.front() != front))
+        updateEventCycles(pendingCPUCycles);
+    
+    return getEventHandle(index);
+}
+
+bool ControlBus::cancelTimer(OEComponent *component, OELong handle)
+{
+    OEInt index = (OEInt) handle;
+    OEInt generation = (OEInt) (handle >> 32);
+    
+    if ((index >= events.size()) ||
+        (events[index].heapIndex == -1) ||
+        (events[index].generation != generation) ||
+        (events[index].component != component))
+        return false;
+    
+    OEInt front = eventHeap.front();
+    
+    removeEvent(index);
+    
+    updateFrontEvent(front);
+    
+    return true;
+}
+
+void ControlBus::invalidateTimers(OEComponent *component, OEInt id)
+{
+    ControlBusEventLists::iterator i = eventLists.find(ControlBusEventKey(component, id));
+    
+    if ((i == eventLists.end()) || (i->second == -1))
+        return;
+    
+    OEInt front = eventHeap.front();
+    
+    while (i->second != -1)
+        removeEvent(i->second);
+    
+    updateFrontEvent(front);
+}
+
+// Updates the running CPU slice when the front event changed
+
+void ControlBus::updateFrontEvent(OEInt front)
+{
+    if (inEvent && !eventHeap.empty() && (eventHeap.front() != front))
+        updateEventCycles(getPendingCPUCycles());
+}
+
+void ControlBus::updateEventCycles(OESLong pendingCPUCycles)
+{
+    OESLong doneCPUCycles = floor(clock.cpuCycles - pendingCPUCycles);
+    clock.cpuCycles -= floor(clock.cpuCycles);
+    
+    clock.cpuCycles += ceil((events[eventHeap.front()].cycles - clock.cycles) * clock.cpuClockMultiplier - clock.cpuCycles);
+    setPendingCPUCycles(clock.cpuCycles - doneCPUCycles);
 }
 
-void ControlBus::scheduleTimer(OEComponent *component, OELong cycles, OEInt id)
+OEInt ControlBus::addEvent(OELong cycles, OEComponent *component, OEInt id)
 {
-    cycles += getCycles();
+    OEInt index;
     
-    list<ControlBusEvent>::iterator i;
-    for (i = events.begin();
-         i != events.end();
-         i++)
+    if (freeEvents.size())
     {
-        if (cycles < i->cycles)
-        {
-            if ((i == events.begin()) && inEvent)
-            {
-                OESLong doneCPUCycles = floor(cpuCycles - getPendingCPUCycles());
-                cpuCycles -= floor(cpuCycles);
-                
-                cpuCycles += ceil(cycles * cpuClockMultiplier - cpuCycles);
-                setPendingCPUCycles(cpuCycles - doneCPUCycles);
-            }
-            
-            i->cycles -= cycles;
-            
-            break;
-        }
+        index = freeEvents.back();
+        freeEvents.pop_back();
+    }
+    else
+    {
+        index = (OEInt) events.size();
+        events.resize(index + 1);
         
-        cycles -= i->cycles;
+        events[index].generation = 1;
     }
     
-    ControlBusEvent event;
+    ControlBusEvent& event = events[index];
     
     event.cycles = cycles;
+    event.order = eventOrder++;
     event.component = component;
     event.id = id;
+    event.heapIndex = (OESInt) eventHeap.size();
+    
+    // Link to the list of the component's timers with this id
+    ControlBusEventLists::iterator i = eventLists.find(ControlBusEventKey(component, id));
+    
+    if (i == eventLists.end())
+        i = eventLists.insert(ControlBusEventLists::value_type(ControlBusEventKey(component, id), -1)).first;
+    
+    event.listHead = &i->second;
+    event.prevEvent = -1;
+    event.nextEvent = *event.listHead;
     
-    events.insert(i, event);
+    if (event.nextEvent != -1)
+        events[event.nextEvent].prevEvent = index;
+    
+    *event.listHead = index;
+    
+    eventHeap.push_back(index);
+    
+    siftEventUp(event.heapIndex);
+    
+    return index;
 }
 
-void ControlBus::invalidateTimers(OEComponent *component, OEInt id)
+void ControlBus::removeEvent(OEInt index)
 {
-    OELong cycles = 0;
+    ControlBusEvent& event = events[index];
+    
+    OEInt i = event.heapIndex;
+    OEInt last = (OEInt) eventHeap.size() - 1;
     
-    list<ControlBusEvent>::iterator i;
-    for (i = events.begin();
-         i != events.end();
-         )
+    if (i != last)
     {
-        if ((i->component == component) &&
-            (i->id == id))
-        {
-            cycles = i->cycles;
-            i = events.erase(i);
-        }
-        else if (cycles)
-        {
-            i->cycles += cycles;
-            cycles = 0;
-            
-            if ((i == events.begin()) && inEvent)
-            {
-                OESLong doneCPUCycles = floor(cpuCycles - getPendingCPUCycles());
-                cpuCycles -= floor(cpuCycles);
-                
-                cpuCycles += ceil(events.front().cycles * cpuClockMultiplier - cpuCycles);
-                setPendingCPUCycles(cpuCycles - doneCPUCycles);
-            }
-            
-            i++;
-        }
-        else
-            i++;
+        swapEvents(i, last);
+        
+        eventHeap.pop_back();
+        
+        siftEventUp(i);
+        siftEventDown(i);
+    }
+    else
+        eventHeap.pop_back();
+    
+    // Unlink
+    if (event.prevEvent != -1)
+        events[event.prevEvent].nextEvent = event.nextEvent;
+    else
+        *event.listHead = event.nextEvent;
+    
+    if (event.nextEvent != -1)
+        events[event.nextEvent].prevEvent = event.prevEvent;
+    
+    event.heapIndex = -1;
+    event.component = NULL;
+    event.listHead = NULL;
+    
+    // Invalidate the handles of this entry
+    event.generation++;
+    if (!event.generation)
+        event.generation = 1;
+    
+    freeEvents.push_back(index);
+}
+
+OELong ControlBus::getEventHandle(OEInt index)
+{
+    return ((OELong) events[index].generation << 32) | index;
+}
+
+bool ControlBus::isEventBefore(OEInt a, OEInt b)
+{
+    ControlBusEvent& eventA = events[eventHeap[a]];
+    ControlBusEvent& eventB = events[eventHeap[b]];
+    
+    if (eventA.cycles != eventB.cycles)
+        return (eventA.cycles < eventB.cycles);
+    
+    return (eventA.order < eventB.order);
+}
+
+void ControlBus::swapEvents(OEInt i, OEInt j)
+{
+    OEInt index = eventHeap[i];
+    
+    eventHeap[i] = eventHeap[j];
+    eventHeap[j] = index;
+    
+    events[eventHeap[i]].heapIndex = i;
+    events[eventHeap[j]].heapIndex = j;
+}
+
+void ControlBus::siftEventUp(OEInt i)
+{
+    while (i > 0)
+    {
+        OEInt parent = (i - 1) / 2;
+        
+        if (!isEventBefore(i, parent))
+            break;
+        
+        swapEvents(i, parent);
+        
+        i = parent;
+    }
+}
+
+void ControlBus::siftEventDown(OEInt i)
+{
+    OEInt size = (OEInt) eventHeap.size();
+    
+    while (true)
+    {
+        OEInt left = 2 * i + 1;
+        OEInt right = left + 1;
+        OEInt first = i;
+        
+        if ((left < size) && isEventBefore(left, first))
+            first = left;
+        if ((right < size) && isEventBefore(right, first))
+            first = right;
+        
+        if (first == i)
+            break;
+        
+        swapEvents(i, first);
+        
+        i = first;
     }
 }
 
 void ControlBus::setCPUClockMultiplier(float value)
 {
-    double ratio = value / cpuClockMultiplier;
+    double ratio = value / clock.cpuClockMultiplier;
     
     OESLong pendingCPUCycles = getPendingCPUCycles();
     
-    double doneCPUCycles = cpuCycles - pendingCPUCycles;
+    double doneCPUCycles = clock.cpuCycles - pendingCPUCycles;
     
     pendingCPUCycles *= ratio;
     
     setPendingCPUCycles(pendingCPUCycles);
     
-    cpuCycles = doneCPUCycles * ratio + pendingCPUCycles;
+    clock.cpuCycles = doneCPUCycles * ratio + pendingCPUCycles;
+    
+    clock.cpuClockMultiplier = value;
+}
+
+// State
+
+static void appendControlBusState(OEData *data, const void *value, size_t size)
+{
+    const OEChar *p = (const OEChar *) value;
+    
+    data->insert(data->end(), p, p + size);
+}
+
+static bool readControlBusState(OEData *data, size_t& offset, void *value, size_t size)
+{
+    if ((data->size() - offset) < size)
+        return false;
+    
+    if (size)
+        memcpy(value, &data->front() + offset, size);
+    
+    offset += size;
+    
+    return true;
+}
+
+OESInt ControlBus::getEventOwner(OEComponent *component)
+{
+    for (OEInt i = 0; i < eventOwners.size(); i++)
+        if (eventOwners[i] == component)
+            return i;
+    
+    eventOwners.push_back(component);
+    
+    return (OESInt) eventOwners.size() - 1;
+}
+
+bool ControlBus::getState(OEData *data)
+{
+    vector<ControlBusEventState> eventStates(events.size());
+    
+    if (events.size())
+        memset(&eventStates.front(), 0, events.size() * sizeof(ControlBusEventState));
+    
+    for (OEInt i = 0; i < events.size(); i++)
+    {
+        ControlBusEvent& event = events[i];
+        ControlBusEventState& eventState = eventStates[i];
+        
+        eventState.generation = event.generation;
+        eventState.heapIndex = event.heapIndex;
+        eventState.owner = -1;
+        eventState.prevEvent = -1;
+        eventState.nextEvent = -1;
+        eventState.freeIndex = -1;
+        
+        if (event.heapIndex == -1)
+            continue;
+        
+        eventState.cycles = event.cycles - clock.cycles;
+        eventState.order = event.order;
+        if (event.component)
+            eventState.owner = getEventOwner(event.component);
+        eventState.id = event.id;
+        eventState.prevEvent = event.prevEvent;
+        eventState.nextEvent = event.nextEvent;
+    }
+    
+    for (OEInt i = 0; i < freeEvents.size(); i++)
+        eventStates[freeEvents[i]].freeIndex = i;
+    
+    ControlBusState state;
+    
+    memset(&state, 0, sizeof(state));
+    
+    state.cycles = clock.cycles;
+    state.cpuCycles = clock.cpuCycles;
+    state.audioBufferStart = clock.audioBufferStart;
+    state.sampleToCycleRatio = clock.sampleToCycleRatio;
+    state.eventOrder = eventOrder;
+    state.ownerNum = (OEInt) eventOwners.size();
+    state.eventNum = (OEInt) events.size();
+    
+    appendControlBusState(data, &state, sizeof(state));
     
-    cpuClockMultiplier = value;
+    // Owners no longer scheduling timers may have been removed
+    vector<bool> isOwnerUsed(eventOwners.size(), false);
+    
+    for (OEInt i = 0; i < eventStates.size(); i++)
+        if (eventStates[i].owner != -1)
+            isOwnerUsed[eventStates[i].owner] = true;
+    
+    for (OEInt i = 0; i < eventOwners.size(); i++)
+    {
+        EmulationComponent owner;
+        
+        owner.component = eventOwners[i];
+        
+        if (!isOwnerUsed[i] ||
+            !emulation ||
+            !emulation->postMessage(this, EMULATION_GET_COMPONENTID, &owner))
+            owner.id = "";
+        
+        if (isOwnerUsed[i] && (owner.id == ""))
+        {
+            logMessage("timer owner has no id");
+            
+            return false;
+        }
+        
+        OEInt size = (OEInt) owner.id.size();
+        
+        appendControlBusState(data, &size, sizeof(size));
+        appendControlBusState(data, owner.id.c_str(), size);
+    }
+    
+    if (eventStates.size())
+        appendControlBusState(data, &eventStates.front(),
+                              eventStates.size() * sizeof(ControlBusEventState));
+    
+    return true;
+}
+
+// The state is checked completely before it is applied
+
+bool ControlBus::setState(OEData *data)
+{
+    size_t offset = 0;
+    ControlBusState state;
+    
+    if (!readControlBusState(data, offset, &state, sizeof(state)))
+        return false;
+    
+    vector<OEComponent *> owners;
+    
+    for (OEInt i = 0; i < state.ownerNum; i++)
+    {
+        OEInt size;
+        
+        if (!readControlBusState(data, offset, &size, sizeof(size)) ||
+            ((data->size() - offset) < size))
+            return false;
+        
+        EmulationComponent owner;
+        
+        owner.id.assign((char *) &data->front() + offset, size);
+        owner.component = NULL;
+        
+        offset += size;
+        
+        if ((owner.id != "") && emulation)
+            emulation->postMessage(this, EMULATION_GET_COMPONENT, &owner);
+        
+        owners.push_back(owner.component);
+    }
+    
+    if ((data->size() - offset) / sizeof(ControlBusEventState) < state.eventNum)
+        return false;
+    
+    vector<ControlBusEventState> eventStates(state.eventNum);
+    
+    if (!readControlBusState(data, offset, eventStates.size() ? &eventStates.front() : NULL,
+                             eventStates.size() * sizeof(ControlBusEventState)) ||
+        (offset != data->size()))
+        return false;
+    
+    OEInt heapSize = 0;
+    
+    for (OEInt i = 0; i < state.eventNum; i++)
+        if (eventStates[i].heapIndex != -1)
+            heapSize++;
+    
+    vector<OEInt> newEventHeap(heapSize, 0);
+    vector<OEInt> newFreeEvents(state.eventNum - heapSize, 0);
+    
+    for (OEInt i = 0; i < state.eventNum; i++)
+    {
+        ControlBusEventState& eventState = eventStates[i];
+        
+        if (eventState.heapIndex == -1)
+        {
+            if ((eventState.freeIndex < 0) ||
+                (eventState.freeIndex >= (OESInt) newFreeEvents.size()))
+                return false;
+            
+            newFreeEvents[eventState.freeIndex] = i;
+            
+            continue;
+        }
+        
+        if ((eventState.heapIndex < 0) ||
+            (eventState.heapIndex >= (OESInt) heapSize) ||
+            (eventState.owner < -1) ||
+            (eventState.owner >= (OESInt) owners.size()) ||
+            ((eventState.owner != -1) && !owners[eventState.owner]))
+            return false;
+        
+        newEventHeap[eventState.heapIndex] = i;
+        
+        // Linked events must be live and have the same owner and id
+        OESInt links[] = {eventState.prevEvent, eventState.nextEvent};
+        
+        for (OEInt j = 0; j < 2; j++)
+        {
+            OESInt link = links[j];
+            
+            if (link == -1)
+                continue;
+            
+            if ((link < 0) ||
+                (link >= (OESInt) state.eventNum) ||
+                (eventStates[link].heapIndex == -1) ||
+                (eventStates[link].owner != eventState.owner) ||
+                (eventStates[link].id != eventState.id) ||
+                ((j == 0) && (eventStates[link].nextEvent != (OESInt) i)) ||
+                ((j == 1) && (eventStates[link].prevEvent != (OESInt) i)))
+                return false;
+        }
+    }
+    
+    // Each heap and free list position must be used exactly once
+    vector<bool> isUsed(state.eventNum, false);
+    
+    for (OEInt i = 0; i < heapSize; i++)
+    {
+        OEInt index = newEventHeap[i];
+        
+        if (isUsed[index] || (eventStates[index].heapIndex != (OESInt) i))
+            return false;
+        
+        isUsed[index] = true;
+    }
+    
+    for (OEInt i = 0; i < newFreeEvents.size(); i++)
+    {
+        if (isUsed[newFreeEvents[i]])
+            return false;
+        
+        isUsed[newFreeEvents[i]] = true;
+    }
+    
+    // Each list must start at one head and reach all its events
+    set<pair<OESInt, OEInt> > listKeys;
+    OEInt listedNum = 0;
+    
+    for (OEInt i = 0; i < state.eventNum; i++)
+    {
+        if ((eventStates[i].heapIndex == -1) || (eventStates[i].prevEvent != -1))
+            continue;
+        
+        if (!listKeys.insert(make_pair(eventStates[i].owner, eventStates[i].id)).second)
+            return false;
+        
+        for (OESInt j = i; (j != -1) && (listedNum <= heapSize); j = eventStates[j].nextEvent)
+            listedNum++;
+    }
+    
+    if (listedNum != heapSize)
+        return false;
+    
+    clock.cycles = state.cycles;
+    clock.cpuCycles = state.cpuCycles;
+    clock.audioBufferStart = state.audioBufferStart;
+    clock.sampleToCycleRatio = state.sampleToCycleRatio;
+    eventOrder = state.eventOrder;
+    eventOwners = owners;
+    
+    events.resize(state.eventNum);
+    eventHeap = newEventHeap;
+    freeEvents = newFreeEvents;
+    eventLists.clear();
+    
+    for (OEInt i = 0; i < state.eventNum; i++)
+    {
+        ControlBusEvent& event = events[i];
+        ControlBusEventState& eventState = eventStates[i];
+        
+        event.cycles = clock.cycles + eventState.cycles;
+        event.order = eventState.order;
+        event.component = ((eventState.owner != -1) ?
+                           owners[eventState.owner] : NULL);
+        event.id = eventState.id;
+        event.generation = eventState.generation;
+        event.heapIndex = eventState.heapIndex;
+        event.listHead = NULL;
+        event.prevEvent = eventState.prevEvent;
+        event.nextEvent = eventState.nextEvent;
+    }
+    
+    for (OEInt i = 0; i < state.eventNum; i++)
+    {
+        ControlBusEvent& event = events[i];
+        
+        if ((event.heapIndex == -1) || (event.prevEvent != -1))
+            continue;
+        
+        ControlBusEventKey key(event.component, event.id);
+        OESInt *listHead = &eventLists.insert(ControlBusEventLists::value_type(key, i)).first->second;
+        
+        for (OESInt j = i; j != -1; j = events[j].nextEvent)
+            events[j].listHead = listHead;
+    }
+    
+    updatePowerState();
+    
+    return true;
 }
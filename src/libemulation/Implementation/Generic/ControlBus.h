@@ -11,19 +11,68 @@
 #ifndef _CONTROLBUS_H
 #define _CONTROLBUS_H
 
-#include <list>
-
 #include "OEComponent.h"
 
 #include "ControlBusInterface.h"
 
+// Notes:
+// * Events are kept in a pool and ordered in a binary heap by absolute
+//   cycle, then by scheduling order, so simultaneous timers fire in the
+//   order they were scheduled.
+// * The pending cycle counter is the CPU's own, obtained with
+//   CPU_GET_PENDINGCYCLESPOINTER when the cpu is connected.
+// * A timer handle holds the event's pool index in its low 32 bits and the
+//   pool entry's generation in its high 32 bits. The generation changes
+//   each time the entry is freed, so stale handles are rejected.
+// * heapIndex is the event's position in the heap, or -1 when the pool
+//   entry is free.
+// * Events of the same component and id are linked in a list, so that
+//   invalidateTimers only visits the events it removes.
+// * The state holds the clock and the whole event pool, so that restored
+//   timers fire in the same order and keep their handles. Event owners are
+//   stored as indices into a table of EDL component ids. The table only
+//   grows, so the state keeps its layout from one save to the next.
+
 typedef struct
 {
     OELong cycles;
+    OELong order;
     OEComponent *component;
     OEInt id;
+    OEInt generation;
+    OESInt heapIndex;
+    OESInt *listHead;
+    OESInt prevEvent;
+    OESInt nextEvent;
 } ControlBusEvent;
 
+typedef struct
+{
+    OESLong cycles;
+    OELong order;
+    OEInt generation;
+    OESInt heapIndex;
+    OESInt owner;
+    OEInt id;
+    OESInt prevEvent;
+    OESInt nextEvent;
+    OESInt freeIndex;
+} ControlBusEventState;
+
+typedef struct
+{
+    OELong cycles;
+    double cpuCycles;
+    OELong audioBufferStart;
+    float sampleToCycleRatio;
+    OELong eventOrder;
+    OEInt ownerNum;
+    OEInt eventNum;
+} ControlBusState;
+
+typedef pair<OEComponent *, OEInt> ControlBusEventKey;
+typedef map<ControlBusEventKey, OESInt> ControlBusEventLists;
+
 class ControlBus : public OEComponent
 {
 public:
@@ -46,20 +95,22 @@ private:
     OEComponent *cpu;
     
     float clockFrequency;
-    double cpuClockMultiplier;
     ControlBusPowerState powerState;
     bool resetOnPowerOn;
     OEInt resetCount;
     OEInt irqCount;
     OEInt nmiCount;
+    OEInt frameSkip;
     
-    OELong cycles;
-    double cpuCycles;
-    list<ControlBusEvent> events;
+    ControlBusClock clock;
+    OESLong noPendingCPUCycles;
+    vector<ControlBusEvent> events;
+    vector<OEInt> eventHeap;
+    vector<OEInt> freeEvents;
+    ControlBusEventLists eventLists;
+    OELong eventOrder;
     bool inEvent;
-    
-    OELong audioBufferStart;
-    float sampleToCycleRatio;
+    vector<OEComponent *> eventOwners;
     
     bool activity;
     
@@ -69,14 +120,31 @@ private:
     void setActivity(bool value);
     void updateActivity();
     
+    void updatePendingCPUCycles();
     OESLong getPendingCPUCycles();
     void setPendingCPUCycles(OESLong value);
     void runCPU();
     OESLong getCycles();
-    void scheduleTimer(OEComponent *component, OELong cycles, OEInt id);
+    OESLong getCycles(OESLong pendingCPUCycles);
+    OELong scheduleTimer(OEComponent *component, OELong cycles, OEInt id);
+    bool cancelTimer(OEComponent *component, OELong handle);
     void invalidateTimers(OEComponent *component, OEInt id);
+    void updateFrontEvent(OEInt front);
+    void updateEventCycles(OESLong pendingCPUCycles);
+    
+    OEInt addEvent(OELong cycles, OEComponent *component, OEInt id);
+    void removeEvent(OEInt index);
+    OELong getEventHandle(OEInt index);
+    bool isEventBefore(OEInt a, OEInt b);
+    void swapEvents(OEInt i, OEInt j);
+    void siftEventUp(OEInt i);
+    void siftEventDown(OEInt i);
     
     void setCPUClockMultiplier(float value);
+    
+    bool getState(OEData *data);
+    bool setState(OEData *data);
+    OESInt getEventOwner(OEComponent *component);
 };
 
 #endif
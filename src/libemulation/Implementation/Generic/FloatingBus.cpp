@@ -8,13 +8,14 @@
  * Controls a generic floating bus
  */
 
-#include <stdlib.h>
+#include <string.h>
 
 #include "FloatingBus.h"
 
 FloatingBus::FloatingBus()
 {
     randomMode = false;
+    randomSeed = 1;
     
     busValue = 0;
 }
@@ -36,10 +37,46 @@ bool FloatingBus::setValue(string name, string value)
     return true;
 }
 
+// The random values come from a generator of the bus' own, so that a
+// loaded state replays them
+
+bool FloatingBus::postMessage(OEComponent *sender, int message, void *data)
+{
+    switch (message)
+    {
+        case COMPONENT_GET_STATE:
+        {
+            OEData *state = (OEData *)data;
+            OEChar *p = (OEChar *) &randomSeed;
+            
+            state->insert(state->end(), p, p + sizeof(randomSeed));
+            
+            return true;
+        }
+        case COMPONENT_SET_STATE:
+        {
+            OEData *state = (OEData *)data;
+            
+            if (state->size() != sizeof(randomSeed))
+                return false;
+            
+            memcpy(&randomSeed, &state->front(), sizeof(randomSeed));
+            
+            return true;
+        }
+    }
+    
+    return false;
+}
+
 OEChar FloatingBus::read(OEAddress address)
 {
     if (randomMode)
-        return random() & 0xff;
+    {
+        randomSeed = randomSeed * 1103515245 + 12345;
+        
+        return (randomSeed >> 16) & 0xff;
+    }
     else
         return busValue;
 }
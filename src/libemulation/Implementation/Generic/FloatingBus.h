@@ -17,10 +17,13 @@ public:
     
     bool setValue(string name, string value);
     
+    bool postMessage(OEComponent *sender, int message, void *data);
+    
     OEChar read(OEAddress address);
     
 private:
     bool randomMode;
+    OEInt randomSeed;
     
     OEChar busValue;
 };
@@ -259,6 +259,9 @@ void Monitor::update()
 
 bool Monitor::postMessage(OEComponent *sender, int message, void *data)
 {
+    if ((message == COMPONENT_GET_STATE) || (message == COMPONENT_SET_STATE))
+        return false;
+    
     if (canvas)
         return canvas->postMessage(sender, message, data);
     
@@ -33,6 +33,10 @@ bool Proxy::init()
 
 bool Proxy::postMessage(OEComponent *sender, int message, void *data)
 {
+    // The state belongs to the proxied component, which saves its own
+    if ((message == COMPONENT_GET_STATE) || (message == COMPONENT_SET_STATE))
+        return false;
+    
     return component->postMessage(sender, message, data);
 }
 
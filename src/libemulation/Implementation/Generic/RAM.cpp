@@ -12,12 +12,23 @@
 
 #include "MemoryInterface.h"
 
+#define DEFAULT_DIRTYPAGESIZE   0x100
+
 RAM::RAM()
 {
     size = 0;
     
+    datap = NULL;
+    mask = 0;
+    
+    dirtyMapp = NULL;
+    dirtyPageSize = DEFAULT_DIRTYPAGESIZE;
+    
     controlBus = NULL;
     powerState = CONTROLBUS_POWERSTATE_ON;
+    
+    dirtyTracking = false;
+    dirtyPageBits = 0;
 }
 
 bool RAM::setValue(string name, string value)
@@ -26,6 +37,8 @@ bool RAM::setValue(string name, string value)
         size = getOELong(value);
     else if (name == "powerOnPattern")
         powerOnPattern = getCharVector(value);
+    else if (name == "dirtyPageSize")
+        dirtyPageSize = getOELong(value);
     else
         return false;
     
@@ -61,7 +74,14 @@ bool RAM::setRef(string name, OEComponent *ref)
 bool RAM::setData(string name, OEData *data)
 {
     if (name == "memoryImage")
-        data->swap(this->data);
+    {
+        // Components hold pointers to the memory, so a loaded state is
+        // copied into it
+        if (data->size() == this->data.size())
+            copy(data->begin(), data->end(), this->data.begin());
+        else
+            data->swap(this->data);
+    }
     else
         return false;
     
@@ -85,7 +105,7 @@ bool RAM::getData(string name, OEData **data)
 
 bool RAM::init()
 {
-    if ((size != getNextPowerOf2(size)) ||
+    if ((size != (OEAddress) getNextPowerOf2(size)) ||
         (!size))
     {
 		logMessage("invalid value for size");
@@ -93,6 +113,14 @@ bool RAM::init()
 		return false;
     }
     
+    if ((dirtyPageSize != (OEAddress) getNextPowerOf2(dirtyPageSize)) ||
+        (!dirtyPageSize))
+    {
+        logMessage("invalid value for dirtyPageSize");
+        
+        return false;
+    }
+    
     if (controlBus)
         controlBus->postMessage(this, CONTROLBUS_GET_POWERSTATE, &powerState);
     
@@ -105,9 +133,16 @@ bool RAM::init()
     data.resize((size_t) size);
     if (oldSize == 0)
         initMemory();
+    
+    OEChar *oldDatap = datap;
     datap = &data.front();
     mask = size - 1;
     
+    updateDirtyMap();
+    
+    if ((datap != oldDatap) || dirtyMapp)
+        postNotification(this, MEMORY_MAP_DID_CHANGE, NULL);
+    
     return true;
 }
 
@@ -128,6 +163,28 @@ bool RAM::postMessage(OEComponent *sender, int message, void *data)
         case RAM_GET_DATA:
             *((OEData **) data) = &this->data;
             return true;
+            
+        case RAM_SET_DIRTYTRACKING:
+            setDirtyTracking(*((bool *) data));
+            return true;
+            
+        case RAM_GET_DIRTYPAGESIZE:
+            *((OEAddress *) data) = (OEAddress) 1 << dirtyPageBits;
+            return true;
+            
+        case RAM_GET_DIRTYPAGES:
+            if (!dirtyMapp)
+                return false;
+            
+            *((OEData *) data) = dirtyMap;
+            return true;
+            
+        case RAM_CLEAR_DIRTYPAGES:
+            if (!dirtyMapp)
+                return false;
+            
+            clearDirtyMap();
+            return true;
     }
     
     return false;
@@ -148,7 +205,78 @@ OEChar RAM::read(OEAddress address)
 
 void RAM::write(OEAddress address, OEChar value)
 {
-    datap[address & mask] = value;
+    address &= mask;
+    
+    if (dirtyMapp)
+        setDirty(address, address);
+    
+    datap[address] = value;
+}
+
+OEChar *RAM::getReadPointer(OEAddress startAddress, OEAddress endAddress)
+{
+    if (!datap ||
+        (endAddress < startAddress) ||
+        ((startAddress & mask) + (endAddress - startAddress) > mask))
+        return NULL;
+    
+    return datap + (startAddress & mask);
+}
+
+OEChar *RAM::getWritePointer(OEAddress startAddress, OEAddress endAddress)
+{
+    OEChar *p = RAM::getReadPointer(startAddress, endAddress);
+    
+    if (p && dirtyMapp)
+    {
+        OEAddress start = startAddress & mask;
+        
+        if (!isDirty(start, start + (endAddress - startAddress)))
+            return NULL;
+    }
+    
+    return p;
+}
+
+// Blocks wrap around at the end of memory, like single byte accesses
+
+void RAM::readBlock(OEAddress address, OEChar *data, OEInt size)
+{
+    if (!datap)
+        return;
+    
+    while (size)
+    {
+        OEAddress start = address & mask;
+        OEInt n = (OEInt) min((OEAddress) size, mask - start + 1);
+        
+        memcpy(data, datap + start, n);
+        
+        address += n;
+        data += n;
+        size -= n;
+    }
+}
+
+void RAM::writeBlock(OEAddress address, const OEChar *data, OEInt size)
+{
+    if (!datap)
+        return;
+    
+    while (size)
+    {
+        OEAddress start = address & mask;
+        OEInt n = (OEInt) min((OEAddress) size, mask - start + 1);
+        
+        if (dirtyMapp)
+            setDirty(start, start + n - 1);
+        
+        memcpy(datap + start, data, n);
+        
+        address += n;
+        data += n;
+        size -= n;
+    }
 }
 
 void RAM::initMemory()
@@ -157,4 +285,105 @@ void RAM::initMemory()
     
     for (OEInt i = 0; i < this->data.size(); i++)
         data[i] = powerOnPattern[i & mask];
+    
+    if (dirtyMapp)
+        setDirty(0, this->mask);
+}
+
+// Dirty pages are cleared when tracking starts. Resizing or reinitializing
+// memory marks every page dirty
+
+void RAM::setDirtyTracking(bool value)
+{
+    if (dirtyTracking == value)
+        return;
+    
+    dirtyTracking = value;
+    
+    updateDirtyMap();
+    
+    if (dirtyMapp)
+        memset(dirtyMapp, 0, dirtyMap.size());
+    
+    postNotification(this, MEMORY_MAP_DID_CHANGE, NULL);
+}
+
+// Only the pages that were dirty lose their write pointers
+
+void RAM::clearDirtyMap()
+{
+    OEAddressRange range;
+    bool isChanged = false;
+    
+    for (size_t i = 0; i < dirtyMap.size(); i++)
+    {
+        if (dirtyMapp[i])
+        {
+            dirtyMapp[i] = false;
+            
+            if (!isChanged)
+                range.startAddress = (OEAddress) i << dirtyPageBits;
+            range.endAddress = ((OEAddress) (i + 1) << dirtyPageBits) - 1;
+            
+            isChanged = true;
+        }
+    }
+    
+    if (isChanged)
+        postNotification(this, MEMORY_MAP_DID_CHANGE, &range);
+}
+
+void RAM::updateDirtyMap()
+{
+    dirtyPageBits = getBitNum(min(dirtyPageSize, size));
+    
+    if (!dirtyTracking || !size)
+    {
+        dirtyMap.clear();
+        dirtyMapp = NULL;
+        
+        return;
+    }
+    
+    dirtyMap.assign((size_t) (size >> dirtyPageBits), true);
+    dirtyMapp = &dirtyMap.front();
+}
+
+void RAM::setDirty(OEAddress startAddress, OEAddress endAddress)
+{
+    size_t startPage = (size_t) (startAddress >> dirtyPageBits);
+    size_t endPage = (size_t) (endAddress >> dirtyPageBits);
+    
+    OEAddressRange range;
+    bool isChanged = false;
+    
+    for (size_t i = startPage; i <= endPage; i++)
+    {
+        if (!dirtyMapp[i])
+        {
+            dirtyMapp[i] = true;
+            
+            if (!isChanged)
+                range.startAddress = (OEAddress) i << dirtyPageBits;
+            range.endAddress = ((OEAddress) (i + 1) << dirtyPageBits) - 1;
+            
+            isChanged = true;
+        }
+    }
+    
+    // Dirty pages can now be written directly
+    if (isChanged)
+        postNotification(this, MEMORY_MAP_DID_CHANGE, &range);
+}
+
+bool RAM::isDirty(OEAddress startAddress, OEAddress endAddress)
+{
+    size_t startPage = (size_t) (startAddress >> dirtyPageBits);
+    size_t endPage = (size_t) (endAddress >> dirtyPageBits);
+    
+    for (size_t i = startPage; i <= endPage; i++)
+        if (!dirtyMapp[i])
+            return false;
+    
+    return true;
 }
@@ -20,6 +20,13 @@
 // * To determine the power state, set the controlBus.
 // * powerOnPattern is the byte pattern used when power is first applied.
 // * image is the RAM image.
+// * dirtyPageSize is the granularity of dirty page tracking. It must be
+//   a power of two.
+// * While dirty page tracking is on, write pointers are only returned for
+//   pages that are already dirty. The first write to a clean page goes
+//   through write(), marks the page and posts MEMORY_MAP_DID_CHANGE with
+//   the page's range, so tracking costs nothing per access once a page is
+//   dirty. Clearing the dirty pages notifies the range they covered.
 
 class RAM : public OEComponent
 {
@@ -41,14 +48,25 @@ public:
     OEChar read(OEAddress address);
     void write(OEAddress address, OEChar value);
     
+    OEChar *getReadPointer(OEAddress startAddress, OEAddress endAddress);
+    OEChar *getWritePointer(OEAddress startAddress, OEAddress endAddress);
+    
+    void readBlock(OEAddress address, OEChar *data, OEInt size);
+    void writeBlock(OEAddress address, const OEChar *data, OEInt size);
+    
 protected:
     OEAddress size;
     
     OEChar *datap;
     OEAddress mask;
     
+    OEChar *dirtyMapp;
+    
+    void setDirty(OEAddress startAddress, OEAddress endAddress);
+    
 private:
     OEData powerOnPattern;
+    OEAddress dirtyPageSize;
     
     OEComponent *controlBus;
     
@@ -56,7 +74,16 @@ private:
     
     ControlBusPowerState powerState;
     
+    bool dirtyTracking;
+    OEInt dirtyPageBits;
+    OEData dirtyMap;
+    
     void initMemory();
+    
+    void setDirtyTracking(bool value);
+    void clearDirtyMap();
+    void updateDirtyMap();
+    bool isDirty(OEAddress startAddress, OEAddress endAddress);
 };
 
 #endif
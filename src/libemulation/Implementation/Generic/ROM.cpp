@@ -10,6 +10,14 @@
 
 #include "ROM.h"
 
+#include "MemoryInterface.h"
+
+ROM::ROM()
+{
+    datap = NULL;
+    mask = 0;
+}
+
 bool ROM::setData(string name, OEData *data)
 {
     if (name == "memoryImage")
@@ -41,9 +49,13 @@ bool ROM::init()
     
     OEAddress size = getNextPowerOf2((int) data.size());
     data.resize((size_t) size);
+    OEChar *oldDatap = datap;
     datap = &data.front();
     mask = size - 1;
     
+    if (datap != oldDatap)
+        postNotification(this, MEMORY_MAP_DID_CHANGE, NULL);
+    
     return true;
 }
 
@@ -51,3 +63,31 @@ OEChar ROM::read(OEAddress address)
 {
     return datap[address & mask];
 }
+
+OEChar *ROM::getReadPointer(OEAddress startAddress, OEAddress endAddress)
+{
+    if (!datap ||
+        (endAddress < startAddress) ||
+        ((startAddress & mask) + (endAddress - startAddress) > mask))
+        return NULL;
+    
+    return datap + (startAddress & mask);
+}
+
+void ROM::readBlock(OEAddress address, OEChar *data, OEInt size)
+{
+    if (!datap)
+        return;
+    
+    while (size)
+    {
+        OEAddress start = address & mask;
+        OEInt n = (OEInt) min((OEAddress) size, mask - start + 1);
+        
+        memcpy(data, datap + start, n);
+        
+        address += n;
+        data += n;
+        size -= n;
+    }
+}
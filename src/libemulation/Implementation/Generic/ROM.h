@@ -16,12 +16,18 @@
 class ROM : public OEComponent
 {
 public:
+    ROM();
+    
     bool setData(string name, OEData *data);
     bool getData(string name, OEData **data);
     bool init();
     
     OEChar read(OEAddress address);
     
+    OEChar *getReadPointer(OEAddress startAddress, OEAddress endAddress);
+    
+    void readBlock(OEAddress address, OEChar *data, OEInt size);
+    
 private:
     OEData data;
     
@@ -15,6 +15,8 @@
 VRAM::VRAM() : RAM()
 {
     videoObserver = NULL;
+    
+    notifyMapp = NULL;
 }
 
 bool VRAM::setValue(string name, string value)
@@ -46,7 +48,7 @@ bool VRAM::init()
     if (!RAM::init())
         return false;
     
-    if ((videoBlockSize != getNextPowerOf2(videoBlockSize)) ||
+    if ((videoBlockSize != (OEAddress) getNextPowerOf2(videoBlockSize)) ||
         (size < videoBlockSize) ||
         (!videoBlockSize) ||
         (!size))
@@ -78,6 +80,8 @@ bool VRAM::init()
             notifyMap[i] = true;
     }
     
+    postNotification(this, MEMORY_MAP_DID_CHANGE, NULL);
+    
     return true;
 }
 
@@ -86,7 +90,54 @@ void VRAM::write(OEAddress address, OEChar value)
     address &= mask;
     
     if (notifyMapp[address >> videoBlockBits])
-        videoObserver->notify(this, VRAM_WILL_CHANGE, NULL);
+        videoObserver->notify(this, VRAM_WILL_CHANGE, datap + address);
+    
+    if (dirtyMapp)
+        setDirty(address, address);
     
     datap[address] = value;
 }
+
+// Writes to video memory notify the video observer, so only blocks outside
+// videoMap can be written directly
+
+OEChar *VRAM::getWritePointer(OEAddress startAddress, OEAddress endAddress)
+{
+    OEChar *p = RAM::getWritePointer(startAddress, endAddress);
+    
+    if (!p || !notifyMapp)
+        return NULL;
+    
+    size_t startBlock = (size_t) ((startAddress & mask) >> videoBlockBits);
+    size_t endBlock = (size_t) (((startAddress & mask) + (endAddress - startAddress)) >> videoBlockBits);
+    
+    for (size_t i = startBlock; i <= endBlock; i++)
+        if (notifyMapp[i])
+            return NULL;
+    
+    return p;
+}
+
+// The video observer is notified once before a block touching video memory
+
+void VRAM::writeBlock(OEAddress address, const OEChar *data, OEInt size)
+{
+    if (!notifyMapp)
+        return;
+    
+    for (OEInt i = 0; i < size;)
+    {
+        OEAddress a = (address + i) & mask;
+        
+        if (notifyMapp[a >> videoBlockBits])
+        {
+            videoObserver->notify(this, VRAM_WILL_CHANGE, NULL);
+            
+            break;
+        }
+        
+        i += (OEInt) (videoBlockSize - (a & (videoBlockSize - 1)));
+    }
+    
+    RAM::writeBlock(address, data, size);
+}
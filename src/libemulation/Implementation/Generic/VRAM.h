@@ -21,6 +21,10 @@ public:
     
     void write(OEAddress address, OEChar value);
     
+    OEChar *getWritePointer(OEAddress startAddress, OEAddress endAddress);
+    
+    void writeBlock(OEAddress address, const OEChar *data, OEInt size);
+    
 private:
     OEAddress videoBlockSize;
     string videoMap;
@@ -14,6 +14,27 @@
 #include "OEComponent.h"
 #include "ControlBusInterface.h"
 
+#include "MOS6502Trace.h"
+
+#define MOS6502_PAGENUM     0x100
+
+#if defined(__GNUC__)
+#define MOS6502_INLINE      inline __attribute__((always_inline))
+#else
+#define MOS6502_INLINE      inline
+#endif
+
+typedef struct
+{
+    OESLong icount;
+    ControlBusPowerState powerState;
+    bool isReset;
+    bool isResetTransition;
+    bool isIRQ;
+    bool isIRQEnabled;
+    bool isNMITransition;
+} MOS6502State;
+
 class MOS6502 : public OEComponent
 {
 public:
@@ -23,6 +44,7 @@ public:
     bool getValue(string name, string& value);
     bool setRef(string name, OEComponent *ref);
     bool init();
+    void dispose();
     
     bool postMessage(OEComponent *sender, int message, void *data);
     
@@ -39,8 +61,13 @@ protected:
     OEComponent *controlBus;
     OEComponent *memoryBus;
     
+    ControlBusClock *controlBusClock;
+    
     OESLong icount;
     
+    string traceFile;
+    MOS6502Trace *trace;
+    
     ControlBusPowerState powerState;
     
     bool isReset;
@@ -51,9 +78,55 @@ protected:
     
     bool isSpecialCondition;
     
+    OEChar *readPointer[MOS6502_PAGENUM];
+    OEChar *writePointer[MOS6502_PAGENUM];
+    bool isReadPointerStale[MOS6502_PAGENUM];
+    bool isWritePointerStale[MOS6502_PAGENUM];
+    
     void initCPU();
     void updateSpecialCondition();
     virtual void execute();
+    void executeSpecialCondition(bool wasIRQEnabled);
+    
+    bool startTrace(string path);
+    void stopTrace();
+    void traceInstruction(OEChar opcode);
+    
+    void getState(OEData *data);
+    bool setState(OEData *data);
+    
+    void invalidatePointers();
+    void invalidatePointers(OEAddressRange& range);
+    OEChar readMemory(OEAddress address);
+    void writeMemory(OEAddress address, OEChar value);
+    OEChar readMemoryBus(OEAddress address);
+    void writeMemoryBus(OEAddress address, OEChar value);
+    
+private:
+    template <bool isTraceEnabled> void executeInstructions();
 };
 
+// Memory accesses go through host pointers to the 256-byte page when
+// the memory bus provides one, and through the memory bus otherwise
+
+MOS6502_INLINE OEChar MOS6502::readMemory(OEAddress address)
+{
+    OEChar *p = readPointer[(address >> 8) & 0xff];
+    
+    if (p)
+        return p[address & 0xff];
+    
+    return readMemoryBus(address);
+}
+
+MOS6502_INLINE void MOS6502::writeMemory(OEAddress address, OEChar value)
+{
+    OEChar *p = writePointer[(address >> 8) & 0xff];
+    
+    if (p)
+        p[address & 0xff] = value;
+    else
+        writeMemoryBus(address, value);
+}
+
 #endif
@@ -0,0 +1,93 @@
+
+/**
+ * libemulation
+ * MOS6502 Execute
+ * (C) 2012 by Marc S. Ressl (mressl@umich.edu)
+ * Released under the GPL
+ *
+ * Implements the MOS6502 family execution loop
+ */
+
+// Notes:
+// * MOS6502_EXECUTE(OPCODES) expands the execution loop of a CPU variant
+//   in the body of its executeInstructions<isTraceEnabled>() template.
+//   OPCODES is the variant's opcode table (see MOS6502_OPCODES), so the
+//   compiler specializes the loop for each variant.
+// * With GCC and clang, opcodes are dispatched through a computed goto
+//   table, and each opcode fetches and dispatches the next one directly.
+//   Other compilers use a switch.
+// * The next opcode is dispatched directly only when no interrupt, reset
+//   or NMI is pending; otherwise the loop head handles it.
+
+#define MOS6502_EXECUTE_CASE(prefix, nn) \
+    case 0x##nn: prefix##_OP##nn; break;
+
+#define MOS6502_EXECUTE_LABELADDRESS(prefix, nn) \
+    &&op##nn,
+
+#define MOS6502_EXECUTE_LABEL(prefix, nn) \
+    op##nn: prefix##_OP##nn; MOS6502_EXECUTE_NEXT;
+
+#define MOS6502_EXECUTE_FETCH \
+    opcode = RDOP(); \
+    if (isTraceEnabled) \
+        traceInstruction(opcode);
+
+#define MOS6502_EXECUTE_NEXT \
+    if ((icount > 0) && !isSpecialCondition) \
+    { \
+        isIRQEnabled = !(P & F_I); \
+        MOS6502_EXECUTE_FETCH; \
+        goto *opcodeLabels[opcode]; \
+    } \
+    continue;
+
+#if defined(__GNUC__)
+
+#define MOS6502_EXECUTE_DISPATCH(OPCODES) \
+    static const void *opcodeLabels[] = \
+    { \
+        OPCODES(MOS6502_EXECUTE_LABELADDRESS) \
+    }; \
+    goto *opcodeLabels[opcode]; \
+    OPCODES(MOS6502_EXECUTE_LABEL)
+
+#else
+
+#define MOS6502_EXECUTE_DISPATCH(OPCODES) \
+    switch (opcode) \
+    { \
+        OPCODES(MOS6502_EXECUTE_CASE) \
+    }
+
+#endif
+
+#define MOS6502_EXECUTE(OPCODES) \
+    if (powerState != CONTROLBUS_POWERSTATE_ON) \
+        icount = 0; \
+    \
+    if (isReset) \
+        icount = 0; \
+    \
+    OEUnion zp; \
+    OEUnion ea; \
+    OEChar opcode; \
+    \
+    zp.q = 0; \
+    ea.q = 0; \
+    \
+    while (icount > 0) \
+    { \
+        bool wasIRQEnabled = isIRQEnabled; \
+        isIRQEnabled = !(P & F_I); \
+        \
+        if (isSpecialCondition) \
+        { \
+            executeSpecialCondition(wasIRQEnabled); \
+            \
+            continue; \
+        } \
+        \
+        MOS6502_EXECUTE_FETCH; \
+        MOS6502_EXECUTE_DISPATCH(OPCODES); \
+    }
@@ -37,6 +37,9 @@
 
 #define MOS6502_OP(nn) case 0x##nn: MOS6502_OP##nn; break
 
+// MOS6502_OPCODES applies OP(prefix, nn) to all opcodes in numeric order.
+// MOS6502_EXECUTE uses it for building the dispatch of a CPU variant.
+
 /*****************************************************************************
  *****************************************************************************
  *
@@ -332,3 +335,37 @@
 #define MOS6502_OPbf { int tmp; RD_ABY_P; LAX;					} /* 4 LAX ABY page penalty */
 #define MOS6502_OPdf { int tmp; RD_ABX_NP; WB_EA; DCP; WB_EA;	} /* 7 DCP ABX */
 #define MOS6502_OPff { int tmp; RD_ABX_NP; WB_EA; ISB; WB_EA;	} /* 7 ISB ABX */
+
+#define MOS6502_OPCODES(OP) \
+    OP(MOS6502, 00) OP(MOS6502, 01) OP(MOS6502, 02) OP(MOS6502, 03) OP(MOS6502, 04) OP(MOS6502, 05) OP(MOS6502, 06) OP(MOS6502, 07) \
+    OP(MOS6502, 08) OP(MOS6502, 09) OP(MOS6502, 0a) OP(MOS6502, 0b) OP(MOS6502, 0c) OP(MOS6502, 0d) OP(MOS6502, 0e) OP(MOS6502, 0f) \
+    OP(MOS6502, 10) OP(MOS6502, 11) OP(MOS6502, 12) OP(MOS6502, 13) OP(MOS6502, 14) OP(MOS6502, 15) OP(MOS6502, 16) OP(MOS6502, 17) \
+    OP(MOS6502, 18) OP(MOS6502, 19) OP(MOS6502, 1a) OP(MOS6502, 1b) OP(MOS6502, 1c) OP(MOS6502, 1d) OP(MOS6502, 1e) OP(MOS6502, 1f) \
+    OP(MOS6502, 20) OP(MOS6502, 21) OP(MOS6502, 22) OP(MOS6502, 23) OP(MOS6502, 24) OP(MOS6502, 25) OP(MOS6502, 26) OP(MOS6502, 27) \
+    OP(MOS6502, 28) OP(MOS6502, 29) OP(MOS6502, 2a) OP(MOS6502, 2b) OP(MOS6502, 2c) OP(MOS6502, 2d) OP(MOS6502, 2e) OP(MOS6502, 2f) \
+    OP(MOS6502, 30) OP(MOS6502, 31) OP(MOS6502, 32) OP(MOS6502, 33) OP(MOS6502, 34) OP(MOS6502, 35) OP(MOS6502, 36) OP(MOS6502, 37) \
+    OP(MOS6502, 38) OP(MOS6502, 39) OP(MOS6502, 3a) OP(MOS6502, 3b) OP(MOS6502, 3c) OP(MOS6502, 3d) OP(MOS6502, 3e) OP(MOS6502, 3f) \
+    OP(MOS6502, 40) OP(MOS6502, 41) OP(MOS6502, 42) OP(MOS6502, 43) OP(MOS6502, 44) OP(MOS6502, 45) OP(MOS6502, 46) OP(MOS6502, 47) \
+    OP(MOS6502, 48) OP(MOS6502, 49) OP(MOS6502, 4a) OP(MOS6502, 4b) OP(MOS6502, 4c) OP(MOS6502, 4d) OP(MOS6502, 4e) OP(MOS6502, 4f) \
+    OP(MOS6502, 50) OP(MOS6502, 51) OP(MOS6502, 52) OP(MOS6502, 53) OP(MOS6502, 54) OP(MOS6502, 55) OP(MOS6502, 56) OP(MOS6502, 57) \
+    OP(MOS6502, 58) OP(MOS6502, 59) OP(MOS6502, 5a) OP(MOS6502, 5b) OP(MOS6502, 5c) OP(MOS6502, 5d) OP(MOS6502, 5e) OP(MOS6502, 5f) \
+    OP(MOS6502, 60) OP(MOS6502, 61) OP(MOS6502, 62) OP(MOS6502, 63) OP(MOS6502, 64) OP(MOS6502, 65) OP(MOS6502, 66) OP(MOS6502, 67) \
+    OP(MOS6502, 68) OP(MOS6502, 69) OP(MOS6502, 6a) OP(MOS6502, 6b) OP(MOS6502, 6c) OP(MOS6502, 6d) OP(MOS6502, 6e) OP(MOS6502, 6f) \
+    OP(MOS6502, 70) OP(MOS6502, 71) OP(MOS6502, 72) OP(MOS6502, 73) OP(MOS6502, 74) OP(MOS6502, 75) OP(MOS6502, 76) OP(MOS6502, 77) \
+    OP(MOS6502, 78) OP(MOS6502, 79) OP(MOS6502, 7a) OP(MOS6502, 7b) OP(MOS6502, 7c) OP(MOS6502, 7d) OP(MOS6502, 7e) OP(MOS6502, 7f) \
+    OP(MOS6502, 80) OP(MOS6502, 81) OP(MOS6502, 82) OP(MOS6502, 83) OP(MOS6502, 84) OP(MOS6502, 85) OP(MOS6502, 86) OP(MOS6502, 87) \
+    OP(MOS6502, 88) OP(MOS6502, 89) OP(MOS6502, 8a) OP(MOS6502, 8b) OP(MOS6502, 8c) OP(MOS6502, 8d) OP(MOS6502, 8e) OP(MOS6502, 8f) \
+    OP(MOS6502, 90) OP(MOS6502, 91) OP(MOS6502, 92) OP(MOS6502, 93) OP(MOS6502, 94) OP(MOS6502, 95) OP(MOS6502, 96) OP(MOS6502, 97) \
+    OP(MOS6502, 98) OP(MOS6502, 99) OP(MOS6502, 9a) OP(MOS6502, 9b) OP(MOS6502, 9c) OP(MOS6502, 9d) OP(MOS6502, 9e) OP(MOS6502, 9f) \
+    OP(MOS6502, a0) OP(MOS6502, a1) OP(MOS6502, a2) OP(MOS6502, a3) OP(MOS6502, a4) OP(MOS6502, a5) OP(MOS6502, a6) OP(MOS6502, a7) \
+    OP(MOS6502, a8) OP(MOS6502, a9) OP(MOS6502, aa) OP(MOS6502, ab) OP(MOS6502, ac) OP(MOS6502, ad) OP(MOS6502, ae) OP(MOS6502, af) \
+    OP(MOS6502, b0) OP(MOS6502, b1) OP(MOS6502, b2) OP(MOS6502, b3) OP(MOS6502, b4) OP(MOS6502, b5) OP(MOS6502, b6) OP(MOS6502, b7) \
+    OP(MOS6502, b8) OP(MOS6502, b9) OP(MOS6502, ba) OP(MOS6502, bb) OP(MOS6502, bc) OP(MOS6502, bd) OP(MOS6502, be) OP(MOS6502, bf) \
+    OP(MOS6502, c0) OP(MOS6502, c1) OP(MOS6502, c2) OP(MOS6502, c3) OP(MOS6502, c4) OP(MOS6502, c5) OP(MOS6502, c6) OP(MOS6502, c7) \
+    OP(MOS6502, c8) OP(MOS6502, c9) OP(MOS6502, ca) OP(MOS6502, cb) OP(MOS6502, cc) OP(MOS6502, cd) OP(MOS6502, ce) OP(MOS6502, cf) \
+    OP(MOS6502, d0) OP(MOS6502, d1) OP(MOS6502, d2) OP(MOS6502, d3) OP(MOS6502, d4) OP(MOS6502, d5) OP(MOS6502, d6) OP(MOS6502, d7) \
+    OP(MOS6502, d8) OP(MOS6502, d9) OP(MOS6502, da) OP(MOS6502, db) OP(MOS6502, dc) OP(MOS6502, dd) OP(MOS6502, de) OP(MOS6502, df) \
+    OP(MOS6502, e0) OP(MOS6502, e1) OP(MOS6502, e2) OP(MOS6502, e3) OP(MOS6502, e4) OP(MOS6502, e5) OP(MOS6502, e6) OP(MOS6502, e7) \
+    OP(MOS6502, e8) OP(MOS6502, e9) OP(MOS6502, ea) OP(MOS6502, eb) OP(MOS6502, ec) OP(MOS6502, ed) OP(MOS6502, ee) OP(MOS6502, ef) \
+    OP(MOS6502, f0) OP(MOS6502, f1) OP(MOS6502, f2) OP(MOS6502, f3) OP(MOS6502, f4) OP(MOS6502, f5) OP(MOS6502, f6) OP(MOS6502, f7) \
+    OP(MOS6502, f8) OP(MOS6502, f9) OP(MOS6502, fa) OP(MOS6502, fb) OP(MOS6502, fc) OP(MOS6502, fd) OP(MOS6502, fe) OP(MOS6502, ff)
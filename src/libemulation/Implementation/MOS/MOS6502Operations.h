@@ -79,24 +79,24 @@
 /***************************************************************
  *  RDOP    read an opcode
  ***************************************************************/
-#define RDOP() memoryBus->read(PCA++); icount--
+#define RDOP() readMemory(PCA++); icount--
 
 /***************************************************************
  *  RDOPARG read an opcode argument
  ***************************************************************/
-#define RDOPARG() memoryBus->read(PCA++); icount--
+#define RDOPARG() readMemory(PCA++); icount--
 
 /***************************************************************
  *  RDMEM   read memory
  ***************************************************************/
-#define RDMEM(addr) memoryBus->read(addr); icount--
-#define RDMEM_ID(a) memoryBus->read(a); icount--
+#define RDMEM(addr) readMemory(addr); icount--
+#define RDMEM_ID(a) readMemory(a); icount--
 
 /***************************************************************
  *  WRMEM   write memory
  ***************************************************************/
-#define WRMEM(addr,data) memoryBus->write(addr, data); icount--
-#define WRMEM_ID(a,d) memoryBus->write(a, d); icount--
+#define WRMEM(addr,data) writeMemory(addr, data); icount--
+#define WRMEM_ID(a,d) writeMemory(a, d); icount--
 
 /***************************************************************
  *  BRA  branch relative
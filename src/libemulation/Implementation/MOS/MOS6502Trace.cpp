@@ -0,0 +1,149 @@
+
+/**
+ * libemulation
+ * MOS6502 Trace
+ * (C) 2012 by Marc S. Ressl (mressl@umich.edu)
+ * Released under the GPL
+ *
+ * Records MOS6502 instruction traces
+ */
+
+#include <unistd.h>
+
+#include "MOS6502Trace.h"
+
+#define MOS6502_TRACE_WRITER_SLEEP  1000
+
+void *MOS6502TraceRunWriter(void *arg)
+{
+    ((MOS6502Trace *) arg)->runWriter();
+    
+    return NULL;
+}
+
+MOS6502Trace::MOS6502Trace()
+{
+    fp = NULL;
+    
+    records = new MOS6502TraceRecord[MOS6502_TRACE_RECORDNUM];
+    head = 0;
+    tail = 0;
+    droppedRecordNum = 0;
+    
+    writerThreadShouldRun = false;
+}
+
+MOS6502Trace::~MOS6502Trace()
+{
+    close();
+    
+    delete[] records;
+}
+
+bool MOS6502Trace::open(string path)
+{
+    close();
+    
+    fp = fopen(path.c_str(), "wb");
+    if (!fp)
+    {
+        logMessage("could not open trace file " + path);
+        
+        return false;
+    }
+    
+    fwrite(MOS6502_TRACE_MAGIC, 1, 8, fp);
+    
+    head = 0;
+    tail = 0;
+    droppedRecordNum = 0;
+    
+    int error;
+    pthread_attr_t attr;
+    
+    error = pthread_attr_init(&attr);
+    
+    if (!error)
+    {
+        error = pthread_attr_setdetachstate(&attr,
+                                            PTHREAD_CREATE_JOINABLE);
+        if (!error)
+        {
+            writerThreadShouldRun = true;
+            error = pthread_create(&writerThread,
+                                   &attr,
+                                   MOS6502TraceRunWriter,
+                                   this);
+            if (!error)
+                return true;
+            else
+                logMessage("could not create trace writer thread, error " + getString(error));
+            
+            writerThreadShouldRun = false;
+        }
+        else
+            logMessage("could not attr trace writer thread, error " + getString(error));
+    }
+    else
+        logMessage("could not init trace writer thread, error " + getString(error));
+    
+    fclose(fp);
+    fp = NULL;
+    
+    return false;
+}
+
+void MOS6502Trace::close()
+{
+    if (!fp)
+        return;
+    
+    if (writerThreadShouldRun)
+    {
+        writerThreadShouldRun = false;
+        
+        void *status;
+        pthread_join(writerThread, &status);
+    }
+    
+    writeRecords();
+    
+    if (droppedRecordNum)
+        logMessage("trace dropped " + getString(droppedRecordNum) + " records");
+    
+    fclose(fp);
+    fp = NULL;
+}
+
+void MOS6502Trace::runWriter()
+{
+    while (writerThreadShouldRun)
+    {
+        if (!writeRecords())
+            usleep(MOS6502_TRACE_WRITER_SLEEP);
+    }
+}
+
+bool MOS6502Trace::writeRecords()
+{
+    OEInt index = tail.load(std::memory_order_relaxed);
+    OEInt endIndex = head.load(std::memory_order_acquire);
+    
+    if (index == endIndex)
+        return false;
+    
+    if (endIndex < index)
+    {
+        fwrite(&records[index], sizeof(MOS6502TraceRecord),
+               MOS6502_TRACE_RECORDNUM - index, fp);
+        
+        index = 0;
+    }
+    
+    fwrite(&records[index], sizeof(MOS6502TraceRecord),
+           endIndex - index, fp);
+    
+    tail.store(endIndex, std::memory_order_release);
+    
+    return true;
+}
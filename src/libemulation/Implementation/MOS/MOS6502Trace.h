@@ -0,0 +1,92 @@
+
+/**
+ * libemulation
+ * MOS6502 Trace
+ * (C) 2012 by Marc S. Ressl (mressl@umich.edu)
+ * Released under the GPL
+ *
+ * Records MOS6502 instruction traces
+ */
+
+#ifndef _MOS6502TRACE_H
+#define _MOS6502TRACE_H
+
+#include <pthread.h>
+
+#include <atomic>
+
+#include "OECommon.h"
+
+// Notes:
+// * Records are appended by the emulation thread to a single-producer,
+//   single-consumer ring, and written to the trace file by a separate
+//   thread. When the ring is full, records are dropped (and counted)
+//   instead of stalling the emulation.
+// * cycles is sampled right after the opcode fetch.
+// * The two bytes after the opcode are recorded when they can be read
+//   without side effects. Bit n of unknownMask is set when opcode[n]
+//   lies in I/O space and was not read.
+// * The trace file starts with the 8-byte MOS6502_TRACE_MAGIC, followed
+//   by MOS6502TraceRecord entries in host byte order.
+
+#define MOS6502_TRACE_MAGIC         "OE6502T2"
+#define MOS6502_TRACE_RECORDNUM     0x10000
+
+typedef struct
+{
+    OELong cycles;
+    OEShort pc;
+    OEChar a;
+    OEChar x;
+    OEChar y;
+    OEChar s;
+    OEChar p;
+    OEChar opcode[3];
+    OEChar unknownMask;
+} MOS6502TraceRecord;
+
+class MOS6502Trace
+{
+public:
+    MOS6502Trace();
+    ~MOS6502Trace();
+    
+    bool open(string path);
+    void close();
+    
+    void write(const MOS6502TraceRecord& record);
+    
+    void runWriter();
+    
+private:
+    FILE *fp;
+    
+    MOS6502TraceRecord *records;
+    std::atomic<OEInt> head;
+    std::atomic<OEInt> tail;
+    OELong droppedRecordNum;
+    
+    pthread_t writerThread;
+    std::atomic<bool> writerThreadShouldRun;
+    
+    bool writeRecords();
+};
+
+inline void MOS6502Trace::write(const MOS6502TraceRecord& record)
+{
+    OEInt index = head.load(std::memory_order_relaxed);
+    OEInt nextIndex = (index + 1) & (MOS6502_TRACE_RECORDNUM - 1);
+    
+    if (nextIndex == tail.load(std::memory_order_acquire))
+    {
+        droppedRecordNum++;
+        
+        return;
+    }
+    
+    records[index] = record;
+    
+    head.store(nextIndex, std::memory_order_release);
+}
+
+#endif
@@ -42,6 +42,7 @@ typedef enum
 MC6845::MC6845()
 {
     controlBus = NULL;
+    controlBusClock = NULL;
     floatingBus = NULL;
     
     horizTotal = 1;
@@ -188,6 +189,9 @@ bool MC6845::init()
     OECheckComponent(controlBus);
     OECheckComponent(floatingBus);
     
+    controlBus->postMessage(this, CONTROLBUS_GET_CLOCK, &controlBusClock);
+    OECheckComponent(controlBusClock);
+    
     controlBus->postMessage(this, CONTROLBUS_GET_POWERSTATE, &powerState);
     
     updateTiming();
@@ -405,7 +409,7 @@ void MC6845::updateTiming()
     
     frameCycleNum = horizTotal * vertTotal;
     
-    controlBus->postMessage(this, CONTROLBUS_GET_CYCLES, &lastCycles);
+    lastCycles = getControlBusCycles(controlBusClock);
     
     OEInt id = 0;
     controlBus->postMessage(this, CONTROLBUS_INVALIDATE_TIMERS, &id);
@@ -440,7 +444,7 @@ void MC6845::scheduleTimer(OESLong cycles)
         }
     }
     
-    controlBus->postMessage(this, CONTROLBUS_GET_CYCLES, &frameStart);
+    frameStart = getControlBusCycles(controlBusClock);
     frameStart += cycles;
     
     ControlBusTimer timer = { cycles + ceil(frameCycleNum / clockMultiplier), 0 };
@@ -461,9 +465,7 @@ void MC6845::refreshVideo()
 
 void MC6845::updateVideo()
 {
-    OELong cycles;
-    
-    controlBus->postMessage(this, CONTROLBUS_GET_CYCLES, &cycles);
+    OELong cycles = getControlBusCycles(controlBusClock);
     
     OEInt deltaCycles = ((OEInt) (cycles - lastCycles) * clockMultiplier);
     
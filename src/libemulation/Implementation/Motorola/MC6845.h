@@ -84,6 +84,7 @@ protected:
     
 private:
     OEComponent *controlBus;
+    ControlBusClock *controlBusClock;
     OEComponent *floatingBus;
     
     OEChar addressRegister;
@@ -17,6 +17,7 @@ class W65C02S : public MOS6502
 {
 private:
     void execute();
+    template <bool isTraceEnabled> void executeInstructions();
 };
 
 #endif
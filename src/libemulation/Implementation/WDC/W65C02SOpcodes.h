@@ -37,8 +37,6 @@
 #include "MOS6502IllegalOperations.h"
 #include "W65C02SOperations.h"
 
-#define W65C02S_OP(nn) case 0x##nn: W65C02S_OP##nn; break
-
 /*****************************************************************************
  *****************************************************************************
  *
@@ -88,14 +86,14 @@
 #define W65C02S_OPd1 { int tmp; RD_IDY_C02_P; CMP;                } /* 5 CMP IDY page penalty */
 #define W65C02S_OPf1 { int tmp; RD_IDY_C02_P; SBC_C02;            } /* 5/6 SBC IDY page penalty */
 
-#define W65C02S_OP02 { int tmp; RD_IMM; NOP;                      } /* 2 NOP not sure for rockwell */
-#define W65C02S_OP22 { int tmp; RD_IMM; NOP;                      } /* 2 NOP not sure for rockwell */
-#define W65C02S_OP42 { int tmp; RD_IMM; NOP;                      } /* 2 NOP not sure for rockwell */
-#define W65C02S_OP62 { int tmp; RD_IMM; NOP;                      } /* 2 NOP not sure for rockwell */
-#define W65C02S_OP82 { int tmp; RD_IMM; NOP;                      } /* 2 NOP not sure for rockwell */
+#define W65C02S_OP02 { RD_IMM_DISCARD; NOP;                       } /* 2 NOP not sure for rockwell */
+#define W65C02S_OP22 { RD_IMM_DISCARD; NOP;                       } /* 2 NOP not sure for rockwell */
+#define W65C02S_OP42 { RD_IMM_DISCARD; NOP;                       } /* 2 NOP not sure for rockwell */
+#define W65C02S_OP62 { RD_IMM_DISCARD; NOP;                       } /* 2 NOP not sure for rockwell */
+#define W65C02S_OP82 { RD_IMM_DISCARD; NOP;                       } /* 2 NOP not sure for rockwell */
 #define W65C02S_OPa2 { int tmp; RD_IMM; LDX;                      } /* 2 LDX IMM */
-#define W65C02S_OPc2 { int tmp; RD_IMM; NOP;                      } /* 2 NOP not sure for rockwell */
-#define W65C02S_OPe2 { int tmp; RD_IMM; NOP;                      } /* 2 NOP not sure for rockwell */
+#define W65C02S_OPc2 { RD_IMM_DISCARD; NOP;                       } /* 2 NOP not sure for rockwell */
+#define W65C02S_OPe2 { RD_IMM_DISCARD; NOP;                       } /* 2 NOP not sure for rockwell */
 
 #define W65C02S_OP12 { int tmp; RD_ZPI; ORA;                      } /* 5 ORA ZPI */
 #define W65C02S_OP32 { int tmp; RD_ZPI; AND;                      } /* 5 AND ZPI */
@@ -126,7 +124,7 @@
 
 #define W65C02S_OP04 { int tmp; RD_ZPG; RD_EA; TSB; WB_EA;        } /* 5 TSB ZPG */
 #define W65C02S_OP24 { int tmp; RD_ZPG; BIT;                      } /* 3 BIT ZPG */
-#define W65C02S_OP44 { int tmp; RD_ZPG; NOP;                      } /* 3 NOP not sure for rockwell */
+#define W65C02S_OP44 { RD_ZPG_DISCARD; NOP;                       } /* 3 NOP not sure for rockwell */
 #define W65C02S_OP64 { int tmp; STZ; WR_ZPG;                      } /* 3 STZ ZPG */
 #define W65C02S_OP84 { int tmp; STY; WR_ZPG;                      } /* 3 STY ZPG */
 #define W65C02S_OPa4 { int tmp; RD_ZPG; LDY;                      } /* 3 LDY ZPG */
@@ -135,12 +133,12 @@
 
 #define W65C02S_OP14 { int tmp; RD_ZPG; RD_EA; TRB; WB_EA;        } /* 5 TRB ZPG */
 #define W65C02S_OP34 { int tmp; RD_ZPX; BIT;                      } /* 4 BIT ZPX */
-#define W65C02S_OP54 { int tmp; RD_ZPX; NOP;                      } /* 4 NOP not sure for rockwell */
+#define W65C02S_OP54 { RD_ZPX_DISCARD; NOP;                       } /* 4 NOP not sure for rockwell */
 #define W65C02S_OP74 { int tmp; STZ; WR_ZPX;                      } /* 4 STZ ZPX */
 #define W65C02S_OP94 { int tmp; STY; WR_ZPX;                      } /* 4 STY ZPX */
 #define W65C02S_OPb4 { int tmp; RD_ZPX; LDY;                      } /* 4 LDY ZPX */
-#define W65C02S_OPd4 { int tmp; RD_ZPX; NOP;                      } /* 4 NOP not sure for rockwell */
-#define W65C02S_OPf4 { int tmp; RD_ZPX; NOP;                      } /* 4 NOP not sure for rockwell */
+#define W65C02S_OPd4 { RD_ZPX_DISCARD; NOP;                       } /* 4 NOP not sure for rockwell */
+#define W65C02S_OPf4 { RD_ZPX_DISCARD; NOP;                       } /* 4 NOP not sure for rockwell */
 
 #define W65C02S_OP05 { int tmp; RD_ZPG; ORA;                      } /* 3 ORA ZPG */
 #define W65C02S_OP25 { int tmp; RD_ZPG; AND;                      } /* 3 AND ZPG */
@@ -279,12 +277,12 @@
 
 #define W65C02S_OP1c { int tmp; RD_ABS; RD_EA; TRB; WB_EA;        } /* 6 TRB ABS */
 #define W65C02S_OP3c { int tmp; RD_ABX_C02_P; BIT;                } /* 4 BIT ABX page penalty */
-#define W65C02S_OP5c { int tmp; RD_ABX_C02_NP; RD_DUM; RD_DUM; RD_DUM; RD_DUM; } /* 8 NOP ABX not sure for rockwell. Page penalty not sure */
+#define W65C02S_OP5c { RD_ABX_C02_NP_DISCARD; RD_DUM; RD_DUM; RD_DUM; RD_DUM; } /* 8 NOP ABX not sure for rockwell. Page penalty not sure */
 #define W65C02S_OP7c { int tmp; EA_IAX; JMP;                      } /* 6 JMP IAX page penalty */
 #define W65C02S_OP9c { int tmp; STZ; WR_ABS;                      } /* 4 STZ ABS */
 #define W65C02S_OPbc { int tmp; RD_ABX_C02_P; LDY;                } /* 4 LDY ABX page penalty */
-#define W65C02S_OPdc { int tmp; RD_ABX_C02_NP; NOP;               } /* 4 NOP ABX not sure for rockwell. Page penalty not sure  */
-#define W65C02S_OPfc { int tmp; RD_ABX_C02_NP; NOP;               } /* 4 NOP ABX not sure for rockwell. Page penalty not sure  */
+#define W65C02S_OPdc { RD_ABX_C02_NP_DISCARD; NOP;                } /* 4 NOP ABX not sure for rockwell. Page penalty not sure  */
+#define W65C02S_OPfc { RD_ABX_C02_NP_DISCARD; NOP;                } /* 4 NOP ABX not sure for rockwell. Page penalty not sure  */
 
 #define W65C02S_OP0d { int tmp; RD_ABS; ORA;                      } /* 4 ORA ABS */
 #define W65C02S_OP2d { int tmp; RD_ABS; AND;                      } /* 4 AND ABS */
@@ -339,3 +337,37 @@
 #define W65C02S_OPbf { int tmp; RD_ZPG; BBS(3);                   } /* 5-7 BBS3 ZPG */
 #define W65C02S_OPdf { int tmp; RD_ZPG; BBS(5);                   } /* 5-7 BBS5 ZPG */
 #define W65C02S_OPff { int tmp; RD_ZPG; BBS(7);                   } /* 5-7 BBS7 ZPG */
+
+#define W65C02S_OPCODES(OP) \
+    OP(W65C02S, 00) OP(W65C02S, 01) OP(W65C02S, 02) OP(W65C02S, 03) OP(W65C02S, 04) OP(W65C02S, 05) OP(W65C02S, 06) OP(W65C02S, 07) \
+    OP(W65C02S, 08) OP(W65C02S, 09) OP(W65C02S, 0a) OP(W65C02S, 0b) OP(W65C02S, 0c) OP(W65C02S, 0d) OP(W65C02S, 0e) OP(W65C02S, 0f) \
+    OP(W65C02S, 10) OP(W65C02S, 11) OP(W65C02S, 12) OP(W65C02S, 13) OP(W65C02S, 14) OP(W65C02S, 15) OP(W65C02S, 16) OP(W65C02S, 17) \
+    OP(W65C02S, 18) OP(W65C02S, 19) OP(W65C02S, 1a) OP(W65C02S, 1b) OP(W65C02S, 1c) OP(W65C02S, 1d) OP(W65C02S, 1e) OP(W65C02S, 1f) \
+    OP(W65C02S, 20) OP(W65C02S, 21) OP(W65C02S, 22) OP(W65C02S, 23) OP(W65C02S, 24) OP(W65C02S, 25) OP(W65C02S, 26) OP(W65C02S, 27) \
+    OP(W65C02S, 28) OP(W65C02S, 29) OP(W65C02S, 2a) OP(W65C02S, 2b) OP(W65C02S, 2c) OP(W65C02S, 2d) OP(W65C02S, 2e) OP(W65C02S, 2f) \
+    OP(W65C02S, 30) OP(W65C02S, 31) OP(W65C02S, 32) OP(W65C02S, 33) OP(W65C02S, 34) OP(W65C02S, 35) OP(W65C02S, 36) OP(W65C02S, 37) \
+    OP(W65C02S, 38) OP(W65C02S, 39) OP(W65C02S, 3a) OP(W65C02S, 3b) OP(W65C02S, 3c) OP(W65C02S, 3d) OP(W65C02S, 3e) OP(W65C02S, 3f) \
+    OP(W65C02S, 40) OP(W65C02S, 41) OP(W65C02S, 42) OP(W65C02S, 43) OP(W65C02S, 44) OP(W65C02S, 45) OP(W65C02S, 46) OP(W65C02S, 47) \
+    OP(W65C02S, 48) OP(W65C02S, 49) OP(W65C02S, 4a) OP(W65C02S, 4b) OP(W65C02S, 4c) OP(W65C02S, 4d) OP(W65C02S, 4e) OP(W65C02S, 4f) \
+    OP(W65C02S, 50) OP(W65C02S, 51) OP(W65C02S, 52) OP(W65C02S, 53) OP(W65C02S, 54) OP(W65C02S, 55) OP(W65C02S, 56) OP(W65C02S, 57) \
+    OP(W65C02S, 58) OP(W65C02S, 59) OP(W65C02S, 5a) OP(W65C02S, 5b) OP(W65C02S, 5c) OP(W65C02S, 5d) OP(W65C02S, 5e) OP(W65C02S, 5f) \
+    OP(W65C02S, 60) OP(W65C02S, 61) OP(W65C02S, 62) OP(W65C02S, 63) OP(W65C02S, 64) OP(W65C02S, 65) OP(W65C02S, 66) OP(W65C02S, 67) \
+    OP(W65C02S, 68) OP(W65C02S, 69) OP(W65C02S, 6a) OP(W65C02S, 6b) OP(W65C02S, 6c) OP(W65C02S, 6d) OP(W65C02S, 6e) OP(W65C02S, 6f) \
+    OP(W65C02S, 70) OP(W65C02S, 71) OP(W65C02S, 72) OP(W65C02S, 73) OP(W65C02S, 74) OP(W65C02S, 75) OP(W65C02S, 76) OP(W65C02S, 77) \
+    OP(W65C02S, 78) OP(W65C02S, 79) OP(W65C02S, 7a) OP(W65C02S, 7b) OP(W65C02S, 7c) OP(W65C02S, 7d) OP(W65C02S, 7e) OP(W65C02S, 7f) \
+    OP(W65C02S, 80) OP(W65C02S, 81) OP(W65C02S, 82) OP(W65C02S, 83) OP(W65C02S, 84) OP(W65C02S, 85) OP(W65C02S, 86) OP(W65C02S, 87) \
+    OP(W65C02S, 88) OP(W65C02S, 89) OP(W65C02S, 8a) OP(W65C02S, 8b) OP(W65C02S, 8c) OP(W65C02S, 8d) OP(W65C02S, 8e) OP(W65C02S, 8f) \
+    OP(W65C02S, 90) OP(W65C02S, 91) OP(W65C02S, 92) OP(W65C02S, 93) OP(W65C02S, 94) OP(W65C02S, 95) OP(W65C02S, 96) OP(W65C02S, 97) \
+    OP(W65C02S, 98) OP(W65C02S, 99) OP(W65C02S, 9a) OP(W65C02S, 9b) OP(W65C02S, 9c) OP(W65C02S, 9d) OP(W65C02S, 9e) OP(W65C02S, 9f) \
+    OP(W65C02S, a0) OP(W65C02S, a1) OP(W65C02S, a2) OP(W65C02S, a3) OP(W65C02S, a4) OP(W65C02S, a5) OP(W65C02S, a6) OP(W65C02S, a7) \
+    OP(W65C02S, a8) OP(W65C02S, a9) OP(W65C02S, aa) OP(W65C02S, ab) OP(W65C02S, ac) OP(W65C02S, ad) OP(W65C02S, ae) OP(W65C02S, af) \
+    OP(W65C02S, b0) OP(W65C02S, b1) OP(W65C02S, b2) OP(W65C02S, b3) OP(W65C02S, b4) OP(W65C02S, b5) OP(W65C02S, b6) OP(W65C02S, b7) \
+    OP(W65C02S, b8) OP(W65C02S, b9) OP(W65C02S, ba) OP(W65C02S, bb) OP(W65C02S, bc) OP(W65C02S, bd) OP(W65C02S, be) OP(W65C02S, bf) \
+    OP(W65C02S, c0) OP(W65C02S, c1) OP(W65C02S, c2) OP(W65C02S, c3) OP(W65C02S, c4) OP(W65C02S, c5) OP(W65C02S, c6) OP(W65C02S, c7) \
+    OP(W65C02S, c8) OP(W65C02S, c9) OP(W65C02S, ca) OP(W65C02S, cb) OP(W65C02S, cc) OP(W65C02S, cd) OP(W65C02S, ce) OP(W65C02S, cf) \
+    OP(W65C02S, d0) OP(W65C02S, d1) OP(W65C02S, d2) OP(W65C02S, d3) OP(W65C02S, d4) OP(W65C02S, d5) OP(W65C02S, d6) OP(W65C02S, d7) \
+    OP(W65C02S, d8) OP(W65C02S, d9) OP(W65C02S, da) OP(W65C02S, db) OP(W65C02S, dc) OP(W65C02S, dd) OP(W65C02S, de) OP(W65C02S, df) \
+    OP(W65C02S, e0) OP(W65C02S, e1) OP(W65C02S, e2) OP(W65C02S, e3) OP(W65C02S, e4) OP(W65C02S, e5) OP(W65C02S, e6) OP(W65C02S, e7) \
+    OP(W65C02S, e8) OP(W65C02S, e9) OP(W65C02S, ea) OP(W65C02S, eb) OP(W65C02S, ec) OP(W65C02S, ed) OP(W65C02S, ee) OP(W65C02S, ef) \
+    OP(W65C02S, f0) OP(W65C02S, f1) OP(W65C02S, f2) OP(W65C02S, f3) OP(W65C02S, f4) OP(W65C02S, f5) OP(W65C02S, f6) OP(W65C02S, f7) \
+    OP(W65C02S, f8) OP(W65C02S, f9) OP(W65C02S, fa) OP(W65C02S, fb) OP(W65C02S, fc) OP(W65C02S, fd) OP(W65C02S, fe) OP(W65C02S, ff)
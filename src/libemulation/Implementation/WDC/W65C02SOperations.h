@@ -136,6 +136,7 @@
 #define RD_ABX_C02_NP	EA_ABX_C02_NP; tmp = RDMEM(EAA)
 #define RD_ABY_C02_P	EA_ABY_C02_P; tmp = RDMEM(EAA)
 #define RD_IDY_C02_P	EA_IDY_C02_P; tmp = RDMEM_ID(EAA)
+#define RD_ABX_C02_NP_DISCARD	EA_ABX_C02_NP; RDMEM(EAA)
 
 #define WR_ABX_C02_NP	EA_ABX_C02_NP; WRMEM(EAA, tmp)
 #define WR_ABY_C02_NP	EA_ABY_C02_NP; WRMEM(EAA, tmp)
@@ -1,11 +1,546 @@
-/*
- *  W65C816S.cpp
- *  OpenEmulator
- *
- *  Created by Marc S. Reßl on 25/02/10.
- *  Copyright 2010 ITBA. All rights reserved.
+
+/**
+ * libemulation
+ * W65C816S
+ * (C) 2012 by Marc S. Ressl (mressl@umich.edu)
+ * Released under the GPL
  *
+ * Emulates a W65C816S microprocessor
  */
 
 #include "W65C816S.h"
 
+#include "CPUInterface.h"
+#include "MemoryInterface.h"
+
+#include "W65C816SOpcodes.h"
+#include "W65C816SExecute.h"
+
+W65C816S::W65C816S()
+{
+    initCPU();
+    
+    controlBus = NULL;
+    memoryBus = NULL;
+    
+    controlBusClock = NULL;
+    
+    icount = 0;
+    
+    isReset = false;
+    isResetTransition = false;
+    isIRQ = false;
+    isNMITransition = false;
+    isWaiting = false;
+    isStopped = false;
+    
+    updateSpecialCondition();
+    
+    for (OEInt i = 0; i < W65C816S_PAGENUM; i++)
+    {
+        readPointer[i] = NULL;
+        writePointer[i] = NULL;
+        isReadPointerStale[i] = true;
+        isWritePointerStale[i] = true;
+    }
+}
+
+bool W65C816S::setValue(string name, string value)
+{
+    if (name == "a")
+        a.w.l = getOEInt(value);
+    else if (name == "x")
+        x.w.l = getOEInt(value);
+    else if (name == "y")
+        y.w.l = getOEInt(value);
+    else if (name == "s")
+        sp.w.l = getOEInt(value);
+    else if (name == "d")
+        d.w.l = getOEInt(value);
+    else if (name == "p")
+        p = getOEInt(value);
+    else if (name == "e")
+        e = getOEInt(value) ? 1 : 0;
+    else if (name == "pc")
+        pc.w.l = getOEInt(value);
+    else if (name == "pbr")
+        pbr = getOEInt(value);
+    else if (name == "dbr")
+        dbr = getOEInt(value);
+    else
+        return false;
+    
+    return true;
+}
+
+bool W65C816S::getValue(string name, string& value)
+{
+    if (name == "a")
+        value = getHexString(a.w.l);
+    else if (name == "x")
+        value = getHexString(x.w.l);
+    else if (name == "y")
+        value = getHexString(y.w.l);
+    else if (name == "s")
+        value = getHexString(sp.w.l);
+    else if (name == "d")
+        value = getHexString(d.w.l);
+    else if (name == "p")
+        value = getHexString(p);
+    else if (name == "e")
+        value = getString(e);
+    else if (name == "pc")
+        value = getHexString(pc.w.l);
+    else if (name == "pbr")
+        value = getHexString(pbr);
+    else if (name == "dbr")
+        value = getHexString(dbr);
+    else
+        return false;
+    
+    return true;
+}
+
+bool W65C816S::setRef(string name, OEComponent *ref)
+{
+    if (name == "controlBus")
+    {
+        if (controlBus)
+        {
+            controlBus->removeObserver(this, CONTROLBUS_POWERSTATE_DID_CHANGE);
+            controlBus->removeObserver(this, CONTROLBUS_RESET_DID_ASSERT);
+            controlBus->removeObserver(this, CONTROLBUS_RESET_DID_CLEAR);
+            controlBus->removeObserver(this, CONTROLBUS_IRQ_DID_CHANGE);
+            controlBus->removeObserver(this, CONTROLBUS_NMI_DID_ASSERT);
+        }
+        controlBus = ref;
+        if (controlBus)
+        {
+            controlBus->addObserver(this, CONTROLBUS_POWERSTATE_DID_CHANGE);
+            controlBus->addObserver(this, CONTROLBUS_RESET_DID_ASSERT);
+            controlBus->addObserver(this, CONTROLBUS_RESET_DID_CLEAR);
+            controlBus->addObserver(this, CONTROLBUS_IRQ_DID_CHANGE);
+            controlBus->addObserver(this, CONTROLBUS_NMI_DID_ASSERT);
+        }
+    }
+    else if (name == "memoryBus")
+    {
+        if (memoryBus)
+            memoryBus->removeObserver(this, MEMORY_MAP_DID_CHANGE);
+        memoryBus = ref;
+        if (memoryBus)
+            memoryBus->addObserver(this, MEMORY_MAP_DID_CHANGE);
+        
+        invalidatePointers();
+    }
+    else
+        return false;
+    
+    return true;
+}
+
+bool W65C816S::init()
+{
+    OECheckComponent(controlBus);
+    OECheckComponent(memoryBus);
+    
+    controlBus->postMessage(this, CONTROLBUS_GET_POWERSTATE, &powerState);
+    controlBus->postMessage(this, CONTROLBUS_IS_RESET_ASSERTED, &isReset);
+    controlBus->postMessage(this, CONTROLBUS_IS_IRQ_ASSERTED, &isIRQ);
+    controlBus->postMessage(this, CONTROLBUS_GET_CLOCK, &controlBusClock);
+    
+    updateRegisterWidths();
+    updateSpecialCondition();
+    
+    invalidatePointers();
+    
+    return true;
+}
+
+bool W65C816S::postMessage(OEComponent *sender, int message, void *data)
+{
+    switch (message)
+    {
+        case CPU_SET_PENDINGCYCLES:
+            icount = *((OESLong *)data);
+            
+            return true;
+            
+        case CPU_GET_PENDINGCYCLES:
+            *((OESLong *)data) = icount;
+            
+            return true;
+            
+        case CPU_RUN:
+            execute();
+            
+            return true;
+            
+        case CPU_GET_PENDINGCYCLESPOINTER:
+            *((OESLong **)data) = &icount;
+            
+            return true;
+            
+        case COMPONENT_GET_STATE:
+            getState((OEData *)data);
+            
+            return true;
+            
+        case COMPONENT_SET_STATE:
+            return setState((OEData *)data);
+    }
+    
+    return false;
+}
+
+void W65C816S::notify(OEComponent *sender, int notification, void *data)
+{
+    if ((sender == memoryBus) && (notification == MEMORY_MAP_DID_CHANGE))
+    {
+        if (data)
+            invalidatePointers(*((OEAddressRange *) data));
+        else
+            invalidatePointers();
+        
+        return;
+    }
+    
+    switch (notification)
+    {
+        case CONTROLBUS_POWERSTATE_DID_CHANGE:
+            powerState = *((ControlBusPowerState *)data);
+            
+            if (powerState == CONTROLBUS_POWERSTATE_OFF)
+                initCPU();
+            
+            return;
+            
+        case CONTROLBUS_RESET_DID_ASSERT:
+            isReset = true;
+            if (icount > 0)
+                icount = 0;
+            
+            return;
+            
+        case CONTROLBUS_RESET_DID_CLEAR:
+            isReset = false;
+            isResetTransition = true;
+            
+            updateSpecialCondition();
+            
+            return;
+            
+        case CONTROLBUS_IRQ_DID_CHANGE:
+            isIRQ = *((bool *)data);
+            
+            updateSpecialCondition();
+            
+            return;
+            
+        case CONTROLBUS_NMI_DID_ASSERT:
+            isNMITransition = true;
+            
+            updateSpecialCondition();
+            
+            return;
+    }
+}
+
+void W65C816S::initCPU()
+{
+    a.q = 0x0000;
+    x.q = 0x0000;
+    y.q = 0x0000;
+    sp.q = 0x01ff;
+    d.q = 0x0000;
+    pc.q = 0x0000;
+    p = F_M | F_X | F_I;
+    e = 1;
+    pbr = 0x00;
+    dbr = 0x00;
+}
+
+// In emulation mode M and X are forced, and the stack lives in page 1.
+// With 8-bit index registers, the high bytes of X and Y are zero.
+
+void W65C816S::updateRegisterWidths()
+{
+    if (e)
+    {
+        P |= F_M | F_X;
+        sp.b.h = 0x01;
+    }
+    
+    if (P & F_X)
+    {
+        x.b.h = 0x00;
+        y.b.h = 0x00;
+    }
+}
+
+void W65C816S::updateSpecialCondition()
+{
+    isSpecialCondition = ((isIRQ && !(P & F_I)) || isResetTransition || isNMITransition ||
+                          isWaiting || isStopped);
+}
+
+// The state holds the pending cycles and the control line state, which
+// are not published as properties
+
+void W65C816S::getState(OEData *data)
+{
+    W65C816SState state;
+    
+    memset(&state, 0, sizeof(state));
+    
+    state.icount = icount;
+    state.powerState = powerState;
+    state.isReset = isReset;
+    state.isResetTransition = isResetTransition;
+    state.isIRQ = isIRQ;
+    state.isNMITransition = isNMITransition;
+    state.isWaiting = isWaiting;
+    state.isStopped = isStopped;
+    
+    OEChar *p = (OEChar *) &state;
+    
+    data->insert(data->end(), p, p + sizeof(state));
+}
+
+bool W65C816S::setState(OEData *data)
+{
+    W65C816SState state;
+    
+    if (data->size() != sizeof(state))
+        return false;
+    
+    memcpy(&state, &data->front(), sizeof(state));
+    
+    icount = state.icount;
+    powerState = state.powerState;
+    isReset = state.isReset;
+    isResetTransition = state.isResetTransition;
+    isIRQ = state.isIRQ;
+    isNMITransition = state.isNMITransition;
+    isWaiting = state.isWaiting;
+    isStopped = state.isStopped;
+    
+    updateSpecialCondition();
+    
+    return true;
+}
+
+void W65C816S::invalidatePointers()
+{
+    for (vector<OEInt>::iterator i = lookedUpPages.begin();
+         i != lookedUpPages.end();
+         i++)
+    {
+        readPointer[*i] = NULL;
+        writePointer[*i] = NULL;
+        isReadPointerStale[*i] = true;
+        isWritePointerStale[*i] = true;
+    }
+    
+    lookedUpPages.clear();
+}
+
+void W65C816S::invalidatePointers(OEAddressRange& range)
+{
+    vector<OEInt>::iterator j = lookedUpPages.begin();
+    
+    for (vector<OEInt>::iterator i = lookedUpPages.begin();
+         i != lookedUpPages.end();
+         i++)
+    {
+        OEAddress pageStart = (OEAddress) *i << 8;
+        
+        if (!isAddressRangeOverlapping(range, pageStart, pageStart + 0xff))
+        {
+            *j++ = *i;
+            
+            continue;
+        }
+        
+        readPointer[*i] = NULL;
+        writePointer[*i] = NULL;
+        isReadPointerStale[*i] = true;
+        isWritePointerStale[*i] = true;
+    }
+    
+    lookedUpPages.erase(j, lookedUpPages.end());
+}
+
+OEChar W65C816S::readMemoryBus(OEAddress address)
+{
+    OEInt page = (address >> 8) & 0xffff;
+    
+    if (isReadPointerStale[page])
+    {
+        isReadPointerStale[page] = false;
+        
+        if (isWritePointerStale[page])
+            lookedUpPages.push_back(page);
+        
+        OEChar *p = memoryBus->getReadPointer(page << 8, (page << 8) | 0xff);
+        
+        readPointer[page] = p;
+        
+        if (p)
+            return p[address & 0xff];
+    }
+    
+    return memoryBus->read(address);
+}
+
+void W65C816S::writeMemoryBus(OEAddress address, OEChar value)
+{
+    OEInt page = (address >> 8) & 0xffff;
+    
+    if (isWritePointerStale[page])
+    {
+        isWritePointerStale[page] = false;
+        
+        if (isReadPointerStale[page])
+            lookedUpPages.push_back(page);
+        
+        OEChar *p = memoryBus->getWritePointer(page << 8, (page << 8) | 0xff);
+        
+        writePointer[page] = p;
+        
+        if (p)
+        {
+            p[address & 0xff] = value;
+            
+            return;
+        }
+    }
+    
+    memoryBus->write(address, value);
+}
+
+// WAI resumes on any IRQ, but only takes it when I is clear.
+// STP waits for reset.
+
+bool W65C816S::executeSpecialCondition()
+{
+    const bool isE = (e != 0);
+    
+    if (isResetTransition)
+    {
+        isResetTransition = false;
+        isWaiting = false;
+        isStopped = false;
+        
+        e = 1;
+        P = (P | F_I) & ~F_D;
+        updateRegisterWidths();
+        D = 0x0000;
+        pbr = 0x00;
+        dbr = 0x00;
+        
+        icount -= 5;
+        PC = RDMEM16(W65C816S_RST_VECTOR_E, 0xffff);
+        
+        updateSpecialCondition();
+        
+        return true;
+    }
+    else if (isStopped)
+    {
+        if (icount > 0)
+            icount = 0;
+        
+        return true;
+    }
+    else if (isNMITransition || (isIRQ && !(P & F_I)))
+    {
+        OEInt vector;
+        
+        if (isNMITransition)
+        {
+            isNMITransition = false;
+            
+            vector = isE ? W65C816S_NMI_VECTOR_E : W65C816S_NMI_VECTOR_N;
+        }
+        else
+            vector = isE ? W65C816S_IRQ_VECTOR_E : W65C816S_IRQ_VECTOR_N;
+        
+        isWaiting = false;
+        
+        IO;
+        IO;
+        if (!isE)
+            PUSH8(pbr);
+        PUSH16(PC);
+        PUSH8(isE ? (P & ~F_B) : P);
+        P = (P | F_I) & ~F_D;
+        pbr = 0x00;
+        PC = RDMEM16(vector, 0xffff);
+        
+        updateSpecialCondition();
+        
+        return true;
+    }
+    else if (isWaiting)
+    {
+        if (!isIRQ)
+        {
+            if (icount > 0)
+                icount = 0;
+            
+            return true;
+        }
+        
+        isWaiting = false;
+    }
+    
+    updateSpecialCondition();
+    
+    return false;
+}
+
+void W65C816S::execute()
+{
+    if (powerState != CONTROLBUS_POWERSTATE_ON)
+        icount = 0;
+    
+    if (isReset)
+        icount = 0;
+    
+    while (icount > 0)
+    {
+        switch (getMode())
+        {
+            case W65C816S_MODE_E | W65C816S_MODE_M8 | W65C816S_MODE_X8:
+                executeInstructions<W65C816S_MODE_E | W65C816S_MODE_M8 | W65C816S_MODE_X8>();
+                
+                break;
+                
+            case W65C816S_MODE_M8 | W65C816S_MODE_X8:
+                executeInstructions<W65C816S_MODE_M8 | W65C816S_MODE_X8>();
+                
+                break;
+                
+            case W65C816S_MODE_M8:
+                executeInstructions<W65C816S_MODE_M8>();
+                
+                break;
+                
+            case W65C816S_MODE_X8:
+                executeInstructions<W65C816S_MODE_X8>();
+                
+                break;
+                
+            default:
+                executeInstructions<0>();
+                
+                break;
+        }
+    }
+}
+
+template <OEInt mode> void W65C816S::executeInstructions()
+{
+    W65C816S_EXECUTE(W65C816S_OPCODES);
+}
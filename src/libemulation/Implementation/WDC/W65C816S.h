@@ -1,9 +1,195 @@
-/*
- *  W65C816S.h
- *  OpenEmulator
- *
- *  Created by Marc S. Reßl on 25/02/10.
- *  Copyright 2010 ITBA. All rights reserved.
+
+/**
+ * libemulation
+ * W65C816S
+ * (C) 2012 by Marc S. Ressl (mressl@umich.edu)
+ * Released under the GPL
  *
+ * Emulates a W65C816S microprocessor
  */
 
+#ifndef _W65C816S_H
+#define _W65C816S_H
+
+#include "OEComponent.h"
+#include "ControlBusInterface.h"
+
+// Notes:
+// * Page pointers are kept for all 0x10000 pages of the 24-bit address
+//   space. Only pages that were actually looked up are reset when the
+//   memory map changes.
+// * 16-bit accesses that do not cross a page are served straight from
+//   the page pointer.
+
+#define W65C816S_PAGENUM    0x10000
+
+#if defined(__GNUC__)
+#define W65C816S_INLINE     inline __attribute__((always_inline))
+#else
+#define W65C816S_INLINE     inline
+#endif
+
+// Execution modes: emulation, or native with the M and X widths
+#define W65C816S_MODE_M8    (1 << 0)
+#define W65C816S_MODE_X8    (1 << 1)
+#define W65C816S_MODE_E     (1 << 2)
+
+typedef struct
+{
+    OESLong icount;
+    ControlBusPowerState powerState;
+    bool isReset;
+    bool isResetTransition;
+    bool isIRQ;
+    bool isNMITransition;
+    bool isWaiting;
+    bool isStopped;
+} W65C816SState;
+
+class W65C816S : public OEComponent
+{
+public:
+    W65C816S();
+    
+    bool setValue(string name, string value);
+    bool getValue(string name, string& value);
+    bool setRef(string name, OEComponent *ref);
+    bool init();
+    
+    bool postMessage(OEComponent *sender, int message, void *data);
+    
+    void notify(OEComponent *sender, int notification, void *data);
+    
+protected:
+    OEUnion a;
+    OEUnion x;
+    OEUnion y;
+    OEUnion sp;
+    OEUnion d;
+    OEUnion pc;
+    OEChar p;
+    OEChar e;
+    OEChar pbr;
+    OEChar dbr;
+    
+    OEComponent *controlBus;
+    OEComponent *memoryBus;
+    
+    ControlBusClock *controlBusClock;
+    
+    OESLong icount;
+    
+    ControlBusPowerState powerState;
+    
+    bool isReset;
+    bool isResetTransition;
+    bool isIRQ;
+    bool isNMITransition;
+    bool isWaiting;
+    bool isStopped;
+    
+    bool isSpecialCondition;
+    
+    OEChar *readPointer[W65C816S_PAGENUM];
+    OEChar *writePointer[W65C816S_PAGENUM];
+    bool isReadPointerStale[W65C816S_PAGENUM];
+    bool isWritePointerStale[W65C816S_PAGENUM];
+    vector<OEInt> lookedUpPages;
+    
+    void initCPU();
+    void updateRegisterWidths();
+    void updateSpecialCondition();
+    OEInt getMode();
+    void execute();
+    bool executeSpecialCondition();
+    
+    void getState(OEData *data);
+    bool setState(OEData *data);
+    
+    void invalidatePointers();
+    void invalidatePointers(OEAddressRange& range);
+    OEChar readMemory(OEAddress address);
+    void writeMemory(OEAddress address, OEChar value);
+    OEInt readMemory16(OEAddress address, OEAddress mask);
+    void writeMemory16(OEAddress address, OEAddress mask, OEInt value);
+    OEChar readMemoryBus(OEAddress address);
+    void writeMemoryBus(OEAddress address, OEChar value);
+    
+private:
+    template <OEInt mode> void executeInstructions();
+};
+
+// Memory accesses go through host pointers to the 256-byte page when
+// the memory bus provides one, and through the memory bus otherwise.
+// For 16-bit accesses, mask selects where the second byte wraps.
+
+W65C816S_INLINE OEChar W65C816S::readMemory(OEAddress address)
+{
+    OEChar *p = readPointer[(address >> 8) & 0xffff];
+    
+    if (p)
+        return p[address & 0xff];
+    
+    return readMemoryBus(address);
+}
+
+W65C816S_INLINE void W65C816S::writeMemory(OEAddress address, OEChar value)
+{
+    OEChar *p = writePointer[(address >> 8) & 0xffff];
+    
+    if (p)
+        p[address & 0xff] = value;
+    else
+        writeMemoryBus(address, value);
+}
+
+W65C816S_INLINE OEInt W65C816S::readMemory16(OEAddress address, OEAddress mask)
+{
+    if ((address & 0xff) != 0xff)
+    {
+        OEChar *p = readPointer[(address >> 8) & 0xffff];
+        
+        if (p)
+        {
+            p += address & 0xff;
+            
+            return p[0] | (p[1] << 8);
+        }
+    }
+    
+    OEInt value = readMemory(address);
+    
+    return value | (readMemory((address & ~mask) | ((address + 1) & mask)) << 8);
+}
+
+W65C816S_INLINE void W65C816S::writeMemory16(OEAddress address, OEAddress mask, OEInt value)
+{
+    if ((address & 0xff) != 0xff)
+    {
+        OEChar *p = writePointer[(address >> 8) & 0xffff];
+        
+        if (p)
+        {
+            p += address & 0xff;
+            
+            p[0] = value;
+            p[1] = value >> 8;
+            
+            return;
+        }
+    }
+    
+    writeMemory(address, value);
+    writeMemory((address & ~mask) | ((address + 1) & mask), value >> 8);
+}
+
+W65C816S_INLINE OEInt W65C816S::getMode()
+{
+    if (e)
+        return W65C816S_MODE_E | W65C816S_MODE_M8 | W65C816S_MODE_X8;
+    
+    return (((p & 0x20) ? W65C816S_MODE_M8 : 0) |
+            ((p & 0x10) ? W65C816S_MODE_X8 : 0));
+}
+
+#endif
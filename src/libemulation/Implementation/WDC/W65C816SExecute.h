@@ -0,0 +1,85 @@
+
+/**
+ * libemulation
+ * W65C816S Execute
+ * (C) 2012 by Marc S. Ressl (mressl@umich.edu)
+ * Released under the GPL
+ *
+ * Implements the W65C816S execution loop
+ */
+
+// Notes:
+// * W65C816S_EXECUTE(OPCODES) expands the execution loop in the body of
+//   executeInstructions<mode>(). isE, isM8 and isX8 are derived from the
+//   mode, so each mode gets its own specialized loop; in emulation mode
+//   the loop carries no 16-bit paths at all.
+// * Opcodes that may change the mode (REP, SEP, PLP, RTI, XCE) return to
+//   execute(), which selects the loop for the new mode.
+// * With GCC and clang, opcodes are dispatched through a computed goto
+//   table, and each opcode fetches and dispatches the next one directly.
+//   Other compilers use a switch.
+// * The next opcode is dispatched directly only when no interrupt, reset,
+//   NMI, WAI or STP is pending; otherwise the loop head handles it.
+
+#define W65C816S_EXECUTE_CASE(prefix, nn) \
+    case 0x##nn: prefix##_OP##nn; break;
+    
+#define W65C816S_EXECUTE_LABELADDRESS(prefix, nn) \
+    &&op##nn,
+    
+#define W65C816S_EXECUTE_LABEL(prefix, nn) \
+    op##nn: prefix##_OP##nn; W65C816S_EXECUTE_NEXT;
+    
+#define W65C816S_EXECUTE_NEXT \
+    if ((icount > 0) && !isSpecialCondition) \
+    { \
+        opcode = RDPC; \
+        goto *opcodeLabels[opcode]; \
+    } \
+    continue;
+    
+#if defined(__GNUC__)
+
+#define W65C816S_EXECUTE_DISPATCH(OPCODES) \
+    static const void *opcodeLabels[] = \
+    { \
+        OPCODES(W65C816S_EXECUTE_LABELADDRESS) \
+    }; \
+    goto *opcodeLabels[opcode]; \
+    OPCODES(W65C816S_EXECUTE_LABEL)
+    
+#else
+
+#define W65C816S_EXECUTE_DISPATCH(OPCODES) \
+    switch (opcode) \
+    { \
+        OPCODES(W65C816S_EXECUTE_CASE) \
+    }
+    
+#endif
+
+#define W65C816S_EXECUTE(OPCODES) \
+    const bool isE = (mode & W65C816S_MODE_E) != 0; \
+    const bool isM8 = (mode & W65C816S_MODE_M8) != 0; \
+    const bool isX8 = (mode & W65C816S_MODE_X8) != 0; \
+    \
+    OEInt ea = 0; \
+    OEInt tmp = 0; \
+    OEChar opcode; \
+    \
+    while (icount > 0) \
+    { \
+        if (isSpecialCondition) \
+        { \
+            if (executeSpecialCondition()) \
+            { \
+                if (getMode() != mode) \
+                    return; \
+                \
+                continue; \
+            } \
+        } \
+        \
+        opcode = RDPC; \
+        W65C816S_EXECUTE_DISPATCH(OPCODES); \
+    }
@@ -0,0 +1,320 @@
+
+/**
+ * libemulation
+ * W65C816S Opcodes
+ * (C) 2012 by Marc S. Ressl (mressl@umich.edu)
+ * Released under the GPL
+ *
+ * Implements W65C816S opcodes
+ */
+
+#include "W65C816SOperations.h"
+
+// W65C816S_OPCODES applies OP(prefix, nn) to all opcodes in numeric order.
+// W65C816S_EXECUTE uses it for building the dispatch of each mode.
+
+#define W65C816S_OP00 { BRK;                             } /* BRK */
+#define W65C816S_OP01 { EA_IDPX; RD_M; ORA;              } /* ORA (dp,X) */
+#define W65C816S_OP02 { COP;                             } /* COP */
+#define W65C816S_OP03 { EA_SR; RD_M_DP; ORA;             } /* ORA sr,S */
+#define W65C816S_OP04 { RMW_DP(EA_DP, TSB);              } /* TSB dp */
+#define W65C816S_OP05 { EA_DP; RD_M_DP; ORA;             } /* ORA dp */
+#define W65C816S_OP06 { RMW_DP(EA_DP, ASL);              } /* ASL dp */
+#define W65C816S_OP07 { EA_IDL; RD_M; ORA;               } /* ORA [dp] */
+#define W65C816S_OP08 { PHP;                             } /* PHP */
+#define W65C816S_OP09 { RD_M_IMM; ORA;                   } /* ORA # */
+#define W65C816S_OP0a { RMW_ACC(ASL);                    } /* ASL A */
+#define W65C816S_OP0b { PHD;                             } /* PHD */
+#define W65C816S_OP0c { RMW(EA_ABS, TSB);                } /* TSB abs */
+#define W65C816S_OP0d { EA_ABS; RD_M; ORA;               } /* ORA abs */
+#define W65C816S_OP0e { RMW(EA_ABS, ASL);                } /* ASL abs */
+#define W65C816S_OP0f { EA_ABL; RD_M; ORA;               } /* ORA long */
+
+#define W65C816S_OP10 { BRA(!(P & F_N));                 } /* BPL rel */
+#define W65C816S_OP11 { EA_IDPY_R; RD_M; ORA;            } /* ORA (dp),Y */
+#define W65C816S_OP12 { EA_IDP; RD_M; ORA;               } /* ORA (dp) */
+#define W65C816S_OP13 { EA_SRY; RD_M; ORA;               } /* ORA (sr,S),Y */
+#define W65C816S_OP14 { RMW_DP(EA_DP, TRB);              } /* TRB dp */
+#define W65C816S_OP15 { EA_DPX; RD_M_DP; ORA;            } /* ORA dp,X */
+#define W65C816S_OP16 { RMW_DP(EA_DPX, ASL);             } /* ASL dp,X */
+#define W65C816S_OP17 { EA_IDLY; RD_M; ORA;              } /* ORA [dp],Y */
+#define W65C816S_OP18 { CLEAR_FLAG(F_C);                 } /* CLC */
+#define W65C816S_OP19 { EA_ABY_R; RD_M; ORA;             } /* ORA abs,Y */
+#define W65C816S_OP1a { RMW_ACC(INC);                    } /* INC A */
+#define W65C816S_OP1b { TCS;                             } /* TCS */
+#define W65C816S_OP1c { RMW(EA_ABS, TRB);                } /* TRB abs */
+#define W65C816S_OP1d { EA_ABX_R; RD_M; ORA;             } /* ORA abs,X */
+#define W65C816S_OP1e { RMW(EA_ABX_W, ASL);              } /* ASL abs,X */
+#define W65C816S_OP1f { EA_ALX; RD_M; ORA;               } /* ORA long,X */
+
+#define W65C816S_OP20 { JSR;                             } /* JSR abs */
+#define W65C816S_OP21 { EA_IDPX; RD_M; AND;              } /* AND (dp,X) */
+#define W65C816S_OP22 { JSL;                             } /* JSL long */
+#define W65C816S_OP23 { EA_SR; RD_M_DP; AND;             } /* AND sr,S */
+#define W65C816S_OP24 { EA_DP; RD_M_DP; BIT;             } /* BIT dp */
+#define W65C816S_OP25 { EA_DP; RD_M_DP; AND;             } /* AND dp */
+#define W65C816S_OP26 { RMW_DP(EA_DP, ROL);              } /* ROL dp */
+#define W65C816S_OP27 { EA_IDL; RD_M; AND;               } /* AND [dp] */
+#define W65C816S_OP28 { PLP;                             } /* PLP */
+#define W65C816S_OP29 { RD_M_IMM; AND;                   } /* AND # */
+#define W65C816S_OP2a { RMW_ACC(ROL);                    } /* ROL A */
+#define W65C816S_OP2b { PLD;                             } /* PLD */
+#define W65C816S_OP2c { EA_ABS; RD_M; BIT;               } /* BIT abs */
+#define W65C816S_OP2d { EA_ABS; RD_M; AND;               } /* AND abs */
+#define W65C816S_OP2e { RMW(EA_ABS, ROL);                } /* ROL abs */
+#define W65C816S_OP2f { EA_ABL; RD_M; AND;               } /* AND long */
+
+#define W65C816S_OP30 { BRA(P & F_N);                    } /* BMI rel */
+#define W65C816S_OP31 { EA_IDPY_R; RD_M; AND;            } /* AND (dp),Y */
+#define W65C816S_OP32 { EA_IDP; RD_M; AND;               } /* AND (dp) */
+#define W65C816S_OP33 { EA_SRY; RD_M; AND;               } /* AND (sr,S),Y */
+#define W65C816S_OP34 { EA_DPX; RD_M_DP; BIT;            } /* BIT dp,X */
+#define W65C816S_OP35 { EA_DPX; RD_M_DP; AND;            } /* AND dp,X */
+#define W65C816S_OP36 { RMW_DP(EA_DPX, ROL);             } /* ROL dp,X */
+#define W65C816S_OP37 { EA_IDLY; RD_M; AND;              } /* AND [dp],Y */
+#define W65C816S_OP38 { SET_FLAG(F_C);                   } /* SEC */
+#define W65C816S_OP39 { EA_ABY_R; RD_M; AND;             } /* AND abs,Y */
+#define W65C816S_OP3a { RMW_ACC(DEC);                    } /* DEC A */
+#define W65C816S_OP3b { TRANSFER_C(C, S);                } /* TSC */
+#define W65C816S_OP3c { EA_ABX_R; RD_M; BIT;             } /* BIT abs,X */
+#define W65C816S_OP3d { EA_ABX_R; RD_M; AND;             } /* AND abs,X */
+#define W65C816S_OP3e { RMW(EA_ABX_W, ROL);              } /* ROL abs,X */
+#define W65C816S_OP3f { EA_ALX; RD_M; AND;               } /* AND long,X */
+
+#define W65C816S_OP40 { RTI;                             } /* RTI */
+#define W65C816S_OP41 { EA_IDPX; RD_M; EOR;              } /* EOR (dp,X) */
+#define W65C816S_OP42 { RDPC;                            } /* WDM */
+#define W65C816S_OP43 { EA_SR; RD_M_DP; EOR;             } /* EOR sr,S */
+#define W65C816S_OP44 { MVP;                             } /* MVP */
+#define W65C816S_OP45 { EA_DP; RD_M_DP; EOR;             } /* EOR dp */
+#define W65C816S_OP46 { RMW_DP(EA_DP, LSR);              } /* LSR dp */
+#define W65C816S_OP47 { EA_IDL; RD_M; EOR;               } /* EOR [dp] */
+#define W65C816S_OP48 { PHA;                             } /* PHA */
+#define W65C816S_OP49 { RD_M_IMM; EOR;                   } /* EOR # */
+#define W65C816S_OP4a { RMW_ACC(LSR);                    } /* LSR A */
+#define W65C816S_OP4b { PHK;                             } /* PHK */
+#define W65C816S_OP4c { JMP;                             } /* JMP abs */
+#define W65C816S_OP4d { EA_ABS; RD_M; EOR;               } /* EOR abs */
+#define W65C816S_OP4e { RMW(EA_ABS, LSR);                } /* LSR abs */
+#define W65C816S_OP4f { EA_ABL; RD_M; EOR;               } /* EOR long */
+
+#define W65C816S_OP50 { BRA(!(P & F_V));                 } /* BVC rel */
+#define W65C816S_OP51 { EA_IDPY_R; RD_M; EOR;            } /* EOR (dp),Y */
+#define W65C816S_OP52 { EA_IDP; RD_M; EOR;               } /* EOR (dp) */
+#define W65C816S_OP53 { EA_SRY; RD_M; EOR;               } /* EOR (sr,S),Y */
+#define W65C816S_OP54 { MVN;                             } /* MVN */
+#define W65C816S_OP55 { EA_DPX; RD_M_DP; EOR;            } /* EOR dp,X */
+#define W65C816S_OP56 { RMW_DP(EA_DPX, LSR);             } /* LSR dp,X */
+#define W65C816S_OP57 { EA_IDLY; RD_M; EOR;              } /* EOR [dp],Y */
+#define W65C816S_OP58 { CLI;                             } /* CLI */
+#define W65C816S_OP59 { EA_ABY_R; RD_M; EOR;             } /* EOR abs,Y */
+#define W65C816S_OP5a { PHX_REG(Y);                      } /* PHY */
+#define W65C816S_OP5b { TRANSFER_C(D, C);                } /* TCD */
+#define W65C816S_OP5c { JML;                             } /* JML long */
+#define W65C816S_OP5d { EA_ABX_R; RD_M; EOR;             } /* EOR abs,X */
+#define W65C816S_OP5e { RMW(EA_ABX_W, LSR);              } /* LSR abs,X */
+#define W65C816S_OP5f { EA_ALX; RD_M; EOR;               } /* EOR long,X */
+
+#define W65C816S_OP60 { RTS;                             } /* RTS */
+#define W65C816S_OP61 { EA_IDPX; RD_M; ADC;              } /* ADC (dp,X) */
+#define W65C816S_OP62 { PER;                             } /* PER rel16 */
+#define W65C816S_OP63 { EA_SR; RD_M_DP; ADC;             } /* ADC sr,S */
+#define W65C816S_OP64 { EA_DP; STZ; WR_M_DP;             } /* STZ dp */
+#define W65C816S_OP65 { EA_DP; RD_M_DP; ADC;             } /* ADC dp */
+#define W65C816S_OP66 { RMW_DP(EA_DP, ROR);              } /* ROR dp */
+#define W65C816S_OP67 { EA_IDL; RD_M; ADC;               } /* ADC [dp] */
+#define W65C816S_OP68 { PLA;                             } /* PLA */
+#define W65C816S_OP69 { RD_M_IMM; ADC;                   } /* ADC # */
+#define W65C816S_OP6a { RMW_ACC(ROR);                    } /* ROR A */
+#define W65C816S_OP6b { RTL;                             } /* RTL */
+#define W65C816S_OP6c { JMP_IND;                         } /* JMP (abs) */
+#define W65C816S_OP6d { EA_ABS; RD_M; ADC;               } /* ADC abs */
+#define W65C816S_OP6e { RMW(EA_ABS, ROR);                } /* ROR abs */
+#define W65C816S_OP6f { EA_ABL; RD_M; ADC;               } /* ADC long */
+
+#define W65C816S_OP70 { BRA(P & F_V);                    } /* BVS rel */
+#define W65C816S_OP71 { EA_IDPY_R; RD_M; ADC;            } /* ADC (dp),Y */
+#define W65C816S_OP72 { EA_IDP; RD_M; ADC;               } /* ADC (dp) */
+#define W65C816S_OP73 { EA_SRY; RD_M; ADC;               } /* ADC (sr,S),Y */
+#define W65C816S_OP74 { EA_DPX; STZ; WR_M_DP;            } /* STZ dp,X */
+#define W65C816S_OP75 { EA_DPX; RD_M_DP; ADC;            } /* ADC dp,X */
+#define W65C816S_OP76 { RMW_DP(EA_DPX, ROR);             } /* ROR dp,X */
+#define W65C816S_OP77 { EA_IDLY; RD_M; ADC;              } /* ADC [dp],Y */
+#define W65C816S_OP78 { SET_FLAG(F_I);                   } /* SEI */
+#define W65C816S_OP79 { EA_ABY_R; RD_M; ADC;             } /* ADC abs,Y */
+#define W65C816S_OP7a { PLX_REG(Y);                      } /* PLY */
+#define W65C816S_OP7b { TRANSFER_C(C, D);                } /* TDC */
+#define W65C816S_OP7c { JMP_IDX;                         } /* JMP (abs,X) */
+#define W65C816S_OP7d { EA_ABX_R; RD_M; ADC;             } /* ADC abs,X */
+#define W65C816S_OP7e { RMW(EA_ABX_W, ROR);              } /* ROR abs,X */
+#define W65C816S_OP7f { EA_ALX; RD_M; ADC;               } /* ADC long,X */
+
+#define W65C816S_OP80 { BRA(true);                       } /* BRA rel */
+#define W65C816S_OP81 { EA_IDPX; STA; WR_M;              } /* STA (dp,X) */
+#define W65C816S_OP82 { BRL;                             } /* BRL rel16 */
+#define W65C816S_OP83 { EA_SR; STA; WR_M_DP;             } /* STA sr,S */
+#define W65C816S_OP84 { EA_DP; STY; WR_X_DP;             } /* STY dp */
+#define W65C816S_OP85 { EA_DP; STA; WR_M_DP;             } /* STA dp */
+#define W65C816S_OP86 { EA_DP; STX; WR_X_DP;             } /* STX dp */
+#define W65C816S_OP87 { EA_IDL; STA; WR_M;               } /* STA [dp] */
+#define W65C816S_OP88 { DEY;                             } /* DEY */
+#define W65C816S_OP89 { RD_M_IMM; BIT_IMM;               } /* BIT # */
+#define W65C816S_OP8a { TRANSFER_M(X);                   } /* TXA */
+#define W65C816S_OP8b { PHB;                             } /* PHB */
+#define W65C816S_OP8c { EA_ABS; STY; WR_X;               } /* STY abs */
+#define W65C816S_OP8d { EA_ABS; STA; WR_M;               } /* STA abs */
+#define W65C816S_OP8e { EA_ABS; STX; WR_X;               } /* STX abs */
+#define W65C816S_OP8f { EA_ABL; STA; WR_M;               } /* STA long */
+
+#define W65C816S_OP90 { BRA(!(P & F_C));                 } /* BCC rel */
+#define W65C816S_OP91 { EA_IDPY_W; STA; WR_M;            } /* STA (dp),Y */
+#define W65C816S_OP92 { EA_IDP; STA; WR_M;               } /* STA (dp) */
+#define W65C816S_OP93 { EA_SRY; STA; WR_M;               } /* STA (sr,S),Y */
+#define W65C816S_OP94 { EA_DPX; STY; WR_X_DP;            } /* STY dp,X */
+#define W65C816S_OP95 { EA_DPX; STA; WR_M_DP;            } /* STA dp,X */
+#define W65C816S_OP96 { EA_DPY; STX; WR_X_DP;            } /* STX dp,Y */
+#define W65C816S_OP97 { EA_IDLY; STA; WR_M;              } /* STA [dp],Y */
+#define W65C816S_OP98 { TRANSFER_M(Y);                   } /* TYA */
+#define W65C816S_OP99 { EA_ABY_W; STA; WR_M;             } /* STA abs,Y */
+#define W65C816S_OP9a { TXS;                             } /* TXS */
+#define W65C816S_OP9b { TRANSFER_X(Y, X);                } /* TXY */
+#define W65C816S_OP9c { EA_ABS; STZ; WR_M;               } /* STZ abs */
+#define W65C816S_OP9d { EA_ABX_W; STA; WR_M;             } /* STA abs,X */
+#define W65C816S_OP9e { EA_ABX_W; STZ; WR_M;             } /* STZ abs,X */
+#define W65C816S_OP9f { EA_ALX; STA; WR_M;               } /* STA long,X */
+
+#define W65C816S_OPa0 { RD_X_IMM; LDY;                   } /* LDY # */
+#define W65C816S_OPa1 { EA_IDPX; RD_M; LDA;              } /* LDA (dp,X) */
+#define W65C816S_OPa2 { RD_X_IMM; LDX;                   } /* LDX # */
+#define W65C816S_OPa3 { EA_SR; RD_M_DP; LDA;             } /* LDA sr,S */
+#define W65C816S_OPa4 { EA_DP; RD_X_DP; LDY;             } /* LDY dp */
+#define W65C816S_OPa5 { EA_DP; RD_M_DP; LDA;             } /* LDA dp */
+#define W65C816S_OPa6 { EA_DP; RD_X_DP; LDX;             } /* LDX dp */
+#define W65C816S_OPa7 { EA_IDL; RD_M; LDA;               } /* LDA [dp] */
+#define W65C816S_OPa8 { TRANSFER_X(Y, C);                } /* TAY */
+#define W65C816S_OPa9 { RD_M_IMM; LDA;                   } /* LDA # */
+#define W65C816S_OPaa { TRANSFER_X(X, C);                } /* TAX */
+#define W65C816S_OPab { PLB;                             } /* PLB */
+#define W65C816S_OPac { EA_ABS; RD_X; LDY;               } /* LDY abs */
+#define W65C816S_OPad { EA_ABS; RD_M; LDA;               } /* LDA abs */
+#define W65C816S_OPae { EA_ABS; RD_X; LDX;               } /* LDX abs */
+#define W65C816S_OPaf { EA_ABL; RD_M; LDA;               } /* LDA long */
+
+#define W65C816S_OPb0 { BRA(P & F_C);                    } /* BCS rel */
+#define W65C816S_OPb1 { EA_IDPY_R; RD_M; LDA;            } /* LDA (dp),Y */
+#define W65C816S_OPb2 { EA_IDP; RD_M; LDA;               } /* LDA (dp) */
+#define W65C816S_OPb3 { EA_SRY; RD_M; LDA;               } /* LDA (sr,S),Y */
+#define W65C816S_OPb4 { EA_DPX; RD_X_DP; LDY;            } /* LDY dp,X */
+#define W65C816S_OPb5 { EA_DPX; RD_M_DP; LDA;            } /* LDA dp,X */
+#define W65C816S_OPb6 { EA_DPY; RD_X_DP; LDX;            } /* LDX dp,Y */
+#define W65C816S_OPb7 { EA_IDLY; RD_M; LDA;              } /* LDA [dp],Y */
+#define W65C816S_OPb8 { CLEAR_FLAG(F_V);                 } /* CLV */
+#define W65C816S_OPb9 { EA_ABY_R; RD_M; LDA;             } /* LDA abs,Y */
+#define W65C816S_OPba { TRANSFER_X(X, S);                } /* TSX */
+#define W65C816S_OPbb { TRANSFER_X(X, Y);                } /* TYX */
+#define W65C816S_OPbc { EA_ABX_R; RD_X; LDY;             } /* LDY abs,X */
+#define W65C816S_OPbd { EA_ABX_R; RD_M; LDA;             } /* LDA abs,X */
+#define W65C816S_OPbe { EA_ABY_R; RD_X; LDX;             } /* LDX abs,Y */
+#define W65C816S_OPbf { EA_ALX; RD_M; LDA;               } /* LDA long,X */
+
+#define W65C816S_OPc0 { RD_X_IMM; CPY;                   } /* CPY # */
+#define W65C816S_OPc1 { EA_IDPX; RD_M; CMP;              } /* CMP (dp,X) */
+#define W65C816S_OPc2 { REP;                             } /* REP # */
+#define W65C816S_OPc3 { EA_SR; RD_M_DP; CMP;             } /* CMP sr,S */
+#define W65C816S_OPc4 { EA_DP; RD_X_DP; CPY;             } /* CPY dp */
+#define W65C816S_OPc5 { EA_DP; RD_M_DP; CMP;             } /* CMP dp */
+#define W65C816S_OPc6 { RMW_DP(EA_DP, DEC);              } /* DEC dp */
+#define W65C816S_OPc7 { EA_IDL; RD_M; CMP;               } /* CMP [dp] */
+#define W65C816S_OPc8 { INY;                             } /* INY */
+#define W65C816S_OPc9 { RD_M_IMM; CMP;                   } /* CMP # */
+#define W65C816S_OPca { DEX;                             } /* DEX */
+#define W65C816S_OPcb { WAI;                             } /* WAI */
+#define W65C816S_OPcc { EA_ABS; RD_X; CPY;               } /* CPY abs */
+#define W65C816S_OPcd { EA_ABS; RD_M; CMP;               } /* CMP abs */
+#define W65C816S_OPce { RMW(EA_ABS, DEC);                } /* DEC abs */
+#define W65C816S_OPcf { EA_ABL; RD_M; CMP;               } /* CMP long */
+
+#define W65C816S_OPd0 { BRA(!(P & F_Z));                 } /* BNE rel */
+#define W65C816S_OPd1 { EA_IDPY_R; RD_M; CMP;            } /* CMP (dp),Y */
+#define W65C816S_OPd2 { EA_IDP; RD_M; CMP;               } /* CMP (dp) */
+#define W65C816S_OPd3 { EA_SRY; RD_M; CMP;               } /* CMP (sr,S),Y */
+#define W65C816S_OPd4 { PEI;                             } /* PEI (dp) */
+#define W65C816S_OPd5 { EA_DPX; RD_M_DP; CMP;            } /* CMP dp,X */
+#define W65C816S_OPd6 { RMW_DP(EA_DPX, DEC);             } /* DEC dp,X */
+#define W65C816S_OPd7 { EA_IDLY; RD_M; CMP;              } /* CMP [dp],Y */
+#define W65C816S_OPd8 { CLEAR_FLAG(F_D);                 } /* CLD */
+#define W65C816S_OPd9 { EA_ABY_R; RD_M; CMP;             } /* CMP abs,Y */
+#define W65C816S_OPda { PHX_REG(X);                      } /* PHX */
+#define W65C816S_OPdb { STP;                             } /* STP */
+#define W65C816S_OPdc { JML_IND;                         } /* JML [abs] */
+#define W65C816S_OPdd { EA_ABX_R; RD_M; CMP;             } /* CMP abs,X */
+#define W65C816S_OPde { RMW(EA_ABX_W, DEC);              } /* DEC abs,X */
+#define W65C816S_OPdf { EA_ALX; RD_M; CMP;               } /* CMP long,X */
+
+#define W65C816S_OPe0 { RD_X_IMM; CPX;                   } /* CPX # */
+#define W65C816S_OPe1 { EA_IDPX; RD_M; SBC;              } /* SBC (dp,X) */
+#define W65C816S_OPe2 { SEP;                             } /* SEP # */
+#define W65C816S_OPe3 { EA_SR; RD_M_DP; SBC;             } /* SBC sr,S */
+#define W65C816S_OPe4 { EA_DP; RD_X_DP; CPX;             } /* CPX dp */
+#define W65C816S_OPe5 { EA_DP; RD_M_DP; SBC;             } /* SBC dp */
+#define W65C816S_OPe6 { RMW_DP(EA_DP, INC);              } /* INC dp */
+#define W65C816S_OPe7 { EA_IDL; RD_M; SBC;               } /* SBC [dp] */
+#define W65C816S_OPe8 { INX;                             } /* INX */
+#define W65C816S_OPe9 { RD_M_IMM; SBC;                   } /* SBC # */
+#define W65C816S_OPea { IO;                              } /* NOP */
+#define W65C816S_OPeb { XBA;                             } /* XBA */
+#define W65C816S_OPec { EA_ABS; RD_X; CPX;               } /* CPX abs */
+#define W65C816S_OPed { EA_ABS; RD_M; SBC;               } /* SBC abs */
+#define W65C816S_OPee { RMW(EA_ABS, INC);                } /* INC abs */
+#define W65C816S_OPef { EA_ABL; RD_M; SBC;               } /* SBC long */
+
+#define W65C816S_OPf0 { BRA(P & F_Z);                    } /* BEQ rel */
+#define W65C816S_OPf1 { EA_IDPY_R; RD_M; SBC;            } /* SBC (dp),Y */
+#define W65C816S_OPf2 { EA_IDP; RD_M; SBC;               } /* SBC (dp) */
+#define W65C816S_OPf3 { EA_SRY; RD_M; SBC;               } /* SBC (sr,S),Y */
+#define W65C816S_OPf4 { PEA;                             } /* PEA abs */
+#define W65C816S_OPf5 { EA_DPX; RD_M_DP; SBC;            } /* SBC dp,X */
+#define W65C816S_OPf6 { RMW_DP(EA_DPX, INC);             } /* INC dp,X */
+#define W65C816S_OPf7 { EA_IDLY; RD_M; SBC;              } /* SBC [dp],Y */
+#define W65C816S_OPf8 { SET_FLAG(F_D);                   } /* SED */
+#define W65C816S_OPf9 { EA_ABY_R; RD_M; SBC;             } /* SBC abs,Y */
+#define W65C816S_OPfa { PLX_REG(X);                      } /* PLX */
+#define W65C816S_OPfb { XCE;                             } /* XCE */
+#define W65C816S_OPfc { JSR_IDX;                         } /* JSR (abs,X) */
+#define W65C816S_OPfd { EA_ABX_R; RD_M; SBC;             } /* SBC abs,X */
+#define W65C816S_OPfe { RMW(EA_ABX_W, INC);              } /* INC abs,X */
+#define W65C816S_OPff { EA_ALX; RD_M; SBC;               } /* SBC long,X */
+
+#define W65C816S_OPCODES(OP) \
+    OP(W65C816S, 00) OP(W65C816S, 01) OP(W65C816S, 02) OP(W65C816S, 03) OP(W65C816S, 04) OP(W65C816S, 05) OP(W65C816S, 06) OP(W65C816S, 07) \
+    OP(W65C816S, 08) OP(W65C816S, 09) OP(W65C816S, 0a) OP(W65C816S, 0b) OP(W65C816S, 0c) OP(W65C816S, 0d) OP(W65C816S, 0e) OP(W65C816S, 0f) \
+    OP(W65C816S, 10) OP(W65C816S, 11) OP(W65C816S, 12) OP(W65C816S, 13) OP(W65C816S, 14) OP(W65C816S, 15) OP(W65C816S, 16) OP(W65C816S, 17) \
+    OP(W65C816S, 18) OP(W65C816S, 19) OP(W65C816S, 1a) OP(W65C816S, 1b) OP(W65C816S, 1c) OP(W65C816S, 1d) OP(W65C816S, 1e) OP(W65C816S, 1f) \
+    OP(W65C816S, 20) OP(W65C816S, 21) OP(W65C816S, 22) OP(W65C816S, 23) OP(W65C816S, 24) OP(W65C816S, 25) OP(W65C816S, 26) OP(W65C816S, 27) \
+    OP(W65C816S, 28) OP(W65C816S, 29) OP(W65C816S, 2a) OP(W65C816S, 2b) OP(W65C816S, 2c) OP(W65C816S, 2d) OP(W65C816S, 2e) OP(W65C816S, 2f) \
+    OP(W65C816S, 30) OP(W65C816S, 31) OP(W65C816S, 32) OP(W65C816S, 33) OP(W65C816S, 34) OP(W65C816S, 35) OP(W65C816S, 36) OP(W65C816S, 37) \
+    OP(W65C816S, 38) OP(W65C816S, 39) OP(W65C816S, 3a) OP(W65C816S, 3b) OP(W65C816S, 3c) OP(W65C816S, 3d) OP(W65C816S, 3e) OP(W65C816S, 3f) \
+    OP(W65C816S, 40) OP(W65C816S, 41) OP(W65C816S, 42) OP(W65C816S, 43) OP(W65C816S, 44) OP(W65C816S, 45) OP(W65C816S, 46) OP(W65C816S, 47) \
+    OP(W65C816S, 48) OP(W65C816S, 49) OP(W65C816S, 4a) OP(W65C816S, 4b) OP(W65C816S, 4c) OP(W65C816S, 4d) OP(W65C816S, 4e) OP(W65C816S, 4f) \
+    OP(W65C816S, 50) OP(W65C816S, 51) OP(W65C816S, 52) OP(W65C816S, 53) OP(W65C816S, 54) OP(W65C816S, 55) OP(W65C816S, 56) OP(W65C816S, 57) \
+    OP(W65C816S, 58) OP(W65C816S, 59) OP(W65C816S, 5a) OP(W65C816S, 5b) OP(W65C816S, 5c) OP(W65C816S, 5d) OP(W65C816S, 5e) OP(W65C816S, 5f) \
+    OP(W65C816S, 60) OP(W65C816S, 61) OP(W65C816S, 62) OP(W65C816S, 63) OP(W65C816S, 64) OP(W65C816S, 65) OP(W65C816S, 66) OP(W65C816S, 67) \
+    OP(W65C816S, 68) OP(W65C816S, 69) OP(W65C816S, 6a) OP(W65C816S, 6b) OP(W65C816S, 6c) OP(W65C816S, 6d) OP(W65C816S, 6e) OP(W65C816S, 6f) \
+    OP(W65C816S, 70) OP(W65C816S, 71) OP(W65C816S, 72) OP(W65C816S, 73) OP(W65C816S, 74) OP(W65C816S, 75) OP(W65C816S, 76) OP(W65C816S, 77) \
+    OP(W65C816S, 78) OP(W65C816S, 79) OP(W65C816S, 7a) OP(W65C816S, 7b) OP(W65C816S, 7c) OP(W65C816S, 7d) OP(W65C816S, 7e) OP(W65C816S, 7f) \
+    OP(W65C816S, 80) OP(W65C816S, 81) OP(W65C816S, 82) OP(W65C816S, 83) OP(W65C816S, 84) OP(W65C816S, 85) OP(W65C816S, 86) OP(W65C816S, 87) \
+    OP(W65C816S, 88) OP(W65C816S, 89) OP(W65C816S, 8a) OP(W65C816S, 8b) OP(W65C816S, 8c) OP(W65C816S, 8d) OP(W65C816S, 8e) OP(W65C816S, 8f) \
+    OP(W65C816S, 90) OP(W65C816S, 91) OP(W65C816S, 92) OP(W65C816S, 93) OP(W65C816S, 94) OP(W65C816S, 95) OP(W65C816S, 96) OP(W65C816S, 97) \
+    OP(W65C816S, 98) OP(W65C816S, 99) OP(W65C816S, 9a) OP(W65C816S, 9b) OP(W65C816S, 9c) OP(W65C816S, 9d) OP(W65C816S, 9e) OP(W65C816S, 9f) \
+    OP(W65C816S, a0) OP(W65C816S, a1) OP(W65C816S, a2) OP(W65C816S, a3) OP(W65C816S, a4) OP(W65C816S, a5) OP(W65C816S, a6) OP(W65C816S, a7) \
+    OP(W65C816S, a8) OP(W65C816S, a9) OP(W65C816S, aa) OP(W65C816S, ab) OP(W65C816S, ac) OP(W65C816S, ad) OP(W65C816S, ae) OP(W65C816S, af) \
+    OP(W65C816S, b0) OP(W65C816S, b1) OP(W65C816S, b2) OP(W65C816S, b3) OP(W65C816S, b4) OP(W65C816S, b5) OP(W65C816S, b6) OP(W65C816S, b7) \
+    OP(W65C816S, b8) OP(W65C816S, b9) OP(W65C816S, ba) OP(W65C816S, bb) OP(W65C816S, bc) OP(W65C816S, bd) OP(W65C816S, be) OP(W65C816S, bf) \
+    OP(W65C816S, c0) OP(W65C816S, c1) OP(W65C816S, c2) OP(W65C816S, c3) OP(W65C816S, c4) OP(W65C816S, c5) OP(W65C816S, c6) OP(W65C816S, c7) \
+    OP(W65C816S, c8) OP(W65C816S, c9) OP(W65C816S, ca) OP(W65C816S, cb) OP(W65C816S, cc) OP(W65C816S, cd) OP(W65C816S, ce) OP(W65C816S, cf) \
+    OP(W65C816S, d0) OP(W65C816S, d1) OP(W65C816S, d2) OP(W65C816S, d3) OP(W65C816S, d4) OP(W65C816S, d5) OP(W65C816S, d6) OP(W65C816S, d7) \
+    OP(W65C816S, d8) OP(W65C816S, d9) OP(W65C816S, da) OP(W65C816S, db) OP(W65C816S, dc) OP(W65C816S, dd) OP(W65C816S, de) OP(W65C816S, df) \
+    OP(W65C816S, e0) OP(W65C816S, e1) OP(W65C816S, e2) OP(W65C816S, e3) OP(W65C816S, e4) OP(W65C816S, e5) OP(W65C816S, e6) OP(W65C816S, e7) \
+    OP(W65C816S, e8) OP(W65C816S, e9) OP(W65C816S, ea) OP(W65C816S, eb) OP(W65C816S, ec) OP(W65C816S, ed) OP(W65C816S, ee) OP(W65C816S, ef) \
+    OP(W65C816S, f0) OP(W65C816S, f1) OP(W65C816S, f2) OP(W65C816S, f3) OP(W65C816S, f4) OP(W65C816S, f5) OP(W65C816S, f6) OP(W65C816S, f7) \
+    OP(W65C816S, f8) OP(W65C816S, f9) OP(W65C816S, fa) OP(W65C816S, fb) OP(W65C816S, fc) OP(W65C816S, fd) OP(W65C816S, fe) OP(W65C816S, ff)
@@ -0,0 +1,924 @@
+
+/**
+ * libemulation
+ * W65C816S Operations
+ * (C) 2012 by Marc S. Ressl (mressl@umich.edu)
+ * Released under the GPL
+ *
+ * Implements W65C816S operations
+ */
+
+// Notes:
+// * Operations are expanded in W65C816S::executeInstructions<mode>(),
+//   where isE, isM8 and isX8 are compile-time constants. Width checks
+//   are thus resolved by the compiler for each mode.
+// * One cycle is counted for each bus access, and IO counts internal
+//   operation cycles.
+// * ea holds 24-bit effective addresses. Direct page and stack accesses
+//   wrap in bank 0, other data accesses wrap at 24 bits.
+
+/* Interrupt vectors */
+#define W65C816S_COP_VECTOR_N   0xffe4
+#define W65C816S_BRK_VECTOR_N   0xffe6
+#define W65C816S_NMI_VECTOR_N   0xffea
+#define W65C816S_IRQ_VECTOR_N   0xffee
+#define W65C816S_COP_VECTOR_E   0xfff4
+#define W65C816S_NMI_VECTOR_E   0xfffa
+#define W65C816S_RST_VECTOR_E   0xfffc
+#define W65C816S_IRQ_VECTOR_E   0xfffe
+
+/* 65816 flags */
+#define F_C 0x01
+#define F_Z 0x02
+#define F_I 0x04
+#define F_D 0x08
+#define F_X 0x10
+#define F_M 0x20
+#define F_V 0x40
+#define F_N 0x80
+
+/* emulation mode flags */
+#define F_B 0x10
+
+/* some shortcuts for improved readability */
+#define A   a.b.l
+#define B   a.b.h
+#define C   a.w.l
+#define X   x.w.l
+#define Y   y.w.l
+#define S   sp.w.l
+#define D   d.w.l
+#define DL  d.b.l
+#define P   p
+#define PC  pc.w.l
+
+#define PBR24   ((OEInt)pbr << 16)
+#define DBR24   ((OEInt)dbr << 16)
+
+#define MMASK   (isM8 ? 0xff : 0xffff)
+#define MSIGN   (isM8 ? 0x80 : 0x8000)
+#define XMASK   (isX8 ? 0xff : 0xffff)
+
+#define ACC     (isM8 ? (OEInt)A : (OEInt)C)
+
+#define SET_ACC(v)                                              \
+    {                                                           \
+        if (isM8)                                               \
+            A = (v);                                            \
+        else                                                    \
+            C = (v);                                            \
+    }
+    
+#define SET_NZ8(n)                                              \
+    P = (P & ~(F_N | F_Z)) | ((n) & F_N) | (((n) & 0xff) ? 0 : F_Z)
+    
+#define SET_NZ16(n)                                             \
+    P = (P & ~(F_N | F_Z)) | (((n) >> 8) & F_N) | (((n) & 0xffff) ? 0 : F_Z)
+    
+#define SET_NZ_M(n)                                             \
+    {                                                           \
+        if (isM8)                                               \
+            SET_NZ8(n);                                         \
+        else                                                    \
+            SET_NZ16(n);                                        \
+    }
+    
+#define SET_NZ_X(n)                                             \
+    {                                                           \
+        if (isX8)                                               \
+            SET_NZ8(n);                                         \
+        else                                                    \
+            SET_NZ16(n);                                        \
+    }
+    
+#define SET_Z(n)                                                \
+    if (n) P &= ~F_Z; else P |= F_Z
+    
+/***************************************************************
+ *  bus cycles
+ ***************************************************************/
+#define IO                  icount--
+
+#define RDMEM(addr)         (icount--, readMemory(addr))
+#define RDMEM16(addr, mask) (icount -= 2, readMemory16(addr, mask))
+
+#define WRMEM(addr, value)                                      \
+    {                                                           \
+        icount--;                                               \
+        writeMemory(addr, value);                               \
+    }
+    
+#define WRMEM16(addr, mask, value)                              \
+    {                                                           \
+        icount -= 2;                                            \
+        writeMemory16(addr, mask, value);                       \
+    }
+    
+/***************************************************************
+ *  program stream
+ ***************************************************************/
+#define RDPC                RDMEM(PBR24 | PC++)
+#define RDPC16              (PC += 2, RDMEM16(PBR24 | ((PC - 2) & 0xffff), 0xffff))
+
+/***************************************************************
+ *  data reads and writes of M and X width
+ *  _DP variants wrap in bank 0
+ ***************************************************************/
+#define RD_M                tmp = isM8 ? RDMEM(ea) : RDMEM16(ea, 0xffffff)
+#define RD_M_DP             tmp = isM8 ? RDMEM(ea) : RDMEM16(ea, 0xffff)
+#define RD_X                tmp = isX8 ? RDMEM(ea) : RDMEM16(ea, 0xffffff)
+#define RD_X_DP             tmp = isX8 ? RDMEM(ea) : RDMEM16(ea, 0xffff)
+#define RD_M_IMM            tmp = isM8 ? RDPC : RDPC16
+#define RD_X_IMM            tmp = isX8 ? RDPC : RDPC16
+
+#define WR_M                                                    \
+    {                                                           \
+        if (isM8)                                               \
+            WRMEM(ea, tmp)                                      \
+        else                                                    \
+            WRMEM16(ea, 0xffffff, tmp)                          \
+    }
+    
+#define WR_M_DP                                                 \
+    {                                                           \
+        if (isM8)                                               \
+            WRMEM(ea, tmp)                                      \
+        else                                                    \
+            WRMEM16(ea, 0xffff, tmp)                            \
+    }
+    
+#define WR_X                                                    \
+    {                                                           \
+        if (isX8)                                               \
+            WRMEM(ea, tmp)                                      \
+        else                                                    \
+            WRMEM16(ea, 0xffffff, tmp)                          \
+    }
+    
+#define WR_X_DP                                                 \
+    {                                                           \
+        if (isX8)                                               \
+            WRMEM(ea, tmp)                                      \
+        else                                                    \
+            WRMEM16(ea, 0xffff, tmp)                            \
+    }
+    
+/***************************************************************
+ *  direct page
+ *  in emulation mode with DL = 0, direct page wraps in its page
+ ***************************************************************/
+#define DP_ISPAGEWRAP       (isE && !DL)
+#define DP_PENALTY          if (DL) IO
+#define DPADDR(o)           (DP_ISPAGEWRAP ? (D | ((o) & 0xff)) : ((D + (o)) & 0xffff))
+#define DPMASK              (DP_ISPAGEWRAP ? 0xff : 0xffff)
+
+/***************************************************************
+ *  effective addresses
+ *  _R variants take the extra cycle only when an 8-bit index
+ *  crosses a page, _W variants always take it
+ ***************************************************************/
+#define EA_DP                                                   \
+    {                                                           \
+        OEInt o = RDPC;                                         \
+        DP_PENALTY;                                             \
+        ea = DPADDR(o);                                         \
+    }
+    
+#define EA_DPX                                                  \
+    {                                                           \
+        OEInt o = RDPC;                                         \
+        DP_PENALTY;                                             \
+        IO;                                                     \
+        ea = DPADDR(o + X);                                     \
+    }
+    
+#define EA_DPY                                                  \
+    {                                                           \
+        OEInt o = RDPC;                                         \
+        DP_PENALTY;                                             \
+        IO;                                                     \
+        ea = DPADDR(o + Y);                                     \
+    }
+    
+#define EA_SR                                                   \
+    {                                                           \
+        OEInt o = RDPC;                                         \
+        IO;                                                     \
+        ea = (S + o) & 0xffff;                                  \
+    }
+    
+#define EA_SRY                                                  \
+    {                                                           \
+        OEInt o = RDPC;                                         \
+        IO;                                                     \
+        OEInt base = RDMEM16((S + o) & 0xffff, 0xffff);         \
+        IO;                                                     \
+        ea = (DBR24 + base + Y) & 0xffffff;                     \
+    }
+    
+#define EA_ABS                                                  \
+    ea = DBR24 | RDPC16
+    
+#define EA_IDX_R(index)                                         \
+    {                                                           \
+        OEInt base = RDPC16;                                    \
+        if (!isX8 || ((base ^ (base + index)) & 0xff00))        \
+            IO;                                                 \
+        ea = (DBR24 + base + index) & 0xffffff;                 \
+    }
+    
+#define EA_IDX_W(index)                                         \
+    {                                                           \
+        OEInt base = RDPC16;                                    \
+        IO;                                                     \
+        ea = (DBR24 + base + index) & 0xffffff;                 \
+    }
+    
+#define EA_ABX_R            EA_IDX_R(X)
+#define EA_ABX_W            EA_IDX_W(X)
+#define EA_ABY_R            EA_IDX_R(Y)
+#define EA_ABY_W            EA_IDX_W(Y)
+
+#define EA_ABL                                                  \
+    {                                                           \
+        ea = RDPC16;                                            \
+        ea |= RDPC << 16;                                       \
+    }
+    
+#define EA_ALX                                                  \
+    {                                                           \
+        EA_ABL;                                                 \
+        ea = (ea + X) & 0xffffff;                               \
+    }
+    
+#define EA_IDP                                                  \
+    {                                                           \
+        OEInt o = RDPC;                                         \
+        DP_PENALTY;                                             \
+        ea = DBR24 | RDMEM16(DPADDR(o), DPMASK);                \
+    }
+    
+#define EA_IDPX                                                 \
+    {                                                           \
+        OEInt o = RDPC;                                         \
+        DP_PENALTY;                                             \
+        IO;                                                     \
+        ea = DBR24 | RDMEM16(DPADDR(o + X), DPMASK);            \
+    }
+    
+#define EA_IDPY_R                                               \
+    {                                                           \
+        OEInt o = RDPC;                                         \
+        DP_PENALTY;                                             \
+        OEInt base = RDMEM16(DPADDR(o), DPMASK);                \
+        if (!isX8 || ((base ^ (base + Y)) & 0xff00))            \
+            IO;                                                 \
+        ea = (DBR24 + base + Y) & 0xffffff;                     \
+    }
+    
+#define EA_IDPY_W                                               \
+    {                                                           \
+        OEInt o = RDPC;                                         \
+        DP_PENALTY;                                             \
+        OEInt base = RDMEM16(DPADDR(o), DPMASK);                \
+        IO;                                                     \
+        ea = (DBR24 + base + Y) & 0xffffff;                     \
+    }
+    
+#define EA_IDL                                                  \
+    {                                                           \
+        OEInt o = RDPC;                                         \
+        DP_PENALTY;                                             \
+        OEInt ptr = (D + o) & 0xffff;                           \
+        ea = RDMEM16(ptr, 0xffff);                              \
+        ea |= RDMEM((ptr + 2) & 0xffff) << 16;                  \
+    }
+    
+#define EA_IDLY                                                 \
+    {                                                           \
+        EA_IDL;                                                 \
+        ea = (ea + Y) & 0xffffff;                               \
+    }
+    
+/***************************************************************
+ *  stack
+ *  in emulation mode, the stack wraps in page 1
+ ***************************************************************/
+#define PUSH8(v)                                                \
+    {                                                           \
+        WRMEM(S, v);                                            \
+        if (isE)                                                \
+            sp.b.l--;                                           \
+        else                                                    \
+            S--;                                                \
+    }
+    
+#define PUSH16(v)                                               \
+    {                                                           \
+        OEInt value = (v);                                      \
+        PUSH8(value >> 8);                                      \
+        PUSH8(value & 0xff);                                    \
+    }
+    
+#define PULL8(v)                                                \
+    {                                                           \
+        if (isE)                                                \
+            sp.b.l++;                                           \
+        else                                                    \
+            S++;                                                \
+        v = RDMEM(S);                                           \
+    }
+    
+#define PULL16(v)                                               \
+    {                                                           \
+        OEInt lo, hi;                                           \
+        PULL8(lo);                                              \
+        PULL8(hi);                                              \
+        v = lo | (hi << 8);                                     \
+    }
+    
+/***************************************************************
+ *  mode changes
+ *  returns to W65C816S::execute(), which selects the loop
+ *  specialized for the new mode
+ ***************************************************************/
+#define CHECK_MODE                                              \
+    updateRegisterWidths();                                     \
+    updateSpecialCondition();                                   \
+    if (getMode() != mode)                                      \
+        return
+        
+/***************************************************************
+ *  ADC/SBC
+ *  SBC adds the inverted value. In decimal mode, digits are
+ *  adjusted one nibble at a time; V is taken before the adjust
+ *  of the last digit, like on the chip.
+ ***************************************************************/
+static W65C816S_INLINE OEInt W65C816SAdd(OEChar& p, OEInt a, OEInt value,
+                                         OEInt bits, bool isSubtract)
+{
+    OEInt mask = (1 << bits) - 1;
+    OEInt sign = 1 << (bits - 1);
+    OEInt c = p & F_C;
+    OEInt r;
+    
+    p &= ~(F_V | F_C);
+    
+    if (!(p & F_D))
+    {
+        r = a + value + c;
+        
+        if (~(a ^ value) & (a ^ r) & sign)
+            p |= F_V;
+        if (r > mask)
+            p |= F_C;
+    }
+    else
+    {
+        r = 0;
+        
+        for (OEInt shift = 0; shift < bits; shift += 4)
+        {
+            OEInt digit = ((a >> shift) & 0xf) + ((value >> shift) & 0xf) + c;
+            
+            if (shift + 4 == bits)
+            {
+                OEInt t = r | (digit << shift);
+                
+                if (~(a ^ value) & (a ^ t) & sign)
+                    p |= F_V;
+            }
+            
+            if (isSubtract)
+            {
+                c = (digit > 0xf);
+                if (!c)
+                    digit -= 6;
+            }
+            else
+            {
+                if (digit > 9)
+                    digit += 6;
+                c = (digit > 0xf);
+            }
+            
+            r |= (digit & 0xf) << shift;
+        }
+        
+        if (c)
+            p |= F_C;
+    }
+    
+    r &= mask;
+    
+    p = (p & ~(F_N | F_Z)) | ((r & sign) ? F_N : 0) | (r ? 0 : F_Z);
+    
+    return r;
+}
+
+/***************************************************************
+ *  ALU operations on tmp
+ ***************************************************************/
+#define ORA                                                     \
+    SET_ACC(ACC | tmp);                                         \
+    SET_NZ_M(ACC)
+    
+#define AND                                                     \
+    SET_ACC(ACC & tmp);                                         \
+    SET_NZ_M(ACC)
+    
+#define EOR                                                     \
+    SET_ACC(ACC ^ tmp);                                         \
+    SET_NZ_M(ACC)
+    
+#define ADC                                                     \
+    SET_ACC(W65C816SAdd(P, ACC, tmp, isM8 ? 8 : 16, false))
+    
+#define SBC                                                     \
+    SET_ACC(W65C816SAdd(P, ACC, tmp ^ MMASK, isM8 ? 8 : 16, true))
+    
+#define LDA                                                     \
+    SET_ACC(tmp);                                               \
+    SET_NZ_M(tmp)
+    
+#define STA                                                     \
+    tmp = ACC
+    
+#define STZ                                                     \
+    tmp = 0
+    
+#define CMP_REG(r, is8)                                         \
+    {                                                           \
+        OEInt value = (r);                                      \
+        OEInt t = value - tmp;                                  \
+        if (value >= tmp)                                       \
+            P |= F_C;                                           \
+        else                                                    \
+            P &= ~F_C;                                          \
+        if (is8)                                                \
+            SET_NZ8(t);                                         \
+        else                                                    \
+            SET_NZ16(t);                                        \
+    }
+    
+#define CMP                 CMP_REG(ACC, isM8)
+#define CPX                 CMP_REG(X, isX8)
+#define CPY                 CMP_REG(Y, isX8)
+
+#define BIT                                                     \
+    SET_Z(ACC & tmp);                                           \
+    if (isM8)                                                   \
+        P = (P & ~(F_N | F_V)) | (tmp & (F_N | F_V));           \
+    else                                                        \
+        P = (P & ~(F_N | F_V)) | ((tmp >> 8) & (F_N | F_V))
+        
+#define BIT_IMM                                                 \
+    SET_Z(ACC & tmp)
+    
+#define LDX                                                     \
+    X = tmp;                                                    \
+    SET_NZ_X(tmp)
+    
+#define LDY                                                     \
+    Y = tmp;                                                    \
+    SET_NZ_X(tmp)
+    
+#define STX                                                     \
+    tmp = X
+    
+#define STY                                                     \
+    tmp = Y
+    
+/***************************************************************
+ *  read-modify-write operations on tmp
+ ***************************************************************/
+#define ASL                                                     \
+    P = (P & ~F_C) | ((tmp & MSIGN) ? F_C : 0);                 \
+    tmp = (tmp << 1) & MMASK;                                   \
+    SET_NZ_M(tmp)
+    
+#define LSR                                                     \
+    P = (P & ~F_C) | (tmp & F_C);                               \
+    tmp >>= 1;                                                  \
+    SET_NZ_M(tmp)
+    
+#define ROL                                                     \
+    {                                                           \
+        OEInt c = P & F_C;                                      \
+        P = (P & ~F_C) | ((tmp & MSIGN) ? F_C : 0);             \
+        tmp = ((tmp << 1) | c) & MMASK;                         \
+        SET_NZ_M(tmp);                                          \
+    }
+    
+#define ROR                                                     \
+    {                                                           \
+        OEInt c = P & F_C;                                      \
+        P = (P & ~F_C) | (tmp & F_C);                           \
+        tmp = (tmp >> 1) | (c ? MSIGN : 0);                     \
+        SET_NZ_M(tmp);                                          \
+    }
+    
+#define INC                                                     \
+    tmp = (tmp + 1) & MMASK;                                    \
+    SET_NZ_M(tmp)
+    
+#define DEC                                                     \
+    tmp = (tmp - 1) & MMASK;                                    \
+    SET_NZ_M(tmp)
+    
+#define TSB                                                     \
+    SET_Z(ACC & tmp);                                           \
+    tmp |= ACC
+    
+#define TRB                                                     \
+    SET_Z(ACC & tmp);                                           \
+    tmp &= ~ACC & MMASK
+    
+/***************************************************************
+ *  RMW_ACC     accumulator operation
+ *  RMW(EA)     memory operation
+ ***************************************************************/
+#define RMW_ACC(OPERATION)                                      \
+    IO;                                                         \
+    tmp = ACC;                                                  \
+    OPERATION;                                                  \
+    SET_ACC(tmp)
+    
+#define RMW(EA, OPERATION)                                      \
+    EA;                                                         \
+    RD_M;                                                       \
+    IO;                                                         \
+    OPERATION;                                                  \
+    WR_M
+    
+#define RMW_DP(EA, OPERATION)                                   \
+    EA;                                                         \
+    RD_M_DP;                                                    \
+    IO;                                                         \
+    OPERATION;                                                  \
+    WR_M_DP
+    
+/***************************************************************
+ *  index register operations
+ ***************************************************************/
+#define INX                                                     \
+    IO;                                                         \
+    X = (X + 1) & XMASK;                                        \
+    SET_NZ_X(X)
+    
+#define INY                                                     \
+    IO;                                                         \
+    Y = (Y + 1) & XMASK;                                        \
+    SET_NZ_X(Y)
+    
+#define DEX                                                     \
+    IO;                                                         \
+    X = (X - 1) & XMASK;                                        \
+    SET_NZ_X(X)
+    
+#define DEY                                                     \
+    IO;                                                         \
+    Y = (Y - 1) & XMASK;                                        \
+    SET_NZ_X(Y)
+    
+/***************************************************************
+ *  transfers
+ ***************************************************************/
+#define TRANSFER_X(dst, src)                                    \
+    IO;                                                         \
+    dst = (src) & XMASK;                                        \
+    SET_NZ_X(dst)
+    
+#define TRANSFER_M(src)                                         \
+    IO;                                                         \
+    SET_ACC((src) & MMASK);                                     \
+    SET_NZ_M(ACC)
+    
+#define TXS                                                     \
+    IO;                                                         \
+    if (isE)                                                    \
+        sp.b.l = x.b.l;                                         \
+    else                                                        \
+        S = X
+        
+#define TCS                                                     \
+    IO;                                                         \
+    if (isE)                                                    \
+        sp.b.l = A;                                             \
+    else                                                        \
+        S = C
+        
+#define TRANSFER_C(dst, src)                                    \
+    IO;                                                         \
+    dst = src;                                                  \
+    SET_NZ16(dst)
+    
+#define XBA                                                     \
+    {                                                           \
+        IO;                                                     \
+        IO;                                                     \
+        OEChar t = A;                                           \
+        A = B;                                                  \
+        B = t;                                                  \
+        SET_NZ8(A);                                             \
+    }
+    
+/***************************************************************
+ *  branches
+ *  extra cycle if taken, and if a page is crossed in emulation
+ *  mode
+ ***************************************************************/
+#define BRA(cond)                                               \
+    {                                                           \
+        OESChar o = (OESChar) RDPC;                             \
+        if (cond)                                               \
+        {                                                       \
+            IO;                                                 \
+            OEShort old = PC;                                   \
+            PC += o;                                            \
+            if (isE && ((old ^ PC) & 0xff00))                   \
+                IO;                                             \
+        }                                                       \
+    }
+    
+#define BRL                                                     \
+    {                                                           \
+        OEShort o = RDPC16;                                     \
+        IO;                                                     \
+        PC += o;                                                \
+    }
+    
+/***************************************************************
+ *  jumps and returns
+ ***************************************************************/
+#define JMP                                                     \
+    PC = RDPC16
+    
+#define JML                                                     \
+    {                                                           \
+        EA_ABL;                                                 \
+        PC = ea;                                                \
+        pbr = ea >> 16;                                         \
+    }
+    
+#define JMP_IND                                                 \
+    {                                                           \
+        OEInt ptr = RDPC16;                                     \
+        PC = RDMEM16(ptr, 0xffff);                              \
+    }
+    
+#define JMP_IDX                                                 \
+    {                                                           \
+        OEInt ptr = RDPC16;                                     \
+        IO;                                                     \
+        PC = RDMEM16(PBR24 | ((ptr + X) & 0xffff), 0xffff);     \
+    }
+    
+#define JML_IND                                                 \
+    {                                                           \
+        OEInt ptr = RDPC16;                                     \
+        OEInt t = RDMEM16(ptr, 0xffff);                         \
+        pbr = RDMEM((ptr + 2) & 0xffff);                        \
+        PC = t;                                                 \
+    }
+    
+#define JSR                                                     \
+    {                                                           \
+        OEInt t = RDPC16;                                       \
+        IO;                                                     \
+        PUSH16((PC - 1) & 0xffff);                              \
+        PC = t;                                                 \
+    }
+    
+#define JSR_IDX                                                 \
+    {                                                           \
+        OEInt lo = RDPC;                                        \
+        PUSH16(PC);                                             \
+        OEInt hi = RDPC;                                        \
+        IO;                                                     \
+        OEInt ptr = (lo | (hi << 8)) + X;                       \
+        PC = RDMEM16(PBR24 | (ptr & 0xffff), 0xffff);           \
+    }
+    
+#define JSL                                                     \
+    {                                                           \
+        OEInt t = RDPC16;                                       \
+        PUSH8(pbr);                                             \
+        IO;                                                     \
+        OEChar bank = RDPC;                                     \
+        PUSH16((PC - 1) & 0xffff);                              \
+        PC = t;                                                 \
+        pbr = bank;                                             \
+    }
+    
+#define RTS                                                     \
+    {                                                           \
+        IO;                                                     \
+        IO;                                                     \
+        OEInt t;                                                \
+        PULL16(t);                                              \
+        IO;                                                     \
+        PC = t + 1;                                             \
+    }
+    
+#define RTL                                                     \
+    {                                                           \
+        IO;                                                     \
+        IO;                                                     \
+        OEInt t;                                                \
+        PULL16(t);                                              \
+        PULL8(pbr);                                             \
+        PC = t + 1;                                             \
+    }
+    
+#define RTI                                                     \
+    {                                                           \
+        IO;                                                     \
+        IO;                                                     \
+        PULL8(P);                                               \
+        OEInt t;                                                \
+        PULL16(t);                                              \
+        PC = t;                                                 \
+        if (!isE)                                               \
+            PULL8(pbr);                                         \
+    }                                                           \
+    CHECK_MODE
+    
+/***************************************************************
+ *  software interrupts
+ ***************************************************************/
+#define SOFTWARE_INTERRUPT(vectorN, vectorE)                    \
+    RDPC;                                                       \
+    if (!isE)                                                   \
+        PUSH8(pbr);                                             \
+    PUSH16(PC);                                                 \
+    PUSH8(P);                                                   \
+    P = (P | F_I) & ~F_D;                                       \
+    pbr = 0;                                                    \
+    PC = RDMEM16(isE ? vectorE : vectorN, 0xffff)
+    
+#define BRK                 SOFTWARE_INTERRUPT(W65C816S_BRK_VECTOR_N, W65C816S_IRQ_VECTOR_E)
+#define COP                 SOFTWARE_INTERRUPT(W65C816S_COP_VECTOR_N, W65C816S_COP_VECTOR_E)
+
+/***************************************************************
+ *  stack operations
+ ***************************************************************/
+#define PHA                                                     \
+    IO;                                                         \
+    if (isM8)                                                   \
+        PUSH8(A)                                                \
+    else                                                        \
+        PUSH16(C)
+        
+#define PLA                                                     \
+    IO;                                                         \
+    IO;                                                         \
+    if (isM8)                                                   \
+        PULL8(A)                                                \
+    else                                                        \
+        PULL16(C)                                               \
+    SET_NZ_M(ACC)
+    
+#define PHX_REG(r)                                              \
+    IO;                                                         \
+    if (isX8)                                                   \
+        PUSH8(r & 0xff)                                         \
+    else                                                        \
+        PUSH16(r)
+        
+#define PLX_REG(r)                                              \
+    IO;                                                         \
+    IO;                                                         \
+    if (isX8)                                                   \
+        PULL8(r)                                                \
+    else                                                        \
+        PULL16(r)                                               \
+    SET_NZ_X(r)
+    
+#define PHP                                                     \
+    IO;                                                         \
+    PUSH8(P)
+    
+#define PLP                                                     \
+    IO;                                                         \
+    IO;                                                         \
+    PULL8(P);                                                   \
+    CHECK_MODE
+    
+#define PHB                                                     \
+    IO;                                                         \
+    PUSH8(dbr)
+    
+#define PLB                                                     \
+    IO;                                                         \
+    IO;                                                         \
+    PULL8(dbr);                                                 \
+    SET_NZ8(dbr)
+    
+#define PHD                                                     \
+    IO;                                                         \
+    PUSH16(D)
+    
+#define PLD                                                     \
+    IO;                                                         \
+    IO;                                                         \
+    PULL16(D);                                                  \
+    SET_NZ16(D)
+    
+#define PHK                                                     \
+    IO;                                                         \
+    PUSH8(pbr)
+    
+#define PEA                                                     \
+    {                                                           \
+        OEInt t = RDPC16;                                       \
+        PUSH16(t);                                              \
+    }
+    
+#define PEI                                                     \
+    {                                                           \
+        OEInt o = RDPC;                                         \
+        DP_PENALTY;                                             \
+        OEInt t = RDMEM16(DPADDR(o), DPMASK);                   \
+        PUSH16(t);                                              \
+    }
+    
+#define PER                                                     \
+    {                                                           \
+        OEInt t = RDPC16;                                       \
+        IO;                                                     \
+        PUSH16((PC + t) & 0xffff);                              \
+    }
+    
+/***************************************************************
+ *  status register operations
+ ***************************************************************/
+#define CLEAR_FLAG(flag)                                        \
+    IO;                                                         \
+    P &= ~(flag)
+    
+#define SET_FLAG(flag)                                          \
+    IO;                                                         \
+    P |= (flag)
+    
+#define CLI                                                     \
+    CLEAR_FLAG(F_I);                                            \
+    updateSpecialCondition()
+    
+#define REP                                                     \
+    tmp = RDPC;                                                 \
+    IO;                                                         \
+    P &= ~tmp;                                                  \
+    CHECK_MODE
+    
+#define SEP                                                     \
+    tmp = RDPC;                                                 \
+    IO;                                                         \
+    P |= tmp;                                                   \
+    CHECK_MODE
+    
+#define XCE                                                     \
+    {                                                           \
+        IO;                                                     \
+        OEChar c = P & F_C;                                     \
+        P = (P & ~F_C) | e;                                     \
+        e = c;                                                  \
+    }                                                           \
+    CHECK_MODE
+    
+/***************************************************************
+ *  block moves
+ *  one byte per execution, the opcode repeats until C wraps
+ ***************************************************************/
+#define BLOCK_MOVE(step)                                        \
+    {                                                           \
+        dbr = RDPC;                                             \
+        OEInt src = RDPC;                                       \
+        tmp = RDMEM((src << 16) | X);                           \
+        WRMEM(DBR24 | Y, tmp);                                  \
+        IO;                                                     \
+        IO;                                                     \
+        X = (X + step) & XMASK;                                 \
+        Y = (Y + step) & XMASK;                                 \
+        C--;                                                    \
+        if (C != 0xffff)                                        \
+            PC -= 3;                                            \
+    }
+    
+#define MVN                 BLOCK_MOVE(1)
+#define MVP                 BLOCK_MOVE(-1)
+
+/***************************************************************
+ *  WAI, STP
+ ***************************************************************/
+#define WAI                                                     \
+    IO;                                                         \
+    IO;                                                         \
+    isWaiting = true;                                           \
+    updateSpecialCondition()
+    
+#define STP                                                     \
+    IO;                                                         \
+    IO;                                                         \
+    isStopped = true;                                           \
+    updateSpecialCondition()
@@ -1,11 +1,515 @@
 
 /**
- * libemulator
+ * libemulation
  * Z80
- * (C) 2010 by Marc S. Ressl (mressl@umich.edu)
+ * (C) 2010-2012 by Marc S. Ressl (mressl@umich.edu)
  * Released under the GPL
  *
- * Emulates a Z80 microprocessor.
+ * Emulates a Z80 microprocessor
  */
 
 #include "Z80.h"
+
+#include "CPUInterface.h"
+#include "MemoryInterface.h"
+
+#include "Z80Opcodes.h"
+#include "Z80Execute.h"
+
+Z80::Z80()
+{
+    initZ80FlagTables();
+    
+    initCPU();
+    
+    controlBus = NULL;
+    memoryBus = NULL;
+    ioBus = NULL;
+    
+    controlBusClock = NULL;
+    
+    icount = 0;
+    
+    isReset = false;
+    isResetTransition = false;
+    isIRQ = false;
+    isNMITransition = false;
+    isAfterEI = false;
+    
+    updateSpecialCondition();
+    
+    invalidatePointers();
+}
+
+bool Z80::setValue(string name, string value)
+{
+    if (name == "af")
+        af.w.l = getOEInt(value);
+    else if (name == "bc")
+        bc.w.l = getOEInt(value);
+    else if (name == "de")
+        de.w.l = getOEInt(value);
+    else if (name == "hl")
+        hl.w.l = getOEInt(value);
+    else if (name == "af2")
+        af2.w.l = getOEInt(value);
+    else if (name == "bc2")
+        bc2.w.l = getOEInt(value);
+    else if (name == "de2")
+        de2.w.l = getOEInt(value);
+    else if (name == "hl2")
+        hl2.w.l = getOEInt(value);
+    else if (name == "ix")
+        ix.w.l = getOEInt(value);
+    else if (name == "iy")
+        iy.w.l = getOEInt(value);
+    else if (name == "sp")
+        sp.w.l = getOEInt(value);
+    else if (name == "pc")
+        pc.w.l = getOEInt(value);
+    else if (name == "i")
+        i = getOEInt(value);
+    else if (name == "r")
+    {
+        r = getOEInt(value) & 0x7f;
+        r2 = getOEInt(value) & 0x80;
+    }
+    else if (name == "iff1")
+        iff1 = getOEInt(value) ? 1 : 0;
+    else if (name == "iff2")
+        iff2 = getOEInt(value) ? 1 : 0;
+    else if (name == "im")
+        im = getOEInt(value);
+    else if (name == "halt")
+        halt = getOEInt(value) ? 1 : 0;
+    else
+        return false;
+    
+    return true;
+}
+
+bool Z80::getValue(string name, string& value)
+{
+    if (name == "af")
+        value = getHexString(af.w.l);
+    else if (name == "bc")
+        value = getHexString(bc.w.l);
+    else if (name == "de")
+        value = getHexString(de.w.l);
+    else if (name == "hl")
+        value = getHexString(hl.w.l);
+    else if (name == "af2")
+        value = getHexString(af2.w.l);
+    else if (name == "bc2")
+        value = getHexString(bc2.w.l);
+    else if (name == "de2")
+        value = getHexString(de2.w.l);
+    else if (name == "hl2")
+        value = getHexString(hl2.w.l);
+    else if (name == "ix")
+        value = getHexString(ix.w.l);
+    else if (name == "iy")
+        value = getHexString(iy.w.l);
+    else if (name == "sp")
+        value = getHexString(sp.w.l);
+    else if (name == "pc")
+        value = getHexString(pc.w.l);
+    else if (name == "i")
+        value = getHexString(i);
+    else if (name == "r")
+        value = getHexString((OEChar)((r & 0x7f) | r2));
+    else if (name == "iff1")
+        value = getString(iff1);
+    else if (name == "iff2")
+        value = getString(iff2);
+    else if (name == "im")
+        value = getString(im);
+    else if (name == "halt")
+        value = getString(halt);
+    else
+        return false;
+    
+    return true;
+}
+
+bool Z80::setRef(string name, OEComponent *ref)
+{
+    if (name == "controlBus")
+    {
+        if (controlBus)
+        {
+            controlBus->removeObserver(this, CONTROLBUS_POWERSTATE_DID_CHANGE);
+            controlBus->removeObserver(this, CONTROLBUS_RESET_DID_ASSERT);
+            controlBus->removeObserver(this, CONTROLBUS_RESET_DID_CLEAR);
+            controlBus->removeObserver(this, CONTROLBUS_IRQ_DID_CHANGE);
+            controlBus->removeObserver(this, CONTROLBUS_NMI_DID_ASSERT);
+        }
+        controlBus = ref;
+        if (controlBus)
+        {
+            controlBus->addObserver(this, CONTROLBUS_POWERSTATE_DID_CHANGE);
+            controlBus->addObserver(this, CONTROLBUS_RESET_DID_ASSERT);
+            controlBus->addObserver(this, CONTROLBUS_RESET_DID_CLEAR);
+            controlBus->addObserver(this, CONTROLBUS_IRQ_DID_CHANGE);
+            controlBus->addObserver(this, CONTROLBUS_NMI_DID_ASSERT);
+        }
+    }
+    else if (name == "memoryBus")
+    {
+        if (memoryBus)
+            memoryBus->removeObserver(this, MEMORY_MAP_DID_CHANGE);
+        memoryBus = ref;
+        if (memoryBus)
+            memoryBus->addObserver(this, MEMORY_MAP_DID_CHANGE);
+        
+        invalidatePointers();
+    }
+    else if (name == "ioBus")
+        ioBus = ref;
+    else
+        return false;
+    
+    return true;
+}
+
+bool Z80::init()
+{
+    OECheckComponent(controlBus);
+    OECheckComponent(memoryBus);
+    OECheckComponent(ioBus);
+    
+    controlBus->postMessage(this, CONTROLBUS_GET_POWERSTATE, &powerState);
+    controlBus->postMessage(this, CONTROLBUS_IS_RESET_ASSERTED, &isReset);
+    controlBus->postMessage(this, CONTROLBUS_IS_IRQ_ASSERTED, &isIRQ);
+    controlBus->postMessage(this, CONTROLBUS_GET_CLOCK, &controlBusClock);
+    
+    updateSpecialCondition();
+    
+    invalidatePointers();
+    
+    return true;
+}
+
+bool Z80::postMessage(OEComponent *sender, int message, void *data)
+{
+    switch (message)
+    {
+        case CPU_SET_PENDINGCYCLES:
+            icount = *((OESLong *)data);
+            
+            return true;
+            
+        case CPU_GET_PENDINGCYCLES:
+            *((OESLong *)data) = icount;
+            
+            return true;
+            
+        case CPU_RUN:
+            execute();
+            
+            return true;
+            
+        case CPU_GET_PENDINGCYCLESPOINTER:
+            *((OESLong **)data) = &icount;
+            
+            return true;
+            
+        case COMPONENT_GET_STATE:
+            getState((OEData *)data);
+            
+            return true;
+            
+        case COMPONENT_SET_STATE:
+            return setState((OEData *)data);
+    }
+    
+    return false;
+}
+
+void Z80::notify(OEComponent *sender, int notification, void *data)
+{
+    if ((sender == memoryBus) && (notification == MEMORY_MAP_DID_CHANGE))
+    {
+        if (data)
+            invalidatePointers(*((OEAddressRange *) data));
+        else
+            invalidatePointers();
+        
+        return;
+    }
+    
+    switch (notification)
+    {
+        case CONTROLBUS_POWERSTATE_DID_CHANGE:
+            powerState = *((ControlBusPowerState *)data);
+            
+            if (powerState == CONTROLBUS_POWERSTATE_OFF)
+                initCPU();
+            
+            return;
+            
+        case CONTROLBUS_RESET_DID_ASSERT:
+            isReset = true;
+            if (icount > 0)
+                icount = 0;
+            
+            return;
+            
+        case CONTROLBUS_RESET_DID_CLEAR:
+            isReset = false;
+            isResetTransition = true;
+            
+            updateSpecialCondition();
+            
+            return;
+            
+        case CONTROLBUS_IRQ_DID_CHANGE:
+            isIRQ = *((bool *)data);
+            
+            updateSpecialCondition();
+            
+            return;
+            
+        case CONTROLBUS_NMI_DID_ASSERT:
+            isNMITransition = true;
+            
+            updateSpecialCondition();
+            
+            return;
+    }
+}
+
+void Z80::initCPU()
+{
+    pc.q = 0x0000;
+    sp.q = 0xffff;
+    af.q = 0xffff;
+    bc.q = 0x0000;
+    de.q = 0x0000;
+    hl.q = 0x0000;
+    ix.q = 0xffff;
+    iy.q = 0xffff;
+    wz.q = 0x0000;
+    af2.q = 0x0000;
+    bc2.q = 0x0000;
+    de2.q = 0x0000;
+    hl2.q = 0x0000;
+    i = 0x00;
+    r = 0x00;
+    r2 = 0x00;
+    iff1 = 0;
+    iff2 = 0;
+    halt = 0;
+    im = 0;
+}
+
+// IRQs are only considered while they are enabled, so a level-triggered
+// IRQ line held during DI keeps the fast path
+
+void Z80::updateSpecialCondition()
+{
+    isSpecialCondition = (isIRQ && iff1) || isResetTransition || isNMITransition || isAfterEI;
+}
+
+// The state holds the pending cycles and the control line state, which
+// are not published as properties
+
+void Z80::getState(OEData *data)
+{
+    Z80State state;
+    
+    memset(&state, 0, sizeof(state));
+    
+    state.icount = icount;
+    state.powerState = powerState;
+    state.isReset = isReset;
+    state.isResetTransition = isResetTransition;
+    state.isIRQ = isIRQ;
+    state.isNMITransition = isNMITransition;
+    state.isAfterEI = isAfterEI;
+    
+    OEChar *p = (OEChar *) &state;
+    
+    data->insert(data->end(), p, p + sizeof(state));
+}
+
+bool Z80::setState(OEData *data)
+{
+    Z80State state;
+    
+    if (data->size() != sizeof(state))
+        return false;
+    
+    memcpy(&state, &data->front(), sizeof(state));
+    
+    icount = state.icount;
+    powerState = state.powerState;
+    isReset = state.isReset;
+    isResetTransition = state.isResetTransition;
+    isIRQ = state.isIRQ;
+    isNMITransition = state.isNMITransition;
+    isAfterEI = state.isAfterEI;
+    
+    updateSpecialCondition();
+    
+    return true;
+}
+
+void Z80::invalidatePointers()
+{
+    for (OEInt i = 0; i < Z80_PAGENUM; i++)
+    {
+        readPointer[i] = NULL;
+        writePointer[i] = NULL;
+        isReadPointerStale[i] = true;
+        isWritePointerStale[i] = true;
+    }
+}
+
+void Z80::invalidatePointers(OEAddressRange& range)
+{
+    for (OEInt i = 0; i < Z80_PAGENUM; i++)
+    {
+        OEAddress pageStart = (OEAddress) i << 8;
+        
+        if (!isAddressRangeOverlapping(range, pageStart, pageStart + 0xff))
+            continue;
+        
+        readPointer[i] = NULL;
+        writePointer[i] = NULL;
+        isReadPointerStale[i] = true;
+        isWritePointerStale[i] = true;
+    }
+}
+
+OEChar Z80::readMemoryBus(OEAddress address)
+{
+    OEInt page = (address >> 8) & 0xff;
+    
+    if (isReadPointerStale[page])
+    {
+        isReadPointerStale[page] = false;
+        
+        OEChar *p = memoryBus->getReadPointer(page << 8, (page << 8) | 0xff);
+        
+        readPointer[page] = p;
+        
+        if (p)
+            return p[address & 0xff];
+    }
+    
+    return memoryBus->read(address);
+}
+
+void Z80::writeMemoryBus(OEAddress address, OEChar value)
+{
+    OEInt page = (address >> 8) & 0xff;
+    
+    if (isWritePointerStale[page])
+    {
+        isWritePointerStale[page] = false;
+        
+        OEChar *p = memoryBus->getWritePointer(page << 8, (page << 8) | 0xff);
+        
+        writePointer[page] = p;
+        
+        if (p)
+        {
+            p[address & 0xff] = value;
+            
+            return;
+        }
+    }
+    
+    memoryBus->write(address, value);
+}
+
+// The instruction following EI runs before any interrupt is accepted.
+// Interrupt acknowledge cycles read 0xff from the data bus, so IM 0
+// executes RST 38h and IM 2 uses vector 0xff.
+
+bool Z80::executeSpecialCondition()
+{
+    if (isAfterEI)
+    {
+        isAfterEI = false;
+        
+        updateSpecialCondition();
+        
+        return false;
+    }
+    else if (isResetTransition)
+    {
+        isResetTransition = false;
+        
+        PCD = 0x0000;
+        WZ = PCD;
+        i = 0x00;
+        r = 0x00;
+        r2 = 0x00;
+        iff1 = 0;
+        iff2 = 0;
+        halt = 0;
+        im = 0;
+        
+        icount -= 3;
+        
+        updateSpecialCondition();
+        
+        return true;
+    }
+    else if (isNMITransition)
+    {
+        isNMITransition = false;
+        
+        LEAVE_HALT();
+        
+        iff1 = 0;
+        PUSH(pc);
+        PCD = 0x0066;
+        WZ = PCD;
+        
+        icount -= 11;
+        
+        updateSpecialCondition();
+        
+        return true;
+    }
+    else if (isIRQ && iff1)
+    {
+        LEAVE_HALT();
+        
+        iff1 = 0;
+        iff2 = 0;
+        
+        if (im == 2)
+        {
+            OEInt vector = (i << 8) | 0xff;
+            
+            PUSH(pc);
+            RM16(vector, &pc);
+            
+            icount -= cc_op[0xcd] + cc_ex[0xff];
+        }
+        else
+        {
+            RST(0x0038);
+            
+            icount -= cc_op[0xff] + cc_ex[0xff];
+        }
+        WZ = PCD;
+        
+        updateSpecialCondition();
+        
+        return true;
+    }
+    
+    updateSpecialCondition();
+    
+    return false;
+}
+
+void Z80::execute()
+{
+    Z80_EXECUTE;
+}
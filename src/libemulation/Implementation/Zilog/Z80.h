@@ -1,60 +1,134 @@
 
 /**
- * libemulator
+ * libemulation
  * Z80
- * (C) 2010 by Marc S. Ressl (mressl@umich.edu)
+ * (C) 2010-2012 by Marc S. Ressl (mressl@umich.edu)
  * Released under the GPL
  *
- * Emulates a Z80 microprocessor.
+ * Emulates a Z80 microprocessor
  */
 
+#ifndef _Z80_H
+#define _Z80_H
+
 #include "OEComponent.h"
+#include "ControlBusInterface.h"
+
+#define Z80_PAGENUM     0x100
 
+#if defined(__GNUC__)
+#define Z80_INLINE      inline __attribute__((always_inline))
+#else
+#define Z80_INLINE      inline
+#endif
+
+typedef struct
+{
+    OESLong icount;
+    ControlBusPowerState powerState;
+    bool isReset;
+    bool isResetTransition;
+    bool isIRQ;
+    bool isNMITransition;
+    bool isAfterEI;
+} Z80State;
 
 class Z80 : public OEComponent
 {
 public:
-	Z80();
-	
-	int ioctl(int message, void *data);		
-	
-private:
-	OEComponent *memory;
-	OEComponent *port;
-	
-	// 8080
-	OEPair ppc;
-	OEPair pc;
-	OEPair sp;
-	OEPair ea;
-	
-	OEPair af;
-	OEPair bc;
-	OEPair de;
-	OEPair hl;
-
-	// Z80
-	OEPair af2;
-	OEPair bc2;
-	OEPair de2;
-	OEPair hl2;
-	OEPair ix;
-	OEPair iy;
-	OEPair wz;
-	UINT8 i;
-	UINT8 r;
-	
-	UINT8 rr;
-	
-	UINT8 iff1;
-	UINT8 iff2;
-	UINT8 halt;
-	UINT8 im;
-	
-	UINT8 nmi_state;		/* nmi line state */
-	UINT8 nmi_pending;		/* nmi pending */
-	UINT8 irq_state;		/* irq line state */
-	UINT8 after_ei;			/* are we in the EI shadow? */
-	
-	void execute();
+    Z80();
+    
+    bool setValue(string name, string value);
+    bool getValue(string name, string& value);
+    bool setRef(string name, OEComponent *ref);
+    bool init();
+    
+    bool postMessage(OEComponent *sender, int message, void *data);
+    
+    void notify(OEComponent *sender, int notification, void *data);
+    
+protected:
+    OEUnion pc;
+    OEUnion sp;
+    OEUnion af;
+    OEUnion bc;
+    OEUnion de;
+    OEUnion hl;
+    OEUnion ix;
+    OEUnion iy;
+    OEUnion wz;
+    OEUnion af2;
+    OEUnion bc2;
+    OEUnion de2;
+    OEUnion hl2;
+    OEChar i;
+    OEInt r;
+    OEChar r2;
+    OEChar iff1;
+    OEChar iff2;
+    OEChar halt;
+    OEChar im;
+    
+    OEComponent *controlBus;
+    OEComponent *memoryBus;
+    OEComponent *ioBus;
+    
+    ControlBusClock *controlBusClock;
+    
+    OESLong icount;
+    
+    ControlBusPowerState powerState;
+    
+    bool isReset;
+    bool isResetTransition;
+    bool isIRQ;
+    bool isNMITransition;
+    bool isAfterEI;
+    
+    bool isSpecialCondition;
+    
+    OEChar *readPointer[Z80_PAGENUM];
+    OEChar *writePointer[Z80_PAGENUM];
+    bool isReadPointerStale[Z80_PAGENUM];
+    bool isWritePointerStale[Z80_PAGENUM];
+    
+    void initCPU();
+    void updateSpecialCondition();
+    void execute();
+    bool executeSpecialCondition();
+    
+    void getState(OEData *data);
+    bool setState(OEData *data);
+    
+    void invalidatePointers();
+    void invalidatePointers(OEAddressRange& range);
+    OEChar readMemory(OEAddress address);
+    void writeMemory(OEAddress address, OEChar value);
+    OEChar readMemoryBus(OEAddress address);
+    void writeMemoryBus(OEAddress address, OEChar value);
 };
+
+// Memory accesses go through host pointers to the 256-byte page when
+// the memory bus provides one, and through the memory bus otherwise
+
+Z80_INLINE OEChar Z80::readMemory(OEAddress address)
+{
+    OEChar *p = readPointer[(address >> 8) & 0xff];
+    
+    if (p)
+        return p[address & 0xff];
+    
+    return readMemoryBus(address);
+}
+
+Z80_INLINE void Z80::writeMemory(OEAddress address, OEChar value)
+{
+    OEChar *p = writePointer[(address >> 8) & 0xff];
+    
+    if (p)
+        p[address & 0xff] = value;
+    else
+        writeMemoryBus(address, value);
+}
+
+#endif
@@ -0,0 +1,136 @@
+
+/**
+ * libemulation
+ * Z80 Execute
+ * (C) 2012 by Marc S. Ressl (mressl@umich.edu)
+ * Released under the GPL
+ *
+ * Implements the Z80 execution loop
+ */
+
+// Notes:
+// * Z80_EXECUTE expands the execution loop in the body of Z80::execute().
+// * With GCC and clang, opcodes are dispatched through computed goto
+//   tables, one per opcode table. Prefix opcodes (CB, DD, ED, FD and
+//   DD CB/FD CB) fetch the next byte and jump straight into their table,
+//   and each opcode fetches and dispatches the next one directly.
+//   Other compilers use nested switches; every nesting level needs its
+//   own case macro, as the preprocessor does not expand a macro within
+//   its own expansion.
+// * The next opcode is dispatched directly only when no interrupt, reset,
+//   NMI or EI shadow is pending; otherwise the loop head handles it.
+
+#define Z80_EXECUTE_CASE(prefix, nn) \
+    case 0x##nn: prefix##_OP##nn; break;
+
+#define Z80_EXECUTE_PREFIXCASE(prefix, nn) \
+    case 0x##nn: prefix##_OP##nn; break;
+
+#define Z80_EXECUTE_XYCBCASE(prefix, nn) \
+    case 0x##nn: prefix##_OP##nn; break;
+
+#define Z80_EXECUTE_LABELADDRESS(prefix, nn) \
+    &&prefix##_##nn,
+
+#define Z80_EXECUTE_LABEL(prefix, nn) \
+    prefix##_##nn: prefix##_OP##nn; Z80_EXECUTE_NEXT;
+
+#define Z80_EXECUTE_LABELS(prefix) \
+    static const void *prefix##Labels[] = \
+    { \
+        prefix##_OPCODES(Z80_EXECUTE_LABELADDRESS) \
+    };
+
+#define Z80_EXECUTE_FETCH \
+    r++; \
+    opcode = ROP(); \
+    CC(op, opcode);
+
+#define Z80_EXECUTE_NEXT \
+    if ((icount > 0) && !isSpecialCondition) \
+    { \
+        Z80_EXECUTE_FETCH; \
+        goto *Z80Labels[opcode]; \
+    } \
+    continue;
+
+#if defined(__GNUC__)
+
+#define Z80_EXECUTE_PREFIX(prefix, table) \
+    opcode = ROP(); \
+    CC(table, opcode); \
+    goto *prefix##Labels[opcode];
+
+#define Z80_EXECUTE_XYCB() \
+    opcode = ARG(); \
+    CC(xycb, opcode); \
+    goto *Z80XYCBLabels[opcode];
+
+#define Z80_EXECUTE_DISPATCH \
+    goto *Z80Labels[opcode]; \
+    Z80_OPCODES(Z80_EXECUTE_LABEL) \
+    Z80CB_OPCODES(Z80_EXECUTE_LABEL) \
+    Z80DD_OPCODES(Z80_EXECUTE_LABEL) \
+    Z80ED_OPCODES(Z80_EXECUTE_LABEL) \
+    Z80FD_OPCODES(Z80_EXECUTE_LABEL) \
+    Z80XYCB_OPCODES(Z80_EXECUTE_LABEL)
+
+#define Z80_EXECUTE_DECLARE \
+    Z80_EXECUTE_LABELS(Z80) \
+    Z80_EXECUTE_LABELS(Z80CB) \
+    Z80_EXECUTE_LABELS(Z80DD) \
+    Z80_EXECUTE_LABELS(Z80ED) \
+    Z80_EXECUTE_LABELS(Z80FD) \
+    Z80_EXECUTE_LABELS(Z80XYCB)
+
+#else
+
+#define Z80_EXECUTE_PREFIX(prefix, table) \
+    opcode = ROP(); \
+    CC(table, opcode); \
+    switch (opcode) \
+    { \
+        prefix##_OPCODES(Z80_EXECUTE_PREFIXCASE) \
+    }
+
+#define Z80_EXECUTE_XYCB() \
+    opcode = ARG(); \
+    CC(xycb, opcode); \
+    switch (opcode) \
+    { \
+        Z80XYCB_OPCODES(Z80_EXECUTE_XYCBCASE) \
+    }
+
+#define Z80_EXECUTE_DISPATCH \
+    switch (opcode) \
+    { \
+        Z80_OPCODES(Z80_EXECUTE_CASE) \
+    }
+
+#define Z80_EXECUTE_DECLARE
+
+#endif
+
+#define Z80_EXECUTE \
+    if (powerState != CONTROLBUS_POWERSTATE_ON) \
+        icount = 0; \
+    \
+    if (isReset) \
+        icount = 0; \
+    \
+    Z80_EXECUTE_DECLARE; \
+    \
+    OEInt ea = 0; \
+    OEChar opcode; \
+    \
+    while (icount > 0) \
+    { \
+        if (isSpecialCondition) \
+        { \
+            if (executeSpecialCondition()) \
+                continue; \
+        } \
+        \
+        Z80_EXECUTE_FETCH; \
+        Z80_EXECUTE_DISPATCH; \
+    }
@@ -1,1772 +1,1992 @@
 
 /**
- * libemulator
- * Z80Opcodes
- * (C) 2010 by Marc S. Ressl (mressl@umich.edu)
+ * libemulation
+ * Z80 Opcodes
+ * (C) 2010-2012 by Marc S. Ressl (mressl@umich.edu)
  * Released under the GPL
  *
- * Implements Z80 opcodes.
+ * Implements Z80 opcodes
  */
 
-#define O2P(prefix,opcode)  INLINE void prefix##_##opcode(z80_state *z80)
+/*****************************************************************************
+ *
+ *   z80.c
+ *   Portable Z80 emulator V3.9
+ *
+ *   Copyright Juergen Buchmueller, all rights reserved.
+ *
+ *   - This source code is released as freeware for non-commercial purposes.
+ *   - You are free to use and redistribute this code in modified or
+ *     unmodified form, provided you list me in the credits.
+ *   - If you modify this source code, you must add a notice to each modified
+ *     source file that it has been changed.  If you're a nice person, you
+ *     will clearly mark each change too.  :)
+ *   - If you wish to use this for commercial purposes, please contact me at
+ *     pullmoll@t-online.de
+ *   - The author of this copywritten work reserves the right to change the
+ *     terms of its usage and license at any time, including retroactively
+ *   - This entire notice must remain in the source code.
+ *
+ *****************************************************************************/
+
+#include "Z80Operations.h"
+
+// Z80_OPCODES, Z80CB_OPCODES, Z80DD_OPCODES, Z80ED_OPCODES, Z80FD_OPCODES
+// and Z80XYCB_OPCODES apply OP(prefix, nn) to all opcodes of a table in
+// numeric order. Z80_EXECUTE uses them for building the dispatch.
 
 /**********************************************************
  * opcodes with CB prefix
  * rotate, shift and bit operations
  **********************************************************/
-#define Z80_OPcb_00 { z80->B = RLC(z80, z80->B);												} /* RLC  B           */
-#define Z80_OPcb_01 { z80->C = RLC(z80, z80->C);												} /* RLC  C           */
-#define Z80_OPcb_02 { z80->D = RLC(z80, z80->D);												} /* RLC  D           */
-#define Z80_OPcb_03 { z80->E = RLC(z80, z80->E);												} /* RLC  E           */
-#define Z80_OPcb_04 { z80->H = RLC(z80, z80->H);												} /* RLC  H           */
-#define Z80_OPcb_05 { z80->L = RLC(z80, z80->L);												} /* RLC  L           */
-#define Z80_OPcb_06 { WM(z80, z80->HL, RLC(z80, RM(z80, z80->HL)));							} /* RLC  (HL)        */
-#define Z80_OPcb_07 { z80->A = RLC(z80, z80->A);												} /* RLC  A           */
-
-#define Z80_OPcb_08 { z80->B = RRC(z80, z80->B);												} /* RRC  B           */
-#define Z80_OPcb_09 { z80->C = RRC(z80, z80->C);												} /* RRC  C           */
-#define Z80_OPcb_0a { z80->D = RRC(z80, z80->D);												} /* RRC  D           */
-#define Z80_OPcb_0b { z80->E = RRC(z80, z80->E);												} /* RRC  E           */
-#define Z80_OPcb_0c { z80->H = RRC(z80, z80->H);												} /* RRC  H           */
-#define Z80_OPcb_0d { z80->L = RRC(z80, z80->L);												} /* RRC  L           */
-#define Z80_OPcb_0e { WM(z80, z80->HL, RRC(z80, RM(z80, z80->HL)));							} /* RRC  (HL)        */
-#define Z80_OPcb_0f { z80->A = RRC(z80, z80->A);												} /* RRC  A           */
-
-#define Z80_OPcb_10 { z80->B = RL(z80, z80->B);												} /* RL   B           */
-#define Z80_OPcb_11 { z80->C = RL(z80, z80->C);												} /* RL   C           */
-#define Z80_OPcb_12 { z80->D = RL(z80, z80->D);												} /* RL   D           */
-#define Z80_OPcb_13 { z80->E = RL(z80, z80->E);												} /* RL   E           */
-#define Z80_OPcb_14 { z80->H = RL(z80, z80->H);												} /* RL   H           */
-#define Z80_OPcb_15 { z80->L = RL(z80, z80->L);												} /* RL   L           */
-#define Z80_OPcb_16 { WM(z80, z80->HL, RL(z80, RM(z80, z80->HL)));							} /* RL   (HL)        */
-#define Z80_OPcb_17 { z80->A = RL(z80, z80->A);												} /* RL   A           */
-
-#define Z80_OPcb_18 { z80->B = RR(z80, z80->B);												} /* RR   B           */
-#define Z80_OPcb_19 { z80->C = RR(z80, z80->C);												} /* RR   C           */
-#define Z80_OPcb_1a { z80->D = RR(z80, z80->D);												} /* RR   D           */
-#define Z80_OPcb_1b { z80->E = RR(z80, z80->E);												} /* RR   E           */
-#define Z80_OPcb_1c { z80->H = RR(z80, z80->H);												} /* RR   H           */
-#define Z80_OPcb_1d { z80->L = RR(z80, z80->L);												} /* RR   L           */
-#define Z80_OPcb_1e { WM(z80, z80->HL, RR(z80, RM(z80, z80->HL)));							} /* RR   (HL)        */
-#define Z80_OPcb_1f { z80->A = RR(z80, z80->A);												} /* RR   A           */
-
-#define Z80_OPcb_20 { z80->B = SLA(z80, z80->B);												} /* SLA  B           */
-#define Z80_OPcb_21 { z80->C = SLA(z80, z80->C);												} /* SLA  C           */
-#define Z80_OPcb_22 { z80->D = SLA(z80, z80->D);												} /* SLA  D           */
-#define Z80_OPcb_23 { z80->E = SLA(z80, z80->E);												} /* SLA  E           */
-#define Z80_OPcb_24 { z80->H = SLA(z80, z80->H);												} /* SLA  H           */
-#define Z80_OPcb_25 { z80->L = SLA(z80, z80->L);												} /* SLA  L           */
-#define Z80_OPcb_26 { WM(z80, z80->HL, SLA(z80, RM(z80, z80->HL)));							} /* SLA  (HL)        */
-#define Z80_OPcb_27 { z80->A = SLA(z80, z80->A);												} /* SLA  A           */
-
-#define Z80_OPcb_28 { z80->B = SRA(z80, z80->B);												} /* SRA  B           */
-#define Z80_OPcb_29 { z80->C = SRA(z80, z80->C);												} /* SRA  C           */
-#define Z80_OPcb_2a { z80->D = SRA(z80, z80->D);												} /* SRA  D           */
-#define Z80_OPcb_2b { z80->E = SRA(z80, z80->E);												} /* SRA  E           */
-#define Z80_OPcb_2c { z80->H = SRA(z80, z80->H);												} /* SRA  H           */
-#define Z80_OPcb_2d { z80->L = SRA(z80, z80->L);												} /* SRA  L           */
-#define Z80_OPcb_2e { WM(z80, z80->HL, SRA(z80, RM(z80, z80->HL)));							} /* SRA  (HL)        */
-#define Z80_OPcb_2f { z80->A = SRA(z80, z80->A);												} /* SRA  A           */
-
-#define Z80_OPcb_30 { z80->B = SLL(z80, z80->B);												} /* SLL  B           */
-#define Z80_OPcb_31 { z80->C = SLL(z80, z80->C);												} /* SLL  C           */
-#define Z80_OPcb_32 { z80->D = SLL(z80, z80->D);												} /* SLL  D           */
-#define Z80_OPcb_33 { z80->E = SLL(z80, z80->E);												} /* SLL  E           */
-#define Z80_OPcb_34 { z80->H = SLL(z80, z80->H);												} /* SLL  H           */
-#define Z80_OPcb_35 { z80->L = SLL(z80, z80->L);												} /* SLL  L           */
-#define Z80_OPcb_36 { WM(z80, z80->HL, SLL(z80, RM(z80, z80->HL)));							} /* SLL  (HL)        */
-#define Z80_OPcb_37 { z80->A = SLL(z80, z80->A);												} /* SLL  A           */
-
-#define Z80_OPcb_38 { z80->B = SRL(z80, z80->B);												} /* SRL  B           */
-#define Z80_OPcb_39 { z80->C = SRL(z80, z80->C);												} /* SRL  C           */
-#define Z80_OPcb_3a { z80->D = SRL(z80, z80->D);												} /* SRL  D           */
-#define Z80_OPcb_3b { z80->E = SRL(z80, z80->E);												} /* SRL  E           */
-#define Z80_OPcb_3c { z80->H = SRL(z80, z80->H);												} /* SRL  H           */
-#define Z80_OPcb_3d { z80->L = SRL(z80, z80->L);												} /* SRL  L           */
-#define Z80_OPcb_3e { WM(z80, z80->HL, SRL(z80, RM(z80, z80->HL)));							} /* SRL  (HL)        */
-#define Z80_OPcb_3f { z80->A = SRL(z80, z80->A);												} /* SRL  A           */
-
-#define Z80_OPcb_40 { BIT(z80, 0, z80->B);													} /* BIT  0,B         */
-#define Z80_OPcb_41 { BIT(z80, 0, z80->C);													} /* BIT  0,C         */
-#define Z80_OPcb_42 { BIT(z80, 0, z80->D);													} /* BIT  0,D         */
-#define Z80_OPcb_43 { BIT(z80, 0, z80->E);													} /* BIT  0,E         */
-#define Z80_OPcb_44 { BIT(z80, 0, z80->H);													} /* BIT  0,H         */
-#define Z80_OPcb_45 { BIT(z80, 0, z80->L);													} /* BIT  0,L         */
-#define Z80_OPcb_46 { BIT_HL(z80, 0, RM(z80, z80->HL));										} /* BIT  0,(HL)      */
-#define Z80_OPcb_47 { BIT(z80, 0, z80->A);													} /* BIT  0,A         */
-
-#define Z80_OPcb_48 { BIT(z80, 1, z80->B);													} /* BIT  1,B         */
-#define Z80_OPcb_49 { BIT(z80, 1, z80->C);													} /* BIT  1,C         */
-#define Z80_OPcb_4a { BIT(z80, 1, z80->D);													} /* BIT  1,D         */
-#define Z80_OPcb_4b { BIT(z80, 1, z80->E);													} /* BIT  1,E         */
-#define Z80_OPcb_4c { BIT(z80, 1, z80->H);													} /* BIT  1,H         */
-#define Z80_OPcb_4d { BIT(z80, 1, z80->L);													} /* BIT  1,L         */
-#define Z80_OPcb_4e { BIT_HL(z80, 1, RM(z80, z80->HL));										} /* BIT  1,(HL)      */
-#define Z80_OPcb_4f { BIT(z80, 1, z80->A);													} /* BIT  1,A         */
-
-#define Z80_OPcb_50 { BIT(z80, 2, z80->B);													} /* BIT  2,B         */
-#define Z80_OPcb_51 { BIT(z80, 2, z80->C);													} /* BIT  2,C         */
-#define Z80_OPcb_52 { BIT(z80, 2, z80->D);													} /* BIT  2,D         */
-#define Z80_OPcb_53 { BIT(z80, 2, z80->E);													} /* BIT  2,E         */
-#define Z80_OPcb_54 { BIT(z80, 2, z80->H);													} /* BIT  2,H         */
-#define Z80_OPcb_55 { BIT(z80, 2, z80->L);													} /* BIT  2,L         */
-#define Z80_OPcb_56 { BIT_HL(z80, 2, RM(z80, z80->HL));										} /* BIT  2,(HL)      */
-#define Z80_OPcb_57 { BIT(z80, 2, z80->A);													} /* BIT  2,A         */
-
-#define Z80_OPcb_58 { BIT(z80, 3, z80->B);													} /* BIT  3,B         */
-#define Z80_OPcb_59 { BIT(z80, 3, z80->C);													} /* BIT  3,C         */
-#define Z80_OPcb_5a { BIT(z80, 3, z80->D);													} /* BIT  3,D         */
-#define Z80_OPcb_5b { BIT(z80, 3, z80->E);													} /* BIT  3,E         */
-#define Z80_OPcb_5c { BIT(z80, 3, z80->H);													} /* BIT  3,H         */
-#define Z80_OPcb_5d { BIT(z80, 3, z80->L);													} /* BIT  3,L         */
-#define Z80_OPcb_5e { BIT_HL(z80, 3, RM(z80, z80->HL));										} /* BIT  3,(HL)      */
-#define Z80_OPcb_5f { BIT(z80, 3, z80->A);													} /* BIT  3,A         */
-
-#define Z80_OPcb_60 { BIT(z80, 4, z80->B);													} /* BIT  4,B         */
-#define Z80_OPcb_61 { BIT(z80, 4, z80->C);													} /* BIT  4,C         */
-#define Z80_OPcb_62 { BIT(z80, 4, z80->D);													} /* BIT  4,D         */
-#define Z80_OPcb_63 { BIT(z80, 4, z80->E);													} /* BIT  4,E         */
-#define Z80_OPcb_64 { BIT(z80, 4, z80->H);													} /* BIT  4,H         */
-#define Z80_OPcb_65 { BIT(z80, 4, z80->L);													} /* BIT  4,L         */
-#define Z80_OPcb_66 { BIT_HL(z80, 4, RM(z80, z80->HL));										} /* BIT  4,(HL)      */
-#define Z80_OPcb_67 { BIT(z80, 4, z80->A);													} /* BIT  4,A         */
-
-#define Z80_OPcb_68 { BIT(z80, 5, z80->B);													} /* BIT  5,B         */
-#define Z80_OPcb_69 { BIT(z80, 5, z80->C);													} /* BIT  5,C         */
-#define Z80_OPcb_6a { BIT(z80, 5, z80->D);													} /* BIT  5,D         */
-#define Z80_OPcb_6b { BIT(z80, 5, z80->E);													} /* BIT  5,E         */
-#define Z80_OPcb_6c { BIT(z80, 5, z80->H);													} /* BIT  5,H         */
-#define Z80_OPcb_6d { BIT(z80, 5, z80->L);													} /* BIT  5,L         */
-#define Z80_OPcb_6e { BIT_HL(z80, 5, RM(z80, z80->HL));										} /* BIT  5,(HL)      */
-#define Z80_OPcb_6f { BIT(z80, 5, z80->A);													} /* BIT  5,A         */
-
-#define Z80_OPcb_70 { BIT(z80, 6, z80->B);													} /* BIT  6,B         */
-#define Z80_OPcb_71 { BIT(z80, 6, z80->C);													} /* BIT  6,C         */
-#define Z80_OPcb_72 { BIT(z80, 6, z80->D);													} /* BIT  6,D         */
-#define Z80_OPcb_73 { BIT(z80, 6, z80->E);													} /* BIT  6,E         */
-#define Z80_OPcb_74 { BIT(z80, 6, z80->H);													} /* BIT  6,H         */
-#define Z80_OPcb_75 { BIT(z80, 6, z80->L);													} /* BIT  6,L         */
-#define Z80_OPcb_76 { BIT_HL(z80, 6, RM(z80, z80->HL));										} /* BIT  6,(HL)      */
-#define Z80_OPcb_77 { BIT(z80, 6, z80->A);													} /* BIT  6,A         */
-
-#define Z80_OPcb_78 { BIT(z80, 7, z80->B);													} /* BIT  7,B         */
-#define Z80_OPcb_79 { BIT(z80, 7, z80->C);													} /* BIT  7,C         */
-#define Z80_OPcb_7a { BIT(z80, 7, z80->D);													} /* BIT  7,D         */
-#define Z80_OPcb_7b { BIT(z80, 7, z80->E);													} /* BIT  7,E         */
-#define Z80_OPcb_7c { BIT(z80, 7, z80->H);													} /* BIT  7,H         */
-#define Z80_OPcb_7d { BIT(z80, 7, z80->L);													} /* BIT  7,L         */
-#define Z80_OPcb_7e { BIT_HL(z80, 7, RM(z80, z80->HL));										} /* BIT  7,(HL)      */
-#define Z80_OPcb_7f { BIT(z80, 7, z80->A);													} /* BIT  7,A         */
-
-#define Z80_OPcb_80 { z80->B = RES(0, z80->B);												} /* RES  0,B         */
-#define Z80_OPcb_81 { z80->C = RES(0, z80->C);												} /* RES  0,C         */
-#define Z80_OPcb_82 { z80->D = RES(0, z80->D);												} /* RES  0,D         */
-#define Z80_OPcb_83 { z80->E = RES(0, z80->E);												} /* RES  0,E         */
-#define Z80_OPcb_84 { z80->H = RES(0, z80->H);												} /* RES  0,H         */
-#define Z80_OPcb_85 { z80->L = RES(0, z80->L);												} /* RES  0,L         */
-#define Z80_OPcb_86 { WM(z80, z80->HL, RES(0, RM(z80, z80->HL)));								} /* RES  0,(HL)      */
-#define Z80_OPcb_87 { z80->A = RES(0, z80->A);												} /* RES  0,A         */
-
-#define Z80_OPcb_88 { z80->B = RES(1, z80->B);												} /* RES  1,B         */
-#define Z80_OPcb_89 { z80->C = RES(1, z80->C);												} /* RES  1,C         */
-#define Z80_OPcb_8a { z80->D = RES(1, z80->D);												} /* RES  1,D         */
-#define Z80_OPcb_8b { z80->E = RES(1, z80->E);												} /* RES  1,E         */
-#define Z80_OPcb_8c { z80->H = RES(1, z80->H);												} /* RES  1,H         */
-#define Z80_OPcb_8d { z80->L = RES(1, z80->L);												} /* RES  1,L         */
-#define Z80_OPcb_8e { WM(z80, z80->HL, RES(1, RM(z80, z80->HL)));								} /* RES  1,(HL)      */
-#define Z80_OPcb_8f { z80->A = RES(1, z80->A);												} /* RES  1,A         */
-
-#define Z80_OPcb_90 { z80->B = RES(2, z80->B);												} /* RES  2,B         */
-#define Z80_OPcb_91 { z80->C = RES(2, z80->C);												} /* RES  2,C         */
-#define Z80_OPcb_92 { z80->D = RES(2, z80->D);												} /* RES  2,D         */
-#define Z80_OPcb_93 { z80->E = RES(2, z80->E);												} /* RES  2,E         */
-#define Z80_OPcb_94 { z80->H = RES(2, z80->H);												} /* RES  2,H         */
-#define Z80_OPcb_95 { z80->L = RES(2, z80->L);												} /* RES  2,L         */
-#define Z80_OPcb_96 { WM(z80, z80->HL, RES(2, RM(z80, z80->HL)));								} /* RES  2,(HL)      */
-#define Z80_OPcb_97 { z80->A = RES(2, z80->A);												} /* RES  2,A         */
-
-#define Z80_OPcb_98 { z80->B = RES(3, z80->B);												} /* RES  3,B         */
-#define Z80_OPcb_99 { z80->C = RES(3, z80->C);												} /* RES  3,C         */
-#define Z80_OPcb_9a { z80->D = RES(3, z80->D);												} /* RES  3,D         */
-#define Z80_OPcb_9b { z80->E = RES(3, z80->E);												} /* RES  3,E         */
-#define Z80_OPcb_9c { z80->H = RES(3, z80->H);												} /* RES  3,H         */
-#define Z80_OPcb_9d { z80->L = RES(3, z80->L);												} /* RES  3,L         */
-#define Z80_OPcb_9e { WM(z80, z80->HL, RES(3, RM(z80, z80->HL)));								} /* RES  3,(HL)      */
-#define Z80_OPcb_9f { z80->A = RES(3, z80->A);												} /* RES  3,A         */
-
-#define Z80_OPcb_a0 { z80->B = RES(4,	z80->B);												} /* RES  4,B         */
-#define Z80_OPcb_a1 { z80->C = RES(4,	z80->C);												} /* RES  4,C         */
-#define Z80_OPcb_a2 { z80->D = RES(4,	z80->D);												} /* RES  4,D         */
-#define Z80_OPcb_a3 { z80->E = RES(4,	z80->E);												} /* RES  4,E         */
-#define Z80_OPcb_a4 { z80->H = RES(4,	z80->H);												} /* RES  4,H         */
-#define Z80_OPcb_a5 { z80->L = RES(4,	z80->L);												} /* RES  4,L         */
-#define Z80_OPcb_a6 { WM(z80, z80->HL, RES(4,	RM(z80, z80->HL)));								} /* RES  4,(HL)      */
-#define Z80_OPcb_a7 { z80->A = RES(4,	z80->A);												} /* RES  4,A         */
-
-#define Z80_OPcb_a8 { z80->B = RES(5, z80->B);												} /* RES  5,B         */
-#define Z80_OPcb_a9 { z80->C = RES(5, z80->C);												} /* RES  5,C         */
-#define Z80_OPcb_aa { z80->D = RES(5, z80->D);												} /* RES  5,D         */
-#define Z80_OPcb_ab { z80->E = RES(5, z80->E);												} /* RES  5,E         */
-#define Z80_OPcb_ac { z80->H = RES(5, z80->H);												} /* RES  5,H         */
-#define Z80_OPcb_ad { z80->L = RES(5, z80->L);												} /* RES  5,L         */
-#define Z80_OPcb_ae { WM(z80, z80->HL, RES(5, RM(z80, z80->HL)));								} /* RES  5,(HL)      */
-#define Z80_OPcb_af { z80->A = RES(5, z80->A);												} /* RES  5,A         */
-
-#define Z80_OPcb_b0 { z80->B = RES(6, z80->B);												} /* RES  6,B         */
-#define Z80_OPcb_b1 { z80->C = RES(6, z80->C);												} /* RES  6,C         */
-#define Z80_OPcb_b2 { z80->D = RES(6, z80->D);												} /* RES  6,D         */
-#define Z80_OPcb_b3 { z80->E = RES(6, z80->E);												} /* RES  6,E         */
-#define Z80_OPcb_b4 { z80->H = RES(6, z80->H);												} /* RES  6,H         */
-#define Z80_OPcb_b5 { z80->L = RES(6, z80->L);												} /* RES  6,L         */
-#define Z80_OPcb_b6 { WM(z80, z80->HL, RES(6, RM(z80, z80->HL)));								} /* RES  6,(HL)      */
-#define Z80_OPcb_b7 { z80->A = RES(6, z80->A);												} /* RES  6,A         */
-
-#define Z80_OPcb_b8 { z80->B = RES(7, z80->B);												} /* RES  7,B         */
-#define Z80_OPcb_b9 { z80->C = RES(7, z80->C);												} /* RES  7,C         */
-#define Z80_OPcb_ba { z80->D = RES(7, z80->D);												} /* RES  7,D         */
-#define Z80_OPcb_bb { z80->E = RES(7, z80->E);												} /* RES  7,E         */
-#define Z80_OPcb_bc { z80->H = RES(7, z80->H);												} /* RES  7,H         */
-#define Z80_OPcb_bd { z80->L = RES(7, z80->L);												} /* RES  7,L         */
-#define Z80_OPcb_be { WM(z80, z80->HL, RES(7, RM(z80, z80->HL)));								} /* RES  7,(HL)      */
-#define Z80_OPcb_bf { z80->A = RES(7, z80->A);												} /* RES  7,A         */
-
-#define Z80_OPcb_c0 { z80->B = SET(0, z80->B);												} /* SET  0,B         */
-#define Z80_OPcb_c1 { z80->C = SET(0, z80->C);												} /* SET  0,C         */
-#define Z80_OPcb_c2 { z80->D = SET(0, z80->D);												} /* SET  0,D         */
-#define Z80_OPcb_c3 { z80->E = SET(0, z80->E);												} /* SET  0,E         */
-#define Z80_OPcb_c4 { z80->H = SET(0, z80->H);												} /* SET  0,H         */
-#define Z80_OPcb_c5 { z80->L = SET(0, z80->L);												} /* SET  0,L         */
-#define Z80_OPcb_c6 { WM(z80, z80->HL, SET(0, RM(z80, z80->HL)));								} /* SET  0,(HL)      */
-#define Z80_OPcb_c7 { z80->A = SET(0, z80->A);												} /* SET  0,A         */
-
-#define Z80_OPcb_c8 { z80->B = SET(1, z80->B);												} /* SET  1,B         */
-#define Z80_OPcb_c9 { z80->C = SET(1, z80->C);												} /* SET  1,C         */
-#define Z80_OPcb_ca { z80->D = SET(1, z80->D);												} /* SET  1,D         */
-#define Z80_OPcb_cb { z80->E = SET(1, z80->E);												} /* SET  1,E         */
-#define Z80_OPcb_cc { z80->H = SET(1, z80->H);												} /* SET  1,H         */
-#define Z80_OPcb_cd { z80->L = SET(1, z80->L);												} /* SET  1,L         */
-#define Z80_OPcb_ce { WM(z80, z80->HL, SET(1, RM(z80, z80->HL)));								} /* SET  1,(HL)      */
-#define Z80_OPcb_cf { z80->A = SET(1, z80->A);												} /* SET  1,A         */
-
-#define Z80_OPcb_d0 { z80->B = SET(2, z80->B);												} /* SET  2,B         */
-#define Z80_OPcb_d1 { z80->C = SET(2, z80->C);												} /* SET  2,C         */
-#define Z80_OPcb_d2 { z80->D = SET(2, z80->D);												} /* SET  2,D         */
-#define Z80_OPcb_d3 { z80->E = SET(2, z80->E);												} /* SET  2,E         */
-#define Z80_OPcb_d4 { z80->H = SET(2, z80->H);												} /* SET  2,H         */
-#define Z80_OPcb_d5 { z80->L = SET(2, z80->L);												} /* SET  2,L         */
-#define Z80_OPcb_d6 { WM(z80, z80->HL, SET(2, RM(z80, z80->HL)));								} /* SET  2,(HL)      */
-#define Z80_OPcb_d7 { z80->A = SET(2, z80->A);												} /* SET  2,A         */
-
-#define Z80_OPcb_d8 { z80->B = SET(3, z80->B);												} /* SET  3,B         */
-#define Z80_OPcb_d9 { z80->C = SET(3, z80->C);												} /* SET  3,C         */
-#define Z80_OPcb_da { z80->D = SET(3, z80->D);												} /* SET  3,D         */
-#define Z80_OPcb_db { z80->E = SET(3, z80->E);												} /* SET  3,E         */
-#define Z80_OPcb_dc { z80->H = SET(3, z80->H);												} /* SET  3,H         */
-#define Z80_OPcb_dd { z80->L = SET(3, z80->L);												} /* SET  3,L         */
-#define Z80_OPcb_de { WM(z80, z80->HL, SET(3, RM(z80, z80->HL)));								} /* SET  3,(HL)      */
-#define Z80_OPcb_df { z80->A = SET(3, z80->A);												} /* SET  3,A         */
-
-#define Z80_OPcb_e0 { z80->B = SET(4, z80->B);												} /* SET  4,B         */
-#define Z80_OPcb_e1 { z80->C = SET(4, z80->C);												} /* SET  4,C         */
-#define Z80_OPcb_e2 { z80->D = SET(4, z80->D);												} /* SET  4,D         */
-#define Z80_OPcb_e3 { z80->E = SET(4, z80->E);												} /* SET  4,E         */
-#define Z80_OPcb_e4 { z80->H = SET(4, z80->H);												} /* SET  4,H         */
-#define Z80_OPcb_e5 { z80->L = SET(4, z80->L);												} /* SET  4,L         */
-#define Z80_OPcb_e6 { WM(z80, z80->HL, SET(4, RM(z80, z80->HL)));								} /* SET  4,(HL)      */
-#define Z80_OPcb_e7 { z80->A = SET(4, z80->A);												} /* SET  4,A         */
-
-#define Z80_OPcb_e8 { z80->B = SET(5, z80->B);												} /* SET  5,B         */
-#define Z80_OPcb_e9 { z80->C = SET(5, z80->C);												} /* SET  5,C         */
-#define Z80_OPcb_ea { z80->D = SET(5, z80->D);												} /* SET  5,D         */
-#define Z80_OPcb_eb { z80->E = SET(5, z80->E);												} /* SET  5,E         */
-#define Z80_OPcb_ec { z80->H = SET(5, z80->H);												} /* SET  5,H         */
-#define Z80_OPcb_ed { z80->L = SET(5, z80->L);												} /* SET  5,L         */
-#define Z80_OPcb_ee { WM(z80, z80->HL, SET(5, RM(z80, z80->HL)));								} /* SET  5,(HL)      */
-#define Z80_OPcb_ef { z80->A = SET(5, z80->A);												} /* SET  5,A         */
-
-#define Z80_OPcb_f0 { z80->B = SET(6, z80->B);												} /* SET  6,B         */
-#define Z80_OPcb_f1 { z80->C = SET(6, z80->C);												} /* SET  6,C         */
-#define Z80_OPcb_f2 { z80->D = SET(6, z80->D);												} /* SET  6,D         */
-#define Z80_OPcb_f3 { z80->E = SET(6, z80->E);												} /* SET  6,E         */
-#define Z80_OPcb_f4 { z80->H = SET(6, z80->H);												} /* SET  6,H         */
-#define Z80_OPcb_f5 { z80->L = SET(6, z80->L);												} /* SET  6,L         */
-#define Z80_OPcb_f6 { WM(z80, z80->HL, SET(6, RM(z80, z80->HL)));								} /* SET  6,(HL)      */
-#define Z80_OPcb_f7 { z80->A = SET(6, z80->A);												} /* SET  6,A         */
-
-#define Z80_OPcb_f8 { z80->B = SET(7, z80->B);												} /* SET  7,B         */
-#define Z80_OPcb_f9 { z80->C = SET(7, z80->C);												} /* SET  7,C         */
-#define Z80_OPcb_fa { z80->D = SET(7, z80->D);												} /* SET  7,D         */
-#define Z80_OPcb_fb { z80->E = SET(7, z80->E);												} /* SET  7,E         */
-#define Z80_OPcb_fc { z80->H = SET(7, z80->H);												} /* SET  7,H         */
-#define Z80_OPcb_fd { z80->L = SET(7, z80->L);												} /* SET  7,L         */
-#define Z80_OPcb_fe { WM(z80, z80->HL, SET(7, RM(z80, z80->HL)));								} /* SET  7,(HL)      */
-#define Z80_OPcb_ff { z80->A = SET(7, z80->A);												} /* SET  7,A         */
+#define Z80CB_OP00 { B = RLC(B);												} /* RLC  B           */
+#define Z80CB_OP01 { C = RLC(C);												} /* RLC  C           */
+#define Z80CB_OP02 { D = RLC(D);												} /* RLC  D           */
+#define Z80CB_OP03 { E = RLC(E);												} /* RLC  E           */
+#define Z80CB_OP04 { H = RLC(H);												} /* RLC  H           */
+#define Z80CB_OP05 { L = RLC(L);												} /* RLC  L           */
+#define Z80CB_OP06 { WM(HL, RLC(RM(HL)));							} /* RLC  (HL)        */
+#define Z80CB_OP07 { A = RLC(A);												} /* RLC  A           */
+
+#define Z80CB_OP08 { B = RRC(B);												} /* RRC  B           */
+#define Z80CB_OP09 { C = RRC(C);												} /* RRC  C           */
+#define Z80CB_OP0a { D = RRC(D);												} /* RRC  D           */
+#define Z80CB_OP0b { E = RRC(E);												} /* RRC  E           */
+#define Z80CB_OP0c { H = RRC(H);												} /* RRC  H           */
+#define Z80CB_OP0d { L = RRC(L);												} /* RRC  L           */
+#define Z80CB_OP0e { WM(HL, RRC(RM(HL)));							} /* RRC  (HL)        */
+#define Z80CB_OP0f { A = RRC(A);												} /* RRC  A           */
+
+#define Z80CB_OP10 { B = RL(B);												} /* RL   B           */
+#define Z80CB_OP11 { C = RL(C);												} /* RL   C           */
+#define Z80CB_OP12 { D = RL(D);												} /* RL   D           */
+#define Z80CB_OP13 { E = RL(E);												} /* RL   E           */
+#define Z80CB_OP14 { H = RL(H);												} /* RL   H           */
+#define Z80CB_OP15 { L = RL(L);												} /* RL   L           */
+#define Z80CB_OP16 { WM(HL, RL(RM(HL)));							} /* RL   (HL)        */
+#define Z80CB_OP17 { A = RL(A);												} /* RL   A           */
+
+#define Z80CB_OP18 { B = RR(B);												} /* RR   B           */
+#define Z80CB_OP19 { C = RR(C);												} /* RR   C           */
+#define Z80CB_OP1a { D = RR(D);												} /* RR   D           */
+#define Z80CB_OP1b { E = RR(E);												} /* RR   E           */
+#define Z80CB_OP1c { H = RR(H);												} /* RR   H           */
+#define Z80CB_OP1d { L = RR(L);												} /* RR   L           */
+#define Z80CB_OP1e { WM(HL, RR(RM(HL)));							} /* RR   (HL)        */
+#define Z80CB_OP1f { A = RR(A);												} /* RR   A           */
+
+#define Z80CB_OP20 { B = SLA(B);												} /* SLA  B           */
+#define Z80CB_OP21 { C = SLA(C);												} /* SLA  C           */
+#define Z80CB_OP22 { D = SLA(D);												} /* SLA  D           */
+#define Z80CB_OP23 { E = SLA(E);												} /* SLA  E           */
+#define Z80CB_OP24 { H = SLA(H);												} /* SLA  H           */
+#define Z80CB_OP25 { L = SLA(L);												} /* SLA  L           */
+#define Z80CB_OP26 { WM(HL, SLA(RM(HL)));							} /* SLA  (HL)        */
+#define Z80CB_OP27 { A = SLA(A);												} /* SLA  A           */
+
+#define Z80CB_OP28 { B = SRA(B);												} /* SRA  B           */
+#define Z80CB_OP29 { C = SRA(C);												} /* SRA  C           */
+#define Z80CB_OP2a { D = SRA(D);												} /* SRA  D           */
+#define Z80CB_OP2b { E = SRA(E);												} /* SRA  E           */
+#define Z80CB_OP2c { H = SRA(H);												} /* SRA  H           */
+#define Z80CB_OP2d { L = SRA(L);												} /* SRA  L           */
+#define Z80CB_OP2e { WM(HL, SRA(RM(HL)));							} /* SRA  (HL)        */
+#define Z80CB_OP2f { A = SRA(A);												} /* SRA  A           */
+
+#define Z80CB_OP30 { B = SLL(B);												} /* SLL  B           */
+#define Z80CB_OP31 { C = SLL(C);												} /* SLL  C           */
+#define Z80CB_OP32 { D = SLL(D);												} /* SLL  D           */
+#define Z80CB_OP33 { E = SLL(E);												} /* SLL  E           */
+#define Z80CB_OP34 { H = SLL(H);												} /* SLL  H           */
+#define Z80CB_OP35 { L = SLL(L);												} /* SLL  L           */
+#define Z80CB_OP36 { WM(HL, SLL(RM(HL)));							} /* SLL  (HL)        */
+#define Z80CB_OP37 { A = SLL(A);												} /* SLL  A           */
+
+#define Z80CB_OP38 { B = SRL(B);												} /* SRL  B           */
+#define Z80CB_OP39 { C = SRL(C);												} /* SRL  C           */
+#define Z80CB_OP3a { D = SRL(D);												} /* SRL  D           */
+#define Z80CB_OP3b { E = SRL(E);												} /* SRL  E           */
+#define Z80CB_OP3c { H = SRL(H);												} /* SRL  H           */
+#define Z80CB_OP3d { L = SRL(L);												} /* SRL  L           */
+#define Z80CB_OP3e { WM(HL, SRL(RM(HL)));							} /* SRL  (HL)        */
+#define Z80CB_OP3f { A = SRL(A);												} /* SRL  A           */
+
+#define Z80CB_OP40 { BIT(0, B);													} /* BIT  0,B         */
+#define Z80CB_OP41 { BIT(0, C);													} /* BIT  0,C         */
+#define Z80CB_OP42 { BIT(0, D);													} /* BIT  0,D         */
+#define Z80CB_OP43 { BIT(0, E);													} /* BIT  0,E         */
+#define Z80CB_OP44 { BIT(0, H);													} /* BIT  0,H         */
+#define Z80CB_OP45 { BIT(0, L);													} /* BIT  0,L         */
+#define Z80CB_OP46 { BIT_HL(0, RM(HL));										} /* BIT  0,(HL)      */
+#define Z80CB_OP47 { BIT(0, A);													} /* BIT  0,A         */
+
+#define Z80CB_OP48 { BIT(1, B);													} /* BIT  1,B         */
+#define Z80CB_OP49 { BIT(1, C);													} /* BIT  1,C         */
+#define Z80CB_OP4a { BIT(1, D);													} /* BIT  1,D         */
+#define Z80CB_OP4b { BIT(1, E);													} /* BIT  1,E         */
+#define Z80CB_OP4c { BIT(1, H);													} /* BIT  1,H         */
+#define Z80CB_OP4d { BIT(1, L);													} /* BIT  1,L         */
+#define Z80CB_OP4e { BIT_HL(1, RM(HL));										} /* BIT  1,(HL)      */
+#define Z80CB_OP4f { BIT(1, A);													} /* BIT  1,A         */
+
+#define Z80CB_OP50 { BIT(2, B);													} /* BIT  2,B         */
+#define Z80CB_OP51 { BIT(2, C);													} /* BIT  2,C         */
+#define Z80CB_OP52 { BIT(2, D);													} /* BIT  2,D         */
+#define Z80CB_OP53 { BIT(2, E);													} /* BIT  2,E         */
+#define Z80CB_OP54 { BIT(2, H);													} /* BIT  2,H         */
+#define Z80CB_OP55 { BIT(2, L);													} /* BIT  2,L         */
+#define Z80CB_OP56 { BIT_HL(2, RM(HL));										} /* BIT  2,(HL)      */
+#define Z80CB_OP57 { BIT(2, A);													} /* BIT  2,A         */
+
+#define Z80CB_OP58 { BIT(3, B);													} /* BIT  3,B         */
+#define Z80CB_OP59 { BIT(3, C);													} /* BIT  3,C         */
+#define Z80CB_OP5a { BIT(3, D);													} /* BIT  3,D         */
+#define Z80CB_OP5b { BIT(3, E);													} /* BIT  3,E         */
+#define Z80CB_OP5c { BIT(3, H);													} /* BIT  3,H         */
+#define Z80CB_OP5d { BIT(3, L);													} /* BIT  3,L         */
+#define Z80CB_OP5e { BIT_HL(3, RM(HL));										} /* BIT  3,(HL)      */
+#define Z80CB_OP5f { BIT(3, A);													} /* BIT  3,A         */
+
+#define Z80CB_OP60 { BIT(4, B);													} /* BIT  4,B         */
+#define Z80CB_OP61 { BIT(4, C);													} /* BIT  4,C         */
+#define Z80CB_OP62 { BIT(4, D);													} /* BIT  4,D         */
+#define Z80CB_OP63 { BIT(4, E);													} /* BIT  4,E         */
+#define Z80CB_OP64 { BIT(4, H);													} /* BIT  4,H         */
+#define Z80CB_OP65 { BIT(4, L);													} /* BIT  4,L         */
+#define Z80CB_OP66 { BIT_HL(4, RM(HL));										} /* BIT  4,(HL)      */
+#define Z80CB_OP67 { BIT(4, A);													} /* BIT  4,A         */
+
+#define Z80CB_OP68 { BIT(5, B);													} /* BIT  5,B         */
+#define Z80CB_OP69 { BIT(5, C);													} /* BIT  5,C         */
+#define Z80CB_OP6a { BIT(5, D);													} /* BIT  5,D         */
+#define Z80CB_OP6b { BIT(5, E);													} /* BIT  5,E         */
+#define Z80CB_OP6c { BIT(5, H);													} /* BIT  5,H         */
+#define Z80CB_OP6d { BIT(5, L);													} /* BIT  5,L         */
+#define Z80CB_OP6e { BIT_HL(5, RM(HL));										} /* BIT  5,(HL)      */
+#define Z80CB_OP6f { BIT(5, A);													} /* BIT  5,A         */
+
+#define Z80CB_OP70 { BIT(6, B);													} /* BIT  6,B         */
+#define Z80CB_OP71 { BIT(6, C);													} /* BIT  6,C         */
+#define Z80CB_OP72 { BIT(6, D);													} /* BIT  6,D         */
+#define Z80CB_OP73 { BIT(6, E);													} /* BIT  6,E         */
+#define Z80CB_OP74 { BIT(6, H);													} /* BIT  6,H         */
+#define Z80CB_OP75 { BIT(6, L);													} /* BIT  6,L         */
+#define Z80CB_OP76 { BIT_HL(6, RM(HL));										} /* BIT  6,(HL)      */
+#define Z80CB_OP77 { BIT(6, A);													} /* BIT  6,A         */
+
+#define Z80CB_OP78 { BIT(7, B);													} /* BIT  7,B         */
+#define Z80CB_OP79 { BIT(7, C);													} /* BIT  7,C         */
+#define Z80CB_OP7a { BIT(7, D);													} /* BIT  7,D         */
+#define Z80CB_OP7b { BIT(7, E);													} /* BIT  7,E         */
+#define Z80CB_OP7c { BIT(7, H);													} /* BIT  7,H         */
+#define Z80CB_OP7d { BIT(7, L);													} /* BIT  7,L         */
+#define Z80CB_OP7e { BIT_HL(7, RM(HL));										} /* BIT  7,(HL)      */
+#define Z80CB_OP7f { BIT(7, A);													} /* BIT  7,A         */
+
+#define Z80CB_OP80 { B = RES(0, B);												} /* RES  0,B         */
+#define Z80CB_OP81 { C = RES(0, C);												} /* RES  0,C         */
+#define Z80CB_OP82 { D = RES(0, D);												} /* RES  0,D         */
+#define Z80CB_OP83 { E = RES(0, E);												} /* RES  0,E         */
+#define Z80CB_OP84 { H = RES(0, H);												} /* RES  0,H         */
+#define Z80CB_OP85 { L = RES(0, L);												} /* RES  0,L         */
+#define Z80CB_OP86 { WM(HL, RES(0, RM(HL)));								} /* RES  0,(HL)      */
+#define Z80CB_OP87 { A = RES(0, A);												} /* RES  0,A         */
+
+#define Z80CB_OP88 { B = RES(1, B);												} /* RES  1,B         */
+#define Z80CB_OP89 { C = RES(1, C);												} /* RES  1,C         */
+#define Z80CB_OP8a { D = RES(1, D);												} /* RES  1,D         */
+#define Z80CB_OP8b { E = RES(1, E);												} /* RES  1,E         */
+#define Z80CB_OP8c { H = RES(1, H);												} /* RES  1,H         */
+#define Z80CB_OP8d { L = RES(1, L);												} /* RES  1,L         */
+#define Z80CB_OP8e { WM(HL, RES(1, RM(HL)));								} /* RES  1,(HL)      */
+#define Z80CB_OP8f { A = RES(1, A);												} /* RES  1,A         */
+
+#define Z80CB_OP90 { B = RES(2, B);												} /* RES  2,B         */
+#define Z80CB_OP91 { C = RES(2, C);												} /* RES  2,C         */
+#define Z80CB_OP92 { D = RES(2, D);												} /* RES  2,D         */
+#define Z80CB_OP93 { E = RES(2, E);												} /* RES  2,E         */
+#define Z80CB_OP94 { H = RES(2, H);												} /* RES  2,H         */
+#define Z80CB_OP95 { L = RES(2, L);												} /* RES  2,L         */
+#define Z80CB_OP96 { WM(HL, RES(2, RM(HL)));								} /* RES  2,(HL)      */
+#define Z80CB_OP97 { A = RES(2, A);												} /* RES  2,A         */
+
+#define Z80CB_OP98 { B = RES(3, B);												} /* RES  3,B         */
+#define Z80CB_OP99 { C = RES(3, C);												} /* RES  3,C         */
+#define Z80CB_OP9a { D = RES(3, D);												} /* RES  3,D         */
+#define Z80CB_OP9b { E = RES(3, E);												} /* RES  3,E         */
+#define Z80CB_OP9c { H = RES(3, H);												} /* RES  3,H         */
+#define Z80CB_OP9d { L = RES(3, L);												} /* RES  3,L         */
+#define Z80CB_OP9e { WM(HL, RES(3, RM(HL)));								} /* RES  3,(HL)      */
+#define Z80CB_OP9f { A = RES(3, A);												} /* RES  3,A         */
+
+#define Z80CB_OPa0 { B = RES(4,	B);												} /* RES  4,B         */
+#define Z80CB_OPa1 { C = RES(4,	C);												} /* RES  4,C         */
+#define Z80CB_OPa2 { D = RES(4,	D);												} /* RES  4,D         */
+#define Z80CB_OPa3 { E = RES(4,	E);												} /* RES  4,E         */
+#define Z80CB_OPa4 { H = RES(4,	H);												} /* RES  4,H         */
+#define Z80CB_OPa5 { L = RES(4,	L);												} /* RES  4,L         */
+#define Z80CB_OPa6 { WM(HL, RES(4,	RM(HL)));								} /* RES  4,(HL)      */
+#define Z80CB_OPa7 { A = RES(4,	A);												} /* RES  4,A         */
+
+#define Z80CB_OPa8 { B = RES(5, B);												} /* RES  5,B         */
+#define Z80CB_OPa9 { C = RES(5, C);												} /* RES  5,C         */
+#define Z80CB_OPaa { D = RES(5, D);												} /* RES  5,D         */
+#define Z80CB_OPab { E = RES(5, E);												} /* RES  5,E         */
+#define Z80CB_OPac { H = RES(5, H);												} /* RES  5,H         */
+#define Z80CB_OPad { L = RES(5, L);												} /* RES  5,L         */
+#define Z80CB_OPae { WM(HL, RES(5, RM(HL)));								} /* RES  5,(HL)      */
+#define Z80CB_OPaf { A = RES(5, A);												} /* RES  5,A         */
+
+#define Z80CB_OPb0 { B = RES(6, B);												} /* RES  6,B         */
+#define Z80CB_OPb1 { C = RES(6, C);												} /* RES  6,C         */
+#define Z80CB_OPb2 { D = RES(6, D);												} /* RES  6,D         */
+#define Z80CB_OPb3 { E = RES(6, E);												} /* RES  6,E         */
+#define Z80CB_OPb4 { H = RES(6, H);												} /* RES  6,H         */
+#define Z80CB_OPb5 { L = RES(6, L);												} /* RES  6,L         */
+#define Z80CB_OPb6 { WM(HL, RES(6, RM(HL)));								} /* RES  6,(HL)      */
+#define Z80CB_OPb7 { A = RES(6, A);												} /* RES  6,A         */
+
+#define Z80CB_OPb8 { B = RES(7, B);												} /* RES  7,B         */
+#define Z80CB_OPb9 { C = RES(7, C);												} /* RES  7,C         */
+#define Z80CB_OPba { D = RES(7, D);												} /* RES  7,D         */
+#define Z80CB_OPbb { E = RES(7, E);												} /* RES  7,E         */
+#define Z80CB_OPbc { H = RES(7, H);												} /* RES  7,H         */
+#define Z80CB_OPbd { L = RES(7, L);												} /* RES  7,L         */
+#define Z80CB_OPbe { WM(HL, RES(7, RM(HL)));								} /* RES  7,(HL)      */
+#define Z80CB_OPbf { A = RES(7, A);												} /* RES  7,A         */
+
+#define Z80CB_OPc0 { B = SET(0, B);												} /* SET  0,B         */
+#define Z80CB_OPc1 { C = SET(0, C);												} /* SET  0,C         */
+#define Z80CB_OPc2 { D = SET(0, D);												} /* SET  0,D         */
+#define Z80CB_OPc3 { E = SET(0, E);												} /* SET  0,E         */
+#define Z80CB_OPc4 { H = SET(0, H);												} /* SET  0,H         */
+#define Z80CB_OPc5 { L = SET(0, L);												} /* SET  0,L         */
+#define Z80CB_OPc6 { WM(HL, SET(0, RM(HL)));								} /* SET  0,(HL)      */
+#define Z80CB_OPc7 { A = SET(0, A);												} /* SET  0,A         */
+
+#define Z80CB_OPc8 { B = SET(1, B);												} /* SET  1,B         */
+#define Z80CB_OPc9 { C = SET(1, C);												} /* SET  1,C         */
+#define Z80CB_OPca { D = SET(1, D);												} /* SET  1,D         */
+#define Z80CB_OPcb { E = SET(1, E);												} /* SET  1,E         */
+#define Z80CB_OPcc { H = SET(1, H);												} /* SET  1,H         */
+#define Z80CB_OPcd { L = SET(1, L);												} /* SET  1,L         */
+#define Z80CB_OPce { WM(HL, SET(1, RM(HL)));								} /* SET  1,(HL)      */
+#define Z80CB_OPcf { A = SET(1, A);												} /* SET  1,A         */
+
+#define Z80CB_OPd0 { B = SET(2, B);												} /* SET  2,B         */
+#define Z80CB_OPd1 { C = SET(2, C);												} /* SET  2,C         */
+#define Z80CB_OPd2 { D = SET(2, D);												} /* SET  2,D         */
+#define Z80CB_OPd3 { E = SET(2, E);												} /* SET  2,E         */
+#define Z80CB_OPd4 { H = SET(2, H);												} /* SET  2,H         */
+#define Z80CB_OPd5 { L = SET(2, L);												} /* SET  2,L         */
+#define Z80CB_OPd6 { WM(HL, SET(2, RM(HL)));								} /* SET  2,(HL)      */
+#define Z80CB_OPd7 { A = SET(2, A);												} /* SET  2,A         */
+
+#define Z80CB_OPd8 { B = SET(3, B);												} /* SET  3,B         */
+#define Z80CB_OPd9 { C = SET(3, C);												} /* SET  3,C         */
+#define Z80CB_OPda { D = SET(3, D);												} /* SET  3,D         */
+#define Z80CB_OPdb { E = SET(3, E);												} /* SET  3,E         */
+#define Z80CB_OPdc { H = SET(3, H);												} /* SET  3,H         */
+#define Z80CB_OPdd { L = SET(3, L);												} /* SET  3,L         */
+#define Z80CB_OPde { WM(HL, SET(3, RM(HL)));								} /* SET  3,(HL)      */
+#define Z80CB_OPdf { A = SET(3, A);												} /* SET  3,A         */
+
+#define Z80CB_OPe0 { B = SET(4, B);												} /* SET  4,B         */
+#define Z80CB_OPe1 { C = SET(4, C);												} /* SET  4,C         */
+#define Z80CB_OPe2 { D = SET(4, D);												} /* SET  4,D         */
+#define Z80CB_OPe3 { E = SET(4, E);												} /* SET  4,E         */
+#define Z80CB_OPe4 { H = SET(4, H);												} /* SET  4,H         */
+#define Z80CB_OPe5 { L = SET(4, L);												} /* SET  4,L         */
+#define Z80CB_OPe6 { WM(HL, SET(4, RM(HL)));								} /* SET  4,(HL)      */
+#define Z80CB_OPe7 { A = SET(4, A);												} /* SET  4,A         */
+
+#define Z80CB_OPe8 { B = SET(5, B);												} /* SET  5,B         */
+#define Z80CB_OPe9 { C = SET(5, C);												} /* SET  5,C         */
+#define Z80CB_OPea { D = SET(5, D);												} /* SET  5,D         */
+#define Z80CB_OPeb { E = SET(5, E);												} /* SET  5,E         */
+#define Z80CB_OPec { H = SET(5, H);												} /* SET  5,H         */
+#define Z80CB_OPed { L = SET(5, L);												} /* SET  5,L         */
+#define Z80CB_OPee { WM(HL, SET(5, RM(HL)));								} /* SET  5,(HL)      */
+#define Z80CB_OPef { A = SET(5, A);												} /* SET  5,A         */
+
+#define Z80CB_OPf0 { B = SET(6, B);												} /* SET  6,B         */
+#define Z80CB_OPf1 { C = SET(6, C);												} /* SET  6,C         */
+#define Z80CB_OPf2 { D = SET(6, D);												} /* SET  6,D         */
+#define Z80CB_OPf3 { E = SET(6, E);												} /* SET  6,E         */
+#define Z80CB_OPf4 { H = SET(6, H);												} /* SET  6,H         */
+#define Z80CB_OPf5 { L = SET(6, L);												} /* SET  6,L         */
+#define Z80CB_OPf6 { WM(HL, SET(6, RM(HL)));								} /* SET  6,(HL)      */
+#define Z80CB_OPf7 { A = SET(6, A);												} /* SET  6,A         */
+
+#define Z80CB_OPf8 { B = SET(7, B);												} /* SET  7,B         */
+#define Z80CB_OPf9 { C = SET(7, C);												} /* SET  7,C         */
+#define Z80CB_OPfa { D = SET(7, D);												} /* SET  7,D         */
+#define Z80CB_OPfb { E = SET(7, E);												} /* SET  7,E         */
+#define Z80CB_OPfc { H = SET(7, H);												} /* SET  7,H         */
+#define Z80CB_OPfd { L = SET(7, L);												} /* SET  7,L         */
+#define Z80CB_OPfe { WM(HL, SET(7, RM(HL)));								} /* SET  7,(HL)      */
+#define Z80CB_OPff { A = SET(7, A);												} /* SET  7,A         */
 
 
 /**********************************************************
  * opcodes with DD/FD CB prefix
  * rotate, shift and bit operations with (IX+o)
  **********************************************************/
-#define Z80_OPxycb_00 { z80->B = RLC(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->B);			} /* RLC  B=(XY+o)    */
-#define Z80_OPxycb_01 { z80->C = RLC(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->C);			} /* RLC  C=(XY+o)    */
-#define Z80_OPxycb_02 { z80->D = RLC(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->D);			} /* RLC  D=(XY+o)    */
-#define Z80_OPxycb_03 { z80->E = RLC(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->E);			} /* RLC  E=(XY+o)    */
-#define Z80_OPxycb_04 { z80->H = RLC(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->H);			} /* RLC  H=(XY+o)    */
-#define Z80_OPxycb_05 { z80->L = RLC(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->L);			} /* RLC  L=(XY+o)    */
-#define Z80_OPxycb_06 { WM(z80, z80->ea, RLC(z80, RM(z80, z80->ea)));							} /* RLC  (XY+o)      */
-#define Z80_OPxycb_07 { z80->A = RLC(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->A);			} /* RLC  A=(XY+o)    */
-
-#define Z80_OPxycb_08 { z80->B = RRC(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->B);			} /* RRC  B=(XY+o)    */
-#define Z80_OPxycb_09 { z80->C = RRC(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->C);			} /* RRC  C=(XY+o)    */
-#define Z80_OPxycb_0a { z80->D = RRC(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->D);			} /* RRC  D=(XY+o)    */
-#define Z80_OPxycb_0b { z80->E = RRC(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->E);			} /* RRC  E=(XY+o)    */
-#define Z80_OPxycb_0c { z80->H = RRC(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->H);			} /* RRC  H=(XY+o)    */
-#define Z80_OPxycb_0d { z80->L = RRC(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->L);			} /* RRC  L=(XY+o)    */
-#define Z80_OPxycb_0e { WM(z80, z80->ea,RRC(z80, RM(z80, z80->ea)));							} /* RRC  (XY+o)      */
-#define Z80_OPxycb_0f { z80->A = RRC(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->A);			} /* RRC  A=(XY+o)    */
-
-#define Z80_OPxycb_10 { z80->B = RL(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->B);			} /* RL   B=(XY+o)    */
-#define Z80_OPxycb_11 { z80->C = RL(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->C);			} /* RL   C=(XY+o)    */
-#define Z80_OPxycb_12 { z80->D = RL(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->D);			} /* RL   D=(XY+o)    */
-#define Z80_OPxycb_13 { z80->E = RL(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->E);			} /* RL   E=(XY+o)    */
-#define Z80_OPxycb_14 { z80->H = RL(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->H);			} /* RL   H=(XY+o)    */
-#define Z80_OPxycb_15 { z80->L = RL(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->L);			} /* RL   L=(XY+o)    */
-#define Z80_OPxycb_16 { WM(z80, z80->ea,RL(z80, RM(z80, z80->ea)));							} /* RL   (XY+o)      */
-#define Z80_OPxycb_17 { z80->A = RL(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->A);			} /* RL   A=(XY+o)    */
-
-#define Z80_OPxycb_18 { z80->B = RR(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->B);			} /* RR   B=(XY+o)    */
-#define Z80_OPxycb_19 { z80->C = RR(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->C);			} /* RR   C=(XY+o)    */
-#define Z80_OPxycb_1a { z80->D = RR(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->D);			} /* RR   D=(XY+o)    */
-#define Z80_OPxycb_1b { z80->E = RR(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->E);			} /* RR   E=(XY+o)    */
-#define Z80_OPxycb_1c { z80->H = RR(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->H);			} /* RR   H=(XY+o)    */
-#define Z80_OPxycb_1d { z80->L = RR(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->L);			} /* RR   L=(XY+o)    */
-#define Z80_OPxycb_1e { WM(z80, z80->ea,RR(z80, RM(z80, z80->ea)));							} /* RR   (XY+o)      */
-#define Z80_OPxycb_1f { z80->A = RR(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->A);			} /* RR   A=(XY+o)    */
-
-#define Z80_OPxycb_20 { z80->B = SLA(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->B);			} /* SLA  B=(XY+o)    */
-#define Z80_OPxycb_21 { z80->C = SLA(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->C);			} /* SLA  C=(XY+o)    */
-#define Z80_OPxycb_22 { z80->D = SLA(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->D);			} /* SLA  D=(XY+o)    */
-#define Z80_OPxycb_23 { z80->E = SLA(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->E);			} /* SLA  E=(XY+o)    */
-#define Z80_OPxycb_24 { z80->H = SLA(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->H);			} /* SLA  H=(XY+o)    */
-#define Z80_OPxycb_25 { z80->L = SLA(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->L);			} /* SLA  L=(XY+o)    */
-#define Z80_OPxycb_26 { WM(z80, z80->ea,SLA(z80, RM(z80, z80->ea)));							} /* SLA  (XY+o)      */
-#define Z80_OPxycb_27 { z80->A = SLA(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->A);			} /* SLA  A=(XY+o)    */
-
-#define Z80_OPxycb_28 { z80->B = SRA(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->B);			} /* SRA  B=(XY+o)    */
-#define Z80_OPxycb_29 { z80->C = SRA(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->C);			} /* SRA  C=(XY+o)    */
-#define Z80_OPxycb_2a { z80->D = SRA(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->D);			} /* SRA  D=(XY+o)    */
-#define Z80_OPxycb_2b { z80->E = SRA(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->E);			} /* SRA  E=(XY+o)    */
-#define Z80_OPxycb_2c { z80->H = SRA(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->H);			} /* SRA  H=(XY+o)    */
-#define Z80_OPxycb_2d { z80->L = SRA(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->L);			} /* SRA  L=(XY+o)    */
-#define Z80_OPxycb_2e { WM(z80, z80->ea,SRA(z80, RM(z80, z80->ea)));							} /* SRA  (XY+o)      */
-#define Z80_OPxycb_2f { z80->A = SRA(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->A);			} /* SRA  A=(XY+o)    */
-
-#define Z80_OPxycb_30 { z80->B = SLL(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->B);			} /* SLL  B=(XY+o)    */
-#define Z80_OPxycb_31 { z80->C = SLL(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->C);			} /* SLL  C=(XY+o)    */
-#define Z80_OPxycb_32 { z80->D = SLL(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->D);			} /* SLL  D=(XY+o)    */
-#define Z80_OPxycb_33 { z80->E = SLL(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->E);			} /* SLL  E=(XY+o)    */
-#define Z80_OPxycb_34 { z80->H = SLL(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->H);			} /* SLL  H=(XY+o)    */
-#define Z80_OPxycb_35 { z80->L = SLL(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->L);			} /* SLL  L=(XY+o)    */
-#define Z80_OPxycb_36 { WM(z80, z80->ea,SLL(z80, RM(z80, z80->ea)));							} /* SLL  (XY+o)      */
-#define Z80_OPxycb_37 { z80->A = SLL(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->A);			} /* SLL  A=(XY+o)    */
-
-#define Z80_OPxycb_38 { z80->B = SRL(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->B);			} /* SRL  B=(XY+o)    */
-#define Z80_OPxycb_39 { z80->C = SRL(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->C);			} /* SRL  C=(XY+o)    */
-#define Z80_OPxycb_3a { z80->D = SRL(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->D);			} /* SRL  D=(XY+o)    */
-#define Z80_OPxycb_3b { z80->E = SRL(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->E);			} /* SRL  E=(XY+o)    */
-#define Z80_OPxycb_3c { z80->H = SRL(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->H);			} /* SRL  H=(XY+o)    */
-#define Z80_OPxycb_3d { z80->L = SRL(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->L);			} /* SRL  L=(XY+o)    */
-#define Z80_OPxycb_3e { WM(z80, z80->ea,SRL(z80, RM(z80, z80->ea)));							} /* SRL  (XY+o)      */
-#define Z80_OPxycb_3f { z80->A = SRL(z80, RM(z80, z80->ea)); WM(z80, z80->ea,z80->A);			} /* SRL  A=(XY+o)    */
-
-#define Z80_OPxycb_40 { xycb_46(z80);															} /* BIT  0,(XY+o)    */
-#define Z80_OPxycb_41 { xycb_46(z80);															} /* BIT  0,(XY+o)    */
-#define Z80_OPxycb_42 { xycb_46(z80);															} /* BIT  0,(XY+o)    */
-#define Z80_OPxycb_43 { xycb_46(z80);															} /* BIT  0,(XY+o)    */
-#define Z80_OPxycb_44 { xycb_46(z80);															} /* BIT  0,(XY+o)    */
-#define Z80_OPxycb_45 { xycb_46(z80);															} /* BIT  0,(XY+o)    */
-#define Z80_OPxycb_46 { BIT_XY(z80, 0, RM(z80, z80->ea));										} /* BIT  0,(XY+o)    */
-#define Z80_OPxycb_47 { xycb_46(z80);															} /* BIT  0,(XY+o)    */
-
-#define Z80_OPxycb_48 { xycb_4e(z80);															} /* BIT  1,(XY+o)    */
-#define Z80_OPxycb_49 { xycb_4e(z80);															} /* BIT  1,(XY+o)    */
-#define Z80_OPxycb_4a { xycb_4e(z80);															} /* BIT  1,(XY+o)    */
-#define Z80_OPxycb_4b { xycb_4e(z80);															} /* BIT  1,(XY+o)    */
-#define Z80_OPxycb_4c { xycb_4e(z80);															} /* BIT  1,(XY+o)    */
-#define Z80_OPxycb_4d { xycb_4e(z80);															} /* BIT  1,(XY+o)    */
-#define Z80_OPxycb_4e { BIT_XY(z80, 1, RM(z80, z80->ea));										} /* BIT  1,(XY+o)    */
-#define Z80_OPxycb_4f { xycb_4e(z80);															} /* BIT  1,(XY+o)    */
-
-#define Z80_OPxycb_50 { xycb_56(z80);															} /* BIT  2,(XY+o)    */
-#define Z80_OPxycb_51 { xycb_56(z80);															} /* BIT  2,(XY+o)    */
-#define Z80_OPxycb_52 { xycb_56(z80);															} /* BIT  2,(XY+o)    */
-#define Z80_OPxycb_53 { xycb_56(z80);															} /* BIT  2,(XY+o)    */
-#define Z80_OPxycb_54 { xycb_56(z80);															} /* BIT  2,(XY+o)    */
-#define Z80_OPxycb_55 { xycb_56(z80);															} /* BIT  2,(XY+o)    */
-#define Z80_OPxycb_56 { BIT_XY(z80, 2, RM(z80, z80->ea));										} /* BIT  2,(XY+o)    */
-#define Z80_OPxycb_57 { xycb_56(z80);															} /* BIT  2,(XY+o)    */
-
-#define Z80_OPxycb_58 { xycb_5e(z80);															} /* BIT  3,(XY+o)    */
-#define Z80_OPxycb_59 { xycb_5e(z80);															} /* BIT  3,(XY+o)    */
-#define Z80_OPxycb_5a { xycb_5e(z80);															} /* BIT  3,(XY+o)    */
-#define Z80_OPxycb_5b { xycb_5e(z80);															} /* BIT  3,(XY+o)    */
-#define Z80_OPxycb_5c { xycb_5e(z80);															} /* BIT  3,(XY+o)    */
-#define Z80_OPxycb_5d { xycb_5e(z80);															} /* BIT  3,(XY+o)    */
-#define Z80_OPxycb_5e { BIT_XY(z80, 3, RM(z80, z80->ea));										} /* BIT  3,(XY+o)    */
-#define Z80_OPxycb_5f { xycb_5e(z80);															} /* BIT  3,(XY+o)    */
-
-#define Z80_OPxycb_60 { xycb_66(z80);															} /* BIT  4,(XY+o)    */
-#define Z80_OPxycb_61 { xycb_66(z80);															} /* BIT  4,(XY+o)    */
-#define Z80_OPxycb_62 { xycb_66(z80);															} /* BIT  4,(XY+o)    */
-#define Z80_OPxycb_63 { xycb_66(z80);															} /* BIT  4,(XY+o)    */
-#define Z80_OPxycb_64 { xycb_66(z80);															} /* BIT  4,(XY+o)    */
-#define Z80_OPxycb_65 { xycb_66(z80);															} /* BIT  4,(XY+o)    */
-#define Z80_OPxycb_66 { BIT_XY(z80, 4, RM(z80, z80->ea));										} /* BIT  4,(XY+o)    */
-#define Z80_OPxycb_67 { xycb_66(z80);															} /* BIT  4,(XY+o)    */
-
-#define Z80_OPxycb_68 { xycb_6e(z80);															} /* BIT  5,(XY+o)    */
-#define Z80_OPxycb_69 { xycb_6e(z80);															} /* BIT  5,(XY+o)    */
-#define Z80_OPxycb_6a { xycb_6e(z80);															} /* BIT  5,(XY+o)    */
-#define Z80_OPxycb_6b { xycb_6e(z80);															} /* BIT  5,(XY+o)    */
-#define Z80_OPxycb_6c { xycb_6e(z80);															} /* BIT  5,(XY+o)    */
-#define Z80_OPxycb_6d { xycb_6e(z80);															} /* BIT  5,(XY+o)    */
-#define Z80_OPxycb_6e { BIT_XY(z80, 5, RM(z80, z80->ea));										} /* BIT  5,(XY+o)    */
-#define Z80_OPxycb_6f { xycb_6e(z80);															} /* BIT  5,(XY+o)    */
-
-#define Z80_OPxycb_70 { xycb_76(z80);															} /* BIT  6,(XY+o)    */
-#define Z80_OPxycb_71 { xycb_76(z80);															} /* BIT  6,(XY+o)    */
-#define Z80_OPxycb_72 { xycb_76(z80);															} /* BIT  6,(XY+o)    */
-#define Z80_OPxycb_73 { xycb_76(z80);															} /* BIT  6,(XY+o)    */
-#define Z80_OPxycb_74 { xycb_76(z80);															} /* BIT  6,(XY+o)    */
-#define Z80_OPxycb_75 { xycb_76(z80);															} /* BIT  6,(XY+o)    */
-#define Z80_OPxycb_76 { BIT_XY(z80, 6, RM(z80, z80->ea));										} /* BIT  6,(XY+o)    */
-#define Z80_OPxycb_77 { xycb_76(z80);															} /* BIT  6,(XY+o)    */
-
-#define Z80_OPxycb_78 { xycb_7e(z80);															} /* BIT  7,(XY+o)    */
-#define Z80_OPxycb_79 { xycb_7e(z80);															} /* BIT  7,(XY+o)    */
-#define Z80_OPxycb_7a { xycb_7e(z80);															} /* BIT  7,(XY+o)    */
-#define Z80_OPxycb_7b { xycb_7e(z80);															} /* BIT  7,(XY+o)    */
-#define Z80_OPxycb_7c { xycb_7e(z80);															} /* BIT  7,(XY+o)    */
-#define Z80_OPxycb_7d { xycb_7e(z80);															} /* BIT  7,(XY+o)    */
-#define Z80_OPxycb_7e { BIT_XY(z80, 7, RM(z80, z80->ea));										} /* BIT  7,(XY+o)    */
-#define Z80_OPxycb_7f { xycb_7e(z80);															} /* BIT  7,(XY+o)    */
-
-#define Z80_OPxycb_80 { z80->B = RES(0, RM(z80, z80->ea)); WM(z80, z80->ea,z80->B);			} /* RES  0,B=(XY+o)  */
-#define Z80_OPxycb_81 { z80->C = RES(0, RM(z80, z80->ea)); WM(z80, z80->ea,z80->C);			} /* RES  0,C=(XY+o)  */
-#define Z80_OPxycb_82 { z80->D = RES(0, RM(z80, z80->ea)); WM(z80, z80->ea,z80->D);			} /* RES  0,D=(XY+o)  */
-#define Z80_OPxycb_83 { z80->E = RES(0, RM(z80, z80->ea)); WM(z80, z80->ea,z80->E);			} /* RES  0,E=(XY+o)  */
-#define Z80_OPxycb_84 { z80->H = RES(0, RM(z80, z80->ea)); WM(z80, z80->ea,z80->H);			} /* RES  0,H=(XY+o)  */
-#define Z80_OPxycb_85 { z80->L = RES(0, RM(z80, z80->ea)); WM(z80, z80->ea,z80->L);			} /* RES  0,L=(XY+o)  */
-#define Z80_OPxycb_86 { WM(z80, z80->ea, RES(0, RM(z80, z80->ea)));							} /* RES  0,(XY+o)    */
-#define Z80_OPxycb_87 { z80->A = RES(0, RM(z80, z80->ea)); WM(z80, z80->ea,z80->A);			} /* RES  0,A=(XY+o)  */
-
-#define Z80_OPxycb_88 { z80->B = RES(1, RM(z80, z80->ea)); WM(z80, z80->ea,z80->B);			} /* RES  1,B=(XY+o)  */
-#define Z80_OPxycb_89 { z80->C = RES(1, RM(z80, z80->ea)); WM(z80, z80->ea,z80->C);			} /* RES  1,C=(XY+o)  */
-#define Z80_OPxycb_8a { z80->D = RES(1, RM(z80, z80->ea)); WM(z80, z80->ea,z80->D);			} /* RES  1,D=(XY+o)  */
-#define Z80_OPxycb_8b { z80->E = RES(1, RM(z80, z80->ea)); WM(z80, z80->ea,z80->E);			} /* RES  1,E=(XY+o)  */
-#define Z80_OPxycb_8c { z80->H = RES(1, RM(z80, z80->ea)); WM(z80, z80->ea,z80->H);			} /* RES  1,H=(XY+o)  */
-#define Z80_OPxycb_8d { z80->L = RES(1, RM(z80, z80->ea)); WM(z80, z80->ea,z80->L);			} /* RES  1,L=(XY+o)  */
-#define Z80_OPxycb_8e { WM(z80, z80->ea, RES(1, RM(z80, z80->ea)));							} /* RES  1,(XY+o)    */
-#define Z80_OPxycb_8f { z80->A = RES(1, RM(z80, z80->ea)); WM(z80, z80->ea,z80->A);			} /* RES  1,A=(XY+o)  */
-
-#define Z80_OPxycb_90 { z80->B = RES(2, RM(z80, z80->ea)); WM(z80, z80->ea,z80->B);			} /* RES  2,B=(XY+o)  */
-#define Z80_OPxycb_91 { z80->C = RES(2, RM(z80, z80->ea)); WM(z80, z80->ea,z80->C);			} /* RES  2,C=(XY+o)  */
-#define Z80_OPxycb_92 { z80->D = RES(2, RM(z80, z80->ea)); WM(z80, z80->ea,z80->D);			} /* RES  2,D=(XY+o)  */
-#define Z80_OPxycb_93 { z80->E = RES(2, RM(z80, z80->ea)); WM(z80, z80->ea,z80->E);			} /* RES  2,E=(XY+o)  */
-#define Z80_OPxycb_94 { z80->H = RES(2, RM(z80, z80->ea)); WM(z80, z80->ea,z80->H);			} /* RES  2,H=(XY+o)  */
-#define Z80_OPxycb_95 { z80->L = RES(2, RM(z80, z80->ea)); WM(z80, z80->ea,z80->L);			} /* RES  2,L=(XY+o)  */
-#define Z80_OPxycb_96 { WM(z80, z80->ea, RES(2, RM(z80, z80->ea)));							} /* RES  2,(XY+o)    */
-#define Z80_OPxycb_97 { z80->A = RES(2, RM(z80, z80->ea)); WM(z80, z80->ea,z80->A);			} /* RES  2,A=(XY+o)  */
-
-#define Z80_OPxycb_98 { z80->B = RES(3, RM(z80, z80->ea)); WM(z80, z80->ea,z80->B);			} /* RES  3,B=(XY+o)  */
-#define Z80_OPxycb_99 { z80->C = RES(3, RM(z80, z80->ea)); WM(z80, z80->ea,z80->C);			} /* RES  3,C=(XY+o)  */
-#define Z80_OPxycb_9a { z80->D = RES(3, RM(z80, z80->ea)); WM(z80, z80->ea,z80->D);			} /* RES  3,D=(XY+o)  */
-#define Z80_OPxycb_9b { z80->E = RES(3, RM(z80, z80->ea)); WM(z80, z80->ea,z80->E);			} /* RES  3,E=(XY+o)  */
-#define Z80_OPxycb_9c { z80->H = RES(3, RM(z80, z80->ea)); WM(z80, z80->ea,z80->H);			} /* RES  3,H=(XY+o)  */
-#define Z80_OPxycb_9d { z80->L = RES(3, RM(z80, z80->ea)); WM(z80, z80->ea,z80->L);			} /* RES  3,L=(XY+o)  */
-#define Z80_OPxycb_9e { WM(z80, z80->ea, RES(3, RM(z80, z80->ea)));							} /* RES  3,(XY+o)    */
-#define Z80_OPxycb_9f { z80->A = RES(3, RM(z80, z80->ea)); WM(z80, z80->ea,z80->A);			} /* RES  3,A=(XY+o)  */
-
-#define Z80_OPxycb_a0 { z80->B = RES(4, RM(z80, z80->ea)); WM(z80, z80->ea,z80->B);			} /* RES  4,B=(XY+o)  */
-#define Z80_OPxycb_a1 { z80->C = RES(4, RM(z80, z80->ea)); WM(z80, z80->ea,z80->C);			} /* RES  4,C=(XY+o)  */
-#define Z80_OPxycb_a2 { z80->D = RES(4, RM(z80, z80->ea)); WM(z80, z80->ea,z80->D);			} /* RES  4,D=(XY+o)  */
-#define Z80_OPxycb_a3 { z80->E = RES(4, RM(z80, z80->ea)); WM(z80, z80->ea,z80->E);			} /* RES  4,E=(XY+o)  */
-#define Z80_OPxycb_a4 { z80->H = RES(4, RM(z80, z80->ea)); WM(z80, z80->ea,z80->H);			} /* RES  4,H=(XY+o)  */
-#define Z80_OPxycb_a5 { z80->L = RES(4, RM(z80, z80->ea)); WM(z80, z80->ea,z80->L);			} /* RES  4,L=(XY+o)  */
-#define Z80_OPxycb_a6 { WM(z80, z80->ea, RES(4, RM(z80, z80->ea)));							} /* RES  4,(XY+o)    */
-#define Z80_OPxycb_a7 { z80->A = RES(4, RM(z80, z80->ea)); WM(z80, z80->ea,z80->A);			} /* RES  4,A=(XY+o)  */
-
-#define Z80_OPxycb_a8 { z80->B = RES(5, RM(z80, z80->ea)); WM(z80, z80->ea,z80->B);			} /* RES  5,B=(XY+o)  */
-#define Z80_OPxycb_a9 { z80->C = RES(5, RM(z80, z80->ea)); WM(z80, z80->ea,z80->C);			} /* RES  5,C=(XY+o)  */
-#define Z80_OPxycb_aa { z80->D = RES(5, RM(z80, z80->ea)); WM(z80, z80->ea,z80->D);			} /* RES  5,D=(XY+o)  */
-#define Z80_OPxycb_ab { z80->E = RES(5, RM(z80, z80->ea)); WM(z80, z80->ea,z80->E);			} /* RES  5,E=(XY+o)  */
-#define Z80_OPxycb_ac { z80->H = RES(5, RM(z80, z80->ea)); WM(z80, z80->ea,z80->H);			} /* RES  5,H=(XY+o)  */
-#define Z80_OPxycb_ad { z80->L = RES(5, RM(z80, z80->ea)); WM(z80, z80->ea,z80->L);			} /* RES  5,L=(XY+o)  */
-#define Z80_OPxycb_ae { WM(z80, z80->ea, RES(5, RM(z80, z80->ea)));							} /* RES  5,(XY+o)    */
-#define Z80_OPxycb_af { z80->A = RES(5, RM(z80, z80->ea)); WM(z80, z80->ea,z80->A);			} /* RES  5,A=(XY+o)  */
-
-#define Z80_OPxycb_b0 { z80->B = RES(6, RM(z80, z80->ea)); WM(z80, z80->ea,z80->B);			} /* RES  6,B=(XY+o)  */
-#define Z80_OPxycb_b1 { z80->C = RES(6, RM(z80, z80->ea)); WM(z80, z80->ea,z80->C);			} /* RES  6,C=(XY+o)  */
-#define Z80_OPxycb_b2 { z80->D = RES(6, RM(z80, z80->ea)); WM(z80, z80->ea,z80->D);			} /* RES  6,D=(XY+o)  */
-#define Z80_OPxycb_b3 { z80->E = RES(6, RM(z80, z80->ea)); WM(z80, z80->ea,z80->E);			} /* RES  6,E=(XY+o)  */
-#define Z80_OPxycb_b4 { z80->H = RES(6, RM(z80, z80->ea)); WM(z80, z80->ea,z80->H);			} /* RES  6,H=(XY+o)  */
-#define Z80_OPxycb_b5 { z80->L = RES(6, RM(z80, z80->ea)); WM(z80, z80->ea,z80->L);			} /* RES  6,L=(XY+o)  */
-#define Z80_OPxycb_b6 { WM(z80, z80->ea, RES(6, RM(z80, z80->ea)));							} /* RES  6,(XY+o)    */
-#define Z80_OPxycb_b7 { z80->A = RES(6, RM(z80, z80->ea)); WM(z80, z80->ea,z80->A);			} /* RES  6,A=(XY+o)  */
-
-#define Z80_OPxycb_b8 { z80->B = RES(7, RM(z80, z80->ea)); WM(z80, z80->ea,z80->B);			} /* RES  7,B=(XY+o)  */
-#define Z80_OPxycb_b9 { z80->C = RES(7, RM(z80, z80->ea)); WM(z80, z80->ea,z80->C);			} /* RES  7,C=(XY+o)  */
-#define Z80_OPxycb_ba { z80->D = RES(7, RM(z80, z80->ea)); WM(z80, z80->ea,z80->D);			} /* RES  7,D=(XY+o)  */
-#define Z80_OPxycb_bb { z80->E = RES(7, RM(z80, z80->ea)); WM(z80, z80->ea,z80->E);			} /* RES  7,E=(XY+o)  */
-#define Z80_OPxycb_bc { z80->H = RES(7, RM(z80, z80->ea)); WM(z80, z80->ea,z80->H);			} /* RES  7,H=(XY+o)  */
-#define Z80_OPxycb_bd { z80->L = RES(7, RM(z80, z80->ea)); WM(z80, z80->ea,z80->L);			} /* RES  7,L=(XY+o)  */
-#define Z80_OPxycb_be { WM(z80, z80->ea, RES(7, RM(z80, z80->ea)));							} /* RES  7,(XY+o)    */
-#define Z80_OPxycb_bf { z80->A = RES(7, RM(z80, z80->ea)); WM(z80, z80->ea,z80->A);			} /* RES  7,A=(XY+o)  */
-
-#define Z80_OPxycb_c0 { z80->B = SET(0, RM(z80, z80->ea)); WM(z80, z80->ea,z80->B);			} /* SET  0,B=(XY+o)  */
-#define Z80_OPxycb_c1 { z80->C = SET(0, RM(z80, z80->ea)); WM(z80, z80->ea,z80->C);			} /* SET  0,C=(XY+o)  */
-#define Z80_OPxycb_c2 { z80->D = SET(0, RM(z80, z80->ea)); WM(z80, z80->ea,z80->D);			} /* SET  0,D=(XY+o)  */
-#define Z80_OPxycb_c3 { z80->E = SET(0, RM(z80, z80->ea)); WM(z80, z80->ea,z80->E);			} /* SET  0,E=(XY+o)  */
-#define Z80_OPxycb_c4 { z80->H = SET(0, RM(z80, z80->ea)); WM(z80, z80->ea,z80->H);			} /* SET  0,H=(XY+o)  */
-#define Z80_OPxycb_c5 { z80->L = SET(0, RM(z80, z80->ea)); WM(z80, z80->ea,z80->L);			} /* SET  0,L=(XY+o)  */
-#define Z80_OPxycb_c6 { WM(z80, z80->ea, SET(0, RM(z80, z80->ea)));							} /* SET  0,(XY+o)    */
-#define Z80_OPxycb_c7 { z80->A = SET(0, RM(z80, z80->ea)); WM(z80, z80->ea,z80->A);			} /* SET  0,A=(XY+o)  */
-
-#define Z80_OPxycb_c8 { z80->B = SET(1, RM(z80, z80->ea)); WM(z80, z80->ea,z80->B);			} /* SET  1,B=(XY+o)  */
-#define Z80_OPxycb_c9 { z80->C = SET(1, RM(z80, z80->ea)); WM(z80, z80->ea,z80->C);			} /* SET  1,C=(XY+o)  */
-#define Z80_OPxycb_ca { z80->D = SET(1, RM(z80, z80->ea)); WM(z80, z80->ea,z80->D);			} /* SET  1,D=(XY+o)  */
-#define Z80_OPxycb_cb { z80->E = SET(1, RM(z80, z80->ea)); WM(z80, z80->ea,z80->E);			} /* SET  1,E=(XY+o)  */
-#define Z80_OPxycb_cc { z80->H = SET(1, RM(z80, z80->ea)); WM(z80, z80->ea,z80->H);			} /* SET  1,H=(XY+o)  */
-#define Z80_OPxycb_cd { z80->L = SET(1, RM(z80, z80->ea)); WM(z80, z80->ea,z80->L);			} /* SET  1,L=(XY+o)  */
-#define Z80_OPxycb_ce { WM(z80, z80->ea, SET(1, RM(z80, z80->ea)));							} /* SET  1,(XY+o)    */
-#define Z80_OPxycb_cf { z80->A = SET(1, RM(z80, z80->ea)); WM(z80, z80->ea,z80->A);			} /* SET  1,A=(XY+o)  */
-
-#define Z80_OPxycb_d0 { z80->B = SET(2, RM(z80, z80->ea)); WM(z80, z80->ea,z80->B);			} /* SET  2,B=(XY+o)  */
-#define Z80_OPxycb_d1 { z80->C = SET(2, RM(z80, z80->ea)); WM(z80, z80->ea,z80->C);			} /* SET  2,C=(XY+o)  */
-#define Z80_OPxycb_d2 { z80->D = SET(2, RM(z80, z80->ea)); WM(z80, z80->ea,z80->D);			} /* SET  2,D=(XY+o)  */
-#define Z80_OPxycb_d3 { z80->E = SET(2, RM(z80, z80->ea)); WM(z80, z80->ea,z80->E);			} /* SET  2,E=(XY+o)  */
-#define Z80_OPxycb_d4 { z80->H = SET(2, RM(z80, z80->ea)); WM(z80, z80->ea,z80->H);			} /* SET  2,H=(XY+o)  */
-#define Z80_OPxycb_d5 { z80->L = SET(2, RM(z80, z80->ea)); WM(z80, z80->ea,z80->L);			} /* SET  2,L=(XY+o)  */
-#define Z80_OPxycb_d6 { WM(z80, z80->ea, SET(2, RM(z80, z80->ea)));							} /* SET  2,(XY+o)    */
-#define Z80_OPxycb_d7 { z80->A = SET(2, RM(z80, z80->ea)); WM(z80, z80->ea,z80->A);			} /* SET  2,A=(XY+o)  */
-
-#define Z80_OPxycb_d8 { z80->B = SET(3, RM(z80, z80->ea)); WM(z80, z80->ea,z80->B);			} /* SET  3,B=(XY+o)  */
-#define Z80_OPxycb_d9 { z80->C = SET(3, RM(z80, z80->ea)); WM(z80, z80->ea,z80->C);			} /* SET  3,C=(XY+o)  */
-#define Z80_OPxycb_da { z80->D = SET(3, RM(z80, z80->ea)); WM(z80, z80->ea,z80->D);			} /* SET  3,D=(XY+o)  */
-#define Z80_OPxycb_db { z80->E = SET(3, RM(z80, z80->ea)); WM(z80, z80->ea,z80->E);			} /* SET  3,E=(XY+o)  */
-#define Z80_OPxycb_dc { z80->H = SET(3, RM(z80, z80->ea)); WM(z80, z80->ea,z80->H);			} /* SET  3,H=(XY+o)  */
-#define Z80_OPxycb_dd { z80->L = SET(3, RM(z80, z80->ea)); WM(z80, z80->ea,z80->L);			} /* SET  3,L=(XY+o)  */
-#define Z80_OPxycb_de { WM(z80, z80->ea, SET(3, RM(z80, z80->ea)));							} /* SET  3,(XY+o)    */
-#define Z80_OPxycb_df { z80->A = SET(3, RM(z80, z80->ea)); WM(z80, z80->ea,z80->A);			} /* SET  3,A=(XY+o)  */
-
-#define Z80_OPxycb_e0 { z80->B = SET(4, RM(z80, z80->ea)); WM(z80, z80->ea,z80->B);			} /* SET  4,B=(XY+o)  */
-#define Z80_OPxycb_e1 { z80->C = SET(4, RM(z80, z80->ea)); WM(z80, z80->ea,z80->C);			} /* SET  4,C=(XY+o)  */
-#define Z80_OPxycb_e2 { z80->D = SET(4, RM(z80, z80->ea)); WM(z80, z80->ea,z80->D);			} /* SET  4,D=(XY+o)  */
-#define Z80_OPxycb_e3 { z80->E = SET(4, RM(z80, z80->ea)); WM(z80, z80->ea,z80->E);			} /* SET  4,E=(XY+o)  */
-#define Z80_OPxycb_e4 { z80->H = SET(4, RM(z80, z80->ea)); WM(z80, z80->ea,z80->H);			} /* SET  4,H=(XY+o)  */
-#define Z80_OPxycb_e5 { z80->L = SET(4, RM(z80, z80->ea)); WM(z80, z80->ea,z80->L);			} /* SET  4,L=(XY+o)  */
-#define Z80_OPxycb_e6 { WM(z80, z80->ea, SET(4, RM(z80, z80->ea)));							} /* SET  4,(XY+o)    */
-#define Z80_OPxycb_e7 { z80->A = SET(4, RM(z80, z80->ea)); WM(z80, z80->ea,z80->A);			} /* SET  4,A=(XY+o)  */
-
-#define Z80_OPxycb_e8 { z80->B = SET(5, RM(z80, z80->ea)); WM(z80, z80->ea,z80->B);			} /* SET  5,B=(XY+o)  */
-#define Z80_OPxycb_e9 { z80->C = SET(5, RM(z80, z80->ea)); WM(z80, z80->ea,z80->C);			} /* SET  5,C=(XY+o)  */
-#define Z80_OPxycb_ea { z80->D = SET(5, RM(z80, z80->ea)); WM(z80, z80->ea,z80->D);			} /* SET  5,D=(XY+o)  */
-#define Z80_OPxycb_eb { z80->E = SET(5, RM(z80, z80->ea)); WM(z80, z80->ea,z80->E);			} /* SET  5,E=(XY+o)  */
-#define Z80_OPxycb_ec { z80->H = SET(5, RM(z80, z80->ea)); WM(z80, z80->ea,z80->H);			} /* SET  5,H=(XY+o)  */
-#define Z80_OPxycb_ed { z80->L = SET(5, RM(z80, z80->ea)); WM(z80, z80->ea,z80->L);			} /* SET  5,L=(XY+o)  */
-#define Z80_OPxycb_ee { WM(z80, z80->ea, SET(5, RM(z80, z80->ea)));							} /* SET  5,(XY+o)    */
-#define Z80_OPxycb_ef { z80->A = SET(5, RM(z80, z80->ea)); WM(z80, z80->ea,z80->A);			} /* SET  5,A=(XY+o)  */
-
-#define Z80_OPxycb_f0 { z80->B = SET(6, RM(z80, z80->ea)); WM(z80, z80->ea,z80->B);			} /* SET  6,B=(XY+o)  */
-#define Z80_OPxycb_f1 { z80->C = SET(6, RM(z80, z80->ea)); WM(z80, z80->ea,z80->C);			} /* SET  6,C=(XY+o)  */
-#define Z80_OPxycb_f2 { z80->D = SET(6, RM(z80, z80->ea)); WM(z80, z80->ea,z80->D);			} /* SET  6,D=(XY+o)  */
-#define Z80_OPxycb_f3 { z80->E = SET(6, RM(z80, z80->ea)); WM(z80, z80->ea,z80->E);			} /* SET  6,E=(XY+o)  */
-#define Z80_OPxycb_f4 { z80->H = SET(6, RM(z80, z80->ea)); WM(z80, z80->ea,z80->H);			} /* SET  6,H=(XY+o)  */
-#define Z80_OPxycb_f5 { z80->L = SET(6, RM(z80, z80->ea)); WM(z80, z80->ea,z80->L);			} /* SET  6,L=(XY+o)  */
-#define Z80_OPxycb_f6 { WM(z80, z80->ea, SET(6, RM(z80, z80->ea)));							} /* SET  6,(XY+o)    */
-#define Z80_OPxycb_f7 { z80->A = SET(6, RM(z80, z80->ea)); WM(z80, z80->ea,z80->A);			} /* SET  6,A=(XY+o)  */
-
-#define Z80_OPxycb_f8 { z80->B = SET(7, RM(z80, z80->ea)); WM(z80, z80->ea,z80->B);			} /* SET  7,B=(XY+o)  */
-#define Z80_OPxycb_f9 { z80->C = SET(7, RM(z80, z80->ea)); WM(z80, z80->ea,z80->C);			} /* SET  7,C=(XY+o)  */
-#define Z80_OPxycb_fa { z80->D = SET(7, RM(z80, z80->ea)); WM(z80, z80->ea,z80->D);			} /* SET  7,D=(XY+o)  */
-#define Z80_OPxycb_fb { z80->E = SET(7, RM(z80, z80->ea)); WM(z80, z80->ea,z80->E);			} /* SET  7,E=(XY+o)  */
-#define Z80_OPxycb_fc { z80->H = SET(7, RM(z80, z80->ea)); WM(z80, z80->ea,z80->H);			} /* SET  7,H=(XY+o)  */
-#define Z80_OPxycb_fd { z80->L = SET(7, RM(z80, z80->ea)); WM(z80, z80->ea,z80->L);			} /* SET  7,L=(XY+o)  */
-#define Z80_OPxycb_fe { WM(z80, z80->ea, SET(7, RM(z80, z80->ea)));							} /* SET  7,(XY+o)    */
-#define Z80_OPxycb_ff { z80->A = SET(7, RM(z80, z80->ea)); WM(z80, z80->ea,z80->A);			} /* SET  7,A=(XY+o)  */
-
-#define Z80_OPillegal,1 {
-	OELog("Z80 '%s' ill. opcode $%02x $%02x\n",
-		  z80->device->tag, memory_decrypted_read_byte(z80->program, (z80->PCD-1)&0xffff), memory_decrypted_read_byte(z80->program, z80->PCD));
-}
+#define Z80XYCB_OP00 { B = RLC(RM(ea)); WM(ea,B);			} /* RLC  B=(XY+o)    */
+#define Z80XYCB_OP01 { C = RLC(RM(ea)); WM(ea,C);			} /* RLC  C=(XY+o)    */
+#define Z80XYCB_OP02 { D = RLC(RM(ea)); WM(ea,D);			} /* RLC  D=(XY+o)    */
+#define Z80XYCB_OP03 { E = RLC(RM(ea)); WM(ea,E);			} /* RLC  E=(XY+o)    */
+#define Z80XYCB_OP04 { H = RLC(RM(ea)); WM(ea,H);			} /* RLC  H=(XY+o)    */
+#define Z80XYCB_OP05 { L = RLC(RM(ea)); WM(ea,L);			} /* RLC  L=(XY+o)    */
+#define Z80XYCB_OP06 { WM(ea, RLC(RM(ea)));							} /* RLC  (XY+o)      */
+#define Z80XYCB_OP07 { A = RLC(RM(ea)); WM(ea,A);			} /* RLC  A=(XY+o)    */
+
+#define Z80XYCB_OP08 { B = RRC(RM(ea)); WM(ea,B);			} /* RRC  B=(XY+o)    */
+#define Z80XYCB_OP09 { C = RRC(RM(ea)); WM(ea,C);			} /* RRC  C=(XY+o)    */
+#define Z80XYCB_OP0a { D = RRC(RM(ea)); WM(ea,D);			} /* RRC  D=(XY+o)    */
+#define Z80XYCB_OP0b { E = RRC(RM(ea)); WM(ea,E);			} /* RRC  E=(XY+o)    */
+#define Z80XYCB_OP0c { H = RRC(RM(ea)); WM(ea,H);			} /* RRC  H=(XY+o)    */
+#define Z80XYCB_OP0d { L = RRC(RM(ea)); WM(ea,L);			} /* RRC  L=(XY+o)    */
+#define Z80XYCB_OP0e { WM(ea,RRC(RM(ea)));							} /* RRC  (XY+o)      */
+#define Z80XYCB_OP0f { A = RRC(RM(ea)); WM(ea,A);			} /* RRC  A=(XY+o)    */
+
+#define Z80XYCB_OP10 { B = RL(RM(ea)); WM(ea,B);			} /* RL   B=(XY+o)    */
+#define Z80XYCB_OP11 { C = RL(RM(ea)); WM(ea,C);			} /* RL   C=(XY+o)    */
+#define Z80XYCB_OP12 { D = RL(RM(ea)); WM(ea,D);			} /* RL   D=(XY+o)    */
+#define Z80XYCB_OP13 { E = RL(RM(ea)); WM(ea,E);			} /* RL   E=(XY+o)    */
+#define Z80XYCB_OP14 { H = RL(RM(ea)); WM(ea,H);			} /* RL   H=(XY+o)    */
+#define Z80XYCB_OP15 { L = RL(RM(ea)); WM(ea,L);			} /* RL   L=(XY+o)    */
+#define Z80XYCB_OP16 { WM(ea,RL(RM(ea)));							} /* RL   (XY+o)      */
+#define Z80XYCB_OP17 { A = RL(RM(ea)); WM(ea,A);			} /* RL   A=(XY+o)    */
+
+#define Z80XYCB_OP18 { B = RR(RM(ea)); WM(ea,B);			} /* RR   B=(XY+o)    */
+#define Z80XYCB_OP19 { C = RR(RM(ea)); WM(ea,C);			} /* RR   C=(XY+o)    */
+#define Z80XYCB_OP1a { D = RR(RM(ea)); WM(ea,D);			} /* RR   D=(XY+o)    */
+#define Z80XYCB_OP1b { E = RR(RM(ea)); WM(ea,E);			} /* RR   E=(XY+o)    */
+#define Z80XYCB_OP1c { H = RR(RM(ea)); WM(ea,H);			} /* RR   H=(XY+o)    */
+#define Z80XYCB_OP1d { L = RR(RM(ea)); WM(ea,L);			} /* RR   L=(XY+o)    */
+#define Z80XYCB_OP1e { WM(ea,RR(RM(ea)));							} /* RR   (XY+o)      */
+#define Z80XYCB_OP1f { A = RR(RM(ea)); WM(ea,A);			} /* RR   A=(XY+o)    */
+
+#define Z80XYCB_OP20 { B = SLA(RM(ea)); WM(ea,B);			} /* SLA  B=(XY+o)    */
+#define Z80XYCB_OP21 { C = SLA(RM(ea)); WM(ea,C);			} /* SLA  C=(XY+o)    */
+#define Z80XYCB_OP22 { D = SLA(RM(ea)); WM(ea,D);			} /* SLA  D=(XY+o)    */
+#define Z80XYCB_OP23 { E = SLA(RM(ea)); WM(ea,E);			} /* SLA  E=(XY+o)    */
+#define Z80XYCB_OP24 { H = SLA(RM(ea)); WM(ea,H);			} /* SLA  H=(XY+o)    */
+#define Z80XYCB_OP25 { L = SLA(RM(ea)); WM(ea,L);			} /* SLA  L=(XY+o)    */
+#define Z80XYCB_OP26 { WM(ea,SLA(RM(ea)));							} /* SLA  (XY+o)      */
+#define Z80XYCB_OP27 { A = SLA(RM(ea)); WM(ea,A);			} /* SLA  A=(XY+o)    */
+
+#define Z80XYCB_OP28 { B = SRA(RM(ea)); WM(ea,B);			} /* SRA  B=(XY+o)    */
+#define Z80XYCB_OP29 { C = SRA(RM(ea)); WM(ea,C);			} /* SRA  C=(XY+o)    */
+#define Z80XYCB_OP2a { D = SRA(RM(ea)); WM(ea,D);			} /* SRA  D=(XY+o)    */
+#define Z80XYCB_OP2b { E = SRA(RM(ea)); WM(ea,E);			} /* SRA  E=(XY+o)    */
+#define Z80XYCB_OP2c { H = SRA(RM(ea)); WM(ea,H);			} /* SRA  H=(XY+o)    */
+#define Z80XYCB_OP2d { L = SRA(RM(ea)); WM(ea,L);			} /* SRA  L=(XY+o)    */
+#define Z80XYCB_OP2e { WM(ea,SRA(RM(ea)));							} /* SRA  (XY+o)      */
+#define Z80XYCB_OP2f { A = SRA(RM(ea)); WM(ea,A);			} /* SRA  A=(XY+o)    */
+
+#define Z80XYCB_OP30 { B = SLL(RM(ea)); WM(ea,B);			} /* SLL  B=(XY+o)    */
+#define Z80XYCB_OP31 { C = SLL(RM(ea)); WM(ea,C);			} /* SLL  C=(XY+o)    */
+#define Z80XYCB_OP32 { D = SLL(RM(ea)); WM(ea,D);			} /* SLL  D=(XY+o)    */
+#define Z80XYCB_OP33 { E = SLL(RM(ea)); WM(ea,E);			} /* SLL  E=(XY+o)    */
+#define Z80XYCB_OP34 { H = SLL(RM(ea)); WM(ea,H);			} /* SLL  H=(XY+o)    */
+#define Z80XYCB_OP35 { L = SLL(RM(ea)); WM(ea,L);			} /* SLL  L=(XY+o)    */
+#define Z80XYCB_OP36 { WM(ea,SLL(RM(ea)));							} /* SLL  (XY+o)      */
+#define Z80XYCB_OP37 { A = SLL(RM(ea)); WM(ea,A);			} /* SLL  A=(XY+o)    */
+
+#define Z80XYCB_OP38 { B = SRL(RM(ea)); WM(ea,B);			} /* SRL  B=(XY+o)    */
+#define Z80XYCB_OP39 { C = SRL(RM(ea)); WM(ea,C);			} /* SRL  C=(XY+o)    */
+#define Z80XYCB_OP3a { D = SRL(RM(ea)); WM(ea,D);			} /* SRL  D=(XY+o)    */
+#define Z80XYCB_OP3b { E = SRL(RM(ea)); WM(ea,E);			} /* SRL  E=(XY+o)    */
+#define Z80XYCB_OP3c { H = SRL(RM(ea)); WM(ea,H);			} /* SRL  H=(XY+o)    */
+#define Z80XYCB_OP3d { L = SRL(RM(ea)); WM(ea,L);			} /* SRL  L=(XY+o)    */
+#define Z80XYCB_OP3e { WM(ea,SRL(RM(ea)));							} /* SRL  (XY+o)      */
+#define Z80XYCB_OP3f { A = SRL(RM(ea)); WM(ea,A);			} /* SRL  A=(XY+o)    */
+
+#define Z80XYCB_OP40 { Z80XYCB_OP46															} /* BIT  0,(XY+o)    */
+#define Z80XYCB_OP41 { Z80XYCB_OP46															} /* BIT  0,(XY+o)    */
+#define Z80XYCB_OP42 { Z80XYCB_OP46															} /* BIT  0,(XY+o)    */
+#define Z80XYCB_OP43 { Z80XYCB_OP46															} /* BIT  0,(XY+o)    */
+#define Z80XYCB_OP44 { Z80XYCB_OP46															} /* BIT  0,(XY+o)    */
+#define Z80XYCB_OP45 { Z80XYCB_OP46															} /* BIT  0,(XY+o)    */
+#define Z80XYCB_OP46 { BIT_XY(0, RM(ea));										} /* BIT  0,(XY+o)    */
+#define Z80XYCB_OP47 { Z80XYCB_OP46															} /* BIT  0,(XY+o)    */
+
+#define Z80XYCB_OP48 { Z80XYCB_OP4e															} /* BIT  1,(XY+o)    */
+#define Z80XYCB_OP49 { Z80XYCB_OP4e															} /* BIT  1,(XY+o)    */
+#define Z80XYCB_OP4a { Z80XYCB_OP4e															} /* BIT  1,(XY+o)    */
+#define Z80XYCB_OP4b { Z80XYCB_OP4e															} /* BIT  1,(XY+o)    */
+#define Z80XYCB_OP4c { Z80XYCB_OP4e															} /* BIT  1,(XY+o)    */
+#define Z80XYCB_OP4d { Z80XYCB_OP4e															} /* BIT  1,(XY+o)    */
+#define Z80XYCB_OP4e { BIT_XY(1, RM(ea));										} /* BIT  1,(XY+o)    */
+#define Z80XYCB_OP4f { Z80XYCB_OP4e															} /* BIT  1,(XY+o)    */
+
+#define Z80XYCB_OP50 { Z80XYCB_OP56															} /* BIT  2,(XY+o)    */
+#define Z80XYCB_OP51 { Z80XYCB_OP56															} /* BIT  2,(XY+o)    */
+#define Z80XYCB_OP52 { Z80XYCB_OP56															} /* BIT  2,(XY+o)    */
+#define Z80XYCB_OP53 { Z80XYCB_OP56															} /* BIT  2,(XY+o)    */
+#define Z80XYCB_OP54 { Z80XYCB_OP56															} /* BIT  2,(XY+o)    */
+#define Z80XYCB_OP55 { Z80XYCB_OP56															} /* BIT  2,(XY+o)    */
+#define Z80XYCB_OP56 { BIT_XY(2, RM(ea));										} /* BIT  2,(XY+o)    */
+#define Z80XYCB_OP57 { Z80XYCB_OP56															} /* BIT  2,(XY+o)    */
+
+#define Z80XYCB_OP58 { Z80XYCB_OP5e															} /* BIT  3,(XY+o)    */
+#define Z80XYCB_OP59 { Z80XYCB_OP5e															} /* BIT  3,(XY+o)    */
+#define Z80XYCB_OP5a { Z80XYCB_OP5e															} /* BIT  3,(XY+o)    */
+#define Z80XYCB_OP5b { Z80XYCB_OP5e															} /* BIT  3,(XY+o)    */
+#define Z80XYCB_OP5c { Z80XYCB_OP5e															} /* BIT  3,(XY+o)    */
+#define Z80XYCB_OP5d { Z80XYCB_OP5e															} /* BIT  3,(XY+o)    */
+#define Z80XYCB_OP5e { BIT_XY(3, RM(ea));										} /* BIT  3,(XY+o)    */
+#define Z80XYCB_OP5f { Z80XYCB_OP5e															} /* BIT  3,(XY+o)    */
+
+#define Z80XYCB_OP60 { Z80XYCB_OP66															} /* BIT  4,(XY+o)    */
+#define Z80XYCB_OP61 { Z80XYCB_OP66															} /* BIT  4,(XY+o)    */
+#define Z80XYCB_OP62 { Z80XYCB_OP66															} /* BIT  4,(XY+o)    */
+#define Z80XYCB_OP63 { Z80XYCB_OP66															} /* BIT  4,(XY+o)    */
+#define Z80XYCB_OP64 { Z80XYCB_OP66															} /* BIT  4,(XY+o)    */
+#define Z80XYCB_OP65 { Z80XYCB_OP66															} /* BIT  4,(XY+o)    */
+#define Z80XYCB_OP66 { BIT_XY(4, RM(ea));										} /* BIT  4,(XY+o)    */
+#define Z80XYCB_OP67 { Z80XYCB_OP66															} /* BIT  4,(XY+o)    */
+
+#define Z80XYCB_OP68 { Z80XYCB_OP6e															} /* BIT  5,(XY+o)    */
+#define Z80XYCB_OP69 { Z80XYCB_OP6e															} /* BIT  5,(XY+o)    */
+#define Z80XYCB_OP6a { Z80XYCB_OP6e															} /* BIT  5,(XY+o)    */
+#define Z80XYCB_OP6b { Z80XYCB_OP6e															} /* BIT  5,(XY+o)    */
+#define Z80XYCB_OP6c { Z80XYCB_OP6e															} /* BIT  5,(XY+o)    */
+#define Z80XYCB_OP6d { Z80XYCB_OP6e															} /* BIT  5,(XY+o)    */
+#define Z80XYCB_OP6e { BIT_XY(5, RM(ea));										} /* BIT  5,(XY+o)    */
+#define Z80XYCB_OP6f { Z80XYCB_OP6e															} /* BIT  5,(XY+o)    */
+
+#define Z80XYCB_OP70 { Z80XYCB_OP76															} /* BIT  6,(XY+o)    */
+#define Z80XYCB_OP71 { Z80XYCB_OP76															} /* BIT  6,(XY+o)    */
+#define Z80XYCB_OP72 { Z80XYCB_OP76															} /* BIT  6,(XY+o)    */
+#define Z80XYCB_OP73 { Z80XYCB_OP76															} /* BIT  6,(XY+o)    */
+#define Z80XYCB_OP74 { Z80XYCB_OP76															} /* BIT  6,(XY+o)    */
+#define Z80XYCB_OP75 { Z80XYCB_OP76															} /* BIT  6,(XY+o)    */
+#define Z80XYCB_OP76 { BIT_XY(6, RM(ea));										} /* BIT  6,(XY+o)    */
+#define Z80XYCB_OP77 { Z80XYCB_OP76															} /* BIT  6,(XY+o)    */
+
+#define Z80XYCB_OP78 { Z80XYCB_OP7e															} /* BIT  7,(XY+o)    */
+#define Z80XYCB_OP79 { Z80XYCB_OP7e															} /* BIT  7,(XY+o)    */
+#define Z80XYCB_OP7a { Z80XYCB_OP7e															} /* BIT  7,(XY+o)    */
+#define Z80XYCB_OP7b { Z80XYCB_OP7e															} /* BIT  7,(XY+o)    */
+#define Z80XYCB_OP7c { Z80XYCB_OP7e															} /* BIT  7,(XY+o)    */
+#define Z80XYCB_OP7d { Z80XYCB_OP7e															} /* BIT  7,(XY+o)    */
+#define Z80XYCB_OP7e { BIT_XY(7, RM(ea));										} /* BIT  7,(XY+o)    */
+#define Z80XYCB_OP7f { Z80XYCB_OP7e															} /* BIT  7,(XY+o)    */
+
+#define Z80XYCB_OP80 { B = RES(0, RM(ea)); WM(ea,B);			} /* RES  0,B=(XY+o)  */
+#define Z80XYCB_OP81 { C = RES(0, RM(ea)); WM(ea,C);			} /* RES  0,C=(XY+o)  */
+#define Z80XYCB_OP82 { D = RES(0, RM(ea)); WM(ea,D);			} /* RES  0,D=(XY+o)  */
+#define Z80XYCB_OP83 { E = RES(0, RM(ea)); WM(ea,E);			} /* RES  0,E=(XY+o)  */
+#define Z80XYCB_OP84 { H = RES(0, RM(ea)); WM(ea,H);			} /* RES  0,H=(XY+o)  */
+#define Z80XYCB_OP85 { L = RES(0, RM(ea)); WM(ea,L);			} /* RES  0,L=(XY+o)  */
+#define Z80XYCB_OP86 { WM(ea, RES(0, RM(ea)));							} /* RES  0,(XY+o)    */
+#define Z80XYCB_OP87 { A = RES(0, RM(ea)); WM(ea,A);			} /* RES  0,A=(XY+o)  */
+
+#define Z80XYCB_OP88 { B = RES(1, RM(ea)); WM(ea,B);			} /* RES  1,B=(XY+o)  */
+#define Z80XYCB_OP89 { C = RES(1, RM(ea)); WM(ea,C);			} /* RES  1,C=(XY+o)  */
+#define Z80XYCB_OP8a { D = RES(1, RM(ea)); WM(ea,D);			} /* RES  1,D=(XY+o)  */
+#define Z80XYCB_OP8b { E = RES(1, RM(ea)); WM(ea,E);			} /* RES  1,E=(XY+o)  */
+#define Z80XYCB_OP8c { H = RES(1, RM(ea)); WM(ea,H);			} /* RES  1,H=(XY+o)  */
+#define Z80XYCB_OP8d { L = RES(1, RM(ea)); WM(ea,L);			} /* RES  1,L=(XY+o)  */
+#define Z80XYCB_OP8e { WM(ea, RES(1, RM(ea)));							} /* RES  1,(XY+o)    */
+#define Z80XYCB_OP8f { A = RES(1, RM(ea)); WM(ea,A);			} /* RES  1,A=(XY+o)  */
+
+#define Z80XYCB_OP90 { B = RES(2, RM(ea)); WM(ea,B);			} /* RES  2,B=(XY+o)  */
+#define Z80XYCB_OP91 { C = RES(2, RM(ea)); WM(ea,C);			} /* RES  2,C=(XY+o)  */
+#define Z80XYCB_OP92 { D = RES(2, RM(ea)); WM(ea,D);			} /* RES  2,D=(XY+o)  */
+#define Z80XYCB_OP93 { E = RES(2, RM(ea)); WM(ea,E);			} /* RES  2,E=(XY+o)  */
+#define Z80XYCB_OP94 { H = RES(2, RM(ea)); WM(ea,H);			} /* RES  2,H=(XY+o)  */
+#define Z80XYCB_OP95 { L = RES(2, RM(ea)); WM(ea,L);			} /* RES  2,L=(XY+o)  */
+#define Z80XYCB_OP96 { WM(ea, RES(2, RM(ea)));							} /* RES  2,(XY+o)    */
+#define Z80XYCB_OP97 { A = RES(2, RM(ea)); WM(ea,A);			} /* RES  2,A=(XY+o)  */
+
+#define Z80XYCB_OP98 { B = RES(3, RM(ea)); WM(ea,B);			} /* RES  3,B=(XY+o)  */
+#define Z80XYCB_OP99 { C = RES(3, RM(ea)); WM(ea,C);			} /* RES  3,C=(XY+o)  */
+#define Z80XYCB_OP9a { D = RES(3, RM(ea)); WM(ea,D);			} /* RES  3,D=(XY+o)  */
+#define Z80XYCB_OP9b { E = RES(3, RM(ea)); WM(ea,E);			} /* RES  3,E=(XY+o)  */
+#define Z80XYCB_OP9c { H = RES(3, RM(ea)); WM(ea,H);			} /* RES  3,H=(XY+o)  */
+#define Z80XYCB_OP9d { L = RES(3, RM(ea)); WM(ea,L);			} /* RES  3,L=(XY+o)  */
+#define Z80XYCB_OP9e { WM(ea, RES(3, RM(ea)));							} /* RES  3,(XY+o)    */
+#define Z80XYCB_OP9f { A = RES(3, RM(ea)); WM(ea,A);			} /* RES  3,A=(XY+o)  */
+
+#define Z80XYCB_OPa0 { B = RES(4, RM(ea)); WM(ea,B);			} /* RES  4,B=(XY+o)  */
+#define Z80XYCB_OPa1 { C = RES(4, RM(ea)); WM(ea,C);			} /* RES  4,C=(XY+o)  */
+#define Z80XYCB_OPa2 { D = RES(4, RM(ea)); WM(ea,D);			} /* RES  4,D=(XY+o)  */
+#define Z80XYCB_OPa3 { E = RES(4, RM(ea)); WM(ea,E);			} /* RES  4,E=(XY+o)  */
+#define Z80XYCB_OPa4 { H = RES(4, RM(ea)); WM(ea,H);			} /* RES  4,H=(XY+o)  */
+#define Z80XYCB_OPa5 { L = RES(4, RM(ea)); WM(ea,L);			} /* RES  4,L=(XY+o)  */
+#define Z80XYCB_OPa6 { WM(ea, RES(4, RM(ea)));							} /* RES  4,(XY+o)    */
+#define Z80XYCB_OPa7 { A = RES(4, RM(ea)); WM(ea,A);			} /* RES  4,A=(XY+o)  */
+
+#define Z80XYCB_OPa8 { B = RES(5, RM(ea)); WM(ea,B);			} /* RES  5,B=(XY+o)  */
+#define Z80XYCB_OPa9 { C = RES(5, RM(ea)); WM(ea,C);			} /* RES  5,C=(XY+o)  */
+#define Z80XYCB_OPaa { D = RES(5, RM(ea)); WM(ea,D);			} /* RES  5,D=(XY+o)  */
+#define Z80XYCB_OPab { E = RES(5, RM(ea)); WM(ea,E);			} /* RES  5,E=(XY+o)  */
+#define Z80XYCB_OPac { H = RES(5, RM(ea)); WM(ea,H);			} /* RES  5,H=(XY+o)  */
+#define Z80XYCB_OPad { L = RES(5, RM(ea)); WM(ea,L);			} /* RES  5,L=(XY+o)  */
+#define Z80XYCB_OPae { WM(ea, RES(5, RM(ea)));							} /* RES  5,(XY+o)    */
+#define Z80XYCB_OPaf { A = RES(5, RM(ea)); WM(ea,A);			} /* RES  5,A=(XY+o)  */
+
+#define Z80XYCB_OPb0 { B = RES(6, RM(ea)); WM(ea,B);			} /* RES  6,B=(XY+o)  */
+#define Z80XYCB_OPb1 { C = RES(6, RM(ea)); WM(ea,C);			} /* RES  6,C=(XY+o)  */
+#define Z80XYCB_OPb2 { D = RES(6, RM(ea)); WM(ea,D);			} /* RES  6,D=(XY+o)  */
+#define Z80XYCB_OPb3 { E = RES(6, RM(ea)); WM(ea,E);			} /* RES  6,E=(XY+o)  */
+#define Z80XYCB_OPb4 { H = RES(6, RM(ea)); WM(ea,H);			} /* RES  6,H=(XY+o)  */
+#define Z80XYCB_OPb5 { L = RES(6, RM(ea)); WM(ea,L);			} /* RES  6,L=(XY+o)  */
+#define Z80XYCB_OPb6 { WM(ea, RES(6, RM(ea)));							} /* RES  6,(XY+o)    */
+#define Z80XYCB_OPb7 { A = RES(6, RM(ea)); WM(ea,A);			} /* RES  6,A=(XY+o)  */
+
+#define Z80XYCB_OPb8 { B = RES(7, RM(ea)); WM(ea,B);			} /* RES  7,B=(XY+o)  */
+#define Z80XYCB_OPb9 { C = RES(7, RM(ea)); WM(ea,C);			} /* RES  7,C=(XY+o)  */
+#define Z80XYCB_OPba { D = RES(7, RM(ea)); WM(ea,D);			} /* RES  7,D=(XY+o)  */
+#define Z80XYCB_OPbb { E = RES(7, RM(ea)); WM(ea,E);			} /* RES  7,E=(XY+o)  */
+#define Z80XYCB_OPbc { H = RES(7, RM(ea)); WM(ea,H);			} /* RES  7,H=(XY+o)  */
+#define Z80XYCB_OPbd { L = RES(7, RM(ea)); WM(ea,L);			} /* RES  7,L=(XY+o)  */
+#define Z80XYCB_OPbe { WM(ea, RES(7, RM(ea)));							} /* RES  7,(XY+o)    */
+#define Z80XYCB_OPbf { A = RES(7, RM(ea)); WM(ea,A);			} /* RES  7,A=(XY+o)  */
+
+#define Z80XYCB_OPc0 { B = SET(0, RM(ea)); WM(ea,B);			} /* SET  0,B=(XY+o)  */
+#define Z80XYCB_OPc1 { C = SET(0, RM(ea)); WM(ea,C);			} /* SET  0,C=(XY+o)  */
+#define Z80XYCB_OPc2 { D = SET(0, RM(ea)); WM(ea,D);			} /* SET  0,D=(XY+o)  */
+#define Z80XYCB_OPc3 { E = SET(0, RM(ea)); WM(ea,E);			} /* SET  0,E=(XY+o)  */
+#define Z80XYCB_OPc4 { H = SET(0, RM(ea)); WM(ea,H);			} /* SET  0,H=(XY+o)  */
+#define Z80XYCB_OPc5 { L = SET(0, RM(ea)); WM(ea,L);			} /* SET  0,L=(XY+o)  */
+#define Z80XYCB_OPc6 { WM(ea, SET(0, RM(ea)));							} /* SET  0,(XY+o)    */
+#define Z80XYCB_OPc7 { A = SET(0, RM(ea)); WM(ea,A);			} /* SET  0,A=(XY+o)  */
+
+#define Z80XYCB_OPc8 { B = SET(1, RM(ea)); WM(ea,B);			} /* SET  1,B=(XY+o)  */
+#define Z80XYCB_OPc9 { C = SET(1, RM(ea)); WM(ea,C);			} /* SET  1,C=(XY+o)  */
+#define Z80XYCB_OPca { D = SET(1, RM(ea)); WM(ea,D);			} /* SET  1,D=(XY+o)  */
+#define Z80XYCB_OPcb { E = SET(1, RM(ea)); WM(ea,E);			} /* SET  1,E=(XY+o)  */
+#define Z80XYCB_OPcc { H = SET(1, RM(ea)); WM(ea,H);			} /* SET  1,H=(XY+o)  */
+#define Z80XYCB_OPcd { L = SET(1, RM(ea)); WM(ea,L);			} /* SET  1,L=(XY+o)  */
+#define Z80XYCB_OPce { WM(ea, SET(1, RM(ea)));							} /* SET  1,(XY+o)    */
+#define Z80XYCB_OPcf { A = SET(1, RM(ea)); WM(ea,A);			} /* SET  1,A=(XY+o)  */
+
+#define Z80XYCB_OPd0 { B = SET(2, RM(ea)); WM(ea,B);			} /* SET  2,B=(XY+o)  */
+#define Z80XYCB_OPd1 { C = SET(2, RM(ea)); WM(ea,C);			} /* SET  2,C=(XY+o)  */
+#define Z80XYCB_OPd2 { D = SET(2, RM(ea)); WM(ea,D);			} /* SET  2,D=(XY+o)  */
+#define Z80XYCB_OPd3 { E = SET(2, RM(ea)); WM(ea,E);			} /* SET  2,E=(XY+o)  */
+#define Z80XYCB_OPd4 { H = SET(2, RM(ea)); WM(ea,H);			} /* SET  2,H=(XY+o)  */
+#define Z80XYCB_OPd5 { L = SET(2, RM(ea)); WM(ea,L);			} /* SET  2,L=(XY+o)  */
+#define Z80XYCB_OPd6 { WM(ea, SET(2, RM(ea)));							} /* SET  2,(XY+o)    */
+#define Z80XYCB_OPd7 { A = SET(2, RM(ea)); WM(ea,A);			} /* SET  2,A=(XY+o)  */
+
+#define Z80XYCB_OPd8 { B = SET(3, RM(ea)); WM(ea,B);			} /* SET  3,B=(XY+o)  */
+#define Z80XYCB_OPd9 { C = SET(3, RM(ea)); WM(ea,C);			} /* SET  3,C=(XY+o)  */
+#define Z80XYCB_OPda { D = SET(3, RM(ea)); WM(ea,D);			} /* SET  3,D=(XY+o)  */
+#define Z80XYCB_OPdb { E = SET(3, RM(ea)); WM(ea,E);			} /* SET  3,E=(XY+o)  */
+#define Z80XYCB_OPdc { H = SET(3, RM(ea)); WM(ea,H);			} /* SET  3,H=(XY+o)  */
+#define Z80XYCB_OPdd { L = SET(3, RM(ea)); WM(ea,L);			} /* SET  3,L=(XY+o)  */
+#define Z80XYCB_OPde { WM(ea, SET(3, RM(ea)));							} /* SET  3,(XY+o)    */
+#define Z80XYCB_OPdf { A = SET(3, RM(ea)); WM(ea,A);			} /* SET  3,A=(XY+o)  */
+
+#define Z80XYCB_OPe0 { B = SET(4, RM(ea)); WM(ea,B);			} /* SET  4,B=(XY+o)  */
+#define Z80XYCB_OPe1 { C = SET(4, RM(ea)); WM(ea,C);			} /* SET  4,C=(XY+o)  */
+#define Z80XYCB_OPe2 { D = SET(4, RM(ea)); WM(ea,D);			} /* SET  4,D=(XY+o)  */
+#define Z80XYCB_OPe3 { E = SET(4, RM(ea)); WM(ea,E);			} /* SET  4,E=(XY+o)  */
+#define Z80XYCB_OPe4 { H = SET(4, RM(ea)); WM(ea,H);			} /* SET  4,H=(XY+o)  */
+#define Z80XYCB_OPe5 { L = SET(4, RM(ea)); WM(ea,L);			} /* SET  4,L=(XY+o)  */
+#define Z80XYCB_OPe6 { WM(ea, SET(4, RM(ea)));							} /* SET  4,(XY+o)    */
+#define Z80XYCB_OPe7 { A = SET(4, RM(ea)); WM(ea,A);			} /* SET  4,A=(XY+o)  */
+
+#define Z80XYCB_OPe8 { B = SET(5, RM(ea)); WM(ea,B);			} /* SET  5,B=(XY+o)  */
+#define Z80XYCB_OPe9 { C = SET(5, RM(ea)); WM(ea,C);			} /* SET  5,C=(XY+o)  */
+#define Z80XYCB_OPea { D = SET(5, RM(ea)); WM(ea,D);			} /* SET  5,D=(XY+o)  */
+#define Z80XYCB_OPeb { E = SET(5, RM(ea)); WM(ea,E);			} /* SET  5,E=(XY+o)  */
+#define Z80XYCB_OPec { H = SET(5, RM(ea)); WM(ea,H);			} /* SET  5,H=(XY+o)  */
+#define Z80XYCB_OPed { L = SET(5, RM(ea)); WM(ea,L);			} /* SET  5,L=(XY+o)  */
+#define Z80XYCB_OPee { WM(ea, SET(5, RM(ea)));							} /* SET  5,(XY+o)    */
+#define Z80XYCB_OPef { A = SET(5, RM(ea)); WM(ea,A);			} /* SET  5,A=(XY+o)  */
+
+#define Z80XYCB_OPf0 { B = SET(6, RM(ea)); WM(ea,B);			} /* SET  6,B=(XY+o)  */
+#define Z80XYCB_OPf1 { C = SET(6, RM(ea)); WM(ea,C);			} /* SET  6,C=(XY+o)  */
+#define Z80XYCB_OPf2 { D = SET(6, RM(ea)); WM(ea,D);			} /* SET  6,D=(XY+o)  */
+#define Z80XYCB_OPf3 { E = SET(6, RM(ea)); WM(ea,E);			} /* SET  6,E=(XY+o)  */
+#define Z80XYCB_OPf4 { H = SET(6, RM(ea)); WM(ea,H);			} /* SET  6,H=(XY+o)  */
+#define Z80XYCB_OPf5 { L = SET(6, RM(ea)); WM(ea,L);			} /* SET  6,L=(XY+o)  */
+#define Z80XYCB_OPf6 { WM(ea, SET(6, RM(ea)));							} /* SET  6,(XY+o)    */
+#define Z80XYCB_OPf7 { A = SET(6, RM(ea)); WM(ea,A);			} /* SET  6,A=(XY+o)  */
+
+#define Z80XYCB_OPf8 { B = SET(7, RM(ea)); WM(ea,B);			} /* SET  7,B=(XY+o)  */
+#define Z80XYCB_OPf9 { C = SET(7, RM(ea)); WM(ea,C);			} /* SET  7,C=(XY+o)  */
+#define Z80XYCB_OPfa { D = SET(7, RM(ea)); WM(ea,D);			} /* SET  7,D=(XY+o)  */
+#define Z80XYCB_OPfb { E = SET(7, RM(ea)); WM(ea,E);			} /* SET  7,E=(XY+o)  */
+#define Z80XYCB_OPfc { H = SET(7, RM(ea)); WM(ea,H);			} /* SET  7,H=(XY+o)  */
+#define Z80XYCB_OPfd { L = SET(7, RM(ea)); WM(ea,L);			} /* SET  7,L=(XY+o)  */
+#define Z80XYCB_OPfe { WM(ea, SET(7, RM(ea)));							} /* SET  7,(XY+o)    */
+#define Z80XYCB_OPff { A = SET(7, RM(ea)); WM(ea,A);			} /* SET  7,A=(XY+o)  */
+
 
 /**********************************************************
  * IX register related opcodes (DD prefix)
  **********************************************************/
-#define Z80_OPdd,00 { illegal_1(z80); op_00(z80);												} /* DB   DD          */
-#define Z80_OPdd,01 { illegal_1(z80); op_01(z80);												} /* DB   DD          */
-#define Z80_OPdd,02 { illegal_1(z80); op_02(z80);												} /* DB   DD          */
-#define Z80_OPdd,03 { illegal_1(z80); op_03(z80);												} /* DB   DD          */
-#define Z80_OPdd,04 { illegal_1(z80); op_04(z80);												} /* DB   DD          */
-#define Z80_OPdd,05 { illegal_1(z80); op_05(z80);												} /* DB   DD          */
-#define Z80_OPdd,06 { illegal_1(z80); op_06(z80);												} /* DB   DD          */
-#define Z80_OPdd,07 { illegal_1(z80); op_07(z80);												} /* DB   DD          */
-
-#define Z80_OPdd,08 { illegal_1(z80); op_08(z80);												} /* DB   DD          */
-#define Z80_OPdd,09 { ADD16(z80, ix, bc);														} /* ADD  IX,BC       */
-#define Z80_OPdd,0a { illegal_1(z80); op_0a(z80);												} /* DB   DD          */
-#define Z80_OPdd,0b { illegal_1(z80); op_0b(z80);												} /* DB   DD          */
-#define Z80_OPdd,0c { illegal_1(z80); op_0c(z80);												} /* DB   DD          */
-#define Z80_OPdd,0d { illegal_1(z80); op_0d(z80);												} /* DB   DD          */
-#define Z80_OPdd,0e { illegal_1(z80); op_0e(z80);												} /* DB   DD          */
-#define Z80_OPdd,0f { illegal_1(z80); op_0f(z80);												} /* DB   DD          */
-
-#define Z80_OPdd,10 { illegal_1(z80); op_10(z80);												} /* DB   DD          */
-#define Z80_OPdd,11 { illegal_1(z80); op_11(z80);												} /* DB   DD          */
-#define Z80_OPdd,12 { illegal_1(z80); op_12(z80);												} /* DB   DD          */
-#define Z80_OPdd,13 { illegal_1(z80); op_13(z80);												} /* DB   DD          */
-#define Z80_OPdd,14 { illegal_1(z80); op_14(z80);												} /* DB   DD          */
-#define Z80_OPdd,15 { illegal_1(z80); op_15(z80);												} /* DB   DD          */
-#define Z80_OPdd,16 { illegal_1(z80); op_16(z80);												} /* DB   DD          */
-#define Z80_OPdd,17 { illegal_1(z80); op_17(z80);												} /* DB   DD          */
-
-#define Z80_OPdd,18 { illegal_1(z80); op_18(z80);												} /* DB   DD          */
-#define Z80_OPdd,19 { ADD16(z80, ix, de);														} /* ADD  IX,DE       */
-#define Z80_OPdd,1a { illegal_1(z80); op_1a(z80);												} /* DB   DD          */
-#define Z80_OPdd,1b { illegal_1(z80); op_1b(z80);												} /* DB   DD          */
-#define Z80_OPdd,1c { illegal_1(z80); op_1c(z80);												} /* DB   DD          */
-#define Z80_OPdd,1d { illegal_1(z80); op_1d(z80);												} /* DB   DD          */
-#define Z80_OPdd,1e { illegal_1(z80); op_1e(z80);												} /* DB   DD          */
-#define Z80_OPdd,1f { illegal_1(z80); op_1f(z80);												} /* DB   DD          */
-
-#define Z80_OPdd,20 { illegal_1(z80); op_20(z80);												} /* DB   DD          */
-#define Z80_OPdd,21 { z80->IX = ARG16(z80);													} /* LD   IX,w        */
-#define Z80_OPdd,22 { z80->ea = ARG16(z80); WM16(z80, z80->ea, &z80->ix);	z80->WZ = z80->ea+1;} /* LD   (w),IX      */
-#define Z80_OPdd,23 { z80->IX++;																} /* INC  IX          */
-#define Z80_OPdd,24 { z80->HX = INC(z80, z80->HX);											} /* INC  HX          */
-#define Z80_OPdd,25 { z80->HX = DEC(z80, z80->HX);											} /* DEC  HX          */
-#define Z80_OPdd,26 { z80->HX = ARG(z80);														} /* LD   HX,n        */
-#define Z80_OPdd,27 { illegal_1(z80); op_27(z80);												} /* DB   DD          */
-
-#define Z80_OPdd,28 { illegal_1(z80); op_28(z80);												} /* DB   DD          */
-#define Z80_OPdd,29 { ADD16(z80, ix, ix);														} /* ADD  IX,IX       */
-#define Z80_OPdd,2a { z80->ea = ARG16(z80); RM16(z80, z80->ea, &z80->ix);	z80->WZ = z80->ea+1;} /* LD   IX,(w)      */
-#define Z80_OPdd,2b { z80->IX--;																} /* DEC  IX          */
-#define Z80_OPdd,2c { z80->LX = INC(z80, z80->LX);											} /* INC  LX          */
-#define Z80_OPdd,2d { z80->LX = DEC(z80, z80->LX);											} /* DEC  LX          */
-#define Z80_OPdd,2e { z80->LX = ARG(z80);														} /* LD   LX,n        */
-#define Z80_OPdd,2f { illegal_1(z80); op_2f(z80);												} /* DB   DD          */
-
-#define Z80_OPdd,30 { illegal_1(z80); op_30(z80);												} /* DB   DD          */
-#define Z80_OPdd,31 { illegal_1(z80); op_31(z80);												} /* DB   DD          */
-#define Z80_OPdd,32 { illegal_1(z80); op_32(z80);												} /* DB   DD          */
-#define Z80_OPdd,33 { illegal_1(z80); op_33(z80);												} /* DB   DD          */
-#define Z80_OPdd,34 { EAX(z80); WM(z80, z80->ea, INC(z80, RM(z80, z80->ea)));					} /* INC  (IX+o)      */
-#define Z80_OPdd,35 { EAX(z80); WM(z80, z80->ea, DEC(z80, RM(z80, z80->ea)));					} /* DEC  (IX+o)      */
-#define Z80_OPdd,36 { EAX(z80); WM(z80, z80->ea, ARG(z80));									} /* LD   (IX+o),n    */
-#define Z80_OPdd,37 { illegal_1(z80); op_37(z80);												} /* DB   DD          */
-
-#define Z80_OPdd,38 { illegal_1(z80); op_38(z80);												} /* DB   DD          */
-#define Z80_OPdd,39 { ADD16(z80, ix, sp);														} /* ADD  IX,SP       */
-#define Z80_OPdd,3a { illegal_1(z80); op_3a(z80);												} /* DB   DD          */
-#define Z80_OPdd,3b { illegal_1(z80); op_3b(z80);												} /* DB   DD          */
-#define Z80_OPdd,3c { illegal_1(z80); op_3c(z80);												} /* DB   DD          */
-#define Z80_OPdd,3d { illegal_1(z80); op_3d(z80);												} /* DB   DD          */
-#define Z80_OPdd,3e { illegal_1(z80); op_3e(z80);												} /* DB   DD          */
-#define Z80_OPdd,3f { illegal_1(z80); op_3f(z80);												} /* DB   DD          */
-
-#define Z80_OPdd,40 { illegal_1(z80); op_40(z80);												} /* DB   DD          */
-#define Z80_OPdd,41 { illegal_1(z80); op_41(z80);												} /* DB   DD          */
-#define Z80_OPdd,42 { illegal_1(z80); op_42(z80);												} /* DB   DD          */
-#define Z80_OPdd,43 { illegal_1(z80); op_43(z80);												} /* DB   DD          */
-#define Z80_OPdd,44 { z80->B = z80->HX;														} /* LD   B,HX        */
-#define Z80_OPdd,45 { z80->B = z80->LX;														} /* LD   B,LX        */
-#define Z80_OPdd,46 { EAX(z80); z80->B = RM(z80, z80->ea);									} /* LD   B,(IX+o)    */
-#define Z80_OPdd,47 { illegal_1(z80); op_47(z80);												} /* DB   DD          */
-
-#define Z80_OPdd,48 { illegal_1(z80); op_48(z80);												} /* DB   DD          */
-#define Z80_OPdd,49 { illegal_1(z80); op_49(z80);												} /* DB   DD          */
-#define Z80_OPdd,4a { illegal_1(z80); op_4a(z80);												} /* DB   DD          */
-#define Z80_OPdd,4b { illegal_1(z80); op_4b(z80);												} /* DB   DD          */
-#define Z80_OPdd,4c { z80->C = z80->HX;														} /* LD   C,HX        */
-#define Z80_OPdd,4d { z80->C = z80->LX;														} /* LD   C,LX        */
-#define Z80_OPdd,4e { EAX(z80); z80->C = RM(z80, z80->ea);									} /* LD   C,(IX+o)    */
-#define Z80_OPdd,4f { illegal_1(z80); op_4f(z80);												} /* DB   DD          */
-
-#define Z80_OPdd,50 { illegal_1(z80); op_50(z80);												} /* DB   DD          */
-#define Z80_OPdd,51 { illegal_1(z80); op_51(z80);												} /* DB   DD          */
-#define Z80_OPdd,52 { illegal_1(z80); op_52(z80);												} /* DB   DD          */
-#define Z80_OPdd,53 { illegal_1(z80); op_53(z80);												} /* DB   DD          */
-#define Z80_OPdd,54 { z80->D = z80->HX;														} /* LD   D,HX        */
-#define Z80_OPdd,55 { z80->D = z80->LX;														} /* LD   D,LX        */
-#define Z80_OPdd,56 { EAX(z80); z80->D = RM(z80, z80->ea);									} /* LD   D,(IX+o)    */
-#define Z80_OPdd,57 { illegal_1(z80); op_57(z80);												} /* DB   DD          */
-
-#define Z80_OPdd,58 { illegal_1(z80); op_58(z80);												} /* DB   DD          */
-#define Z80_OPdd,59 { illegal_1(z80); op_59(z80);												} /* DB   DD          */
-#define Z80_OPdd,5a { illegal_1(z80); op_5a(z80);												} /* DB   DD          */
-#define Z80_OPdd,5b { illegal_1(z80); op_5b(z80);												} /* DB   DD          */
-#define Z80_OPdd,5c { z80->E = z80->HX;														} /* LD   E,HX        */
-#define Z80_OPdd,5d { z80->E = z80->LX;														} /* LD   E,LX        */
-#define Z80_OPdd,5e { EAX(z80); z80->E = RM(z80, z80->ea);									} /* LD   E,(IX+o)    */
-#define Z80_OPdd,5f { illegal_1(z80); op_5f(z80);												} /* DB   DD          */
-
-#define Z80_OPdd,60 { z80->HX = z80->B;														} /* LD   HX,B        */
-#define Z80_OPdd,61 { z80->HX = z80->C;														} /* LD   HX,C        */
-#define Z80_OPdd,62 { z80->HX = z80->D;														} /* LD   HX,D        */
-#define Z80_OPdd,63 { z80->HX = z80->E;														} /* LD   HX,E        */
-#define Z80_OPdd,64 {																			} /* LD   HX,HX       */
-#define Z80_OPdd,65 { z80->HX = z80->LX;														} /* LD   HX,LX       */
-#define Z80_OPdd,66 { EAX(z80); z80->H = RM(z80, z80->ea);									} /* LD   H,(IX+o)    */
-#define Z80_OPdd,67 { z80->HX = z80->A;														} /* LD   HX,A        */
-
-#define Z80_OPdd,68 { z80->LX = z80->B;														} /* LD   LX,B        */
-#define Z80_OPdd,69 { z80->LX = z80->C;														} /* LD   LX,C        */
-#define Z80_OPdd,6a { z80->LX = z80->D;														} /* LD   LX,D        */
-#define Z80_OPdd,6b { z80->LX = z80->E;														} /* LD   LX,E        */
-#define Z80_OPdd,6c { z80->LX = z80->HX;														} /* LD   LX,HX       */
-#define Z80_OPdd,6d {																			} /* LD   LX,LX       */
-#define Z80_OPdd,6e { EAX(z80); z80->L = RM(z80, z80->ea);									} /* LD   L,(IX+o)    */
-#define Z80_OPdd,6f { z80->LX = z80->A;														} /* LD   LX,A        */
-
-#define Z80_OPdd,70 { EAX(z80); WM(z80, z80->ea, z80->B);										} /* LD   (IX+o),B    */
-#define Z80_OPdd,71 { EAX(z80); WM(z80, z80->ea, z80->C);										} /* LD   (IX+o),C    */
-#define Z80_OPdd,72 { EAX(z80); WM(z80, z80->ea, z80->D);										} /* LD   (IX+o),D    */
-#define Z80_OPdd,73 { EAX(z80); WM(z80, z80->ea, z80->E);										} /* LD   (IX+o),E    */
-#define Z80_OPdd,74 { EAX(z80); WM(z80, z80->ea, z80->H);										} /* LD   (IX+o),H    */
-#define Z80_OPdd,75 { EAX(z80); WM(z80, z80->ea, z80->L);										} /* LD   (IX+o),L    */
-#define Z80_OPdd,76 { illegal_1(z80); op_76(z80);												} /* DB   DD          */
-#define Z80_OPdd,77 { EAX(z80); WM(z80, z80->ea, z80->A);										} /* LD   (IX+o),A    */
-
-#define Z80_OPdd,78 { illegal_1(z80); op_78(z80);												} /* DB   DD          */
-#define Z80_OPdd,79 { illegal_1(z80); op_79(z80);												} /* DB   DD          */
-#define Z80_OPdd,7a { illegal_1(z80); op_7a(z80);												} /* DB   DD          */
-#define Z80_OPdd,7b { illegal_1(z80); op_7b(z80);												} /* DB   DD          */
-#define Z80_OPdd,7c { z80->A = z80->HX;														} /* LD   A,HX        */
-#define Z80_OPdd,7d { z80->A = z80->LX;														} /* LD   A,LX        */
-#define Z80_OPdd,7e { EAX(z80); z80->A = RM(z80, z80->ea);									} /* LD   A,(IX+o)    */
-#define Z80_OPdd,7f { illegal_1(z80); op_7f(z80);												} /* DB   DD          */
-
-#define Z80_OPdd,80 { illegal_1(z80); op_80(z80);												} /* DB   DD          */
-#define Z80_OPdd,81 { illegal_1(z80); op_81(z80);												} /* DB   DD          */
-#define Z80_OPdd,82 { illegal_1(z80); op_82(z80);												} /* DB   DD          */
-#define Z80_OPdd,83 { illegal_1(z80); op_83(z80);												} /* DB   DD          */
-#define Z80_OPdd,84 { ADD(z80, z80->HX);														} /* ADD  A,HX        */
-#define Z80_OPdd,85 { ADD(z80, z80->LX);														} /* ADD  A,LX        */
-#define Z80_OPdd,86 { EAX(z80); ADD(z80, RM(z80, z80->ea));									} /* ADD  A,(IX+o)    */
-#define Z80_OPdd,87 { illegal_1(z80); op_87(z80);												} /* DB   DD          */
-
-#define Z80_OPdd,88 { illegal_1(z80); op_88(z80);												} /* DB   DD          */
-#define Z80_OPdd,89 { illegal_1(z80); op_89(z80);												} /* DB   DD          */
-#define Z80_OPdd,8a { illegal_1(z80); op_8a(z80);												} /* DB   DD          */
-#define Z80_OPdd,8b { illegal_1(z80); op_8b(z80);												} /* DB   DD          */
-#define Z80_OPdd,8c { ADC(z80, z80->HX);														} /* ADC  A,HX        */
-#define Z80_OPdd,8d { ADC(z80, z80->LX);														} /* ADC  A,LX        */
-#define Z80_OPdd,8e { EAX(z80); ADC(z80, RM(z80, z80->ea));									} /* ADC  A,(IX+o)    */
-#define Z80_OPdd,8f { illegal_1(z80); op_8f(z80);												} /* DB   DD          */
-
-#define Z80_OPdd,90 { illegal_1(z80); op_90(z80);												} /* DB   DD          */
-#define Z80_OPdd,91 { illegal_1(z80); op_91(z80);												} /* DB   DD          */
-#define Z80_OPdd,92 { illegal_1(z80); op_92(z80);												} /* DB   DD          */
-#define Z80_OPdd,93 { illegal_1(z80); op_93(z80);												} /* DB   DD          */
-#define Z80_OPdd,94 { SUB(z80, z80->HX);														} /* SUB  HX          */
-#define Z80_OPdd,95 { SUB(z80, z80->LX);														} /* SUB  LX          */
-#define Z80_OPdd,96 { EAX(z80); SUB(z80, RM(z80, z80->ea));									} /* SUB  (IX+o)      */
-#define Z80_OPdd,97 { illegal_1(z80); op_97(z80);												} /* DB   DD          */
-
-#define Z80_OPdd,98 { illegal_1(z80); op_98(z80);												} /* DB   DD          */
-#define Z80_OPdd,99 { illegal_1(z80); op_99(z80);												} /* DB   DD          */
-#define Z80_OPdd,9a { illegal_1(z80); op_9a(z80);												} /* DB   DD          */
-#define Z80_OPdd,9b { illegal_1(z80); op_9b(z80);												} /* DB   DD          */
-#define Z80_OPdd,9c { SBC(z80, z80->HX);														} /* SBC  A,HX        */
-#define Z80_OPdd,9d { SBC(z80, z80->LX);														} /* SBC  A,LX        */
-#define Z80_OPdd,9e { EAX(z80); SBC(z80, RM(z80, z80->ea));									} /* SBC  A,(IX+o)    */
-#define Z80_OPdd,9f { illegal_1(z80); op_9f(z80);												} /* DB   DD          */
-
-#define Z80_OPdd,a0 { illegal_1(z80); op_a0(z80);												} /* DB   DD          */
-#define Z80_OPdd,a1 { illegal_1(z80); op_a1(z80);												} /* DB   DD          */
-#define Z80_OPdd,a2 { illegal_1(z80); op_a2(z80);												} /* DB   DD          */
-#define Z80_OPdd,a3 { illegal_1(z80); op_a3(z80);												} /* DB   DD          */
-#define Z80_OPdd,a4 { AND(z80, z80->HX);														} /* AND  HX          */
-#define Z80_OPdd,a5 { AND(z80, z80->LX);														} /* AND  LX          */
-#define Z80_OPdd,a6 { EAX(z80); AND(z80, RM(z80, z80->ea));									} /* AND  (IX+o)      */
-#define Z80_OPdd,a7 { illegal_1(z80); op_a7(z80);												} /* DB   DD          */
-
-#define Z80_OPdd,a8 { illegal_1(z80); op_a8(z80);												} /* DB   DD          */
-#define Z80_OPdd,a9 { illegal_1(z80); op_a9(z80);												} /* DB   DD          */
-#define Z80_OPdd,aa { illegal_1(z80); op_aa(z80);												} /* DB   DD          */
-#define Z80_OPdd,ab { illegal_1(z80); op_ab(z80);												} /* DB   DD          */
-#define Z80_OPdd,ac { XOR(z80, z80->HX);														} /* XOR  HX          */
-#define Z80_OPdd,ad { XOR(z80, z80->LX);														} /* XOR  LX          */
-#define Z80_OPdd,ae { EAX(z80); XOR(z80, RM(z80, z80->ea));									} /* XOR  (IX+o)      */
-#define Z80_OPdd,af { illegal_1(z80); op_af(z80);												} /* DB   DD          */
-
-#define Z80_OPdd,b0 { illegal_1(z80); op_b0(z80);												} /* DB   DD          */
-#define Z80_OPdd,b1 { illegal_1(z80); op_b1(z80);												} /* DB   DD          */
-#define Z80_OPdd,b2 { illegal_1(z80); op_b2(z80);												} /* DB   DD          */
-#define Z80_OPdd,b3 { illegal_1(z80); op_b3(z80);												} /* DB   DD          */
-#define Z80_OPdd,b4 { OR(z80, z80->HX);														} /* OR   HX          */
-#define Z80_OPdd,b5 { OR(z80, z80->LX);														} /* OR   LX          */
-#define Z80_OPdd,b6 { EAX(z80); OR(z80, RM(z80, z80->ea));									} /* OR   (IX+o)      */
-#define Z80_OPdd,b7 { illegal_1(z80); op_b7(z80);												} /* DB   DD          */
-
-#define Z80_OPdd,b8 { illegal_1(z80); op_b8(z80);												} /* DB   DD          */
-#define Z80_OPdd,b9 { illegal_1(z80); op_b9(z80);												} /* DB   DD          */
-#define Z80_OPdd,ba { illegal_1(z80); op_ba(z80);												} /* DB   DD          */
-#define Z80_OPdd,bb { illegal_1(z80); op_bb(z80);												} /* DB   DD          */
-#define Z80_OPdd,bc { CP(z80, z80->HX);														} /* CP   HX          */
-#define Z80_OPdd,bd { CP(z80, z80->LX);														} /* CP   LX          */
-#define Z80_OPdd,be { EAX(z80); CP(z80, RM(z80, z80->ea));									} /* CP   (IX+o)      */
-#define Z80_OPdd,bf { illegal_1(z80); op_bf(z80);												} /* DB   DD          */
-
-#define Z80_OPdd,c0 { illegal_1(z80); op_c0(z80);												} /* DB   DD          */
-#define Z80_OPdd,c1 { illegal_1(z80); op_c1(z80);												} /* DB   DD          */
-#define Z80_OPdd,c2 { illegal_1(z80); op_c2(z80);												} /* DB   DD          */
-#define Z80_OPdd,c3 { illegal_1(z80); op_c3(z80);												} /* DB   DD          */
-#define Z80_OPdd,c4 { illegal_1(z80); op_c4(z80);												} /* DB   DD          */
-#define Z80_OPdd,c5 { illegal_1(z80); op_c5(z80);												} /* DB   DD          */
-#define Z80_OPdd,c6 { illegal_1(z80); op_c6(z80);												} /* DB   DD          */
-#define Z80_OPdd,c7 { illegal_1(z80); op_c7(z80);												} /* DB   DD          */
-
-#define Z80_OPdd,c8 { illegal_1(z80); op_c8(z80);												} /* DB   DD          */
-#define Z80_OPdd,c9 { illegal_1(z80); op_c9(z80);												} /* DB   DD          */
-#define Z80_OPdd,ca { illegal_1(z80); op_ca(z80);												} /* DB   DD          */
-#define Z80_OPdd,cb { EAX(z80); EXEC(z80,xycb,ARG(z80));										} /* **   DD CB xx    */
-#define Z80_OPdd,cc { illegal_1(z80); op_cc(z80);												} /* DB   DD          */
-#define Z80_OPdd,cd { illegal_1(z80); op_cd(z80);												} /* DB   DD          */
-#define Z80_OPdd,ce { illegal_1(z80); op_ce(z80);												} /* DB   DD          */
-#define Z80_OPdd,cf { illegal_1(z80); op_cf(z80);												} /* DB   DD          */
-
-#define Z80_OPdd,d0 { illegal_1(z80); op_d0(z80);												} /* DB   DD          */
-#define Z80_OPdd,d1 { illegal_1(z80); op_d1(z80);												} /* DB   DD          */
-#define Z80_OPdd,d2 { illegal_1(z80); op_d2(z80);												} /* DB   DD          */
-#define Z80_OPdd,d3 { illegal_1(z80); op_d3(z80);												} /* DB   DD          */
-#define Z80_OPdd,d4 { illegal_1(z80); op_d4(z80);												} /* DB   DD          */
-#define Z80_OPdd,d5 { illegal_1(z80); op_d5(z80);												} /* DB   DD          */
-#define Z80_OPdd,d6 { illegal_1(z80); op_d6(z80);												} /* DB   DD          */
-#define Z80_OPdd,d7 { illegal_1(z80); op_d7(z80);												} /* DB   DD          */
-
-#define Z80_OPdd,d8 { illegal_1(z80); op_d8(z80);												} /* DB   DD          */
-#define Z80_OPdd,d9 { illegal_1(z80); op_d9(z80);												} /* DB   DD          */
-#define Z80_OPdd,da { illegal_1(z80); op_da(z80);												} /* DB   DD          */
-#define Z80_OPdd,db { illegal_1(z80); op_db(z80);												} /* DB   DD          */
-#define Z80_OPdd,dc { illegal_1(z80); op_dc(z80);												} /* DB   DD          */
-#define Z80_OPdd,dd { illegal_1(z80); op_dd(z80);												} /* DB   DD          */
-#define Z80_OPdd,de { illegal_1(z80); op_de(z80);												} /* DB   DD          */
-#define Z80_OPdd,df { illegal_1(z80); op_df(z80);												} /* DB   DD          */
-
-#define Z80_OPdd,e0 { illegal_1(z80); op_e0(z80);												} /* DB   DD          */
-#define Z80_OPdd,e1 { P#define Z80_OPz80, ix);															} /* POP  IX          */
-#define Z80_OPdd,e2 { illegal_1(z80); op_e2(z80);												} /* DB   DD          */
-#define Z80_OPdd,e3 { EXSP(z80, ix);															} /* EX   (SP),IX     */
-#define Z80_OPdd,e4 { illegal_1(z80); op_e4(z80);												} /* DB   DD          */
-#define Z80_OPdd,e5 { PUSH(z80, ix);															} /* PUSH IX          */
-#define Z80_OPdd,e6 { illegal_1(z80); op_e6(z80);												} /* DB   DD          */
-#define Z80_OPdd,e7 { illegal_1(z80); op_e7(z80);												} /* DB   DD          */
-
-#define Z80_OPdd,e8 { illegal_1(z80); op_e8(z80);												} /* DB   DD          */
-#define Z80_OPdd,e9 { z80->PC = z80->IX;														} /* JP   (IX)        */
-#define Z80_OPdd,ea { illegal_1(z80); op_ea(z80);												} /* DB   DD          */
-#define Z80_OPdd,eb { illegal_1(z80); op_eb(z80);												} /* DB   DD          */
-#define Z80_OPdd,ec { illegal_1(z80); op_ec(z80);												} /* DB   DD          */
-#define Z80_OPdd,ed { illegal_1(z80); op_ed(z80);												} /* DB   DD          */
-#define Z80_OPdd,ee { illegal_1(z80); op_ee(z80);												} /* DB   DD          */
-#define Z80_OPdd,ef { illegal_1(z80); op_ef(z80);												} /* DB   DD          */
-
-#define Z80_OPdd,f0 { illegal_1(z80); op_f0(z80);												} /* DB   DD          */
-#define Z80_OPdd,f1 { illegal_1(z80); op_f1(z80);												} /* DB   DD          */
-#define Z80_OPdd,f2 { illegal_1(z80); op_f2(z80);												} /* DB   DD          */
-#define Z80_OPdd,f3 { illegal_1(z80); op_f3(z80);												} /* DB   DD          */
-#define Z80_OPdd,f4 { illegal_1(z80); op_f4(z80);												} /* DB   DD          */
-#define Z80_OPdd,f5 { illegal_1(z80); op_f5(z80);												} /* DB   DD          */
-#define Z80_OPdd,f6 { illegal_1(z80); op_f6(z80);												} /* DB   DD          */
-#define Z80_OPdd,f7 { illegal_1(z80); op_f7(z80);												} /* DB   DD          */
-
-#define Z80_OPdd,f8 { illegal_1(z80); op_f8(z80);												} /* DB   DD          */
-#define Z80_OPdd,f9 { z80->SP = z80->IX;														} /* LD   SP,IX       */
-#define Z80_OPdd,fa { illegal_1(z80); op_fa(z80);												} /* DB   DD          */
-#define Z80_OPdd,fb { illegal_1(z80); op_fb(z80);												} /* DB   DD          */
-#define Z80_OPdd,fc { illegal_1(z80); op_fc(z80);												} /* DB   DD          */
-#define Z80_OPdd,fd { illegal_1(z80); op_fd(z80);												} /* DB   DD          */
-#define Z80_OPdd,fe { illegal_1(z80); op_fe(z80);												} /* DB   DD          */
-#define Z80_OPdd,ff { illegal_1(z80); op_ff(z80);												} /* DB   DD          */
+#define Z80DD_OP00 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP01 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP02 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP03 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP04 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP05 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP06 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP07 { XY_IGNORE();												} /* DB   DD          */
+
+#define Z80DD_OP08 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP09 { ADD16(ix, bc);														} /* ADD  IX,BC       */
+#define Z80DD_OP0a { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP0b { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP0c { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP0d { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP0e { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP0f { XY_IGNORE();												} /* DB   DD          */
+
+#define Z80DD_OP10 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP11 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP12 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP13 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP14 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP15 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP16 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP17 { XY_IGNORE();												} /* DB   DD          */
+
+#define Z80DD_OP18 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP19 { ADD16(ix, de);														} /* ADD  IX,DE       */
+#define Z80DD_OP1a { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP1b { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP1c { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP1d { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP1e { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP1f { XY_IGNORE();												} /* DB   DD          */
+
+#define Z80DD_OP20 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP21 { IX = ARG16();													} /* LD   IX,w        */
+#define Z80DD_OP22 { ea = ARG16(); WM16(ea, &ix);	WZ = ea+1;} /* LD   (w),IX      */
+#define Z80DD_OP23 { IX++;																} /* INC  IX          */
+#define Z80DD_OP24 { HX = INC(HX);											} /* INC  HX          */
+#define Z80DD_OP25 { HX = DEC(HX);											} /* DEC  HX          */
+#define Z80DD_OP26 { HX = ARG();														} /* LD   HX,n        */
+#define Z80DD_OP27 { XY_IGNORE();												} /* DB   DD          */
+
+#define Z80DD_OP28 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP29 { ADD16(ix, ix);														} /* ADD  IX,IX       */
+#define Z80DD_OP2a { ea = ARG16(); RM16(ea, &ix);	WZ = ea+1;} /* LD   IX,(w)      */
+#define Z80DD_OP2b { IX--;																} /* DEC  IX          */
+#define Z80DD_OP2c { LX = INC(LX);											} /* INC  LX          */
+#define Z80DD_OP2d { LX = DEC(LX);											} /* DEC  LX          */
+#define Z80DD_OP2e { LX = ARG();														} /* LD   LX,n        */
+#define Z80DD_OP2f { XY_IGNORE();												} /* DB   DD          */
+
+#define Z80DD_OP30 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP31 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP32 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP33 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP34 { EAX(); WM(ea, INC(RM(ea)));					} /* INC  (IX+o)      */
+#define Z80DD_OP35 { EAX(); WM(ea, DEC(RM(ea)));					} /* DEC  (IX+o)      */
+#define Z80DD_OP36 { EAX(); WM(ea, ARG());									} /* LD   (IX+o),n    */
+#define Z80DD_OP37 { XY_IGNORE();												} /* DB   DD          */
+
+#define Z80DD_OP38 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP39 { ADD16(ix, sp);														} /* ADD  IX,SP       */
+#define Z80DD_OP3a { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP3b { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP3c { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP3d { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP3e { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP3f { XY_IGNORE();												} /* DB   DD          */
+
+#define Z80DD_OP40 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP41 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP42 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP43 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP44 { B = HX;														} /* LD   B,HX        */
+#define Z80DD_OP45 { B = LX;														} /* LD   B,LX        */
+#define Z80DD_OP46 { EAX(); B = RM(ea);									} /* LD   B,(IX+o)    */
+#define Z80DD_OP47 { XY_IGNORE();												} /* DB   DD          */
+
+#define Z80DD_OP48 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP49 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP4a { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP4b { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP4c { C = HX;														} /* LD   C,HX        */
+#define Z80DD_OP4d { C = LX;														} /* LD   C,LX        */
+#define Z80DD_OP4e { EAX(); C = RM(ea);									} /* LD   C,(IX+o)    */
+#define Z80DD_OP4f { XY_IGNORE();												} /* DB   DD          */
+
+#define Z80DD_OP50 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP51 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP52 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP53 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP54 { D = HX;														} /* LD   D,HX        */
+#define Z80DD_OP55 { D = LX;														} /* LD   D,LX        */
+#define Z80DD_OP56 { EAX(); D = RM(ea);									} /* LD   D,(IX+o)    */
+#define Z80DD_OP57 { XY_IGNORE();												} /* DB   DD          */
+
+#define Z80DD_OP58 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP59 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP5a { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP5b { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP5c { E = HX;														} /* LD   E,HX        */
+#define Z80DD_OP5d { E = LX;														} /* LD   E,LX        */
+#define Z80DD_OP5e { EAX(); E = RM(ea);									} /* LD   E,(IX+o)    */
+#define Z80DD_OP5f { XY_IGNORE();												} /* DB   DD          */
+
+#define Z80DD_OP60 { HX = B;														} /* LD   HX,B        */
+#define Z80DD_OP61 { HX = C;														} /* LD   HX,C        */
+#define Z80DD_OP62 { HX = D;														} /* LD   HX,D        */
+#define Z80DD_OP63 { HX = E;														} /* LD   HX,E        */
+#define Z80DD_OP64 {																			} /* LD   HX,HX       */
+#define Z80DD_OP65 { HX = LX;														} /* LD   HX,LX       */
+#define Z80DD_OP66 { EAX(); H = RM(ea);									} /* LD   H,(IX+o)    */
+#define Z80DD_OP67 { HX = A;														} /* LD   HX,A        */
+
+#define Z80DD_OP68 { LX = B;														} /* LD   LX,B        */
+#define Z80DD_OP69 { LX = C;														} /* LD   LX,C        */
+#define Z80DD_OP6a { LX = D;														} /* LD   LX,D        */
+#define Z80DD_OP6b { LX = E;														} /* LD   LX,E        */
+#define Z80DD_OP6c { LX = HX;														} /* LD   LX,HX       */
+#define Z80DD_OP6d {																			} /* LD   LX,LX       */
+#define Z80DD_OP6e { EAX(); L = RM(ea);									} /* LD   L,(IX+o)    */
+#define Z80DD_OP6f { LX = A;														} /* LD   LX,A        */
+
+#define Z80DD_OP70 { EAX(); WM(ea, B);										} /* LD   (IX+o),B    */
+#define Z80DD_OP71 { EAX(); WM(ea, C);										} /* LD   (IX+o),C    */
+#define Z80DD_OP72 { EAX(); WM(ea, D);										} /* LD   (IX+o),D    */
+#define Z80DD_OP73 { EAX(); WM(ea, E);										} /* LD   (IX+o),E    */
+#define Z80DD_OP74 { EAX(); WM(ea, H);										} /* LD   (IX+o),H    */
+#define Z80DD_OP75 { EAX(); WM(ea, L);										} /* LD   (IX+o),L    */
+#define Z80DD_OP76 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP77 { EAX(); WM(ea, A);										} /* LD   (IX+o),A    */
+
+#define Z80DD_OP78 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP79 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP7a { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP7b { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP7c { A = HX;														} /* LD   A,HX        */
+#define Z80DD_OP7d { A = LX;														} /* LD   A,LX        */
+#define Z80DD_OP7e { EAX(); A = RM(ea);									} /* LD   A,(IX+o)    */
+#define Z80DD_OP7f { XY_IGNORE();												} /* DB   DD          */
+
+#define Z80DD_OP80 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP81 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP82 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP83 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP84 { ADD(HX);														} /* ADD  A,HX        */
+#define Z80DD_OP85 { ADD(LX);														} /* ADD  A,LX        */
+#define Z80DD_OP86 { EAX(); ADD(RM(ea));									} /* ADD  A,(IX+o)    */
+#define Z80DD_OP87 { XY_IGNORE();												} /* DB   DD          */
+
+#define Z80DD_OP88 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP89 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP8a { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP8b { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP8c { ADC(HX);														} /* ADC  A,HX        */
+#define Z80DD_OP8d { ADC(LX);														} /* ADC  A,LX        */
+#define Z80DD_OP8e { EAX(); ADC(RM(ea));									} /* ADC  A,(IX+o)    */
+#define Z80DD_OP8f { XY_IGNORE();												} /* DB   DD          */
+
+#define Z80DD_OP90 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP91 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP92 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP93 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP94 { SUB(HX);														} /* SUB  HX          */
+#define Z80DD_OP95 { SUB(LX);														} /* SUB  LX          */
+#define Z80DD_OP96 { EAX(); SUB(RM(ea));									} /* SUB  (IX+o)      */
+#define Z80DD_OP97 { XY_IGNORE();												} /* DB   DD          */
+
+#define Z80DD_OP98 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP99 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP9a { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP9b { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OP9c { SBC(HX);														} /* SBC  A,HX        */
+#define Z80DD_OP9d { SBC(LX);														} /* SBC  A,LX        */
+#define Z80DD_OP9e { EAX(); SBC(RM(ea));									} /* SBC  A,(IX+o)    */
+#define Z80DD_OP9f { XY_IGNORE();												} /* DB   DD          */
+
+#define Z80DD_OPa0 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPa1 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPa2 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPa3 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPa4 { AND(HX);														} /* AND  HX          */
+#define Z80DD_OPa5 { AND(LX);														} /* AND  LX          */
+#define Z80DD_OPa6 { EAX(); AND(RM(ea));									} /* AND  (IX+o)      */
+#define Z80DD_OPa7 { XY_IGNORE();												} /* DB   DD          */
+
+#define Z80DD_OPa8 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPa9 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPaa { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPab { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPac { XOR(HX);														} /* XOR  HX          */
+#define Z80DD_OPad { XOR(LX);														} /* XOR  LX          */
+#define Z80DD_OPae { EAX(); XOR(RM(ea));									} /* XOR  (IX+o)      */
+#define Z80DD_OPaf { XY_IGNORE();												} /* DB   DD          */
+
+#define Z80DD_OPb0 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPb1 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPb2 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPb3 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPb4 { OR(HX);														} /* OR   HX          */
+#define Z80DD_OPb5 { OR(LX);														} /* OR   LX          */
+#define Z80DD_OPb6 { EAX(); OR(RM(ea));									} /* OR   (IX+o)      */
+#define Z80DD_OPb7 { XY_IGNORE();												} /* DB   DD          */
+
+#define Z80DD_OPb8 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPb9 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPba { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPbb { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPbc { CP(HX);														} /* CP   HX          */
+#define Z80DD_OPbd { CP(LX);														} /* CP   LX          */
+#define Z80DD_OPbe { EAX(); CP(RM(ea));									} /* CP   (IX+o)      */
+#define Z80DD_OPbf { XY_IGNORE();												} /* DB   DD          */
+
+#define Z80DD_OPc0 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPc1 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPc2 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPc3 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPc4 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPc5 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPc6 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPc7 { XY_IGNORE();												} /* DB   DD          */
+
+#define Z80DD_OPc8 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPc9 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPca { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPcb { EAX(); Z80_EXECUTE_XYCB();										} /* **   DD CB xx    */
+#define Z80DD_OPcc { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPcd { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPce { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPcf { XY_IGNORE();												} /* DB   DD          */
+
+#define Z80DD_OPd0 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPd1 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPd2 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPd3 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPd4 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPd5 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPd6 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPd7 { XY_IGNORE();												} /* DB   DD          */
+
+#define Z80DD_OPd8 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPd9 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPda { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPdb { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPdc { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPdd { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPde { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPdf { XY_IGNORE();												} /* DB   DD          */
+
+#define Z80DD_OPe0 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPe1 { POP(ix);															} /* POP  IX          */
+#define Z80DD_OPe2 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPe3 { EXSP(ix);															} /* EX   (SP),IX     */
+#define Z80DD_OPe4 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPe5 { PUSH(ix);															} /* PUSH IX          */
+#define Z80DD_OPe6 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPe7 { XY_IGNORE();												} /* DB   DD          */
+
+#define Z80DD_OPe8 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPe9 { PC = IX;														} /* JP   (IX)        */
+#define Z80DD_OPea { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPeb { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPec { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPed { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPee { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPef { XY_IGNORE();												} /* DB   DD          */
+
+#define Z80DD_OPf0 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPf1 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPf2 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPf3 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPf4 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPf5 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPf6 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPf7 { XY_IGNORE();												} /* DB   DD          */
+
+#define Z80DD_OPf8 { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPf9 { SP = IX;														} /* LD   SP,IX       */
+#define Z80DD_OPfa { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPfb { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPfc { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPfd { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPfe { XY_IGNORE();												} /* DB   DD          */
+#define Z80DD_OPff { XY_IGNORE();												} /* DB   DD          */
 
 /**********************************************************
  * IY register related opcodes (FD prefix)
  **********************************************************/
-#define Z80_OPfd_00 { illegal_1(z80); op_00(z80);												} /* DB   FD          */
-#define Z80_OPfd_01 { illegal_1(z80); op_01(z80);												} /* DB   FD          */
-#define Z80_OPfd_02 { illegal_1(z80); op_02(z80);												} /* DB   FD          */
-#define Z80_OPfd_03 { illegal_1(z80); op_03(z80);												} /* DB   FD          */
-#define Z80_OPfd_04 { illegal_1(z80); op_04(z80);												} /* DB   FD          */
-#define Z80_OPfd_05 { illegal_1(z80); op_05(z80);												} /* DB   FD          */
-#define Z80_OPfd_06 { illegal_1(z80); op_06(z80);												} /* DB   FD          */
-#define Z80_OPfd_07 { illegal_1(z80); op_07(z80);												} /* DB   FD          */
-
-#define Z80_OPfd_08 { illegal_1(z80); op_08(z80);												} /* DB   FD          */
-#define Z80_OPfd_09 { ADD16(z80, iy, bc);														} /* ADD  IY,BC       */
-#define Z80_OPfd_0a { illegal_1(z80); op_0a(z80);												} /* DB   FD          */
-#define Z80_OPfd_0b { illegal_1(z80); op_0b(z80);												} /* DB   FD          */
-#define Z80_OPfd_0c { illegal_1(z80); op_0c(z80);												} /* DB   FD          */
-#define Z80_OPfd_0d { illegal_1(z80); op_0d(z80);												} /* DB   FD          */
-#define Z80_OPfd_0e { illegal_1(z80); op_0e(z80);												} /* DB   FD          */
-#define Z80_OPfd_0f { illegal_1(z80); op_0f(z80);												} /* DB   FD          */
-
-#define Z80_OPfd_10 { illegal_1(z80); op_10(z80);												} /* DB   FD          */
-#define Z80_OPfd_11 { illegal_1(z80); op_11(z80);												} /* DB   FD          */
-#define Z80_OPfd_12 { illegal_1(z80); op_12(z80);												} /* DB   FD          */
-#define Z80_OPfd_13 { illegal_1(z80); op_13(z80);												} /* DB   FD          */
-#define Z80_OPfd_14 { illegal_1(z80); op_14(z80);												} /* DB   FD          */
-#define Z80_OPfd_15 { illegal_1(z80); op_15(z80);												} /* DB   FD          */
-#define Z80_OPfd_16 { illegal_1(z80); op_16(z80);												} /* DB   FD          */
-#define Z80_OPfd_17 { illegal_1(z80); op_17(z80);												} /* DB   FD          */
-
-#define Z80_OPfd_18 { illegal_1(z80); op_18(z80);												} /* DB   FD          */
-#define Z80_OPfd_19 { ADD16(z80, iy, de);														} /* ADD  IY,DE       */
-#define Z80_OPfd_1a { illegal_1(z80); op_1a(z80);												} /* DB   FD          */
-#define Z80_OPfd_1b { illegal_1(z80); op_1b(z80);												} /* DB   FD          */
-#define Z80_OPfd_1c { illegal_1(z80); op_1c(z80);												} /* DB   FD          */
-#define Z80_OPfd_1d { illegal_1(z80); op_1d(z80);												} /* DB   FD          */
-#define Z80_OPfd_1e { illegal_1(z80); op_1e(z80);												} /* DB   FD          */
-#define Z80_OPfd_1f { illegal_1(z80); op_1f(z80);												} /* DB   FD          */
-
-#define Z80_OPfd_20 { illegal_1(z80); op_20(z80);												} /* DB   FD          */
-#define Z80_OPfd_21 { z80->IY = ARG16(z80);													} /* LD   IY,w        */
-#define Z80_OPfd_22 { z80->ea = ARG16(z80); WM16(z80, z80->ea, &z80->iy); z80->WZ = z80->ea+1;} /* LD   (w),IY      */
-#define Z80_OPfd_23 { z80->IY++;																} /* INC  IY          */
-#define Z80_OPfd_24 { z80->HY = INC(z80, z80->HY);											} /* INC  HY          */
-#define Z80_OPfd_25 { z80->HY = DEC(z80, z80->HY);											} /* DEC  HY          */
-#define Z80_OPfd_26 { z80->HY = ARG(z80);														} /* LD   HY,n        */
-#define Z80_OPfd_27 { illegal_1(z80); op_27(z80);												} /* DB   FD          */
-
-#define Z80_OPfd_28 { illegal_1(z80); op_28(z80);												} /* DB   FD          */
-#define Z80_OPfd_29 { ADD16(z80, iy, iy);														} /* ADD  IY,IY       */
-#define Z80_OPfd_2a { z80->ea = ARG16(z80); RM16(z80, z80->ea, &z80->iy); z80->WZ = z80->ea+1;} /* LD   IY,(w)      */
-#define Z80_OPfd_2b { z80->IY--;																} /* DEC  IY          */
-#define Z80_OPfd_2c { z80->LY = INC(z80, z80->LY);											} /* INC  LY          */
-#define Z80_OPfd_2d { z80->LY = DEC(z80, z80->LY);											} /* DEC  LY          */
-#define Z80_OPfd_2e { z80->LY = ARG(z80);														} /* LD   LY,n        */
-#define Z80_OPfd_2f { illegal_1(z80); op_2f(z80);												} /* DB   FD          */
-
-#define Z80_OPfd_30 { illegal_1(z80); op_30(z80);												} /* DB   FD          */
-#define Z80_OPfd_31 { illegal_1(z80); op_31(z80);												} /* DB   FD          */
-#define Z80_OPfd_32 { illegal_1(z80); op_32(z80);												} /* DB   FD          */
-#define Z80_OPfd_33 { illegal_1(z80); op_33(z80);												} /* DB   FD          */
-#define Z80_OPfd_34 { EAY(z80); WM(z80, z80->ea, INC(z80, RM(z80, z80->ea)));					} /* INC  (IY+o)      */
-#define Z80_OPfd_35 { EAY(z80); WM(z80, z80->ea, DEC(z80, RM(z80, z80->ea)));					} /* DEC  (IY+o)      */
-#define Z80_OPfd_36 { EAY(z80); WM(z80, z80->ea, ARG(z80));									} /* LD   (IY+o),n    */
-#define Z80_OPfd_37 { illegal_1(z80); op_37(z80);												} /* DB   FD          */
-
-#define Z80_OPfd_38 { illegal_1(z80); op_38(z80);												} /* DB   FD          */
-#define Z80_OPfd_39 { ADD16(z80, iy, sp);														} /* ADD  IY,SP       */
-#define Z80_OPfd_3a { illegal_1(z80); op_3a(z80);												} /* DB   FD          */
-#define Z80_OPfd_3b { illegal_1(z80); op_3b(z80);												} /* DB   FD          */
-#define Z80_OPfd_3c { illegal_1(z80); op_3c(z80);												} /* DB   FD          */
-#define Z80_OPfd_3d { illegal_1(z80); op_3d(z80);												} /* DB   FD          */
-#define Z80_OPfd_3e { illegal_1(z80); op_3e(z80);												} /* DB   FD          */
-#define Z80_OPfd_3f { illegal_1(z80); op_3f(z80);												} /* DB   FD          */
-
-#define Z80_OPfd_40 { illegal_1(z80); op_40(z80);												} /* DB   FD          */
-#define Z80_OPfd_41 { illegal_1(z80); op_41(z80);												} /* DB   FD          */
-#define Z80_OPfd_42 { illegal_1(z80); op_42(z80);												} /* DB   FD          */
-#define Z80_OPfd_43 { illegal_1(z80); op_43(z80);												} /* DB   FD          */
-#define Z80_OPfd_44 { z80->B = z80->HY;														} /* LD   B,HY        */
-#define Z80_OPfd_45 { z80->B = z80->LY;														} /* LD   B,LY        */
-#define Z80_OPfd_46 { EAY(z80); z80->B = RM(z80, z80->ea);									} /* LD   B,(IY+o)    */
-#define Z80_OPfd_47 { illegal_1(z80); op_47(z80);												} /* DB   FD          */
-
-#define Z80_OPfd_48 { illegal_1(z80); op_48(z80);												} /* DB   FD          */
-#define Z80_OPfd_49 { illegal_1(z80); op_49(z80);												} /* DB   FD          */
-#define Z80_OPfd_4a { illegal_1(z80); op_4a(z80);												} /* DB   FD          */
-#define Z80_OPfd_4b { illegal_1(z80); op_4b(z80);												} /* DB   FD          */
-#define Z80_OPfd_4c { z80->C = z80->HY;														} /* LD   C,HY        */
-#define Z80_OPfd_4d { z80->C = z80->LY;														} /* LD   C,LY        */
-#define Z80_OPfd_4e { EAY(z80); z80->C = RM(z80, z80->ea);									} /* LD   C,(IY+o)    */
-#define Z80_OPfd_4f { illegal_1(z80); op_4f(z80);												} /* DB   FD          */
-
-#define Z80_OPfd_50 { illegal_1(z80); op_50(z80);												} /* DB   FD          */
-#define Z80_OPfd_51 { illegal_1(z80); op_51(z80);												} /* DB   FD          */
-#define Z80_OPfd_52 { illegal_1(z80); op_52(z80);												} /* DB   FD          */
-#define Z80_OPfd_53 { illegal_1(z80); op_53(z80);												} /* DB   FD          */
-#define Z80_OPfd_54 { z80->D = z80->HY;														} /* LD   D,HY        */
-#define Z80_OPfd_55 { z80->D = z80->LY;														} /* LD   D,LY        */
-#define Z80_OPfd_56 { EAY(z80); z80->D = RM(z80, z80->ea);									} /* LD   D,(IY+o)    */
-#define Z80_OPfd_57 { illegal_1(z80); op_57(z80);												} /* DB   FD          */
-
-#define Z80_OPfd_58 { illegal_1(z80); op_58(z80);												} /* DB   FD          */
-#define Z80_OPfd_59 { illegal_1(z80); op_59(z80);												} /* DB   FD          */
-#define Z80_OPfd_5a { illegal_1(z80); op_5a(z80);												} /* DB   FD          */
-#define Z80_OPfd_5b { illegal_1(z80); op_5b(z80);												} /* DB   FD          */
-#define Z80_OPfd_5c { z80->E = z80->HY;														} /* LD   E,HY        */
-#define Z80_OPfd_5d { z80->E = z80->LY;														} /* LD   E,LY        */
-#define Z80_OPfd_5e { EAY(z80); z80->E = RM(z80, z80->ea);									} /* LD   E,(IY+o)    */
-#define Z80_OPfd_5f { illegal_1(z80); op_5f(z80);												} /* DB   FD          */
-
-#define Z80_OPfd_60 { z80->HY = z80->B;														} /* LD   HY,B        */
-#define Z80_OPfd_61 { z80->HY = z80->C;														} /* LD   HY,C        */
-#define Z80_OPfd_62 { z80->HY = z80->D;														} /* LD   HY,D        */
-#define Z80_OPfd_63 { z80->HY = z80->E;														} /* LD   HY,E        */
-#define Z80_OPfd_64 {																			} /* LD   HY,HY       */
-#define Z80_OPfd_65 { z80->HY = z80->LY;														} /* LD   HY,LY       */
-#define Z80_OPfd_66 { EAY(z80); z80->H = RM(z80, z80->ea);									} /* LD   H,(IY+o)    */
-#define Z80_OPfd_67 { z80->HY = z80->A;														} /* LD   HY,A        */
-
-#define Z80_OPfd_68 { z80->LY = z80->B;														} /* LD   LY,B        */
-#define Z80_OPfd_69 { z80->LY = z80->C;														} /* LD   LY,C        */
-#define Z80_OPfd_6a { z80->LY = z80->D;														} /* LD   LY,D        */
-#define Z80_OPfd_6b { z80->LY = z80->E;														} /* LD   LY,E        */
-#define Z80_OPfd_6c { z80->LY = z80->HY;														} /* LD   LY,HY       */
-#define Z80_OPfd_6d {																			} /* LD   LY,LY       */
-#define Z80_OPfd_6e { EAY(z80); z80->L = RM(z80, z80->ea);									} /* LD   L,(IY+o)    */
-#define Z80_OPfd_6f { z80->LY = z80->A;														} /* LD   LY,A        */
-
-#define Z80_OPfd_70 { EAY(z80); WM(z80, z80->ea, z80->B);										} /* LD   (IY+o),B    */
-#define Z80_OPfd_71 { EAY(z80); WM(z80, z80->ea, z80->C);										} /* LD   (IY+o),C    */
-#define Z80_OPfd_72 { EAY(z80); WM(z80, z80->ea, z80->D);										} /* LD   (IY+o),D    */
-#define Z80_OPfd_73 { EAY(z80); WM(z80, z80->ea, z80->E);										} /* LD   (IY+o),E    */
-#define Z80_OPfd_74 { EAY(z80); WM(z80, z80->ea, z80->H);										} /* LD   (IY+o),H    */
-#define Z80_OPfd_75 { EAY(z80); WM(z80, z80->ea, z80->L);										} /* LD   (IY+o),L    */
-#define Z80_OPfd_76 { illegal_1(z80); op_76(z80);												} /* DB   FD          */
-#define Z80_OPfd_77 { EAY(z80); WM(z80, z80->ea, z80->A);										} /* LD   (IY+o),A    */
-
-#define Z80_OPfd_78 { illegal_1(z80); op_78(z80);												} /* DB   FD          */
-#define Z80_OPfd_79 { illegal_1(z80); op_79(z80);												} /* DB   FD          */
-#define Z80_OPfd_7a { illegal_1(z80); op_7a(z80);												} /* DB   FD          */
-#define Z80_OPfd_7b { illegal_1(z80); op_7b(z80);												} /* DB   FD          */
-#define Z80_OPfd_7c { z80->A = z80->HY;														} /* LD   A,HY        */
-#define Z80_OPfd_7d { z80->A = z80->LY;														} /* LD   A,LY        */
-#define Z80_OPfd_7e { EAY(z80); z80->A = RM(z80, z80->ea);									} /* LD   A,(IY+o)    */
-#define Z80_OPfd_7f { illegal_1(z80); op_7f(z80);												} /* DB   FD          */
-
-#define Z80_OPfd_80 { illegal_1(z80); op_80(z80);												} /* DB   FD          */
-#define Z80_OPfd_81 { illegal_1(z80); op_81(z80);												} /* DB   FD          */
-#define Z80_OPfd_82 { illegal_1(z80); op_82(z80);												} /* DB   FD          */
-#define Z80_OPfd_83 { illegal_1(z80); op_83(z80);												} /* DB   FD          */
-#define Z80_OPfd_84 { ADD(z80, z80->HY);														} /* ADD  A,HY        */
-#define Z80_OPfd_85 { ADD(z80, z80->LY);														} /* ADD  A,LY        */
-#define Z80_OPfd_86 { EAY(z80); ADD(z80, RM(z80, z80->ea));									} /* ADD  A,(IY+o)    */
-#define Z80_OPfd_87 { illegal_1(z80); op_87(z80);												} /* DB   FD          */
-
-#define Z80_OPfd_88 { illegal_1(z80); op_88(z80);												} /* DB   FD          */
-#define Z80_OPfd_89 { illegal_1(z80); op_89(z80);												} /* DB   FD          */
-#define Z80_OPfd_8a { illegal_1(z80); op_8a(z80);												} /* DB   FD          */
-#define Z80_OPfd_8b { illegal_1(z80); op_8b(z80);												} /* DB   FD          */
-#define Z80_OPfd_8c { ADC(z80, z80->HY);														} /* ADC  A,HY        */
-#define Z80_OPfd_8d { ADC(z80, z80->LY);														} /* ADC  A,LY        */
-#define Z80_OPfd_8e { EAY(z80); ADC(z80, RM(z80, z80->ea));									} /* ADC  A,(IY+o)    */
-#define Z80_OPfd_8f { illegal_1(z80); op_8f(z80);												} /* DB   FD          */
-
-#define Z80_OPfd_90 { illegal_1(z80); op_90(z80);												} /* DB   FD          */
-#define Z80_OPfd_91 { illegal_1(z80); op_91(z80);												} /* DB   FD          */
-#define Z80_OPfd_92 { illegal_1(z80); op_92(z80);												} /* DB   FD          */
-#define Z80_OPfd_93 { illegal_1(z80); op_93(z80);												} /* DB   FD          */
-#define Z80_OPfd_94 { SUB(z80, z80->HY);														} /* SUB  HY          */
-#define Z80_OPfd_95 { SUB(z80, z80->LY);														} /* SUB  LY          */
-#define Z80_OPfd_96 { EAY(z80); SUB(z80, RM(z80, z80->ea));									} /* SUB  (IY+o)      */
-#define Z80_OPfd_97 { illegal_1(z80); op_97(z80);												} /* DB   FD          */
-
-#define Z80_OPfd_98 { illegal_1(z80); op_98(z80);												} /* DB   FD          */
-#define Z80_OPfd_99 { illegal_1(z80); op_99(z80);												} /* DB   FD          */
-#define Z80_OPfd_9a { illegal_1(z80); op_9a(z80);												} /* DB   FD          */
-#define Z80_OPfd_9b { illegal_1(z80); op_9b(z80);												} /* DB   FD          */
-#define Z80_OPfd_9c { SBC(z80, z80->HY);														} /* SBC  A,HY        */
-#define Z80_OPfd_9d { SBC(z80, z80->LY);														} /* SBC  A,LY        */
-#define Z80_OPfd_9e { EAY(z80); SBC(z80, RM(z80, z80->ea));									} /* SBC  A,(IY+o)    */
-#define Z80_OPfd_9f { illegal_1(z80); op_9f(z80);												} /* DB   FD          */
-
-#define Z80_OPfd_a0 { illegal_1(z80); op_a0(z80);												} /* DB   FD          */
-#define Z80_OPfd_a1 { illegal_1(z80); op_a1(z80);												} /* DB   FD          */
-#define Z80_OPfd_a2 { illegal_1(z80); op_a2(z80);												} /* DB   FD          */
-#define Z80_OPfd_a3 { illegal_1(z80); op_a3(z80);												} /* DB   FD          */
-#define Z80_OPfd_a4 { AND(z80, z80->HY);														} /* AND  HY          */
-#define Z80_OPfd_a5 { AND(z80, z80->LY);														} /* AND  LY          */
-#define Z80_OPfd_a6 { EAY(z80); AND(z80, RM(z80, z80->ea));									} /* AND  (IY+o)      */
-#define Z80_OPfd_a7 { illegal_1(z80); op_a7(z80);												} /* DB   FD          */
-
-#define Z80_OPfd_a8 { illegal_1(z80); op_a8(z80);												} /* DB   FD          */
-#define Z80_OPfd_a9 { illegal_1(z80); op_a9(z80);												} /* DB   FD          */
-#define Z80_OPfd_aa { illegal_1(z80); op_aa(z80);												} /* DB   FD          */
-#define Z80_OPfd_ab { illegal_1(z80); op_ab(z80);												} /* DB   FD          */
-#define Z80_OPfd_ac { XOR(z80, z80->HY);														} /* XOR  HY          */
-#define Z80_OPfd_ad { XOR(z80, z80->LY);														} /* XOR  LY          */
-#define Z80_OPfd_ae { EAY(z80); XOR(z80, RM(z80, z80->ea));									} /* XOR  (IY+o)      */
-#define Z80_OPfd_af { illegal_1(z80); op_af(z80);												} /* DB   FD          */
-
-#define Z80_OPfd_b0 { illegal_1(z80); op_b0(z80);												} /* DB   FD          */
-#define Z80_OPfd_b1 { illegal_1(z80); op_b1(z80);												} /* DB   FD          */
-#define Z80_OPfd_b2 { illegal_1(z80); op_b2(z80);												} /* DB   FD          */
-#define Z80_OPfd_b3 { illegal_1(z80); op_b3(z80);												} /* DB   FD          */
-#define Z80_OPfd_b4 { OR(z80, z80->HY);														} /* OR   HY          */
-#define Z80_OPfd_b5 { OR(z80, z80->LY);														} /* OR   LY          */
-#define Z80_OPfd_b6 { EAY(z80); OR(z80, RM(z80, z80->ea));									} /* OR   (IY+o)      */
-#define Z80_OPfd_b7 { illegal_1(z80); op_b7(z80);												} /* DB   FD          */
-
-#define Z80_OPfd_b8 { illegal_1(z80); op_b8(z80);												} /* DB   FD          */
-#define Z80_OPfd_b9 { illegal_1(z80); op_b9(z80);												} /* DB   FD          */
-#define Z80_OPfd_ba { illegal_1(z80); op_ba(z80);												} /* DB   FD          */
-#define Z80_OPfd_bb { illegal_1(z80); op_bb(z80);												} /* DB   FD          */
-#define Z80_OPfd_bc { CP(z80, z80->HY);														} /* CP   HY          */
-#define Z80_OPfd_bd { CP(z80, z80->LY);														} /* CP   LY          */
-#define Z80_OPfd_be { EAY(z80); CP(z80, RM(z80, z80->ea));									} /* CP   (IY+o)      */
-#define Z80_OPfd_bf { illegal_1(z80); op_bf(z80);												} /* DB   FD          */
-
-#define Z80_OPfd_c0 { illegal_1(z80); op_c0(z80);												} /* DB   FD          */
-#define Z80_OPfd_c1 { illegal_1(z80); op_c1(z80);												} /* DB   FD          */
-#define Z80_OPfd_c2 { illegal_1(z80); op_c2(z80);												} /* DB   FD          */
-#define Z80_OPfd_c3 { illegal_1(z80); op_c3(z80);												} /* DB   FD          */
-#define Z80_OPfd_c4 { illegal_1(z80); op_c4(z80);												} /* DB   FD          */
-#define Z80_OPfd_c5 { illegal_1(z80); op_c5(z80);												} /* DB   FD          */
-#define Z80_OPfd_c6 { illegal_1(z80); op_c6(z80);												} /* DB   FD          */
-#define Z80_OPfd_c7 { illegal_1(z80); op_c7(z80);												} /* DB   FD          */
-
-#define Z80_OPfd_c8 { illegal_1(z80); op_c8(z80);												} /* DB   FD          */
-#define Z80_OPfd_c9 { illegal_1(z80); op_c9(z80);												} /* DB   FD          */
-#define Z80_OPfd_ca { illegal_1(z80); op_ca(z80);												} /* DB   FD          */
-#define Z80_OPfd_cb { EAY(z80); EXEC(z80,xycb,ARG(z80));										} /* **   FD CB xx    */
-#define Z80_OPfd_cc { illegal_1(z80); op_cc(z80);												} /* DB   FD          */
-#define Z80_OPfd_cd { illegal_1(z80); op_cd(z80);												} /* DB   FD          */
-#define Z80_OPfd_ce { illegal_1(z80); op_ce(z80);												} /* DB   FD          */
-#define Z80_OPfd_cf { illegal_1(z80); op_cf(z80);												} /* DB   FD          */
-
-#define Z80_OPfd_d0 { illegal_1(z80); op_d0(z80);												} /* DB   FD          */
-#define Z80_OPfd_d1 { illegal_1(z80); op_d1(z80);												} /* DB   FD          */
-#define Z80_OPfd_d2 { illegal_1(z80); op_d2(z80);												} /* DB   FD          */
-#define Z80_OPfd_d3 { illegal_1(z80); op_d3(z80);												} /* DB   FD          */
-#define Z80_OPfd_d4 { illegal_1(z80); op_d4(z80);												} /* DB   FD          */
-#define Z80_OPfd_d5 { illegal_1(z80); op_d5(z80);												} /* DB   FD          */
-#define Z80_OPfd_d6 { illegal_1(z80); op_d6(z80);												} /* DB   FD          */
-#define Z80_OPfd_d7 { illegal_1(z80); op_d7(z80);												} /* DB   FD          */
-
-#define Z80_OPfd_d8 { illegal_1(z80); op_d8(z80);												} /* DB   FD          */
-#define Z80_OPfd_d9 { illegal_1(z80); op_d9(z80);												} /* DB   FD          */
-#define Z80_OPfd_da { illegal_1(z80); op_da(z80);												} /* DB   FD          */
-#define Z80_OPfd_db { illegal_1(z80); op_db(z80);												} /* DB   FD          */
-#define Z80_OPfd_dc { illegal_1(z80); op_dc(z80);												} /* DB   FD          */
-#define Z80_OPfd_dd { illegal_1(z80); op_dd(z80);												} /* DB   FD          */
-#define Z80_OPfd_de { illegal_1(z80); op_de(z80);												} /* DB   FD          */
-#define Z80_OPfd_df { illegal_1(z80); op_df(z80);												} /* DB   FD          */
-
-#define Z80_OPfd_e0 { illegal_1(z80); op_e0(z80);												} /* DB   FD          */
-#define Z80_OPfd_e1 { P#define Z80_OPz80, iy);															} /* POP  IY          */
-#define Z80_OPfd_e2 { illegal_1(z80); op_e2(z80);												} /* DB   FD          */
-#define Z80_OPfd_e3 { EXSP(z80, iy);															} /* EX   (SP),IY     */
-#define Z80_OPfd_e4 { illegal_1(z80); op_e4(z80);												} /* DB   FD          */
-#define Z80_OPfd_e5 { PUSH(z80, iy);															} /* PUSH IY          */
-#define Z80_OPfd_e6 { illegal_1(z80); op_e6(z80);												} /* DB   FD          */
-#define Z80_OPfd_e7 { illegal_1(z80); op_e7(z80);												} /* DB   FD          */
-
-#define Z80_OPfd_e8 { illegal_1(z80); op_e8(z80);												} /* DB   FD          */
-#define Z80_OPfd_e9 { z80->PC = z80->IY;														} /* JP   (IY)        */
-#define Z80_OPfd_ea { illegal_1(z80); op_ea(z80);												} /* DB   FD          */
-#define Z80_OPfd_eb { illegal_1(z80); op_eb(z80);												} /* DB   FD          */
-#define Z80_OPfd_ec { illegal_1(z80); op_ec(z80);												} /* DB   FD          */
-#define Z80_OPfd_ed { illegal_1(z80); op_ed(z80);												} /* DB   FD          */
-#define Z80_OPfd_ee { illegal_1(z80); op_ee(z80);												} /* DB   FD          */
-#define Z80_OPfd_ef { illegal_1(z80); op_ef(z80);												} /* DB   FD          */
-
-#define Z80_OPfd_f0 { illegal_1(z80); op_f0(z80);												} /* DB   FD          */
-#define Z80_OPfd_f1 { illegal_1(z80); op_f1(z80);												} /* DB   FD          */
-#define Z80_OPfd_f2 { illegal_1(z80); op_f2(z80);												} /* DB   FD          */
-#define Z80_OPfd_f3 { illegal_1(z80); op_f3(z80);												} /* DB   FD          */
-#define Z80_OPfd_f4 { illegal_1(z80); op_f4(z80);												} /* DB   FD          */
-#define Z80_OPfd_f5 { illegal_1(z80); op_f5(z80);												} /* DB   FD          */
-#define Z80_OPfd_f6 { illegal_1(z80); op_f6(z80);												} /* DB   FD          */
-#define Z80_OPfd_f7 { illegal_1(z80); op_f7(z80);												} /* DB   FD          */
-
-#define Z80_OPfd_f8 { illegal_1(z80); op_f8(z80);												} /* DB   FD          */
-#define Z80_OPfd_f9 { z80->SP = z80->IY;														} /* LD   SP,IY       */
-#define Z80_OPfd_fa { illegal_1(z80); op_fa(z80);												} /* DB   FD          */
-#define Z80_OPfd_fb { illegal_1(z80); op_fb(z80);												} /* DB   FD          */
-#define Z80_OPfd_fc { illegal_1(z80); op_fc(z80);												} /* DB   FD          */
-#define Z80_OPfd_fd { illegal_1(z80); op_fd(z80);												} /* DB   FD          */
-#define Z80_OPfd_fe { illegal_1(z80); op_fe(z80);												} /* DB   FD          */
-#define Z80_OPfd_ff { illegal_1(z80); op_ff(z80);												} /* DB   FD          */
-
-#define Z80_OPillegal,2)
-{
-	OELog("Z80 '%s' ill. opcode $ed $%02x\n",
-		  z80->device->tag, memory_decrypted_read_byte(z80->program, (z80->PCD-1)&0xffff));
-}
+#define Z80FD_OP00 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP01 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP02 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP03 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP04 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP05 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP06 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP07 { XY_IGNORE();												} /* DB   FD          */
+
+#define Z80FD_OP08 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP09 { ADD16(iy, bc);														} /* ADD  IY,BC       */
+#define Z80FD_OP0a { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP0b { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP0c { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP0d { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP0e { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP0f { XY_IGNORE();												} /* DB   FD          */
+
+#define Z80FD_OP10 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP11 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP12 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP13 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP14 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP15 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP16 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP17 { XY_IGNORE();												} /* DB   FD          */
+
+#define Z80FD_OP18 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP19 { ADD16(iy, de);														} /* ADD  IY,DE       */
+#define Z80FD_OP1a { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP1b { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP1c { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP1d { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP1e { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP1f { XY_IGNORE();												} /* DB   FD          */
+
+#define Z80FD_OP20 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP21 { IY = ARG16();													} /* LD   IY,w        */
+#define Z80FD_OP22 { ea = ARG16(); WM16(ea, &iy); WZ = ea+1;} /* LD   (w),IY      */
+#define Z80FD_OP23 { IY++;																} /* INC  IY          */
+#define Z80FD_OP24 { HY = INC(HY);											} /* INC  HY          */
+#define Z80FD_OP25 { HY = DEC(HY);											} /* DEC  HY          */
+#define Z80FD_OP26 { HY = ARG();														} /* LD   HY,n        */
+#define Z80FD_OP27 { XY_IGNORE();												} /* DB   FD          */
+
+#define Z80FD_OP28 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP29 { ADD16(iy, iy);														} /* ADD  IY,IY       */
+#define Z80FD_OP2a { ea = ARG16(); RM16(ea, &iy); WZ = ea+1;} /* LD   IY,(w)      */
+#define Z80FD_OP2b { IY--;																} /* DEC  IY          */
+#define Z80FD_OP2c { LY = INC(LY);											} /* INC  LY          */
+#define Z80FD_OP2d { LY = DEC(LY);											} /* DEC  LY          */
+#define Z80FD_OP2e { LY = ARG();														} /* LD   LY,n        */
+#define Z80FD_OP2f { XY_IGNORE();												} /* DB   FD          */
+
+#define Z80FD_OP30 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP31 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP32 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP33 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP34 { EAY(); WM(ea, INC(RM(ea)));					} /* INC  (IY+o)      */
+#define Z80FD_OP35 { EAY(); WM(ea, DEC(RM(ea)));					} /* DEC  (IY+o)      */
+#define Z80FD_OP36 { EAY(); WM(ea, ARG());									} /* LD   (IY+o),n    */
+#define Z80FD_OP37 { XY_IGNORE();												} /* DB   FD          */
+
+#define Z80FD_OP38 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP39 { ADD16(iy, sp);														} /* ADD  IY,SP       */
+#define Z80FD_OP3a { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP3b { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP3c { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP3d { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP3e { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP3f { XY_IGNORE();												} /* DB   FD          */
+
+#define Z80FD_OP40 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP41 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP42 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP43 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP44 { B = HY;														} /* LD   B,HY        */
+#define Z80FD_OP45 { B = LY;														} /* LD   B,LY        */
+#define Z80FD_OP46 { EAY(); B = RM(ea);									} /* LD   B,(IY+o)    */
+#define Z80FD_OP47 { XY_IGNORE();												} /* DB   FD          */
+
+#define Z80FD_OP48 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP49 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP4a { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP4b { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP4c { C = HY;														} /* LD   C,HY        */
+#define Z80FD_OP4d { C = LY;														} /* LD   C,LY        */
+#define Z80FD_OP4e { EAY(); C = RM(ea);									} /* LD   C,(IY+o)    */
+#define Z80FD_OP4f { XY_IGNORE();												} /* DB   FD          */
+
+#define Z80FD_OP50 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP51 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP52 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP53 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP54 { D = HY;														} /* LD   D,HY        */
+#define Z80FD_OP55 { D = LY;														} /* LD   D,LY        */
+#define Z80FD_OP56 { EAY(); D = RM(ea);									} /* LD   D,(IY+o)    */
+#define Z80FD_OP57 { XY_IGNORE();												} /* DB   FD          */
+
+#define Z80FD_OP58 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP59 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP5a { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP5b { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP5c { E = HY;														} /* LD   E,HY        */
+#define Z80FD_OP5d { E = LY;														} /* LD   E,LY        */
+#define Z80FD_OP5e { EAY(); E = RM(ea);									} /* LD   E,(IY+o)    */
+#define Z80FD_OP5f { XY_IGNORE();												} /* DB   FD          */
+
+#define Z80FD_OP60 { HY = B;														} /* LD   HY,B        */
+#define Z80FD_OP61 { HY = C;														} /* LD   HY,C        */
+#define Z80FD_OP62 { HY = D;														} /* LD   HY,D        */
+#define Z80FD_OP63 { HY = E;														} /* LD   HY,E        */
+#define Z80FD_OP64 {																			} /* LD   HY,HY       */
+#define Z80FD_OP65 { HY = LY;														} /* LD   HY,LY       */
+#define Z80FD_OP66 { EAY(); H = RM(ea);									} /* LD   H,(IY+o)    */
+#define Z80FD_OP67 { HY = A;														} /* LD   HY,A        */
+
+#define Z80FD_OP68 { LY = B;														} /* LD   LY,B        */
+#define Z80FD_OP69 { LY = C;														} /* LD   LY,C        */
+#define Z80FD_OP6a { LY = D;														} /* LD   LY,D        */
+#define Z80FD_OP6b { LY = E;														} /* LD   LY,E        */
+#define Z80FD_OP6c { LY = HY;														} /* LD   LY,HY       */
+#define Z80FD_OP6d {																			} /* LD   LY,LY       */
+#define Z80FD_OP6e { EAY(); L = RM(ea);									} /* LD   L,(IY+o)    */
+#define Z80FD_OP6f { LY = A;														} /* LD   LY,A        */
+
+#define Z80FD_OP70 { EAY(); WM(ea, B);										} /* LD   (IY+o),B    */
+#define Z80FD_OP71 { EAY(); WM(ea, C);										} /* LD   (IY+o),C    */
+#define Z80FD_OP72 { EAY(); WM(ea, D);										} /* LD   (IY+o),D    */
+#define Z80FD_OP73 { EAY(); WM(ea, E);										} /* LD   (IY+o),E    */
+#define Z80FD_OP74 { EAY(); WM(ea, H);										} /* LD   (IY+o),H    */
+#define Z80FD_OP75 { EAY(); WM(ea, L);										} /* LD   (IY+o),L    */
+#define Z80FD_OP76 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP77 { EAY(); WM(ea, A);										} /* LD   (IY+o),A    */
+
+#define Z80FD_OP78 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP79 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP7a { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP7b { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP7c { A = HY;														} /* LD   A,HY        */
+#define Z80FD_OP7d { A = LY;														} /* LD   A,LY        */
+#define Z80FD_OP7e { EAY(); A = RM(ea);									} /* LD   A,(IY+o)    */
+#define Z80FD_OP7f { XY_IGNORE();												} /* DB   FD          */
+
+#define Z80FD_OP80 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP81 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP82 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP83 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP84 { ADD(HY);														} /* ADD  A,HY        */
+#define Z80FD_OP85 { ADD(LY);														} /* ADD  A,LY        */
+#define Z80FD_OP86 { EAY(); ADD(RM(ea));									} /* ADD  A,(IY+o)    */
+#define Z80FD_OP87 { XY_IGNORE();												} /* DB   FD          */
+
+#define Z80FD_OP88 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP89 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP8a { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP8b { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP8c { ADC(HY);														} /* ADC  A,HY        */
+#define Z80FD_OP8d { ADC(LY);														} /* ADC  A,LY        */
+#define Z80FD_OP8e { EAY(); ADC(RM(ea));									} /* ADC  A,(IY+o)    */
+#define Z80FD_OP8f { XY_IGNORE();												} /* DB   FD          */
+
+#define Z80FD_OP90 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP91 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP92 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP93 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP94 { SUB(HY);														} /* SUB  HY          */
+#define Z80FD_OP95 { SUB(LY);														} /* SUB  LY          */
+#define Z80FD_OP96 { EAY(); SUB(RM(ea));									} /* SUB  (IY+o)      */
+#define Z80FD_OP97 { XY_IGNORE();												} /* DB   FD          */
+
+#define Z80FD_OP98 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP99 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP9a { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP9b { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OP9c { SBC(HY);														} /* SBC  A,HY        */
+#define Z80FD_OP9d { SBC(LY);														} /* SBC  A,LY        */
+#define Z80FD_OP9e { EAY(); SBC(RM(ea));									} /* SBC  A,(IY+o)    */
+#define Z80FD_OP9f { XY_IGNORE();												} /* DB   FD          */
+
+#define Z80FD_OPa0 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPa1 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPa2 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPa3 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPa4 { AND(HY);														} /* AND  HY          */
+#define Z80FD_OPa5 { AND(LY);														} /* AND  LY          */
+#define Z80FD_OPa6 { EAY(); AND(RM(ea));									} /* AND  (IY+o)      */
+#define Z80FD_OPa7 { XY_IGNORE();												} /* DB   FD          */
+
+#define Z80FD_OPa8 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPa9 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPaa { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPab { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPac { XOR(HY);														} /* XOR  HY          */
+#define Z80FD_OPad { XOR(LY);														} /* XOR  LY          */
+#define Z80FD_OPae { EAY(); XOR(RM(ea));									} /* XOR  (IY+o)      */
+#define Z80FD_OPaf { XY_IGNORE();												} /* DB   FD          */
+
+#define Z80FD_OPb0 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPb1 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPb2 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPb3 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPb4 { OR(HY);														} /* OR   HY          */
+#define Z80FD_OPb5 { OR(LY);														} /* OR   LY          */
+#define Z80FD_OPb6 { EAY(); OR(RM(ea));									} /* OR   (IY+o)      */
+#define Z80FD_OPb7 { XY_IGNORE();												} /* DB   FD          */
+
+#define Z80FD_OPb8 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPb9 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPba { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPbb { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPbc { CP(HY);														} /* CP   HY          */
+#define Z80FD_OPbd { CP(LY);														} /* CP   LY          */
+#define Z80FD_OPbe { EAY(); CP(RM(ea));									} /* CP   (IY+o)      */
+#define Z80FD_OPbf { XY_IGNORE();												} /* DB   FD          */
+
+#define Z80FD_OPc0 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPc1 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPc2 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPc3 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPc4 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPc5 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPc6 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPc7 { XY_IGNORE();												} /* DB   FD          */
+
+#define Z80FD_OPc8 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPc9 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPca { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPcb { EAY(); Z80_EXECUTE_XYCB();										} /* **   FD CB xx    */
+#define Z80FD_OPcc { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPcd { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPce { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPcf { XY_IGNORE();												} /* DB   FD          */
+
+#define Z80FD_OPd0 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPd1 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPd2 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPd3 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPd4 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPd5 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPd6 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPd7 { XY_IGNORE();												} /* DB   FD          */
+
+#define Z80FD_OPd8 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPd9 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPda { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPdb { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPdc { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPdd { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPde { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPdf { XY_IGNORE();												} /* DB   FD          */
+
+#define Z80FD_OPe0 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPe1 { POP(iy);															} /* POP  IY          */
+#define Z80FD_OPe2 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPe3 { EXSP(iy);															} /* EX   (SP),IY     */
+#define Z80FD_OPe4 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPe5 { PUSH(iy);															} /* PUSH IY          */
+#define Z80FD_OPe6 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPe7 { XY_IGNORE();												} /* DB   FD          */
+
+#define Z80FD_OPe8 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPe9 { PC = IY;														} /* JP   (IY)        */
+#define Z80FD_OPea { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPeb { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPec { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPed { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPee { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPef { XY_IGNORE();												} /* DB   FD          */
+
+#define Z80FD_OPf0 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPf1 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPf2 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPf3 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPf4 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPf5 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPf6 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPf7 { XY_IGNORE();												} /* DB   FD          */
+
+#define Z80FD_OPf8 { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPf9 { SP = IY;														} /* LD   SP,IY       */
+#define Z80FD_OPfa { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPfb { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPfc { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPfd { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPfe { XY_IGNORE();												} /* DB   FD          */
+#define Z80FD_OPff { XY_IGNORE();												} /* DB   FD          */
+
 
 /**********************************************************
  * special opcodes (ED prefix)
  **********************************************************/
-#define Z80_OPed_00 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_01 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_02 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_03 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_04 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_05 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_06 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_07 { illegal_2(z80);															} /* DB   ED          */
-
-#define Z80_OPed_08 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_09 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_0a { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_0b { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_0c { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_0d { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_0e { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_0f { illegal_2(z80);															} /* DB   ED          */
-
-#define Z80_OPed_10 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_11 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_12 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_13 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_14 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_15 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_16 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_17 { illegal_2(z80);															} /* DB   ED          */
-
-#define Z80_OPed_18 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_19 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_1a { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_1b { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_1c { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_1d { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_1e { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_1f { illegal_2(z80);															} /* DB   ED          */
-
-#define Z80_OPed_20 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_21 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_22 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_23 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_24 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_25 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_26 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_27 { illegal_2(z80);															} /* DB   ED          */
-
-#define Z80_OPed_28 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_29 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_2a { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_2b { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_2c { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_2d { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_2e { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_2f { illegal_2(z80);															} /* DB   ED          */
-
-#define Z80_OPed_30 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_31 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_32 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_33 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_34 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_35 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_36 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_37 { illegal_2(z80);															} /* DB   ED          */
-
-#define Z80_OPed_38 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_39 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_3a { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_3b { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_3c { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_3d { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_3e { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_3f { illegal_2(z80);															} /* DB   ED          */
-
-#define Z80_OPed_40 { z80->B = IN(z80, z80->BC); z80->F = (z80->F & CF) | SZP[z80->B];		} /* IN   B,(C)       */
-#define Z80_OPed_41 { OUT(z80, z80->BC, z80->B);												} /* OUT  (C),B       */
-#define Z80_OPed_42 { SBC16(z80, bc);															} /* SBC  HL,BC       */
-#define Z80_OPed_43 { z80->ea = ARG16(z80); WM16(z80, z80->ea, &z80->bc); z80->WZ = z80->ea+1;} /* LD   (w),BC      */
-#define Z80_OPed_44 { NEG(z80);																} /* NEG              */
-#define Z80_OPed_45 { RETN(z80);																} /* RETN             */
-#define Z80_OPed_46 { z80->im = 0;															} /* im   0           */
-#define Z80_OPed_47 { LD_I_A(z80);															} /* LD   i,A         */
-
-#define Z80_OPed_48 { z80->C = IN(z80, z80->BC); z80->F = (z80->F & CF) | SZP[z80->C];		} /* IN   C,(C)       */
-#define Z80_OPed_49 { OUT(z80, z80->BC, z80->C);												} /* OUT  (C),C       */
-#define Z80_OPed_4a { ADC16(z80, bc);															} /* ADC  HL,BC       */
-#define Z80_OPed_4b { z80->ea = ARG16(z80); RM16(z80, z80->ea, &z80->bc); z80->WZ = z80->ea+1;} /* LD   BC,(w)      */
-#define Z80_OPed_4c { NEG(z80);																} /* NEG              */
-#define Z80_OPed_4d { RETI(z80);																} /* RETI             */
-#define Z80_OPed_4e { z80->im = 0;															} /* im   0           */
-#define Z80_OPed_4f { LD_R_A(z80);															} /* LD   r,A         */
-
-#define Z80_OPed_50 { z80->D = IN(z80, z80->BC); z80->F = (z80->F & CF) | SZP[z80->D];		} /* IN   D,(C)       */
-#define Z80_OPed_51 { OUT(z80, z80->BC, z80->D);												} /* OUT  (C),D       */
-#define Z80_OPed_52 { SBC16(z80, de);															} /* SBC  HL,DE       */
-#define Z80_OPed_53 { z80->ea = ARG16(z80); WM16(z80, z80->ea, &z80->de); z80->WZ = z80->ea+1;} /* LD   (w),DE      */
-#define Z80_OPed_54 { NEG(z80);																} /* NEG              */
-#define Z80_OPed_55 { RETN(z80);																} /* RETN             */
-#define Z80_OPed_56 { z80->im = 1;															} /* im   1           */
-#define Z80_OPed_57 { LD_A_I(z80);															} /* LD   A,i         */
-
-#define Z80_OPed_58 { z80->E = IN(z80, z80->BC); z80->F = (z80->F & CF) | SZP[z80->E];		} /* IN   E,(C)       */
-#define Z80_OPed_59 { OUT(z80, z80->BC, z80->E);												} /* OUT  (C),E       */
-#define Z80_OPed_5a { ADC16(z80, de);															} /* ADC  HL,DE       */
-#define Z80_OPed_5b { z80->ea = ARG16(z80); RM16(z80, z80->ea, &z80->de); z80->WZ = z80->ea+1;} /* LD   DE,(w)      */
-#define Z80_OPed_5c { NEG(z80);																} /* NEG              */
-#define Z80_OPed_5d { RETI(z80);																} /* RETI             */
-#define Z80_OPed_5e { z80->im = 2;															} /* im   2           */
-#define Z80_OPed_5f { LD_A_R(z80);															} /* LD   A,r         */
-
-#define Z80_OPed_60 { z80->H = IN(z80, z80->BC); z80->F = (z80->F & CF) | SZP[z80->H];		} /* IN   H,(C)       */
-#define Z80_OPed_61 { OUT(z80, z80->BC, z80->H);												} /* OUT  (C),H       */
-#define Z80_OPed_62 { SBC16(z80, hl);															} /* SBC  HL,HL       */
-#define Z80_OPed_63 { z80->ea = ARG16(z80); WM16(z80, z80->ea, &z80->hl); z80->WZ = z80->ea+1;} /* LD   (w),HL      */
-#define Z80_OPed_64 { NEG(z80);																} /* NEG              */
-#define Z80_OPed_65 { RETN(z80);																} /* RETN             */
-#define Z80_OPed_66 { z80->im = 0;															} /* im   0           */
-#define Z80_OPed_67 { RRD(z80);																} /* RRD  (HL)        */
-
-#define Z80_OPed_68 { z80->L = IN(z80, z80->BC); z80->F = (z80->F & CF) | SZP[z80->L];		} /* IN   L,(C)       */
-#define Z80_OPed_69 { OUT(z80, z80->BC, z80->L);												} /* OUT  (C),L       */
-#define Z80_OPed_6a { ADC16(z80, hl);															} /* ADC  HL,HL       */
-#define Z80_OPed_6b { z80->ea = ARG16(z80); RM16(z80, z80->ea, &z80->hl); z80->WZ = z80->ea+1;} /* LD   HL,(w)      */
-#define Z80_OPed_6c { NEG(z80);																} /* NEG              */
-#define Z80_OPed_6d { RETI(z80);																} /* RETI             */
-#define Z80_OPed_6e { z80->im = 0;															} /* im   0           */
-#define Z80_OPed_6f { RLD(z80);																} /* RLD  (HL)        */
-
-#define Z80_OPed_70 { UINT8 res = IN(z80, z80->BC); z80->F = (z80->F & CF) | SZP[res];		} /* IN   0,(C)       */
-#define Z80_OPed_71 { OUT(z80, z80->BC, 0);													} /* OUT  (C),0       */
-#define Z80_OPed_72 { SBC16(z80, sp);															} /* SBC  HL,SP       */
-#define Z80_OPed_73 { z80->ea = ARG16(z80); WM16(z80, z80->ea, &z80->sp); z80->WZ = z80->ea+1;} /* LD   (w),SP      */
-#define Z80_OPed_74 { NEG(z80);																} /* NEG              */
-#define Z80_OPed_75 { RETN(z80);																} /* RETN             */
-#define Z80_OPed_76 { z80->im = 1;															} /* im   1           */
-#define Z80_OPed_77 { illegal_2(z80);															} /* DB   ED,77       */
-
-#define Z80_OPed_78 { z80->A = IN(z80, z80->BC); z80->F = (z80->F & CF) | SZP[z80->A]; z80->WZ = z80->BC + 1;	} /* IN   A,(C)       */
-#define Z80_OPed_79 { OUT(z80, z80->BC, z80->A);	z80->WZ = z80->BC + 1;						} /* OUT  (C),A       */
-#define Z80_OPed_7a { ADC16(z80, sp);															} /* ADC  HL,SP       */
-#define Z80_OPed_7b { z80->ea = ARG16(z80); RM16(z80, z80->ea, &z80->sp); z80->WZ = z80->ea+1;} /* LD   SP,(w)      */
-#define Z80_OPed_7c { NEG(z80);																} /* NEG              */
-#define Z80_OPed_7d { RETI(z80);																} /* RETI             */
-#define Z80_OPed_7e { z80->im = 2;															} /* im   2           */
-#define Z80_OPed_7f { illegal_2(z80);															} /* DB   ED,7F       */
-
-#define Z80_OPed_80 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_81 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_82 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_83 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_84 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_85 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_86 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_87 { illegal_2(z80);															} /* DB   ED          */
-
-#define Z80_OPed_88 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_89 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_8a { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_8b { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_8c { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_8d { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_8e { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_8f { illegal_2(z80);															} /* DB   ED          */
-
-#define Z80_OPed_90 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_91 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_92 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_93 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_94 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_95 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_96 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_97 { illegal_2(z80);															} /* DB   ED          */
-
-#define Z80_OPed_98 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_99 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_9a { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_9b { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_9c { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_9d { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_9e { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_9f { illegal_2(z80);															} /* DB   ED          */
-
-#define Z80_OPed_a0 { LDI(z80);																} /* LDI              */
-#define Z80_OPed_a1 { CPI(z80);																} /* CPI              */
-#define Z80_OPed_a2 { INI(z80);																} /* INI              */
-#define Z80_OPed_a3 { OUTI(z80);																} /* OUTI             */
-#define Z80_OPed_a4 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_a5 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_a6 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_a7 { illegal_2(z80);															} /* DB   ED          */
-
-#define Z80_OPed_a8 { LDD(z80);																} /* LDD              */
-#define Z80_OPed_a9 { CPD(z80);																} /* CPD              */
-#define Z80_OPed_aa { IND(z80);																} /* IND              */
-#define Z80_OPed_ab { OUTD(z80);																} /* OUTD             */
-#define Z80_OPed_ac { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_ad { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_ae { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_af { illegal_2(z80);															} /* DB   ED          */
-
-#define Z80_OPed_b0 { LDIR(z80);																} /* LDIR             */
-#define Z80_OPed_b1 { CPIR(z80);																} /* CPIR             */
-#define Z80_OPed_b2 { INIR(z80);																} /* INIR             */
-#define Z80_OPed_b3 { OTIR(z80);																} /* OTIR             */
-#define Z80_OPed_b4 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_b5 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_b6 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_b7 { illegal_2(z80);															} /* DB   ED          */
-
-#define Z80_OPed_b8 { LDDR(z80);																} /* LDDR             */
-#define Z80_OPed_b9 { CPDR(z80);																} /* CPDR             */
-#define Z80_OPed_ba { INDR(z80);																} /* INDR             */
-#define Z80_OPed_bb { OTDR(z80);																} /* OTDR             */
-#define Z80_OPed_bc { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_bd { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_be { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_bf { illegal_2(z80);															} /* DB   ED          */
-
-#define Z80_OPed_c0 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_c1 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_c2 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_c3 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_c4 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_c5 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_c6 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_c7 { illegal_2(z80);															} /* DB   ED          */
-
-#define Z80_OPed_c8 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_c9 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_ca { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_cb { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_cc { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_cd { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_ce { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_cf { illegal_2(z80);															} /* DB   ED          */
-
-#define Z80_OPed_d0 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_d1 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_d2 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_d3 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_d4 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_d5 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_d6 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_d7 { illegal_2(z80);															} /* DB   ED          */
-
-#define Z80_OPed_d8 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_d9 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_da { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_db { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_dc { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_dd { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_de { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_df { illegal_2(z80);															} /* DB   ED          */
-
-#define Z80_OPed_e0 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_e1 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_e2 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_e3 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_e4 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_e5 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_e6 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_e7 { illegal_2(z80);															} /* DB   ED          */
-
-#define Z80_OPed_e8 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_e9 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_ea { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_eb { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_ec { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_ed { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_ee { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_ef { illegal_2(z80);															} /* DB   ED          */
-
-#define Z80_OPed_f0 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_f1 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_f2 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_f3 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_f4 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_f5 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_f6 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_f7 { illegal_2(z80);															} /* DB   ED          */
-
-#define Z80_OPed_f8 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_f9 { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_fa { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_fb { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_fc { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_fd { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_fe { illegal_2(z80);															} /* DB   ED          */
-#define Z80_OPed_ff { illegal_2(z80);															} /* DB   ED          */
+#define Z80ED_OP00 { 															} /* DB   ED          */
+#define Z80ED_OP01 { 															} /* DB   ED          */
+#define Z80ED_OP02 { 															} /* DB   ED          */
+#define Z80ED_OP03 { 															} /* DB   ED          */
+#define Z80ED_OP04 { 															} /* DB   ED          */
+#define Z80ED_OP05 { 															} /* DB   ED          */
+#define Z80ED_OP06 { 															} /* DB   ED          */
+#define Z80ED_OP07 { 															} /* DB   ED          */
+
+#define Z80ED_OP08 { 															} /* DB   ED          */
+#define Z80ED_OP09 { 															} /* DB   ED          */
+#define Z80ED_OP0a { 															} /* DB   ED          */
+#define Z80ED_OP0b { 															} /* DB   ED          */
+#define Z80ED_OP0c { 															} /* DB   ED          */
+#define Z80ED_OP0d { 															} /* DB   ED          */
+#define Z80ED_OP0e { 															} /* DB   ED          */
+#define Z80ED_OP0f { 															} /* DB   ED          */
+
+#define Z80ED_OP10 { 															} /* DB   ED          */
+#define Z80ED_OP11 { 															} /* DB   ED          */
+#define Z80ED_OP12 { 															} /* DB   ED          */
+#define Z80ED_OP13 { 															} /* DB   ED          */
+#define Z80ED_OP14 { 															} /* DB   ED          */
+#define Z80ED_OP15 { 															} /* DB   ED          */
+#define Z80ED_OP16 { 															} /* DB   ED          */
+#define Z80ED_OP17 { 															} /* DB   ED          */
+
+#define Z80ED_OP18 { 															} /* DB   ED          */
+#define Z80ED_OP19 { 															} /* DB   ED          */
+#define Z80ED_OP1a { 															} /* DB   ED          */
+#define Z80ED_OP1b { 															} /* DB   ED          */
+#define Z80ED_OP1c { 															} /* DB   ED          */
+#define Z80ED_OP1d { 															} /* DB   ED          */
+#define Z80ED_OP1e { 															} /* DB   ED          */
+#define Z80ED_OP1f { 															} /* DB   ED          */
+
+#define Z80ED_OP20 { 															} /* DB   ED          */
+#define Z80ED_OP21 { 															} /* DB   ED          */
+#define Z80ED_OP22 { 															} /* DB   ED          */
+#define Z80ED_OP23 { 															} /* DB   ED          */
+#define Z80ED_OP24 { 															} /* DB   ED          */
+#define Z80ED_OP25 { 															} /* DB   ED          */
+#define Z80ED_OP26 { 															} /* DB   ED          */
+#define Z80ED_OP27 { 															} /* DB   ED          */
+
+#define Z80ED_OP28 { 															} /* DB   ED          */
+#define Z80ED_OP29 { 															} /* DB   ED          */
+#define Z80ED_OP2a { 															} /* DB   ED          */
+#define Z80ED_OP2b { 															} /* DB   ED          */
+#define Z80ED_OP2c { 															} /* DB   ED          */
+#define Z80ED_OP2d { 															} /* DB   ED          */
+#define Z80ED_OP2e { 															} /* DB   ED          */
+#define Z80ED_OP2f { 															} /* DB   ED          */
+
+#define Z80ED_OP30 { 															} /* DB   ED          */
+#define Z80ED_OP31 { 															} /* DB   ED          */
+#define Z80ED_OP32 { 															} /* DB   ED          */
+#define Z80ED_OP33 { 															} /* DB   ED          */
+#define Z80ED_OP34 { 															} /* DB   ED          */
+#define Z80ED_OP35 { 															} /* DB   ED          */
+#define Z80ED_OP36 { 															} /* DB   ED          */
+#define Z80ED_OP37 { 															} /* DB   ED          */
+
+#define Z80ED_OP38 { 															} /* DB   ED          */
+#define Z80ED_OP39 { 															} /* DB   ED          */
+#define Z80ED_OP3a { 															} /* DB   ED          */
+#define Z80ED_OP3b { 															} /* DB   ED          */
+#define Z80ED_OP3c { 															} /* DB   ED          */
+#define Z80ED_OP3d { 															} /* DB   ED          */
+#define Z80ED_OP3e { 															} /* DB   ED          */
+#define Z80ED_OP3f { 															} /* DB   ED          */
+
+#define Z80ED_OP40 { B = IN(BC); F = (F & CF) | SZP[B];		} /* IN   B,(C)       */
+#define Z80ED_OP41 { OUT(BC, B);												} /* OUT  (C),B       */
+#define Z80ED_OP42 { SBC16(bc);															} /* SBC  HL,BC       */
+#define Z80ED_OP43 { ea = ARG16(); WM16(ea, &bc); WZ = ea+1;} /* LD   (w),BC      */
+#define Z80ED_OP44 { NEG();																} /* NEG              */
+#define Z80ED_OP45 { RETN();																} /* RETN             */
+#define Z80ED_OP46 { im = 0;															} /* im   0           */
+#define Z80ED_OP47 { LD_I_A();															} /* LD   i,A         */
+
+#define Z80ED_OP48 { C = IN(BC); F = (F & CF) | SZP[C];		} /* IN   C,(C)       */
+#define Z80ED_OP49 { OUT(BC, C);												} /* OUT  (C),C       */
+#define Z80ED_OP4a { ADC16(bc);															} /* ADC  HL,BC       */
+#define Z80ED_OP4b { ea = ARG16(); RM16(ea, &bc); WZ = ea+1;} /* LD   BC,(w)      */
+#define Z80ED_OP4c { NEG();																} /* NEG              */
+#define Z80ED_OP4d { RETI();																} /* RETI             */
+#define Z80ED_OP4e { im = 0;															} /* im   0           */
+#define Z80ED_OP4f { LD_R_A();															} /* LD   r,A         */
+
+#define Z80ED_OP50 { D = IN(BC); F = (F & CF) | SZP[D];		} /* IN   D,(C)       */
+#define Z80ED_OP51 { OUT(BC, D);												} /* OUT  (C),D       */
+#define Z80ED_OP52 { SBC16(de);															} /* SBC  HL,DE       */
+#define Z80ED_OP53 { ea = ARG16(); WM16(ea, &de); WZ = ea+1;} /* LD   (w),DE      */
+#define Z80ED_OP54 { NEG();																} /* NEG              */
+#define Z80ED_OP55 { RETN();																} /* RETN             */
+#define Z80ED_OP56 { im = 1;															} /* im   1           */
+#define Z80ED_OP57 { LD_A_I();															} /* LD   A,i         */
+
+#define Z80ED_OP58 { E = IN(BC); F = (F & CF) | SZP[E];		} /* IN   E,(C)       */
+#define Z80ED_OP59 { OUT(BC, E);												} /* OUT  (C),E       */
+#define Z80ED_OP5a { ADC16(de);															} /* ADC  HL,DE       */
+#define Z80ED_OP5b { ea = ARG16(); RM16(ea, &de); WZ = ea+1;} /* LD   DE,(w)      */
+#define Z80ED_OP5c { NEG();																} /* NEG              */
+#define Z80ED_OP5d { RETI();																} /* RETI             */
+#define Z80ED_OP5e { im = 2;															} /* im   2           */
+#define Z80ED_OP5f { LD_A_R();															} /* LD   A,r         */
+
+#define Z80ED_OP60 { H = IN(BC); F = (F & CF) | SZP[H];		} /* IN   H,(C)       */
+#define Z80ED_OP61 { OUT(BC, H);												} /* OUT  (C),H       */
+#define Z80ED_OP62 { SBC16(hl);															} /* SBC  HL,HL       */
+#define Z80ED_OP63 { ea = ARG16(); WM16(ea, &hl); WZ = ea+1;} /* LD   (w),HL      */
+#define Z80ED_OP64 { NEG();																} /* NEG              */
+#define Z80ED_OP65 { RETN();																} /* RETN             */
+#define Z80ED_OP66 { im = 0;															} /* im   0           */
+#define Z80ED_OP67 { RRD();																} /* RRD  (HL)        */
+
+#define Z80ED_OP68 { L = IN(BC); F = (F & CF) | SZP[L];		} /* IN   L,(C)       */
+#define Z80ED_OP69 { OUT(BC, L);												} /* OUT  (C),L       */
+#define Z80ED_OP6a { ADC16(hl);															} /* ADC  HL,HL       */
+#define Z80ED_OP6b { ea = ARG16(); RM16(ea, &hl); WZ = ea+1;} /* LD   HL,(w)      */
+#define Z80ED_OP6c { NEG();																} /* NEG              */
+#define Z80ED_OP6d { RETI();																} /* RETI             */
+#define Z80ED_OP6e { im = 0;															} /* im   0           */
+#define Z80ED_OP6f { RLD();																} /* RLD  (HL)        */
+
+#define Z80ED_OP70 { OEChar res = IN(BC); F = (F & CF) | SZP[res];		} /* IN   0,(C)       */
+#define Z80ED_OP71 { OUT(BC, 0);													} /* OUT  (C),0       */
+#define Z80ED_OP72 { SBC16(sp);															} /* SBC  HL,SP       */
+#define Z80ED_OP73 { ea = ARG16(); WM16(ea, &sp); WZ = ea+1;} /* LD   (w),SP      */
+#define Z80ED_OP74 { NEG();																} /* NEG              */
+#define Z80ED_OP75 { RETN();																} /* RETN             */
+#define Z80ED_OP76 { im = 1;															} /* im   1           */
+#define Z80ED_OP77 { 															} /* DB   ED,77       */
+
+#define Z80ED_OP78 { A = IN(BC); F = (F & CF) | SZP[A]; WZ = BC + 1;	} /* IN   A,(C)       */
+#define Z80ED_OP79 { OUT(BC, A);	WZ = BC + 1;						} /* OUT  (C),A       */
+#define Z80ED_OP7a { ADC16(sp);															} /* ADC  HL,SP       */
+#define Z80ED_OP7b { ea = ARG16(); RM16(ea, &sp); WZ = ea+1;} /* LD   SP,(w)      */
+#define Z80ED_OP7c { NEG();																} /* NEG              */
+#define Z80ED_OP7d { RETI();																} /* RETI             */
+#define Z80ED_OP7e { im = 2;															} /* im   2           */
+#define Z80ED_OP7f { 															} /* DB   ED,7F       */
+
+#define Z80ED_OP80 { 															} /* DB   ED          */
+#define Z80ED_OP81 { 															} /* DB   ED          */
+#define Z80ED_OP82 { 															} /* DB   ED          */
+#define Z80ED_OP83 { 															} /* DB   ED          */
+#define Z80ED_OP84 { 															} /* DB   ED          */
+#define Z80ED_OP85 { 															} /* DB   ED          */
+#define Z80ED_OP86 { 															} /* DB   ED          */
+#define Z80ED_OP87 { 															} /* DB   ED          */
+
+#define Z80ED_OP88 { 															} /* DB   ED          */
+#define Z80ED_OP89 { 															} /* DB   ED          */
+#define Z80ED_OP8a { 															} /* DB   ED          */
+#define Z80ED_OP8b { 															} /* DB   ED          */
+#define Z80ED_OP8c { 															} /* DB   ED          */
+#define Z80ED_OP8d { 															} /* DB   ED          */
+#define Z80ED_OP8e { 															} /* DB   ED          */
+#define Z80ED_OP8f { 															} /* DB   ED          */
+
+#define Z80ED_OP90 { 															} /* DB   ED          */
+#define Z80ED_OP91 { 															} /* DB   ED          */
+#define Z80ED_OP92 { 															} /* DB   ED          */
+#define Z80ED_OP93 { 															} /* DB   ED          */
+#define Z80ED_OP94 { 															} /* DB   ED          */
+#define Z80ED_OP95 { 															} /* DB   ED          */
+#define Z80ED_OP96 { 															} /* DB   ED          */
+#define Z80ED_OP97 { 															} /* DB   ED          */
+
+#define Z80ED_OP98 { 															} /* DB   ED          */
+#define Z80ED_OP99 { 															} /* DB   ED          */
+#define Z80ED_OP9a { 															} /* DB   ED          */
+#define Z80ED_OP9b { 															} /* DB   ED          */
+#define Z80ED_OP9c { 															} /* DB   ED          */
+#define Z80ED_OP9d { 															} /* DB   ED          */
+#define Z80ED_OP9e { 															} /* DB   ED          */
+#define Z80ED_OP9f { 															} /* DB   ED          */
+
+#define Z80ED_OPa0 { LDI();																} /* LDI              */
+#define Z80ED_OPa1 { CPI();																} /* CPI              */
+#define Z80ED_OPa2 { INI();																} /* INI              */
+#define Z80ED_OPa3 { OUTI();																} /* OUTI             */
+#define Z80ED_OPa4 { 															} /* DB   ED          */
+#define Z80ED_OPa5 { 															} /* DB   ED          */
+#define Z80ED_OPa6 { 															} /* DB   ED          */
+#define Z80ED_OPa7 { 															} /* DB   ED          */
+
+#define Z80ED_OPa8 { LDD();																} /* LDD              */
+#define Z80ED_OPa9 { CPD();																} /* CPD              */
+#define Z80ED_OPaa { IND();																} /* IND              */
+#define Z80ED_OPab { OUTD();																} /* OUTD             */
+#define Z80ED_OPac { 															} /* DB   ED          */
+#define Z80ED_OPad { 															} /* DB   ED          */
+#define Z80ED_OPae { 															} /* DB   ED          */
+#define Z80ED_OPaf { 															} /* DB   ED          */
+
+#define Z80ED_OPb0 { LDIR();																} /* LDIR             */
+#define Z80ED_OPb1 { CPIR();																} /* CPIR             */
+#define Z80ED_OPb2 { INIR();																} /* INIR             */
+#define Z80ED_OPb3 { OTIR();																} /* OTIR             */
+#define Z80ED_OPb4 { 															} /* DB   ED          */
+#define Z80ED_OPb5 { 															} /* DB   ED          */
+#define Z80ED_OPb6 { 															} /* DB   ED          */
+#define Z80ED_OPb7 { 															} /* DB   ED          */
+
+#define Z80ED_OPb8 { LDDR();																} /* LDDR             */
+#define Z80ED_OPb9 { CPDR();																} /* CPDR             */
+#define Z80ED_OPba { INDR();																} /* INDR             */
+#define Z80ED_OPbb { OTDR();																} /* OTDR             */
+#define Z80ED_OPbc { 															} /* DB   ED          */
+#define Z80ED_OPbd { 															} /* DB   ED          */
+#define Z80ED_OPbe { 															} /* DB   ED          */
+#define Z80ED_OPbf { 															} /* DB   ED          */
+
+#define Z80ED_OPc0 { 															} /* DB   ED          */
+#define Z80ED_OPc1 { 															} /* DB   ED          */
+#define Z80ED_OPc2 { 															} /* DB   ED          */
+#define Z80ED_OPc3 { 															} /* DB   ED          */
+#define Z80ED_OPc4 { 															} /* DB   ED          */
+#define Z80ED_OPc5 { 															} /* DB   ED          */
+#define Z80ED_OPc6 { 															} /* DB   ED          */
+#define Z80ED_OPc7 { 															} /* DB   ED          */
+
+#define Z80ED_OPc8 { 															} /* DB   ED          */
+#define Z80ED_OPc9 { 															} /* DB   ED          */
+#define Z80ED_OPca { 															} /* DB   ED          */
+#define Z80ED_OPcb { 															} /* DB   ED          */
+#define Z80ED_OPcc { 															} /* DB   ED          */
+#define Z80ED_OPcd { 															} /* DB   ED          */
+#define Z80ED_OPce { 															} /* DB   ED          */
+#define Z80ED_OPcf { 															} /* DB   ED          */
+
+#define Z80ED_OPd0 { 															} /* DB   ED          */
+#define Z80ED_OPd1 { 															} /* DB   ED          */
+#define Z80ED_OPd2 { 															} /* DB   ED          */
+#define Z80ED_OPd3 { 															} /* DB   ED          */
+#define Z80ED_OPd4 { 															} /* DB   ED          */
+#define Z80ED_OPd5 { 															} /* DB   ED          */
+#define Z80ED_OPd6 { 															} /* DB   ED          */
+#define Z80ED_OPd7 { 															} /* DB   ED          */
+
+#define Z80ED_OPd8 { 															} /* DB   ED          */
+#define Z80ED_OPd9 { 															} /* DB   ED          */
+#define Z80ED_OPda { 															} /* DB   ED          */
+#define Z80ED_OPdb { 															} /* DB   ED          */
+#define Z80ED_OPdc { 															} /* DB   ED          */
+#define Z80ED_OPdd { 															} /* DB   ED          */
+#define Z80ED_OPde { 															} /* DB   ED          */
+#define Z80ED_OPdf { 															} /* DB   ED          */
+
+#define Z80ED_OPe0 { 															} /* DB   ED          */
+#define Z80ED_OPe1 { 															} /* DB   ED          */
+#define Z80ED_OPe2 { 															} /* DB   ED          */
+#define Z80ED_OPe3 { 															} /* DB   ED          */
+#define Z80ED_OPe4 { 															} /* DB   ED          */
+#define Z80ED_OPe5 { 															} /* DB   ED          */
+#define Z80ED_OPe6 { 															} /* DB   ED          */
+#define Z80ED_OPe7 { 															} /* DB   ED          */
+
+#define Z80ED_OPe8 { 															} /* DB   ED          */
+#define Z80ED_OPe9 { 															} /* DB   ED          */
+#define Z80ED_OPea { 															} /* DB   ED          */
+#define Z80ED_OPeb { 															} /* DB   ED          */
+#define Z80ED_OPec { 															} /* DB   ED          */
+#define Z80ED_OPed { 															} /* DB   ED          */
+#define Z80ED_OPee { 															} /* DB   ED          */
+#define Z80ED_OPef { 															} /* DB   ED          */
+
+#define Z80ED_OPf0 { 															} /* DB   ED          */
+#define Z80ED_OPf1 { 															} /* DB   ED          */
+#define Z80ED_OPf2 { 															} /* DB   ED          */
+#define Z80ED_OPf3 { 															} /* DB   ED          */
+#define Z80ED_OPf4 { 															} /* DB   ED          */
+#define Z80ED_OPf5 { 															} /* DB   ED          */
+#define Z80ED_OPf6 { 															} /* DB   ED          */
+#define Z80ED_OPf7 { 															} /* DB   ED          */
+
+#define Z80ED_OPf8 { 															} /* DB   ED          */
+#define Z80ED_OPf9 { 															} /* DB   ED          */
+#define Z80ED_OPfa { 															} /* DB   ED          */
+#define Z80ED_OPfb { 															} /* DB   ED          */
+#define Z80ED_OPfc { 															} /* DB   ED          */
+#define Z80ED_OPfd { 															} /* DB   ED          */
+#define Z80ED_OPfe { 															} /* DB   ED          */
+#define Z80ED_OPff { 															} /* DB   ED          */
 
 
 /**********************************************************
  * main opcodes
  **********************************************************/
 #define Z80_OP00 {																			} /* NOP              */
-#define Z80_OP01 { z80->BC = ARG16(z80);													} /* LD   BC,w        */
-#define Z80_OP02 { WM(z80,z80->BC,z80->A); z80->WZ_L = (z80->BC + 1) & 0xFF;  z80->WZ_H = z80->A; } /* LD (BC),A */
-#define Z80_OP03 { z80->BC++;																} /* INC  BC          */
-#define Z80_OP04 { z80->B = INC(z80, z80->B);												} /* INC  B           */
-#define Z80_OP05 { z80->B = DEC(z80, z80->B);												} /* DEC  B           */
-#define Z80_OP06 { z80->B = ARG(z80);														} /* LD   B,n         */
-#define Z80_OP07 { RLCA(z80);																} /* RLCA             */
-
-#define Z80_OP08 { EX_AF(z80);																} /* EX   AF,AF'      */
-#define Z80_OP09 { ADD16(z80, hl, bc);														} /* ADD  HL,BC       */
-#define Z80_OP0a { z80->A = RM(z80, z80->BC);	z80->WZ=z80->BC+1;  						} /* LD   A,(BC)      */
-#define Z80_OP0b { z80->BC--;																} /* DEC  BC          */
-#define Z80_OP0c { z80->C = INC(z80, z80->C);												} /* INC  C           */
-#define Z80_OP0d { z80->C = DEC(z80, z80->C);												} /* DEC  C           */
-#define Z80_OP0e { z80->C = ARG(z80);														} /* LD   C,n         */
-#define Z80_OP0f { RRCA(z80);																} /* RRCA             */
-
-#define Z80_OP10 { z80->B--; JR_COND(z80, z80->B, 0x10);									} /* DJNZ o           */
-#define Z80_OP11 { z80->DE = ARG16(z80);													} /* LD   DE,w        */
-#define Z80_OP12 { WM(z80,z80->DE,z80->A); z80->WZ_L = (z80->DE + 1) & 0xFF;  z80->WZ_H = z80->A; } /* LD (DE),A */
-#define Z80_OP13 { z80->DE++;																} /* INC  DE          */
-#define Z80_OP14 { z80->D = INC(z80, z80->D);												} /* INC  D           */
-#define Z80_OP15 { z80->D = DEC(z80, z80->D);												} /* DEC  D           */
-#define Z80_OP16 { z80->D = ARG(z80);														} /* LD   D,n         */
-#define Z80_OP17 { RLA(z80);																} /* RLA              */
-
-#define Z80_OP18 { JR(z80);																} /* JR   o           */
-#define Z80_OP19 { ADD16(z80, hl, de);														} /* ADD  HL,DE       */
-#define Z80_OP1a { z80->A = RM(z80, z80->DE); z80->WZ=z80->DE+1;							} /* LD   A,(DE)      */
-#define Z80_OP1b { z80->DE--;																} /* DEC  DE          */
-#define Z80_OP1c { z80->E = INC(z80, z80->E);												} /* INC  E           */
-#define Z80_OP1d { z80->E = DEC(z80, z80->E);												} /* DEC  E           */
-#define Z80_OP1e { z80->E = ARG(z80);														} /* LD   E,n         */
-#define Z80_OP1f { RRA(z80);																} /* RRA              */
-
-#define Z80_OP20 { JR_COND(z80, !(z80->F & ZF), 0x20);										} /* JR   NZ,o        */
-#define Z80_OP21 { z80->HL = ARG16(z80);													} /* LD   HL,w        */
-#define Z80_OP22 { z80->ea = ARG16(z80); WM16(z80, z80->ea, &z80->hl);	z80->WZ = z80->ea+1;} /* LD   (w),HL      */
-#define Z80_OP23 { z80->HL++;																} /* INC  HL          */
-#define Z80_OP24 { z80->H = INC(z80, z80->H);												} /* INC  H           */
-#define Z80_OP25 { z80->H = DEC(z80, z80->H);												} /* DEC  H           */
-#define Z80_OP26 { z80->H = ARG(z80);														} /* LD   H,n         */
-#define Z80_OP27 { DAA(z80);																} /* DAA              */
-
-#define Z80_OP28 { JR_COND(z80, z80->F & ZF, 0x28);										} /* JR   Z,o         */
-#define Z80_OP29 { ADD16(z80, hl, hl);														} /* ADD  HL,HL       */
-#define Z80_OP2a { z80->ea = ARG16(z80); RM16(z80, z80->ea, &z80->hl);	z80->WZ = z80->ea+1;} /* LD   HL,(w)      */
-#define Z80_OP2b { z80->HL--;																} /* DEC  HL          */
-#define Z80_OP2c { z80->L = INC(z80, z80->L);												} /* INC  L           */
-#define Z80_OP2d { z80->L = DEC(z80, z80->L);												} /* DEC  L           */
-#define Z80_OP2e { z80->L = ARG(z80);														} /* LD   L,n         */
-#define Z80_OP2f { z80->A ^= 0xff; z80->F = (z80->F&(SF|ZF|PF|CF))|HF|NF|(z80->A&(YF|XF));	} /* CPL              */
-
-#define Z80_OP30 { JR_COND(z80, !(z80->F & CF), 0x30);										} /* JR   NC,o        */
-#define Z80_OP31 { z80->SP = ARG16(z80);													} /* LD   SP,w        */
-#define Z80_OP32 { z80->ea=ARG16(z80);WM(z80,z80->ea,z80->A);z80->WZ_L=(z80->ea+1)&0xFF;z80->WZ_H=z80->A; } /* LD   (w),A       */
-#define Z80_OP33 { z80->SP++;																} /* INC  SP          */
-#define Z80_OP34 { WM(z80, z80->HL, INC(z80, RM(z80, z80->HL)));							} /* INC  (HL)        */
-#define Z80_OP35 { WM(z80, z80->HL, DEC(z80, RM(z80, z80->HL)));							} /* DEC  (HL)        */
-#define Z80_OP36 { WM(z80, z80->HL, ARG(z80));												} /* LD   (HL),n      */
-#define Z80_OP37 { z80->F = (z80->F & (SF|ZF|YF|XF|PF)) | CF | (z80->A & (YF|XF));			} /* SCF              */
-
-#define Z80_OP38 { JR_COND(z80, z80->F & CF, 0x38);										} /* JR   C,o         */
-#define Z80_OP39 { ADD16(z80, hl, sp);														} /* ADD  HL,SP       */
-#define Z80_OP3a { z80->ea = ARG16(z80); z80->A = RM(z80, z80->ea); z80->WZ=z80->ea+1;		} /* LD   A,(w)       */
-#define Z80_OP3b { z80->SP--;																} /* DEC  SP          */
-#define Z80_OP3c { z80->A = INC(z80, z80->A);												} /* INC  A           */
-#define Z80_OP3d { z80->A = DEC(z80, z80->A);												} /* DEC  A           */
-#define Z80_OP3e { z80->A = ARG(z80);														} /* LD   A,n         */
-#define Z80_OP3f { z80->F = ((z80->F&(SF|ZF|YF|XF|PF|CF))|((z80->F&CF)<<4)|(z80->A&(YF|XF)))^CF; } /* CCF        */
+#define Z80_OP01 { BC = ARG16();													} /* LD   BC,w        */
+#define Z80_OP02 { WM(BC,A); WZ_L = (BC + 1) & 0xFF;  WZ_H = A; } /* LD (BC),A */
+#define Z80_OP03 { BC++;																} /* INC  BC          */
+#define Z80_OP04 { B = INC(B);												} /* INC  B           */
+#define Z80_OP05 { B = DEC(B);												} /* DEC  B           */
+#define Z80_OP06 { B = ARG();														} /* LD   B,n         */
+#define Z80_OP07 { RLCA();																} /* RLCA             */
+
+#define Z80_OP08 { EX_AF();																} /* EX   AF,AF'      */
+#define Z80_OP09 { ADD16(hl, bc);														} /* ADD  HL,BC       */
+#define Z80_OP0a { A = RM(BC);	WZ=BC+1;  						} /* LD   A,(BC)      */
+#define Z80_OP0b { BC--;																} /* DEC  BC          */
+#define Z80_OP0c { C = INC(C);												} /* INC  C           */
+#define Z80_OP0d { C = DEC(C);												} /* DEC  C           */
+#define Z80_OP0e { C = ARG();														} /* LD   C,n         */
+#define Z80_OP0f { RRCA();																} /* RRCA             */
+
+#define Z80_OP10 { B--; JR_COND(B, 0x10);									} /* DJNZ o           */
+#define Z80_OP11 { DE = ARG16();													} /* LD   DE,w        */
+#define Z80_OP12 { WM(DE,A); WZ_L = (DE + 1) & 0xFF;  WZ_H = A; } /* LD (DE),A */
+#define Z80_OP13 { DE++;																} /* INC  DE          */
+#define Z80_OP14 { D = INC(D);												} /* INC  D           */
+#define Z80_OP15 { D = DEC(D);												} /* DEC  D           */
+#define Z80_OP16 { D = ARG();														} /* LD   D,n         */
+#define Z80_OP17 { RLA();																} /* RLA              */
+
+#define Z80_OP18 { JR();																} /* JR   o           */
+#define Z80_OP19 { ADD16(hl, de);														} /* ADD  HL,DE       */
+#define Z80_OP1a { A = RM(DE); WZ=DE+1;							} /* LD   A,(DE)      */
+#define Z80_OP1b { DE--;																} /* DEC  DE          */
+#define Z80_OP1c { E = INC(E);												} /* INC  E           */
+#define Z80_OP1d { E = DEC(E);												} /* DEC  E           */
+#define Z80_OP1e { E = ARG();														} /* LD   E,n         */
+#define Z80_OP1f { RRA();																} /* RRA              */
+
+#define Z80_OP20 { JR_COND(!(F & ZF), 0x20);										} /* JR   NZ,o        */
+#define Z80_OP21 { HL = ARG16();													} /* LD   HL,w        */
+#define Z80_OP22 { ea = ARG16(); WM16(ea, &hl);	WZ = ea+1;} /* LD   (w),HL      */
+#define Z80_OP23 { HL++;																} /* INC  HL          */
+#define Z80_OP24 { H = INC(H);												} /* INC  H           */
+#define Z80_OP25 { H = DEC(H);												} /* DEC  H           */
+#define Z80_OP26 { H = ARG();														} /* LD   H,n         */
+#define Z80_OP27 { DAA();																} /* DAA              */
+
+#define Z80_OP28 { JR_COND(F & ZF, 0x28);										} /* JR   Z,o         */
+#define Z80_OP29 { ADD16(hl, hl);														} /* ADD  HL,HL       */
+#define Z80_OP2a { ea = ARG16(); RM16(ea, &hl);	WZ = ea+1;} /* LD   HL,(w)      */
+#define Z80_OP2b { HL--;																} /* DEC  HL          */
+#define Z80_OP2c { L = INC(L);												} /* INC  L           */
+#define Z80_OP2d { L = DEC(L);												} /* DEC  L           */
+#define Z80_OP2e { L = ARG();														} /* LD   L,n         */
+#define Z80_OP2f { A ^= 0xff; F = (F&(SF|ZF|PF|CF))|HF|NF|(A&(YF|XF));	} /* CPL              */
+
+#define Z80_OP30 { JR_COND(!(F & CF), 0x30);										} /* JR   NC,o        */
+#define Z80_OP31 { SP = ARG16();													} /* LD   SP,w        */
+#define Z80_OP32 { ea=ARG16();WM(ea,A);WZ_L=(ea+1)&0xFF;WZ_H=A; } /* LD   (w),A       */
+#define Z80_OP33 { SP++;																} /* INC  SP          */
+#define Z80_OP34 { WM(HL, INC(RM(HL)));							} /* INC  (HL)        */
+#define Z80_OP35 { WM(HL, DEC(RM(HL)));							} /* DEC  (HL)        */
+#define Z80_OP36 { WM(HL, ARG());												} /* LD   (HL),n      */
+#define Z80_OP37 { F = (F & (SF|ZF|YF|XF|PF)) | CF | (A & (YF|XF));			} /* SCF              */
+
+#define Z80_OP38 { JR_COND(F & CF, 0x38);										} /* JR   C,o         */
+#define Z80_OP39 { ADD16(hl, sp);														} /* ADD  HL,SP       */
+#define Z80_OP3a { ea = ARG16(); A = RM(ea); WZ=ea+1;		} /* LD   A,(w)       */
+#define Z80_OP3b { SP--;																} /* DEC  SP          */
+#define Z80_OP3c { A = INC(A);												} /* INC  A           */
+#define Z80_OP3d { A = DEC(A);												} /* DEC  A           */
+#define Z80_OP3e { A = ARG();														} /* LD   A,n         */
+#define Z80_OP3f { F = ((F&(SF|ZF|YF|XF|PF|CF))|((F&CF)<<4)|(A&(YF|XF)))^CF; } /* CCF        */
 
 #define Z80_OP40 {																			} /* LD   B,B         */
-#define Z80_OP41 { z80->B = z80->C;														} /* LD   B,C         */
-#define Z80_OP42 { z80->B = z80->D;														} /* LD   B,D         */
-#define Z80_OP43 { z80->B = z80->E;														} /* LD   B,E         */
-#define Z80_OP44 { z80->B = z80->H;														} /* LD   B,H         */
-#define Z80_OP45 { z80->B = z80->L;														} /* LD   B,L         */
-#define Z80_OP46 { z80->B = RM(z80, z80->HL);												} /* LD   B,(HL)      */
-#define Z80_OP47 { z80->B = z80->A;														} /* LD   B,A         */
-
-#define Z80_OP48 { z80->C = z80->B;														} /* LD   C,B         */
+#define Z80_OP41 { B = C;														} /* LD   B,C         */
+#define Z80_OP42 { B = D;														} /* LD   B,D         */
+#define Z80_OP43 { B = E;														} /* LD   B,E         */
+#define Z80_OP44 { B = H;														} /* LD   B,H         */
+#define Z80_OP45 { B = L;														} /* LD   B,L         */
+#define Z80_OP46 { B = RM(HL);												} /* LD   B,(HL)      */
+#define Z80_OP47 { B = A;														} /* LD   B,A         */
+
+#define Z80_OP48 { C = B;														} /* LD   C,B         */
 #define Z80_OP49 {																			} /* LD   C,C         */
-#define Z80_OP4a { z80->C = z80->D;														} /* LD   C,D         */
-#define Z80_OP4b { z80->C = z80->E;														} /* LD   C,E         */
-#define Z80_OP4c { z80->C = z80->H;														} /* LD   C,H         */
-#define Z80_OP4d { z80->C = z80->L;														} /* LD   C,L         */
-#define Z80_OP4e { z80->C = RM(z80, z80->HL);												} /* LD   C,(HL)      */
-#define Z80_OP4f { z80->C = z80->A;														} /* LD   C,A         */
-
-#define Z80_OP50 { z80->D = z80->B;														} /* LD   D,B         */
-#define Z80_OP51 { z80->D = z80->C;														} /* LD   D,C         */
+#define Z80_OP4a { C = D;														} /* LD   C,D         */
+#define Z80_OP4b { C = E;														} /* LD   C,E         */
+#define Z80_OP4c { C = H;														} /* LD   C,H         */
+#define Z80_OP4d { C = L;														} /* LD   C,L         */
+#define Z80_OP4e { C = RM(HL);												} /* LD   C,(HL)      */
+#define Z80_OP4f { C = A;														} /* LD   C,A         */
+
+#define Z80_OP50 { D = B;														} /* LD   D,B         */
+#define Z80_OP51 { D = C;														} /* LD   D,C         */
 #define Z80_OP52 {																			} /* LD   D,D         */
-#define Z80_OP53 { z80->D = z80->E;														} /* LD   D,E         */
-#define Z80_OP54 { z80->D = z80->H;														} /* LD   D,H         */
-#define Z80_OP55 { z80->D = z80->L;														} /* LD   D,L         */
-#define Z80_OP56 { z80->D = RM(z80, z80->HL);												} /* LD   D,(HL)      */
-#define Z80_OP57 { z80->D = z80->A;														} /* LD   D,A         */
-
-#define Z80_OP58 { z80->E = z80->B;														} /* LD   E,B         */
-#define Z80_OP59 { z80->E = z80->C;														} /* LD   E,C         */
-#define Z80_OP5a { z80->E = z80->D;														} /* LD   E,D         */
+#define Z80_OP53 { D = E;														} /* LD   D,E         */
+#define Z80_OP54 { D = H;														} /* LD   D,H         */
+#define Z80_OP55 { D = L;														} /* LD   D,L         */
+#define Z80_OP56 { D = RM(HL);												} /* LD   D,(HL)      */
+#define Z80_OP57 { D = A;														} /* LD   D,A         */
+
+#define Z80_OP58 { E = B;														} /* LD   E,B         */
+#define Z80_OP59 { E = C;														} /* LD   E,C         */
+#define Z80_OP5a { E = D;														} /* LD   E,D         */
 #define Z80_OP5b {																			} /* LD   E,E         */
-#define Z80_OP5c { z80->E = z80->H;														} /* LD   E,H         */
-#define Z80_OP5d { z80->E = z80->L;														} /* LD   E,L         */
-#define Z80_OP5e { z80->E = RM(z80, z80->HL);												} /* LD   E,(HL)      */
-#define Z80_OP5f { z80->E = z80->A;														} /* LD   E,A         */
-
-#define Z80_OP60 { z80->H = z80->B;														} /* LD   H,B         */
-#define Z80_OP61 { z80->H = z80->C;														} /* LD   H,C         */
-#define Z80_OP62 { z80->H = z80->D;														} /* LD   H,D         */
-#define Z80_OP63 { z80->H = z80->E;														} /* LD   H,E         */
+#define Z80_OP5c { E = H;														} /* LD   E,H         */
+#define Z80_OP5d { E = L;														} /* LD   E,L         */
+#define Z80_OP5e { E = RM(HL);												} /* LD   E,(HL)      */
+#define Z80_OP5f { E = A;														} /* LD   E,A         */
+
+#define Z80_OP60 { H = B;														} /* LD   H,B         */
+#define Z80_OP61 { H = C;														} /* LD   H,C         */
+#define Z80_OP62 { H = D;														} /* LD   H,D         */
+#define Z80_OP63 { H = E;														} /* LD   H,E         */
 #define Z80_OP64 {																			} /* LD   H,H         */
-#define Z80_OP65 { z80->H = z80->L;														} /* LD   H,L         */
-#define Z80_OP66 { z80->H = RM(z80, z80->HL);												} /* LD   H,(HL)      */
-#define Z80_OP67 { z80->H = z80->A;														} /* LD   H,A         */
-
-#define Z80_OP68 { z80->L = z80->B;														} /* LD   L,B         */
-#define Z80_OP69 { z80->L = z80->C;														} /* LD   L,C         */
-#define Z80_OP6a { z80->L = z80->D;														} /* LD   L,D         */
-#define Z80_OP6b { z80->L = z80->E;														} /* LD   L,E         */
-#define Z80_OP6c { z80->L = z80->H;														} /* LD   L,H         */
+#define Z80_OP65 { H = L;														} /* LD   H,L         */
+#define Z80_OP66 { H = RM(HL);												} /* LD   H,(HL)      */
+#define Z80_OP67 { H = A;														} /* LD   H,A         */
+
+#define Z80_OP68 { L = B;														} /* LD   L,B         */
+#define Z80_OP69 { L = C;														} /* LD   L,C         */
+#define Z80_OP6a { L = D;														} /* LD   L,D         */
+#define Z80_OP6b { L = E;														} /* LD   L,E         */
+#define Z80_OP6c { L = H;														} /* LD   L,H         */
 #define Z80_OP6d {																			} /* LD   L,L         */
-#define Z80_OP6e { z80->L = RM(z80, z80->HL);												} /* LD   L,(HL)      */
-#define Z80_OP6f { z80->L = z80->A;														} /* LD   L,A         */
-
-#define Z80_OP70 { WM(z80, z80->HL, z80->B);												} /* LD   (HL),B      */
-#define Z80_OP71 { WM(z80, z80->HL, z80->C);												} /* LD   (HL),C      */
-#define Z80_OP72 { WM(z80, z80->HL, z80->D);												} /* LD   (HL),D      */
-#define Z80_OP73 { WM(z80, z80->HL, z80->E);												} /* LD   (HL),E      */
-#define Z80_OP74 { WM(z80, z80->HL, z80->H);												} /* LD   (HL),H      */
-#define Z80_OP75 { WM(z80, z80->HL, z80->L);												} /* LD   (HL),L      */
-#define Z80_OP76 { ENTER_HALT(z80);														} /* halt             */
-#define Z80_OP77 { WM(z80, z80->HL, z80->A);												} /* LD   (HL),A      */
-
-#define Z80_OP78 { z80->A = z80->B;														} /* LD   A,B         */
-#define Z80_OP79 { z80->A = z80->C;														} /* LD   A,C         */
-#define Z80_OP7a { z80->A = z80->D;														} /* LD   A,D         */
-#define Z80_OP7b { z80->A = z80->E;														} /* LD   A,E         */
-#define Z80_OP7c { z80->A = z80->H;														} /* LD   A,H         */
-#define Z80_OP7d { z80->A = z80->L;														} /* LD   A,L         */
-#define Z80_OP7e { z80->A = RM(z80, z80->HL);												} /* LD   A,(HL)      */
+#define Z80_OP6e { L = RM(HL);												} /* LD   L,(HL)      */
+#define Z80_OP6f { L = A;														} /* LD   L,A         */
+
+#define Z80_OP70 { WM(HL, B);												} /* LD   (HL),B      */
+#define Z80_OP71 { WM(HL, C);												} /* LD   (HL),C      */
+#define Z80_OP72 { WM(HL, D);												} /* LD   (HL),D      */
+#define Z80_OP73 { WM(HL, E);												} /* LD   (HL),E      */
+#define Z80_OP74 { WM(HL, H);												} /* LD   (HL),H      */
+#define Z80_OP75 { WM(HL, L);												} /* LD   (HL),L      */
+#define Z80_OP76 { ENTER_HALT();														} /* halt             */
+#define Z80_OP77 { WM(HL, A);												} /* LD   (HL),A      */
+
+#define Z80_OP78 { A = B;														} /* LD   A,B         */
+#define Z80_OP79 { A = C;														} /* LD   A,C         */
+#define Z80_OP7a { A = D;														} /* LD   A,D         */
+#define Z80_OP7b { A = E;														} /* LD   A,E         */
+#define Z80_OP7c { A = H;														} /* LD   A,H         */
+#define Z80_OP7d { A = L;														} /* LD   A,L         */
+#define Z80_OP7e { A = RM(HL);												} /* LD   A,(HL)      */
 #define Z80_OP7f {																			} /* LD   A,A         */
 
-#define Z80_OP80 { ADD(z80, z80->B);														} /* ADD  A,B         */
-#define Z80_OP81 { ADD(z80, z80->C);														} /* ADD  A,C         */
-#define Z80_OP82 { ADD(z80, z80->D);														} /* ADD  A,D         */
-#define Z80_OP83 { ADD(z80, z80->E);														} /* ADD  A,E         */
-#define Z80_OP84 { ADD(z80, z80->H);														} /* ADD  A,H         */
-#define Z80_OP85 { ADD(z80, z80->L);														} /* ADD  A,L         */
-#define Z80_OP86 { ADD(z80, RM(z80, z80->HL));												} /* ADD  A,(HL)      */
-#define Z80_OP87 { ADD(z80, z80->A);														} /* ADD  A,A         */
-
-#define Z80_OP88 { ADC(z80, z80->B);														} /* ADC  A,B         */
-#define Z80_OP89 { ADC(z80, z80->C);														} /* ADC  A,C         */
-#define Z80_OP8a { ADC(z80, z80->D);														} /* ADC  A,D         */
-#define Z80_OP8b { ADC(z80, z80->E);														} /* ADC  A,E         */
-#define Z80_OP8c { ADC(z80, z80->H);														} /* ADC  A,H         */
-#define Z80_OP8d { ADC(z80, z80->L);														} /* ADC  A,L         */
-#define Z80_OP8e { ADC(z80, RM(z80, z80->HL));												} /* ADC  A,(HL)      */
-#define Z80_OP8f { ADC(z80, z80->A);														} /* ADC  A,A         */
-
-#define Z80_OP90 { SUB(z80, z80->B);														} /* SUB  B           */
-#define Z80_OP91 { SUB(z80, z80->C);														} /* SUB  C           */
-#define Z80_OP92 { SUB(z80, z80->D);														} /* SUB  D           */
-#define Z80_OP93 { SUB(z80, z80->E);														} /* SUB  E           */
-#define Z80_OP94 { SUB(z80, z80->H);														} /* SUB  H           */
-#define Z80_OP95 { SUB(z80, z80->L);														} /* SUB  L           */
-#define Z80_OP96 { SUB(z80, RM(z80, z80->HL));												} /* SUB  (HL)        */
-#define Z80_OP97 { SUB(z80, z80->A);														} /* SUB  A           */
-
-#define Z80_OP98 { SBC(z80, z80->B);														} /* SBC  A,B         */
-#define Z80_OP99 { SBC(z80, z80->C);														} /* SBC  A,C         */
-#define Z80_OP9a { SBC(z80, z80->D);														} /* SBC  A,D         */
-#define Z80_OP9b { SBC(z80, z80->E);														} /* SBC  A,E         */
-#define Z80_OP9c { SBC(z80, z80->H);														} /* SBC  A,H         */
-#define Z80_OP9d { SBC(z80, z80->L);														} /* SBC  A,L         */
-#define Z80_OP9e { SBC(z80, RM(z80, z80->HL));												} /* SBC  A,(HL)      */
-#define Z80_OP9f { SBC(z80, z80->A);														} /* SBC  A,A         */
-
-#define Z80_OPa0 { AND(z80, z80->B);														} /* AND  B           */
-#define Z80_OPa1 { AND(z80, z80->C);														} /* AND  C           */
-#define Z80_OPa2 { AND(z80, z80->D);														} /* AND  D           */
-#define Z80_OPa3 { AND(z80, z80->E);														} /* AND  E           */
-#define Z80_OPa4 { AND(z80, z80->H);														} /* AND  H           */
-#define Z80_OPa5 { AND(z80, z80->L);														} /* AND  L           */
-#define Z80_OPa6 { AND(z80, RM(z80, z80->HL));												} /* AND  (HL)        */
-#define Z80_OPa7 { AND(z80, z80->A);														} /* AND  A           */
-
-#define Z80_OPa8 { XOR(z80, z80->B);														} /* XOR  B           */
-#define Z80_OPa9 { XOR(z80, z80->C);														} /* XOR  C           */
-#define Z80_OPaa { XOR(z80, z80->D);														} /* XOR  D           */
-#define Z80_OPab { XOR(z80, z80->E);														} /* XOR  E           */
-#define Z80_OPac { XOR(z80, z80->H);														} /* XOR  H           */
-#define Z80_OPad { XOR(z80, z80->L);														} /* XOR  L           */
-#define Z80_OPae { XOR(z80, RM(z80, z80->HL));												} /* XOR  (HL)        */
-#define Z80_OPaf { XOR(z80, z80->A);														} /* XOR  A           */
-
-#define Z80_OPb0 { OR(z80, z80->B);														} /* OR   B           */
-#define Z80_OPb1 { OR(z80, z80->C);														} /* OR   C           */
-#define Z80_OPb2 { OR(z80, z80->D);														} /* OR   D           */
-#define Z80_OPb3 { OR(z80, z80->E);														} /* OR   E           */
-#define Z80_OPb4 { OR(z80, z80->H);														} /* OR   H           */
-#define Z80_OPb5 { OR(z80, z80->L);														} /* OR   L           */
-#define Z80_OPb6 { OR(z80, RM(z80, z80->HL));												} /* OR   (HL)        */
-#define Z80_OPb7 { OR(z80, z80->A);														} /* OR   A           */
-
-#define Z80_OPb8 { CP(z80, z80->B);														} /* CP   B           */
-#define Z80_OPb9 { CP(z80, z80->C);														} /* CP   C           */
-#define Z80_OPba { CP(z80, z80->D);														} /* CP   D           */
-#define Z80_OPbb { CP(z80, z80->E);														} /* CP   E           */
-#define Z80_OPbc { CP(z80, z80->H);														} /* CP   H           */
-#define Z80_OPbd { CP(z80, z80->L);														} /* CP   L           */
-#define Z80_OPbe { CP(z80, RM(z80, z80->HL));												} /* CP   (HL)        */
-#define Z80_OPbf { CP(z80, z80->A);														} /* CP   A           */
-
-#define Z80_OPc0 { RET_COND(z80, !(z80->F & ZF), 0xc0);									} /* RET  NZ          */
-#define Z80_OPc1 { P#define Z80_OPz80, bc);															} /* POP  BC          */
-#define Z80_OPc2 { JP_COND(z80, !(z80->F & ZF));											} /* JP   NZ,a        */
-#define Z80_OPc3 { JP(z80);																} /* JP   a           */
-#define Z80_OPc4 { CALL_COND(z80, !(z80->F & ZF), 0xc4);									} /* CALL NZ,a        */
-#define Z80_OPc5 { PUSH(z80, bc);															} /* PUSH BC          */
-#define Z80_OPc6 { ADD(z80, ARG(z80));														} /* ADD  A,n         */
-#define Z80_OPc7 { RST(z80, 0x00);															} /* RST  0           */
-
-#define Z80_OPc8 { RET_COND(z80, z80->F & ZF, 0xc8);										} /* RET  Z           */
-#define Z80_OPc9 { P#define Z80_OPz80, pc); z80->WZ=z80->PCD;											} /* RET              */
-#define Z80_OPca { JP_COND(z80, z80->F & ZF);												} /* JP   Z,a         */
-#define Z80_OPcb { z80->r++; EXEC(z80,cb,R#define Z80_OPz80));										} /* **** CB xx       */
-#define Z80_OPcc { CALL_COND(z80, z80->F & ZF, 0xcc);										} /* CALL Z,a         */
-#define Z80_OPcd { CALL(z80);																} /* CALL a           */
-#define Z80_OPce { ADC(z80, ARG(z80));														} /* ADC  A,n         */
-#define Z80_OPcf { RST(z80, 0x08);															} /* RST  1           */
-
-#define Z80_OPd0 { RET_COND(z80, !(z80->F & CF), 0xd0);									} /* RET  NC          */
-#define Z80_OPd1 { P#define Z80_OPz80, de);															} /* POP  DE          */
-#define Z80_OPd2 { JP_COND(z80, !(z80->F & CF));											} /* JP   NC,a        */
-#define Z80_OPd3 { unsigned n = ARG(z80) | (z80->A << 8); OUT(z80, n, z80->A);	z80->WZ_L = ((n & 0xff) + 1) & 0xff;  z80->WZ_H = z80->A;	} /* OUT  (n),A       */
-#define Z80_OPd4 { CALL_COND(z80, !(z80->F & CF), 0xd4);									} /* CALL NC,a        */
-#define Z80_OPd5 { PUSH(z80, de);															} /* PUSH DE          */
-#define Z80_OPd6 { SUB(z80, ARG(z80));														} /* SUB  n           */
-#define Z80_OPd7 { RST(z80, 0x10);															} /* RST  2           */
-
-#define Z80_OPd8 { RET_COND(z80, z80->F & CF, 0xd8);										} /* RET  C           */
-#define Z80_OPd9 { EXX(z80);																} /* EXX              */
-#define Z80_OPda { JP_COND(z80, z80->F & CF);												} /* JP   C,a         */
-#define Z80_OPdb { unsigned n = ARG(z80) | (z80->A << 8); z80->A = IN(z80, n);	z80->WZ = n + 1; } /* IN   A,(n)  */
-#define Z80_OPdc { CALL_COND(z80, z80->F & CF, 0xdc);										} /* CALL C,a         */
-#define Z80_OPdd { z80->r++; EXEC(z80,dd,R#define Z80_OPz80));										} /* **** DD xx       */
-#define Z80_OPde { SBC(z80, ARG(z80));														} /* SBC  A,n         */
-#define Z80_OPdf { RST(z80, 0x18);															} /* RST  3           */
-
-#define Z80_OPe0 { RET_COND(z80, !(z80->F & PF), 0xe0);									} /* RET  PO          */
-#define Z80_OPe1 { P#define Z80_OPz80, hl);															} /* POP  HL          */
-#define Z80_OPe2 { JP_COND(z80, !(z80->F & PF));											} /* JP   PO,a        */
-#define Z80_OPe3 { EXSP(z80, hl);															} /* EX   HL,(SP)     */
-#define Z80_OPe4 { CALL_COND(z80, !(z80->F & PF), 0xe4);									} /* CALL PO,a        */
-#define Z80_OPe5 { PUSH(z80, hl);															} /* PUSH HL          */
-#define Z80_OPe6 { AND(z80, ARG(z80));														} /* AND  n           */
-#define Z80_OPe7 { RST(z80, 0x20);															} /* RST  4           */
-
-#define Z80_OPe8 { RET_COND(z80, z80->F & PF, 0xe8);										} /* RET  PE          */
-#define Z80_OPe9 { z80->PC = z80->HL;														} /* JP   (HL)        */
-#define Z80_OPea { JP_COND(z80, z80->F & PF);												} /* JP   PE,a        */
-#define Z80_OPeb { EX_DE_HL(z80);															} /* EX   DE,HL       */
-#define Z80_OPec { CALL_COND(z80, z80->F & PF, 0xec);										} /* CALL PE,a        */
-#define Z80_OPed { z80->r++; EXEC(z80,ed,R#define Z80_OPz80));										} /* **** ED xx       */
-#define Z80_OPee { XOR(z80, ARG(z80));														} /* XOR  n           */
-#define Z80_OPef { RST(z80, 0x28);															} /* RST  5           */
-
-#define Z80_OPf0 { RET_COND(z80, !(z80->F & SF), 0xf0);									} /* RET  P           */
-#define Z80_OPf1 { P#define Z80_OPz80, af);															} /* POP  AF          */
-#define Z80_OPf2 { JP_COND(z80, !(z80->F & SF));											} /* JP   P,a         */
-#define Z80_OPf3 { z80->iff1 = z80->iff2 = 0;												} /* DI               */
-#define Z80_OPf4 { CALL_COND(z80, !(z80->F & SF), 0xf4);									} /* CALL P,a         */
-#define Z80_OPf5 { PUSH(z80, af);															} /* PUSH AF          */
-#define Z80_OPf6 { OR(z80, ARG(z80));														} /* OR   n           */
-#define Z80_OPf7 { RST(z80, 0x30);															} /* RST  6           */
-
-#define Z80_OPf8 { RET_COND(z80, z80->F & SF, 0xf8);										} /* RET  M           */
-#define Z80_OPf9 { z80->SP = z80->HL;														} /* LD   SP,HL       */
-#define Z80_OPfa { JP_COND(z80, z80->F & SF);												} /* JP   M,a         */
-#define Z80_OPfb { EI(z80);																} /* EI               */
-#define Z80_OPfc { CALL_COND(z80, z80->F & SF, 0xfc);										} /* CALL M,a         */
-#define Z80_OPfd { z80->r++; EXEC(z80,fd,R#define Z80_OPz80));										} /* **** FD xx       */
-#define Z80_OPfe { CP(z80, ARG(z80));														} /* CP   n           */
-#define Z80_OPff { RST(z80, 0x38);															} /* RST  7           */
+#define Z80_OP80 { ADD(B);														} /* ADD  A,B         */
+#define Z80_OP81 { ADD(C);														} /* ADD  A,C         */
+#define Z80_OP82 { ADD(D);														} /* ADD  A,D         */
+#define Z80_OP83 { ADD(E);														} /* ADD  A,E         */
+#define Z80_OP84 { ADD(H);														} /* ADD  A,H         */
+#define Z80_OP85 { ADD(L);														} /* ADD  A,L         */
+#define Z80_OP86 { ADD(RM(HL));												} /* ADD  A,(HL)      */
+#define Z80_OP87 { ADD(A);														} /* ADD  A,A         */
+
+#define Z80_OP88 { ADC(B);														} /* ADC  A,B         */
+#define Z80_OP89 { ADC(C);														} /* ADC  A,C         */
+#define Z80_OP8a { ADC(D);														} /* ADC  A,D         */
+#define Z80_OP8b { ADC(E);														} /* ADC  A,E         */
+#define Z80_OP8c { ADC(H);														} /* ADC  A,H         */
+#define Z80_OP8d { ADC(L);														} /* ADC  A,L         */
+#define Z80_OP8e { ADC(RM(HL));												} /* ADC  A,(HL)      */
+#define Z80_OP8f { ADC(A);														} /* ADC  A,A         */
+
+#define Z80_OP90 { SUB(B);														} /* SUB  B           */
+#define Z80_OP91 { SUB(C);														} /* SUB  C           */
+#define Z80_OP92 { SUB(D);														} /* SUB  D           */
+#define Z80_OP93 { SUB(E);														} /* SUB  E           */
+#define Z80_OP94 { SUB(H);														} /* SUB  H           */
+#define Z80_OP95 { SUB(L);														} /* SUB  L           */
+#define Z80_OP96 { SUB(RM(HL));												} /* SUB  (HL)        */
+#define Z80_OP97 { SUB(A);														} /* SUB  A           */
+
+#define Z80_OP98 { SBC(B);														} /* SBC  A,B         */
+#define Z80_OP99 { SBC(C);														} /* SBC  A,C         */
+#define Z80_OP9a { SBC(D);														} /* SBC  A,D         */
+#define Z80_OP9b { SBC(E);														} /* SBC  A,E         */
+#define Z80_OP9c { SBC(H);														} /* SBC  A,H         */
+#define Z80_OP9d { SBC(L);														} /* SBC  A,L         */
+#define Z80_OP9e { SBC(RM(HL));												} /* SBC  A,(HL)      */
+#define Z80_OP9f { SBC(A);														} /* SBC  A,A         */
+
+#define Z80_OPa0 { AND(B);														} /* AND  B           */
+#define Z80_OPa1 { AND(C);														} /* AND  C           */
+#define Z80_OPa2 { AND(D);														} /* AND  D           */
+#define Z80_OPa3 { AND(E);														} /* AND  E           */
+#define Z80_OPa4 { AND(H);														} /* AND  H           */
+#define Z80_OPa5 { AND(L);														} /* AND  L           */
+#define Z80_OPa6 { AND(RM(HL));												} /* AND  (HL)        */
+#define Z80_OPa7 { AND(A);														} /* AND  A           */
+
+#define Z80_OPa8 { XOR(B);														} /* XOR  B           */
+#define Z80_OPa9 { XOR(C);														} /* XOR  C           */
+#define Z80_OPaa { XOR(D);														} /* XOR  D           */
+#define Z80_OPab { XOR(E);														} /* XOR  E           */
+#define Z80_OPac { XOR(H);														} /* XOR  H           */
+#define Z80_OPad { XOR(L);														} /* XOR  L           */
+#define Z80_OPae { XOR(RM(HL));												} /* XOR  (HL)        */
+#define Z80_OPaf { XOR(A);														} /* XOR  A           */
+
+#define Z80_OPb0 { OR(B);														} /* OR   B           */
+#define Z80_OPb1 { OR(C);														} /* OR   C           */
+#define Z80_OPb2 { OR(D);														} /* OR   D           */
+#define Z80_OPb3 { OR(E);														} /* OR   E           */
+#define Z80_OPb4 { OR(H);														} /* OR   H           */
+#define Z80_OPb5 { OR(L);														} /* OR   L           */
+#define Z80_OPb6 { OR(RM(HL));												} /* OR   (HL)        */
+#define Z80_OPb7 { OR(A);														} /* OR   A           */
+
+#define Z80_OPb8 { CP(B);														} /* CP   B           */
+#define Z80_OPb9 { CP(C);														} /* CP   C           */
+#define Z80_OPba { CP(D);														} /* CP   D           */
+#define Z80_OPbb { CP(E);														} /* CP   E           */
+#define Z80_OPbc { CP(H);														} /* CP   H           */
+#define Z80_OPbd { CP(L);														} /* CP   L           */
+#define Z80_OPbe { CP(RM(HL));												} /* CP   (HL)        */
+#define Z80_OPbf { CP(A);														} /* CP   A           */
+
+#define Z80_OPc0 { RET_COND(!(F & ZF), 0xc0);									} /* RET  NZ          */
+#define Z80_OPc1 { POP(bc);															} /* POP  BC          */
+#define Z80_OPc2 { JP_COND(!(F & ZF));											} /* JP   NZ,a        */
+#define Z80_OPc3 { JP();																} /* JP   a           */
+#define Z80_OPc4 { CALL_COND(!(F & ZF), 0xc4);									} /* CALL NZ,a        */
+#define Z80_OPc5 { PUSH(bc);															} /* PUSH BC          */
+#define Z80_OPc6 { ADD(ARG());														} /* ADD  A,n         */
+#define Z80_OPc7 { RST(0x00);															} /* RST  0           */
+
+#define Z80_OPc8 { RET_COND(F & ZF, 0xc8);										} /* RET  Z           */
+#define Z80_OPc9 { POP(pc); WZ=PCD;											} /* RET              */
+#define Z80_OPca { JP_COND(F & ZF);												} /* JP   Z,a         */
+#define Z80_OPcb { r++; Z80_EXECUTE_PREFIX(Z80CB, cb);										} /* **** CB xx       */
+#define Z80_OPcc { CALL_COND(F & ZF, 0xcc);										} /* CALL Z,a         */
+#define Z80_OPcd { CALL();																} /* CALL a           */
+#define Z80_OPce { ADC(ARG());														} /* ADC  A,n         */
+#define Z80_OPcf { RST(0x08);															} /* RST  1           */
+
+#define Z80_OPd0 { RET_COND(!(F & CF), 0xd0);									} /* RET  NC          */
+#define Z80_OPd1 { POP(de);															} /* POP  DE          */
+#define Z80_OPd2 { JP_COND(!(F & CF));											} /* JP   NC,a        */
+#define Z80_OPd3 { OEInt n = ARG() | (A << 8); OUT(n, A);	WZ_L = ((n & 0xff) + 1) & 0xff;  WZ_H = A;	} /* OUT  (n),A       */
+#define Z80_OPd4 { CALL_COND(!(F & CF), 0xd4);									} /* CALL NC,a        */
+#define Z80_OPd5 { PUSH(de);															} /* PUSH DE          */
+#define Z80_OPd6 { SUB(ARG());														} /* SUB  n           */
+#define Z80_OPd7 { RST(0x10);															} /* RST  2           */
+
+#define Z80_OPd8 { RET_COND(F & CF, 0xd8);										} /* RET  C           */
+#define Z80_OPd9 { EXX();																} /* EXX              */
+#define Z80_OPda { JP_COND(F & CF);												} /* JP   C,a         */
+#define Z80_OPdb { OEInt n = ARG() | (A << 8); A = IN(n);	WZ = n + 1; } /* IN   A,(n)  */
+#define Z80_OPdc { CALL_COND(F & CF, 0xdc);										} /* CALL C,a         */
+#define Z80_OPdd { r++; Z80_EXECUTE_PREFIX(Z80DD, xy);										} /* **** DD xx       */
+#define Z80_OPde { SBC(ARG());														} /* SBC  A,n         */
+#define Z80_OPdf { RST(0x18);															} /* RST  3           */
+
+#define Z80_OPe0 { RET_COND(!(F & PF), 0xe0);									} /* RET  PO          */
+#define Z80_OPe1 { POP(hl);															} /* POP  HL          */
+#define Z80_OPe2 { JP_COND(!(F & PF));											} /* JP   PO,a        */
+#define Z80_OPe3 { EXSP(hl);															} /* EX   HL,(SP)     */
+#define Z80_OPe4 { CALL_COND(!(F & PF), 0xe4);									} /* CALL PO,a        */
+#define Z80_OPe5 { PUSH(hl);															} /* PUSH HL          */
+#define Z80_OPe6 { AND(ARG());														} /* AND  n           */
+#define Z80_OPe7 { RST(0x20);															} /* RST  4           */
+
+#define Z80_OPe8 { RET_COND(F & PF, 0xe8);										} /* RET  PE          */
+#define Z80_OPe9 { PC = HL;														} /* JP   (HL)        */
+#define Z80_OPea { JP_COND(F & PF);												} /* JP   PE,a        */
+#define Z80_OPeb { EX_DE_HL();															} /* EX   DE,HL       */
+#define Z80_OPec { CALL_COND(F & PF, 0xec);										} /* CALL PE,a        */
+#define Z80_OPed { r++; Z80_EXECUTE_PREFIX(Z80ED, ed);										} /* **** ED xx       */
+#define Z80_OPee { XOR(ARG());														} /* XOR  n           */
+#define Z80_OPef { RST(0x28);															} /* RST  5           */
+
+#define Z80_OPf0 { RET_COND(!(F & SF), 0xf0);									} /* RET  P           */
+#define Z80_OPf1 { POP(af);															} /* POP  AF          */
+#define Z80_OPf2 { JP_COND(!(F & SF));											} /* JP   P,a         */
+#define Z80_OPf3 { DI();												} /* DI               */
+#define Z80_OPf4 { CALL_COND(!(F & SF), 0xf4);									} /* CALL P,a         */
+#define Z80_OPf5 { PUSH(af);															} /* PUSH AF          */
+#define Z80_OPf6 { OR(ARG());														} /* OR   n           */
+#define Z80_OPf7 { RST(0x30);															} /* RST  6           */
+
+#define Z80_OPf8 { RET_COND(F & SF, 0xf8);										} /* RET  M           */
+#define Z80_OPf9 { SP = HL;														} /* LD   SP,HL       */
+#define Z80_OPfa { JP_COND(F & SF);												} /* JP   M,a         */
+#define Z80_OPfb { EI();																} /* EI               */
+#define Z80_OPfc { CALL_COND(F & SF, 0xfc);										} /* CALL M,a         */
+#define Z80_OPfd { r++; Z80_EXECUTE_PREFIX(Z80FD, xy);										} /* **** FD xx       */
+#define Z80_OPfe { CP(ARG());														} /* CP   n           */
+#define Z80_OPff { RST(0x38);															} /* RST  7           */
+
+#define Z80_OPCODES(OP) \
+    OP(Z80, 00) OP(Z80, 01) OP(Z80, 02) OP(Z80, 03) OP(Z80, 04) OP(Z80, 05) OP(Z80, 06) OP(Z80, 07) \
+    OP(Z80, 08) OP(Z80, 09) OP(Z80, 0a) OP(Z80, 0b) OP(Z80, 0c) OP(Z80, 0d) OP(Z80, 0e) OP(Z80, 0f) \
+    OP(Z80, 10) OP(Z80, 11) OP(Z80, 12) OP(Z80, 13) OP(Z80, 14) OP(Z80, 15) OP(Z80, 16) OP(Z80, 17) \
+    OP(Z80, 18) OP(Z80, 19) OP(Z80, 1a) OP(Z80, 1b) OP(Z80, 1c) OP(Z80, 1d) OP(Z80, 1e) OP(Z80, 1f) \
+    OP(Z80, 20) OP(Z80, 21) OP(Z80, 22) OP(Z80, 23) OP(Z80, 24) OP(Z80, 25) OP(Z80, 26) OP(Z80, 27) \
+    OP(Z80, 28) OP(Z80, 29) OP(Z80, 2a) OP(Z80, 2b) OP(Z80, 2c) OP(Z80, 2d) OP(Z80, 2e) OP(Z80, 2f) \
+    OP(Z80, 30) OP(Z80, 31) OP(Z80, 32) OP(Z80, 33) OP(Z80, 34) OP(Z80, 35) OP(Z80, 36) OP(Z80, 37) \
+    OP(Z80, 38) OP(Z80, 39) OP(Z80, 3a) OP(Z80, 3b) OP(Z80, 3c) OP(Z80, 3d) OP(Z80, 3e) OP(Z80, 3f) \
+    OP(Z80, 40) OP(Z80, 41) OP(Z80, 42) OP(Z80, 43) OP(Z80, 44) OP(Z80, 45) OP(Z80, 46) OP(Z80, 47) \
+    OP(Z80, 48) OP(Z80, 49) OP(Z80, 4a) OP(Z80, 4b) OP(Z80, 4c) OP(Z80, 4d) OP(Z80, 4e) OP(Z80, 4f) \
+    OP(Z80, 50) OP(Z80, 51) OP(Z80, 52) OP(Z80, 53) OP(Z80, 54) OP(Z80, 55) OP(Z80, 56) OP(Z80, 57) \
+    OP(Z80, 58) OP(Z80, 59) OP(Z80, 5a) OP(Z80, 5b) OP(Z80, 5c) OP(Z80, 5d) OP(Z80, 5e) OP(Z80, 5f) \
+    OP(Z80, 60) OP(Z80, 61) OP(Z80, 62) OP(Z80, 63) OP(Z80, 64) OP(Z80, 65) OP(Z80, 66) OP(Z80, 67) \
+    OP(Z80, 68) OP(Z80, 69) OP(Z80, 6a) OP(Z80, 6b) OP(Z80, 6c) OP(Z80, 6d) OP(Z80, 6e) OP(Z80, 6f) \
+    OP(Z80, 70) OP(Z80, 71) OP(Z80, 72) OP(Z80, 73) OP(Z80, 74) OP(Z80, 75) OP(Z80, 76) OP(Z80, 77) \
+    OP(Z80, 78) OP(Z80, 79) OP(Z80, 7a) OP(Z80, 7b) OP(Z80, 7c) OP(Z80, 7d) OP(Z80, 7e) OP(Z80, 7f) \
+    OP(Z80, 80) OP(Z80, 81) OP(Z80, 82) OP(Z80, 83) OP(Z80, 84) OP(Z80, 85) OP(Z80, 86) OP(Z80, 87) \
+    OP(Z80, 88) OP(Z80, 89) OP(Z80, 8a) OP(Z80, 8b) OP(Z80, 8c) OP(Z80, 8d) OP(Z80, 8e) OP(Z80, 8f) \
+    OP(Z80, 90) OP(Z80, 91) OP(Z80, 92) OP(Z80, 93) OP(Z80, 94) OP(Z80, 95) OP(Z80, 96) OP(Z80, 97) \
+    OP(Z80, 98) OP(Z80, 99) OP(Z80, 9a) OP(Z80, 9b) OP(Z80, 9c) OP(Z80, 9d) OP(Z80, 9e) OP(Z80, 9f) \
+    OP(Z80, a0) OP(Z80, a1) OP(Z80, a2) OP(Z80, a3) OP(Z80, a4) OP(Z80, a5) OP(Z80, a6) OP(Z80, a7) \
+    OP(Z80, a8) OP(Z80, a9) OP(Z80, aa) OP(Z80, ab) OP(Z80, ac) OP(Z80, ad) OP(Z80, ae) OP(Z80, af) \
+    OP(Z80, b0) OP(Z80, b1) OP(Z80, b2) OP(Z80, b3) OP(Z80, b4) OP(Z80, b5) OP(Z80, b6) OP(Z80, b7) \
+    OP(Z80, b8) OP(Z80, b9) OP(Z80, ba) OP(Z80, bb) OP(Z80, bc) OP(Z80, bd) OP(Z80, be) OP(Z80, bf) \
+    OP(Z80, c0) OP(Z80, c1) OP(Z80, c2) OP(Z80, c3) OP(Z80, c4) OP(Z80, c5) OP(Z80, c6) OP(Z80, c7) \
+    OP(Z80, c8) OP(Z80, c9) OP(Z80, ca) OP(Z80, cb) OP(Z80, cc) OP(Z80, cd) OP(Z80, ce) OP(Z80, cf) \
+    OP(Z80, d0) OP(Z80, d1) OP(Z80, d2) OP(Z80, d3) OP(Z80, d4) OP(Z80, d5) OP(Z80, d6) OP(Z80, d7) \
+    OP(Z80, d8) OP(Z80, d9) OP(Z80, da) OP(Z80, db) OP(Z80, dc) OP(Z80, dd) OP(Z80, de) OP(Z80, df) \
+    OP(Z80, e0) OP(Z80, e1) OP(Z80, e2) OP(Z80, e3) OP(Z80, e4) OP(Z80, e5) OP(Z80, e6) OP(Z80, e7) \
+    OP(Z80, e8) OP(Z80, e9) OP(Z80, ea) OP(Z80, eb) OP(Z80, ec) OP(Z80, ed) OP(Z80, ee) OP(Z80, ef) \
+    OP(Z80, f0) OP(Z80, f1) OP(Z80, f2) OP(Z80, f3) OP(Z80, f4) OP(Z80, f5) OP(Z80, f6) OP(Z80, f7) \
+    OP(Z80, f8) OP(Z80, f9) OP(Z80, fa) OP(Z80, fb) OP(Z80, fc) OP(Z80, fd) OP(Z80, fe) OP(Z80, ff)
+
+#define Z80CB_OPCODES(OP) \
+    OP(Z80CB, 00) OP(Z80CB, 01) OP(Z80CB, 02) OP(Z80CB, 03) OP(Z80CB, 04) OP(Z80CB, 05) OP(Z80CB, 06) OP(Z80CB, 07) \
+    OP(Z80CB, 08) OP(Z80CB, 09) OP(Z80CB, 0a) OP(Z80CB, 0b) OP(Z80CB, 0c) OP(Z80CB, 0d) OP(Z80CB, 0e) OP(Z80CB, 0f) \
+    OP(Z80CB, 10) OP(Z80CB, 11) OP(Z80CB, 12) OP(Z80CB, 13) OP(Z80CB, 14) OP(Z80CB, 15) OP(Z80CB, 16) OP(Z80CB, 17) \
+    OP(Z80CB, 18) OP(Z80CB, 19) OP(Z80CB, 1a) OP(Z80CB, 1b) OP(Z80CB, 1c) OP(Z80CB, 1d) OP(Z80CB, 1e) OP(Z80CB, 1f) \
+    OP(Z80CB, 20) OP(Z80CB, 21) OP(Z80CB, 22) OP(Z80CB, 23) OP(Z80CB, 24) OP(Z80CB, 25) OP(Z80CB, 26) OP(Z80CB, 27) \
+    OP(Z80CB, 28) OP(Z80CB, 29) OP(Z80CB, 2a) OP(Z80CB, 2b) OP(Z80CB, 2c) OP(Z80CB, 2d) OP(Z80CB, 2e) OP(Z80CB, 2f) \
+    OP(Z80CB, 30) OP(Z80CB, 31) OP(Z80CB, 32) OP(Z80CB, 33) OP(Z80CB, 34) OP(Z80CB, 35) OP(Z80CB, 36) OP(Z80CB, 37) \
+    OP(Z80CB, 38) OP(Z80CB, 39) OP(Z80CB, 3a) OP(Z80CB, 3b) OP(Z80CB, 3c) OP(Z80CB, 3d) OP(Z80CB, 3e) OP(Z80CB, 3f) \
+    OP(Z80CB, 40) OP(Z80CB, 41) OP(Z80CB, 42) OP(Z80CB, 43) OP(Z80CB, 44) OP(Z80CB, 45) OP(Z80CB, 46) OP(Z80CB, 47) \
+    OP(Z80CB, 48) OP(Z80CB, 49) OP(Z80CB, 4a) OP(Z80CB, 4b) OP(Z80CB, 4c) OP(Z80CB, 4d) OP(Z80CB, 4e) OP(Z80CB, 4f) \
+    OP(Z80CB, 50) OP(Z80CB, 51) OP(Z80CB, 52) OP(Z80CB, 53) OP(Z80CB, 54) OP(Z80CB, 55) OP(Z80CB, 56) OP(Z80CB, 57) \
+    OP(Z80CB, 58) OP(Z80CB, 59) OP(Z80CB, 5a) OP(Z80CB, 5b) OP(Z80CB, 5c) OP(Z80CB, 5d) OP(Z80CB, 5e) OP(Z80CB, 5f) \
+    OP(Z80CB, 60) OP(Z80CB, 61) OP(Z80CB, 62) OP(Z80CB, 63) OP(Z80CB, 64) OP(Z80CB, 65) OP(Z80CB, 66) OP(Z80CB, 67) \
+    OP(Z80CB, 68) OP(Z80CB, 69) OP(Z80CB, 6a) OP(Z80CB, 6b) OP(Z80CB, 6c) OP(Z80CB, 6d) OP(Z80CB, 6e) OP(Z80CB, 6f) \
+    OP(Z80CB, 70) OP(Z80CB, 71) OP(Z80CB, 72) OP(Z80CB, 73) OP(Z80CB, 74) OP(Z80CB, 75) OP(Z80CB, 76) OP(Z80CB, 77) \
+    OP(Z80CB, 78) OP(Z80CB, 79) OP(Z80CB, 7a) OP(Z80CB, 7b) OP(Z80CB, 7c) OP(Z80CB, 7d) OP(Z80CB, 7e) OP(Z80CB, 7f) \
+    OP(Z80CB, 80) OP(Z80CB, 81) OP(Z80CB, 82) OP(Z80CB, 83) OP(Z80CB, 84) OP(Z80CB, 85) OP(Z80CB, 86) OP(Z80CB, 87) \
+    OP(Z80CB, 88) OP(Z80CB, 89) OP(Z80CB, 8a) OP(Z80CB, 8b) OP(Z80CB, 8c) OP(Z80CB, 8d) OP(Z80CB, 8e) OP(Z80CB, 8f) \
+    OP(Z80CB, 90) OP(Z80CB, 91) OP(Z80CB, 92) OP(Z80CB, 93) OP(Z80CB, 94) OP(Z80CB, 95) OP(Z80CB, 96) OP(Z80CB, 97) \
+    OP(Z80CB, 98) OP(Z80CB, 99) OP(Z80CB, 9a) OP(Z80CB, 9b) OP(Z80CB, 9c) OP(Z80CB, 9d) OP(Z80CB, 9e) OP(Z80CB, 9f) \
+    OP(Z80CB, a0) OP(Z80CB, a1) OP(Z80CB, a2) OP(Z80CB, a3) OP(Z80CB, a4) OP(Z80CB, a5) OP(Z80CB, a6) OP(Z80CB, a7) \
+    OP(Z80CB, a8) OP(Z80CB, a9) OP(Z80CB, aa) OP(Z80CB, ab) OP(Z80CB, ac) OP(Z80CB, ad) OP(Z80CB, ae) OP(Z80CB, af) \
+    OP(Z80CB, b0) OP(Z80CB, b1) OP(Z80CB, b2) OP(Z80CB, b3) OP(Z80CB, b4) OP(Z80CB, b5) OP(Z80CB, b6) OP(Z80CB, b7) \
+    OP(Z80CB, b8) OP(Z80CB, b9) OP(Z80CB, ba) OP(Z80CB, bb) OP(Z80CB, bc) OP(Z80CB, bd) OP(Z80CB, be) OP(Z80CB, bf) \
+    OP(Z80CB, c0) OP(Z80CB, c1) OP(Z80CB, c2) OP(Z80CB, c3) OP(Z80CB, c4) OP(Z80CB, c5) OP(Z80CB, c6) OP(Z80CB, c7) \
+    OP(Z80CB, c8) OP(Z80CB, c9) OP(Z80CB, ca) OP(Z80CB, cb) OP(Z80CB, cc) OP(Z80CB, cd) OP(Z80CB, ce) OP(Z80CB, cf) \
+    OP(Z80CB, d0) OP(Z80CB, d1) OP(Z80CB, d2) OP(Z80CB, d3) OP(Z80CB, d4) OP(Z80CB, d5) OP(Z80CB, d6) OP(Z80CB, d7) \
+    OP(Z80CB, d8) OP(Z80CB, d9) OP(Z80CB, da) OP(Z80CB, db) OP(Z80CB, dc) OP(Z80CB, dd) OP(Z80CB, de) OP(Z80CB, df) \
+    OP(Z80CB, e0) OP(Z80CB, e1) OP(Z80CB, e2) OP(Z80CB, e3) OP(Z80CB, e4) OP(Z80CB, e5) OP(Z80CB, e6) OP(Z80CB, e7) \
+    OP(Z80CB, e8) OP(Z80CB, e9) OP(Z80CB, ea) OP(Z80CB, eb) OP(Z80CB, ec) OP(Z80CB, ed) OP(Z80CB, ee) OP(Z80CB, ef) \
+    OP(Z80CB, f0) OP(Z80CB, f1) OP(Z80CB, f2) OP(Z80CB, f3) OP(Z80CB, f4) OP(Z80CB, f5) OP(Z80CB, f6) OP(Z80CB, f7) \
+    OP(Z80CB, f8) OP(Z80CB, f9) OP(Z80CB, fa) OP(Z80CB, fb) OP(Z80CB, fc) OP(Z80CB, fd) OP(Z80CB, fe) OP(Z80CB, ff)
+
+#define Z80DD_OPCODES(OP) \
+    OP(Z80DD, 00) OP(Z80DD, 01) OP(Z80DD, 02) OP(Z80DD, 03) OP(Z80DD, 04) OP(Z80DD, 05) OP(Z80DD, 06) OP(Z80DD, 07) \
+    OP(Z80DD, 08) OP(Z80DD, 09) OP(Z80DD, 0a) OP(Z80DD, 0b) OP(Z80DD, 0c) OP(Z80DD, 0d) OP(Z80DD, 0e) OP(Z80DD, 0f) \
+    OP(Z80DD, 10) OP(Z80DD, 11) OP(Z80DD, 12) OP(Z80DD, 13) OP(Z80DD, 14) OP(Z80DD, 15) OP(Z80DD, 16) OP(Z80DD, 17) \
+    OP(Z80DD, 18) OP(Z80DD, 19) OP(Z80DD, 1a) OP(Z80DD, 1b) OP(Z80DD, 1c) OP(Z80DD, 1d) OP(Z80DD, 1e) OP(Z80DD, 1f) \
+    OP(Z80DD, 20) OP(Z80DD, 21) OP(Z80DD, 22) OP(Z80DD, 23) OP(Z80DD, 24) OP(Z80DD, 25) OP(Z80DD, 26) OP(Z80DD, 27) \
+    OP(Z80DD, 28) OP(Z80DD, 29) OP(Z80DD, 2a) OP(Z80DD, 2b) OP(Z80DD, 2c) OP(Z80DD, 2d) OP(Z80DD, 2e) OP(Z80DD, 2f) \
+    OP(Z80DD, 30) OP(Z80DD, 31) OP(Z80DD, 32) OP(Z80DD, 33) OP(Z80DD, 34) OP(Z80DD, 35) OP(Z80DD, 36) OP(Z80DD, 37) \
+    OP(Z80DD, 38) OP(Z80DD, 39) OP(Z80DD, 3a) OP(Z80DD, 3b) OP(Z80DD, 3c) OP(Z80DD, 3d) OP(Z80DD, 3e) OP(Z80DD, 3f) \
+    OP(Z80DD, 40) OP(Z80DD, 41) OP(Z80DD, 42) OP(Z80DD, 43) OP(Z80DD, 44) OP(Z80DD, 45) OP(Z80DD, 46) OP(Z80DD, 47) \
+    OP(Z80DD, 48) OP(Z80DD, 49) OP(Z80DD, 4a) OP(Z80DD, 4b) OP(Z80DD, 4c) OP(Z80DD, 4d) OP(Z80DD, 4e) OP(Z80DD, 4f) \
+    OP(Z80DD, 50) OP(Z80DD, 51) OP(Z80DD, 52) OP(Z80DD, 53) OP(Z80DD, 54) OP(Z80DD, 55) OP(Z80DD, 56) OP(Z80DD, 57) \
+    OP(Z80DD, 58) OP(Z80DD, 59) OP(Z80DD, 5a) OP(Z80DD, 5b) OP(Z80DD, 5c) OP(Z80DD, 5d) OP(Z80DD, 5e) OP(Z80DD, 5f) \
+    OP(Z80DD, 60) OP(Z80DD, 61) OP(Z80DD, 62) OP(Z80DD, 63) OP(Z80DD, 64) OP(Z80DD, 65) OP(Z80DD, 66) OP(Z80DD, 67) \
+    OP(Z80DD, 68) OP(Z80DD, 69) OP(Z80DD, 6a) OP(Z80DD, 6b) OP(Z80DD, 6c) OP(Z80DD, 6d) OP(Z80DD, 6e) OP(Z80DD, 6f) \
+    OP(Z80DD, 70) OP(Z80DD, 71) OP(Z80DD, 72) OP(Z80DD, 73) OP(Z80DD, 74) OP(Z80DD, 75) OP(Z80DD, 76) OP(Z80DD, 77) \
+    OP(Z80DD, 78) OP(Z80DD, 79) OP(Z80DD, 7a) OP(Z80DD, 7b) OP(Z80DD, 7c) OP(Z80DD, 7d) OP(Z80DD, 7e) OP(Z80DD, 7f) \
+    OP(Z80DD, 80) OP(Z80DD, 81) OP(Z80DD, 82) OP(Z80DD, 83) OP(Z80DD, 84) OP(Z80DD, 85) OP(Z80DD, 86) OP(Z80DD, 87) \
+    OP(Z80DD, 88) OP(Z80DD, 89) OP(Z80DD, 8a) OP(Z80DD, 8b) OP(Z80DD, 8c) OP(Z80DD, 8d) OP(Z80DD, 8e) OP(Z80DD, 8f) \
+    OP(Z80DD, 90) OP(Z80DD, 91) OP(Z80DD, 92) OP(Z80DD, 93) OP(Z80DD, 94) OP(Z80DD, 95) OP(Z80DD, 96) OP(Z80DD, 97) \
+    OP(Z80DD, 98) OP(Z80DD, 99) OP(Z80DD, 9a) OP(Z80DD, 9b) OP(Z80DD, 9c) OP(Z80DD, 9d) OP(Z80DD, 9e) OP(Z80DD, 9f) \
+    OP(Z80DD, a0) OP(Z80DD, a1) OP(Z80DD, a2) OP(Z80DD, a3) OP(Z80DD, a4) OP(Z80DD, a5) OP(Z80DD, a6) OP(Z80DD, a7) \
+    OP(Z80DD, a8) OP(Z80DD, a9) OP(Z80DD, aa) OP(Z80DD, ab) OP(Z80DD, ac) OP(Z80DD, ad) OP(Z80DD, ae) OP(Z80DD, af) \
+    OP(Z80DD, b0) OP(Z80DD, b1) OP(Z80DD, b2) OP(Z80DD, b3) OP(Z80DD, b4) OP(Z80DD, b5) OP(Z80DD, b6) OP(Z80DD, b7) \
+    OP(Z80DD, b8) OP(Z80DD, b9) OP(Z80DD, ba) OP(Z80DD, bb) OP(Z80DD, bc) OP(Z80DD, bd) OP(Z80DD, be) OP(Z80DD, bf) \
+    OP(Z80DD, c0) OP(Z80DD, c1) OP(Z80DD, c2) OP(Z80DD, c3) OP(Z80DD, c4) OP(Z80DD, c5) OP(Z80DD, c6) OP(Z80DD, c7) \
+    OP(Z80DD, c8) OP(Z80DD, c9) OP(Z80DD, ca) OP(Z80DD, cb) OP(Z80DD, cc) OP(Z80DD, cd) OP(Z80DD, ce) OP(Z80DD, cf) \
+    OP(Z80DD, d0) OP(Z80DD, d1) OP(Z80DD, d2) OP(Z80DD, d3) OP(Z80DD, d4) OP(Z80DD, d5) OP(Z80DD, d6) OP(Z80DD, d7) \
+    OP(Z80DD, d8) OP(Z80DD, d9) OP(Z80DD, da) OP(Z80DD, db) OP(Z80DD, dc) OP(Z80DD, dd) OP(Z80DD, de) OP(Z80DD, df) \
+    OP(Z80DD, e0) OP(Z80DD, e1) OP(Z80DD, e2) OP(Z80DD, e3) OP(Z80DD, e4) OP(Z80DD, e5) OP(Z80DD, e6) OP(Z80DD, e7) \
+    OP(Z80DD, e8) OP(Z80DD, e9) OP(Z80DD, ea) OP(Z80DD, eb) OP(Z80DD, ec) OP(Z80DD, ed) OP(Z80DD, ee) OP(Z80DD, ef) \
+    OP(Z80DD, f0) OP(Z80DD, f1) OP(Z80DD, f2) OP(Z80DD, f3) OP(Z80DD, f4) OP(Z80DD, f5) OP(Z80DD, f6) OP(Z80DD, f7) \
+    OP(Z80DD, f8) OP(Z80DD, f9) OP(Z80DD, fa) OP(Z80DD, fb) OP(Z80DD, fc) OP(Z80DD, fd) OP(Z80DD, fe) OP(Z80DD, ff)
+
+#define Z80ED_OPCODES(OP) \
+    OP(Z80ED, 00) OP(Z80ED, 01) OP(Z80ED, 02) OP(Z80ED, 03) OP(Z80ED, 04) OP(Z80ED, 05) OP(Z80ED, 06) OP(Z80ED, 07) \
+    OP(Z80ED, 08) OP(Z80ED, 09) OP(Z80ED, 0a) OP(Z80ED, 0b) OP(Z80ED, 0c) OP(Z80ED, 0d) OP(Z80ED, 0e) OP(Z80ED, 0f) \
+    OP(Z80ED, 10) OP(Z80ED, 11) OP(Z80ED, 12) OP(Z80ED, 13) OP(Z80ED, 14) OP(Z80ED, 15) OP(Z80ED, 16) OP(Z80ED, 17) \
+    OP(Z80ED, 18) OP(Z80ED, 19) OP(Z80ED, 1a) OP(Z80ED, 1b) OP(Z80ED, 1c) OP(Z80ED, 1d) OP(Z80ED, 1e) OP(Z80ED, 1f) \
+    OP(Z80ED, 20) OP(Z80ED, 21) OP(Z80ED, 22) OP(Z80ED, 23) OP(Z80ED, 24) OP(Z80ED, 25) OP(Z80ED, 26) OP(Z80ED, 27) \
+    OP(Z80ED, 28) OP(Z80ED, 29) OP(Z80ED, 2a) OP(Z80ED, 2b) OP(Z80ED, 2c) OP(Z80ED, 2d) OP(Z80ED, 2e) OP(Z80ED, 2f) \
+    OP(Z80ED, 30) OP(Z80ED, 31) OP(Z80ED, 32) OP(Z80ED, 33) OP(Z80ED, 34) OP(Z80ED, 35) OP(Z80ED, 36) OP(Z80ED, 37) \
+    OP(Z80ED, 38) OP(Z80ED, 39) OP(Z80ED, 3a) OP(Z80ED, 3b) OP(Z80ED, 3c) OP(Z80ED, 3d) OP(Z80ED, 3e) OP(Z80ED, 3f) \
+    OP(Z80ED, 40) OP(Z80ED, 41) OP(Z80ED, 42) OP(Z80ED, 43) OP(Z80ED, 44) OP(Z80ED, 45) OP(Z80ED, 46) OP(Z80ED, 47) \
+    OP(Z80ED, 48) OP(Z80ED, 49) OP(Z80ED, 4a) OP(Z80ED, 4b) OP(Z80ED, 4c) OP(Z80ED, 4d) OP(Z80ED, 4e) OP(Z80ED, 4f) \
+    OP(Z80ED, 50) OP(Z80ED, 51) OP(Z80ED, 52) OP(Z80ED, 53) OP(Z80ED, 54) OP(Z80ED, 55) OP(Z80ED, 56) OP(Z80ED, 57) \
+    OP(Z80ED, 58) OP(Z80ED, 59) OP(Z80ED, 5a) OP(Z80ED, 5b) OP(Z80ED, 5c) OP(Z80ED, 5d) OP(Z80ED, 5e) OP(Z80ED, 5f) \
+    OP(Z80ED, 60) OP(Z80ED, 61) OP(Z80ED, 62) OP(Z80ED, 63) OP(Z80ED, 64) OP(Z80ED, 65) OP(Z80ED, 66) OP(Z80ED, 67) \
+    OP(Z80ED, 68) OP(Z80ED, 69) OP(Z80ED, 6a) OP(Z80ED, 6b) OP(Z80ED, 6c) OP(Z80ED, 6d) OP(Z80ED, 6e) OP(Z80ED, 6f) \
+    OP(Z80ED, 70) OP(Z80ED, 71) OP(Z80ED, 72) OP(Z80ED, 73) OP(Z80ED, 74) OP(Z80ED, 75) OP(Z80ED, 76) OP(Z80ED, 77) \
+    OP(Z80ED, 78) OP(Z80ED, 79) OP(Z80ED, 7a) OP(Z80ED, 7b) OP(Z80ED, 7c) OP(Z80ED, 7d) OP(Z80ED, 7e) OP(Z80ED, 7f) \
+    OP(Z80ED, 80) OP(Z80ED, 81) OP(Z80ED, 82) OP(Z80ED, 83) OP(Z80ED, 84) OP(Z80ED, 85) OP(Z80ED, 86) OP(Z80ED, 87) \
+    OP(Z80ED, 88) OP(Z80ED, 89) OP(Z80ED, 8a) OP(Z80ED, 8b) OP(Z80ED, 8c) OP(Z80ED, 8d) OP(Z80ED, 8e) OP(Z80ED, 8f) \
+    OP(Z80ED, 90) OP(Z80ED, 91) OP(Z80ED, 92) OP(Z80ED, 93) OP(Z80ED, 94) OP(Z80ED, 95) OP(Z80ED, 96) OP(Z80ED, 97) \
+    OP(Z80ED, 98) OP(Z80ED, 99) OP(Z80ED, 9a) OP(Z80ED, 9b) OP(Z80ED, 9c) OP(Z80ED, 9d) OP(Z80ED, 9e) OP(Z80ED, 9f) \
+    OP(Z80ED, a0) OP(Z80ED, a1) OP(Z80ED, a2) OP(Z80ED, a3) OP(Z80ED, a4) OP(Z80ED, a5) OP(Z80ED, a6) OP(Z80ED, a7) \
+    OP(Z80ED, a8) OP(Z80ED, a9) OP(Z80ED, aa) OP(Z80ED, ab) OP(Z80ED, ac) OP(Z80ED, ad) OP(Z80ED, ae) OP(Z80ED, af) \
+    OP(Z80ED, b0) OP(Z80ED, b1) OP(Z80ED, b2) OP(Z80ED, b3) OP(Z80ED, b4) OP(Z80ED, b5) OP(Z80ED, b6) OP(Z80ED, b7) \
+    OP(Z80ED, b8) OP(Z80ED, b9) OP(Z80ED, ba) OP(Z80ED, bb) OP(Z80ED, bc) OP(Z80ED, bd) OP(Z80ED, be) OP(Z80ED, bf) \
+    OP(Z80ED, c0) OP(Z80ED, c1) OP(Z80ED, c2) OP(Z80ED, c3) OP(Z80ED, c4) OP(Z80ED, c5) OP(Z80ED, c6) OP(Z80ED, c7) \
+    OP(Z80ED, c8) OP(Z80ED, c9) OP(Z80ED, ca) OP(Z80ED, cb) OP(Z80ED, cc) OP(Z80ED, cd) OP(Z80ED, ce) OP(Z80ED, cf) \
+    OP(Z80ED, d0) OP(Z80ED, d1) OP(Z80ED, d2) OP(Z80ED, d3) OP(Z80ED, d4) OP(Z80ED, d5) OP(Z80ED, d6) OP(Z80ED, d7) \
+    OP(Z80ED, d8) OP(Z80ED, d9) OP(Z80ED, da) OP(Z80ED, db) OP(Z80ED, dc) OP(Z80ED, dd) OP(Z80ED, de) OP(Z80ED, df) \
+    OP(Z80ED, e0) OP(Z80ED, e1) OP(Z80ED, e2) OP(Z80ED, e3) OP(Z80ED, e4) OP(Z80ED, e5) OP(Z80ED, e6) OP(Z80ED, e7) \
+    OP(Z80ED, e8) OP(Z80ED, e9) OP(Z80ED, ea) OP(Z80ED, eb) OP(Z80ED, ec) OP(Z80ED, ed) OP(Z80ED, ee) OP(Z80ED, ef) \
+    OP(Z80ED, f0) OP(Z80ED, f1) OP(Z80ED, f2) OP(Z80ED, f3) OP(Z80ED, f4) OP(Z80ED, f5) OP(Z80ED, f6) OP(Z80ED, f7) \
+    OP(Z80ED, f8) OP(Z80ED, f9) OP(Z80ED, fa) OP(Z80ED, fb) OP(Z80ED, fc) OP(Z80ED, fd) OP(Z80ED, fe) OP(Z80ED, ff)
+
+#define Z80FD_OPCODES(OP) \
+    OP(Z80FD, 00) OP(Z80FD, 01) OP(Z80FD, 02) OP(Z80FD, 03) OP(Z80FD, 04) OP(Z80FD, 05) OP(Z80FD, 06) OP(Z80FD, 07) \
+    OP(Z80FD, 08) OP(Z80FD, 09) OP(Z80FD, 0a) OP(Z80FD, 0b) OP(Z80FD, 0c) OP(Z80FD, 0d) OP(Z80FD, 0e) OP(Z80FD, 0f) \
+    OP(Z80FD, 10) OP(Z80FD, 11) OP(Z80FD, 12) OP(Z80FD, 13) OP(Z80FD, 14) OP(Z80FD, 15) OP(Z80FD, 16) OP(Z80FD, 17) \
+    OP(Z80FD, 18) OP(Z80FD, 19) OP(Z80FD, 1a) OP(Z80FD, 1b) OP(Z80FD, 1c) OP(Z80FD, 1d) OP(Z80FD, 1e) OP(Z80FD, 1f) \
+    OP(Z80FD, 20) OP(Z80FD, 21) OP(Z80FD, 22) OP(Z80FD, 23) OP(Z80FD, 24) OP(Z80FD, 25) OP(Z80FD, 26) OP(Z80FD, 27) \
+    OP(Z80FD, 28) OP(Z80FD, 29) OP(Z80FD, 2a) OP(Z80FD, 2b) OP(Z80FD, 2c) OP(Z80FD, 2d) OP(Z80FD, 2e) OP(Z80FD, 2f) \
+    OP(Z80FD, 30) OP(Z80FD, 31) OP(Z80FD, 32) OP(Z80FD, 33) OP(Z80FD, 34) OP(Z80FD, 35) OP(Z80FD, 36) OP(Z80FD, 37) \
+    OP(Z80FD, 38) OP(Z80FD, 39) OP(Z80FD, 3a) OP(Z80FD, 3b) OP(Z80FD, 3c) OP(Z80FD, 3d) OP(Z80FD, 3e) OP(Z80FD, 3f) \
+    OP(Z80FD, 40) OP(Z80FD, 41) OP(Z80FD, 42) OP(Z80FD, 43) OP(Z80FD, 44) OP(Z80FD, 45) OP(Z80FD, 46) OP(Z80FD, 47) \
+    OP(Z80FD, 48) OP(Z80FD, 49) OP(Z80FD, 4a) OP(Z80FD, 4b) OP(Z80FD, 4c) OP(Z80FD, 4d) OP(Z80FD, 4e) OP(Z80FD, 4f) \
+    OP(Z80FD, 50) OP(Z80FD, 51) OP(Z80FD, 52) OP(Z80FD, 53) OP(Z80FD, 54) OP(Z80FD, 55) OP(Z80FD, 56) OP(Z80FD, 57) \
+    OP(Z80FD, 58) OP(Z80FD, 59) OP(Z80FD, 5a) OP(Z80FD, 5b) OP(Z80FD, 5c) OP(Z80FD, 5d) OP(Z80FD, 5e) OP(Z80FD, 5f) \
+    OP(Z80FD, 60) OP(Z80FD, 61) OP(Z80FD, 62) OP(Z80FD, 63) OP(Z80FD, 64) OP(Z80FD, 65) OP(Z80FD, 66) OP(Z80FD, 67) \
+    OP(Z80FD, 68) OP(Z80FD, 69) OP(Z80FD, 6a) OP(Z80FD, 6b) OP(Z80FD, 6c) OP(Z80FD, 6d) OP(Z80FD, 6e) OP(Z80FD, 6f) \
+    OP(Z80FD, 70) OP(Z80FD, 71) OP(Z80FD, 72) OP(Z80FD, 73) OP(Z80FD, 74) OP(Z80FD, 75) OP(Z80FD, 76) OP(Z80FD, 77) \
+    OP(Z80FD, 78) OP(Z80FD, 79) OP(Z80FD, 7a) OP(Z80FD, 7b) OP(Z80FD, 7c) OP(Z80FD, 7d) OP(Z80FD, 7e) OP(Z80FD, 7f) \
+    OP(Z80FD, 80) OP(Z80FD, 81) OP(Z80FD, 82) OP(Z80FD, 83) OP(Z80FD, 84) OP(Z80FD, 85) OP(Z80FD, 86) OP(Z80FD, 87) \
+    OP(Z80FD, 88) OP(Z80FD, 89) OP(Z80FD, 8a) OP(Z80FD, 8b) OP(Z80FD, 8c) OP(Z80FD, 8d) OP(Z80FD, 8e) OP(Z80FD, 8f) \
+    OP(Z80FD, 90) OP(Z80FD, 91) OP(Z80FD, 92) OP(Z80FD, 93) OP(Z80FD, 94) OP(Z80FD, 95) OP(Z80FD, 96) OP(Z80FD, 97) \
+    OP(Z80FD, 98) OP(Z80FD, 99) OP(Z80FD, 9a) OP(Z80FD, 9b) OP(Z80FD, 9c) OP(Z80FD, 9d) OP(Z80FD, 9e) OP(Z80FD, 9f) \
+    OP(Z80FD, a0) OP(Z80FD, a1) OP(Z80FD, a2) OP(Z80FD, a3) OP(Z80FD, a4) OP(Z80FD, a5) OP(Z80FD, a6) OP(Z80FD, a7) \
+    OP(Z80FD, a8) OP(Z80FD, a9) OP(Z80FD, aa) OP(Z80FD, ab) OP(Z80FD, ac) OP(Z80FD, ad) OP(Z80FD, ae) OP(Z80FD, af) \
+    OP(Z80FD, b0) OP(Z80FD, b1) OP(Z80FD, b2) OP(Z80FD, b3) OP(Z80FD, b4) OP(Z80FD, b5) OP(Z80FD, b6) OP(Z80FD, b7) \
+    OP(Z80FD, b8) OP(Z80FD, b9) OP(Z80FD, ba) OP(Z80FD, bb) OP(Z80FD, bc) OP(Z80FD, bd) OP(Z80FD, be) OP(Z80FD, bf) \
+    OP(Z80FD, c0) OP(Z80FD, c1) OP(Z80FD, c2) OP(Z80FD, c3) OP(Z80FD, c4) OP(Z80FD, c5) OP(Z80FD, c6) OP(Z80FD, c7) \
+    OP(Z80FD, c8) OP(Z80FD, c9) OP(Z80FD, ca) OP(Z80FD, cb) OP(Z80FD, cc) OP(Z80FD, cd) OP(Z80FD, ce) OP(Z80FD, cf) \
+    OP(Z80FD, d0) OP(Z80FD, d1) OP(Z80FD, d2) OP(Z80FD, d3) OP(Z80FD, d4) OP(Z80FD, d5) OP(Z80FD, d6) OP(Z80FD, d7) \
+    OP(Z80FD, d8) OP(Z80FD, d9) OP(Z80FD, da) OP(Z80FD, db) OP(Z80FD, dc) OP(Z80FD, dd) OP(Z80FD, de) OP(Z80FD, df) \
+    OP(Z80FD, e0) OP(Z80FD, e1) OP(Z80FD, e2) OP(Z80FD, e3) OP(Z80FD, e4) OP(Z80FD, e5) OP(Z80FD, e6) OP(Z80FD, e7) \
+    OP(Z80FD, e8) OP(Z80FD, e9) OP(Z80FD, ea) OP(Z80FD, eb) OP(Z80FD, ec) OP(Z80FD, ed) OP(Z80FD, ee) OP(Z80FD, ef) \
+    OP(Z80FD, f0) OP(Z80FD, f1) OP(Z80FD, f2) OP(Z80FD, f3) OP(Z80FD, f4) OP(Z80FD, f5) OP(Z80FD, f6) OP(Z80FD, f7) \
+    OP(Z80FD, f8) OP(Z80FD, f9) OP(Z80FD, fa) OP(Z80FD, fb) OP(Z80FD, fc) OP(Z80FD, fd) OP(Z80FD, fe) OP(Z80FD, ff)
+
+#define Z80XYCB_OPCODES(OP) \
+    OP(Z80XYCB, 00) OP(Z80XYCB, 01) OP(Z80XYCB, 02) OP(Z80XYCB, 03) OP(Z80XYCB, 04) OP(Z80XYCB, 05) OP(Z80XYCB, 06) OP(Z80XYCB, 07) \
+    OP(Z80XYCB, 08) OP(Z80XYCB, 09) OP(Z80XYCB, 0a) OP(Z80XYCB, 0b) OP(Z80XYCB, 0c) OP(Z80XYCB, 0d) OP(Z80XYCB, 0e) OP(Z80XYCB, 0f) \
+    OP(Z80XYCB, 10) OP(Z80XYCB, 11) OP(Z80XYCB, 12) OP(Z80XYCB, 13) OP(Z80XYCB, 14) OP(Z80XYCB, 15) OP(Z80XYCB, 16) OP(Z80XYCB, 17) \
+    OP(Z80XYCB, 18) OP(Z80XYCB, 19) OP(Z80XYCB, 1a) OP(Z80XYCB, 1b) OP(Z80XYCB, 1c) OP(Z80XYCB, 1d) OP(Z80XYCB, 1e) OP(Z80XYCB, 1f) \
+    OP(Z80XYCB, 20) OP(Z80XYCB, 21) OP(Z80XYCB, 22) OP(Z80XYCB, 23) OP(Z80XYCB, 24) OP(Z80XYCB, 25) OP(Z80XYCB, 26) OP(Z80XYCB, 27) \
+    OP(Z80XYCB, 28) OP(Z80XYCB, 29) OP(Z80XYCB, 2a) OP(Z80XYCB, 2b) OP(Z80XYCB, 2c) OP(Z80XYCB, 2d) OP(Z80XYCB, 2e) OP(Z80XYCB, 2f) \
+    OP(Z80XYCB, 30) OP(Z80XYCB, 31) OP(Z80XYCB, 32) OP(Z80XYCB, 33) OP(Z80XYCB, 34) OP(Z80XYCB, 35) OP(Z80XYCB, 36) OP(Z80XYCB, 37) \
+    OP(Z80XYCB, 38) OP(Z80XYCB, 39) OP(Z80XYCB, 3a) OP(Z80XYCB, 3b) OP(Z80XYCB, 3c) OP(Z80XYCB, 3d) OP(Z80XYCB, 3e) OP(Z80XYCB, 3f) \
+    OP(Z80XYCB, 40) OP(Z80XYCB, 41) OP(Z80XYCB, 42) OP(Z80XYCB, 43) OP(Z80XYCB, 44) OP(Z80XYCB, 45) OP(Z80XYCB, 46) OP(Z80XYCB, 47) \
+    OP(Z80XYCB, 48) OP(Z80XYCB, 49) OP(Z80XYCB, 4a) OP(Z80XYCB, 4b) OP(Z80XYCB, 4c) OP(Z80XYCB, 4d) OP(Z80XYCB, 4e) OP(Z80XYCB, 4f) \
+    OP(Z80XYCB, 50) OP(Z80XYCB, 51) OP(Z80XYCB, 52) OP(Z80XYCB, 53) OP(Z80XYCB, 54) OP(Z80XYCB, 55) OP(Z80XYCB, 56) OP(Z80XYCB, 57) \
+    OP(Z80XYCB, 58) OP(Z80XYCB, 59) OP(Z80XYCB, 5a) OP(Z80XYCB, 5b) OP(Z80XYCB, 5c) OP(Z80XYCB, 5d) OP(Z80XYCB, 5e) OP(Z80XYCB, 5f) \
+    OP(Z80XYCB, 60) OP(Z80XYCB, 61) OP(Z80XYCB, 62) OP(Z80XYCB, 63) OP(Z80XYCB, 64) OP(Z80XYCB, 65) OP(Z80XYCB, 66) OP(Z80XYCB, 67) \
+    OP(Z80XYCB, 68) OP(Z80XYCB, 69) OP(Z80XYCB, 6a) OP(Z80XYCB, 6b) OP(Z80XYCB, 6c) OP(Z80XYCB, 6d) OP(Z80XYCB, 6e) OP(Z80XYCB, 6f) \
+    OP(Z80XYCB, 70) OP(Z80XYCB, 71) OP(Z80XYCB, 72) OP(Z80XYCB, 73) OP(Z80XYCB, 74) OP(Z80XYCB, 75) OP(Z80XYCB, 76) OP(Z80XYCB, 77) \
+    OP(Z80XYCB, 78) OP(Z80XYCB, 79) OP(Z80XYCB, 7a) OP(Z80XYCB, 7b) OP(Z80XYCB, 7c) OP(Z80XYCB, 7d) OP(Z80XYCB, 7e) OP(Z80XYCB, 7f) \
+    OP(Z80XYCB, 80) OP(Z80XYCB, 81) OP(Z80XYCB, 82) OP(Z80XYCB, 83) OP(Z80XYCB, 84) OP(Z80XYCB, 85) OP(Z80XYCB, 86) OP(Z80XYCB, 87) \
+    OP(Z80XYCB, 88) OP(Z80XYCB, 89) OP(Z80XYCB, 8a) OP(Z80XYCB, 8b) OP(Z80XYCB, 8c) OP(Z80XYCB, 8d) OP(Z80XYCB, 8e) OP(Z80XYCB, 8f) \
+    OP(Z80XYCB, 90) OP(Z80XYCB, 91) OP(Z80XYCB, 92) OP(Z80XYCB, 93) OP(Z80XYCB, 94) OP(Z80XYCB, 95) OP(Z80XYCB, 96) OP(Z80XYCB, 97) \
+    OP(Z80XYCB, 98) OP(Z80XYCB, 99) OP(Z80XYCB, 9a) OP(Z80XYCB, 9b) OP(Z80XYCB, 9c) OP(Z80XYCB, 9d) OP(Z80XYCB, 9e) OP(Z80XYCB, 9f) \
+    OP(Z80XYCB, a0) OP(Z80XYCB, a1) OP(Z80XYCB, a2) OP(Z80XYCB, a3) OP(Z80XYCB, a4) OP(Z80XYCB, a5) OP(Z80XYCB, a6) OP(Z80XYCB, a7) \
+    OP(Z80XYCB, a8) OP(Z80XYCB, a9) OP(Z80XYCB, aa) OP(Z80XYCB, ab) OP(Z80XYCB, ac) OP(Z80XYCB, ad) OP(Z80XYCB, ae) OP(Z80XYCB, af) \
+    OP(Z80XYCB, b0) OP(Z80XYCB, b1) OP(Z80XYCB, b2) OP(Z80XYCB, b3) OP(Z80XYCB, b4) OP(Z80XYCB, b5) OP(Z80XYCB, b6) OP(Z80XYCB, b7) \
+    OP(Z80XYCB, b8) OP(Z80XYCB, b9) OP(Z80XYCB, ba) OP(Z80XYCB, bb) OP(Z80XYCB, bc) OP(Z80XYCB, bd) OP(Z80XYCB, be) OP(Z80XYCB, bf) \
+    OP(Z80XYCB, c0) OP(Z80XYCB, c1) OP(Z80XYCB, c2) OP(Z80XYCB, c3) OP(Z80XYCB, c4) OP(Z80XYCB, c5) OP(Z80XYCB, c6) OP(Z80XYCB, c7) \
+    OP(Z80XYCB, c8) OP(Z80XYCB, c9) OP(Z80XYCB, ca) OP(Z80XYCB, cb) OP(Z80XYCB, cc) OP(Z80XYCB, cd) OP(Z80XYCB, ce) OP(Z80XYCB, cf) \
+    OP(Z80XYCB, d0) OP(Z80XYCB, d1) OP(Z80XYCB, d2) OP(Z80XYCB, d3) OP(Z80XYCB, d4) OP(Z80XYCB, d5) OP(Z80XYCB, d6) OP(Z80XYCB, d7) \
+    OP(Z80XYCB, d8) OP(Z80XYCB, d9) OP(Z80XYCB, da) OP(Z80XYCB, db) OP(Z80XYCB, dc) OP(Z80XYCB, dd) OP(Z80XYCB, de) OP(Z80XYCB, df) \
+    OP(Z80XYCB, e0) OP(Z80XYCB, e1) OP(Z80XYCB, e2) OP(Z80XYCB, e3) OP(Z80XYCB, e4) OP(Z80XYCB, e5) OP(Z80XYCB, e6) OP(Z80XYCB, e7) \
+    OP(Z80XYCB, e8) OP(Z80XYCB, e9) OP(Z80XYCB, ea) OP(Z80XYCB, eb) OP(Z80XYCB, ec) OP(Z80XYCB, ed) OP(Z80XYCB, ee) OP(Z80XYCB, ef) \
+    OP(Z80XYCB, f0) OP(Z80XYCB, f1) OP(Z80XYCB, f2) OP(Z80XYCB, f3) OP(Z80XYCB, f4) OP(Z80XYCB, f5) OP(Z80XYCB, f6) OP(Z80XYCB, f7) \
+    OP(Z80XYCB, f8) OP(Z80XYCB, f9) OP(Z80XYCB, fa) OP(Z80XYCB, fb) OP(Z80XYCB, fc) OP(Z80XYCB, fd) OP(Z80XYCB, fe) OP(Z80XYCB, ff)
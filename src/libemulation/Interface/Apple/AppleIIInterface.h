@@ -55,6 +55,19 @@ typedef enum
     APPLEII_KEYSTROBE_DID_CHANGE,
 } AppleIIKeyboardNotification;
 
+// Notes:
+// * getVideoStatePointer returns a pointer to the video state (OEInt *),
+//   valid for the life of the video component. It holds the
+//   APPLEII_VIDEOSTATE_* bits, so soft-switch reads take a single load.
+
+#define APPLEII_VIDEOSTATE_TEXT         (1 << 0)
+#define APPLEII_VIDEOSTATE_MIXED        (1 << 1)
+#define APPLEII_VIDEOSTATE_PAGE2        (1 << 2)
+#define APPLEII_VIDEOSTATE_HIRES        (1 << 3)
+#define APPLEII_VIDEOSTATE_80COL        (1 << 4)
+#define APPLEII_VIDEOSTATE_ALTCHRSET    (1 << 5)
+#define APPLEII_VIDEOSTATE_VBL          (1 << 6)
+
 typedef enum
 {
     APPLEII_REFRESH_VIDEO = CANVAS_END,
@@ -65,6 +78,7 @@ typedef enum
     APPLEII_CLEAR_VIDEOINHIBIT,
     APPLEII_IS_VIDEO_INHIBITED,
     APPLEII_IS_MONITOR_CONNECTED,
+    APPLEII_GET_VIDEOSTATEPOINTER,
     APPLEII_VIDEO_END,
     APPLEII_80STORE_DID_CHANGE,
 } AppleIIVideoMessage;
@@ -12,6 +12,10 @@
 // * setPendingCycles sets the number of cycles to be executed (OESLong)
 // * getPendingCycles returns the number of remaining cycles (OESLong)
 // * run executes a number of CPU cycles
+// * getPendingCyclesPointer returns a pointer to the CPU's pending cycle
+//   counter (OESLong *). The control bus reads and writes it directly
+// * startTrace starts recording an instruction trace to a file (string)
+// * stopTrace stops recording the instruction trace
 
 #ifndef _CPUINTERFACE_H
 #define _CPUINTERFACE_H
@@ -21,6 +25,9 @@ typedef enum
 	CPU_SET_PENDINGCYCLES,
 	CPU_GET_PENDINGCYCLES,
 	CPU_RUN,
+	CPU_GET_PENDINGCYCLESPOINTER,
+	CPU_START_TRACE,
+	CPU_STOP_TRACE,
     CPU_END,
 } CPUMessage;
 
@@ -9,20 +9,49 @@
  */
 
 // Notes:
-// * scheduleTimer schedules a timer using the ControlBusTimer structure
+// * scheduleTimer schedules a timer using the ControlBusTimer structure,
+//   and returns the timer's handle in it
+// * cancelTimer receives the handle of a timer to be removed (OELong).
+//   It fails when the timer already fired or was removed
 // * invalidateTimers receives the id of the timers to be removed
 // * timerDidFire passes the timer using ControlBusTimer
 //   (cycles is the number of remaining cycles for this timer)
+// * getClock returns a pointer to the control bus clock (ControlBusClock *),
+//   valid for the life of the control bus. getControlBusCycles and
+//   getControlBusAudioBufferFrame read it without posting a message
+// * setFrameSkip sets how many video frames are skipped after each drawn
+//   frame (OEInt). Hosts raise it while fast-forwarding, so that video
+//   components do not draw frames that are never shown
+// * endSlice ends the running CPU slice by clearing its pending cycles, so
+//   the CPU stops after the current instruction. The rest of the slice
+//   is counted as done. While the control bus is not powered on, timers
+//   still fire until the end of the audio buffer, but the CPU is not run
 
 #ifndef _CONTROLBUSINTERFACE_H
 #define _CONTROLBUSINTERFACE_H
 
+#include <math.h>
+
+#include "OECommon.h"
+
 typedef struct
 {
     OESLong cycles;
     OEInt id;
+    OELong handle;
 } ControlBusTimer;
 
+typedef struct
+{
+    OELong cycles;
+    double cpuCycles;
+    double cpuClockMultiplier;
+    OESLong *pendingCPUCycles;
+    
+    OELong audioBufferStart;
+    float sampleToCycleRatio;
+} ControlBusClock;
+
 typedef enum
 {
     CONTROLBUS_SET_POWERSTATE,
@@ -49,6 +78,14 @@ typedef enum
     CONTROLBUS_CLEAR_NMI,
     CONTROLBUS_IS_NMI_ASSERTED,
     
+    CONTROLBUS_GET_CLOCK,
+    
+    CONTROLBUS_SET_FRAMESKIP,
+    CONTROLBUS_GET_FRAMESKIP,
+    
+    CONTROLBUS_CANCEL_TIMER,
+    CONTROLBUS_END_SLICE,
+    
     CONTROLBUS_END,
 } ControlBusMessage;
 
@@ -62,6 +99,7 @@ typedef enum
     CONTROLBUS_IRQ_DID_CHANGE,
     CONTROLBUS_NMI_DID_ASSERT,
     CONTROLBUS_NMI_DID_CLEAR,
+    CONTROLBUS_FRAMESKIP_DID_CHANGE,
 } ControlBusNotification;
 
 typedef enum
@@ -74,4 +112,15 @@ typedef enum
     CONTROLBUS_POWERSTATE_OFF,
 } ControlBusPowerState;
 
+inline OELong getControlBusCycles(ControlBusClock *clock)
+{
+    return clock->cycles + (OESLong) floor((clock->cpuCycles - *clock->pendingCPUCycles) /
+                                           clock->cpuClockMultiplier);
+}
+
+inline float getControlBusAudioBufferFrame(ControlBusClock *clock)
+{
+    return ((OEInt) (getControlBusCycles(clock) - clock->audioBufferStart)) * clock->sampleToCycleRatio;
+}
+
 #endif
@@ -79,3 +79,28 @@ bool validateMemoryMaps(MemoryMaps& theMaps,
     
     return true;
 }
+
+// Components may ignore the high address bits, so addresses are compared
+// modulo the smallest power of two above the range. This may report
+// overlaps that do not exist, never the opposite
+
+bool isAddressRangeOverlapping(OEAddressRange& range,
+                               OEAddress startAddress,
+                               OEAddress endAddress)
+{
+    OEAddress mask = 0;
+    
+    while (mask < range.endAddress)
+        mask = (mask << 1) | 1;
+    
+    if ((endAddress - startAddress) >= mask)
+        return true;
+    
+    OEAddress start = startAddress & mask;
+    OEAddress end = endAddress & mask;
+    
+    if (start <= end)
+        return ((start <= range.endAddress) && (range.startAddress <= end));
+    
+    return ((range.startAddress <= end) || (start <= range.endAddress));
+}
@@ -37,6 +37,9 @@ bool appendMemoryMaps(MemoryMaps& theMaps,
 bool validateMemoryMaps(MemoryMaps& theMaps,
                         OEAddress blockSize,
                         OEAddress addressMask);
+bool isAddressRangeOverlapping(OEAddressRange& range,
+                               OEAddress startAddress,
+                               OEAddress endAddress);
 
 typedef struct
 {
@@ -48,16 +51,75 @@ typedef struct
 
 typedef list<AddressOffsetMap> AddressOffsetMaps;
 
+typedef struct
+{
+    OEAddress startAddress;
+    OEAddress endAddress;
+    
+    bool read;
+    bool write;
+    bool halt;
+} MemoryWatchpoint;
+
+typedef list<MemoryWatchpoint> MemoryWatchpoints;
+
+typedef struct
+{
+    OELong cycles;
+    OEAddress address;
+    OEChar value;
+    bool write;
+} MemoryWatchpointHit;
+
+typedef vector<MemoryWatchpointHit> MemoryWatchpointHits;
+
+// Notes:
+// * Map and unmap messages posted between ADDRESSDECODER_BEGIN_UPDATE and
+//   ADDRESSDECODER_COMMIT_UPDATE are applied when the outermost commit is
+//   posted, so the decoder rebuilds its tables and notifies
+//   MEMORY_MAP_DID_CHANGE once. Updates may be nested.
+// * ADDRESSDECODER_ADD_WATCHPOINT routes the blocks covered by a
+//   MemoryWatchpoint through a watching proxy. Other blocks keep their
+//   direct pointers. ADDRESSDECODER_REMOVE_WATCHPOINT restores them.
+// * Each matching access is recorded with the control bus cycle count;
+//   ADDRESSDECODER_GET_WATCHPOINTHITS copies the hits, oldest first, to a
+//   MemoryWatchpointHits. A watchpoint with halt set pauses the control bus
+//   and ends the CPU slice, so the CPU stops after the instruction that
+//   made the access.
+
 typedef enum
 {
     ADDRESSDECODER_MAP,
     ADDRESSDECODER_UNMAP,
+    ADDRESSDECODER_BEGIN_UPDATE,
+    ADDRESSDECODER_COMMIT_UPDATE,
+    ADDRESSDECODER_ADD_WATCHPOINT,
+    ADDRESSDECODER_REMOVE_WATCHPOINT,
+    ADDRESSDECODER_GET_WATCHPOINTHITS,
+    ADDRESSDECODER_CLEAR_WATCHPOINTHITS,
     ADDRESSDECODER_END,
 } AddressDecoderMessage;
 
+// Notes:
+// * ADDRESSMAPPER_SELECT selects maps by a comma-separated list of names.
+//   Where maps overlap, later names take precedence.
+// * ADDRESSMAPPER_GET_MASK translates such a list into a selection mask
+//   once, so that ADDRESSMAPPER_SELECT_MASK can switch maps without
+//   building or parsing strings. A mask does not keep the order of the
+//   list: overlapping names selected by mask take precedence in the order
+//   their map* properties sort by name.
+
+typedef struct
+{
+    string sel;
+    OELong mask;
+} AddressMapperMask;
+
 typedef enum
 {
     ADDRESSMAPPER_SELECT,
+    ADDRESSMAPPER_SELECT_MASK,
+    ADDRESSMAPPER_GET_MASK,
 } AddressMapperMessage;
 
 typedef enum
@@ -71,14 +133,46 @@ typedef enum
     ADDRESSOFFSET_MAP,
 } AddressOffsetMessage;
 
+// Notes:
+// * RAM_SET_DIRTYTRACKING turns dirty page tracking on or off. Turning it
+//   on clears all pages.
+// * RAM_GET_DIRTYPAGES copies the dirty map to an OEData, one byte per
+//   page of RAM_GET_DIRTYPAGESIZE bytes. Non-zero bytes are dirty pages.
+//   It and RAM_CLEAR_DIRTYPAGES fail when tracking is off.
+// * Components writing through the data returned by RAM_GET_DATA bypass
+//   dirty page tracking.
+// * The dirty page messages are numbered apart from other messages, so
+//   that they can be posted to components that may not be RAM.
+
 typedef enum
 {
     RAM_GET_DATA,
+    RAM_SET_DIRTYTRACKING = 0x10000,
+    RAM_GET_DIRTYPAGESIZE,
+    RAM_GET_DIRTYPAGES,
+    RAM_CLEAR_DIRTYPAGES,
 } RAMMessage;
 
+// Notes:
+// * MEMORY_MAP_DID_CHANGE is posted by memory components when the
+//   pointers returned by getReadPointer/getWritePointer may have changed.
+//   data is NULL when any pointer may have changed, or points to an
+//   OEAddressRange in the component's address space.
+//   Memory notifications are numbered apart from other notifications, as
+//   decoders observe components that post their own notifications.
+// * VRAM_WILL_CHANGE is sent to the video observer before video memory is
+//   written. data points to the byte about to change, or is NULL when
+//   several bytes may change.
+
+typedef enum
+{
+    MEMORY_MAP_DID_CHANGE = 0x10000,
+    MEMORY_NOTIFICATION_END,
+} MemoryNotification;
+
 typedef enum
 {
-    RAM_SIZE_DID_CHANGE,
+    RAM_SIZE_DID_CHANGE = MEMORY_NOTIFICATION_END,
 } RAMNotification;
 
 typedef enum
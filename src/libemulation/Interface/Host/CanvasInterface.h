@@ -20,6 +20,7 @@
 
 // Drawing:
 // * postImage post an image to the canvas (OEImage)
+//   A display canvas only uploads the rows of the image's dirty rect
 // * clear clears the canvas
 // * setPrintPosition sets the print position in a paper canvas (OEPoint)
 
@@ -37,6 +38,8 @@
 // Multithreading, beware!
 // * didVSync and willDraw are sent from the drawing thread! Keep this in mind
 //   for managing threads correctly.
+// * postImage and clear are not synchronized with each other: they must be
+//   sent from a single thread (usually the emulation thread).
 
 #ifndef _CANVASINTERFACE_H
 #define _CANVASINTERFACE_H
@@ -18,6 +18,17 @@
 
 using namespace std;
 
+// Notes:
+// * EMULATION_GET_COMPONENT looks up the component of an EDL id, and
+//   EMULATION_GET_COMPONENTID the id of a component, in an
+//   EmulationComponent. Both fail when there is no such component.
+
+typedef struct
+{
+    string id;
+    OEComponent *component;
+} EmulationComponent;
+
 typedef enum
 {
     EMULATION_CONSTRUCT_DISPLAYCANVAS,
@@ -29,6 +40,9 @@ typedef enum
     
     EMULATION_ASSERT_ACTIVITY,
     EMULATION_CLEAR_ACTIVITY,
+    
+    EMULATION_GET_COMPONENT,
+    EMULATION_GET_COMPONENTID,
 } EmulationMessage;
 
 typedef enum
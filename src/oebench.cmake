@@ -0,0 +1,8 @@
+# oebench - headless emulation benchmark
+
+set(_oebench_dir ${source_directory}/oebench)
+
+# Sources
+set(oebench
+  ${_oebench_dir}/oebench.cpp
+)
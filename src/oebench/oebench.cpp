@@ -0,0 +1,448 @@
+
+/**
+ * oebench
+ * Headless emulation benchmark
+ * (C) 2012 by Marc S. Ressl (mressl@umich.edu)
+ * Released under the GPL
+ *
+ * Runs emulations at maximum speed without audio or video hardware,
+ * and reports emulated cycles per second, frames per second,
+ * host nanoseconds per emulated cycle and state snapshot times.
+ * Optionally decodes display frames in software
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <iostream>
+
+#include "OEEmulation.h"
+#include "OERewind.h"
+
+#include "HeadlessAudio.h"
+#include "HeadlessCanvas.h"
+#include "SoftwareCanvas.h"
+#include "HIDJoystick.h"
+
+#include "ControlBusInterface.h"
+
+#define DEFAULT_SECONDS     10.0
+#define STATE_ITERATIONS    100
+
+typedef struct
+{
+    string id;
+    OEComponent *controlBus;
+    float clockFrequency;
+    OELong startCycles;
+} BenchControlBus;
+
+static vector<HeadlessCanvas *> benchCanvases;
+static HeadlessCanvas *recordedCanvas = NULL;
+
+static bool isSoftwareDecoding = false;
+static OEInt decoderThreadNum = 1;
+static double decodeTime = 0;
+static OEImage decodedImage;
+
+static OEComponent *constructCanvas(void *userData,
+                                    OEComponent *device,
+                                    OECanvasType canvasType)
+{
+    HeadlessCanvas *canvas;
+    
+    if (isSoftwareDecoding)
+    {
+        SoftwareCanvas *softwareCanvas = new SoftwareCanvas(canvasType);
+        
+        softwareCanvas->setThreadNum(decoderThreadNum);
+        
+        canvas = softwareCanvas;
+    }
+    else
+        canvas = new HeadlessCanvas(canvasType);
+    
+    benchCanvases.push_back(canvas);
+    
+    // The machine's monitor constructs the first display canvas; canvases
+    // of added devices, such as the graphics tablet, come later
+    if (!recordedCanvas && (canvasType == OECANVAS_DISPLAY))
+        recordedCanvas = canvas;
+    
+    return canvas;
+}
+
+static void destroyCanvas(void *userData, OEComponent *canvas)
+{
+    for (OEInt i = 0; i < benchCanvases.size(); i++)
+    {
+        if (benchCanvases[i] == canvas)
+        {
+            // Keep the monitor's last frame and the decode time
+            if (isSoftwareDecoding && (benchCanvases[i]->getCanvasType() == OECANVAS_DISPLAY))
+            {
+                SoftwareCanvas *softwareCanvas = (SoftwareCanvas *)benchCanvases[i];
+                
+                decodeTime += softwareCanvas->getDecodeTime();
+                
+                if ((softwareCanvas == recordedCanvas) &&
+                    softwareCanvas->getImage().getSize().width)
+                    decodedImage = softwareCanvas->getImage();
+            }
+            
+            if (benchCanvases[i] == recordedCanvas)
+                recordedCanvas = NULL;
+            
+            benchCanvases.erase(benchCanvases.begin() + i);
+            
+            break;
+        }
+    }
+    
+    delete (HeadlessCanvas *)canvas;
+}
+
+static double getHostTime()
+{
+    struct timespec ts;
+    
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return ts.tv_sec + ts.tv_nsec * 1E-9;
+}
+
+static OELong getFrameCount()
+{
+    OELong frameCount = 0;
+    
+    for (OEInt i = 0; i < benchCanvases.size(); i++)
+        if (benchCanvases[i]->getCanvasType() != OECANVAS_PAPER)
+            frameCount += benchCanvases[i]->getFrameCount();
+    
+    return frameCount;
+}
+
+static double getDecodeTime()
+{
+    double time = decodeTime;
+    
+    if (isSoftwareDecoding)
+        for (OEInt i = 0; i < benchCanvases.size(); i++)
+            if (benchCanvases[i]->getCanvasType() == OECANVAS_DISPLAY)
+                time += ((SoftwareCanvas *)benchCanvases[i])->getDecodeTime();
+    
+    return time;
+}
+
+static bool writeImage(string path, OEImage& image)
+{
+    OESize size = image.getSize();
+    
+    FILE *fp = fopen(path.c_str(), "wb");
+    
+    if (!fp)
+        return false;
+    
+    fprintf(fp, "P6\n%d %d\n255\n", (int) size.width, (int) size.height);
+    
+    size_t byteNum = (size_t) (size.width * size.height * 3);
+    bool isWritten = (fwrite(image.getPixels(), 1, byteNum, fp) == byteNum);
+    
+    fclose(fp);
+    
+    return isWritten;
+}
+
+static string getParentPath(string path)
+{
+    size_t pos = path.rfind('/');
+    
+    if (pos == string::npos)
+        return ".";
+    
+    if (pos == 0)
+        return "/";
+    
+    return path.substr(0, pos);
+}
+
+static void printUsage()
+{
+    cerr << "usage: oebench [-r resourcePath] [-s seconds] [-b framesPerBuffer] "
+    "[-a sampleRate] [-k frameSkip] [-w] [-c] [-t threadNum] [-o path.ppm] "
+    "path.xml..." << endl;
+    cerr << "  -r  resource path (default: the directory above templates)" << endl;
+    cerr << "  -s  emulated seconds to run (default: " << DEFAULT_SECONDS << ")" << endl;
+    cerr << "  -b  audio frames per buffer (default: 512)" << endl;
+    cerr << "  -a  audio sample rate (default: 48000)" << endl;
+    cerr << "  -k  video frames skipped after each drawn frame (default: 0)" << endl;
+    cerr << "  -w  capture a rewind snapshot after each audio buffer" << endl;
+    cerr << "  -c  decode display frames in software" << endl;
+    cerr << "  -t  software decoder threads (default: 1)" << endl;
+    cerr << "  -o  write the monitor's last decoded frame as a PPM image (implies -c)" << endl;
+}
+
+static bool runBenchmark(string path,
+                         string resourcePath,
+                         float seconds,
+                         float sampleRate,
+                         OEInt framesPerBuffer,
+                         OEInt frameSkip,
+                         bool rewind,
+                         string imagePath)
+{
+    if (resourcePath == "")
+        resourcePath = getParentPath(getParentPath(getParentPath(path)));
+    
+    decodedImage = OEImage();
+    recordedCanvas = NULL;
+    
+    HeadlessAudio audio;
+    HIDJoystick joystick;
+    
+    audio.setSampleRate(sampleRate);
+    audio.setFramesPerBuffer(framesPerBuffer);
+    
+    OEEmulation *emulation = new OEEmulation();
+    
+    emulation->setResourcePath(resourcePath);
+    emulation->setConstructCanvas(constructCanvas);
+    emulation->setDestroyCanvas(destroyCanvas);
+    emulation->addComponent("audio", &audio);
+    emulation->addComponent("joystick", &joystick);
+    
+    emulation->open(path);
+    
+    if (!emulation->isOpen())
+    {
+        cerr << "oebench: could not open " << path << endl;
+        
+        delete emulation;
+        
+        return false;
+    }
+    
+    // Find control buses
+    vector<BenchControlBus> controlBuses;
+    
+    OEIds deviceIds = emulation->getDeviceIds();
+    for (OEInt i = 0; i < deviceIds.size(); i++)
+    {
+        string id = deviceIds[i] + ".controlBus";
+        OEComponent *controlBus = emulation->getComponent(id);
+        
+        if (!controlBus)
+            continue;
+        
+        BenchControlBus benchControlBus;
+        
+        benchControlBus.id = id;
+        benchControlBus.controlBus = controlBus;
+        benchControlBus.clockFrequency = 0;
+        benchControlBus.startCycles = 0;
+        
+        controlBus->postMessage(NULL, CONTROLBUS_GET_CLOCKFREQUENCY,
+                                &benchControlBus.clockFrequency);
+        controlBus->postMessage(NULL, CONTROLBUS_GET_CYCLES,
+                                &benchControlBus.startCycles);
+        controlBus->postMessage(NULL, CONTROLBUS_SET_FRAMESKIP, &frameSkip);
+        
+        controlBuses.push_back(benchControlBus);
+    }
+    
+    // Run
+    OELong bufferNum = (OELong) (seconds * sampleRate / framesPerBuffer + 0.5);
+    OELong startFrameCount = getFrameCount();
+    double startDecodeTime = getDecodeTime();
+    
+    OERewind emulationRewind;
+    
+    emulationRewind.setEmulation(emulation);
+    
+    double startTime = getHostTime();
+    
+    if (rewind)
+    {
+        for (OELong i = 0; i < bufferNum; i++)
+        {
+            audio.runEmulations(1);
+            
+            emulationRewind.capture();
+        }
+    }
+    else
+        audio.runEmulations(bufferNum);
+    
+    double elapsedTime = getHostTime() - startTime;
+    
+    if (elapsedTime <= 0)
+        elapsedTime = 1E-9;
+    
+    // Report
+    double emulatedTime = (double) bufferNum * framesPerBuffer / sampleRate;
+    OELong frameNum = getFrameCount() - startFrameCount;
+    double frameDecodeTime = getDecodeTime() - startDecodeTime;
+    
+    printf("%s\n", path.c_str());
+    printf("  emulated time:  %.3f s in %.3f s host time (%.2fx)\n",
+           emulatedTime, elapsedTime, emulatedTime / elapsedTime);
+    printf("  audio buffers:  %lld (%.0f buffers/s)\n",
+           (long long) bufferNum, bufferNum / elapsedTime);
+    printf("  frames:         %lld (%.1f frames/s)\n",
+           (long long) frameNum, frameNum / elapsedTime);
+    
+    if (isSoftwareDecoding && frameNum)
+        printf("  decoding:       %.3f ms/frame (%d threads)\n",
+               frameDecodeTime * 1E3 / frameNum, decoderThreadNum);
+    
+    for (OEInt i = 0; i < controlBuses.size(); i++)
+    {
+        BenchControlBus& benchControlBus = controlBuses[i];
+        
+        OELong cycles = 0;
+        
+        benchControlBus.controlBus->postMessage(NULL, CONTROLBUS_GET_CYCLES, &cycles);
+        
+        OELong cycleNum = cycles - benchControlBus.startCycles;
+        
+        printf("  %s: %lld cycles at %.6f MHz nominal\n",
+               benchControlBus.id.c_str(),
+               (long long) cycleNum,
+               benchControlBus.clockFrequency * 1E-6);
+        printf("    emulated speed: %.3f MHz\n",
+               cycleNum / elapsedTime * 1E-6);
+        
+        if (cycleNum)
+            printf("    host time:      %.2f ns/cycle\n",
+                   elapsedTime * 1E9 / cycleNum);
+    }
+    
+    // Time state snapshots
+    OEData state;
+    
+    startTime = getHostTime();
+    
+    for (OEInt i = 0; i < STATE_ITERATIONS; i++)
+        emulation->saveState(&state);
+    
+    double saveTime = (getHostTime() - startTime) / STATE_ITERATIONS;
+    
+    startTime = getHostTime();
+    
+    bool isLoaded = true;
+    
+    for (OEInt i = 0; i < STATE_ITERATIONS; i++)
+        isLoaded &= emulation->loadState(&state);
+    
+    double loadTime = (getHostTime() - startTime) / STATE_ITERATIONS;
+    
+    printf("  state:          %lld bytes, save %.1f us, load %.1f us%s\n",
+           (long long) state.size(),
+           saveTime * 1E6,
+           loadTime * 1E6,
+           isLoaded ? "" : " (load failed)");
+    
+    if (rewind && emulationRewind.getCaptureNum())
+    {
+        startTime = getHostTime();
+        
+        bool isRestored = emulationRewind.restore(emulationRewind.getSnapshotNum() / 2);
+        
+        double restoreTime = getHostTime() - startTime;
+        
+        printf("  rewind:         %d snapshots in %.2f MB, capture %.1f us, restore %.1f us%s\n",
+               emulationRewind.getSnapshotNum(),
+               emulationRewind.getMemorySize() / 1048576.0,
+               emulationRewind.getCaptureTime() * 1E6 / emulationRewind.getCaptureNum(),
+               restoreTime * 1E6,
+               isRestored ? "" : " (restore failed)");
+    }
+    
+    delete emulation;
+    
+    // Write last decoded frame
+    if (imagePath != "")
+    {
+        if (!decodedImage.getSize().width)
+            cerr << "oebench: no monitor frame was decoded" << endl;
+        else if (!writeImage(imagePath, decodedImage))
+        {
+            cerr << "oebench: could not write " << imagePath << endl;
+            
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    string resourcePath;
+    float seconds = DEFAULT_SECONDS;
+    float sampleRate = 48000;
+    OEInt framesPerBuffer = 512;
+    OEInt frameSkip = 0;
+    bool rewind = false;
+    string imagePath;
+    vector<string> paths;
+    
+    for (int i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+        
+        if ((arg == "-r") && (i + 1 < argc))
+            resourcePath = argv[++i];
+        else if ((arg == "-s") && (i + 1 < argc))
+            seconds = atof(argv[++i]);
+        else if ((arg == "-b") && (i + 1 < argc))
+            framesPerBuffer = atoi(argv[++i]);
+        else if ((arg == "-a") && (i + 1 < argc))
+            sampleRate = atof(argv[++i]);
+        else if ((arg == "-k") && (i + 1 < argc))
+            frameSkip = atoi(argv[++i]);
+        else if (arg == "-w")
+            rewind = true;
+        else if (arg == "-c")
+            isSoftwareDecoding = true;
+        else if ((arg == "-t") && (i + 1 < argc))
+            decoderThreadNum = atoi(argv[++i]);
+        else if ((arg == "-o") && (i + 1 < argc))
+        {
+            imagePath = argv[++i];
+            isSoftwareDecoding = true;
+        }
+        else if ((arg == "-h") || (arg == "--help"))
+        {
+            printUsage();
+            
+            return 0;
+        }
+        else if (arg[0] == '-')
+        {
+            printUsage();
+            
+            return 1;
+        }
+        else
+            paths.push_back(arg);
+    }
+    
+    if (!paths.size() || (seconds <= 0) || (sampleRate <= 0) || !framesPerBuffer ||
+        !decoderThreadNum)
+    {
+        printUsage();
+        
+        return 1;
+    }
+    
+    bool success = true;
+    
+    for (OEInt i = 0; i < paths.size(); i++)
+        success &= runBenchmark(paths[i], resourcePath, seconds, sampleRate,
+                                framesPerBuffer, frameSkip, rewind, imagePath);
+    
+    return success ? 0 : 1;
+}
@@ -0,0 +1,19 @@
+# oetest - emulation regression tests
+
+set(_oetest_dir ${source_directory}/oetest)
+
+# Sources
+set(oetest
+  ${_oetest_dir}/oetest.cpp
+  ${_oetest_dir}/AppleIIIMOS6502Test.cpp
+  ${_oetest_dir}/ControlBusTest.cpp
+  ${_oetest_dir}/CPUTest.cpp
+  ${_oetest_dir}/MemoryTest.cpp
+  ${_oetest_dir}/RewindTest.cpp
+  ${_oetest_dir}/StateTest.cpp
+  ${_oetest_dir}/TripleBufferTest.cpp
+  ${_oetest_dir}/VideoDecoderTest.cpp
+  ${_oetest_dir}/VideoTest.cpp
+  ${_oetest_dir}/W65C816STest.cpp
+  ${_oetest_dir}/Z80Test.cpp
+)
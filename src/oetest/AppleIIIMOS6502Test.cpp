@@ -0,0 +1,507 @@
+
+/**
+ * oetest
+ * Apple III MOS6502 test
+ * (C) 2012 by Marc S. Ressl (mressl@umich.edu)
+ * Released under the GPL
+ *
+ * Checks the extended addressing of the Apple III MOS6502 over plain RAM
+ */
+
+#include <iostream>
+
+#include "oetest.h"
+
+#include "util.h"
+
+#include "HeadlessAudio.h"
+
+#include "ControlBus.h"
+#include "RAM.h"
+#include "MOS6502.h"
+#include "AppleIIIMOS6502.h"
+#include "CPUInterface.h"
+#include "AppleIIIInterface.h"
+
+// Notes:
+// * The core runs on two plain 64 kB RAMs: one as the memory bus, and one
+//   as the extended memory bus, which stands for the bank selected through
+//   the system control. A stub system control reports the zero page and
+//   records the banks the core selects.
+// * With a zero page from 18h to 1Fh, (zp),Y instructions read the X-byte
+//   at the same offset as the pointer's high byte, on page zero page ^ 0Ch.
+//   When its bit 7 is set, the core selects bank X-byte & 0Fh and the
+//   access goes to the extended memory bus. Cycles must match the MOS6502.
+// * With extended addressing off, random code must run cycle for cycle as
+//   on the MOS6502: registers and pending cycles are compared after each
+//   slice, and the RAM at the end.
+
+#define APPLEIIIMOS6502_TEST_CLOCKFREQUENCY "1000000"
+#define APPLEIIIMOS6502_TEST_RAMSIZE        "0x10000"
+#define APPLEIIIMOS6502_TEST_PROGRAM        0x1000
+#define APPLEIIIMOS6502_TEST_RST_VECTOR     0xfffc
+#define APPLEIIIMOS6502_TEST_SLICE          1000
+#define APPLEIIIMOS6502_TEST_SLICENUM       2000
+
+#define APPLEIIIMOS6502_TEST_F_C            0x01
+#define APPLEIIIMOS6502_TEST_F_Z            0x02
+
+class AppleIIIMOS6502TestDevice : public OEComponent
+{
+public:
+    bool postMessage(OEComponent *sender, int message, void *data)
+    {
+        return true;
+    }
+};
+
+// Reports the zero page and records extended RAM bank selections
+
+class AppleIIIMOS6502TestSystemControl : public OEComponent
+{
+public:
+    AppleIIIMOS6502TestSystemControl()
+    {
+        zeroPage = 0;
+        extendedRAMBank = -1;
+        extendedRAMBankCount = 0;
+    }
+    
+    OEChar zeroPage;
+    OESInt extendedRAMBank;
+    OEInt extendedRAMBankCount;
+    
+    bool postMessage(OEComponent *sender, int message, void *data)
+    {
+        switch (message)
+        {
+            case APPLEIII_GET_ZEROPAGE:
+                *((OEChar *)data) = zeroPage;
+                
+                return true;
+                
+            case APPLEIII_SET_EXTENDEDRAMBANK:
+                extendedRAMBank = *((OEChar *)data);
+                extendedRAMBankCount++;
+                
+                return true;
+        }
+        
+        return false;
+    }
+    
+    void setZeroPage(OEChar value)
+    {
+        zeroPage = value;
+        
+        postNotification(this, APPLEIII_ZEROPAGE_DID_CHANGE, &zeroPage);
+    }
+};
+
+// Runs a program on a MOS6502 or an Apple III MOS6502 over plain RAM
+
+class AppleIIIMOS6502TestRig
+{
+public:
+    AppleIIIMOS6502TestRig(string name, MOS6502 *cpu)
+    {
+        this->name = name;
+        this->cpu = cpu;
+        
+        isOpen = false;
+        success = true;
+    }
+    
+    ~AppleIIIMOS6502TestRig()
+    {
+        if (isOpen)
+            controlBus.dispose();
+    }
+    
+    AppleIIIMOS6502TestSystemControl systemControl;
+    RAM ram;
+    RAM extendedRAM;
+    
+    bool open(OEChar zeroPage)
+    {
+        ram.setValue("size", APPLEIIIMOS6502_TEST_RAMSIZE);
+        extendedRAM.setValue("size", APPLEIIIMOS6502_TEST_RAMSIZE);
+        
+        if (!ram.init() || !extendedRAM.init())
+            return false;
+        
+        systemControl.zeroPage = zeroPage;
+        
+        controlBus.setValue("clockFrequency", APPLEIIIMOS6502_TEST_CLOCKFREQUENCY);
+        controlBus.setValue("powerState", "S0");
+        controlBus.setValue("resetOnPowerOn", "0");
+        controlBus.setRef("device", &device);
+        controlBus.setRef("audio", &audio);
+        controlBus.setRef("cpu", cpu);
+        
+        cpu->setRef("controlBus", &controlBus);
+        cpu->setRef("memoryBus", &ram);
+        cpu->setRef("extendedMemoryBus", &extendedRAM);
+        cpu->setRef("systemControl", &systemControl);
+        
+        if (!cpu->init() || !controlBus.init())
+            return false;
+        
+        isOpen = true;
+        
+        return true;
+    }
+    
+    void load(OEAddress address, const OEChar *data, OEInt size)
+    {
+        for (OEInt i = 0; i < size; i++)
+            ram.write(address + i, data[i]);
+    }
+    
+    void write16(OEAddress address, OEInt value)
+    {
+        ram.write(address, value);
+        ram.write(address + 1, value >> 8);
+    }
+    
+    void reset()
+    {
+        write16(APPLEIIIMOS6502_TEST_RST_VECTOR, APPLEIIIMOS6502_TEST_PROGRAM);
+        
+        controlBus.postMessage(NULL, CONTROLBUS_ASSERT_RESET, NULL);
+        controlBus.postMessage(NULL, CONTROLBUS_CLEAR_RESET, NULL);
+        
+        checkStep("reset", 7);
+    }
+    
+    OEInt get(string name)
+    {
+        string value;
+        
+        cpu->getValue(name, value);
+        
+        return getOEInt(value);
+    }
+    
+    // Runs cycles and returns the pending cycles
+    OESLong run(OESLong cycles)
+    {
+        OESLong pendingCycles = cycles;
+        
+        cpu->postMessage(NULL, CPU_SET_PENDINGCYCLES, &pendingCycles);
+        cpu->postMessage(NULL, CPU_RUN, NULL);
+        cpu->postMessage(NULL, CPU_GET_PENDINGCYCLES, &pendingCycles);
+        
+        return pendingCycles;
+    }
+    
+    bool checkStep(string what, OEInt cycles)
+    {
+        OEInt stepCycles = (OEInt) (1 - run(1));
+        
+        return check(stepCycles == cycles,
+                     what + " took " + getString(stepCycles) +
+                     " cycles, not " + getString(cycles));
+    }
+    
+    bool checkRegister(string registerName, OEInt value)
+    {
+        OEInt registerValue = get(registerName);
+        
+        return check(registerValue == value,
+                     registerName + " is " + getHexString(registerValue) +
+                     ", not " + getHexString(value));
+    }
+    
+    bool checkMemory(RAM& memory, OEAddress address, OEChar value)
+    {
+        OEChar memoryValue = memory.read(address);
+        string memoryName = (&memory == &ram) ? "memory" : "extended memory";
+        
+        return check(memoryValue == value,
+                     memoryName + " at " + getHexString(address) + " is " +
+                     getHexString(memoryValue) + ", not " + getHexString(value));
+    }
+    
+    bool checkBank(OESInt bank, OEInt count)
+    {
+        return (check(systemControl.extendedRAMBank == bank,
+                      "extended RAM bank is " + getString(systemControl.extendedRAMBank) +
+                      ", not " + getString(bank)) &&
+                check(systemControl.extendedRAMBankCount == count,
+                      "extended RAM bank was selected " +
+                      getString(systemControl.extendedRAMBankCount) +
+                      " times, not " + getString(count)));
+    }
+    
+    bool check(bool condition, string message)
+    {
+        if (!condition)
+        {
+            cerr << "oetest: appleiiimos6502: " << name << ": " << message << endl;
+            
+            success = false;
+        }
+        
+        return condition;
+    }
+    
+    bool isSuccess()
+    {
+        return success;
+    }
+    
+private:
+    string name;
+    MOS6502 *cpu;
+    bool isOpen;
+    bool success;
+    
+    ControlBus controlBus;
+    AppleIIIMOS6502TestDevice device;
+    HeadlessAudio audio;
+};
+
+// Pointers at 40h (X-byte 83h) and 42h (X-byte 05h), zero page 1Ah
+
+static const OEChar appleIIIMOS6502TestZeroPage[] =
+{
+    0x10, 0x20,             // 0040: DW 2010h
+    0xf0, 0x20,             // 0042: DW 20F0h
+};
+
+static const OEChar appleIIIMOS6502TestXBytes[] =
+{
+    0x83,                   // 1641: bank 3
+    0x00,                   // 1642
+    0x05,                   // 1643: bit 7 clear
+};
+
+static const OEChar appleIIIMOS6502TestProgram[] =
+{
+    0xa0, 0x04,             // 1000: LDY #$04
+    0xb1, 0x40,             // 1002: LDA ($40),Y
+    0xb1, 0x42,             // 1004: LDA ($42),Y
+    0xa0, 0x10,             // 1006: LDY #$10
+    0xa9, 0x5a,             // 1008: LDA #$5A
+    0x91, 0x42,             // 100a: STA ($42),Y
+    0x91, 0x40,             // 100c: STA ($40),Y
+    0xa0, 0xff,             // 100e: LDY #$FF
+    0xb1, 0x40,             // 1010: LDA ($40),Y
+    0x51, 0x40,             // 1012: EOR ($40),Y
+    0x18,                   // 1014: CLC
+    0x71, 0x40,             // 1015: ADC ($40),Y
+    0x11, 0x42,             // 1017: ORA ($42),Y
+    0x31, 0x40,             // 1019: AND ($40),Y
+    0xd1, 0x40,             // 101b: CMP ($40),Y
+    0x38,                   // 101d: SEC
+    0xf1, 0x40,             // 101e: SBC ($40),Y
+};
+
+static bool openAppleIIIMOS6502Test(AppleIIIMOS6502TestRig& rig, OEChar zeroPage)
+{
+    if (!rig.open(zeroPage))
+        return rig.check(false, "could not open");
+    
+    rig.load(0x0040, appleIIIMOS6502TestZeroPage, sizeof(appleIIIMOS6502TestZeroPage));
+    rig.load(0x1641, appleIIIMOS6502TestXBytes, sizeof(appleIIIMOS6502TestXBytes));
+    rig.load(APPLEIIIMOS6502_TEST_PROGRAM,
+             appleIIIMOS6502TestProgram, sizeof(appleIIIMOS6502TestProgram));
+    
+    rig.ram.write(0x2014, 0x11);
+    rig.extendedRAM.write(0x2014, 0x22);
+    rig.ram.write(0x20f4, 0x33);
+    rig.extendedRAM.write(0x20f4, 0x44);
+    rig.ram.write(0x210f, 0x55);
+    rig.extendedRAM.write(0x210f, 0x0f);
+    rig.ram.write(0x21ef, 0xf0);
+    
+    rig.reset();
+    
+    return true;
+}
+
+static bool checkAppleIIIMOS6502Extended()
+{
+    AppleIIIMOS6502 cpu;
+    AppleIIIMOS6502TestRig rig("extended addressing", &cpu);
+    
+    if (!openAppleIIIMOS6502Test(rig, 0x1a))
+        return false;
+    
+    // LDY #$04; LDA ($40),Y reads bank 3
+    rig.checkStep("LDY #", 2);
+    rig.checkStep("LDA (zp),Y", 5);
+    rig.checkRegister("a", 0x22);
+    rig.checkBank(3, 1);
+    
+    // LDA ($42),Y reads the memory bus, as its X-byte has bit 7 clear
+    rig.checkStep("LDA (zp),Y", 5);
+    rig.checkRegister("a", 0x33);
+    rig.checkBank(3, 1);
+    
+    // STA ($42),Y crosses a page on the memory bus, STA ($40),Y writes bank 3
+    rig.checkStep("LDY #", 2);
+    rig.checkStep("LDA #", 2);
+    rig.checkStep("STA (zp),Y", 6);
+    rig.checkMemory(rig.ram, 0x2100, 0x5a);
+    rig.checkMemory(rig.extendedRAM, 0x2100, 0x00);
+    rig.checkStep("STA (zp),Y", 6);
+    rig.checkMemory(rig.extendedRAM, 0x2020, 0x5a);
+    rig.checkMemory(rig.ram, 0x2020, 0x00);
+    rig.checkBank(3, 2);
+    
+    // The page penalty also applies on the extended memory bus
+    rig.checkStep("LDY #", 2);
+    rig.checkStep("LDA (zp),Y", 6);
+    rig.checkRegister("a", 0x0f);
+    
+    rig.checkStep("EOR (zp),Y", 6);
+    rig.checkRegister("a", 0x00);
+    rig.checkStep("CLC", 2);
+    rig.checkStep("ADC (zp),Y", 6);
+    rig.checkRegister("a", 0x0f);
+    rig.checkStep("ORA (zp),Y", 6);
+    rig.checkRegister("a", 0xff);
+    rig.checkStep("AND (zp),Y", 6);
+    rig.checkRegister("a", 0x0f);
+    rig.checkStep("CMP (zp),Y", 6);
+    rig.check((rig.get("p") & (APPLEIIIMOS6502_TEST_F_Z | APPLEIIIMOS6502_TEST_F_C)) ==
+              (APPLEIIIMOS6502_TEST_F_Z | APPLEIIIMOS6502_TEST_F_C),
+              "CMP (zp),Y did not set Z and C");
+    rig.checkStep("SEC", 2);
+    rig.checkStep("SBC (zp),Y", 6);
+    rig.checkRegister("a", 0x00);
+    rig.checkBank(3, 8);
+    
+    return rig.isSuccess();
+}
+
+static bool checkAppleIIIMOS6502ZeroPage()
+{
+    AppleIIIMOS6502 cpu;
+    AppleIIIMOS6502TestRig rig("zero page", &cpu);
+    
+    if (!openAppleIIIMOS6502Test(rig, 0x00))
+        return false;
+    
+    // Extended addressing is off outside zero pages 18h to 1Fh
+    rig.checkStep("LDY #", 2);
+    rig.checkStep("LDA (zp),Y", 5);
+    rig.checkRegister("a", 0x11);
+    rig.checkBank(-1, 0);
+    
+    // The core follows zero page changes
+    rig.systemControl.setZeroPage(0x1a);
+    
+    rig.checkStep("LDA (zp),Y", 5);
+    rig.checkRegister("a", 0x33);
+    rig.checkBank(-1, 0);
+    
+    rig.systemControl.setZeroPage(0x19);
+    rig.ram.write(0x1541, 0x87);
+    
+    rig.checkStep("LDY #", 2);
+    rig.checkStep("LDA #", 2);
+    rig.checkStep("STA (zp),Y", 6);
+    rig.checkStep("STA (zp),Y", 6);
+    rig.checkMemory(rig.extendedRAM, 0x2020, 0x5a);
+    rig.checkBank(7, 1);
+    
+    return rig.isSuccess();
+}
+
+// Random code with extended addressing off, on both cores
+
+static void fillAppleIIIMOS6502TestRAM(AppleIIIMOS6502TestRig& rig)
+{
+    OEInt seed = 1;
+    
+    for (OEAddress address = 0; address < 0x10000; address++)
+        rig.ram.write(address, getTestRandom(seed));
+}
+
+static bool checkAppleIIIMOS6502Parity()
+{
+    MOS6502 referenceCPU;
+    AppleIIIMOS6502 cpu;
+    AppleIIIMOS6502TestRig referenceRig("parity", &referenceCPU);
+    AppleIIIMOS6502TestRig rig("parity", &cpu);
+    
+    if (!referenceRig.open(0x00) || !rig.open(0x00))
+        return rig.check(false, "could not open");
+    
+    fillAppleIIIMOS6502TestRAM(referenceRig);
+    fillAppleIIIMOS6502TestRAM(rig);
+    
+    referenceRig.reset();
+    rig.reset();
+    
+    const char *registers[] = {"a", "x", "y", "s", "p", "pc"};
+    OEInt seed = 2;
+    
+    for (OEInt i = 0; i < APPLEIIIMOS6502_TEST_SLICENUM; i++)
+    {
+        // Restart at random from time to time, so that no loop holds on
+        if (!(i % 16))
+        {
+            string a = getHexString(getTestRandom(seed) & 0xff);
+            string x = getHexString(getTestRandom(seed) & 0xff);
+            string y = getHexString(getTestRandom(seed) & 0xff);
+            string p = getHexString(getTestRandom(seed) & 0xff);
+            string pc = getHexString(getTestRandom(seed) & 0xffff);
+            
+            referenceCPU.setValue("a", a);
+            referenceCPU.setValue("x", x);
+            referenceCPU.setValue("y", y);
+            referenceCPU.setValue("p", p);
+            referenceCPU.setValue("pc", pc);
+            cpu.setValue("a", a);
+            cpu.setValue("x", x);
+            cpu.setValue("y", y);
+            cpu.setValue("p", p);
+            cpu.setValue("pc", pc);
+        }
+        
+        OESLong referencePendingCycles = referenceRig.run(APPLEIIIMOS6502_TEST_SLICE);
+        OESLong pendingCycles = rig.run(APPLEIIIMOS6502_TEST_SLICE);
+        
+        if (!rig.check(pendingCycles == referencePendingCycles,
+                       "slice " + getString(i) + " ended " +
+                       getString((OEInt) (referencePendingCycles - pendingCycles)) +
+                       " cycles away from the MOS6502"))
+            return false;
+        
+        for (OEInt j = 0; j < sizeof(registers) / sizeof(registers[0]); j++)
+        {
+            OEInt referenceValue = referenceRig.get(registers[j]);
+            
+            if (!rig.check(rig.get(registers[j]) == referenceValue,
+                           "slice " + getString(i) + ": " + registers[j] + " is " +
+                           getHexString(rig.get(registers[j])) + ", not " +
+                           getHexString(referenceValue)))
+                return false;
+        }
+    }
+    
+    for (OEAddress address = 0; address < 0x10000; address++)
+    {
+        if (referenceRig.ram.read(address) != rig.ram.read(address))
+            return rig.check(false, "memory at " + getHexString(address) +
+                             " differs from the MOS6502");
+    }
+    
+    return rig.check(rig.systemControl.extendedRAMBankCount == 0,
+                     "extended RAM bank selected with extended addressing off");
+}
+
+bool testAppleIIIMOS6502(string resourcePath, vector<string>& args)
+{
+    bool success = true;
+    
+    success &= checkAppleIIIMOS6502Extended();
+    success &= checkAppleIIIMOS6502ZeroPage();
+    success &= checkAppleIIIMOS6502Parity();
+    
+    return success;
+}
@@ -0,0 +1,141 @@
+
+/**
+ * oetest
+ * CPU test
+ * (C) 2012 by Marc S. Ressl (mressl@umich.edu)
+ * Released under the GPL
+ *
+ * Checks the 6502-family cores against the cores they replaced
+ */
+
+#include <iostream>
+
+#include "oetest.h"
+
+#include "util.h"
+
+#include "HeadlessAudio.h"
+
+#include "ControlBusInterface.h"
+
+// Notes:
+// * Each machine's RAM is filled with random bytes. Before each audio
+//   buffer the registers, decimal mode included, are set at random and
+//   the program counter is pointed into RAM, so the core runs random
+//   code, legal or not, and random I/O accesses.
+// * After each buffer the registers and the bus cycles are added to the
+//   digest, and the RAM at the end. The expected digests were recorded
+//   with the cores as they were before the page pointer fast path and
+//   the shared MOS6502_EXECUTE loop, and with the disk drive noise drawn
+//   from the drive's own generator.
+
+#define CPU_TEST_SAMPLERATE         48000
+#define CPU_TEST_FRAMESPERBUFFER    64
+#define CPU_TEST_BUFFERNUM          4000
+#define CPU_TEST_RAMEND             0xc000
+#define CPU_TEST_CODESTART          0x0800
+
+typedef struct
+{
+    string templateName;
+    string device;
+    OEAddress ramEnd;
+    OELong digest;
+} CPUTestMachine;
+
+static CPUTestMachine cpuTestMachines[] =
+{
+    {"Apple II/Apple II plus", "appleIIplus", CPU_TEST_RAMEND, 0x30f356a1d3757f92ULL},
+    {"Apple II/Apple IIe", "appleIIe", CPU_TEST_RAMEND, 0x9f8fff8bacdaeda6ULL},
+    {"Apple II/Apple IIe Enhanced", "appleIIe", CPU_TEST_RAMEND, 0xcb42084ffbde4f86ULL},
+    {"Apple-1/Apple-1", "apple1", 0x1000, 0xce74db2d4025b6b4ULL},
+    {"Apple-1/Briel Replica-1", "replica1", 0x8000, 0x781a931dc2645804ULL},
+};
+
+#define CPU_TEST_MACHINENUM (sizeof(cpuTestMachines) / sizeof(CPUTestMachine))
+
+static const char *cpuTestRegisters[] =
+{
+    "a", "x", "y", "s", "p", "pc",
+};
+
+#define CPU_TEST_REGISTERNUM (sizeof(cpuTestRegisters) / sizeof(const char *))
+
+static bool runCPUTest(string resourcePath, CPUTestMachine& machine)
+{
+    HeadlessAudio audio;
+    
+    audio.setSampleRate(CPU_TEST_SAMPLERATE);
+    audio.setFramesPerBuffer(CPU_TEST_FRAMESPERBUFFER);
+    
+    OEEmulation *emulation = openTestEmulation(resourcePath, machine.templateName, &audio);
+    
+    if (!emulation)
+        return false;
+    
+    OEComponent *cpu = emulation->getComponent(machine.device + ".cpu");
+    OEComponent *memoryBus = emulation->getComponent(machine.device + ".memoryBus");
+    OEComponent *controlBus = emulation->getComponent(machine.device + ".controlBus");
+    
+    if (!cpu || !memoryBus || !controlBus)
+    {
+        cerr << "oetest: cpu: " << machine.templateName << " has no " <<
+        machine.device << " cpu, memoryBus or controlBus" << endl;
+        
+        delete emulation;
+        
+        return false;
+    }
+    
+    OEInt seed = 1;
+    OELong digest = 0xcbf29ce484222325ULL;
+    
+    for (OEAddress address = 0; address < machine.ramEnd; address++)
+        memoryBus->write(address, getTestRandom(seed));
+    
+    for (OEInt i = 0; i < CPU_TEST_BUFFERNUM; i++)
+    {
+        OEAddress pc = CPU_TEST_CODESTART + getTestRandom(seed) % (machine.ramEnd -
+                                                                   CPU_TEST_CODESTART);
+        
+        cpu->setValue("a", getHexString(getTestRandom(seed) & 0xff));
+        cpu->setValue("x", getHexString(getTestRandom(seed) & 0xff));
+        cpu->setValue("y", getHexString(getTestRandom(seed) & 0xff));
+        cpu->setValue("p", getHexString(getTestRandom(seed) & 0xff));
+        cpu->setValue("pc", getHexString(pc));
+        
+        audio.runEmulations(1);
+        
+        for (OEInt j = 0; j < CPU_TEST_REGISTERNUM; j++)
+        {
+            string value;
+            
+            cpu->getValue(cpuTestRegisters[j], value);
+            
+            digest = getTestHash(digest, getOEInt(value));
+        }
+        
+        OELong cycles;
+        
+        controlBus->postMessage(NULL, CONTROLBUS_GET_CYCLES, &cycles);
+        
+        digest = getTestHash(digest, cycles);
+    }
+    
+    for (OEAddress address = 0; address < machine.ramEnd; address++)
+        digest = getTestHash(digest, memoryBus->read(address));
+    
+    delete emulation;
+    
+    return checkTestDigest("cpu " + machine.templateName, digest, machine.digest);
+}
+
+bool testCPU(string resourcePath, vector<string>& args)
+{
+    bool success = true;
+    
+    for (OEInt i = 0; i < CPU_TEST_MACHINENUM; i++)
+        success &= runCPUTest(resourcePath, cpuTestMachines[i]);
+    
+    return success;
+}
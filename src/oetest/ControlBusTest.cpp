@@ -0,0 +1,560 @@
+
+/**
+ * oetest
+ * Control bus test
+ * (C) 2012 by Marc S. Ressl (mressl@umich.edu)
+ * Released under the GPL
+ *
+ * Checks the control bus event scheduler
+ */
+
+#include <iostream>
+
+#include "oetest.h"
+
+#include "HeadlessAudio.h"
+
+#include "ControlBus.h"
+#include "CPUInterface.h"
+
+// Notes:
+// * A fake CPU runs instructions of random length. Now and then an
+//   instruction makes one of the test timers schedule a timer, or
+//   invalidate its timers with an id. Timers do the same, at random, when
+//   they fire.
+// * Every action and every fired timer is added to a trace digest, with
+//   the control bus cycles at that moment. The expected digests were
+//   recorded with the list scheduler the control bus used before events
+//   were kept in a heap. That scheduler lost the delay of a removed timer
+//   when the timer after it was removed too; this was fixed before
+//   recording.
+// * The ghost run adds a timer component that schedules timers and cancels
+//   them by handle. A cancelled timer must leave the other timers exactly
+//   as if it had never been scheduled, so the ghost run's digest is
+//   compared with that of a run that only draws the same random numbers.
+
+#define CONTROLBUS_TEST_CLOCKFREQUENCY  "1020484"
+#define CONTROLBUS_TEST_SAMPLERATE      48000
+#define CONTROLBUS_TEST_BUFFERNUM       2000
+#define CONTROLBUS_TEST_TIMERNUM        8
+#define CONTROLBUS_TEST_IDNUM           3
+#define CONTROLBUS_TEST_GHOSTID         7
+#define CONTROLBUS_TEST_HALTINSTRUCTION 5
+
+#define CONTROLBUS_TEST_TRACE1          0xd2f26014154fa583ULL
+#define CONTROLBUS_TEST_TRACE25         0x062f210f61c3caacULL
+
+typedef enum
+{
+    CONTROLBUS_TEST_GHOST_NONE,
+    CONTROLBUS_TEST_GHOST_SKIP,
+    CONTROLBUS_TEST_GHOST_RUN,
+} ControlBusTestGhostMode;
+
+class ControlBusTestTimer;
+class ControlBusTestGhost;
+
+typedef struct
+{
+    OEComponent *controlBus;
+    OEInt seed;
+    OELong trace;
+    OELong fireCount;
+    ControlBusTestGhostMode ghostMode;
+    OEInt errorCount;
+    vector<ControlBusTestTimer *> timers;
+    ControlBusTestGhost *ghost;
+} ControlBusTestContext;
+
+class ControlBusTestDevice : public OEComponent
+{
+public:
+    bool postMessage(OEComponent *sender, int message, void *data)
+    {
+        return true;
+    }
+};
+
+class ControlBusTestTimer : public OEComponent
+{
+public:
+    ControlBusTestTimer(ControlBusTestContext *context, OEInt index)
+    {
+        this->context = context;
+        this->index = index;
+    }
+    
+    void act()
+    {
+        OEInt value = getTestRandom(context->seed);
+        
+        if (value & 3)
+        {
+            ControlBusTimer timer;
+            
+            if (value & 4)
+                timer.cycles = getTestRandom(context->seed) & 0x3fff;
+            else
+                timer.cycles = getTestRandom(context->seed) & 0x3f;
+            timer.id = getTestRandom(context->seed) % CONTROLBUS_TEST_IDNUM;
+            
+            context->controlBus->postMessage(this, CONTROLBUS_SCHEDULE_TIMER, &timer);
+        }
+        else
+        {
+            OEInt id = getTestRandom(context->seed) % CONTROLBUS_TEST_IDNUM;
+            
+            context->controlBus->postMessage(this, CONTROLBUS_INVALIDATE_TIMERS, &id);
+        }
+    }
+    
+    void notify(OEComponent *sender, int notification, void *data)
+    {
+        ControlBusTimer *timer = (ControlBusTimer *)data;
+        OELong cycles;
+        
+        context->controlBus->postMessage(this, CONTROLBUS_GET_CYCLES, &cycles);
+        
+        context->trace = getTestHash(context->trace, index);
+        context->trace = getTestHash(context->trace, timer->id);
+        context->trace = getTestHash(context->trace, timer->cycles);
+        context->trace = getTestHash(context->trace, cycles);
+        context->fireCount++;
+        
+        if (getTestRandom(context->seed) & 1)
+            act();
+    }
+    
+private:
+    ControlBusTestContext *context;
+    OEInt index;
+};
+
+class ControlBusTestGhost : public OEComponent
+{
+public:
+    ControlBusTestGhost(ControlBusTestContext *context)
+    {
+        this->context = context;
+    }
+    
+    void act()
+    {
+        bool isRun = (context->ghostMode == CONTROLBUS_TEST_GHOST_RUN);
+        OEInt value = getTestRandom(context->seed);
+        OEInt cycles = getTestRandom(context->seed) & 0xfff;
+        OEInt choice = getTestRandom(context->seed);
+        
+        if (!isRun)
+            return;
+        
+        if (value & 1)
+        {
+            ControlBusTimer timer;
+            
+            timer.cycles = cycles;
+            timer.id = CONTROLBUS_TEST_GHOSTID;
+            
+            context->controlBus->postMessage(this, CONTROLBUS_SCHEDULE_TIMER, &timer);
+            
+            pendingHandles.push_back(timer.handle);
+        }
+        else if (pendingHandles.size())
+        {
+            OEInt i = choice % pendingHandles.size();
+            OELong handle = pendingHandles[i];
+            
+            if (!context->controlBus->postMessage(this, CONTROLBUS_CANCEL_TIMER, &handle))
+                context->errorCount++;
+            
+            // A cancelled handle stays invalid
+            if (context->controlBus->postMessage(this, CONTROLBUS_CANCEL_TIMER, &handle))
+                context->errorCount++;
+            
+            pendingHandles.erase(pendingHandles.begin() + i);
+        }
+    }
+    
+    void notify(OEComponent *sender, int notification, void *data)
+    {
+        ControlBusTimer *timer = (ControlBusTimer *)data;
+        
+        if (timer->id != CONTROLBUS_TEST_GHOSTID)
+            context->errorCount++;
+        
+        for (OEInt i = 0; i < pendingHandles.size(); i++)
+        {
+            if (pendingHandles[i] == timer->handle)
+            {
+                pendingHandles.erase(pendingHandles.begin() + i);
+                
+                // A fired handle can not be cancelled
+                OELong handle = timer->handle;
+                
+                if (context->controlBus->postMessage(this, CONTROLBUS_CANCEL_TIMER, &handle))
+                    context->errorCount++;
+                
+                return;
+            }
+        }
+        
+        context->errorCount++;
+    }
+    
+private:
+    ControlBusTestContext *context;
+    vector<OELong> pendingHandles;
+};
+
+class ControlBusTestCPU : public OEComponent
+{
+public:
+    ControlBusTestCPU(ControlBusTestContext *context)
+    {
+        this->context = context;
+        
+        pendingCycles = 0;
+    }
+    
+    bool postMessage(OEComponent *sender, int message, void *data)
+    {
+        switch (message)
+        {
+            case CPU_SET_PENDINGCYCLES:
+                pendingCycles = *((OESLong *)data);
+                
+                return true;
+                
+            case CPU_GET_PENDINGCYCLES:
+                *((OESLong *)data) = pendingCycles;
+                
+                return true;
+                
+            case CPU_GET_PENDINGCYCLESPOINTER:
+                *((OESLong **)data) = &pendingCycles;
+                
+                return true;
+                
+            case CPU_RUN:
+                run();
+                
+                return true;
+        }
+        
+        return false;
+    }
+    
+private:
+    ControlBusTestContext *context;
+    OESLong pendingCycles;
+    
+    void run()
+    {
+        while (pendingCycles > 0)
+        {
+            pendingCycles -= 2 + getTestRandom(context->seed) % 6;
+            
+            if (getTestRandom(context->seed) & 0x1f)
+                continue;
+            
+            OELong cycles;
+            
+            context->controlBus->postMessage(this, CONTROLBUS_GET_CYCLES, &cycles);
+            
+            context->trace = getTestHash(context->trace, cycles);
+            
+            OEInt value = getTestRandom(context->seed);
+            
+            if ((context->ghostMode != CONTROLBUS_TEST_GHOST_NONE) && !(value & 0x7))
+                context->ghost->act();
+            else
+                context->timers[value % CONTROLBUS_TEST_TIMERNUM]->act();
+        }
+    }
+};
+
+// Runs the fake machine and returns the trace digest
+
+static OELong runControlBusTrace(string cpuClockMultiplier,
+                                 ControlBusTestGhostMode ghostMode,
+                                 OEInt& errorCount)
+{
+    ControlBusTestContext context;
+    
+    context.seed = 1;
+    context.trace = 0xcbf29ce484222325ULL;
+    context.fireCount = 0;
+    context.ghostMode = ghostMode;
+    context.errorCount = 0;
+    
+    ControlBus controlBus;
+    ControlBusTestDevice device;
+    HeadlessAudio audio;
+    ControlBusTestCPU cpu(&context);
+    ControlBusTestGhost ghost(&context);
+    
+    context.controlBus = &controlBus;
+    context.ghost = &ghost;
+    
+    for (OEInt i = 0; i < CONTROLBUS_TEST_TIMERNUM; i++)
+        context.timers.push_back(new ControlBusTestTimer(&context, i));
+    
+    controlBus.setValue("clockFrequency", CONTROLBUS_TEST_CLOCKFREQUENCY);
+    controlBus.setValue("cpuClockMultiplier", cpuClockMultiplier);
+    controlBus.setValue("powerState", "S0");
+    controlBus.setRef("device", &device);
+    controlBus.setRef("audio", &audio);
+    controlBus.setRef("cpu", &cpu);
+    
+    if (!controlBus.init())
+        errorCount++;
+    
+    audio.setSampleRate(CONTROLBUS_TEST_SAMPLERATE);
+    
+    for (OEInt i = 0; i < CONTROLBUS_TEST_BUFFERNUM; i++)
+    {
+        audio.setFramesPerBuffer(1 + getTestRandom(context.seed) % 1024);
+        audio.runEmulations(1);
+    }
+    
+    OELong cycles;
+    
+    controlBus.postMessage(NULL, CONTROLBUS_GET_CYCLES, &cycles);
+    
+    context.trace = getTestHash(context.trace, cycles);
+    context.trace = getTestHash(context.trace, context.fireCount);
+    
+    controlBus.dispose();
+    
+    for (OEInt i = 0; i < CONTROLBUS_TEST_TIMERNUM; i++)
+        delete context.timers[i];
+    
+    errorCount += context.errorCount;
+    
+    return context.trace;
+}
+
+// Checks handles on a fixed schedule
+
+class ControlBusTestRecorder : public OEComponent
+{
+public:
+    vector<OELong> handles;
+    
+    void notify(OEComponent *sender, int notification, void *data)
+    {
+        handles.push_back(((ControlBusTimer *)data)->handle);
+    }
+};
+
+class ControlBusTestIdleCPU : public OEComponent
+{
+public:
+    ControlBusTestIdleCPU()
+    {
+        pendingCycles = 0;
+    }
+    
+    bool postMessage(OEComponent *sender, int message, void *data)
+    {
+        switch (message)
+        {
+            case CPU_GET_PENDINGCYCLESPOINTER:
+                *((OESLong **)data) = &pendingCycles;
+                
+                return true;
+                
+            case CPU_RUN:
+                pendingCycles = 0;
+                
+                return true;
+        }
+        
+        return false;
+    }
+    
+private:
+    OESLong pendingCycles;
+};
+
+static bool checkControlBusHandles()
+{
+    ControlBus controlBus;
+    ControlBusTestDevice device;
+    HeadlessAudio audio;
+    ControlBusTestIdleCPU cpu;
+    ControlBusTestRecorder a;
+    ControlBusTestRecorder b;
+    
+    controlBus.setValue("clockFrequency", CONTROLBUS_TEST_CLOCKFREQUENCY);
+    controlBus.setValue("powerState", "S0");
+    controlBus.setRef("device", &device);
+    controlBus.setRef("audio", &audio);
+    controlBus.setRef("cpu", &cpu);
+    
+    if (!controlBus.init())
+        return false;
+    
+    ControlBusTimer timer1 = {100, 0, 0};
+    ControlBusTimer timer2 = {200, 0, 0};
+    ControlBusTimer timer3 = {150, 0, 0};
+    
+    controlBus.postMessage(&a, CONTROLBUS_SCHEDULE_TIMER, &timer1);
+    controlBus.postMessage(&a, CONTROLBUS_SCHEDULE_TIMER, &timer2);
+    controlBus.postMessage(&b, CONTROLBUS_SCHEDULE_TIMER, &timer3);
+    
+    bool success = true;
+    
+    // Only the owner cancels, and only once
+    success &= !controlBus.postMessage(&b, CONTROLBUS_CANCEL_TIMER, &timer1.handle);
+    success &= controlBus.postMessage(&a, CONTROLBUS_CANCEL_TIMER, &timer1.handle);
+    success &= !controlBus.postMessage(&a, CONTROLBUS_CANCEL_TIMER, &timer1.handle);
+    
+    // A reused pool entry gets a new handle
+    ControlBusTimer timer4 = {300, 1, 0};
+    
+    controlBus.postMessage(&a, CONTROLBUS_SCHEDULE_TIMER, &timer4);
+    
+    success &= (timer4.handle != timer1.handle);
+    success &= !controlBus.postMessage(&a, CONTROLBUS_CANCEL_TIMER, &timer1.handle);
+    
+    // Invalidating id 1 leaves id 0 alone
+    OEInt id = 1;
+    
+    controlBus.postMessage(&a, CONTROLBUS_INVALIDATE_TIMERS, &id);
+    
+    success &= !controlBus.postMessage(&a, CONTROLBUS_CANCEL_TIMER, &timer4.handle);
+    
+    audio.setSampleRate(CONTROLBUS_TEST_SAMPLERATE);
+    audio.setFramesPerBuffer(512);
+    audio.runEmulations(1);
+    
+    success &= ((a.handles.size() == 1) && (a.handles[0] == timer2.handle));
+    success &= ((b.handles.size() == 1) && (b.handles[0] == timer3.handle));
+    success &= !controlBus.postMessage(&a, CONTROLBUS_CANCEL_TIMER, &timer2.handle);
+    
+    controlBus.dispose();
+    
+    if (!success)
+        cerr << "oetest: controlbus: timer handles are not consistent" << endl;
+    
+    return success;
+}
+
+// Checks that a CPU pausing the control bus stops at once
+
+class ControlBusTestHaltingCPU : public OEComponent
+{
+public:
+    ControlBusTestHaltingCPU()
+    {
+        controlBus = NULL;
+        pendingCycles = 0;
+        instructionCount = 0;
+    }
+    
+    OEComponent *controlBus;
+    OEInt instructionCount;
+    
+    bool postMessage(OEComponent *sender, int message, void *data)
+    {
+        switch (message)
+        {
+            case CPU_GET_PENDINGCYCLESPOINTER:
+                *((OESLong **)data) = &pendingCycles;
+                
+                return true;
+                
+            case CPU_RUN:
+                while (pendingCycles > 0)
+                {
+                    pendingCycles -= 10;
+                    instructionCount++;
+                    
+                    if (instructionCount == CONTROLBUS_TEST_HALTINSTRUCTION)
+                    {
+                        ControlBusPowerState powerState = CONTROLBUS_POWERSTATE_PAUSE;
+                        
+                        controlBus->postMessage(this, CONTROLBUS_SET_POWERSTATE, &powerState);
+                        controlBus->postMessage(this, CONTROLBUS_END_SLICE, NULL);
+                    }
+                }
+                
+                return true;
+        }
+        
+        return false;
+    }
+    
+private:
+    OESLong pendingCycles;
+};
+
+static bool checkControlBusEndSlice()
+{
+    ControlBus controlBus;
+    ControlBusTestDevice device;
+    HeadlessAudio audio;
+    ControlBusTestHaltingCPU cpu;
+    ControlBusTestRecorder a;
+    
+    controlBus.setValue("clockFrequency", CONTROLBUS_TEST_CLOCKFREQUENCY);
+    controlBus.setValue("powerState", "S0");
+    controlBus.setRef("device", &device);
+    controlBus.setRef("audio", &audio);
+    controlBus.setRef("cpu", &cpu);
+    
+    cpu.controlBus = &controlBus;
+    
+    if (!controlBus.init())
+        return false;
+    
+    ControlBusTimer timer = {2000, 0, 0};
+    
+    controlBus.postMessage(&a, CONTROLBUS_SCHEDULE_TIMER, &timer);
+    
+    audio.setSampleRate(CONTROLBUS_TEST_SAMPLERATE);
+    audio.setFramesPerBuffer(512);
+    audio.runEmulations(2);
+    
+    // The timer still fires in the paused buffer, but the CPU is not run
+    bool success = ((cpu.instructionCount == CONTROLBUS_TEST_HALTINSTRUCTION) &&
+                    (a.handles.size() == 1));
+    
+    controlBus.dispose();
+    
+    if (!success)
+        cerr << "oetest: controlbus: the CPU did not stop when halted" << endl;
+    
+    return success;
+}
+
+bool testControlBus(string resourcePath, vector<string>& args)
+{
+    OEInt errorCount = 0;
+    bool success = true;
+    
+    success &= checkTestDigest("controlbus trace",
+                               runControlBusTrace("1", CONTROLBUS_TEST_GHOST_NONE, errorCount),
+                               CONTROLBUS_TEST_TRACE1);
+    success &= checkTestDigest("controlbus trace at 2.5x",
+                               runControlBusTrace("2.5", CONTROLBUS_TEST_GHOST_NONE, errorCount),
+                               CONTROLBUS_TEST_TRACE25);
+    
+    OELong skipTrace = runControlBusTrace("1", CONTROLBUS_TEST_GHOST_SKIP, errorCount);
+    OELong ghostTrace = runControlBusTrace("1", CONTROLBUS_TEST_GHOST_RUN, errorCount);
+    
+    success &= checkTestDigest("controlbus cancelled timers", ghostTrace, skipTrace);
+    
+    if (errorCount)
+    {
+        cerr << "oetest: controlbus: " << errorCount << " handle errors" << endl;
+        
+        success = false;
+    }
+    
+    success &= checkControlBusHandles();
+    success &= checkControlBusEndSlice();
+    
+    return success;
+}
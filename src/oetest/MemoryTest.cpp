@@ -0,0 +1,823 @@
+
+/**
+ * oetest
+ * Memory test
+ * (C) 2012 by Marc S. Ressl (mressl@umich.edu)
+ * Released under the GPL
+ *
+ * Checks the generic memory components
+ */
+
+#include <string.h>
+
+#include <iostream>
+#include <algorithm>
+
+#include "oetest.h"
+
+#include "util.h"
+
+#include "AddressDecoder.h"
+#include "AddressMapper.h"
+#include "AddressMasker.h"
+#include "AddressMux.h"
+#include "AddressOffset.h"
+#include "RAM.h"
+#include "ROM.h"
+#include "VRAM.h"
+
+// Notes:
+// * The components are built without an emulation, and RAM is mapped over
+//   a MEMORY_TEST_SIZE address decoder with MEMORY_TEST_BLOCKSIZE blocks.
+// * The decoder check maps and unmaps random ranges of three RAMs, half of
+//   the time between ADDRESSDECODER_BEGIN_UPDATE and
+//   ADDRESSDECODER_COMMIT_UPDATE. After each step, the pointers must match
+//   those of a decoder built from scratch with the live maps. Batches must
+//   post one MEMORY_MAP_DID_CHANGE, on commit, and the posted ranges must
+//   cover every block whose pointers changed.
+// * The mapper check drives two address mappers with the same overlapping
+//   maps through random selections, one with ADDRESSMAPPER_SELECT and the
+//   other with the masks ADDRESSMAPPER_GET_MASK returns for the same
+//   lists. Half of the lists are shuffled. The decoder of the first must
+//   match a decoder with the maps posted in list order, and the decoder
+//   of the second one with the maps posted in name order.
+// * The block check builds two equal sets of RAM, ROM, VRAM, offset,
+//   masker and mux components, mapped over a decoder. Random blocks that
+//   cross decoder blocks, VRAM video blocks and the end of each component
+//   are read with readBlock and compared with byte reads. Random blocks
+//   are written with writeBlock to one set and byte by byte to the other,
+//   and all memory must stay equal. VRAM_WILL_CHANGE must be sent, with no
+//   byte, before a block touching video memory is written, and only then.
+//   Other VRAM bytes may be written directly before the notification.
+// * The watchpoint check adds a write watchpoint and a read watchpoint
+//   within single blocks. Only the watched direction of those blocks may
+//   lose its direct pointer. Accesses are made in and out of the watched
+//   ranges, through mirrors and after remapping, and the hits must list
+//   exactly the watched ones, oldest first. Removing the watchpoints must
+//   give the blocks their direct pointers back.
+
+#define MEMORY_TEST_SIZE        0x10000
+#define MEMORY_TEST_BLOCKSIZE   0x100
+#define MEMORY_TEST_BLOCKNUM    (MEMORY_TEST_SIZE / MEMORY_TEST_BLOCKSIZE)
+#define MEMORY_TEST_RAMNUM      3
+#define MEMORY_TEST_UPDATENUM   1000
+#define MEMORY_TEST_MAPNUM      4
+#define MEMORY_TEST_SELECTNUM   500
+#define MEMORY_TEST_BLOCKOPNUM  400
+#define MEMORY_TEST_BLOCKMAX    0x400
+#define MEMORY_TEST_ROMSIZE     0x1000
+#define MEMORY_TEST_VRAMSIZE    0x2000
+#define MEMORY_TEST_CHAINSIZE   0x4000
+
+static const char *memoryTestMapperMaps[] =
+{
+    "0x0000-0x3fff",
+    "0x2000-0x5fff",
+    "0x4000-0x7fffr",
+    "0x4000-0x7fffw,0xc000-0xcfff",
+    "0x8000-0xbfff,0x0000-0x0fff",
+    "0xa000-0xffff",
+};
+
+#define MEMORY_TEST_MAPPERNAMENUM (sizeof(memoryTestMapperMaps) / sizeof(const char *))
+
+class MemoryTestObserver : public OEComponent
+{
+public:
+    OEInt notificationNum;
+    bool isRangeMissing;
+    vector<bool> isBlockNotified;
+    
+    MemoryTestObserver()
+    {
+        clear();
+    }
+    
+    void clear()
+    {
+        notificationNum = 0;
+        isRangeMissing = false;
+        isBlockNotified.assign(MEMORY_TEST_BLOCKNUM, false);
+    }
+    
+    void notify(OEComponent *sender, int notification, void *data)
+    {
+        if (notification != MEMORY_MAP_DID_CHANGE)
+            return;
+        
+        notificationNum++;
+        
+        if (!data)
+        {
+            isRangeMissing = true;
+            
+            return;
+        }
+        
+        OEAddressRange *range = (OEAddressRange *) data;
+        
+        for (OEAddress i = range->startAddress / MEMORY_TEST_BLOCKSIZE;
+             i <= range->endAddress / MEMORY_TEST_BLOCKSIZE;
+             i++)
+            isBlockNotified[(size_t) i] = true;
+    }
+};
+
+class MemoryTestVideoObserver : public OEComponent
+{
+public:
+    VRAM *vram;
+    OEInt notificationNum;
+    bool isByteNotified;
+    OEData notifiedData;
+    
+    void clear()
+    {
+        notificationNum = 0;
+        isByteNotified = false;
+    }
+    
+    void notify(OEComponent *sender, int notification, void *data)
+    {
+        if (notification != VRAM_WILL_CHANGE)
+            return;
+        
+        if (!notificationNum++)
+        {
+            OEData *vramData;
+            
+            vram->postMessage(NULL, RAM_GET_DATA, &vramData);
+            
+            notifiedData = *vramData;
+        }
+        
+        isByteNotified |= (data != NULL);
+    }
+};
+
+static bool isMemoryTestVideoEqual(OEData& a, OEData& b)
+{
+    return (equal(a.begin() + 0x400, a.begin() + 0xc00, b.begin() + 0x400) &&
+            equal(a.begin() + 0x1000, a.begin() + 0x1100, b.begin() + 0x1000));
+}
+
+static bool initMemoryTestRAM(RAM& ram, OEAddress size)
+{
+    ram.setValue("size", getHexString(size));
+    
+    return ram.init();
+}
+
+static void fillMemoryTestRAM(RAM& ram, OEInt seed)
+{
+    OEData *data;
+    
+    ram.postMessage(NULL, RAM_GET_DATA, &data);
+    
+    for (size_t i = 0; i < data->size(); i++)
+        (*data)[i] = getTestRandom(seed);
+}
+
+static bool isMemoryTestRAMEqual(RAM& a, RAM& b)
+{
+    OEData *aData;
+    OEData *bData;
+    
+    a.postMessage(NULL, RAM_GET_DATA, &aData);
+    b.postMessage(NULL, RAM_GET_DATA, &bData);
+    
+    return *aData == *bData;
+}
+
+static bool initMemoryTestDecoder(AddressDecoder& decoder, RAM& floatingBus)
+{
+    decoder.setValue("size", getHexString(MEMORY_TEST_SIZE));
+    decoder.setValue("blockSize", getHexString(MEMORY_TEST_BLOCKSIZE));
+    decoder.setRef("floatingBus", &floatingBus);
+    
+    return (initMemoryTestRAM(floatingBus, MEMORY_TEST_BLOCKSIZE) &&
+            decoder.init());
+}
+
+static void mapMemoryTest(AddressDecoder& decoder, MemoryMap& memoryMap,
+                          OEComponent *component,
+                          OEAddress startAddress, OEAddress endAddress)
+{
+    memoryMap.component = component;
+    memoryMap.startAddress = startAddress;
+    memoryMap.endAddress = endAddress;
+    memoryMap.read = true;
+    memoryMap.write = true;
+    
+    decoder.postMessage(NULL, ADDRESSDECODER_MAP, &memoryMap);
+}
+
+static bool checkMemoryTest(bool value, string message)
+{
+    if (!value)
+        cerr << "oetest: memory: " << message << endl;
+    
+    return value;
+}
+
+static void getMemoryTestPointers(AddressDecoder& decoder, vector<OEChar *>& pointers)
+{
+    pointers.clear();
+    
+    for (OEAddress i = 0; i < MEMORY_TEST_BLOCKNUM; i++)
+    {
+        OEAddress startAddress = i * MEMORY_TEST_BLOCKSIZE;
+        OEAddress endAddress = startAddress + MEMORY_TEST_BLOCKSIZE - 1;
+        
+        pointers.push_back(decoder.getReadPointer(startAddress, endAddress));
+        pointers.push_back(decoder.getWritePointer(startAddress, endAddress));
+    }
+}
+
+static bool isMemoryTestMapEqual(MemoryMap& a, MemoryMap& b)
+{
+    return ((a.component == b.component) &&
+            (a.startAddress == b.startAddress) &&
+            (a.endAddress == b.endAddress) &&
+            (a.read == b.read) &&
+            (a.write == b.write));
+}
+
+static bool checkMemoryDecoder()
+{
+    RAM floatingBus;
+    RAM ram[MEMORY_TEST_RAMNUM];
+    AddressDecoder decoder;
+    MemoryTestObserver observer;
+    
+    bool success = initMemoryTestDecoder(decoder, floatingBus);
+    
+    for (OEInt i = 0; i < MEMORY_TEST_RAMNUM; i++)
+        success &= initMemoryTestRAM(ram[i], MEMORY_TEST_SIZE);
+    
+    if (!success)
+        return checkMemoryTest(false, "could not init components");
+    
+    decoder.addObserver(&observer, MEMORY_MAP_DID_CHANGE);
+    
+    vector<MemoryMap> maps;
+    vector<OEChar *> lastPointers;
+    vector<OEChar *> pointers;
+    OEInt seed = 1;
+    
+    getMemoryTestPointers(decoder, lastPointers);
+    
+    for (OEInt i = 0; i < MEMORY_TEST_UPDATENUM; i++)
+    {
+        bool isBatch = getTestRandom(seed) & 1;
+        OEInt mapNum = 1 + getTestRandom(seed) % MEMORY_TEST_MAPNUM;
+        
+        observer.clear();
+        
+        if (isBatch)
+            decoder.postMessage(NULL, ADDRESSDECODER_BEGIN_UPDATE, NULL);
+        
+        for (OEInt j = 0; j < mapNum; j++)
+        {
+            if (maps.size() && (getTestRandom(seed) & 1))
+            {
+                size_t index = getTestRandom(seed) % maps.size();
+                
+                decoder.postMessage(NULL, ADDRESSDECODER_UNMAP, &maps[index]);
+                
+                maps.erase(maps.begin() + index);
+                
+                continue;
+            }
+            
+            OEInt startBlock = getTestRandom(seed) % MEMORY_TEST_BLOCKNUM;
+            OEInt endBlock = startBlock + getTestRandom(seed) % (MEMORY_TEST_BLOCKNUM - startBlock);
+            
+            MemoryMap m;
+            
+            m.component = &ram[getTestRandom(seed) % MEMORY_TEST_RAMNUM];
+            m.startAddress = startBlock * MEMORY_TEST_BLOCKSIZE;
+            m.endAddress = (endBlock + 1) * MEMORY_TEST_BLOCKSIZE - 1;
+            m.read = getTestRandom(seed) & 1;
+            m.write = !m.read || (getTestRandom(seed) & 1);
+            
+            // Unmapping removes every equal map, so maps are kept unique
+            bool isMapped = false;
+            
+            for (size_t k = 0; k < maps.size(); k++)
+                isMapped |= isMemoryTestMapEqual(maps[k], m);
+            
+            if (isMapped)
+                continue;
+            
+            maps.push_back(m);
+            
+            decoder.postMessage(NULL, ADDRESSDECODER_MAP, &m);
+        }
+        
+        if (isBatch)
+        {
+            success &= checkMemoryTest(!observer.notificationNum,
+                                       "decoder notified before commit");
+            
+            decoder.postMessage(NULL, ADDRESSDECODER_COMMIT_UPDATE, NULL);
+        }
+        
+        // Compare with a decoder built from scratch
+        AddressDecoder expectedDecoder;
+        vector<OEChar *> expectedPointers;
+        
+        initMemoryTestDecoder(expectedDecoder, floatingBus);
+        
+        for (size_t j = 0; j < maps.size(); j++)
+            expectedDecoder.postMessage(NULL, ADDRESSDECODER_MAP, &maps[j]);
+        
+        getMemoryTestPointers(decoder, pointers);
+        getMemoryTestPointers(expectedDecoder, expectedPointers);
+        
+        if (pointers != expectedPointers)
+            return checkMemoryTest(false, "decoder pointers do not match the maps");
+        
+        bool isChanged = false;
+        bool isCovered = true;
+        
+        for (size_t j = 0; j < pointers.size(); j++)
+        {
+            if (pointers[j] == lastPointers[j])
+                continue;
+            
+            isChanged = true;
+            isCovered &= observer.isBlockNotified[j / 2];
+        }
+        
+        success &= checkMemoryTest(!observer.isRangeMissing,
+                                   "decoder notified without a range");
+        success &= checkMemoryTest(isCovered,
+                                   "decoder notification misses changed blocks");
+        
+        if (isBatch)
+            success &= checkMemoryTest(observer.notificationNum == (isChanged ? 1 : 0),
+                                       "decoder commit did not notify once");
+        
+        if (!success)
+            return false;
+        
+        lastPointers = pointers;
+    }
+    
+    return success;
+}
+
+static bool checkMemoryMapper()
+{
+    RAM floatingBus;
+    RAM ram[MEMORY_TEST_MAPPERNAMENUM];
+    AddressDecoder selDecoder;
+    AddressDecoder maskDecoder;
+    AddressMapper selMapper;
+    AddressMapper maskMapper;
+    vector<MemoryMaps> maps(MEMORY_TEST_MAPPERNAMENUM);
+    
+    bool success = (initMemoryTestDecoder(selDecoder, floatingBus) &&
+                    initMemoryTestDecoder(maskDecoder, floatingBus));
+    
+    selMapper.setRef("addressDecoder", &selDecoder);
+    maskMapper.setRef("addressDecoder", &maskDecoder);
+    
+    for (OEInt i = 0; i < MEMORY_TEST_MAPPERNAMENUM; i++)
+    {
+        string name = "N" + getString(i);
+        
+        success &= initMemoryTestRAM(ram[i], MEMORY_TEST_SIZE);
+        success &= appendMemoryMaps(maps[i], &ram[i], memoryTestMapperMaps[i]);
+        
+        selMapper.setValue("map" + name, memoryTestMapperMaps[i]);
+        selMapper.setRef("ref" + name, &ram[i]);
+        maskMapper.setValue("map" + name, memoryTestMapperMaps[i]);
+        maskMapper.setRef("ref" + name, &ram[i]);
+    }
+    
+    success &= selMapper.init() && maskMapper.init();
+    
+    if (!success)
+        return checkMemoryTest(false, "could not init components");
+    
+    OEInt seed = 1;
+    
+    for (OEInt i = 0; i < MEMORY_TEST_SELECTNUM; i++)
+    {
+        vector<OEInt> order;
+        
+        for (OEInt j = 0; j < MEMORY_TEST_MAPPERNAMENUM; j++)
+            if (getTestRandom(seed) & 1)
+                order.push_back(j);
+        
+        vector<OEInt> nameOrder = order;
+        
+        if (getTestRandom(seed) & 1)
+        {
+            for (OEInt j = (OEInt) order.size(); j > 1; j--)
+                swap(order[j - 1], order[getTestRandom(seed) % j]);
+        }
+        
+        AddressMapperMask mask;
+        
+        for (size_t j = 0; j < order.size(); j++)
+            mask.sel += (j ? ",N" : "N") + getString(order[j]);
+        
+        selMapper.postMessage(NULL, ADDRESSMAPPER_SELECT, &mask.sel);
+        maskMapper.postMessage(NULL, ADDRESSMAPPER_GET_MASK, &mask);
+        maskMapper.postMessage(NULL, ADDRESSMAPPER_SELECT_MASK, &mask.mask);
+        
+        string sel;
+        
+        selMapper.getValue("sel", sel);
+        
+        success &= checkMemoryTest(sel == mask.sel, "mapper sel does not match the selection");
+        
+        // Expected decoders, with the maps posted in list and name order
+        AddressDecoder expectedSelDecoder;
+        AddressDecoder expectedMaskDecoder;
+        
+        initMemoryTestDecoder(expectedSelDecoder, floatingBus);
+        initMemoryTestDecoder(expectedMaskDecoder, floatingBus);
+        
+        for (size_t j = 0; j < order.size(); j++)
+        {
+            MemoryMaps& selMaps = maps[order[j]];
+            MemoryMaps& maskMaps = maps[nameOrder[j]];
+            
+            for (MemoryMaps::iterator k = selMaps.begin(); k != selMaps.end(); k++)
+                expectedSelDecoder.postMessage(NULL, ADDRESSDECODER_MAP, &*k);
+            for (MemoryMaps::iterator k = maskMaps.begin(); k != maskMaps.end(); k++)
+                expectedMaskDecoder.postMessage(NULL, ADDRESSDECODER_MAP, &*k);
+        }
+        
+        vector<OEChar *> pointers;
+        vector<OEChar *> expectedPointers;
+        
+        getMemoryTestPointers(selDecoder, pointers);
+        getMemoryTestPointers(expectedSelDecoder, expectedPointers);
+        
+        success &= checkMemoryTest(pointers == expectedPointers,
+                                   "mapper selection is not mapped in list order");
+        
+        getMemoryTestPointers(maskDecoder, pointers);
+        getMemoryTestPointers(expectedMaskDecoder, expectedPointers);
+        
+        success &= checkMemoryTest(pointers == expectedPointers,
+                                   "mapper mask is not mapped in name order");
+        
+        if (!success)
+            return false;
+    }
+    
+    return success;
+}
+
+// The decoder maps, in 0x1000 byte blocks: RAM 0-3, ROM 4 (read only),
+// VRAM 6-7, offset 8-b, masker c-d and mux e-f
+
+class MemoryTestBlocks
+{
+public:
+    RAM floatingBus;
+    RAM ram;
+    ROM rom;
+    VRAM vram;
+    RAM offsetRAM;
+    AddressOffset offset;
+    RAM maskerRAM;
+    AddressMasker masker;
+    RAM muxRAM;
+    AddressMux mux;
+    AddressDecoder decoder;
+    MemoryTestVideoObserver videoObserver;
+    
+    bool init()
+    {
+        bool success = true;
+        
+        OEData romData;
+        OEInt seed = 1;
+        
+        for (OEInt i = 0; i < MEMORY_TEST_ROMSIZE; i++)
+            romData.push_back(getTestRandom(seed));
+        
+        rom.setData("memoryImage", &romData);
+        
+        success &= rom.init();
+        
+        videoObserver.vram = &vram;
+        videoObserver.clear();
+        vram.setValue("videoBlockSize", "0x100");
+        // isMemoryTestVideoEqual compares these ranges
+        vram.setValue("videoMap", "0x400-0xbff,0x1000-0x10ff");
+        vram.setRef("videoObserver", &videoObserver);
+        
+        success &= initMemoryTestRAM(ram, MEMORY_TEST_CHAINSIZE);
+        success &= initMemoryTestRAM(vram, MEMORY_TEST_VRAMSIZE);
+        success &= initMemoryTestRAM(offsetRAM, MEMORY_TEST_CHAINSIZE);
+        success &= initMemoryTestRAM(maskerRAM, MEMORY_TEST_CHAINSIZE);
+        success &= initMemoryTestRAM(muxRAM, MEMORY_TEST_CHAINSIZE);
+        
+        AddressOffsetMap offsetMaps[] =
+        {
+            {0x0000, 0x0fff, 0x1000},
+            {0x1000, 0x17ff, 0x2800},
+            {0x3000, 0x3fff, -0x3000},
+        };
+        
+        offset.setValue("size", getHexString(MEMORY_TEST_CHAINSIZE));
+        offset.setValue("blockSize", getHexString(MEMORY_TEST_BLOCKSIZE));
+        offset.setRef("memory", &offsetRAM);
+        
+        success &= offset.init();
+        
+        for (OEInt i = 0; i < sizeof(offsetMaps) / sizeof(AddressOffsetMap); i++)
+            offset.postMessage(NULL, ADDRESSOFFSET_MAP, &offsetMaps[i]);
+        
+        // Ranges within 16 bytes stay contiguous, others are split
+        masker.setValue("andMask", "0x3fef");
+        masker.setValue("orMask", "0x10");
+        masker.setRef("memory", &maskerRAM);
+        
+        success &= masker.init();
+        
+        mux.setValue("sel", "RAM");
+        mux.setRef("refRAM", &muxRAM);
+        
+        success &= mux.init();
+        
+        success &= initMemoryTestDecoder(decoder, floatingBus);
+        
+        fillMemoryTestRAM(floatingBus, 2);
+        fillMemoryTestRAM(ram, 3);
+        fillMemoryTestRAM(vram, 4);
+        fillMemoryTestRAM(offsetRAM, 5);
+        fillMemoryTestRAM(maskerRAM, 6);
+        fillMemoryTestRAM(muxRAM, 7);
+        
+        MemoryMap m;
+        
+        mapMemoryTest(decoder, m, &ram, 0x0000, 0x3fff);
+        mapMemoryTest(decoder, m, &rom, 0x4000, 0x4fff);
+        mapMemoryTest(decoder, m, &vram, 0x6000, 0x7fff);
+        mapMemoryTest(decoder, m, &offset, 0x8000, 0xbfff);
+        mapMemoryTest(decoder, m, &masker, 0xc000, 0xdfff);
+        mapMemoryTest(decoder, m, &mux, 0xe000, 0xffff);
+        
+        m.component = &rom;
+        m.startAddress = 0x4000;
+        m.endAddress = 0x4fff;
+        m.read = false;
+        m.write = true;
+        
+        decoder.postMessage(NULL, ADDRESSDECODER_UNMAP, &m);
+        
+        m.component = &floatingBus;
+        
+        decoder.postMessage(NULL, ADDRESSDECODER_MAP, &m);
+        
+        return success;
+    }
+    
+    OEComponent *getComponent(OEInt index, OEAddress& size)
+    {
+        switch (index)
+        {
+            case 0: size = MEMORY_TEST_CHAINSIZE; return &ram;
+            case 1: size = MEMORY_TEST_ROMSIZE; return &rom;
+            case 2: size = MEMORY_TEST_VRAMSIZE; return &vram;
+            case 3: size = MEMORY_TEST_CHAINSIZE; return &offset;
+            case 4: size = MEMORY_TEST_CHAINSIZE; return &masker;
+            case 5: size = MEMORY_TEST_CHAINSIZE; return &mux;
+            case 6: size = MEMORY_TEST_SIZE; return &decoder;
+        }
+        
+        return NULL;
+    }
+    
+    bool isEqual(MemoryTestBlocks& other)
+    {
+        return (isMemoryTestRAMEqual(floatingBus, other.floatingBus) &&
+                isMemoryTestRAMEqual(ram, other.ram) &&
+                isMemoryTestRAMEqual(vram, other.vram) &&
+                isMemoryTestRAMEqual(offsetRAM, other.offsetRAM) &&
+                isMemoryTestRAMEqual(maskerRAM, other.maskerRAM) &&
+                isMemoryTestRAMEqual(muxRAM, other.muxRAM));
+    }
+};
+
+#define MEMORY_TEST_BLOCKCOMPONENTNUM 7
+
+static const char *memoryTestBlockComponents[] =
+{
+    "RAM", "ROM", "VRAM", "offset", "masker", "mux", "decoder",
+};
+
+static bool checkMemoryBlocks()
+{
+    MemoryTestBlocks blocks;
+    MemoryTestBlocks bytes;
+    
+    if (!blocks.init() || !bytes.init())
+        return checkMemoryTest(false, "could not init components");
+    
+    OEInt seed = 1;
+    OEChar data[MEMORY_TEST_BLOCKMAX];
+    OEChar expectedData[MEMORY_TEST_BLOCKMAX];
+    
+    for (OEInt i = 0; i < MEMORY_TEST_BLOCKCOMPONENTNUM; i++)
+    {
+        OEAddress size;
+        OEComponent *blockComponent = blocks.getComponent(i, size);
+        OEComponent *byteComponent = bytes.getComponent(i, size);
+        string name = memoryTestBlockComponents[i];
+        
+        for (OEInt j = 0; j < MEMORY_TEST_BLOCKOPNUM; j++)
+        {
+            // Addresses past the end check mirroring and wrapping
+            OEAddress address = getTestRandom(seed) % (2 * size);
+            OEInt n = getTestRandom(seed) % (MEMORY_TEST_BLOCKMAX + 1);
+            bool isWrite = (getTestRandom(seed) & 1) && (blockComponent != &blocks.rom);
+            
+            if (!isWrite)
+            {
+                blockComponent->readBlock(address, data, n);
+                
+                for (OEInt k = 0; k < n; k++)
+                    expectedData[k] = blockComponent->read(address + k);
+                
+                if (memcmp(data, expectedData, n))
+                    return checkMemoryTest(false, name + " readBlock does not match read");
+                
+                continue;
+            }
+            
+            OEData *vramData;
+            
+            blocks.vram.postMessage(NULL, RAM_GET_DATA, &vramData);
+            
+            OEData lastVRAMData = *vramData;
+            
+            for (OEInt k = 0; k < n; k++)
+                data[k] = getTestRandom(seed);
+            
+            blocks.videoObserver.clear();
+            bytes.videoObserver.clear();
+            
+            blockComponent->writeBlock(address, data, n);
+            
+            for (OEInt k = 0; k < n; k++)
+                byteComponent->write(address + k, data[k]);
+            
+            if (!blocks.isEqual(bytes))
+                return checkMemoryTest(false, name + " writeBlock does not match write");
+            
+            if ((blocks.videoObserver.notificationNum != 0) !=
+                (bytes.videoObserver.notificationNum != 0))
+                return checkMemoryTest(false, name + " writeBlock did not notify "
+                                       "VRAM_WILL_CHANGE as write did");
+            
+            if (blocks.videoObserver.notificationNum &&
+                (blocks.videoObserver.isByteNotified ||
+                 !isMemoryTestVideoEqual(blocks.videoObserver.notifiedData, lastVRAMData)))
+                return checkMemoryTest(false, name + " writeBlock notified "
+                                       "VRAM_WILL_CHANGE with a byte or after writing");
+        }
+    }
+    
+    return true;
+}
+
+static bool checkMemoryWatchpoints()
+{
+    RAM floatingBus;
+    RAM ram;
+    RAM otherRAM;
+    AddressDecoder decoder;
+    
+    if (!initMemoryTestDecoder(decoder, floatingBus) ||
+        !initMemoryTestRAM(ram, MEMORY_TEST_SIZE) ||
+        !initMemoryTestRAM(otherRAM, MEMORY_TEST_SIZE))
+        return checkMemoryTest(false, "could not init components");
+    
+    bool success = true;
+    
+    MemoryMap ramMap;
+    
+    mapMemoryTest(decoder, ramMap, &ram, 0, MEMORY_TEST_SIZE - 1);
+    
+    MemoryWatchpoint writeWatchpoint = {0x300, 0x30f, false, true, false};
+    MemoryWatchpoint readWatchpoint = {0x520, 0x52f, true, false, false};
+    MemoryWatchpoint invalidWatchpoint = {0x10, MEMORY_TEST_SIZE, true, true, false};
+    
+    success &= checkMemoryTest(decoder.postMessage(NULL, ADDRESSDECODER_ADD_WATCHPOINT,
+                                                   &writeWatchpoint) &&
+                               decoder.postMessage(NULL, ADDRESSDECODER_ADD_WATCHPOINT,
+                                                   &readWatchpoint),
+                               "could not add watchpoints");
+    success &= checkMemoryTest(!decoder.postMessage(NULL, ADDRESSDECODER_ADD_WATCHPOINT,
+                                                    &invalidWatchpoint),
+                               "added a watchpoint past the decoder");
+    
+    success &= checkMemoryTest(!decoder.getWritePointer(0x300, 0x3ff) &&
+                               !decoder.getReadPointer(0x500, 0x5ff),
+                               "watched blocks have direct pointers");
+    success &= checkMemoryTest(decoder.getReadPointer(0x300, 0x3ff) &&
+                               decoder.getWritePointer(0x500, 0x5ff) &&
+                               decoder.getReadPointer(0x400, 0x4ff) &&
+                               decoder.getWritePointer(0x400, 0x4ff),
+                               "unwatched blocks lost their direct pointers");
+    
+    // Hits: 0x305 written, 0x525 read, 0x10306 written through a mirror
+    ram.write(0x525, 0x5a);
+    
+    decoder.write(0x305, 0x42);
+    decoder.write(0x310, 0x01);
+    decoder.read(0x305);
+    decoder.write(0x525, 0x5a);
+    decoder.read(0x525);
+    decoder.read(0x530);
+    decoder.write(0x10306, 0x07);
+    
+    success &= checkMemoryTest((ram.read(0x305) == 0x42) &&
+                               (ram.read(0x306) == 0x07) &&
+                               (ram.read(0x310) == 0x01),
+                               "watched writes did not reach memory");
+    
+    MemoryWatchpointHits hits;
+    
+    decoder.postMessage(NULL, ADDRESSDECODER_GET_WATCHPOINTHITS, &hits);
+    
+    success &= checkMemoryTest((hits.size() == 3) &&
+                               (hits[0].address == 0x305) &&
+                               (hits[0].value == 0x42) && hits[0].write &&
+                               (hits[1].address == 0x525) &&
+                               (hits[1].value == 0x5a) && !hits[1].write &&
+                               (hits[2].address == 0x10306) &&
+                               (hits[2].value == 0x07) && hits[2].write,
+                               "watchpoint hits do not match the watched accesses");
+    
+    // Watchpoints survive remapping
+    MemoryMap otherMap;
+    
+    mapMemoryTest(decoder, otherMap, &otherRAM, 0, 0xfff);
+    
+    decoder.write(0x301, 0x09);
+    
+    success &= checkMemoryTest(otherRAM.read(0x301) == 0x09,
+                               "watched write did not reach the remapped memory");
+    
+    decoder.postMessage(NULL, ADDRESSDECODER_UNMAP, &otherMap);
+    
+    decoder.postMessage(NULL, ADDRESSDECODER_GET_WATCHPOINTHITS, &hits);
+    
+    success &= checkMemoryTest((hits.size() == 4) &&
+                               (hits[0].address == 0x305) &&
+                               (hits[3].address == 0x301),
+                               "watchpoint did not survive remapping");
+    
+    decoder.postMessage(NULL, ADDRESSDECODER_CLEAR_WATCHPOINTHITS, NULL);
+    decoder.postMessage(NULL, ADDRESSDECODER_GET_WATCHPOINTHITS, &hits);
+    
+    success &= checkMemoryTest(hits.empty(), "watchpoint hits were not cleared");
+    
+    // Removing restores the direct pointers
+    success &= checkMemoryTest(decoder.postMessage(NULL, ADDRESSDECODER_REMOVE_WATCHPOINT,
+                                                   &writeWatchpoint) &&
+                               decoder.postMessage(NULL, ADDRESSDECODER_REMOVE_WATCHPOINT,
+                                                   &readWatchpoint),
+                               "could not remove watchpoints");
+    success &= checkMemoryTest(!decoder.postMessage(NULL, ADDRESSDECODER_REMOVE_WATCHPOINT,
+                                                    &writeWatchpoint),
+                               "removed a watchpoint twice");
+    
+    success &= checkMemoryTest((decoder.getWritePointer(0x300, 0x3ff) ==
+                                ram.getWritePointer(0x300, 0x3ff)) &&
+                               (decoder.getReadPointer(0x500, 0x5ff) ==
+                                ram.getReadPointer(0x500, 0x5ff)),
+                               "removed watchpoints did not restore direct pointers");
+    
+    decoder.write(0x303, 0x05);
+    decoder.read(0x525);
+    decoder.postMessage(NULL, ADDRESSDECODER_GET_WATCHPOINTHITS, &hits);
+    
+    success &= checkMemoryTest(hits.empty() && (ram.read(0x303) == 0x05),
+                               "removed watchpoints still record hits");
+    
+    return success;
+}
+
+bool testMemory(string resourcePath, vector<string>& args)
+{
+    bool success = true;
+    
+    success &= checkMemoryBlocks();
+    success &= checkMemoryDecoder();
+    success &= checkMemoryMapper();
+    success &= checkMemoryWatchpoints();
+    
+    return success;
+}
@@ -0,0 +1,194 @@
+
+/**
+ * oetest
+ * Rewind test
+ * (C) 2012 by Marc S. Ressl (mressl@umich.edu)
+ * Released under the GPL
+ *
+ * Checks that rewind snapshots restore the state they captured
+ */
+
+#include <iostream>
+
+#include "oetest.h"
+
+#include "HeadlessAudio.h"
+
+#include "OERewind.h"
+
+// Notes:
+// * Before each capture, random bytes are written to RAM and the machine
+//   runs one buffer. Every REWIND_TEST_FILLINTERVAL captures, a large
+//   block is written too, so that the delta grows past half the keyframe
+//   and a new group is started early. The state saved after each capture
+//   is kept.
+// * Every snapshot is restored, in random order, and the state saved
+//   right after restoring must match the one kept for that snapshot.
+// * A snapshot is then restored, RAM is written and the machine runs, and
+//   a capture is made. The snapshots newer than the restored one must be
+//   dropped, the new capture must be the newest, and the restored one must
+//   come right before it.
+
+#define REWIND_TEST_SAMPLERATE       48000
+#define REWIND_TEST_FRAMESPERBUFFER  512
+#define REWIND_TEST_BOOTBUFFERNUM    100
+#define REWIND_TEST_SNAPSHOTNUM      40
+#define REWIND_TEST_KEYFRAMEINTERVAL 8
+#define REWIND_TEST_FILLINTERVAL     13
+#define REWIND_TEST_WRITENUM         64
+#define REWIND_TEST_RAMSTART         0x800
+#define REWIND_TEST_RAMEND           0xc000
+#define REWIND_TEST_MAXMEMORY        (64 << 20)
+#define REWIND_TEST_RESTOREINDEX     9
+
+static void writeRewindTestMemory(OEComponent *memoryBus, OEInt& seed, bool isFill)
+{
+    OEInt ramSize = REWIND_TEST_RAMEND - REWIND_TEST_RAMSTART;
+    
+    for (OEInt i = 0; i < REWIND_TEST_WRITENUM; i++)
+        memoryBus->write(REWIND_TEST_RAMSTART + getTestRandom(seed) % ramSize,
+                         getTestRandom(seed));
+    
+    if (isFill)
+    {
+        for (OEAddress address = REWIND_TEST_RAMSTART; address < REWIND_TEST_RAMEND; address++)
+            memoryBus->write(address, getTestRandom(seed));
+    }
+}
+
+static bool checkRewindTestRestore(OEEmulation *emulation, OERewind& rewind,
+                                   OEInt index, OEData& expectedState)
+{
+    OEData state;
+    
+    if (!rewind.restore(index) || !emulation->saveState(&state))
+    {
+        cerr << "oetest: rewind: could not restore snapshot " << index << endl;
+        
+        return false;
+    }
+    
+    if (state != expectedState)
+    {
+        cerr << "oetest: rewind: snapshot " << index << " restored another state" << endl;
+        
+        return false;
+    }
+    
+    return true;
+}
+
+bool testRewind(string resourcePath, vector<string>& args)
+{
+    HeadlessAudio audio;
+    
+    audio.setSampleRate(REWIND_TEST_SAMPLERATE);
+    audio.setFramesPerBuffer(REWIND_TEST_FRAMESPERBUFFER);
+    
+    OEEmulation *emulation = openTestEmulation(resourcePath, "Apple II/Apple IIe Enhanced",
+                                               &audio);
+    
+    if (!emulation)
+        return false;
+    
+    OEComponent *memoryBus = emulation->getComponent("appleIIe.memoryBus");
+    
+    if (!memoryBus)
+    {
+        cerr << "oetest: rewind: Apple IIe Enhanced has no appleIIe memoryBus" << endl;
+        
+        delete emulation;
+        
+        return false;
+    }
+    
+    audio.runEmulations(REWIND_TEST_BOOTBUFFERNUM);
+    
+    OERewind rewind;
+    
+    rewind.setEmulation(emulation);
+    rewind.setMaxMemory(REWIND_TEST_MAXMEMORY);
+    rewind.setKeyframeInterval(REWIND_TEST_KEYFRAMEINTERVAL);
+    
+    vector<OEData> states(REWIND_TEST_SNAPSHOTNUM);
+    
+    OEInt seed = 1;
+    bool success = true;
+    
+    for (OEInt i = 0; i < REWIND_TEST_SNAPSHOTNUM; i++)
+    {
+        writeRewindTestMemory(memoryBus, seed, !((i + 1) % REWIND_TEST_FILLINTERVAL));
+        
+        audio.runEmulations(1);
+        
+        success &= rewind.capture();
+        success &= emulation->saveState(&states[i]);
+    }
+    
+    if (!success || (rewind.getSnapshotNum() != REWIND_TEST_SNAPSHOTNUM))
+    {
+        cerr << "oetest: rewind: could not capture " << REWIND_TEST_SNAPSHOTNUM <<
+        " snapshots" << endl;
+        
+        delete emulation;
+        
+        return false;
+    }
+    
+    // Restore every snapshot once, in random order
+    vector<OEInt> indices;
+    
+    for (OEInt i = 0; i < REWIND_TEST_SNAPSHOTNUM; i++)
+        indices.push_back(i);
+    
+    for (OEInt i = REWIND_TEST_SNAPSHOTNUM - 1; i > 0; i--)
+        swap(indices[i], indices[getTestRandom(seed) % (i + 1)]);
+    
+    for (OEInt i = 0; i < REWIND_TEST_SNAPSHOTNUM; i++)
+    {
+        OEInt index = indices[i];
+        
+        success &= checkRewindTestRestore(emulation, rewind, index,
+                                          states[REWIND_TEST_SNAPSHOTNUM - 1 - index]);
+    }
+    
+    if (rewind.restore(REWIND_TEST_SNAPSHOTNUM))
+    {
+        cerr << "oetest: rewind: restored a snapshot past the oldest" << endl;
+        
+        success = false;
+    }
+    
+    // Restore, mutate and capture again
+    OEData capturedState;
+    
+    success &= checkRewindTestRestore(emulation, rewind, REWIND_TEST_RESTOREINDEX,
+                                      states[REWIND_TEST_SNAPSHOTNUM - 1 -
+                                             REWIND_TEST_RESTOREINDEX]);
+    
+    writeRewindTestMemory(memoryBus, seed, false);
+    
+    audio.runEmulations(1);
+    
+    success &= rewind.capture();
+    success &= emulation->saveState(&capturedState);
+    
+    if (rewind.getSnapshotNum() != (REWIND_TEST_SNAPSHOTNUM - REWIND_TEST_RESTOREINDEX + 1))
+    {
+        cerr << "oetest: rewind: " << rewind.getSnapshotNum() <<
+        " snapshots after capturing past a restore" << endl;
+        
+        success = false;
+    }
+    else
+    {
+        success &= checkRewindTestRestore(emulation, rewind, 1,
+                                          states[REWIND_TEST_SNAPSHOTNUM - 1 -
+                                                 REWIND_TEST_RESTOREINDEX]);
+        success &= checkRewindTestRestore(emulation, rewind, 0, capturedState);
+    }
+    
+    delete emulation;
+    
+    return success;
+}
@@ -0,0 +1,192 @@
+
+/**
+ * oetest
+ * State test
+ * (C) 2012 by Marc S. Ressl (mressl@umich.edu)
+ * Released under the GPL
+ *
+ * Checks that a loaded state resumes the machine exactly
+ */
+
+#include <iostream>
+
+#include "oetest.h"
+
+#include "util.h"
+
+#include "HeadlessAudio.h"
+
+#include "ControlBusInterface.h"
+
+// Notes:
+// * The machine boots for STATE_TEST_BOOTBUFFERNUM buffers, so that the
+//   disk card, the drive and the video have timers pending, and the state
+//   is saved. The machine then runs STATE_TEST_BUFFERNUM buffers, adding
+//   the registers and the bus cycles to a digest after each one and the
+//   RAM at the end.
+// * The state is loaded and the same buffers are run again. The digests
+//   must match, and the state saved right after loading must match the
+//   state that was loaded byte by byte.
+// * On the IIe, the VBL switch at $C019 is read when the state is saved.
+//   Before loading, the machine runs until the switch reads otherwise, so
+//   that the switch read right after loading checks that the video state
+//   was restored.
+
+#define STATE_TEST_SAMPLERATE       48000
+#define STATE_TEST_FRAMESPERBUFFER  512
+#define STATE_TEST_BOOTBUFFERNUM    100
+#define STATE_TEST_BUFFERNUM        200
+#define STATE_TEST_RAMEND           0xc000
+#define STATE_TEST_VBLBUFFERNUM     16
+
+typedef struct
+{
+    string templateName;
+    string device;
+    OEAddress vblAddress;
+} StateTestMachine;
+
+static StateTestMachine stateTestMachines[] =
+{
+    {"Apple II/Apple II plus", "appleIIplus", 0},
+    {"Apple II/Apple IIe Enhanced", "appleIIe", 0xc019},
+};
+
+#define STATE_TEST_MACHINENUM (sizeof(stateTestMachines) / sizeof(StateTestMachine))
+
+static const char *stateTestRegisters[] =
+{
+    "a", "x", "y", "s", "p", "pc",
+};
+
+#define STATE_TEST_REGISTERNUM (sizeof(stateTestRegisters) / sizeof(const char *))
+
+static OELong runStateTestBuffers(HeadlessAudio& audio, OEComponent *cpu,
+                                  OEComponent *memoryBus, OEComponent *controlBus)
+{
+    OELong digest = 0xcbf29ce484222325ULL;
+    
+    for (OEInt i = 0; i < STATE_TEST_BUFFERNUM; i++)
+    {
+        audio.runEmulations(1);
+        
+        for (OEInt j = 0; j < STATE_TEST_REGISTERNUM; j++)
+        {
+            string value;
+            
+            cpu->getValue(stateTestRegisters[j], value);
+            
+            digest = getTestHash(digest, getOEInt(value));
+        }
+        
+        OELong cycles;
+        
+        controlBus->postMessage(NULL, CONTROLBUS_GET_CYCLES, &cycles);
+        
+        digest = getTestHash(digest, cycles);
+    }
+    
+    for (OEAddress address = 0; address < STATE_TEST_RAMEND; address++)
+        digest = getTestHash(digest, memoryBus->read(address));
+    
+    return digest;
+}
+
+static bool runStateTest(string resourcePath, StateTestMachine& machine)
+{
+    HeadlessAudio audio;
+    
+    audio.setSampleRate(STATE_TEST_SAMPLERATE);
+    audio.setFramesPerBuffer(STATE_TEST_FRAMESPERBUFFER);
+    
+    OEEmulation *emulation = openTestEmulation(resourcePath, machine.templateName, &audio);
+    
+    if (!emulation)
+        return false;
+    
+    OEComponent *cpu = emulation->getComponent(machine.device + ".cpu");
+    OEComponent *memoryBus = emulation->getComponent(machine.device + ".memoryBus");
+    OEComponent *controlBus = emulation->getComponent(machine.device + ".controlBus");
+    
+    if (!cpu || !memoryBus || !controlBus)
+    {
+        cerr << "oetest: state: " << machine.templateName << " has no " <<
+        machine.device << " cpu, memoryBus or controlBus" << endl;
+        
+        delete emulation;
+        
+        return false;
+    }
+    
+    audio.runEmulations(STATE_TEST_BOOTBUFFERNUM);
+    
+    OEData state;
+    OEData loadedState;
+    
+    bool success = emulation->saveState(&state);
+    
+    OEChar vbl = 0;
+    
+    if (machine.vblAddress)
+        vbl = memoryBus->read(machine.vblAddress) & 0x80;
+    
+    OELong digest = runStateTestBuffers(audio, cpu, memoryBus, controlBus);
+    
+    if (machine.vblAddress)
+    {
+        for (OEInt i = 0; i < STATE_TEST_VBLBUFFERNUM; i++)
+        {
+            if ((memoryBus->read(machine.vblAddress) & 0x80) != vbl)
+                break;
+            
+            audio.runEmulations(1);
+        }
+    }
+    
+    success &= emulation->loadState(&state);
+    success &= emulation->saveState(&loadedState);
+    
+    OEChar loadedVBL = 0;
+    
+    if (machine.vblAddress)
+        loadedVBL = memoryBus->read(machine.vblAddress) & 0x80;
+    
+    OELong resumedDigest = runStateTestBuffers(audio, cpu, memoryBus, controlBus);
+    
+    delete emulation;
+    
+    if (!success)
+    {
+        cerr << "oetest: state: could not save or load " << machine.templateName << endl;
+        
+        return false;
+    }
+    
+    if (loadedState != state)
+    {
+        cerr << "oetest: state: " << machine.templateName <<
+        " state changed when loaded" << endl;
+        
+        return false;
+    }
+    
+    if (loadedVBL != vbl)
+    {
+        cerr << "oetest: state: " << machine.templateName <<
+        " VBL switch not restored when loaded" << endl;
+        
+        return false;
+    }
+    
+    return checkTestDigest("state " + machine.templateName, resumedDigest, digest);
+}
+
+bool testState(string resourcePath, vector<string>& args)
+{
+    bool success = true;
+    
+    for (OEInt i = 0; i < STATE_TEST_MACHINENUM; i++)
+        success &= runStateTest(resourcePath, stateTestMachines[i]);
+    
+    return success;
+}
@@ -0,0 +1,286 @@
+
+/**
+ * oetest
+ * Triple buffer test
+ * (C) 2012 by Marc S. Ressl (mressl@umich.edu)
+ * Released under the GPL
+ *
+ * Checks that the display triple buffer hands over whole, ordered frames
+ */
+
+#include <string.h>
+#include <pthread.h>
+
+#include <atomic>
+#include <iostream>
+
+#include "oetest.h"
+
+#include "TripleBuffer.h"
+
+// Notes:
+// * A posting thread keeps one image, as the video components do. For
+//   each frame it writes the frame number to row 0 and a random band of
+//   rows, marks those rows dirty and posts the image.
+// * The reading thread takes frames as fast as it can. It replays the same
+//   writes on its own image up to the frame number it read, and the whole
+//   frame must match: a torn frame or a row left stale shows up here. The
+//   frame numbers must increase, and every row changed since the previous
+//   frame it took must be in the dirty rect.
+// * After the posting thread ends, the last frame must be delivered. Three
+//   more frames are posted and read one by one, then the buffer is cleared,
+//   and a partially dirty frame of another image must still arrive whole.
+
+#define TRIPLEBUFFER_TEST_WIDTH     80
+#define TRIPLEBUFFER_TEST_HEIGHT    192
+#define TRIPLEBUFFER_TEST_FRAMENUM  50000
+#define TRIPLEBUFFER_TEST_BANDNUM   8
+
+typedef struct
+{
+    TripleBuffer *frames;
+    std::atomic<bool> isDone;
+} TripleBufferTestPoster;
+
+static OEInt getTripleBufferTestFrameNum(OEImage& image)
+{
+    OEChar *p = image.getPixels();
+    
+    return p[0] | (p[1] << 8) | (p[2] << 16) | (p[3] << 24);
+}
+
+static void drawTripleBufferTestFrame(OEImage& image, OEInt& seed, OEInt frameNum)
+{
+    OEInt bytesPerRow = image.getBytesPerRow();
+    OEChar *p = image.getPixels();
+    
+    p[0] = frameNum;
+    p[1] = frameNum >> 8;
+    p[2] = frameNum >> 16;
+    p[3] = frameNum >> 24;
+    
+    OEInt y0 = 1 + getTestRandom(seed) % (TRIPLEBUFFER_TEST_HEIGHT - 1);
+    OEInt y1 = min(y0 + 1 + getTestRandom(seed) % TRIPLEBUFFER_TEST_BANDNUM,
+                   (OEInt) TRIPLEBUFFER_TEST_HEIGHT);
+    
+    for (OEInt y = y0; y < y1; y++)
+        memset(p + y * bytesPerRow, frameNum + y, bytesPerRow);
+    
+    image.setDirtyRect(OEUnionRect(OEMakeRect(0, 0, TRIPLEBUFFER_TEST_WIDTH, 1),
+                                   OEMakeRect(0, y0, TRIPLEBUFFER_TEST_WIDTH, y1 - y0)));
+}
+
+static void initTripleBufferTestImage(OEImage& image)
+{
+    image.setFormat(OEIMAGE_RGB);
+    image.setSize(OEMakeSize(TRIPLEBUFFER_TEST_WIDTH, TRIPLEBUFFER_TEST_HEIGHT));
+}
+
+static void *runTripleBufferTestPoster(void *arg)
+{
+    TripleBufferTestPoster *poster = (TripleBufferTestPoster *)arg;
+    
+    OEImage image;
+    OEInt seed = 1;
+    
+    initTripleBufferTestImage(image);
+    
+    for (OEInt i = 1; i <= TRIPLEBUFFER_TEST_FRAMENUM; i++)
+    {
+        drawTripleBufferTestFrame(image, seed, i);
+        
+        poster->frames->post(image);
+    }
+    
+    poster->isDone = true;
+    
+    return NULL;
+}
+
+// Replays frames on the model until frameNum, and checks the frame read
+
+class TripleBufferTestReader
+{
+public:
+    TripleBufferTestReader()
+    {
+        initTripleBufferTestImage(model);
+        initTripleBufferTestImage(lastModel);
+        
+        seed = 1;
+        frameNum = 0;
+    }
+    
+    bool check(OEImage& image)
+    {
+        OESize size = image.getSize();
+        
+        if ((size.width != TRIPLEBUFFER_TEST_WIDTH) ||
+            (size.height != TRIPLEBUFFER_TEST_HEIGHT) ||
+            (image.getFormat() != OEIMAGE_RGB))
+        {
+            cerr << "oetest: triplebuffer: frame after " << frameNum <<
+            " has another size or format" << endl;
+            
+            return false;
+        }
+        
+        OEInt nextFrameNum = getTripleBufferTestFrameNum(image);
+        
+        if (nextFrameNum <= frameNum)
+        {
+            cerr << "oetest: triplebuffer: frame " << nextFrameNum <<
+            " read after frame " << frameNum << endl;
+            
+            return false;
+        }
+        
+        memcpy(lastModel.getPixels(), model.getPixels(),
+               TRIPLEBUFFER_TEST_HEIGHT * model.getBytesPerRow());
+        
+        while (frameNum < nextFrameNum)
+            drawTripleBufferTestFrame(model, seed, ++frameNum);
+        
+        OEInt bytesPerRow = model.getBytesPerRow();
+        OERect dirtyRect = image.getDirtyRect();
+        
+        for (OEInt y = 0; y < TRIPLEBUFFER_TEST_HEIGHT; y++)
+        {
+            OEChar *p = image.getPixels() + y * bytesPerRow;
+            OEChar *modelp = model.getPixels() + y * bytesPerRow;
+            OEChar *lastModelp = lastModel.getPixels() + y * bytesPerRow;
+            
+            if (memcmp(p, modelp, bytesPerRow))
+            {
+                cerr << "oetest: triplebuffer: frame " << frameNum <<
+                " row " << y << " does not match" << endl;
+                
+                return false;
+            }
+            
+            if (memcmp(modelp, lastModelp, bytesPerRow) &&
+                ((y < OEMinY(dirtyRect)) || (y >= OEMaxY(dirtyRect))))
+            {
+                cerr << "oetest: triplebuffer: frame " << frameNum <<
+                " row " << y << " changed outside the dirty rect" << endl;
+                
+                return false;
+            }
+        }
+        
+        return true;
+    }
+    
+    OEInt getFrameNum()
+    {
+        return frameNum;
+    }
+    
+private:
+    OEImage model;
+    OEImage lastModel;
+    OEInt seed;
+    OEInt frameNum;
+};
+
+bool testTripleBuffer(string resourcePath, vector<string>& args)
+{
+    TripleBuffer frames;
+    TripleBufferTestPoster poster;
+    TripleBufferTestReader reader;
+    
+    poster.frames = &frames;
+    poster.isDone = false;
+    
+    pthread_t thread;
+    
+    if (pthread_create(&thread, NULL, runTripleBufferTestPoster, &poster))
+    {
+        cerr << "oetest: triplebuffer: could not create posting thread" << endl;
+        
+        return false;
+    }
+    
+    bool success = true;
+    
+    while (!poster.isDone)
+    {
+        if (!frames.update())
+            continue;
+        
+        if (!reader.check(frames.getImage()))
+        {
+            success = false;
+            
+            break;
+        }
+    }
+    
+    pthread_join(thread, NULL);
+    
+    if (!success)
+        return false;
+    
+    if (frames.update() && !reader.check(frames.getImage()))
+        return false;
+    
+    if (reader.getFrameNum() != TRIPLEBUFFER_TEST_FRAMENUM)
+    {
+        cerr << "oetest: triplebuffer: last frame read is " << reader.getFrameNum() <<
+        ", not " << TRIPLEBUFFER_TEST_FRAMENUM << endl;
+        
+        return false;
+    }
+    
+    // Post a frame into each buffer, so that none of them is stale all over
+    OEImage image;
+    OEInt seed = 1;
+    
+    initTripleBufferTestImage(image);
+    
+    for (OEInt i = 1; i <= TRIPLEBUFFER_TEST_FRAMENUM + 3; i++)
+    {
+        drawTripleBufferTestFrame(image, seed, i);
+        
+        if (i <= TRIPLEBUFFER_TEST_FRAMENUM)
+            continue;
+        
+        frames.post(image);
+        
+        if (!frames.update() || !reader.check(frames.getImage()))
+        {
+            cerr << "oetest: triplebuffer: frame " << i << " was not delivered" << endl;
+            
+            return false;
+        }
+    }
+    
+    // Clear, then post a partially dirty frame from another image
+    frames.clear();
+    
+    if (!frames.update() || frames.getImage().getSize().height)
+    {
+        cerr << "oetest: triplebuffer: clear was not delivered" << endl;
+        
+        return false;
+    }
+    
+    OEImage clearImage;
+    TripleBufferTestReader clearReader;
+    
+    seed = 1;
+    
+    initTripleBufferTestImage(clearImage);
+    drawTripleBufferTestFrame(clearImage, seed, 1);
+    
+    frames.post(clearImage);
+    
+    if (!frames.update() || !clearReader.check(frames.getImage()))
+    {
+        cerr << "oetest: triplebuffer: frame after clear was not delivered whole" << endl;
+        
+        return false;
+    }
+    
+    return true;
+}
@@ -0,0 +1,240 @@
+
+/**
+ * oetest
+ * Video decoder test
+ * (C) 2012 by Marc S. Ressl (mressl@umich.edu)
+ * Released under the GPL
+ *
+ * Checks the software video decoder on composite Apple IIe frames
+ */
+
+#include <string.h>
+
+#include <iostream>
+
+#include "oetest.h"
+
+#include "HeadlessAudio.h"
+#include "SoftwareCanvas.h"
+
+#include "CanvasInterface.h"
+
+// Notes:
+// * The Apple IIe Enhanced monitor is switched to the composite Y'IQ
+//   decoder. Each mode fills the text and hires pages with random bytes
+//   and runs VIDEODECODER_TEST_MODEBUFFERNUM buffers; then a few bytes at
+//   a time are written, so that frames only change some rows.
+// * Every display frame is decoded three times: by the canvas, on one
+//   thread and only redecoding dirty rows, by a canvas with
+//   VIDEODECODER_TEST_THREADNUM threads, and by a canvas that is passed a
+//   copy of the frame marked dirty all over. The three decoded images must
+//   match byte by byte.
+// * The decoded images are added to a digest, so that changes to the FIR
+//   filters, the carrier or the decoder matrix show up. When the decoder
+//   is changed on purpose, check the frames and update the digest.
+
+#define VIDEODECODER_TEST_SAMPLERATE        48000
+#define VIDEODECODER_TEST_FRAMESPERBUFFER   64
+#define VIDEODECODER_TEST_BOOTBUFFERNUM     500
+#define VIDEODECODER_TEST_MODEBUFFERNUM     60
+#define VIDEODECODER_TEST_WRITENUM          20
+#define VIDEODECODER_TEST_WRITEBUFFERNUM    15
+#define VIDEODECODER_TEST_THREADNUM         3
+#define VIDEODECODER_TEST_SWITCHNUM         6
+
+#define VIDEODECODER_TEST_DIGEST            0x4f778ccbb3a590c5ULL
+
+typedef struct
+{
+    OEAddress writeSwitches[VIDEODECODER_TEST_SWITCHNUM];
+    OEAddress readSwitches[VIDEODECODER_TEST_SWITCHNUM];
+} VideoDecoderTestMode;
+
+static VideoDecoderTestMode videoDecoderTestModes[] =
+{
+    {{0}, {0xc051, 0xc054, 0}},
+    {{0}, {0xc050, 0xc052, 0xc056, 0xc054, 0}},
+    {{0}, {0xc050, 0xc053, 0xc057, 0xc054, 0}},
+    {{0xc00d, 0}, {0xc050, 0xc052, 0xc057, 0xc05e, 0}},
+};
+
+#define VIDEODECODER_TEST_MODENUM (sizeof(videoDecoderTestModes) / sizeof(VideoDecoderTestMode))
+
+static OELong videoDecoderTestDigest;
+static OELong videoDecoderTestFrameCount;
+static bool isVideoDecoderTestMatching;
+
+class VideoDecoderTestCanvas : public SoftwareCanvas
+{
+public:
+    VideoDecoderTestCanvas(OECanvasType canvasType) :
+    SoftwareCanvas(canvasType),
+    threadedCanvas(canvasType),
+    fullCanvas(canvasType)
+    {
+        threadedCanvas.setThreadNum(VIDEODECODER_TEST_THREADNUM);
+    }
+    
+    bool postMessage(OEComponent *sender, int message, void *data)
+    {
+        if (getCanvasType() != OECANVAS_DISPLAY)
+            return SoftwareCanvas::postMessage(sender, message, data);
+        
+        if (message == CANVAS_POST_IMAGE)
+        {
+            OEImage fullImage = *((OEImage *)data);
+            OESize size = fullImage.getSize();
+            
+            fullImage.setDirtyRect(OEMakeRect(0, 0, size.width, size.height));
+            
+            SoftwareCanvas::postMessage(sender, message, data);
+            threadedCanvas.postMessage(sender, message, data);
+            fullCanvas.postMessage(sender, message, &fullImage);
+            
+            checkImages();
+            
+            return true;
+        }
+        
+        threadedCanvas.postMessage(sender, message, data);
+        fullCanvas.postMessage(sender, message, data);
+        
+        return SoftwareCanvas::postMessage(sender, message, data);
+    }
+    
+private:
+    SoftwareCanvas threadedCanvas;
+    SoftwareCanvas fullCanvas;
+    
+    bool isImageEqual(OEImage& a, OEImage& b)
+    {
+        OESize size = a.getSize();
+        
+        return ((size.width == b.getSize().width) &&
+                (size.height == b.getSize().height) &&
+                (a.getBytesPerRow() == b.getBytesPerRow()) &&
+                !memcmp(a.getPixels(), b.getPixels(),
+                        (size_t) size.height * a.getBytesPerRow()));
+    }
+    
+    void checkImages()
+    {
+        OEImage& image = getImage();
+        OESize size = image.getSize();
+        
+        if (!isImageEqual(image, threadedCanvas.getImage()))
+        {
+            cerr << "oetest: videodecoder: frame " << videoDecoderTestFrameCount <<
+            " decoded on " << VIDEODECODER_TEST_THREADNUM <<
+            " threads does not match" << endl;
+            
+            isVideoDecoderTestMatching = false;
+        }
+        
+        if (!isImageEqual(image, fullCanvas.getImage()))
+        {
+            cerr << "oetest: videodecoder: frame " << videoDecoderTestFrameCount <<
+            " decoded from dirty rows does not match a full decode" << endl;
+            
+            isVideoDecoderTestMatching = false;
+        }
+        
+        videoDecoderTestDigest = getTestHash(videoDecoderTestDigest, image.getPixels(),
+                                             (size_t) size.height * image.getBytesPerRow());
+        videoDecoderTestFrameCount++;
+    }
+};
+
+static OEComponent *constructVideoDecoderTestCanvas(void *userData,
+                                                    OEComponent *device,
+                                                    OECanvasType canvasType)
+{
+    return new VideoDecoderTestCanvas(canvasType);
+}
+
+static void destroyVideoDecoderTestCanvas(void *userData, OEComponent *canvas)
+{
+    delete (VideoDecoderTestCanvas *)canvas;
+}
+
+static void fillVideoDecoderTestMemory(OEComponent *memoryBus, OEInt& seed)
+{
+    for (OEAddress address = 0x400; address < 0xc00; address++)
+        memoryBus->write(address, getTestRandom(seed));
+    for (OEAddress address = 0x2000; address < 0x6000; address++)
+        memoryBus->write(address, getTestRandom(seed));
+}
+
+bool testVideoDecoder(string resourcePath, vector<string>& args)
+{
+    HeadlessAudio audio;
+    
+    audio.setSampleRate(VIDEODECODER_TEST_SAMPLERATE);
+    audio.setFramesPerBuffer(VIDEODECODER_TEST_FRAMESPERBUFFER);
+    
+    OEEmulation *emulation = openTestEmulation(resourcePath, "Apple II/Apple IIe Enhanced",
+                                               &audio,
+                                               constructVideoDecoderTestCanvas,
+                                               destroyVideoDecoderTestCanvas);
+    
+    if (!emulation)
+        return false;
+    
+    OEComponent *memoryBus = emulation->getComponent("appleIIe.memoryBus");
+    OEComponent *monitor = emulation->getComponent("appleMonitorII.monitor");
+    
+    if (!memoryBus || !monitor)
+    {
+        cerr << "oetest: videodecoder: Apple IIe Enhanced has no appleIIe memoryBus "
+        "or appleMonitorII monitor" << endl;
+        
+        delete emulation;
+        
+        return false;
+    }
+    
+    monitor->setValue("videoDecoder", "Composite Y'IQ");
+    monitor->update();
+    
+    videoDecoderTestDigest = 0xcbf29ce484222325ULL;
+    videoDecoderTestFrameCount = 0;
+    isVideoDecoderTestMatching = true;
+    
+    audio.runEmulations(VIDEODECODER_TEST_BOOTBUFFERNUM);
+    
+    OEInt seed = 1;
+    
+    for (OEInt i = 0; i < VIDEODECODER_TEST_MODENUM; i++)
+    {
+        VideoDecoderTestMode& mode = videoDecoderTestModes[i];
+        
+        // Write auxiliary memory through RAMWRT
+        memoryBus->write(0xc005, 0);
+        fillVideoDecoderTestMemory(memoryBus, seed);
+        memoryBus->write(0xc004, 0);
+        
+        fillVideoDecoderTestMemory(memoryBus, seed);
+        
+        for (OEInt j = 0; mode.writeSwitches[j]; j++)
+            memoryBus->write(mode.writeSwitches[j], 0);
+        for (OEInt j = 0; mode.readSwitches[j]; j++)
+            memoryBus->read(mode.readSwitches[j]);
+        
+        audio.runEmulations(VIDEODECODER_TEST_MODEBUFFERNUM);
+        
+        for (OEInt j = 0; j < VIDEODECODER_TEST_WRITENUM; j++)
+        {
+            OEAddress address = 0x2000 + getTestRandom(seed) % 0x2000;
+            
+            memoryBus->write(address, getTestRandom(seed));
+            
+            audio.runEmulations(VIDEODECODER_TEST_WRITEBUFFERNUM);
+        }
+    }
+    
+    delete emulation;
+    
+    return (isVideoDecoderTestMatching &&
+            checkTestDigest("videodecoder", videoDecoderTestDigest,
+                            VIDEODECODER_TEST_DIGEST));
+}
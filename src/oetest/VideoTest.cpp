@@ -0,0 +1,343 @@
+
+/**
+ * oetest
+ * Video test
+ * (C) 2012 by Marc S. Ressl (mressl@umich.edu)
+ * Released under the GPL
+ *
+ * Checks the Apple II and IIe video draw routines against the routines
+ * they replaced, and the frames they post
+ */
+
+#include <iostream>
+
+#include "oetest.h"
+
+#include "HeadlessAudio.h"
+#include "HeadlessCanvas.h"
+
+#include "CanvasInterface.h"
+
+// Notes:
+// * Each mode fills the text and hires pages with random bytes, both
+//   main and auxiliary memory on the IIe, sets the mode's soft switches
+//   and runs VIDEO_TEST_MODEBUFFERNUM buffers. Every mode is drawn: text,
+//   lores and hires, full and mixed, both pages, AN3 and, on the IIe, 80
+//   columns, the alternate character set and double lores and hires.
+// * The machine then runs VIDEO_TEST_MIXBUFFERNUM buffers, toggling a
+//   random soft switch before each one, so that modes change mid-frame.
+// * Every posted frame is added to the digest byte by byte. The expected
+//   digests were recorded with the draw routines as they were before
+//   spans were drawn with wide segment copies, and before the IIe looked
+//   up its character ROM through per-row tables.
+// * The dirty check shows a cleared hires page, where nothing flashes,
+//   and runs VIDEO_TEST_IDLEBUFFERNUM buffers, which must post no frame.
+//   A byte is then written on hires line 0, and later on line 1: each
+//   write must post one frame, whose dirty rect, read back from the
+//   headless canvas, covers only that line's row.
+
+#define VIDEO_TEST_SAMPLERATE       48000
+#define VIDEO_TEST_FRAMESPERBUFFER  64
+#define VIDEO_TEST_BOOTBUFFERNUM    500
+#define VIDEO_TEST_MODEBUFFERNUM    200
+#define VIDEO_TEST_MIXBUFFERNUM     2000
+#define VIDEO_TEST_SWITCHNUM        6
+#define VIDEO_TEST_IDLEBUFFERNUM    50
+
+typedef struct
+{
+    string templateName;
+    string device;
+    bool isIIe;
+    OELong digest;
+} VideoTestMachine;
+
+static VideoTestMachine videoTestMachines[] =
+{
+    {"Apple II/Apple II plus", "appleIIplus", false, 0xa7cc69164336c2b6ULL},
+    {"Apple II/Apple IIe", "appleIIe", true, 0xa11f39deb9b8d207ULL},
+    {"Apple II/Apple IIe Enhanced", "appleIIe", true, 0x720701d20ee46795ULL},
+};
+
+#define VIDEO_TEST_MACHINENUM (sizeof(videoTestMachines) / sizeof(VideoTestMachine))
+
+// Soft switches are written first, then read; lists end with zero
+
+typedef struct
+{
+    bool isIIe;
+    OEAddress writeSwitches[VIDEO_TEST_SWITCHNUM];
+    OEAddress readSwitches[VIDEO_TEST_SWITCHNUM];
+} VideoTestMode;
+
+static VideoTestMode videoTestModes[] =
+{
+    {false, {0}, {0xc051, 0xc054, 0}},
+    {false, {0}, {0xc051, 0xc055, 0}},
+    {false, {0}, {0xc050, 0xc052, 0xc056, 0xc054, 0}},
+    {false, {0}, {0xc050, 0xc053, 0xc056, 0}},
+    {false, {0}, {0xc050, 0xc052, 0xc057, 0xc054, 0}},
+    {false, {0}, {0xc050, 0xc053, 0xc057, 0xc055, 0}},
+    {false, {0}, {0xc050, 0xc052, 0xc057, 0xc054, 0xc05e, 0}},
+    {false, {0}, {0xc050, 0xc052, 0xc057, 0xc054, 0xc05f, 0}},
+    {true, {0xc00d, 0}, {0xc051, 0xc054, 0}},
+    {true, {0xc00d, 0xc00f, 0}, {0xc051, 0}},
+    {true, {0xc00e, 0xc00c, 0}, {0xc051, 0}},
+    {true, {0xc00d, 0}, {0xc050, 0xc052, 0xc056, 0xc05e, 0}},
+    {true, {0xc00d, 0}, {0xc050, 0xc053, 0xc056, 0xc05e, 0}},
+    {true, {0xc00d, 0}, {0xc050, 0xc052, 0xc057, 0xc05e, 0}},
+    {true, {0xc00d, 0}, {0xc050, 0xc053, 0xc057, 0xc05e, 0}},
+    {true, {0xc00c, 0}, {0xc050, 0xc052, 0xc057, 0xc05e, 0}},
+    {true, {0xc00c, 0}, {0xc050, 0xc052, 0xc057, 0xc05f, 0}},
+};
+
+#define VIDEO_TEST_MODENUM (sizeof(videoTestModes) / sizeof(VideoTestMode))
+
+static OELong videoTestDigest;
+static HeadlessCanvas *videoTestDisplayCanvas;
+
+class VideoTestCanvas : public HeadlessCanvas
+{
+public:
+    VideoTestCanvas(OECanvasType canvasType) : HeadlessCanvas(canvasType)
+    {
+    }
+    
+    bool postMessage(OEComponent *sender, int message, void *data)
+    {
+        if (message == CANVAS_POST_IMAGE)
+        {
+            OEImage *image = (OEImage *)data;
+            OESize size = image->getSize();
+            
+            videoTestDigest = getTestHash(videoTestDigest, image->getPixels(),
+                                          (size_t) size.height * image->getBytesPerRow());
+        }
+        
+        return HeadlessCanvas::postMessage(sender, message, data);
+    }
+};
+
+static OEComponent *constructVideoTestCanvas(void *userData,
+                                             OEComponent *device,
+                                             OECanvasType canvasType)
+{
+    VideoTestCanvas *canvas = new VideoTestCanvas(canvasType);
+    
+    // The machine's own monitor is constructed before card monitors
+    if ((canvasType == OECANVAS_DISPLAY) && !videoTestDisplayCanvas)
+        videoTestDisplayCanvas = canvas;
+    
+    return canvas;
+}
+
+static void destroyVideoTestCanvas(void *userData, OEComponent *canvas)
+{
+    delete (VideoTestCanvas *)canvas;
+}
+
+static void fillVideoTestMemory(OEComponent *memoryBus, OEInt& seed)
+{
+    for (OEAddress address = 0x400; address < 0xc00; address++)
+        memoryBus->write(address, getTestRandom(seed));
+    for (OEAddress address = 0x2000; address < 0x6000; address++)
+        memoryBus->write(address, getTestRandom(seed));
+}
+
+static bool runVideoTest(string resourcePath, VideoTestMachine& machine)
+{
+    HeadlessAudio audio;
+    
+    audio.setSampleRate(VIDEO_TEST_SAMPLERATE);
+    audio.setFramesPerBuffer(VIDEO_TEST_FRAMESPERBUFFER);
+    
+    OEEmulation *emulation = openTestEmulation(resourcePath, machine.templateName, &audio,
+                                               constructVideoTestCanvas,
+                                               destroyVideoTestCanvas);
+    
+    if (!emulation)
+        return false;
+    
+    OEComponent *memoryBus = emulation->getComponent(machine.device + ".memoryBus");
+    
+    if (!memoryBus)
+    {
+        cerr << "oetest: video: " << machine.templateName << " has no " <<
+        machine.device << " memoryBus" << endl;
+        
+        delete emulation;
+        
+        return false;
+    }
+    
+    audio.runEmulations(VIDEO_TEST_BOOTBUFFERNUM);
+    
+    OEInt seed = 1;
+    
+    videoTestDigest = 0xcbf29ce484222325ULL;
+    
+    for (OEInt i = 0; i < VIDEO_TEST_MODENUM; i++)
+    {
+        VideoTestMode& mode = videoTestModes[i];
+        
+        if (mode.isIIe && !machine.isIIe)
+            continue;
+        
+        if (machine.isIIe)
+        {
+            // Write auxiliary memory through RAMWRT
+            memoryBus->write(0xc005, 0);
+            fillVideoTestMemory(memoryBus, seed);
+            memoryBus->write(0xc004, 0);
+        }
+        
+        fillVideoTestMemory(memoryBus, seed);
+        
+        for (OEInt j = 0; mode.writeSwitches[j]; j++)
+            memoryBus->write(mode.writeSwitches[j], 0);
+        for (OEInt j = 0; mode.readSwitches[j]; j++)
+            memoryBus->read(mode.readSwitches[j]);
+        
+        audio.runEmulations(VIDEO_TEST_MODEBUFFERNUM);
+    }
+    
+    for (OEInt i = 0; i < VIDEO_TEST_MIXBUFFERNUM; i++)
+    {
+        OEInt value = getTestRandom(seed) % (machine.isIIe ? 12 : 8);
+        
+        if (value < 8)
+            memoryBus->read(0xc050 + value);
+        else if (value < 10)
+            memoryBus->read(0xc05e + (value & 1));
+        else
+            memoryBus->write(0xc00c + (value & 1), 0);
+        
+        audio.runEmulations(1);
+    }
+    
+    delete emulation;
+    
+    return checkTestDigest("video " + machine.templateName, videoTestDigest, machine.digest);
+}
+
+static bool checkVideoDirtyFrame(VideoTestMachine& machine, OELong frameCount,
+                                 OERect dirtyRect, string state)
+{
+    OELong postedNum = videoTestDisplayCanvas->getFrameCount() - frameCount;
+    OERect postedRect = videoTestDisplayCanvas->getDirtyRect();
+    
+    if (postedNum != 1)
+    {
+        cerr << "oetest: video: " << machine.templateName << " posted " <<
+        postedNum << " frames " << state << endl;
+        
+        return false;
+    }
+    
+    if ((postedRect.size.height != dirtyRect.size.height) ||
+        (postedRect.origin.y != dirtyRect.origin.y))
+    {
+        cerr << "oetest: video: " << machine.templateName << " dirty rows " <<
+        postedRect.origin.y << "+" << postedRect.size.height << " " << state <<
+        ", expected " << dirtyRect.origin.y << "+" << dirtyRect.size.height << endl;
+        
+        return false;
+    }
+    
+    return true;
+}
+
+static bool runVideoDirtyTest(string resourcePath, VideoTestMachine& machine)
+{
+    HeadlessAudio audio;
+    
+    audio.setSampleRate(VIDEO_TEST_SAMPLERATE);
+    audio.setFramesPerBuffer(VIDEO_TEST_FRAMESPERBUFFER);
+    
+    videoTestDisplayCanvas = NULL;
+    
+    OEEmulation *emulation = openTestEmulation(resourcePath, machine.templateName, &audio,
+                                               constructVideoTestCanvas,
+                                               destroyVideoTestCanvas);
+    
+    if (!emulation)
+        return false;
+    
+    OEComponent *memoryBus = emulation->getComponent(machine.device + ".memoryBus");
+    
+    if (!memoryBus || !videoTestDisplayCanvas)
+    {
+        cerr << "oetest: video: " << machine.templateName << " has no " <<
+        machine.device << " memoryBus or display canvas" << endl;
+        
+        delete emulation;
+        
+        return false;
+    }
+    
+    audio.runEmulations(VIDEO_TEST_BOOTBUFFERNUM);
+    
+    for (OEAddress address = 0x2000; address < 0x4000; address++)
+        memoryBus->write(address, 0);
+    
+    memoryBus->read(0xc050);
+    memoryBus->read(0xc052);
+    memoryBus->read(0xc054);
+    memoryBus->read(0xc057);
+    
+    audio.runEmulations(VIDEO_TEST_IDLEBUFFERNUM);
+    
+    bool success = true;
+    
+    // An idle frame is not posted
+    OELong frameCount = videoTestDisplayCanvas->getFrameCount();
+    
+    audio.runEmulations(VIDEO_TEST_IDLEBUFFERNUM);
+    
+    if (videoTestDisplayCanvas->getFrameCount() != frameCount)
+    {
+        cerr << "oetest: video: " << machine.templateName << " posted " <<
+        (videoTestDisplayCanvas->getFrameCount() - frameCount) <<
+        " idle frames" << endl;
+        
+        success = false;
+    }
+    
+    // A one line change posts that line's row
+    memoryBus->write(0x2000, 0x7f);
+    
+    audio.runEmulations(VIDEO_TEST_IDLEBUFFERNUM);
+    
+    OERect dirtyRect = videoTestDisplayCanvas->getDirtyRect();
+    
+    dirtyRect.size.height = 1;
+    
+    success &= checkVideoDirtyFrame(machine, frameCount, dirtyRect, "after a line 0 change");
+    
+    frameCount = videoTestDisplayCanvas->getFrameCount();
+    
+    memoryBus->write(0x2400, 0x7f);
+    
+    audio.runEmulations(VIDEO_TEST_IDLEBUFFERNUM);
+    
+    dirtyRect.origin.y++;
+    
+    success &= checkVideoDirtyFrame(machine, frameCount, dirtyRect, "after a line 1 change");
+    
+    delete emulation;
+    
+    return success;
+}
+
+bool testVideo(string resourcePath, vector<string>& args)
+{
+    bool success = true;
+    
+    for (OEInt i = 0; i < VIDEO_TEST_MACHINENUM; i++)
+    {
+        success &= runVideoTest(resourcePath, videoTestMachines[i]);
+        success &= runVideoDirtyTest(resourcePath, videoTestMachines[i]);
+    }
+    
+    return success;
+}
@@ -0,0 +1,716 @@
+
+/**
+ * oetest
+ * W65C816S test
+ * (C) 2012 by Marc S. Ressl (mressl@umich.edu)
+ * Released under the GPL
+ *
+ * Checks modes, block moves, interrupts and cycle counts of the W65C816S
+ */
+
+#include <iostream>
+
+#include "oetest.h"
+
+#include "util.h"
+
+#include "HeadlessAudio.h"
+
+#include "ControlBus.h"
+#include "RAM.h"
+#include "W65C816S.h"
+#include "CPUInterface.h"
+
+// Notes:
+// * The core runs on a 16 MB RAM, so that every bank is backed. Each
+//   check loads a short program at W65C816S_TEST_PROGRAM, points the
+//   reset vector at it and resets the core through the control bus.
+// * The core is run one instruction at a time: a slice of one cycle ends
+//   after the instruction that started in it. The cycles of each
+//   instruction, interrupt entries included, are checked against the
+//   W65C816S datasheet.
+// * IRQs and NMIs are asserted through the control bus between
+//   instructions, as the devices of a machine would.
+
+#define W65C816S_TEST_CLOCKFREQUENCY    "4000000"
+#define W65C816S_TEST_RAMSIZE           "0x1000000"
+#define W65C816S_TEST_PROGRAM           0x1000
+#define W65C816S_TEST_HANDLER           0x3000
+#define W65C816S_TEST_STEPNUM           1000
+
+#define W65C816S_TEST_COP_VECTOR_N      0xffe4
+#define W65C816S_TEST_BRK_VECTOR_N      0xffe6
+#define W65C816S_TEST_NMI_VECTOR_N      0xffea
+#define W65C816S_TEST_IRQ_VECTOR_N      0xffee
+#define W65C816S_TEST_COP_VECTOR_E      0xfff4
+#define W65C816S_TEST_NMI_VECTOR_E      0xfffa
+#define W65C816S_TEST_RST_VECTOR_E      0xfffc
+#define W65C816S_TEST_IRQ_VECTOR_E      0xfffe
+
+#define W65C816S_TEST_F_C               0x01
+#define W65C816S_TEST_F_I               0x04
+#define W65C816S_TEST_F_D               0x08
+#define W65C816S_TEST_F_X               0x10
+#define W65C816S_TEST_F_M               0x20
+
+class W65C816STestDevice : public OEComponent
+{
+public:
+    bool postMessage(OEComponent *sender, int message, void *data)
+    {
+        return true;
+    }
+};
+
+// Runs a program on a W65C816S over a plain RAM
+
+class W65C816STestRig
+{
+public:
+    W65C816STestRig(string name)
+    {
+        this->name = name;
+        
+        isOpen = false;
+        success = true;
+    }
+    
+    ~W65C816STestRig()
+    {
+        if (isOpen)
+            controlBus.dispose();
+    }
+    
+    bool open(const OEChar *program, OEInt size)
+    {
+        ram.setValue("size", W65C816S_TEST_RAMSIZE);
+        
+        if (!ram.init())
+            return false;
+        
+        load(W65C816S_TEST_PROGRAM, program, size);
+        
+        write16(W65C816S_TEST_RST_VECTOR_E, W65C816S_TEST_PROGRAM);
+        
+        controlBus.setValue("clockFrequency", W65C816S_TEST_CLOCKFREQUENCY);
+        controlBus.setValue("powerState", "S0");
+        controlBus.setValue("resetOnPowerOn", "0");
+        controlBus.setRef("device", &device);
+        controlBus.setRef("audio", &audio);
+        controlBus.setRef("cpu", &cpu);
+        
+        cpu.setRef("controlBus", &controlBus);
+        cpu.setRef("memoryBus", &ram);
+        
+        if (!cpu.init() || !controlBus.init())
+            return false;
+        
+        isOpen = true;
+        
+        controlBus.postMessage(NULL, CONTROLBUS_ASSERT_RESET, NULL);
+        controlBus.postMessage(NULL, CONTROLBUS_CLEAR_RESET, NULL);
+        
+        return checkStep("reset", 7);
+    }
+    
+    void load(OEAddress address, const OEChar *data, OEInt size)
+    {
+        for (OEInt i = 0; i < size; i++)
+            ram.write(address + i, data[i]);
+    }
+    
+    void write16(OEAddress address, OEInt value)
+    {
+        ram.write(address, value);
+        ram.write(address + 1, value >> 8);
+    }
+    
+    OEChar read(OEAddress address)
+    {
+        return ram.read(address);
+    }
+    
+    OEInt get(string name)
+    {
+        string value;
+        
+        cpu.getValue(name, value);
+        
+        return getOEInt(value);
+    }
+    
+    void postControlBus(int message)
+    {
+        controlBus.postMessage(NULL, message, NULL);
+    }
+    
+    // Runs one instruction and returns its cycles
+    OEInt step()
+    {
+        OESLong pendingCycles = 1;
+        
+        cpu.postMessage(NULL, CPU_SET_PENDINGCYCLES, &pendingCycles);
+        cpu.postMessage(NULL, CPU_RUN, NULL);
+        cpu.postMessage(NULL, CPU_GET_PENDINGCYCLES, &pendingCycles);
+        
+        return (OEInt) (1 - pendingCycles);
+    }
+    
+    // Runs instructions until the program counter reaches pc
+    OEInt runTo(OEAddress pc)
+    {
+        OEInt cycles = 0;
+        
+        for (OEInt i = 0; (i < W65C816S_TEST_STEPNUM) && (get("pc") != pc); i++)
+            cycles += step();
+        
+        check(get("pc") == pc, "did not reach " + getHexString(pc));
+        
+        return cycles;
+    }
+    
+    bool checkStep(string what, OEInt cycles)
+    {
+        OEInt stepCycles = step();
+        
+        return check(stepCycles == cycles,
+                     what + " took " + getString(stepCycles) +
+                     " cycles, not " + getString(cycles));
+    }
+    
+    bool checkRunTo(OEAddress pc, OEInt cycles)
+    {
+        OEInt runCycles = runTo(pc);
+        
+        return check(runCycles == cycles,
+                     "run to " + getHexString(pc) + " took " + getString(runCycles) +
+                     " cycles, not " + getString(cycles));
+    }
+    
+    bool checkRegister(string registerName, OEInt value)
+    {
+        OEInt registerValue = get(registerName);
+        
+        return check(registerValue == value,
+                     registerName + " is " + getHexString(registerValue) +
+                     ", not " + getHexString(value));
+    }
+    
+    bool checkMemory(OEAddress address, OEChar value)
+    {
+        OEChar memoryValue = read(address);
+        
+        return check(memoryValue == value,
+                     "memory at " + getHexString(address) + " is " +
+                     getHexString(memoryValue) + ", not " + getHexString(value));
+    }
+    
+    bool check(bool condition, string message)
+    {
+        if (!condition)
+        {
+            cerr << "oetest: w65c816s: " << name << ": " << message << endl;
+            
+            success = false;
+        }
+        
+        return condition;
+    }
+    
+    bool isSuccess()
+    {
+        return success;
+    }
+    
+private:
+    string name;
+    bool isOpen;
+    bool success;
+    
+    ControlBus controlBus;
+    W65C816STestDevice device;
+    HeadlessAudio audio;
+    W65C816S cpu;
+    RAM ram;
+};
+
+// Emulation and native modes, and register widths on REP, SEP and XCE
+
+static const OEChar w65c816sTestModeProgram[] =
+{
+    0x18,                   // 1000: CLC
+    0xfb,                   // 1001: XCE
+    0xc2, 0x30,             // 1002: REP #$30
+    0xa9, 0x34, 0x12,       // 1004: LDA #$1234
+    0xa2, 0xcd, 0xab,       // 1007: LDX #$ABCD
+    0xe2, 0x20,             // 100a: SEP #$20
+    0xa9, 0x56,             // 100c: LDA #$56
+    0xe2, 0x10,             // 100e: SEP #$10
+    0xc2, 0x10,             // 1010: REP #$10
+    0xa0, 0x78, 0x56,       // 1012: LDY #$5678
+    0x38,                   // 1015: SEC
+    0xfb,                   // 1016: XCE
+    0xc2, 0x30,             // 1017: REP #$30
+    0xdb,                   // 1019: STP
+};
+
+static bool checkW65C816SModes()
+{
+    W65C816STestRig rig("modes");
+    
+    if (!rig.open(w65c816sTestModeProgram, sizeof(w65c816sTestModeProgram)))
+        return rig.check(false, "could not open");
+    
+    rig.checkRegister("e", 1);
+    rig.checkRegister("p", W65C816S_TEST_F_M | W65C816S_TEST_F_X | W65C816S_TEST_F_I);
+    
+    // CLC; XCE
+    rig.checkStep("CLC", 2);
+    rig.checkStep("XCE", 2);
+    rig.checkRegister("e", 0);
+    rig.checkRegister("p", (W65C816S_TEST_F_M | W65C816S_TEST_F_X | W65C816S_TEST_F_I |
+                            W65C816S_TEST_F_C));
+    
+    // REP #$30; LDA #$1234; LDX #$ABCD
+    rig.checkStep("REP", 3);
+    rig.checkStep("LDA # (16 bits)", 3);
+    rig.checkStep("LDX # (16 bits)", 3);
+    rig.checkRegister("a", 0x1234);
+    rig.checkRegister("x", 0xabcd);
+    
+    // SEP #$20; LDA #$56 keeps B
+    rig.checkStep("SEP", 3);
+    rig.checkStep("LDA # (8 bits)", 2);
+    rig.checkRegister("a", 0x1256);
+    
+    // SEP #$10 clears the high bytes of the index registers
+    rig.checkStep("SEP", 3);
+    rig.checkRegister("x", 0x00cd);
+    
+    // REP #$10; LDY #$5678
+    rig.checkStep("REP", 3);
+    rig.checkStep("LDY # (16 bits)", 3);
+    rig.checkRegister("y", 0x5678);
+    
+    // SEC; XCE back to emulation forces M and X, and the stack page
+    rig.checkStep("SEC", 2);
+    rig.checkStep("XCE", 2);
+    rig.checkRegister("e", 1);
+    rig.checkRegister("y", 0x0078);
+    rig.checkRegister("s", 0x01ff);
+    rig.checkRegister("a", 0x1256);
+    
+    // REP #$30 can not clear M and X in emulation mode
+    rig.checkStep("REP", 3);
+    rig.checkRegister("p", (W65C816S_TEST_F_M | W65C816S_TEST_F_X | W65C816S_TEST_F_I));
+    
+    return rig.isSuccess();
+}
+
+// Cycle counts that depend on the mode and the direct page
+
+static const OEChar w65c816sTestCycleProgram[] =
+{
+    0xa9, 0x01,             // 1000: LDA #$01
+    0xa5, 0x10,             // 1002: LDA $10
+    0xa2, 0xff,             // 1004: LDX #$FF
+    0xbd, 0x01, 0x20,       // 1006: LDA $2001,X
+    0xbd, 0x00, 0x20,       // 1009: LDA $2000,X
+    0x18,                   // 100c: CLC
+    0xfb,                   // 100d: XCE
+    0xc2, 0x20,             // 100e: REP #$20
+    0xa5, 0x10,             // 1010: LDA $10
+    0xa9, 0x01, 0x00,       // 1012: LDA #$0001
+    0x5b,                   // 1015: TCD
+    0xa5, 0x10,             // 1016: LDA $10
+    0x22, 0x00, 0x00, 0x02, // 1018: JSL $020000
+    0xea,                   // 101c: NOP
+    0xdb,                   // 101d: STP
+};
+
+static const OEChar w65c816sTestCycleSubroutine[] =
+{
+    0x6b,                   // 020000: RTL
+};
+
+static bool checkW65C816SCycles()
+{
+    W65C816STestRig rig("cycles");
+    
+    if (!rig.open(w65c816sTestCycleProgram, sizeof(w65c816sTestCycleProgram)))
+        return rig.check(false, "could not open");
+    
+    rig.load(0x020000, w65c816sTestCycleSubroutine, sizeof(w65c816sTestCycleSubroutine));
+    rig.write16(0x0010, 0x5aa5);
+    rig.write16(0x0011, 0x3cc3);
+    
+    rig.checkStep("LDA # (8 bits)", 2);
+    rig.checkStep("LDA dp (8 bits)", 3);
+    rig.checkRegister("a", 0x00a5);
+    rig.checkStep("LDX #", 2);
+    rig.checkStep("LDA abs,X across a page", 5);
+    rig.checkStep("LDA abs,X within a page", 4);
+    rig.checkStep("CLC", 2);
+    rig.checkStep("XCE", 2);
+    rig.checkStep("REP", 3);
+    rig.checkStep("LDA dp (16 bits)", 4);
+    rig.checkRegister("a", 0xc3a5);
+    rig.checkStep("LDA # (16 bits)", 3);
+    rig.checkStep("TCD", 2);
+    rig.checkRegister("d", 0x0001);
+    rig.checkStep("LDA dp (16 bits, DL not 0)", 5);
+    rig.checkRegister("a", 0x3cc3);
+    rig.checkStep("JSL", 8);
+    rig.checkRegister("pbr", 0x02);
+    rig.checkRegister("pc", 0x0000);
+    rig.checkStep("RTL", 6);
+    rig.checkRegister("pbr", 0x00);
+    rig.checkRegister("pc", 0x101c);
+    rig.checkStep("NOP", 2);
+    
+    return rig.isSuccess();
+}
+
+// MVN and MVP move one byte per execution, 7 cycles each
+
+static const OEChar w65c816sTestBlockMoveProgram[] =
+{
+    0x18,                   // 1000: CLC
+    0xfb,                   // 1001: XCE
+    0xc2, 0x30,             // 1002: REP #$30
+    0xa9, 0x04, 0x00,       // 1004: LDA #$0004
+    0xa2, 0x00, 0x20,       // 1007: LDX #$2000
+    0xa0, 0x00, 0x30,       // 100a: LDY #$3000
+    0x54, 0x01, 0x00,       // 100d: MVN $01,$00
+    0xa9, 0x02, 0x00,       // 1010: LDA #$0002
+    0xa2, 0x04, 0x20,       // 1013: LDX #$2004
+    0xa0, 0x02, 0x40,       // 1016: LDY #$4002
+    0x44, 0x00, 0x00,       // 1019: MVP $00,$00
+    0x38,                   // 101c: SEC
+    0xfb,                   // 101d: XCE
+    0xa9, 0x00,             // 101e: LDA #$00
+    0xeb,                   // 1020: XBA
+    0xa9, 0x01,             // 1021: LDA #$01
+    0xa2, 0xff,             // 1023: LDX #$FF
+    0xa0, 0x50,             // 1025: LDY #$50
+    0x54, 0x00, 0x00,       // 1027: MVN $00,$00
+    0xdb,                   // 102a: STP
+};
+
+static const OEChar w65c816sTestBlockMoveData[] =
+{
+    0x11, 0x22, 0x33, 0x44, 0x55,
+};
+
+static bool checkW65C816SBlockMoves()
+{
+    W65C816STestRig rig("block moves");
+    
+    if (!rig.open(w65c816sTestBlockMoveProgram, sizeof(w65c816sTestBlockMoveProgram)))
+        return rig.check(false, "could not open");
+    
+    rig.load(0x2000, w65c816sTestBlockMoveData, sizeof(w65c816sTestBlockMoveData));
+    
+    // MVN $01,$00 with 16-bit index registers
+    rig.runTo(0x100d);
+    rig.checkStep("MVN (first byte)", 7);
+    rig.checkRegister("pc", 0x100d);
+    rig.checkRegister("dbr", 0x01);
+    rig.checkRunTo(0x1010, 4 * 7);
+    rig.checkRegister("a", 0xffff);
+    rig.checkRegister("x", 0x2005);
+    rig.checkRegister("y", 0x3005);
+    
+    for (OEInt i = 0; i < 5; i++)
+        rig.checkMemory(0x013000 + i, 0x11 * (i + 1));
+    
+    rig.checkMemory(0x3000, 0x00);
+    
+    // MVP $00,$00 moves down
+    rig.checkRunTo(0x1019, 9);
+    rig.checkRunTo(0x101c, 3 * 7);
+    rig.checkRegister("a", 0xffff);
+    rig.checkRegister("x", 0x2001);
+    rig.checkRegister("y", 0x3fff);
+    rig.checkRegister("dbr", 0x00);
+    rig.checkMemory(0x4000, 0x33);
+    rig.checkMemory(0x4001, 0x44);
+    rig.checkMemory(0x4002, 0x55);
+    
+    // MVN in emulation mode wraps the 8-bit index registers
+    rig.runTo(0x1027);
+    rig.write16(0x00ff, 0x00a5);
+    rig.checkRunTo(0x102a, 2 * 7);
+    rig.checkRegister("x", 0x0001);
+    rig.checkRegister("y", 0x0052);
+    rig.checkMemory(0x0050, 0xa5);
+    
+    return rig.isSuccess();
+}
+
+// WAI waits for an IRQ; with I set it resumes without taking it
+
+static const OEChar w65c816sTestWaitProgram[] =
+{
+    0x58,                   // 1000: CLI
+    0xcb,                   // 1001: WAI
+    0xa9, 0x01,             // 1002: LDA #$01
+    0x78,                   // 1004: SEI
+    0x18,                   // 1005: CLC
+    0xfb,                   // 1006: XCE
+    0xcb,                   // 1007: WAI
+    0xa9, 0x09,             // 1008: LDA #$09
+    0x58,                   // 100a: CLI
+    0xcb,                   // 100b: WAI
+    0xa9, 0x02,             // 100c: LDA #$02
+    0xdb,                   // 100e: STP
+};
+
+static const OEChar w65c816sTestWaitHandler[] =
+{
+    0xe6, 0x40,             // 3000: INC $40
+    0x40,                   // 3002: RTI
+};
+
+static bool checkW65C816SWait()
+{
+    W65C816STestRig rig("WAI");
+    
+    if (!rig.open(w65c816sTestWaitProgram, sizeof(w65c816sTestWaitProgram)))
+        return rig.check(false, "could not open");
+    
+    rig.load(W65C816S_TEST_HANDLER, w65c816sTestWaitHandler, sizeof(w65c816sTestWaitHandler));
+    rig.write16(W65C816S_TEST_IRQ_VECTOR_E, W65C816S_TEST_HANDLER);
+    rig.write16(W65C816S_TEST_IRQ_VECTOR_N, W65C816S_TEST_HANDLER);
+    
+    // Emulation mode
+    rig.checkStep("CLI", 2);
+    rig.checkStep("WAI", 3);
+    
+    for (OEInt i = 0; i < 10; i++)
+        rig.step();
+    
+    rig.checkRegister("pc", 0x1002);
+    
+    rig.postControlBus(CONTROLBUS_ASSERT_IRQ);
+    rig.checkStep("IRQ (emulation)", 7);
+    rig.postControlBus(CONTROLBUS_CLEAR_IRQ);
+    
+    rig.checkRegister("pc", W65C816S_TEST_HANDLER);
+    rig.checkRegister("s", 0x01fc);
+    rig.checkMemory(0x01ff, 0x10);
+    rig.checkMemory(0x01fe, 0x02);
+    rig.check(!(rig.read(0x01fd) & W65C816S_TEST_F_X), "IRQ pushed P with B set");
+    
+    rig.checkStep("INC dp", 5);
+    rig.checkStep("RTI (emulation)", 6);
+    rig.checkRegister("pc", 0x1002);
+    rig.checkMemory(0x0040, 0x01);
+    
+    // Native mode, I set: WAI resumes at the next instruction
+    rig.runTo(0x1007);
+    rig.checkStep("WAI", 3);
+    rig.step();
+    rig.checkRegister("pc", 0x1008);
+    
+    rig.postControlBus(CONTROLBUS_ASSERT_IRQ);
+    rig.checkStep("LDA # after WAI", 2);
+    rig.checkRegister("a", 0x0009);
+    rig.checkMemory(0x0040, 0x01);
+    
+    // Native mode, I clear: the IRQ still asserted is taken after CLI
+    rig.checkStep("CLI", 2);
+    rig.checkStep("IRQ (native)", 8);
+    rig.postControlBus(CONTROLBUS_CLEAR_IRQ);
+    
+    rig.checkRegister("pc", W65C816S_TEST_HANDLER);
+    rig.checkRegister("s", 0x01fb);
+    rig.checkMemory(0x01ff, 0x00);
+    rig.checkMemory(0x01fe, 0x10);
+    rig.checkMemory(0x01fd, 0x0b);
+    
+    rig.checkStep("INC dp", 5);
+    rig.checkStep("RTI (native)", 7);
+    rig.checkRegister("pc", 0x100b);
+    rig.checkMemory(0x0040, 0x02);
+    
+    rig.checkStep("WAI", 3);
+    rig.step();
+    rig.checkRegister("pc", 0x100c);
+    
+    rig.postControlBus(CONTROLBUS_ASSERT_IRQ);
+    rig.checkStep("IRQ (native)", 8);
+    rig.postControlBus(CONTROLBUS_CLEAR_IRQ);
+    rig.checkRunTo(0x100c, 5 + 7);
+    rig.checkStep("LDA # after WAI", 2);
+    rig.checkRegister("a", 0x0002);
+    rig.checkMemory(0x0040, 0x03);
+    
+    return rig.isSuccess();
+}
+
+// BRK and COP take their own vectors in each mode
+
+typedef struct
+{
+    string name;
+    OEChar opcode;
+    bool isNative;
+    OEAddress vector;
+    OEInt cycles;
+} W65C816STestInterrupt;
+
+static W65C816STestInterrupt w65c816sTestInterrupts[] =
+{
+    {"BRK (emulation)", 0x00, false, W65C816S_TEST_IRQ_VECTOR_E, 7},
+    {"COP (emulation)", 0x02, false, W65C816S_TEST_COP_VECTOR_E, 7},
+    {"BRK (native)", 0x00, true, W65C816S_TEST_BRK_VECTOR_N, 8},
+    {"COP (native)", 0x02, true, W65C816S_TEST_COP_VECTOR_N, 8},
+};
+
+#define W65C816S_TEST_INTERRUPTNUM (sizeof(w65c816sTestInterrupts) / sizeof(W65C816STestInterrupt))
+
+static const OEInt w65c816sTestVectors[] =
+{
+    W65C816S_TEST_COP_VECTOR_N,
+    W65C816S_TEST_BRK_VECTOR_N,
+    W65C816S_TEST_NMI_VECTOR_N,
+    W65C816S_TEST_IRQ_VECTOR_N,
+    W65C816S_TEST_COP_VECTOR_E,
+    W65C816S_TEST_NMI_VECTOR_E,
+    W65C816S_TEST_IRQ_VECTOR_E,
+};
+
+#define W65C816S_TEST_VECTORNUM (sizeof(w65c816sTestVectors) / sizeof(OEInt))
+
+static bool checkW65C816SInterrupt(W65C816STestInterrupt& interrupt)
+{
+    W65C816STestRig rig(interrupt.name);
+    
+    // SED; CLC; XCE (or NOP); JML $020000
+    OEChar program[] =
+    {
+        0xf8,
+        0x18,
+        (OEChar) (interrupt.isNative ? 0xfb : 0xea),
+        0x5c, 0x00, 0x00, 0x02,
+    };
+    
+    // BRK or COP with signature; STP
+    OEChar caller[] = {interrupt.opcode, 0x5a, 0xdb};
+    
+    // RTI
+    OEChar handler[] = {0x40};
+    
+    if (!rig.open(program, sizeof(program)))
+        return rig.check(false, "could not open");
+    
+    rig.load(0x020000, caller, sizeof(caller));
+    
+    // Each vector points to its own handler
+    for (OEInt i = 0; i < W65C816S_TEST_VECTORNUM; i++)
+    {
+        OEAddress handlerAddress = W65C816S_TEST_HANDLER + 0x10 * i;
+        
+        rig.write16(w65c816sTestVectors[i], handlerAddress);
+        rig.load(handlerAddress, handler, sizeof(handler));
+    }
+    
+    rig.runTo(0x0000);
+    
+    if (!rig.check(rig.get("pbr") == 0x02, "JML did not reach bank 2"))
+        return false;
+    
+    OEInt p = rig.get("p");
+    
+    rig.checkStep(interrupt.name, interrupt.cycles);
+    
+    OEInt handlerAddress = rig.get("pc");
+    
+    rig.check(handlerAddress == (OEInt) (rig.read(interrupt.vector) |
+                                         (rig.read(interrupt.vector + 1) << 8)),
+              "took the vector to " + getHexString(handlerAddress));
+    rig.checkRegister("pbr", 0x00);
+    rig.check(rig.get("p") & W65C816S_TEST_F_I, "I not set");
+    rig.check(!(rig.get("p") & W65C816S_TEST_F_D), "D not cleared");
+    
+    // The return address skips the signature byte
+    if (interrupt.isNative)
+    {
+        rig.checkRegister("s", 0x01fb);
+        rig.checkMemory(0x01ff, 0x02);
+        rig.checkMemory(0x01fe, 0x00);
+        rig.checkMemory(0x01fd, 0x02);
+        rig.checkMemory(0x01fc, p);
+    }
+    else
+    {
+        rig.checkRegister("s", 0x01fc);
+        rig.checkMemory(0x01ff, 0x00);
+        rig.checkMemory(0x01fe, 0x02);
+        rig.checkMemory(0x01fd, p | W65C816S_TEST_F_X);
+    }
+    
+    rig.checkStep("RTI", interrupt.isNative ? 7 : 6);
+    rig.checkRegister("pc", 0x0002);
+    rig.checkRegister("pbr", interrupt.isNative ? 0x02 : 0x00);
+    rig.checkRegister("p", p);
+    
+    return rig.isSuccess();
+}
+
+// An NMI in native mode pushes the program bank
+
+static const OEChar w65c816sTestNMIProgram[] =
+{
+    0x18,                   // 1000: CLC
+    0xfb,                   // 1001: XCE
+    0x5c, 0x00, 0x00, 0x05, // 1002: JML $050000
+};
+
+static const OEChar w65c816sTestNMILoop[] =
+{
+    0x80, 0xfe,             // 050000: BRA 050000
+};
+
+static bool checkW65C816SNMI()
+{
+    W65C816STestRig rig("NMI");
+    
+    if (!rig.open(w65c816sTestNMIProgram, sizeof(w65c816sTestNMIProgram)))
+        return rig.check(false, "could not open");
+    
+    rig.load(0x050000, w65c816sTestNMILoop, sizeof(w65c816sTestNMILoop));
+    rig.write16(W65C816S_TEST_NMI_VECTOR_N, W65C816S_TEST_HANDLER);
+    
+    rig.runTo(0x0000);
+    rig.checkStep("BRA", 3);
+    
+    rig.postControlBus(CONTROLBUS_ASSERT_NMI);
+    rig.postControlBus(CONTROLBUS_CLEAR_NMI);
+    
+    rig.checkStep("NMI (native)", 8);
+    rig.checkRegister("pc", W65C816S_TEST_HANDLER);
+    rig.checkRegister("pbr", 0x00);
+    rig.checkMemory(0x01ff, 0x05);
+    rig.checkRegister("s", 0x01fb);
+    
+    return rig.isSuccess();
+}
+
+bool testW65C816S(string resourcePath, vector<string>& args)
+{
+    bool success = true;
+    
+    success &= checkW65C816SModes();
+    success &= checkW65C816SCycles();
+    success &= checkW65C816SBlockMoves();
+    success &= checkW65C816SWait();
+    
+    for (OEInt i = 0; i < W65C816S_TEST_INTERRUPTNUM; i++)
+        success &= checkW65C816SInterrupt(w65c816sTestInterrupts[i]);
+    
+    success &= checkW65C816SNMI();
+    
+    return success;
+}
@@ -0,0 +1,992 @@
+
+/**
+ * oetest
+ * Z80 test
+ * (C) 2012 by Marc S. Ressl (mressl@umich.edu)
+ * Released under the GPL
+ *
+ * Runs CP/M test programs, such as ZEXDOC and ZEXALL, on the Z80 core,
+ * and checks instructions and interrupts
+ */
+
+#include <stdio.h>
+#include <time.h>
+
+#include <iostream>
+
+#include "oetest.h"
+
+#include "util.h"
+
+#include "HeadlessAudio.h"
+
+#include "ControlBus.h"
+#include "RAM.h"
+#include "Z80.h"
+#include "CPUInterface.h"
+
+// Notes:
+// * Programs are loaded at 0x100, as CP/M .com files. BDOS calls through
+//   0x0005 reach an OUT (0),A at Z80_TEST_BDOS, which prints with
+//   functions 2 and 9; a jump to 0x0000 ends the program.
+// * Each program is run twice. The timed run executes slices of
+//   Z80_TEST_SLICE T-states; the counting run executes one instruction
+//   per slice to count instructions. Instructions per second are the
+//   counted instructions over the timed run's host time.
+// * The output of both runs must match, which also checks that the core
+//   resumes correctly at any slice boundary.
+// * Without arguments, a built-in program is run. It adds up a counter
+//   in a loop and prints the result through DAA, so that the harness and
+//   the core can be checked without the ZEX images.
+// * Without arguments, short programs are also run one instruction at a
+//   time, checking registers, flags and cycles of DAA, NEG, SBC HL, the
+//   block instructions, IX and IY, and IRQ and NMI entry against the
+//   Zilog Z80 user manual.
+
+#define Z80_TEST_CLOCKFREQUENCY "4000000"
+#define Z80_TEST_PROGRAM        0x100
+#define Z80_TEST_BDOS           0xfe00
+#define Z80_TEST_STACK          0xfdfe
+#define Z80_TEST_SLICE          1000000
+#define Z80_TEST_STEPNUM        1000
+
+#define Z80_TEST_F_C            0x01
+#define Z80_TEST_F_N            0x02
+#define Z80_TEST_F_PV           0x04
+#define Z80_TEST_F_H            0x10
+#define Z80_TEST_F_Z            0x40
+#define Z80_TEST_F_S            0x80
+#define Z80_TEST_F_DOCUMENTED   0xd7
+
+static const OEChar z80TestProgram[] =
+{
+    0x11, 0x44, 0x01,       // LD DE,message
+    0x0e, 0x09,             // LD C,9
+    0xcd, 0x05, 0x00,       // CALL 5
+    0x16, 0x10,             // LD D,16
+    0x01, 0x00, 0x00,       // LD BC,0
+    0x21, 0x00, 0x00,       // LD HL,0
+    0x09,                   // ADD HL,BC
+    0x03,                   // INC BC
+    0x78,                   // LD A,B
+    0xb1,                   // OR C
+    0x20, 0xfa,             // JR NZ,-6
+    0x15,                   // DEC D
+    0x20, 0xf1,             // JR NZ,-15
+    0x7c,                   // LD A,H
+    0xcd, 0x2c, 0x01,       // CALL printHex
+    0x7d,                   // LD A,L
+    0xcd, 0x2c, 0x01,       // CALL printHex
+    0x11, 0x50, 0x01,       // LD DE,newLine
+    0x0e, 0x09,             // LD C,9
+    0xcd, 0x05, 0x00,       // CALL 5
+    0xc3, 0x00, 0x00,       // JP 0
+    0xf5,                   // printHex: PUSH AF
+    0x0f, 0x0f, 0x0f, 0x0f, // RRCA (4 times)
+    0xcd, 0x35, 0x01,       // CALL printNibble
+    0xf1,                   // POP AF
+    0xe6, 0x0f,             // printNibble: AND 0x0f
+    0xc6, 0x90,             // ADD A,0x90
+    0x27,                   // DAA
+    0xce, 0x40,             // ADC A,0x40
+    0x27,                   // DAA
+    0x5f,                   // LD E,A
+    0x0e, 0x02,             // LD C,2
+    0xcd, 0x05, 0x00,       // CALL 5
+    0xc9,                   // RET
+    'Z', '8', '0', ' ', 't', 'e', 's', 't', ' ', '=', ' ', '$',
+    '\r', '\n', '$',
+};
+
+#define Z80_TEST_PROGRAMOUTPUT  "Z80 test = 8000\r\n"
+
+class Z80TestDevice : public OEComponent
+{
+public:
+    bool postMessage(OEComponent *sender, int message, void *data)
+    {
+        return true;
+    }
+};
+
+// Implements the BDOS and the warm boot through the I/O ports
+
+class Z80TestIO : public OEComponent
+{
+public:
+    Z80TestIO()
+    {
+        cpu = NULL;
+        memory = NULL;
+        isEchoed = false;
+        isDone = false;
+    }
+    
+    OEComponent *cpu;
+    OEComponent *memory;
+    bool isEchoed;
+    bool isDone;
+    string output;
+    
+    OEChar read(OEAddress address)
+    {
+        return 0xff;
+    }
+    
+    void write(OEAddress address, OEChar value)
+    {
+        if (address & 0xff)
+        {
+            OESLong pendingCycles = 0;
+            
+            cpu->postMessage(this, CPU_SET_PENDINGCYCLES, &pendingCycles);
+            
+            isDone = true;
+            
+            return;
+        }
+        
+        OEInt function = getRegister("bc") & 0xff;
+        OEInt de = getRegister("de");
+        
+        if (function == 2)
+            print(de & 0xff);
+        else if (function == 9)
+        {
+            for (OEInt i = 0; i < 0x10000; i++)
+            {
+                OEChar c = memory->read((de + i) & 0xffff);
+                
+                if (c == '$')
+                    break;
+                
+                print(c);
+            }
+        }
+    }
+    
+private:
+    OEInt getRegister(string name)
+    {
+        string value;
+        
+        cpu->getValue(name, value);
+        
+        return getOEInt(value);
+    }
+    
+    void print(OEChar c)
+    {
+        output += c;
+        
+        if (isEchoed)
+        {
+            putchar(c);
+            fflush(stdout);
+        }
+    }
+};
+
+static double getZ80TestTime()
+{
+    struct timespec ts;
+    
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return ts.tv_sec + ts.tv_nsec * 1E-9;
+}
+
+// Runs a program and returns its output
+
+static bool runZ80Program(const OEData& program, OESLong slice, bool isEchoed,
+                          string& output, OELong& cycles, OELong& instructions,
+                          double& time)
+{
+    ControlBus controlBus;
+    Z80TestDevice device;
+    HeadlessAudio audio;
+    Z80 cpu;
+    RAM ram;
+    Z80TestIO io;
+    
+    ram.setValue("size", "0x10000");
+    
+    if (!ram.init())
+        return false;
+    
+    OEChar boot[] = {0xd3, 0x01, 0x76, 0x00, 0x00, 0xc3, 0x00, 0xfe};
+    OEChar bdos[] = {0xd3, 0x00, 0xc9};
+    
+    for (OEInt i = 0; i < sizeof(boot); i++)
+        ram.write(i, boot[i]);
+    for (OEInt i = 0; i < sizeof(bdos); i++)
+        ram.write(Z80_TEST_BDOS + i, bdos[i]);
+    for (OEInt i = 0; i < program.size(); i++)
+        ram.write(Z80_TEST_PROGRAM + i, program[i]);
+    
+    io.cpu = &cpu;
+    io.memory = &ram;
+    io.isEchoed = isEchoed;
+    
+    controlBus.setValue("clockFrequency", Z80_TEST_CLOCKFREQUENCY);
+    controlBus.setValue("powerState", "S0");
+    controlBus.setValue("resetOnPowerOn", "0");
+    controlBus.setRef("device", &device);
+    controlBus.setRef("audio", &audio);
+    controlBus.setRef("cpu", &cpu);
+    
+    cpu.setRef("controlBus", &controlBus);
+    cpu.setRef("memoryBus", &ram);
+    cpu.setRef("ioBus", &io);
+    
+    if (!cpu.init() || !controlBus.init())
+        return false;
+    
+    cpu.setValue("pc", getHexString(Z80_TEST_PROGRAM));
+    cpu.setValue("sp", getHexString(Z80_TEST_STACK));
+    
+    double startTime = getZ80TestTime();
+    
+    cycles = 0;
+    instructions = 0;
+    
+    while (!io.isDone)
+    {
+        OESLong pendingCycles = slice;
+        
+        cpu.postMessage(NULL, CPU_SET_PENDINGCYCLES, &pendingCycles);
+        cpu.postMessage(NULL, CPU_RUN, NULL);
+        cpu.postMessage(NULL, CPU_GET_PENDINGCYCLES, &pendingCycles);
+        
+        cycles += slice - pendingCycles;
+        instructions++;
+    }
+    
+    time = getZ80TestTime() - startTime;
+    
+    if (time <= 0)
+        time = 1E-9;
+    
+    output = io.output;
+    
+    controlBus.dispose();
+    
+    return true;
+}
+
+static bool runZ80Test(string name, const OEData& program, bool isEchoed,
+                       string& output)
+{
+    OELong cycles;
+    OELong instructions;
+    double time;
+    OELong countedCycles;
+    OELong countedInstructions;
+    double countingTime;
+    string countedOutput;
+    
+    if (!runZ80Program(program, Z80_TEST_SLICE, isEchoed,
+                       output, cycles, instructions, time) ||
+        !runZ80Program(program, 1, false,
+                       countedOutput, countedCycles, countedInstructions, countingTime))
+    {
+        cerr << "oetest: z80: could not run " << name << endl;
+        
+        return false;
+    }
+    
+    if (output != countedOutput)
+    {
+        cerr << "oetest: z80: " << name << " output depends on the slice size" << endl;
+        
+        return false;
+    }
+    
+    printf("%s\n", name.c_str());
+    printf("  %lld T-states, %lld instructions in %.3f s host time\n",
+           (long long) cycles, (long long) countedInstructions, time);
+    printf("  %.1f MHz, %.2f million instructions/s\n",
+           cycles / time * 1E-6, countedInstructions / time * 1E-6);
+    
+    return true;
+}
+
+// Runs a program on a Z80 over a plain RAM, one instruction at a time
+
+class Z80TestRig
+{
+public:
+    Z80TestRig(string name)
+    {
+        this->name = name;
+        
+        isOpen = false;
+        success = true;
+    }
+    
+    ~Z80TestRig()
+    {
+        if (isOpen)
+            controlBus.dispose();
+    }
+    
+    bool open(const OEChar *program, OEInt size)
+    {
+        ram.setValue("size", "0x10000");
+        
+        if (!ram.init())
+            return false;
+        
+        load(Z80_TEST_PROGRAM, program, size);
+        
+        io.cpu = &cpu;
+        io.memory = &ram;
+        
+        controlBus.setValue("clockFrequency", Z80_TEST_CLOCKFREQUENCY);
+        controlBus.setValue("powerState", "S0");
+        controlBus.setValue("resetOnPowerOn", "0");
+        controlBus.setRef("device", &device);
+        controlBus.setRef("audio", &audio);
+        controlBus.setRef("cpu", &cpu);
+        
+        cpu.setRef("controlBus", &controlBus);
+        cpu.setRef("memoryBus", &ram);
+        cpu.setRef("ioBus", &io);
+        
+        if (!cpu.init() || !controlBus.init())
+            return false;
+        
+        isOpen = true;
+        
+        cpu.setValue("pc", getHexString(Z80_TEST_PROGRAM));
+        cpu.setValue("sp", getHexString(Z80_TEST_STACK));
+        
+        return true;
+    }
+    
+    void load(OEAddress address, const OEChar *data, OEInt size)
+    {
+        for (OEInt i = 0; i < size; i++)
+            ram.write(address + i, data[i]);
+    }
+    
+    OEChar read(OEAddress address)
+    {
+        return ram.read(address);
+    }
+    
+    OEInt get(string name)
+    {
+        string value;
+        
+        cpu.getValue(name, value);
+        
+        return getOEInt(value);
+    }
+    
+    void postControlBus(int message)
+    {
+        controlBus.postMessage(NULL, message, NULL);
+    }
+    
+    // Runs one instruction and returns its cycles
+    OEInt step()
+    {
+        OESLong pendingCycles = 1;
+        
+        cpu.postMessage(NULL, CPU_SET_PENDINGCYCLES, &pendingCycles);
+        cpu.postMessage(NULL, CPU_RUN, NULL);
+        cpu.postMessage(NULL, CPU_GET_PENDINGCYCLES, &pendingCycles);
+        
+        return (OEInt) (1 - pendingCycles);
+    }
+    
+    // Runs instructions until the program counter reaches pc
+    OEInt runTo(OEAddress pc)
+    {
+        OEInt cycles = 0;
+        
+        for (OEInt i = 0; (i < Z80_TEST_STEPNUM) && (get("pc") != pc); i++)
+            cycles += step();
+        
+        check(get("pc") == pc, "did not reach " + getHexString(pc));
+        
+        return cycles;
+    }
+    
+    bool checkStep(string what, OEInt cycles)
+    {
+        OEInt stepCycles = step();
+        
+        return check(stepCycles == cycles,
+                     what + " took " + getString(stepCycles) +
+                     " cycles, not " + getString(cycles));
+    }
+    
+    bool checkRunTo(OEAddress pc, OEInt cycles)
+    {
+        OEInt runCycles = runTo(pc);
+        
+        return check(runCycles == cycles,
+                     "run to " + getHexString(pc) + " took " + getString(runCycles) +
+                     " cycles, not " + getString(cycles));
+    }
+    
+    bool checkRegister(string registerName, OEInt value)
+    {
+        OEInt registerValue = get(registerName);
+        
+        return check(registerValue == value,
+                     registerName + " is " + getHexString(registerValue) +
+                     ", not " + getHexString(value));
+    }
+    
+    // Checks A, and the flags selected by mask
+    bool checkA(OEChar value, OEChar flags, OEChar mask)
+    {
+        OEInt af = get("af");
+        
+        return (check((af >> 8) == value,
+                      "a is " + getHexString(af >> 8) + ", not " + getHexString(value)) &&
+                check((af & mask) == flags,
+                      "f is " + getHexString(af & 0xff) + ", not " + getHexString(flags) +
+                      " in mask " + getHexString(mask)));
+    }
+    
+    bool checkMemory(OEAddress address, OEChar value)
+    {
+        OEChar memoryValue = read(address);
+        
+        return check(memoryValue == value,
+                     "memory at " + getHexString(address) + " is " +
+                     getHexString(memoryValue) + ", not " + getHexString(value));
+    }
+    
+    // Checks the return address on top of the stack
+    bool checkReturnAddress(OEAddress value)
+    {
+        OEInt sp = get("sp");
+        OEInt returnAddress = read(sp) | (read((sp + 1) & 0xffff) << 8);
+        
+        return check(returnAddress == value,
+                     "return address is " + getHexString(returnAddress) +
+                     ", not " + getHexString(value));
+    }
+    
+    bool check(bool condition, string message)
+    {
+        if (!condition)
+        {
+            cerr << "oetest: z80: " << name << ": " << message << endl;
+            
+            success = false;
+        }
+        
+        return condition;
+    }
+    
+    bool isSuccess()
+    {
+        return success;
+    }
+    
+private:
+    string name;
+    bool isOpen;
+    bool success;
+    
+    ControlBus controlBus;
+    Z80TestDevice device;
+    HeadlessAudio audio;
+    Z80 cpu;
+    RAM ram;
+    Z80TestIO io;
+};
+
+// DAA after additions and subtractions
+
+static const OEChar z80TestDAAProgram[] =
+{
+    0x3e, 0x15,             // 0100: LD A,15h
+    0xc6, 0x27,             // 0102: ADD A,27h
+    0x27,                   // 0104: DAA
+    0x3e, 0x42,             // 0105: LD A,42h
+    0xd6, 0x15,             // 0107: SUB 15h
+    0x27,                   // 0109: DAA
+    0x3e, 0x99,             // 010a: LD A,99h
+    0xc6, 0x01,             // 010c: ADD A,01h
+    0x27,                   // 010e: DAA
+    0x76,                   // 010f: HALT
+};
+
+static bool checkZ80DAA()
+{
+    Z80TestRig rig("DAA");
+    
+    if (!rig.open(z80TestDAAProgram, sizeof(z80TestDAAProgram)))
+        return rig.check(false, "could not open");
+    
+    // 15h + 27h = 42h
+    rig.checkStep("LD A,n", 7);
+    rig.checkStep("ADD A,n", 7);
+    rig.checkStep("DAA", 4);
+    rig.checkA(0x42, Z80_TEST_F_H | Z80_TEST_F_PV, Z80_TEST_F_DOCUMENTED);
+    
+    // 42h - 15h = 27h
+    rig.checkStep("LD A,n", 7);
+    rig.checkStep("SUB n", 7);
+    rig.checkStep("DAA", 4);
+    rig.checkA(0x27, Z80_TEST_F_PV | Z80_TEST_F_N, Z80_TEST_F_DOCUMENTED);
+    
+    // 99h + 01h = 100h
+    rig.checkStep("LD A,n", 7);
+    rig.checkStep("ADD A,n", 7);
+    rig.checkStep("DAA", 4);
+    rig.checkA(0x00, (Z80_TEST_F_Z | Z80_TEST_F_H | Z80_TEST_F_PV |
+                      Z80_TEST_F_C), Z80_TEST_F_DOCUMENTED);
+    
+    return rig.isSuccess();
+}
+
+// NEG, with its overflow and zero cases
+
+static const OEChar z80TestNEGProgram[] =
+{
+    0x3e, 0x01,             // 0100: LD A,01h
+    0xed, 0x44,             // 0102: NEG
+    0x3e, 0x80,             // 0104: LD A,80h
+    0xed, 0x44,             // 0106: NEG
+    0xaf,                   // 0108: XOR A
+    0xed, 0x44,             // 0109: NEG
+    0x76,                   // 010b: HALT
+};
+
+static bool checkZ80NEG()
+{
+    Z80TestRig rig("NEG");
+    
+    if (!rig.open(z80TestNEGProgram, sizeof(z80TestNEGProgram)))
+        return rig.check(false, "could not open");
+    
+    // Bits 5 and 3 of F are copied from the result
+    rig.checkStep("LD A,n", 7);
+    rig.checkStep("NEG", 8);
+    rig.checkA(0xff, 0xbb, 0xff);
+    
+    rig.checkStep("LD A,n", 7);
+    rig.checkStep("NEG", 8);
+    rig.checkA(0x80, (Z80_TEST_F_S | Z80_TEST_F_PV | Z80_TEST_F_N |
+                      Z80_TEST_F_C), Z80_TEST_F_DOCUMENTED);
+    
+    rig.checkStep("XOR A", 4);
+    rig.checkStep("NEG", 8);
+    rig.checkA(0x00, Z80_TEST_F_Z | Z80_TEST_F_N, Z80_TEST_F_DOCUMENTED);
+    
+    return rig.isSuccess();
+}
+
+// 16-bit SBC, with borrow in, overflow and a negative result
+
+static const OEChar z80TestSBC16Program[] =
+{
+    0x21, 0x00, 0x10,       // 0100: LD HL,1000h
+    0x11, 0x01, 0x00,       // 0103: LD DE,0001h
+    0x37,                   // 0106: SCF
+    0xed, 0x52,             // 0107: SBC HL,DE
+    0x21, 0x00, 0x80,       // 0109: LD HL,8000h
+    0xb7,                   // 010c: OR A
+    0xed, 0x52,             // 010d: SBC HL,DE
+    0x37,                   // 010f: SCF
+    0xed, 0x62,             // 0110: SBC HL,HL
+    0x76,                   // 0112: HALT
+};
+
+static bool checkZ80SBC16()
+{
+    Z80TestRig rig("SBC HL");
+    
+    if (!rig.open(z80TestSBC16Program, sizeof(z80TestSBC16Program)))
+        return rig.check(false, "could not open");
+    
+    rig.checkStep("LD HL,nn", 10);
+    rig.checkStep("LD DE,nn", 10);
+    rig.checkStep("SCF", 4);
+    rig.checkStep("SBC HL,DE", 15);
+    rig.checkRegister("hl", 0x0ffe);
+    rig.check((rig.get("af") & Z80_TEST_F_DOCUMENTED) == (Z80_TEST_F_H | Z80_TEST_F_N),
+              "SBC HL,DE flags are wrong");
+    
+    rig.checkStep("LD HL,nn", 10);
+    rig.checkStep("OR A", 4);
+    rig.checkStep("SBC HL,DE", 15);
+    rig.checkRegister("hl", 0x7fff);
+    rig.check((rig.get("af") & Z80_TEST_F_DOCUMENTED) == (Z80_TEST_F_H | Z80_TEST_F_PV |
+                                                          Z80_TEST_F_N),
+              "SBC HL,DE overflow flags are wrong");
+    
+    rig.checkStep("SCF", 4);
+    rig.checkStep("SBC HL,HL", 15);
+    rig.checkRegister("hl", 0xffff);
+    rig.check((rig.get("af") & Z80_TEST_F_DOCUMENTED) == (Z80_TEST_F_S | Z80_TEST_F_H |
+                                                          Z80_TEST_F_N | Z80_TEST_F_C),
+              "SBC HL,HL flags are wrong");
+    
+    return rig.isSuccess();
+}
+
+// LDIR, CPIR and LDDR, with the cycles of every repetition
+
+static const OEChar z80TestBlockProgram[] =
+{
+    0x21, 0x00, 0x20,       // 0100: LD HL,2000h
+    0x11, 0x00, 0x30,       // 0103: LD DE,3000h
+    0x01, 0x05, 0x00,       // 0106: LD BC,0005h
+    0xed, 0xb0,             // 0109: LDIR
+    0x21, 0x00, 0x20,       // 010b: LD HL,2000h
+    0x01, 0x10, 0x00,       // 010e: LD BC,0010h
+    0x3e, 0x33,             // 0111: LD A,33h
+    0xed, 0xb1,             // 0113: CPIR
+    0x21, 0x04, 0x30,       // 0115: LD HL,3004h
+    0x11, 0x04, 0x40,       // 0118: LD DE,4004h
+    0x01, 0x05, 0x00,       // 011b: LD BC,0005h
+    0xed, 0xb8,             // 011e: LDDR
+    0x76,                   // 0120: HALT
+};
+
+static const OEChar z80TestBlockData[] =
+{
+    0x11, 0x22, 0x00, 0x33, 0x44,
+};
+
+static bool checkZ80Block()
+{
+    Z80TestRig rig("block");
+    
+    if (!rig.open(z80TestBlockProgram, sizeof(z80TestBlockProgram)))
+        return rig.check(false, "could not open");
+    
+    rig.load(0x2000, z80TestBlockData, sizeof(z80TestBlockData));
+    
+    // 4 repetitions of 21 cycles, the last one takes 16
+    rig.checkRunTo(0x0109, 30);
+    rig.checkRunTo(0x010b, 100);
+    rig.checkRegister("hl", 0x2005);
+    rig.checkRegister("de", 0x3005);
+    rig.checkRegister("bc", 0x0000);
+    rig.check(!(rig.get("af") & Z80_TEST_F_PV), "LDIR left P/V set");
+    
+    for (OEInt i = 0; i < sizeof(z80TestBlockData); i++)
+        rig.checkMemory(0x3000 + i, z80TestBlockData[i]);
+    
+    // The match at 2003h ends CPIR with BC not zero
+    rig.checkRunTo(0x0113, 27);
+    rig.checkRunTo(0x0115, 79);
+    rig.checkRegister("hl", 0x2004);
+    rig.checkRegister("bc", 0x000c);
+    rig.check((rig.get("af") & (Z80_TEST_F_Z | Z80_TEST_F_PV)) == (Z80_TEST_F_Z | Z80_TEST_F_PV),
+              "CPIR did not set Z and P/V");
+    
+    rig.checkRunTo(0x011e, 30);
+    rig.checkRunTo(0x0120, 100);
+    rig.checkRegister("hl", 0x2fff);
+    rig.checkRegister("de", 0x3fff);
+    rig.checkRegister("bc", 0x0000);
+    
+    for (OEInt i = 0; i < sizeof(z80TestBlockData); i++)
+        rig.checkMemory(0x4000 + i, z80TestBlockData[i]);
+    
+    return rig.isSuccess();
+}
+
+// IX and IY with positive and negative displacements, DDCB and FDCB
+
+static const OEChar z80TestIndexProgram[] =
+{
+    0xdd, 0x21, 0x00, 0x10, // 0100: LD IX,1000h
+    0xdd, 0x36, 0x05, 0x77, // 0104: LD (IX+5),77h
+    0xdd, 0x7e, 0x05,       // 0108: LD A,(IX+5)
+    0xdd, 0x34, 0x05,       // 010b: INC (IX+5)
+    0xfd, 0x21, 0x10, 0x10, // 010e: LD IY,1010h
+    0xfd, 0x46, 0xf5,       // 0112: LD B,(IY-0Bh)
+    0xdd, 0xcb, 0x05, 0xc6, // 0115: SET 0,(IX+5)
+    0xfd, 0xcb, 0xf5, 0x9e, // 0119: RES 3,(IY-0Bh)
+    0xdd, 0xcb, 0x05, 0x7e, // 011d: BIT 7,(IX+5)
+    0xdd, 0xcb, 0x05, 0x00, // 0121: RLC (IX+5),B
+    0xdd, 0xe5,             // 0125: PUSH IX
+    0xfd, 0xe1,             // 0127: POP IY
+    0x76,                   // 0129: HALT
+};
+
+static bool checkZ80Index()
+{
+    Z80TestRig rig("IX and IY");
+    
+    if (!rig.open(z80TestIndexProgram, sizeof(z80TestIndexProgram)))
+        return rig.check(false, "could not open");
+    
+    rig.checkStep("LD IX,nn", 14);
+    rig.checkStep("LD (IX+d),n", 19);
+    rig.checkStep("LD A,(IX+d)", 19);
+    rig.checkA(0x77, 0, 0);
+    rig.checkStep("INC (IX+d)", 23);
+    rig.checkMemory(0x1005, 0x78);
+    
+    rig.checkStep("LD IY,nn", 14);
+    rig.checkStep("LD B,(IY+d)", 19);
+    rig.checkRegister("bc", 0x7800);
+    
+    rig.checkStep("SET b,(IX+d)", 23);
+    rig.checkMemory(0x1005, 0x79);
+    rig.checkStep("RES b,(IY+d)", 23);
+    rig.checkMemory(0x1005, 0x71);
+    rig.checkStep("BIT b,(IX+d)", 20);
+    rig.check(rig.get("af") & Z80_TEST_F_Z, "BIT 7,(IX+5) did not set Z");
+    
+    // The undocumented DDCB forms also store the result in a register
+    rig.checkStep("RLC (IX+d),B", 23);
+    rig.checkMemory(0x1005, 0xe2);
+    rig.checkRegister("bc", 0xe200);
+    rig.check(!(rig.get("af") & Z80_TEST_F_C), "RLC (IX+5) set C");
+    
+    rig.checkStep("PUSH IX", 15);
+    rig.checkStep("POP IY", 14);
+    rig.checkRegister("iy", 0x1000);
+    
+    return rig.isSuccess();
+}
+
+// IM 1 while halted
+
+static const OEChar z80TestIM1Program[] =
+{
+    0xed, 0x56,             // 0100: IM 1
+    0xfb,                   // 0102: EI
+    0x76,                   // 0103: HALT
+};
+
+static bool checkZ80IM1()
+{
+    Z80TestRig rig("IM 1");
+    
+    if (!rig.open(z80TestIM1Program, sizeof(z80TestIM1Program)))
+        return rig.check(false, "could not open");
+    
+    rig.checkStep("IM 1", 8);
+    rig.checkStep("EI", 4);
+    rig.checkStep("HALT", 4);
+    
+    // HALT executes NOPs at the HALT instruction
+    rig.checkStep("halted NOP", 4);
+    rig.checkRegister("pc", 0x0103);
+    rig.checkRegister("halt", 1);
+    
+    rig.postControlBus(CONTROLBUS_ASSERT_IRQ);
+    
+    rig.checkStep("IRQ", 13);
+    rig.checkRegister("pc", 0x0038);
+    rig.checkRegister("halt", 0);
+    rig.checkRegister("iff1", 0);
+    rig.checkReturnAddress(0x0104);
+    
+    rig.postControlBus(CONTROLBUS_CLEAR_IRQ);
+    
+    return rig.isSuccess();
+}
+
+// The instructions following EI run before an IRQ is accepted
+
+static const OEChar z80TestEIProgram[] =
+{
+    0xed, 0x56,             // 0100: IM 1
+    0xfb,                   // 0102: EI
+    0xfb,                   // 0103: EI
+    0x3e, 0x01,             // 0104: LD A,01h
+    0x3e, 0x02,             // 0106: LD A,02h
+};
+
+static bool checkZ80EI()
+{
+    Z80TestRig rig("EI");
+    
+    if (!rig.open(z80TestEIProgram, sizeof(z80TestEIProgram)))
+        return rig.check(false, "could not open");
+    
+    // The IRQ is held off while interrupts are disabled
+    rig.postControlBus(CONTROLBUS_ASSERT_IRQ);
+    
+    rig.checkStep("IM 1", 8);
+    rig.checkStep("EI", 4);
+    rig.checkStep("EI", 4);
+    rig.checkStep("LD A,n", 7);
+    rig.checkRegister("pc", 0x0106);
+    
+    rig.checkStep("IRQ", 13);
+    rig.checkRegister("pc", 0x0038);
+    rig.checkA(0x01, 0, 0);
+    rig.checkReturnAddress(0x0106);
+    
+    rig.postControlBus(CONTROLBUS_CLEAR_IRQ);
+    
+    return rig.isSuccess();
+}
+
+// NMI while halted, and RETN
+
+static const OEChar z80TestNMIProgram[] =
+{
+    0xfb,                   // 0100: EI
+    0x76,                   // 0101: HALT
+};
+
+static const OEChar z80TestNMIHandler[] =
+{
+    0xed, 0x45,             // 0066: RETN
+};
+
+static bool checkZ80NMI()
+{
+    Z80TestRig rig("NMI");
+    
+    if (!rig.open(z80TestNMIProgram, sizeof(z80TestNMIProgram)))
+        return rig.check(false, "could not open");
+    
+    rig.load(0x0066, z80TestNMIHandler, sizeof(z80TestNMIHandler));
+    
+    rig.checkStep("EI", 4);
+    rig.checkStep("HALT", 4);
+    
+    rig.postControlBus(CONTROLBUS_ASSERT_NMI);
+    
+    // NMI clears IFF1 and keeps IFF2
+    rig.checkStep("NMI", 11);
+    rig.checkRegister("pc", 0x0066);
+    rig.checkRegister("halt", 0);
+    rig.checkRegister("iff1", 0);
+    rig.checkRegister("iff2", 1);
+    rig.checkReturnAddress(0x0102);
+    
+    rig.checkStep("RETN", 14);
+    rig.checkRegister("pc", 0x0102);
+    rig.checkRegister("iff1", 1);
+    
+    return rig.isSuccess();
+}
+
+// IM 2 reads its vector at I * 100h + FFh, as the data bus is FFh
+
+static const OEChar z80TestIM2Program[] =
+{
+    0x3e, 0x12,             // 0100: LD A,12h
+    0xed, 0x47,             // 0102: LD I,A
+    0xed, 0x5e,             // 0104: IM 2
+    0xfb,                   // 0106: EI
+    0x00,                   // 0107: NOP
+    0x00,                   // 0108: NOP
+};
+
+static const OEChar z80TestIM2Vector[] =
+{
+    0x00, 0x05,             // 12ff: DW 0500h
+};
+
+static bool checkZ80IM2()
+{
+    Z80TestRig rig("IM 2");
+    
+    if (!rig.open(z80TestIM2Program, sizeof(z80TestIM2Program)))
+        return rig.check(false, "could not open");
+    
+    rig.load(0x12ff, z80TestIM2Vector, sizeof(z80TestIM2Vector));
+    
+    rig.postControlBus(CONTROLBUS_ASSERT_IRQ);
+    
+    rig.checkStep("LD A,n", 7);
+    rig.checkStep("LD I,A", 9);
+    rig.checkStep("IM 2", 8);
+    rig.checkStep("EI", 4);
+    rig.checkStep("NOP", 4);
+    
+    rig.checkStep("IRQ", 19);
+    rig.checkRegister("pc", 0x0500);
+    rig.checkRegister("im", 2);
+    rig.checkReturnAddress(0x0108);
+    
+    rig.postControlBus(CONTROLBUS_CLEAR_IRQ);
+    
+    return rig.isSuccess();
+}
+
+static bool readZ80TestFile(string path, OEData& data)
+{
+    FILE *fp = fopen(path.c_str(), "rb");
+    
+    if (!fp)
+        return false;
+    
+    OEChar buffer[0x1000];
+    size_t n;
+    
+    while ((n = fread(buffer, 1, sizeof(buffer), fp)) > 0)
+        data.insert(data.end(), buffer, buffer + n);
+    
+    fclose(fp);
+    
+    return (data.size() && (data.size() <= Z80_TEST_STACK - Z80_TEST_PROGRAM));
+}
+
+bool testZ80(string resourcePath, vector<string>& args)
+{
+    string output;
+    
+    if (!args.size())
+    {
+        OEData program(z80TestProgram, z80TestProgram + sizeof(z80TestProgram));
+        
+        if (!runZ80Test("built-in program", program, false, output))
+            return false;
+        
+        if (output != Z80_TEST_PROGRAMOUTPUT)
+        {
+            cerr << "oetest: z80: built-in program printed \"" << output << "\"" << endl;
+            
+            return false;
+        }
+        
+        bool success = true;
+        
+        success &= checkZ80DAA();
+        success &= checkZ80NEG();
+        success &= checkZ80SBC16();
+        success &= checkZ80Block();
+        success &= checkZ80Index();
+        success &= checkZ80IM1();
+        success &= checkZ80EI();
+        success &= checkZ80NMI();
+        success &= checkZ80IM2();
+        
+        return success;
+    }
+    
+    bool success = true;
+    
+    for (OEInt i = 0; i < args.size(); i++)
+    {
+        OEData program;
+        
+        if (!readZ80TestFile(args[i], program))
+        {
+            cerr << "oetest: z80: could not read " << args[i] << endl;
+            
+            success = false;
+            
+            continue;
+        }
+        
+        if (!runZ80Test(args[i], program, true, output))
+            success = false;
+        else if (output.find("ERROR") != string::npos)
+            success = false;
+    }
+    
+    return success;
+}
@@ -0,0 +1,198 @@
+
+/**
+ * oetest
+ * Emulation regression tests
+ * (C) 2012 by Marc S. Ressl (mressl@umich.edu)
+ * Released under the GPL
+ *
+ * Runs regression tests on libemulation components without audio or
+ * video hardware
+ */
+
+#include <stdlib.h>
+
+#include <iostream>
+
+#include "oetest.h"
+
+#include "util.h"
+
+#include "HeadlessCanvas.h"
+#include "HIDJoystick.h"
+
+typedef struct
+{
+    string name;
+    OETestFunction function;
+} OETest;
+
+static OETest tests[] =
+{
+    {"appleiiimos6502", testAppleIIIMOS6502},
+    {"controlbus", testControlBus},
+    {"cpu", testCPU},
+    {"memory", testMemory},
+    {"rewind", testRewind},
+    {"state", testState},
+    {"triplebuffer", testTripleBuffer},
+    {"video", testVideo},
+    {"videodecoder", testVideoDecoder},
+    {"w65c816s", testW65C816S},
+    {"z80", testZ80},
+};
+
+#define TEST_NUM (sizeof(tests) / sizeof(OETest))
+
+static HIDJoystick joystick;
+
+OEInt getTestRandom(OEInt& seed)
+{
+    seed = seed * 1103515245 + 12345;
+    
+    return (seed >> 16) & 0x7fff;
+}
+
+OELong getTestHash(OELong hash, const void *data, size_t size)
+{
+    const OEChar *p = (const OEChar *)data;
+    
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= p[i];
+        hash *= 0x100000001b3ULL;
+    }
+    
+    return hash;
+}
+
+OELong getTestHash(OELong hash, OELong value)
+{
+    for (OEInt i = 0; i < 8; i++)
+    {
+        hash ^= (value >> (i * 8)) & 0xff;
+        hash *= 0x100000001b3ULL;
+    }
+    
+    return hash;
+}
+
+bool checkTestDigest(string name, OELong digest, OELong expectedDigest)
+{
+    if (digest == expectedDigest)
+        return true;
+    
+    cerr << "oetest: " << name << ": digest " << getHexString((long long) digest) <<
+    ", expected " << getHexString((long long) expectedDigest) << endl;
+    
+    return false;
+}
+
+static OEComponent *constructCanvas(void *userData,
+                                    OEComponent *device,
+                                    OECanvasType canvasType)
+{
+    return new HeadlessCanvas(canvasType);
+}
+
+static void destroyCanvas(void *userData, OEComponent *canvas)
+{
+    delete (HeadlessCanvas *)canvas;
+}
+
+OEEmulation *openTestEmulation(string resourcePath, string templateName,
+                               OEComponent *audio)
+{
+    return openTestEmulation(resourcePath, templateName, audio,
+                             constructCanvas, destroyCanvas);
+}
+
+OEEmulation *openTestEmulation(string resourcePath, string templateName,
+                               OEComponent *audio,
+                               EmulationConstructCanvas constructCanvas,
+                               EmulationDestroyCanvas destroyCanvas)
+{
+    OEEmulation *emulation = new OEEmulation();
+    
+    emulation->setResourcePath(resourcePath);
+    emulation->setConstructCanvas(constructCanvas);
+    emulation->setDestroyCanvas(destroyCanvas);
+    emulation->addComponent("audio", audio);
+    emulation->addComponent("joystick", &joystick);
+    
+    emulation->open(resourcePath + "/templates/" + templateName + ".xml");
+    
+    if (!emulation->isOpen())
+    {
+        cerr << "oetest: could not open " << templateName << endl;
+        
+        delete emulation;
+        
+        return NULL;
+    }
+    
+    return emulation;
+}
+
+static void printUsage()
+{
+    cerr << "usage: oetest -r resourcePath [test [args...]]" << endl;
+    cerr << "  -r  resource path (the directory holding templates and roms)" << endl;
+    cerr << "tests:";
+    
+    for (OEInt i = 0; i < TEST_NUM; i++)
+        cerr << " " << tests[i].name;
+    
+    cerr << endl;
+}
+
+int main(int argc, char *argv[])
+{
+    string resourcePath;
+    int i = 1;
+    
+    if ((argc > 2) && (string(argv[1]) == "-r"))
+    {
+        resourcePath = argv[2];
+        
+        i = 3;
+    }
+    
+    if (resourcePath == "")
+    {
+        printUsage();
+        
+        return 1;
+    }
+    
+    string name = (i < argc) ? argv[i++] : "";
+    vector<string> args;
+    
+    for (; i < argc; i++)
+        args.push_back(argv[i]);
+    
+    bool isFound = false;
+    bool success = true;
+    
+    for (OEInt j = 0; j < TEST_NUM; j++)
+    {
+        if ((name != "") && (name != tests[j].name))
+            continue;
+        
+        isFound = true;
+        
+        bool isPassed = tests[j].function(resourcePath, args);
+        
+        cout << tests[j].name << ": " << (isPassed ? "passed" : "FAILED") << endl;
+        
+        success &= isPassed;
+    }
+    
+    if (!isFound)
+    {
+        printUsage();
+        
+        return 1;
+    }
+    
+    return success ? 0 : 1;
+}
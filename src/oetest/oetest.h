@@ -0,0 +1,52 @@
+
+/**
+ * oetest
+ * Emulation regression tests
+ * (C) 2012 by Marc S. Ressl (mressl@umich.edu)
+ * Released under the GPL
+ *
+ * Declares the tests and their shared helpers
+ */
+
+#ifndef _OETEST_H
+#define _OETEST_H
+
+#include "OEEmulation.h"
+
+// Notes:
+// * A test receives the resource path and the arguments that follow its
+//   name on the command line, and returns false when it fails.
+// * Tests that compare against an earlier implementation check a digest
+//   recorded by running the same test on that implementation.
+// * openTestEmulation opens a template with headless canvases, unless the
+//   test passes its own canvas constructor.
+// * getTestRandom is a fixed linear congruential generator, so that test
+//   runs are the same on every host.
+
+typedef bool (*OETestFunction)(string resourcePath, vector<string>& args);
+
+OEInt getTestRandom(OEInt& seed);
+OELong getTestHash(OELong hash, const void *data, size_t size);
+OELong getTestHash(OELong hash, OELong value);
+bool checkTestDigest(string name, OELong digest, OELong expectedDigest);
+
+OEEmulation *openTestEmulation(string resourcePath, string templateName,
+                               OEComponent *audio);
+OEEmulation *openTestEmulation(string resourcePath, string templateName,
+                               OEComponent *audio,
+                               EmulationConstructCanvas constructCanvas,
+                               EmulationDestroyCanvas destroyCanvas);
+
+bool testAppleIIIMOS6502(string resourcePath, vector<string>& args);
+bool testControlBus(string resourcePath, vector<string>& args);
+bool testCPU(string resourcePath, vector<string>& args);
+bool testMemory(string resourcePath, vector<string>& args);
+bool testRewind(string resourcePath, vector<string>& args);
+bool testState(string resourcePath, vector<string>& args);
+bool testTripleBuffer(string resourcePath, vector<string>& args);
+bool testVideo(string resourcePath, vector<string>& args);
+bool testVideoDecoder(string resourcePath, vector<string>& args);
+bool testW65C816S(string resourcePath, vector<string>& args);
+bool testZ80(string resourcePath, vector<string>& args);
+
+#endif